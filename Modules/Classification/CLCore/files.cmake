@@ -4,6 +4,7 @@ set(CPP_FILES
   mitkConfigurationHolder.cpp
   mitkAbstractClassifier.cpp
   mitkAbstractGlobalImageFeature.cpp
+  mitkGlobalImageFeaturesEngine.cpp
   mitkIntensityQuantifier.cpp
 )
 
@@ -233,6 +233,11 @@ public:
   itkSetMacro(IgnoreMask, bool);
   itkGetConstMacro(IgnoreMask, bool);
 
+  /** Cache of intensity ranges that is shared with other feature classes processing the same image.
+  If set, the quantifier takes the ranges from the cache instead of scanning the image again.*/
+  itkSetMacro(IntensityRangeCache, IntensityRangeCache::Pointer);
+  itkGetConstMacro(IntensityRangeCache, IntensityRangeCache::Pointer);
+
   itkSetMacro(EncodeParametersInFeaturePrefix, bool);
   itkGetConstMacro(EncodeParametersInFeaturePrefix, bool);
   itkBooleanMacro(EncodeParametersInFeaturePrefix);
@@ -319,6 +324,7 @@ private:
 
 
   IntensityQuantifier::Pointer m_Quantifier;
+  IntensityRangeCache::Pointer m_IntensityRangeCache;
   //Quantifier relevant variables
   double m_MinimumIntensity = 0;
   bool m_UseMinimumIntensity = false;
@@ -0,0 +1,79 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+
+#ifndef mitkGlobalImageFeaturesEngine_h
+#define mitkGlobalImageFeaturesEngine_h
+
+#include <MitkCLCoreExports.h>
+
+#include <mitkAbstractGlobalImageFeature.h>
+
+#include <functional>
+
+namespace mitk
+{
+  /**
+  * \brief Calculates the features of several feature classes for several images concurrently.
+  *
+  * Every feature class of every image is a task of a pool of threads. The feature classes of an image
+  * share an IntensityRangeCache, so that the image and the masks are scanned only once for the
+  * initialization of the quantifiers. As feature classes store the state of a calculation, every image
+  * gets its own instances, which are created by the feature factory.
+  *
+  * The results are independent of the number of threads: the features of an image are listed in the
+  * order of the feature classes returned by the factory, like when calling CalculateAndAppendFeatures()
+  * of every class one after another.
+  */
+  class MITKCLCORE_EXPORT GlobalImageFeaturesEngine
+  {
+  public:
+    using FeatureListType = AbstractGlobalImageFeature::FeatureListType;
+    using FeatureVectorType = std::vector<AbstractGlobalImageFeature::Pointer>;
+
+    /** Creates the configured feature classes for one image. Is called from the calling thread only.*/
+    using FeatureFactoryType = std::function<FeatureVectorType()>;
+
+    struct Input
+    {
+      Image::Pointer image;
+      Image::Pointer mask;
+      Image::Pointer maskNoNaN;
+      /** Optional, the mask is used if not set.*/
+      Image::Pointer morphMask;
+    };
+
+    explicit GlobalImageFeaturesEngine(const FeatureFactoryType &featureFactory);
+
+    /** Number of concurrent tasks. 0 (default) uses the number of hardware threads.*/
+    void SetNumberOfThreads(unsigned int numberOfThreads);
+    unsigned int GetNumberOfThreads() const;
+
+    /** If true (default), only feature classes that are activated in their parameters are calculated.
+    See AbstractGlobalImageFeature::CalculateAndAppendFeatures().*/
+    void SetCheckParameterActivation(bool checkParameterActivation);
+    bool GetCheckParameterActivation() const;
+
+    FeatureListType CalculateFeatures(const Input &input);
+
+    /** \brief Calculates the features of all inputs, the results are in the order of the inputs.
+    * Exceptions of a feature class are rethrown after all running tasks are finished.*/
+    std::vector<FeatureListType> CalculateFeatures(const std::vector<Input> &inputs);
+
+  private:
+    FeatureFactoryType m_FeatureFactory;
+    unsigned int m_NumberOfThreads;
+    bool m_CheckParameterActivation;
+  };
+}
+
+#endif
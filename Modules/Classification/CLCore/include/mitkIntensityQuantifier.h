@@ -19,8 +19,50 @@ found in the LICENSE file.
 #include <mitkBaseData.h>
 #include <mitkImage.h>
 
+#include <future>
+#include <map>
+#include <mutex>
+
 namespace mitk
 {
+/**
+* \brief Caches the minimum and maximum intensity of images and of masked image regions.
+*
+* Most feature classes initialize their quantifier from the intensity range of the image or of the masked
+* region. If the feature classes that process the same image share a cache, every range is computed only
+* once, also if the classes run concurrently. The cache keeps the images alive and does not observe
+* modifications, so it should only live as long as the images are processed.
+*/
+class MITKCLCORE_EXPORT IntensityRangeCache : public itk::Object
+{
+public:
+  mitkClassMacroItkParent(IntensityRangeCache, itk::Object);
+  itkFactorylessNewMacro(Self);
+
+  /** \brief Returns the range of the image, or of the region within the mask if a mask is passed.*/
+  void GetRange(const Image* image, const Image* mask, double &minimum, double &maximum);
+
+  void Clear();
+
+protected:
+  IntensityRangeCache() = default;
+  ~IntensityRangeCache() override = default;
+
+private:
+  using KeyType = std::pair<const Image*, const Image*>;
+  using RangeType = std::pair<double, double>;
+
+  struct Entry
+  {
+    Image::ConstPointer image;
+    Image::ConstPointer mask;
+    std::shared_future<RangeType> range;
+  };
+
+  std::mutex m_Mutex;
+  std::map<KeyType, Entry> m_Entries;
+};
+
 class MITKCLCORE_EXPORT IntensityQuantifier : public BaseData
 {
 public:
@@ -57,6 +99,9 @@ public:
   itkGetConstMacro(Minimum, double);
   itkGetConstMacro(Maximum, double);
 
+  /** If set, the intensity ranges of images and masked regions are taken from the cache.*/
+  itkSetObjectMacro(IntensityRangeCache, IntensityRangeCache);
+
 public:
 
 //#ifndef DOXYGEN_SKIP
@@ -79,6 +124,9 @@ public:
 
 
 private:
+  void CalculateRange(const Image* image, const Image* mask, double &minimum, double &maximum);
+
+  IntensityRangeCache::Pointer m_IntensityRangeCache;
   bool m_Initialized;
   unsigned int m_Bins;
   double m_Binsize;
@@ -256,6 +256,7 @@ void mitk::AbstractGlobalImageFeature::ConfigureSettingsByParameters(const Param
 void  mitk::AbstractGlobalImageFeature::InitializeQuantifier(const Image* image, const Image* mask, unsigned int defaultBins)
 {
   m_Quantifier = IntensityQuantifier::New();
+  m_Quantifier->SetIntensityRangeCache(m_IntensityRangeCache);
   if (GetUseMinimumIntensity() && GetUseMaximumIntensity() && GetUseBinsize())
     m_Quantifier->InitializeByBinsizeAndMaximum(GetMinimumIntensity(), GetMaximumIntensity(), GetBinsize());
   else if (GetUseMinimumIntensity() && GetUseBins() && GetUseBinsize())
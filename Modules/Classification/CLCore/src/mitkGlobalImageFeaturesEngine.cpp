@@ -0,0 +1,142 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include <mitkGlobalImageFeaturesEngine.h>
+
+#include <mitkExceptionMacro.h>
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <mutex>
+#include <thread>
+
+mitk::GlobalImageFeaturesEngine::GlobalImageFeaturesEngine(const FeatureFactoryType &featureFactory)
+  : m_FeatureFactory(featureFactory),
+    m_NumberOfThreads(0),
+    m_CheckParameterActivation(true)
+{
+  if (!m_FeatureFactory)
+    mitkThrow() << "GlobalImageFeaturesEngine requires a feature factory.";
+}
+
+void mitk::GlobalImageFeaturesEngine::SetNumberOfThreads(unsigned int numberOfThreads)
+{
+  m_NumberOfThreads = numberOfThreads;
+}
+
+unsigned int mitk::GlobalImageFeaturesEngine::GetNumberOfThreads() const
+{
+  if (0 != m_NumberOfThreads)
+    return m_NumberOfThreads;
+
+  return std::max(1u, std::thread::hardware_concurrency());
+}
+
+void mitk::GlobalImageFeaturesEngine::SetCheckParameterActivation(bool checkParameterActivation)
+{
+  m_CheckParameterActivation = checkParameterActivation;
+}
+
+bool mitk::GlobalImageFeaturesEngine::GetCheckParameterActivation() const
+{
+  return m_CheckParameterActivation;
+}
+
+mitk::GlobalImageFeaturesEngine::FeatureListType mitk::GlobalImageFeaturesEngine::CalculateFeatures(const Input &input)
+{
+  return this->CalculateFeatures(std::vector<Input>{ input }).front();
+}
+
+std::vector<mitk::GlobalImageFeaturesEngine::FeatureListType> mitk::GlobalImageFeaturesEngine::CalculateFeatures(const std::vector<Input> &inputs)
+{
+  struct Task
+  {
+    std::size_t input;
+    std::size_t feature;
+  };
+
+  std::vector<FeatureVectorType> features(inputs.size());
+  std::vector<std::vector<FeatureListType>> results(inputs.size());
+  std::vector<Task> tasks;
+
+  for (std::size_t i = 0; i < inputs.size(); ++i)
+  {
+    if (inputs[i].image.IsNull() || inputs[i].mask.IsNull() || inputs[i].maskNoNaN.IsNull())
+      mitkThrow() << "Input " << i << " of GlobalImageFeaturesEngine is incomplete.";
+
+    features[i] = m_FeatureFactory();
+    results[i].resize(features[i].size());
+
+    auto rangeCache = IntensityRangeCache::New();
+    auto morphMask = inputs[i].morphMask.IsNotNull() ? inputs[i].morphMask : inputs[i].mask;
+
+    for (std::size_t j = 0; j < features[i].size(); ++j)
+    {
+      features[i][j]->SetIntensityRangeCache(rangeCache);
+      features[i][j]->SetMorphMask(morphMask);
+      tasks.push_back({ i, j });
+    }
+  }
+
+  std::atomic<std::size_t> nextTask(0);
+  std::exception_ptr error;
+  std::mutex errorMutex;
+
+  auto worker = [&]() {
+    for (auto t = nextTask++; t < tasks.size(); t = nextTask++)
+    {
+      const auto &task = tasks[t];
+      const auto &input = inputs[task.input];
+
+      try
+      {
+        features[task.input][task.feature]->CalculateAndAppendFeatures(input.image, input.mask, input.maskNoNaN,
+          results[task.input][task.feature], m_CheckParameterActivation);
+      }
+      catch (...)
+      {
+        std::lock_guard<std::mutex> lock(errorMutex);
+
+        if (!error)
+          error = std::current_exception();
+
+        // Skip the remaining tasks
+        nextTask = tasks.size();
+      }
+    }
+  };
+
+  const auto numberOfThreads = std::min<std::size_t>(this->GetNumberOfThreads(), tasks.size());
+  std::vector<std::thread> threads;
+
+  for (std::size_t i = 1; i < numberOfThreads; ++i)
+    threads.emplace_back(worker);
+
+  worker();
+
+  for (auto &thread : threads)
+    thread.join();
+
+  if (error)
+    std::rethrow_exception(error);
+
+  std::vector<FeatureListType> featureLists(inputs.size());
+
+  for (std::size_t i = 0; i < inputs.size(); ++i)
+  {
+    for (const auto &result : results[i])
+      featureLists[i].insert(featureLists[i].end(), result.begin(), result.end());
+  }
+
+  return featureLists;
+}
@@ -69,6 +69,71 @@ CalculateImageRegionMinMax(const itk::Image<TPixel, VImageDimension>* itkImage,
   }
 }
 
+static void
+CalculateMinMax(const mitk::Image* image, const mitk::Image* mask, double &minimum, double &maximum)
+{
+  if (nullptr == mask)
+  {
+    AccessByItk_2(image, CalculateImageMinMax, minimum, maximum);
+  }
+  else
+  {
+    AccessByItk_3(image, CalculateImageRegionMinMax, mask, minimum, maximum);
+  }
+}
+
+void mitk::IntensityRangeCache::GetRange(const Image* image, const Image* mask, double &minimum, double &maximum)
+{
+  std::shared_future<RangeType> range;
+  std::promise<RangeType> promise;
+  bool calculate = false;
+
+  {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    auto finding = m_Entries.find(std::make_pair(image, mask));
+
+    if (finding == m_Entries.end())
+    {
+      // The range is calculated outside of the lock. Concurrent requests of the same range wait for the result.
+      Entry entry;
+      entry.image = image;
+      entry.mask = mask;
+      entry.range = promise.get_future().share();
+      range = entry.range;
+      m_Entries.emplace(std::make_pair(image, mask), entry);
+      calculate = true;
+    }
+    else
+    {
+      range = finding->second.range;
+    }
+  }
+
+  if (calculate)
+  {
+    try
+    {
+      RangeType result;
+      CalculateMinMax(image, mask, result.first, result.second);
+      promise.set_value(result);
+    }
+    catch (...)
+    {
+      promise.set_exception(std::current_exception());
+    }
+  }
+
+  const auto &result = range.get();
+  minimum = result.first;
+  maximum = result.second;
+}
+
+void mitk::IntensityRangeCache::Clear()
+{
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  m_Entries.clear();
+}
+
 mitk::IntensityQuantifier::IntensityQuantifier() :
       m_Initialized(false),
       m_Bins(0),
@@ -103,76 +168,88 @@ void mitk::IntensityQuantifier::InitializeByBinsizeAndMaximum(double minimum, do
 
 void mitk::IntensityQuantifier::InitializeByImage(const Image* image, unsigned int bins) {
   double minimum, maximum;
-  AccessByItk_2(image, CalculateImageMinMax, minimum, maximum);
+  CalculateRange(image, nullptr, minimum, maximum);
   InitializeByMinimumMaximum(minimum, maximum, bins);
 }
 
 void mitk::IntensityQuantifier::InitializeByImageAndMinimum(const Image* image, double minimum, unsigned int bins) {
   double tmp, maximum;
-  AccessByItk_2(image, CalculateImageMinMax, tmp, maximum);
+  CalculateRange(image, nullptr, tmp, maximum);
   InitializeByMinimumMaximum(minimum, maximum, bins);
 }
 
 void mitk::IntensityQuantifier::InitializeByImageAndMaximum(const Image* image, double maximum, unsigned int bins) {
   double minimum, tmp;
-  AccessByItk_2(image, CalculateImageMinMax, minimum, tmp);
+  CalculateRange(image, nullptr, minimum, tmp);
   InitializeByMinimumMaximum(minimum, maximum, bins);
 }
 
 void mitk::IntensityQuantifier::InitializeByImageRegion(const Image* image, const Image* mask, unsigned int bins) {
   double minimum, maximum;
-  AccessByItk_3(image, CalculateImageRegionMinMax, mask, minimum, maximum);
+  CalculateRange(image, mask, minimum, maximum);
   InitializeByMinimumMaximum(minimum, maximum, bins);
 }
 
 void mitk::IntensityQuantifier::InitializeByImageRegionAndMinimum(const Image* image, const Image* mask, double minimum, unsigned int bins) {
   double tmp, maximum;
-  AccessByItk_3(image, CalculateImageRegionMinMax, mask, tmp, maximum);
+  CalculateRange(image, mask, tmp, maximum);
   InitializeByMinimumMaximum(minimum, maximum, bins);
 }
 
 void mitk::IntensityQuantifier::InitializeByImageRegionAndMaximum(const Image* image, const Image* mask, double maximum, unsigned int bins) {
   double minimum, tmp;
-  AccessByItk_3(image, CalculateImageRegionMinMax, mask, minimum, tmp);
+  CalculateRange(image, mask, minimum, tmp);
   InitializeByMinimumMaximum(minimum, maximum, bins);
 }
 
 void mitk::IntensityQuantifier::InitializeByImageAndBinsize(const Image* image, double binsize) {
   double minimum, maximum;
-  AccessByItk_2(image, CalculateImageMinMax, minimum, maximum);
+  CalculateRange(image, nullptr, minimum, maximum);
   InitializeByBinsizeAndMaximum(minimum, maximum, binsize);
 }
 
 void mitk::IntensityQuantifier::InitializeByImageAndBinsizeAndMinimum(const Image* image, double minimum, double binsize) {
   double tmp, maximum;
-  AccessByItk_2(image, CalculateImageMinMax, tmp, maximum);
+  CalculateRange(image, nullptr, tmp, maximum);
   InitializeByBinsizeAndMaximum(minimum, maximum, binsize);
 }
 
 void mitk::IntensityQuantifier::InitializeByImageAndBinsizeAndMaximum(const Image* image, double maximum, double binsize) {
   double minimum, tmp;
-  AccessByItk_2(image, CalculateImageMinMax, minimum, tmp);
+  CalculateRange(image, nullptr, minimum, tmp);
   InitializeByBinsizeAndMaximum(minimum, maximum, binsize);
 }
 
 void mitk::IntensityQuantifier::InitializeByImageRegionAndBinsize(const Image* image, const Image* mask, double binsize) {
   double minimum, maximum;
-  AccessByItk_3(image, CalculateImageRegionMinMax, mask, minimum, maximum);
+  CalculateRange(image, mask, minimum, maximum);
   InitializeByBinsizeAndMaximum(minimum, maximum, binsize);
 }
 
 void mitk::IntensityQuantifier::InitializeByImageRegionAndBinsizeAndMinimum(const Image* image, const Image* mask, double minimum, double binsize) {
   double tmp, maximum;
-  AccessByItk_3(image, CalculateImageRegionMinMax, mask, tmp, maximum);
+  CalculateRange(image, mask, tmp, maximum);
   InitializeByBinsizeAndMaximum(minimum, maximum, binsize);
 }
 
 void mitk::IntensityQuantifier::InitializeByImageRegionAndBinsizeAndMaximum(const Image* image, const Image* mask, double maximum, double binsize) {
   double minimum, tmp;
-  AccessByItk_3(image, CalculateImageRegionMinMax, mask, minimum, tmp);
+  CalculateRange(image, mask, minimum, tmp);
   InitializeByBinsizeAndMaximum(minimum, maximum, binsize);
 }
 
+void mitk::IntensityQuantifier::CalculateRange(const Image* image, const Image* mask, double &minimum, double &maximum)
+{
+  if (m_IntensityRangeCache.IsNotNull())
+  {
+    m_IntensityRangeCache->GetRange(image, mask, minimum, maximum);
+  }
+  else
+  {
+    CalculateMinMax(image, mask, minimum, maximum);
+  }
+}
+
 unsigned int mitk::IntensityQuantifier::IntensityToIndex(double intensity)
 {
   double index = std::floor((intensity - m_Minimum) / m_Binsize);
@@ -43,6 +43,8 @@ found in the LICENSE file.
 #include <mitkITKImageImport.h>
 #include <mitkConvert2Dto3DImageFilter.h>
 
+#include <mitkGlobalImageFeaturesEngine.h>
+
 #include <mitkCLResultWriter.h>
 #include <mitkCLResultXMLWriter.h>
 #include <mitkVersion.h>
@@ -52,6 +54,7 @@ found in the LICENSE file.
 
 #include <itkImageDuplicator.h>
 #include <itkImageRegionIterator.h>
+#include <itksys/SystemTools.hxx>
 
 
 #include "itkNearestNeighborInterpolateImageFunction.h"
@@ -359,7 +362,7 @@ void SaveSliceOrImageAsPNG(mitk::Image::Pointer image, mitk::Image::Pointer mask
   }
 }
 
-int main(int argc, char* argv[])
+static std::vector<mitk::AbstractGlobalImageFeature::Pointer> CreateFeatures()
 {
   // Commented : Updated to a common interface, include, if possible, mask is type unsigned short, uses Quantification, Comments
   //                                 Name follows standard scheme with Class Name::Feature Name
@@ -398,78 +401,69 @@ int main(int argc, char* argv[])
   features.push_back(gldzCalculator.GetPointer());
   features.push_back(ipCalculator.GetPointer());
   features.push_back(ngtdCalculator.GetPointer());
+  return features;
+}
 
-  mitkCommandLineParser parser;
-  parser.setArgumentPrefix("--", "-");
-  mitk::cl::GlobalImageFeaturesParameter param;
-  param.AddParameter(parser);
-
-  parser.addArgument("--","-", mitkCommandLineParser::String, "---", "---", us::Any(),true);
+static void ConfigureFeatures(const std::vector<mitk::AbstractGlobalImageFeature::Pointer> &features,
+                              const mitk::cl::GlobalImageFeaturesParameter &param,
+                              const std::map<std::string, us::Any> &parsedArgs,
+                              int direction)
+{
   for (auto cFeature : features)
   {
-    cFeature->AddArguments(parser);
-  }
-
-  parser.addArgument("--", "-", mitkCommandLineParser::String, "---", "---", us::Any(), true);
-  parser.addArgument("description","d",mitkCommandLineParser::String,"Text","Description that is added to the output",us::Any());
-  parser.addArgument("direction", "dir", mitkCommandLineParser::String, "Int", "Allows to specify the direction for Cooc and RL. 0: All directions, 1: Only single direction (Test purpose), 2,3,4... Without dimension 0,1,2... ", us::Any());
-  parser.addArgument("slice-wise", "slice", mitkCommandLineParser::String, "Int", "Allows to specify if the image is processed slice-wise (number giving direction) ", us::Any());
-  parser.addArgument("output-mode", "omode", mitkCommandLineParser::Int, "Int", "Defines the format of the output. 0: (Default) results of an image / slice are written in a single row;"
-    " 1: results of an image / slice are written in a single column; 2: store the result of on image as structured radiomocs report (XML).");
-
-  // Miniapp Infos
-  parser.setCategory("Classification Tools");
-  parser.setTitle("Global Image Feature calculator");
-  parser.setDescription("Calculates different global statistics for a given segmentation / image combination");
-  parser.setContributor("German Cancer Research Center (DKFZ)");
-
-  std::map<std::string, us::Any> parsedArgs = parser.parseArguments(argc, argv);
-  param.ParseParameter(parsedArgs);
-
-  if (parsedArgs.size()==0)
-  {
-    return EXIT_FAILURE;
-  }
-  if ( parsedArgs.count("help") || parsedArgs.count("h"))
-  {
-    return EXIT_SUCCESS;
-  }
-
-  std::string version = "Version: 1.23";
-  MITK_INFO << version;
-
-  std::ofstream log;
-  if (param.useLogfile)
-  {
-    log.open(param.logfilePath, std::ios::app);
-    log << std::endl;
-    log << version;
-    log << "Image: " << param.imagePath;
-    log << "Mask: " << param.maskPath;
+    if (param.defineGlobalMinimumIntensity)
+    {
+      cFeature->SetMinimumIntensity(param.globalMinimumIntensity);
+      cFeature->SetUseMinimumIntensity(true);
+    }
+    if (param.defineGlobalMaximumIntensity)
+    {
+      cFeature->SetMaximumIntensity(param.globalMaximumIntensity);
+      cFeature->SetUseMaximumIntensity(true);
+    }
+    if (param.defineGlobalNumberOfBins)
+    {
+      cFeature->SetBins(param.globalNumberOfBins);
+    }
+    cFeature->SetParameters(parsedArgs);
+    cFeature->SetDirection(direction);
+    cFeature->SetEncodeParametersInFeaturePrefix(param.encodeParameter);
   }
+}
 
+struct GlobalImageFeaturesCase
+{
+  std::string imagePath;
+  std::string maskPath;
+  std::string morphPath;
 
-  if (param.useDecimalPoint)
-  {
-    std::cout.imbue(std::locale(std::cout.getloc(), new punct_facet<char>(param.decimalPoint)));
-  }
+  //representing the original loaded image data without any prepropcessing that might come.
+  mitk::Image::Pointer loadedImage;
+  mitk::Image::Pointer loadedMask;
 
+  mitk::Image::Pointer image;
+  mitk::Image::Pointer mask;
+  mitk::Image::Pointer maskNoNaN;
+  mitk::Image::Pointer morphMask;
+};
 
-  //representing the original loaded image data without any prepropcessing that might come.
-  mitk::Image::Pointer loadedImage = mitk::IOUtil::Load<mitk::Image>(param.imagePath);
-  //representing the original loaded mask data without any prepropcessing that might come.
-  mitk::Image::Pointer loadedMask = mitk::IOUtil::Load<mitk::Image>(param.maskPath);
+/** Loads the images of a case and adapts image and mask to each other as requested by the parameters.
+Returns false if the case cannot be processed.*/
+static bool PrepareCase(const mitk::cl::GlobalImageFeaturesParameter &param, std::ofstream &log, GlobalImageFeaturesCase &currentCase)
+{
+  currentCase.loadedImage = mitk::IOUtil::Load<mitk::Image>(currentCase.imagePath);
+  currentCase.loadedMask = mitk::IOUtil::Load<mitk::Image>(currentCase.maskPath);
 
-  mitk::Image::Pointer image = loadedImage;
-  mitk::Image::Pointer mask = loadedMask;
+  mitk::Image::Pointer image = currentCase.loadedImage;
+  mitk::Image::Pointer mask = currentCase.loadedMask;
 
-  mitk::Image::Pointer tmpImage = loadedImage;
-  mitk::Image::Pointer tmpMask = loadedMask;
+  mitk::Image::Pointer tmpImage = currentCase.loadedImage;
+  mitk::Image::Pointer tmpMask = currentCase.loadedMask;
 
   mitk::Image::Pointer morphMask = mask;
-  if (param.useMorphMask)
+  if (!currentCase.morphPath.empty())
   {
-    morphMask = mitk::IOUtil::Load<mitk::Image>(param.morphPath);
+    morphMask = mitk::IOUtil::Load<mitk::Image>(currentCase.morphPath);
   }
 
   log << " Check for Dimensions -";
@@ -493,12 +487,6 @@ int main(int argc, char* argv[])
     }
   }
 
-  int writeDirection = 0;
-  if (parsedArgs.count("output-mode"))
-  {
-    writeDirection = us::any_cast<int>(parsedArgs["output-mode"]);
-  }
-
   log << " Check for Resolution -";
   if (param.resampleToFixIsotropic)
   {
@@ -526,7 +514,7 @@ int main(int argc, char* argv[])
       image->GetGeometry(0)->SetOrigin(mask->GetGeometry(0)->GetOrigin());
     } else
     {
-      return -1;
+      return false;
     }
   }
 
@@ -544,66 +532,268 @@ int main(int argc, char* argv[])
     {
       MITK_INFO << "The spacing of the mask and the input images is not equal.";
       MITK_INFO << "Terminating the program. You may use the '-fi' option";
-      return -1;
+      return false;
     }
   }
 
-  int direction = 0;
-  if (parsedArgs.count("direction"))
-  {
-    direction = mitk::cl::splitDouble(parsedArgs["direction"].ToString(), ';')[0];
-  }
-
   MITK_INFO << "Start creating Mask without NaN";
 
   mitk::Image::Pointer maskNoNaN = mitk::Image::New();
   AccessByItk_2(image, CreateNoNaNMask,  mask, maskNoNaN);
-  //CreateNoNaNMask(mask, image, maskNoNaN);
 
+  currentCase.image = image;
+  currentCase.mask = mask;
+  currentCase.maskNoNaN = maskNoNaN;
+  currentCase.morphMask = morphMask;
+  return true;
+}
 
-  bool sliceWise = false;
-  int sliceDirection = 0;
-  unsigned int currentSlice = 0;
-  bool imageToProcess = true;
+static void AddCaseResult(mitk::cl::FeatureResultWriter &writer,
+                          const std::string &description,
+                          bool addDescription,
+                          bool useHeader,
+                          const std::string &imagePath,
+                          const std::string &maskName,
+                          int slice,
+                          const mitk::AbstractGlobalImageFeature::FeatureListType &stats)
+{
+  writer.AddHeader(description, slice, stats, useHeader, addDescription);
+  writer.AddSubjectInformation(MITK_REVISION);
+  writer.AddSubjectInformation(itksys::SystemTools::GetFilenamePath(imagePath));
+  writer.AddSubjectInformation(itksys::SystemTools::GetFilenameName(imagePath));
+  writer.AddSubjectInformation(maskName);
+  writer.AddResult(description, slice, stats, useHeader, addDescription);
+}
 
-  std::vector<mitk::Image::Pointer> floatVector;
-  std::vector<mitk::Image::Pointer> maskVector;
-  std::vector<mitk::Image::Pointer> maskNoNaNVector;
-  std::vector<mitk::Image::Pointer> morphMaskVector;
+/** Processes all cases of the batch file. The cases are calculated in chunks that are processed concurrently,
+so that only a few cases are kept in memory. The results of a chunk are written before the next one is loaded.*/
+static int ProcessBatchFile(const mitk::cl::GlobalImageFeaturesParameter &param,
+                            mitk::GlobalImageFeaturesEngine &engine,
+                            mitk::cl::FeatureResultWriter &writer,
+                            const std::string &description,
+                            bool addDescription,
+                            std::ofstream &log)
+{
+  int returnCode = EXIT_SUCCESS;
 
-  if ((parsedArgs.count("slice-wise")) && image->GetDimension() > 2)
+  std::ifstream batchFile(param.batchFilePath);
+  if (!batchFile.good())
   {
-    MITK_INFO << "Enabled slice-wise";
-    sliceWise = true;
-    sliceDirection = mitk::cl::splitDouble(parsedArgs["slice-wise"].ToString(), ';')[0];
-    MITK_INFO << sliceDirection;
-    ExtractSlicesFromImages(image, mask, maskNoNaN, morphMask, sliceDirection, floatVector, maskVector, maskNoNaNVector, morphMaskVector);
-    MITK_INFO << "Slice";
+    MITK_ERROR << "Cannot read batch file " << param.batchFilePath;
+    return EXIT_FAILURE;
   }
 
-  log << " Configure features -";
-  for (auto cFeature : features)
+  std::vector<GlobalImageFeaturesCase> cases;
+  std::string line;
+  while (std::getline(batchFile, line))
   {
-    if (param.defineGlobalMinimumIntensity)
+    if (!line.empty() && line.back() == '\r')
+      line.pop_back();
+
+    if (line.empty() || line[0] == '#')
+      continue;
+
+    std::vector<std::string> paths;
+    std::stringstream lineStream(line);
+    std::string path;
+    while (std::getline(lineStream, path, ';'))
     {
-      cFeature->SetMinimumIntensity(param.globalMinimumIntensity);
-      cFeature->SetUseMinimumIntensity(true);
+      paths.push_back(path);
     }
-    if (param.defineGlobalMaximumIntensity)
+
+    if (paths.size() < 2)
     {
-      cFeature->SetMaximumIntensity(param.globalMaximumIntensity);
-      cFeature->SetUseMaximumIntensity(true);
+      MITK_ERROR << "Skipping invalid line of batch file: " << line;
+      returnCode = EXIT_FAILURE;
+      continue;
     }
-    if (param.defineGlobalNumberOfBins)
+
+    GlobalImageFeaturesCase currentCase;
+    currentCase.imagePath = paths[0];
+    currentCase.maskPath = paths[1];
+    if (paths.size() > 2)
     {
-      cFeature->SetBins(param.globalNumberOfBins);
-      MITK_INFO << param.globalNumberOfBins;
+      currentCase.morphPath = paths[2];
+    }
+    cases.push_back(currentCase);
+  }
+
+  const std::size_t casesPerChunk = engine.GetNumberOfThreads();
+
+  for (std::size_t first = 0; first < cases.size(); first += casesPerChunk)
+  {
+    const auto last = std::min(cases.size(), first + casesPerChunk);
+
+    std::vector<std::size_t> caseIndices;
+    std::vector<mitk::GlobalImageFeaturesEngine::Input> inputs;
+
+    for (auto i = first; i < last; ++i)
+    {
+      log << " Prepare " << cases[i].imagePath << " -";
+      bool isPrepared = false;
+      try
+      {
+        isPrepared = PrepareCase(param, log, cases[i]);
+      }
+      catch (const std::exception &e)
+      {
+        MITK_ERROR << e.what();
+      }
+
+      if (!isPrepared)
+      {
+        MITK_ERROR << "Skipping case " << cases[i].imagePath << ";" << cases[i].maskPath;
+        returnCode = EXIT_FAILURE;
+        continue;
+      }
+
+      caseIndices.push_back(i);
+      inputs.push_back({ cases[i].image, cases[i].mask, cases[i].maskNoNaN, cases[i].morphMask });
+    }
+
+    std::vector<mitk::AbstractGlobalImageFeature::FeatureListType> allStats;
+    std::vector<bool> isCalculated(inputs.size(), true);
+
+    log << " Calculating features -";
+    try
+    {
+      allStats = engine.CalculateFeatures(inputs);
+    }
+    catch (const std::exception &e)
+    {
+      // Find out which cases fail by calculating them one after another
+      MITK_WARN << "Feature calculation of a chunk failed: " << e.what();
+      allStats.resize(inputs.size());
+      for (std::size_t i = 0; i < inputs.size(); ++i)
+      {
+        try
+        {
+          allStats[i] = engine.CalculateFeatures(inputs[i]);
+        }
+        catch (const std::exception &caseException)
+        {
+          MITK_ERROR << "Skipping case " << cases[caseIndices[i]].imagePath << ": " << caseException.what();
+          isCalculated[i] = false;
+          returnCode = EXIT_FAILURE;
+        }
+      }
+    }
+
+    for (std::size_t i = 0; i < inputs.size(); ++i)
+    {
+      if (!isCalculated[i])
+        continue;
+
+      const auto &currentCase = cases[caseIndices[i]];
+      AddCaseResult(writer, description, addDescription, param.useHeader, currentCase.imagePath,
+        itksys::SystemTools::GetFilenameName(currentCase.maskPath), 0, allStats[i]);
+    }
+    writer.Flush();
+
+    // Release the images of the chunk
+    for (auto i = first; i < last; ++i)
+    {
+      cases[i] = GlobalImageFeaturesCase{ cases[i].imagePath, cases[i].maskPath, cases[i].morphPath };
     }
-    cFeature->SetParameters(parsedArgs);
-    cFeature->SetDirection(direction);
-    cFeature->SetEncodeParametersInFeaturePrefix(param.encodeParameter);
   }
 
+  return returnCode;
+}
+
+int main(int argc, char* argv[])
+{
+  // Only used to add the arguments to the parser, every image is processed by its own instances
+  auto features = CreateFeatures();
+
+  mitkCommandLineParser parser;
+  parser.setArgumentPrefix("--", "-");
+  mitk::cl::GlobalImageFeaturesParameter param;
+  param.AddParameter(parser);
+
+  parser.addArgument("--","-", mitkCommandLineParser::String, "---", "---", us::Any(),true);
+  for (auto cFeature : features)
+  {
+    cFeature->AddArguments(parser);
+  }
+
+  parser.addArgument("--", "-", mitkCommandLineParser::String, "---", "---", us::Any(), true);
+  parser.addArgument("description","d",mitkCommandLineParser::String,"Text","Description that is added to the output",us::Any());
+  parser.addArgument("direction", "dir", mitkCommandLineParser::String, "Int", "Allows to specify the direction for Cooc and RL. 0: All directions, 1: Only single direction (Test purpose), 2,3,4... Without dimension 0,1,2... ", us::Any());
+  parser.addArgument("slice-wise", "slice", mitkCommandLineParser::String, "Int", "Allows to specify if the image is processed slice-wise (number giving direction) ", us::Any());
+  parser.addArgument("output-mode", "omode", mitkCommandLineParser::Int, "Int", "Defines the format of the output. 0: (Default) results of an image / slice are written in a single row;"
+    " 1: results of an image / slice are written in a single column; 2: store the result of on image as structured radiomocs report (XML).");
+
+  // Miniapp Infos
+  parser.setCategory("Classification Tools");
+  parser.setTitle("Global Image Feature calculator");
+  parser.setDescription("Calculates different global statistics for a given segmentation / image combination");
+  parser.setContributor("German Cancer Research Center (DKFZ)");
+
+  std::map<std::string, us::Any> parsedArgs = parser.parseArguments(argc, argv);
+  param.ParseParameter(parsedArgs);
+
+  if (parsedArgs.size()==0)
+  {
+    return EXIT_FAILURE;
+  }
+  if ( parsedArgs.count("help") || parsedArgs.count("h"))
+  {
+    return EXIT_SUCCESS;
+  }
+
+  if (!param.useBatchFile && (param.imagePath.empty() || param.maskPath.empty()))
+  {
+    MITK_ERROR << "Either an image and a mask or a batch file has to be specified.";
+    return EXIT_FAILURE;
+  }
+
+  std::string version = "Version: 1.24";
+  MITK_INFO << version;
+
+  std::ofstream log;
+  if (param.useLogfile)
+  {
+    log.open(param.logfilePath, std::ios::app);
+    log << std::endl;
+    log << version;
+    if (param.useBatchFile)
+    {
+      log << "Batch: " << param.batchFilePath;
+    }
+    else
+    {
+      log << "Image: " << param.imagePath;
+      log << "Mask: " << param.maskPath;
+    }
+  }
+
+
+  if (param.useDecimalPoint)
+  {
+    std::cout.imbue(std::locale(std::cout.getloc(), new punct_facet<char>(param.decimalPoint)));
+  }
+
+  int writeDirection = 0;
+  if (parsedArgs.count("output-mode"))
+  {
+    writeDirection = us::any_cast<int>(parsedArgs["output-mode"]);
+  }
+
+  int direction = 0;
+  if (parsedArgs.count("direction"))
+  {
+    direction = mitk::cl::splitDouble(parsedArgs["direction"].ToString(), ';')[0];
+  }
+
+  log << " Configure features -";
+  mitk::GlobalImageFeaturesEngine engine([&param, &parsedArgs, direction]() {
+    auto caseFeatures = CreateFeatures();
+    ConfigureFeatures(caseFeatures, param, parsedArgs, direction);
+    return caseFeatures;
+  });
+  engine.SetNumberOfThreads(param.numberOfThreads);
+  engine.SetCheckParameterActivation(!param.calculateAllFeatures);
+
   bool addDescription = parsedArgs.count("description");
   mitk::cl::FeatureResultWriter writer(param.outputPath, writeDirection);
 
@@ -618,11 +808,6 @@ int main(int argc, char* argv[])
     description = parsedArgs["description"].ToString();
   }
 
-  mitk::Image::Pointer cImage = image;
-  mitk::Image::Pointer cMask = mask;
-  mitk::Image::Pointer cMaskNoNaN = maskNoNaN;
-  mitk::Image::Pointer cMorphMask = morphMask;
-
   if (param.useHeader)
   {
     writer.AddColumn("SoftwareVersion");
@@ -631,29 +816,90 @@ int main(int argc, char* argv[])
     writer.AddColumn("Segmentation");
   }
 
+  if (param.useBatchFile)
+  {
+    if (parsedArgs.count("slice-wise") || !param.outputXMLPath.empty() || param.writePNGScreenshots ||
+        param.writeAnalysisImage || param.writeAnalysisMask)
+    {
+      MITK_WARN << "Slice-wise processing, XML output, screenshots and saving the analysed images are ignored in batch mode.";
+    }
+
+    log << " Process Batch -";
+    int returnCode = ProcessBatchFile(param, engine, writer, description, addDescription, log);
+
+    if (param.useLogfile)
+    {
+      log << "Finished calculation" << std::endl;
+      log.close();
+    }
+    return returnCode;
+  }
+
+  GlobalImageFeaturesCase singleCase;
+  singleCase.imagePath = param.imagePath;
+  singleCase.maskPath = param.maskPath;
+  if (param.useMorphMask)
+  {
+    singleCase.morphPath = param.morphPath;
+  }
+
+  if (!PrepareCase(param, log, singleCase))
+  {
+    return -1;
+  }
+
+  mitk::Image::Pointer image = singleCase.image;
+
+  bool sliceWise = false;
+  int sliceDirection = 0;
+  unsigned int currentSlice = 0;
+
+  std::vector<mitk::GlobalImageFeaturesEngine::Input> inputs;
+
+  if ((parsedArgs.count("slice-wise")) && image->GetDimension() > 2)
+  {
+    MITK_INFO << "Enabled slice-wise";
+    sliceWise = true;
+    sliceDirection = mitk::cl::splitDouble(parsedArgs["slice-wise"].ToString(), ';')[0];
+    MITK_INFO << sliceDirection;
+
+    std::vector<mitk::Image::Pointer> floatVector;
+    std::vector<mitk::Image::Pointer> maskVector;
+    std::vector<mitk::Image::Pointer> maskNoNaNVector;
+    std::vector<mitk::Image::Pointer> morphMaskVector;
+    ExtractSlicesFromImages(image, singleCase.mask, singleCase.maskNoNaN, singleCase.morphMask, sliceDirection, floatVector, maskVector, maskNoNaNVector, morphMaskVector);
+    MITK_INFO << "Slice";
+
+    for (std::size_t i = 0; i < floatVector.size(); ++i)
+    {
+      inputs.push_back({ floatVector[i], maskVector[i], maskNoNaNVector[i], morphMaskVector[i] });
+    }
+
+    if (inputs.empty())
+    {
+      MITK_ERROR << "No slice contains voxels of the mask.";
+      return EXIT_FAILURE;
+    }
+  }
+  else
+  {
+    inputs.push_back({ image, singleCase.mask, singleCase.maskNoNaN, singleCase.morphMask });
+  }
+
   // Create a QTApplication and a Datastorage
   // This is necessary in order to save screenshots of
   // each image / slice.
   QApplication qtapplication(argc, argv);
   QmitkRegisterClasses();
 
-  std::vector<mitk::AbstractGlobalImageFeature::FeatureListType> allStats;
-
+  // The feature classes and slices are calculated concurrently
   log << " Begin Processing -";
-  while (imageToProcess)
+  std::vector<mitk::AbstractGlobalImageFeature::FeatureListType> allStats = engine.CalculateFeatures(inputs);
+
+  for (currentSlice = 0; currentSlice < inputs.size(); ++currentSlice)
   {
-    if (sliceWise)
-    {
-      cImage = floatVector[currentSlice];
-      cMask = maskVector[currentSlice];
-      cMaskNoNaN = maskNoNaNVector[currentSlice];
-      cMorphMask = morphMaskVector[currentSlice];
-      imageToProcess = (floatVector.size()-1 > (currentSlice)) ? true : false ;
-    }
-    else
-    {
-      imageToProcess = false;
-    }
+    mitk::Image::Pointer cImage = inputs[currentSlice].image;
+    mitk::Image::Pointer cMask = inputs[currentSlice].mask;
 
     if (param.writePNGScreenshots)
     {
@@ -668,32 +914,14 @@ int main(int argc, char* argv[])
       mitk::IOUtil::Save(cMask, param.analysisMaskPath);
     }
 
-    mitk::AbstractGlobalImageFeature::FeatureListType stats;
-
-    for (auto cFeature : features)
-    {
-      log << " Calculating " << cFeature->GetFeatureClassName() << " -";
-      cFeature->SetMorphMask(cMorphMask);
-      cFeature->CalculateAndAppendFeatures(cImage, cMask, cMaskNoNaN, stats, !param.calculateAllFeatures);
-    }
+    const auto &stats = allStats[currentSlice];
 
     for (std::size_t i = 0; i < stats.size(); ++i)
     {
       std::cout << stats[i].first.legacyName << " - " << stats[i].second << std::endl;
     }
 
-    writer.AddHeader(description, currentSlice, stats, param.useHeader, addDescription);
-    if (true)
-    {
-      writer.AddSubjectInformation(MITK_REVISION);
-      writer.AddSubjectInformation(param.imageFolder);
-      writer.AddSubjectInformation(param.imageName);
-      writer.AddSubjectInformation(param.maskName);
-    }
-    writer.AddResult(description, currentSlice, stats, param.useHeader, addDescription);
-
-    allStats.push_back(stats);
-    ++currentSlice;
+    AddCaseResult(writer, description, addDescription, param.useHeader, param.imagePath, param.maskName, currentSlice, stats);
   }
 
   log << " Process Slicewise -";
@@ -765,8 +993,8 @@ int main(int argc, char* argv[])
       mitk::cl::CLResultXMLWriter xmlWriter;
       xmlWriter.SetCLIArgs(parsedArgs);
       xmlWriter.SetFeatures(allStats.front());
-      xmlWriter.SetImage(loadedImage);
-      xmlWriter.SetMask(loadedMask);
+      xmlWriter.SetImage(singleCase.loadedImage);
+      xmlWriter.SetMask(singleCase.loadedMask);
       xmlWriter.SetMethodName("CLGlobalImageFeatures");
       xmlWriter.SetMethodVersion(version + "(mitk: " MITK_VERSION_STRING+")");
       xmlWriter.SetOrganisation("German Cancer Research Center (DKFZ)");
@@ -41,6 +41,10 @@ namespace mitk
       void AddResult(std::string desc, int slice, mitk::AbstractGlobalImageFeature::FeatureListType stats, bool , bool withDescription);
       void AddHeader(std::string, int slice, mitk::AbstractGlobalImageFeature::FeatureListType stats, bool withHeader, bool withDescription);
 
+      /** Writes all completed rows to the file. Only has an effect if the results are written row-wise
+      (mode 0 and 2), otherwise the output is written on destruction.*/
+      void Flush();
+
     private:
       int m_Mode;
       std::size_t m_CurrentRow;
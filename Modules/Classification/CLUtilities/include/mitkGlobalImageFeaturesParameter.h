@@ -37,6 +37,10 @@ namespace mitk
       std::string outputPath;
       std::string outputXMLPath;
 
+      bool useBatchFile;
+      std::string batchFilePath;
+      unsigned int numberOfThreads;
+
       std::string morphPath;
       std::string morphName;
       bool useMorphMask;
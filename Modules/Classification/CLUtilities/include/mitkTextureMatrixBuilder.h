@@ -0,0 +1,546 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#ifndef mitkTextureMatrixBuilder_h
+#define mitkTextureMatrixBuilder_h
+
+#include <mitkExceptionMacro.h>
+
+#include <itkImage.h>
+#include <itkImageRegionConstIteratorWithIndex.h>
+#include <itkEnhancedScalarImageToRunLengthMatrixFilter.h>
+
+#include <itkeigen/Eigen/Dense>
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace mitk
+{
+  /**
+  * \brief Builds the co-occurrence and run-length matrices of several offsets in one pass over the masked voxels.
+  *
+  * The constructor compacts the masked voxels of the bounding box of the mask into a list in raster
+  * order. Update() then fills the matrices of all requested offsets while walking this list once. The
+  * list is split into chunks that are processed by a pool of threads with matrices per thread, which
+  * are added up at the end. Run-lengths depend on the raster order, therefore each run-length offset
+  * is a task of the same pool that walks the list on its own.
+  *
+  * The co-occurrence matrices follow the binning of GIFCooccurenceMatrix2: an intensity is mapped to
+  * \f$ \lfloor (i - min) / binsize \rfloor \f$, clamped to the valid bins. Voxels with a mask value
+  * greater than zero are used and every pair is counted in both orders, so the matrices are symmetric.
+  *
+  * The run-length matrices are identical to those of itk::Statistics::EnhancedScalarImageToRunLengthMatrixFilter
+  * with a distance range of [0, number of bins]: the rows are the intensity bins, the columns the
+  * number of steps of a run. Only voxels with a mask value of one are used. CreateRunLengthHistogram()
+  * converts a matrix into the histogram of that filter, e.g. for itk::Statistics::EnhancedHistogramToRunLengthFeaturesFilter.
+  *
+  * Voxels with a NaN intensity are ignored. The mask is expected to have the same region as the image.
+  */
+  template <typename TPixel, unsigned int VImageDimension>
+  class TextureMatrixBuilder
+  {
+  public:
+    typedef itk::Image<TPixel, VImageDimension> ImageType;
+    typedef itk::Image<unsigned short, VImageDimension> MaskType;
+    typedef itk::Offset<VImageDimension> OffsetType;
+    typedef std::vector<OffsetType> OffsetVectorType;
+    typedef Eigen::MatrixXd MatrixType;
+    typedef std::vector<MatrixType> MatrixVectorType;
+    typedef typename itk::Statistics::EnhancedScalarImageToRunLengthMatrixFilter<ImageType>::HistogramType RunLengthHistogramType;
+
+    TextureMatrixBuilder(const ImageType *image, const MaskType *mask)
+      : m_NumberOfThreads(0),
+        m_NumberOfMaskedVoxels(0),
+        m_CooccurrenceMinimum(0),
+        m_CooccurrenceMaximum(0),
+        m_CooccurrenceBins(0),
+        m_RunLengthMinimum(0),
+        m_RunLengthMaximum(0),
+        m_RunLengthBins(0)
+    {
+      if (nullptr == image || nullptr == mask)
+        mitkThrow() << "TextureMatrixBuilder requires an image and a mask.";
+
+      if (image->GetLargestPossibleRegion() != mask->GetLargestPossibleRegion())
+        mitkThrow() << "TextureMatrixBuilder requires an image and a mask with the same region.";
+
+      this->CompactVoxels(image, mask);
+    }
+
+    /** Number of threads used by Update(). 0 (default) uses the number of hardware threads.*/
+    void SetNumberOfThreads(unsigned int numberOfThreads) { m_NumberOfThreads = numberOfThreads; }
+
+    void SetCooccurrenceBinning(double minimum, double maximum, int bins)
+    {
+      m_CooccurrenceMinimum = minimum;
+      m_CooccurrenceMaximum = maximum;
+      m_CooccurrenceBins = bins;
+    }
+
+    /** Offsets of the co-occurrence matrices. Each offset gets its own matrix.*/
+    void SetCooccurrenceOffsets(const OffsetVectorType &offsets) { m_CooccurrenceOffsets = offsets; }
+
+    void SetRunLengthBinning(TPixel minimum, TPixel maximum, int bins)
+    {
+      m_RunLengthMinimum = minimum;
+      m_RunLengthMaximum = maximum;
+      m_RunLengthBins = bins;
+    }
+
+    /** Offsets of the run-length matrices. Each offset gets its own matrix.*/
+    void SetRunLengthOffsets(const OffsetVectorType &offsets) { m_RunLengthOffsets = offsets; }
+
+    /** Number of voxels with a mask value greater than zero, including those with a NaN intensity.*/
+    std::size_t GetNumberOfMaskedVoxels() const { return m_NumberOfMaskedVoxels; }
+
+    const MatrixVectorType &GetCooccurrenceMatrices() const { return m_CooccurrenceMatrices; }
+    const MatrixVectorType &GetRunLengthMatrices() const { return m_RunLengthMatrices; }
+
+    void Update()
+    {
+      if (!m_CooccurrenceOffsets.empty() && m_CooccurrenceBins < 1)
+        mitkThrow() << "TextureMatrixBuilder requires at least one co-occurrence bin.";
+
+      if (!m_RunLengthOffsets.empty() && m_RunLengthBins < 1)
+        mitkThrow() << "TextureMatrixBuilder requires at least one run-length bin.";
+
+      m_CooccurrenceMatrices.assign(m_CooccurrenceOffsets.size(), MatrixType::Zero(m_CooccurrenceBins, m_CooccurrenceBins));
+      m_RunLengthMatrices.assign(m_RunLengthOffsets.size(), MatrixType::Zero(m_RunLengthBins, m_RunLengthBins));
+
+      this->PrepareCooccurrence();
+      this->PrepareRunLength();
+
+      const unsigned int numberOfThreads = 0 != m_NumberOfThreads
+        ? m_NumberOfThreads
+        : std::max(1u, std::thread::hardware_concurrency());
+
+      // The first tasks are the run-lengths, as a single one takes longer than a chunk of the co-occurrence
+      const std::size_t numberOfRunLengthTasks = m_RunLengthOffsets.size();
+      const std::size_t numberOfChunks = m_CooccurrenceOffsets.empty() || m_Voxels.empty()
+        ? 0
+        : std::min<std::size_t>(m_Voxels.size(), 4 * numberOfThreads);
+      const std::size_t numberOfTasks = numberOfRunLengthTasks + numberOfChunks;
+
+      const std::size_t numberOfWorkers = std::max<std::size_t>(1, std::min<std::size_t>(numberOfThreads, numberOfTasks));
+      std::vector<MatrixVectorType> cooccurrenceMatricesOfWorkers(numberOfWorkers, m_CooccurrenceMatrices);
+
+      std::atomic<std::size_t> nextTask(0);
+      std::exception_ptr error;
+      std::mutex errorMutex;
+
+      auto worker = [&](std::size_t workerIndex) {
+        for (auto task = nextTask++; task < numberOfTasks; task = nextTask++)
+        {
+          try
+          {
+            if (task < numberOfRunLengthTasks)
+            {
+              this->FillRunLengthMatrix(task);
+            }
+            else
+            {
+              const auto chunk = task - numberOfRunLengthTasks;
+              const auto begin = chunk * m_Voxels.size() / numberOfChunks;
+              const auto end = (chunk + 1) * m_Voxels.size() / numberOfChunks;
+              this->FillCooccurrenceMatrices(begin, end, cooccurrenceMatricesOfWorkers[workerIndex]);
+            }
+          }
+          catch (...)
+          {
+            std::lock_guard<std::mutex> lock(errorMutex);
+
+            if (!error)
+              error = std::current_exception();
+
+            nextTask = numberOfTasks;
+          }
+        }
+      };
+
+      std::vector<std::thread> threads;
+
+      for (std::size_t i = 1; i < numberOfWorkers; ++i)
+        threads.emplace_back(worker, i);
+
+      worker(0);
+
+      for (auto &thread : threads)
+        thread.join();
+
+      if (error)
+        std::rethrow_exception(error);
+
+      for (const auto &matrices : cooccurrenceMatricesOfWorkers)
+      {
+        for (std::size_t i = 0; i < matrices.size(); ++i)
+          m_CooccurrenceMatrices[i] += matrices[i];
+      }
+    }
+
+    /** \brief Creates the histogram of itk::Statistics::EnhancedScalarImageToRunLengthMatrixFilter with the
+    * frequencies of a run-length matrix, e.g. of GetRunLengthMatrices() or the sum of them.*/
+    typename RunLengthHistogramType::Pointer CreateRunLengthHistogram(const MatrixType &matrix) const
+    {
+      auto histogram = this->CreateEmptyRunLengthHistogram();
+
+      typename RunLengthHistogramType::IndexType index(2);
+      for (int i = 0; i < m_RunLengthBins; ++i)
+      {
+        for (int j = 0; j < m_RunLengthBins; ++j)
+        {
+          index[0] = i;
+          index[1] = j;
+          histogram->SetFrequencyOfIndex(index, matrix(i, j));
+        }
+      }
+      return histogram;
+    }
+
+  private:
+    typedef typename ImageType::RegionType RegionType;
+    typedef typename ImageType::IndexType IndexType;
+    typedef typename RunLengthHistogramType::MeasurementType MeasurementType;
+
+    enum VoxelFlags : unsigned char
+    {
+      /** Mask value greater than zero and a valid intensity*/
+      CooccurrenceVoxel = 1,
+      /** Mask value equal to one and a valid intensity*/
+      RunLengthVoxel = 2
+    };
+
+    void CompactVoxels(const ImageType *image, const MaskType *mask)
+    {
+      // Only the bounding box of the masked voxels can contribute to a matrix
+      IndexType lower, upper;
+      lower.Fill(itk::NumericTraits<itk::IndexValueType>::max());
+      upper.Fill(itk::NumericTraits<itk::IndexValueType>::NonpositiveMin());
+      bool hasVoxels = false;
+
+      itk::ImageRegionConstIteratorWithIndex<MaskType> maskIter(mask, mask->GetLargestPossibleRegion());
+      for (; !maskIter.IsAtEnd(); ++maskIter)
+      {
+        if (maskIter.Get() == 0)
+          continue;
+
+        ++m_NumberOfMaskedVoxels;
+
+        const auto value = image->GetPixel(maskIter.GetIndex());
+        if (value != value)
+          continue;
+
+        const auto index = maskIter.GetIndex();
+        for (unsigned int d = 0; d < VImageDimension; ++d)
+        {
+          lower[d] = std::min(lower[d], index[d]);
+          upper[d] = std::max(upper[d], index[d]);
+        }
+        hasVoxels = true;
+      }
+
+      if (!hasVoxels)
+        return;
+
+      typename RegionType::SizeType size;
+      for (unsigned int d = 0; d < VImageDimension; ++d)
+        size[d] = upper[d] - lower[d] + 1;
+
+      m_Region.SetIndex(lower);
+      m_Region.SetSize(size);
+
+      itk::OffsetValueType stride = 1;
+      for (unsigned int d = 0; d < VImageDimension; ++d)
+      {
+        m_Strides[d] = stride;
+        stride *= size[d];
+      }
+
+      m_Values.resize(m_Region.GetNumberOfPixels());
+      m_Flags.assign(m_Region.GetNumberOfPixels(), 0);
+
+      itk::ImageRegionConstIteratorWithIndex<ImageType> imageIter(image, m_Region);
+      itk::ImageRegionConstIteratorWithIndex<MaskType> regionMaskIter(mask, m_Region);
+      for (std::size_t i = 0; !imageIter.IsAtEnd(); ++imageIter, ++regionMaskIter, ++i)
+      {
+        const auto value = imageIter.Get();
+        const auto maskValue = regionMaskIter.Get();
+        m_Values[i] = value;
+
+        if (value != value || maskValue == 0)
+          continue;
+
+        m_Flags[i] = CooccurrenceVoxel | (maskValue == 1 ? RunLengthVoxel : 0);
+        m_Voxels.push_back(i);
+      }
+    }
+
+    IndexType GetRelativeIndex(std::size_t voxel) const
+    {
+      auto remainder = static_cast<itk::OffsetValueType>(voxel);
+
+      IndexType index;
+      for (int d = VImageDimension - 1; d >= 0; --d)
+      {
+        index[d] = remainder / m_Strides[d];
+        remainder -= index[d] * m_Strides[d];
+      }
+      return index;
+    }
+
+    bool IsInside(const IndexType &relativeIndex) const
+    {
+      for (unsigned int d = 0; d < VImageDimension; ++d)
+      {
+        if (relativeIndex[d] < 0 || relativeIndex[d] >= static_cast<itk::IndexValueType>(m_Region.GetSize(d)))
+          return false;
+      }
+      return true;
+    }
+
+    itk::OffsetValueType OffsetToStep(const OffsetType &offset) const
+    {
+      itk::OffsetValueType step = 0;
+      for (unsigned int d = 0; d < VImageDimension; ++d)
+        step += offset[d] * m_Strides[d];
+      return step;
+    }
+
+    void PrepareCooccurrence()
+    {
+      m_CooccurrenceBinOfVoxel.clear();
+
+      if (m_CooccurrenceOffsets.empty())
+        return;
+
+      const double stepsize = (m_CooccurrenceMaximum - m_CooccurrenceMinimum) / m_CooccurrenceBins;
+
+      m_CooccurrenceBinOfVoxel.assign(m_Values.size(), -1);
+      for (auto voxel : m_Voxels)
+      {
+        int index = std::floor((m_Values[voxel] - m_CooccurrenceMinimum) / stepsize);
+        m_CooccurrenceBinOfVoxel[voxel] = std::max(0, std::min(index, m_CooccurrenceBins - 1));
+      }
+    }
+
+    void PrepareRunLength()
+    {
+      m_RunLengthHistogram = nullptr;
+      m_CenterBinMinimum.clear();
+      m_CenterBinMaximum.clear();
+
+      if (m_RunLengthOffsets.empty())
+        return;
+
+      m_RunLengthHistogram = this->CreateEmptyRunLengthHistogram();
+      m_LastBinMaximum = m_RunLengthHistogram->GetDimensionMaxs(0)[m_RunLengthHistogram->GetSize(0) - 1];
+
+      // The bin limits of a voxel are the same for all offsets
+      m_CenterBinMinimum.resize(m_Voxels.size());
+      m_CenterBinMaximum.resize(m_Voxels.size());
+      for (std::size_t i = 0; i < m_Voxels.size(); ++i)
+      {
+        const auto value = m_Values[m_Voxels[i]];
+        m_CenterBinMinimum[i] = m_RunLengthHistogram->GetBinMinFromValue(0, value);
+        m_CenterBinMaximum[i] = m_RunLengthHistogram->GetBinMaxFromValue(0, value);
+      }
+    }
+
+    typename RunLengthHistogramType::Pointer CreateEmptyRunLengthHistogram() const
+    {
+      auto histogram = RunLengthHistogramType::New();
+      histogram->SetMeasurementVectorSize(2);
+
+      typename RunLengthHistogramType::SizeType size(2);
+      size.Fill(m_RunLengthBins);
+
+      typename RunLengthHistogramType::MeasurementVectorType lowerBound(2), upperBound(2);
+      lowerBound[0] = m_RunLengthMinimum;
+      lowerBound[1] = 0;
+      upperBound[0] = m_RunLengthMaximum;
+      upperBound[1] = m_RunLengthBins;
+
+      histogram->Initialize(size, lowerBound, upperBound);
+      return histogram;
+    }
+
+    void FillCooccurrenceMatrices(std::size_t begin, std::size_t end, MatrixVectorType &matrices) const
+    {
+      std::vector<itk::OffsetValueType> steps;
+      for (const auto &offset : m_CooccurrenceOffsets)
+        steps.push_back(this->OffsetToStep(offset));
+
+      for (auto i = begin; i < end; ++i)
+      {
+        const auto voxel = m_Voxels[i];
+        const auto relativeIndex = this->GetRelativeIndex(voxel);
+        const int binOfVoxel = m_CooccurrenceBinOfVoxel[voxel];
+
+        for (std::size_t k = 0; k < m_CooccurrenceOffsets.size(); ++k)
+        {
+          if (!this->IsInside(relativeIndex + m_CooccurrenceOffsets[k]))
+            continue;
+
+          const auto neighbour = voxel + steps[k];
+          if (!(m_Flags[neighbour] & CooccurrenceVoxel))
+            continue;
+
+          const int binOfNeighbour = m_CooccurrenceBinOfVoxel[neighbour];
+          matrices[k](binOfVoxel, binOfNeighbour) += 1;
+          matrices[k](binOfNeighbour, binOfVoxel) += 1;
+        }
+      }
+    }
+
+    void FillRunLengthMatrix(std::size_t offsetIndex)
+    {
+      // Same direction as itk::Statistics::EnhancedScalarImageToRunLengthMatrixFilter::NormalizeOffsetDirection
+      OffsetType offset = m_RunLengthOffsets[offsetIndex];
+      int sign = 1;
+      bool metLastNonZero = false;
+      for (int d = VImageDimension - 1; d >= 0; --d)
+      {
+        if (metLastNonZero)
+        {
+          offset[d] *= sign;
+        }
+        else if (offset[d] != 0)
+        {
+          sign = (offset[d] > 0) ? 1 : -1;
+          metLastNonZero = true;
+          offset[d] *= sign;
+        }
+      }
+
+      const auto step = this->OffsetToStep(offset);
+      auto &matrix = m_RunLengthMatrices[offsetIndex];
+      std::vector<bool> visited(m_Values.size(), false);
+
+      typename RunLengthHistogramType::MeasurementVectorType run(2);
+      typename RunLengthHistogramType::IndexType histogramIndex(2);
+
+      for (std::size_t i = 0; i < m_Voxels.size(); ++i)
+      {
+        const auto center = m_Voxels[i];
+        const TPixel centerValue = m_Values[center];
+
+        if (!(m_Flags[center] & RunLengthVoxel) || visited[center] ||
+            centerValue < m_RunLengthMinimum || centerValue > m_RunLengthMaximum)
+          continue;
+
+        const MeasurementType binMinimum = m_CenterBinMinimum[i];
+        const MeasurementType binMaximum = m_CenterBinMaximum[i];
+
+        auto isInBin = [&](TPixel value) {
+          return value >= binMinimum &&
+                 (value < binMaximum || (value == binMaximum && binMaximum == m_LastBinMaximum));
+        };
+
+        const auto centerIndex = this->GetRelativeIndex(center);
+        int steps = 0;
+        bool alreadyVisited = false;
+
+        // Voxels outside of the bounding box are never part of a run
+        auto index = centerIndex + offset;
+        auto voxel = center + step;
+        while (this->IsInside(index))
+        {
+          if (visited[voxel])
+          {
+            alreadyVisited = true;
+            break;
+          }
+
+          if (!(m_Flags[voxel] & RunLengthVoxel) || !isInBin(m_Values[voxel]))
+            break;
+
+          visited[voxel] = true;
+          index += offset;
+          voxel += step;
+          ++steps;
+        }
+
+        if (alreadyVisited)
+          continue;
+
+        index = centerIndex - offset;
+        voxel = center - step;
+        while (this->IsInside(index))
+        {
+          const auto value = m_Values[voxel];
+          if (value != value)
+            break;
+
+          if (visited[voxel])
+          {
+            alreadyVisited = isInBin(value);
+            break;
+          }
+
+          if (!(m_Flags[voxel] & RunLengthVoxel) || !isInBin(value))
+            break;
+
+          visited[voxel] = true;
+          index -= offset;
+          voxel -= step;
+          ++steps;
+        }
+
+        if (alreadyVisited || steps > m_RunLengthBins)
+          continue;
+
+        run[0] = centerValue;
+        run[1] = steps;
+        if (m_RunLengthHistogram->GetIndex(run, histogramIndex))
+          matrix(histogramIndex[0], histogramIndex[1]) += 1;
+      }
+    }
+
+    unsigned int m_NumberOfThreads;
+    std::size_t m_NumberOfMaskedVoxels;
+
+    /** Bounding box of the masked voxels and the strides of a voxel position within it*/
+    RegionType m_Region;
+    itk::OffsetValueType m_Strides[VImageDimension];
+
+    /** Intensities and flags of all voxels of the bounding box*/
+    std::vector<TPixel> m_Values;
+    std::vector<unsigned char> m_Flags;
+
+    /** Positions of the masked voxels within the bounding box, in raster order*/
+    std::vector<std::size_t> m_Voxels;
+
+    double m_CooccurrenceMinimum;
+    double m_CooccurrenceMaximum;
+    int m_CooccurrenceBins;
+    OffsetVectorType m_CooccurrenceOffsets;
+    std::vector<int> m_CooccurrenceBinOfVoxel;
+    MatrixVectorType m_CooccurrenceMatrices;
+
+    TPixel m_RunLengthMinimum;
+    TPixel m_RunLengthMaximum;
+    int m_RunLengthBins;
+    OffsetVectorType m_RunLengthOffsets;
+    typename RunLengthHistogramType::Pointer m_RunLengthHistogram;
+    MeasurementType m_LastBinMaximum;
+    std::vector<MeasurementType> m_CenterBinMinimum;
+    std::vector<MeasurementType> m_CenterBinMaximum;
+    MatrixVectorType m_RunLengthMatrices;
+  };
+}
+
+#endif
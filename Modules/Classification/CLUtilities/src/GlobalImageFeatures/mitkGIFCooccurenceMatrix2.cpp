@@ -16,11 +16,10 @@ found in the LICENSE file.
 #include <mitkITKImageImport.h>
 #include <mitkImageCast.h>
 #include <mitkImageAccessByItk.h>
+#include <mitkTextureMatrixBuilder.h>
 
 // ITK
-#include <itkEnhancedScalarImageToTextureFeaturesFilter.h>
-#include <itkShapedNeighborhoodIterator.h>
-#include <itkImageRegionConstIterator.h>
+#include <itkNeighborhood.h>
 
 // STL
 #include <sstream>
@@ -209,56 +208,6 @@ double mitk::CoocurenceMatrixHolder::IndexToMaxIntensity(int index)
   return m_MinimumRange + (index + 1) * m_Stepsize;
 }
 
-template<typename TPixel, unsigned int VImageDimension>
-void
-CalculateCoOcMatrix(const itk::Image<TPixel, VImageDimension>* itkImage,
-                    const itk::Image<unsigned short, VImageDimension>* mask,
-                    itk::Offset<VImageDimension> offset,
-                    int range,
-                    mitk::CoocurenceMatrixHolder &holder)
-{
-  typedef itk::Image<TPixel, VImageDimension> ImageType;
-  typedef itk::Image<unsigned short, VImageDimension> MaskImageType;
-  typedef itk::ShapedNeighborhoodIterator<ImageType> ShapeIterType;
-  typedef itk::ShapedNeighborhoodIterator<MaskImageType> ShapeMaskIterType;
-  typedef itk::ImageRegionConstIterator<ImageType> ConstIterType;
-  typedef itk::ImageRegionConstIterator<MaskImageType> ConstMaskIterType;
-
-
-  itk::Size<VImageDimension> radius;
-  radius.Fill(range+1);
-  ShapeIterType imageOffsetIter(radius, itkImage, itkImage->GetLargestPossibleRegion());
-  ShapeMaskIterType maskOffsetIter(radius, mask, mask->GetLargestPossibleRegion());
-  imageOffsetIter.ActivateOffset(offset);
-  maskOffsetIter.ActivateOffset(offset);
-  ConstIterType imageIter(itkImage, itkImage->GetLargestPossibleRegion());
-  ConstMaskIterType maskIter(mask, mask->GetLargestPossibleRegion());
-  //  iterator.GetIndex() + ci.GetNeighborhoodOffset()
-  auto region = mask->GetLargestPossibleRegion();
-
-
-  while (!maskIter.IsAtEnd())
-  {
-    auto ciMask = maskOffsetIter.Begin();
-    auto ciValue = imageOffsetIter.Begin();
-    if (maskIter.Value() > 0 &&
-      ciMask.Get() > 0 &&
-      imageIter.Get() == imageIter.Get() &&
-      ciValue.Get() == ciValue.Get() &&
-      region.IsInside(maskOffsetIter.GetIndex() + ciMask.GetNeighborhoodOffset()))
-    {
-      int i = holder.IntensityToIndex(imageIter.Get());
-      int j = holder.IntensityToIndex(ciValue.Get());
-      holder.m_Matrix(i, j) += 1;
-      holder.m_Matrix(j, i) += 1;
-    }
-    ++imageOffsetIter;
-    ++maskOffsetIter;
-    ++imageIter;
-    ++maskIter;
-  }
-}
-
 void CalculateFeatures(
   mitk::CoocurenceMatrixHolder &holder,
   mitk::CoocurenceMatrixFeatures & results
@@ -419,22 +368,13 @@ void CalculateFeatures(
 
 }
 
-template<typename TPixel, unsigned int VImageDimension>
-void
-CalculateCoocurenceFeatures(const itk::Image<TPixel, VImageDimension>* itkImage, const mitk::Image* mask, mitk::GIFCooccurenceMatrix2::FeatureListType & featureList, mitk::GIFCooccurenceMatrix2Configuration config)
+template<unsigned int VImageDimension>
+std::vector<itk::Offset<VImageDimension> >
+CalculateCoocurenceOffsets(const mitk::GIFCooccurenceMatrix2Configuration& config)
 {
-  typedef itk::Image<unsigned short, VImageDimension> MaskType;
-  typedef itk::Neighborhood<TPixel, VImageDimension > NeighborhoodType;
+  typedef itk::Neighborhood<double, VImageDimension > NeighborhoodType;
   typedef itk::Offset<VImageDimension> OffsetType;
 
-  ///////////////////////////////////////////////////////////////////////////////////////////////
-  double rangeMin = config.MinimumIntensity;
-  double rangeMax = config.MaximumIntensity;
-  int numberOfBins = config.Bins;
-
-  typename MaskType::Pointer maskImage = MaskType::New();
-  mitk::CastToItkImage(mask, maskImage);
-
   //Find possible directions
   std::vector < itk::Offset<VImageDimension> > offsetVector;
   NeighborhoodType hood;
@@ -461,48 +401,67 @@ CalculateCoocurenceFeatures(const itk::Image<TPixel, VImageDimension>* itkImage,
   if (config.direction == 1)
   {
     offsetVector.clear();
-    offset[0] = 0;
-    offset[1] = 0;
-    offset[2] = 1;
   }
+  return offsetVector;
+}
 
-  std::vector<mitk::CoocurenceMatrixFeatures> resultVector;
-  mitk::CoocurenceMatrixHolder holderOverall(rangeMin, rangeMax, numberOfBins);
-  mitk::CoocurenceMatrixFeatures overallFeature;
-  for (std::size_t i = 0; i < offsetVector.size(); ++i)
-  {
-    if (config.direction > 1)
-    {
-      if (offsetVector[i][config.direction - 2] != 0)
-      {
-        continue;
-      }
-    }
+template<typename TPixel, unsigned int VImageDimension>
+void
+CalculateCoocurenceFeatures(const itk::Image<TPixel, VImageDimension>* itkImage, const mitk::Image* mask, mitk::GIFCooccurenceMatrix2::FeatureListType & featureList, std::vector<mitk::GIFCooccurenceMatrix2Configuration> configs)
+{
+  typedef itk::Image<unsigned short, VImageDimension> MaskType;
+  typedef mitk::TextureMatrixBuilder<TPixel, VImageDimension> BuilderType;
 
+  if (configs.empty())
+    return;
 
-    offset = offsetVector[i];
-    mitk::CoocurenceMatrixHolder holder(rangeMin, rangeMax, numberOfBins);
-    mitk::CoocurenceMatrixFeatures coocResults;
-    CalculateCoOcMatrix<TPixel, VImageDimension>(itkImage, maskImage, offset, config.range, holder);
-    holderOverall.m_Matrix += holder.m_Matrix;
-    CalculateFeatures(holder, coocResults);
-    resultVector.push_back(coocResults);
+  typename MaskType::Pointer maskImage = MaskType::New();
+  mitk::CastToItkImage(mask, maskImage);
+
+  // The matrices of all ranges are filled in a single pass over the masked voxels
+  typename BuilderType::OffsetVectorType offsetVector;
+  std::vector<std::size_t> numberOfOffsets;
+  for (const auto& config : configs)
+  {
+    auto offsetsOfRange = CalculateCoocurenceOffsets<VImageDimension>(config);
+    offsetVector.insert(offsetVector.end(), offsetsOfRange.begin(), offsetsOfRange.end());
+    numberOfOffsets.push_back(offsetsOfRange.size());
   }
-  CalculateFeatures(holderOverall, overallFeature);
-  //NormalizeMatrixFeature(overallFeature, offsetVector.size());
 
+  BuilderType builder(itkImage, maskImage);
+  builder.SetCooccurrenceBinning(configs.front().MinimumIntensity, configs.front().MaximumIntensity, configs.front().Bins);
+  builder.SetCooccurrenceOffsets(offsetVector);
+  builder.Update();
+
+  auto matrix = builder.GetCooccurrenceMatrices().begin();
+  for (std::size_t c = 0; c < configs.size(); ++c)
+  {
+    const auto& config = configs[c];
+
+    std::vector<mitk::CoocurenceMatrixFeatures> resultVector;
+    mitk::CoocurenceMatrixHolder holderOverall(config.MinimumIntensity, config.MaximumIntensity, config.Bins);
+    mitk::CoocurenceMatrixFeatures overallFeature;
+    for (std::size_t i = 0; i < numberOfOffsets[c]; ++i, ++matrix)
+    {
+      mitk::CoocurenceMatrixHolder holder(config.MinimumIntensity, config.MaximumIntensity, config.Bins);
+      mitk::CoocurenceMatrixFeatures coocResults;
+      holder.m_Matrix = *matrix;
+      holderOverall.m_Matrix += holder.m_Matrix;
+      CalculateFeatures(holder, coocResults);
+      resultVector.push_back(coocResults);
+    }
+    CalculateFeatures(holderOverall, overallFeature);
+    //NormalizeMatrixFeature(overallFeature, offsetVector.size());
 
-  mitk::CoocurenceMatrixFeatures featureMean;
-  mitk::CoocurenceMatrixFeatures featureStd;
-  CalculateMeanAndStdDevFeatures(resultVector, featureMean, featureStd);
 
-  std::ostringstream  ss;
-  ss << config.range;
-  std::string strRange = ss.str();
+    mitk::CoocurenceMatrixFeatures featureMean;
+    mitk::CoocurenceMatrixFeatures featureStd;
+    CalculateMeanAndStdDevFeatures(resultVector, featureMean, featureStd);
 
-  MatrixFeaturesTo(overallFeature, "Overall ", config, featureList);
-  MatrixFeaturesTo(featureMean, "Mean ", config, featureList);
-  MatrixFeaturesTo(featureStd, "Std.Dev. ", config, featureList);
+    MatrixFeaturesTo(overallFeature, "Overall ", config, featureList);
+    MatrixFeaturesTo(featureMean, "Mean ", config, featureList);
+    MatrixFeaturesTo(featureStd, "Std.Dev. ", config, featureList);
+  }
 }
 
 static
@@ -652,10 +611,9 @@ mitk::AbstractGlobalImageFeature::FeatureListType mitk::GIFCooccurenceMatrix2::D
 
   InitializeQuantifier(image, mask);
 
+  std::vector<GIFCooccurenceMatrix2Configuration> configs;
   for (const auto& range: m_Ranges)
   {
-    MITK_INFO << "Start calculating coocurence with range " << range << "....";
-
     GIFCooccurenceMatrix2Configuration config;
     config.direction = GetDirection();
     config.range = range;
@@ -663,11 +621,14 @@ mitk::AbstractGlobalImageFeature::FeatureListType mitk::GIFCooccurenceMatrix2::D
     config.MaximumIntensity = GetQuantifier()->GetMaximum();
     config.Bins = GetQuantifier()->GetBins();
     config.id = this->CreateTemplateFeatureID(std::to_string(range), { {GetOptionPrefix() + "::range", range} });
+    configs.push_back(config);
+  }
 
-    AccessByItk_3(image, CalculateCoocurenceFeatures, mask, featureList, config);
+  MITK_INFO << "Start calculating coocurence....";
 
-    MITK_INFO << "Finished calculating coocurence with range " << range << "....";
-  }
+  AccessByItk_3(image, CalculateCoocurenceFeatures, mask, featureList, configs);
+
+  MITK_INFO << "Finished calculating coocurence....";
 
   return featureList;
 }
@@ -16,11 +16,13 @@ found in the LICENSE file.
 #include <mitkITKImageImport.h>
 #include <mitkImageCast.h>
 #include <mitkImageAccessByItk.h>
+#include <mitkTextureMatrixBuilder.h>
 
 // ITK
 #include <itkEnhancedScalarImageToRunLengthFeaturesFilter.h>
 
 // STL
+#include <cmath>
 #include <sstream>
 
 namespace mitk
@@ -37,22 +39,43 @@ namespace mitk
 }
 
 
+template<typename THistogram>
+std::vector<double>
+  CalculateRunLengthMatrixFeatures(const THistogram* histogram, unsigned long numberOfVoxels)
+{
+  typedef itk::Statistics::EnhancedHistogramToRunLengthFeaturesFilter<THistogram> TextureFilterType;
+
+  typename TextureFilterType::Pointer calculator = TextureFilterType::New();
+  calculator->SetInput(histogram);
+  calculator->SetNumberOfVoxels(numberOfVoxels);
+  calculator->Update();
+
+  // All features are required, in the order of their names
+  std::vector<double> features;
+  for (int name = TextureFilterType::ShortRunEmphasis; name <= TextureFilterType::RunEntropy; ++name)
+  {
+    features.push_back(calculator->GetFeature(static_cast<typename TextureFilterType::RunLengthFeatureName>(name)));
+  }
+  return features;
+}
+
 template<typename TPixel, unsigned int VImageDimension>
 void
   CalculateGrayLevelRunLengthFeatures(const itk::Image<TPixel, VImageDimension>* itkImage, const mitk::Image* mask, mitk::GIFGreyLevelRunLength::FeatureListType & featureList, mitk::GIFGreyLevelRunLengthParameters params)
 {
   typedef itk::Image<TPixel, VImageDimension> ImageType;
-  typedef itk::Image<TPixel, VImageDimension> MaskType;
+  typedef itk::Image<unsigned short, VImageDimension> MaskType;
   typedef itk::Statistics::EnhancedScalarImageToRunLengthFeaturesFilter<ImageType> FilterType;
   typedef typename FilterType::RunLengthFeaturesFilterType TextureFilterType;
+  typedef mitk::TextureMatrixBuilder<TPixel, VImageDimension> BuilderType;
 
   typename MaskType::Pointer maskImage = MaskType::New();
   mitk::CastToItkImage(mask, maskImage);
 
+  // The default offsets of the ITK filter, i.e. the 13 directions in 3D
   typename FilterType::Pointer filter = FilterType::New();
-  typename FilterType::Pointer filter2 = FilterType::New();
 
-  typename FilterType::OffsetVector::Pointer newOffset = FilterType::OffsetVector::New();
+  typename BuilderType::OffsetVectorType newOffset;
   auto oldOffsets = filter->GetOffsets();
   auto oldOffsetsIterator = oldOffsets->Begin();
   while (oldOffsetsIterator != oldOffsets->End())
@@ -71,45 +94,16 @@ void
       offset[0] = 0;
       offset[1] = 0;
       offset[2] = 1;
-      newOffset->push_back(offset);
+      newOffset.push_back(offset);
       break;
     }
 
     oldOffsetsIterator++;
     if (continueOuterLoop)
       continue;
-    newOffset->push_back(offset);
+    newOffset.push_back(offset);
   }
-  filter->SetOffsets(newOffset);
-  filter2->SetOffsets(newOffset);
-
-
-  // All features are required
-  typename FilterType::FeatureNameVectorPointer requestedFeatures = FilterType::FeatureNameVector::New();
-  requestedFeatures->push_back(TextureFilterType::ShortRunEmphasis);
-  requestedFeatures->push_back(TextureFilterType::LongRunEmphasis);
-  requestedFeatures->push_back(TextureFilterType::GreyLevelNonuniformity);
-  requestedFeatures->push_back(TextureFilterType::GreyLevelNonuniformityNormalized);
-  requestedFeatures->push_back(TextureFilterType::RunLengthNonuniformity);
-  requestedFeatures->push_back(TextureFilterType::RunLengthNonuniformityNormalized);
-  requestedFeatures->push_back(TextureFilterType::LowGreyLevelRunEmphasis);
-  requestedFeatures->push_back(TextureFilterType::HighGreyLevelRunEmphasis);
-  requestedFeatures->push_back(TextureFilterType::ShortRunLowGreyLevelEmphasis);
-  requestedFeatures->push_back(TextureFilterType::ShortRunHighGreyLevelEmphasis);
-  requestedFeatures->push_back(TextureFilterType::LongRunLowGreyLevelEmphasis);
-  requestedFeatures->push_back(TextureFilterType::LongRunHighGreyLevelEmphasis);
-  requestedFeatures->push_back(TextureFilterType::RunPercentage);
-  requestedFeatures->push_back(TextureFilterType::NumberOfRuns);
-  requestedFeatures->push_back(TextureFilterType::GreyLevelVariance);
-  requestedFeatures->push_back(TextureFilterType::RunLengthVariance);
-  requestedFeatures->push_back(TextureFilterType::RunEntropy);
-
-  filter->SetInput(itkImage);
-  filter->SetMaskImage(maskImage);
-  filter->SetRequestedFeatures(requestedFeatures);
-  filter2->SetInput(itkImage);
-  filter2->SetMaskImage(maskImage);
-  filter2->SetRequestedFeatures(requestedFeatures);
+
   int numberOfBins = params.Bins;
   if (numberOfBins < 2)
     numberOfBins = 256;
@@ -117,111 +111,142 @@ void
   double minRange = params.MinimumIntensity;
   double maxRange = params.MaximumIntensity;
 
-  filter->SetPixelValueMinMax(minRange, maxRange);
-  filter->SetNumberOfBinsPerAxis(numberOfBins);
-  filter2->SetPixelValueMinMax(minRange, maxRange);
-  filter2->SetNumberOfBinsPerAxis(numberOfBins);
+  // All directions are filled in a single pass over the masked voxels. The combined
+  // matrix is the sum of the matrices of all directions.
+  BuilderType builder(itkImage, maskImage);
+  builder.SetRunLengthBinning(minRange, maxRange, numberOfBins);
+  builder.SetRunLengthOffsets(newOffset);
+  builder.Update();
 
-  filter->SetDistanceValueMinMax(0, numberOfBins);
-  filter2->SetDistanceValueMinMax(0, numberOfBins);
+  const unsigned long numberOfVoxels = builder.GetNumberOfMaskedVoxels();
+  const auto& matrices = builder.GetRunLengthMatrices();
 
-  filter2->CombinedFeatureCalculationOn();
+  if (matrices.empty())
+    return;
 
-  filter->Update();
-  filter2->Update();
+  typename BuilderType::MatrixType combinedMatrix = matrices.front();
+  combinedMatrix.setZero();
 
-  auto featureMeans = filter->GetFeatureMeans ();
-  auto featureStd = filter->GetFeatureStandardDeviations();
-  auto featureCombined = filter2->GetFeatureMeans();
+  std::vector<std::vector<double> > features;
+  for (const auto& matrix : matrices)
+  {
+    combinedMatrix += matrix;
+    auto histogram = builder.CreateRunLengthHistogram(matrix);
+    features.push_back(CalculateRunLengthMatrixFeatures(histogram.GetPointer(), numberOfVoxels));
+  }
+
+  auto histogram = builder.CreateRunLengthHistogram(combinedMatrix);
+  auto featureCombined = CalculateRunLengthMatrixFeatures(histogram.GetPointer(), numberOfVoxels);
+
+  // Mean and standard deviation over the directions, computed incrementally like the ITK filter
+  std::vector<double> featureMeans = features.front();
+  std::vector<double> featureStd(featureMeans.size(), 0.0);
+  for (std::size_t offsetNum = 1; offsetNum < features.size(); ++offsetNum)
+  {
+    const double k = offsetNum + 1;
+    for (std::size_t featureNum = 0; featureNum < featureMeans.size(); ++featureNum)
+    {
+      double M_k_minus_1 = featureMeans[featureNum];
+      double x_k = features[offsetNum][featureNum];
+      double M_k = M_k_minus_1 + (x_k - M_k_minus_1) / k;
+
+      featureStd[featureNum] += (x_k - M_k_minus_1) * (x_k - M_k);
+      featureMeans[featureNum] = M_k;
+    }
+  }
+  for (auto& value : featureStd)
+  {
+    value = std::sqrt(value / features.size());
+  }
 
-  for (std::size_t i = 0; i < featureMeans->size(); ++i)
+  for (std::size_t i = 0; i < featureMeans.size(); ++i)
   {
     switch (i)
     {
     case TextureFilterType::ShortRunEmphasis :
-      featureList.push_back(std::make_pair(mitk::CreateFeatureID(params.id, "Short run emphasis Means"), featureMeans->ElementAt(i)));
-      featureList.push_back(std::make_pair(mitk::CreateFeatureID(params.id, "Short run emphasis Std."), featureStd->ElementAt(i)));
-      featureList.push_back(std::make_pair(mitk::CreateFeatureID(params.id, "Short run emphasis Comb."), featureCombined->ElementAt(i)));
+      featureList.push_back(std::make_pair(mitk::CreateFeatureID(params.id, "Short run emphasis Means"), featureMeans[i]));
+      featureList.push_back(std::make_pair(mitk::CreateFeatureID(params.id, "Short run emphasis Std."), featureStd[i]));
+      featureList.push_back(std::make_pair(mitk::CreateFeatureID(params.id, "Short run emphasis Comb."), featureCombined[i]));
       break;
     case TextureFilterType::LongRunEmphasis :
-      featureList.push_back(std::make_pair(mitk::CreateFeatureID(params.id, "Long run emphasis Means"), featureMeans->ElementAt(i)));
-      featureList.push_back(std::make_pair(mitk::CreateFeatureID(params.id, "Long run emphasis Std."), featureStd->ElementAt(i)));
-      featureList.push_back(std::make_pair(mitk::CreateFeatureID(params.id, "Long run emphasis Comb."), featureCombined->ElementAt(i)));
+      featureList.push_back(std::make_pair(mitk::CreateFeatureID(params.id, "Long run emphasis Means"), featureMeans[i]));
+      featureList.push_back(std::make_pair(mitk::CreateFeatureID(params.id, "Long run emphasis Std."), featureStd[i]));
+      featureList.push_back(std::make_pair(mitk::CreateFeatureID(params.id, "Long run emphasis Comb."), featureCombined[i]));
       break;
     case TextureFilterType::GreyLevelNonuniformity :
-      featureList.push_back(std::make_pair(mitk::CreateFeatureID(params.id, "Grey level nonuniformity Means"), featureMeans->ElementAt(i)));
-      featureList.push_back(std::make_pair(mitk::CreateFeatureID(params.id, "Grey level nonuniformity Std."), featureStd->ElementAt(i)));
-      featureList.push_back(std::make_pair(mitk::CreateFeatureID(params.id, "Grey level nonuniformity Comb."), featureCombined->ElementAt(i)));
+      featureList.push_back(std::make_pair(mitk::CreateFeatureID(params.id, "Grey level nonuniformity Means"), featureMeans[i]));
+      featureList.push_back(std::make_pair(mitk::CreateFeatureID(params.id, "Grey level nonuniformity Std."), featureStd[i]));
+      featureList.push_back(std::make_pair(mitk::CreateFeatureID(params.id, "Grey level nonuniformity Comb."), featureCombined[i]));
       break;
     case TextureFilterType::GreyLevelNonuniformityNormalized :
-      featureList.push_back(std::make_pair(mitk::CreateFeatureID(params.id, "Grey level nonuniformity normalized Means"), featureMeans->ElementAt(i)));
-      featureList.push_back(std::make_pair(mitk::CreateFeatureID(params.id, "Grey level nonuniformity normalized Std."), featureStd->ElementAt(i)));
-      featureList.push_back(std::make_pair(mitk::CreateFeatureID(params.id, "Grey level nonuniformity normalized Comb."), featureCombined->ElementAt(i)));
+      featureList.push_back(std::make_pair(mitk::CreateFeatureID(params.id, "Grey level nonuniformity normalized Means"), featureMeans[i]));
+      featureList.push_back(std::make_pair(mitk::CreateFeatureID(params.id, "Grey level nonuniformity normalized Std."), featureStd[i]));
+      featureList.push_back(std::make_pair(mitk::CreateFeatureID(params.id, "Grey level nonuniformity normalized Comb."), featureCombined[i]));
       break;
     case TextureFilterType::RunLengthNonuniformity :
-      featureList.push_back(std::make_pair(mitk::CreateFeatureID(params.id, "Run length nonuniformity Means"), featureMeans->ElementAt(i)));
-      featureList.push_back(std::make_pair(mitk::CreateFeatureID(params.id, "Run length nonuniformity Std."), featureStd->ElementAt(i)));
-      featureList.push_back(std::make_pair(mitk::CreateFeatureID(params.id, "Run length nonuniformity Comb."), featureCombined->ElementAt(i)));
+      featureList.push_back(std::make_pair(mitk::CreateFeatureID(params.id, "Run length nonuniformity Means"), featureMeans[i]));
+      featureList.push_back(std::make_pair(mitk::CreateFeatureID(params.id, "Run length nonuniformity Std."), featureStd[i]));
+      featureList.push_back(std::make_pair(mitk::CreateFeatureID(params.id, "Run length nonuniformity Comb."), featureCombined[i]));
       break;
     case TextureFilterType::RunLengthNonuniformityNormalized :
-      featureList.push_back(std::make_pair(mitk::CreateFeatureID(params.id, "Run length nonuniformity normalized Means"), featureMeans->ElementAt(i)));
-      featureList.push_back(std::make_pair(mitk::CreateFeatureID(params.id, "Run length nonuniformity normalized Std."), featureStd->ElementAt(i)));
-      featureList.push_back(std::make_pair(mitk::CreateFeatureID(params.id, "Run length nonuniformity normalized Comb."), featureCombined->ElementAt(i)));
+      featureList.push_back(std::make_pair(mitk::CreateFeatureID(params.id, "Run length nonuniformity normalized Means"), featureMeans[i]));
+      featureList.push_back(std::make_pair(mitk::CreateFeatureID(params.id, "Run length nonuniformity normalized Std."), featureStd[i]));
+      featureList.push_back(std::make_pair(mitk::CreateFeatureID(params.id, "Run length nonuniformity normalized Comb."), featureCombined[i]));
       break;
     case TextureFilterType::LowGreyLevelRunEmphasis :
-      featureList.push_back(std::make_pair(mitk::CreateFeatureID(params.id, "Low grey level run emphasis Means"), featureMeans->ElementAt(i)));
-      featureList.push_back(std::make_pair(mitk::CreateFeatureID(params.id, "Low grey level run emphasis Std."), featureStd->ElementAt(i)));
-      featureList.push_back(std::make_pair(mitk::CreateFeatureID(params.id, "Low grey level run emphasis Comb."), featureCombined->ElementAt(i)));
+      featureList.push_back(std::make_pair(mitk::CreateFeatureID(params.id, "Low grey level run emphasis Means"), featureMeans[i]));
+      featureList.push_back(std::make_pair(mitk::CreateFeatureID(params.id, "Low grey level run emphasis Std."), featureStd[i]));
+      featureList.push_back(std::make_pair(mitk::CreateFeatureID(params.id, "Low grey level run emphasis Comb."), featureCombined[i]));
       break;
     case TextureFilterType::HighGreyLevelRunEmphasis :
-      featureList.push_back(std::make_pair(mitk::CreateFeatureID(params.id, "High grey level run emphasis Means"), featureMeans->ElementAt(i)));
-      featureList.push_back(std::make_pair(mitk::CreateFeatureID(params.id, "High grey level run emphasis Std."), featureStd->ElementAt(i)));
-      featureList.push_back(std::make_pair(mitk::CreateFeatureID(params.id, "High grey level run emphasis Comb."), featureCombined->ElementAt(i)));
+      featureList.push_back(std::make_pair(mitk::CreateFeatureID(params.id, "High grey level run emphasis Means"), featureMeans[i]));
+      featureList.push_back(std::make_pair(mitk::CreateFeatureID(params.id, "High grey level run emphasis Std."), featureStd[i]));
+      featureList.push_back(std::make_pair(mitk::CreateFeatureID(params.id, "High grey level run emphasis Comb."), featureCombined[i]));
       break;
     case TextureFilterType::ShortRunLowGreyLevelEmphasis :
-      featureList.push_back(std::make_pair(mitk::CreateFeatureID(params.id, "Short run low grey level emphasis Means"), featureMeans->ElementAt(i)));
-      featureList.push_back(std::make_pair(mitk::CreateFeatureID(params.id, "Short run low grey level emphasis  Std."), featureStd->ElementAt(i)));
-      featureList.push_back(std::make_pair(mitk::CreateFeatureID(params.id, "Short run low grey level emphasis  Comb."), featureCombined->ElementAt(i)));
+      featureList.push_back(std::make_pair(mitk::CreateFeatureID(params.id, "Short run low grey level emphasis Means"), featureMeans[i]));
+      featureList.push_back(std::make_pair(mitk::CreateFeatureID(params.id, "Short run low grey level emphasis  Std."), featureStd[i]));
+      featureList.push_back(std::make_pair(mitk::CreateFeatureID(params.id, "Short run low grey level emphasis  Comb."), featureCombined[i]));
       break;
     case TextureFilterType::ShortRunHighGreyLevelEmphasis :
-      featureList.push_back(std::make_pair(mitk::CreateFeatureID(params.id, "Short run high grey level emphasis Means"), featureMeans->ElementAt(i)));
-      featureList.push_back(std::make_pair(mitk::CreateFeatureID(params.id, "Short run high grey level emphasis Std."), featureStd->ElementAt(i)));
-      featureList.push_back(std::make_pair(mitk::CreateFeatureID(params.id, "Short run high grey level emphasis Comb."), featureCombined->ElementAt(i)));
+      featureList.push_back(std::make_pair(mitk::CreateFeatureID(params.id, "Short run high grey level emphasis Means"), featureMeans[i]));
+      featureList.push_back(std::make_pair(mitk::CreateFeatureID(params.id, "Short run high grey level emphasis Std."), featureStd[i]));
+      featureList.push_back(std::make_pair(mitk::CreateFeatureID(params.id, "Short run high grey level emphasis Comb."), featureCombined[i]));
       break;
     case TextureFilterType::LongRunLowGreyLevelEmphasis :
-      featureList.push_back(std::make_pair(mitk::CreateFeatureID(params.id, "Long run low grey level emphasis Means"), featureMeans->ElementAt(i)));
-      featureList.push_back(std::make_pair(mitk::CreateFeatureID(params.id, "Long run low grey level emphasis Std."), featureStd->ElementAt(i)));
-      featureList.push_back(std::make_pair(mitk::CreateFeatureID(params.id, "Long run low grey level emphasis Comb."), featureCombined->ElementAt(i)));
+      featureList.push_back(std::make_pair(mitk::CreateFeatureID(params.id, "Long run low grey level emphasis Means"), featureMeans[i]));
+      featureList.push_back(std::make_pair(mitk::CreateFeatureID(params.id, "Long run low grey level emphasis Std."), featureStd[i]));
+      featureList.push_back(std::make_pair(mitk::CreateFeatureID(params.id, "Long run low grey level emphasis Comb."), featureCombined[i]));
       break;
     case TextureFilterType::LongRunHighGreyLevelEmphasis :
-      featureList.push_back(std::make_pair(mitk::CreateFeatureID(params.id, "Long run high grey level emphasis Means"), featureMeans->ElementAt(i)));
-      featureList.push_back(std::make_pair(mitk::CreateFeatureID(params.id, "Long run high grey level emphasis Std."), featureStd->ElementAt(i)));
-      featureList.push_back(std::make_pair(mitk::CreateFeatureID(params.id, "Long run high grey level emphasis Comb."), featureCombined->ElementAt(i)));
+      featureList.push_back(std::make_pair(mitk::CreateFeatureID(params.id, "Long run high grey level emphasis Means"), featureMeans[i]));
+      featureList.push_back(std::make_pair(mitk::CreateFeatureID(params.id, "Long run high grey level emphasis Std."), featureStd[i]));
+      featureList.push_back(std::make_pair(mitk::CreateFeatureID(params.id, "Long run high grey level emphasis Comb."), featureCombined[i]));
       break;
     case TextureFilterType::RunPercentage :
-      featureList.push_back(std::make_pair(mitk::CreateFeatureID(params.id, "Run percentage Means"), featureMeans->ElementAt(i)));
-      featureList.push_back(std::make_pair(mitk::CreateFeatureID(params.id, "Run percentage Std."), featureStd->ElementAt(i)));
-      featureList.push_back(std::make_pair(mitk::CreateFeatureID(params.id, "Run percentage Comb."), featureCombined->ElementAt(i) / newOffset->size()));
+      featureList.push_back(std::make_pair(mitk::CreateFeatureID(params.id, "Run percentage Means"), featureMeans[i]));
+      featureList.push_back(std::make_pair(mitk::CreateFeatureID(params.id, "Run percentage Std."), featureStd[i]));
+      featureList.push_back(std::make_pair(mitk::CreateFeatureID(params.id, "Run percentage Comb."), featureCombined[i] / newOffset.size()));
       break;
     case TextureFilterType::NumberOfRuns :
-      featureList.push_back(std::make_pair(mitk::CreateFeatureID(params.id, "Number of runs Means"), featureMeans->ElementAt(i)));
-      featureList.push_back(std::make_pair(mitk::CreateFeatureID(params.id, "Number of runs Std."), featureStd->ElementAt(i)));
-      featureList.push_back(std::make_pair(mitk::CreateFeatureID(params.id, "Number of runs Comb."), featureCombined->ElementAt(i)));
+      featureList.push_back(std::make_pair(mitk::CreateFeatureID(params.id, "Number of runs Means"), featureMeans[i]));
+      featureList.push_back(std::make_pair(mitk::CreateFeatureID(params.id, "Number of runs Std."), featureStd[i]));
+      featureList.push_back(std::make_pair(mitk::CreateFeatureID(params.id, "Number of runs Comb."), featureCombined[i]));
       break;
     case TextureFilterType::GreyLevelVariance :
-      featureList.push_back(std::make_pair(mitk::CreateFeatureID(params.id, "Grey level variance Means"), featureMeans->ElementAt(i)));
-      featureList.push_back(std::make_pair(mitk::CreateFeatureID(params.id, "Grey level variance Std."), featureStd->ElementAt(i)));
-      featureList.push_back(std::make_pair(mitk::CreateFeatureID(params.id, "Grey level variance Comb."), featureCombined->ElementAt(i)));
+      featureList.push_back(std::make_pair(mitk::CreateFeatureID(params.id, "Grey level variance Means"), featureMeans[i]));
+      featureList.push_back(std::make_pair(mitk::CreateFeatureID(params.id, "Grey level variance Std."), featureStd[i]));
+      featureList.push_back(std::make_pair(mitk::CreateFeatureID(params.id, "Grey level variance Comb."), featureCombined[i]));
       break;
     case TextureFilterType::RunLengthVariance :
-      featureList.push_back(std::make_pair(mitk::CreateFeatureID(params.id, "Run length variance Means"), featureMeans->ElementAt(i)));
-      featureList.push_back(std::make_pair(mitk::CreateFeatureID(params.id, "Run length variance Std."), featureStd->ElementAt(i)));
-      featureList.push_back(std::make_pair(mitk::CreateFeatureID(params.id, "Run length variance Comb."), featureCombined->ElementAt(i)));
+      featureList.push_back(std::make_pair(mitk::CreateFeatureID(params.id, "Run length variance Means"), featureMeans[i]));
+      featureList.push_back(std::make_pair(mitk::CreateFeatureID(params.id, "Run length variance Std."), featureStd[i]));
+      featureList.push_back(std::make_pair(mitk::CreateFeatureID(params.id, "Run length variance Comb."), featureCombined[i]));
       break;
     case TextureFilterType::RunEntropy :
-      featureList.push_back(std::make_pair(mitk::CreateFeatureID(params.id, "Run length entropy Means"), featureMeans->ElementAt(i)));
-      featureList.push_back(std::make_pair(mitk::CreateFeatureID(params.id, "Run length entropy Std."), featureStd->ElementAt(i)));
-      featureList.push_back(std::make_pair(mitk::CreateFeatureID(params.id, "Run length entropy Comb."), featureCombined->ElementAt(i)));
+      featureList.push_back(std::make_pair(mitk::CreateFeatureID(params.id, "Run length entropy Means"), featureMeans[i]));
+      featureList.push_back(std::make_pair(mitk::CreateFeatureID(params.id, "Run length entropy Std."), featureStd[i]));
+      featureList.push_back(std::make_pair(mitk::CreateFeatureID(params.id, "Run length entropy Comb."), featureCombined[i]));
       break;
     default:
       break;
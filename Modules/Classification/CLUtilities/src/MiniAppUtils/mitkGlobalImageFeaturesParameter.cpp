@@ -13,6 +13,7 @@ found in the LICENSE file.
 #include <mitkGlobalImageFeaturesParameter.h>
 
 
+#include <algorithm>
 #include <fstream>
 #include <itkFileTools.h>
 #include <itksys/SystemTools.hxx>
@@ -30,12 +31,14 @@ static bool fileExists(const std::string& filename)
 void mitk::cl::GlobalImageFeaturesParameter::AddParameter(mitkCommandLineParser &parser)
 {
   // Required Parameter
-  parser.addArgument("image",   "i", mitkCommandLineParser::Image, "Input Image", "Path to the input image file", us::Any(), false, false, false, mitkCommandLineParser::Input);
-  parser.addArgument("mask", "m", mitkCommandLineParser::Image, "Input Mask", "Path to the mask Image that specifies the area over for the statistic (Values = 1)", us::Any(), false, false, false, mitkCommandLineParser::Input);
+  parser.addArgument("image",   "i", mitkCommandLineParser::Image, "Input Image", "Path to the input image file. Required if no batch file is given.", us::Any(), true, false, false, mitkCommandLineParser::Input);
+  parser.addArgument("mask", "m", mitkCommandLineParser::Image, "Input Mask", "Path to the mask Image that specifies the area over for the statistic (Values = 1). Required if no batch file is given.", us::Any(), true, false, false, mitkCommandLineParser::Input);
   parser.addArgument("morph-mask", "morph", mitkCommandLineParser::Image, "Morphological Image Mask", "Path to the mask Image that specifies the area over for the statistic (Values = 1)", us::Any(), true, false, false, mitkCommandLineParser::Input);
   parser.addArgument("output",  "o", mitkCommandLineParser::File, "Output text file", "Path to output file. The output statistic is appended to this file.", us::Any(), false, false, false, mitkCommandLineParser::Output);
 
   // Optional Parameter
+  parser.addArgument("batch", "b", mitkCommandLineParser::File, "Batch file", "Text file with one case per line, given as 'image path;mask path[;morphological mask path]'. The cases are processed instead of the image and mask and the results are streamed to the output file.", us::Any(), true, false, false, mitkCommandLineParser::Input);
+  parser.addArgument("threads", "t", mitkCommandLineParser::Int, "Number of threads", "Number of feature classes, slices or cases that are processed concurrently. Default is the number of hardware threads.", us::Any());
   parser.addArgument("xml-output", "x", mitkCommandLineParser::File, "XML result file", "Path where the results should be stored as XML result file. ", us::Any(), true, false, false, mitkCommandLineParser::Input);
   parser.addArgument("logfile",    "log",         mitkCommandLineParser::File, "Text Logfile", "Path to the location of the target log file. ", us::Any(), true, false, false, mitkCommandLineParser::Input);
   parser.addArgument("save-image", "save-image",  mitkCommandLineParser::File, "Output Image", "If specified, the image that is used for the analysis is saved to this location.", us::Any(), true, false, false, mitkCommandLineParser::Output);
@@ -75,8 +78,14 @@ void mitk::cl::GlobalImageFeaturesParameter::ParseFileLocations(std::map<std::st
   //
   // Read input and output file information
   //
-  imagePath = parsedArgs["image"].ToString();
-  maskPath = parsedArgs["mask"].ToString();
+  if (parsedArgs.count("image"))
+  {
+    imagePath = parsedArgs["image"].ToString();
+  }
+  if (parsedArgs.count("mask"))
+  {
+    maskPath = parsedArgs["mask"].ToString();
+  }
   outputPath = parsedArgs["output"].ToString();
 
   imageFolder = itksys::SystemTools::GetFilenamePath(imagePath);
@@ -92,6 +101,13 @@ void mitk::cl::GlobalImageFeaturesParameter::ParseFileLocations(std::map<std::st
     morphName = itksys::SystemTools::GetFilenameName(morphPath);
   }
 
+  useBatchFile = false;
+  if (parsedArgs.count("batch"))
+  {
+    useBatchFile = true;
+    batchFilePath = parsedArgs["batch"].ToString();
+  }
+
   outputXMLPath = "";
   if (parsedArgs.count("xml-output"))
   {
@@ -153,6 +169,12 @@ void mitk::cl::GlobalImageFeaturesParameter::ParseAdditionalOutputs(std::map<std
   }
 
   calculateAllFeatures = parsedArgs.count("all-features");
+
+  numberOfThreads = 0;
+  if (parsedArgs.count("threads"))
+  {
+    numberOfThreads = std::max(0, us::any_cast<int>(parsedArgs["threads"]));
+  }
 }
 
 void mitk::cl::GlobalImageFeaturesParameter::ParseHeaderInformation(std::map<std::string, us::Any> &parsedArgs)
@@ -55,6 +55,21 @@ mitk::cl::FeatureResultWriter::~FeatureResultWriter()
   m_Output.close();
 }
 
+void mitk::cl::FeatureResultWriter::Flush()
+{
+  if (m_Mode == 1)
+    return;
+
+  // all rows before the current row are complete
+  for (std::size_t i = 0; i < m_CurrentRow; ++i)
+  {
+    m_Output << m_List[i] << std::endl;
+  }
+  m_List.erase(m_List.begin(), m_List.begin() + m_CurrentRow);
+  m_CurrentRow = 0;
+  m_Output.flush();
+}
+
 void mitk::cl::FeatureResultWriter::SetDecimalPoint(char decimal)
 {
   m_Output.imbue(std::locale(std::cout.getloc(), new punct_facet<char>(decimal)));
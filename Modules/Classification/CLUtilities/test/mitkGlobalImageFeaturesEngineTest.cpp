@@ -0,0 +1,175 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include <mitkTestingMacros.h>
+#include <mitkTestFixture.h>
+#include "mitkIOUtil.h"
+
+#include <mitkGlobalImageFeaturesEngine.h>
+#include <mitkGIFCooccurenceMatrix2.h>
+#include <mitkGIFFirstOrderHistogramStatistics.h>
+#include <mitkGIFFirstOrderStatistics.h>
+#include <mitkGIFGreyLevelSizeZone.h>
+#include <mitkGIFVolumetricStatistics.h>
+
+class mitkGlobalImageFeaturesEngineTestSuite : public mitk::TestFixture
+{
+  CPPUNIT_TEST_SUITE(mitkGlobalImageFeaturesEngineTestSuite);
+
+  MITK_TEST(ConcurrentFeaturesEqualSerialFeatures);
+  MITK_TEST(ResultsAreInOrderOfInputs);
+  MITK_TEST(InactiveFeatureClassesAreSkipped);
+  MITK_TEST(SharedRangeCacheEqualsImageScan);
+
+  CPPUNIT_TEST_SUITE_END();
+
+private:
+  mitk::Image::Pointer m_IBSI_Phantom_Image_Small;
+  mitk::Image::Pointer m_IBSI_Phantom_Image_Large;
+  mitk::Image::Pointer m_IBSI_Phantom_Mask_Small;
+  mitk::Image::Pointer m_IBSI_Phantom_Mask_Large;
+
+  static mitk::GlobalImageFeaturesEngine::FeatureVectorType CreateFeatures()
+  {
+    mitk::GlobalImageFeaturesEngine::FeatureVectorType features;
+    features.push_back(mitk::GIFVolumetricStatistics::New().GetPointer());
+    features.push_back(mitk::GIFFirstOrderStatistics::New().GetPointer());
+    features.push_back(mitk::GIFFirstOrderHistogramStatistics::New().GetPointer());
+    features.push_back(mitk::GIFCooccurenceMatrix2::New().GetPointer());
+    features.push_back(mitk::GIFGreyLevelSizeZone::New().GetPointer());
+
+    for (auto feature : features)
+    {
+      feature->SetUseBinsize(true);
+      feature->SetBinsize(1.0);
+    }
+    return features;
+  }
+
+  static mitk::AbstractGlobalImageFeature::FeatureListType CalculateSerial(mitk::Image* image, mitk::Image* mask)
+  {
+    mitk::AbstractGlobalImageFeature::FeatureListType result;
+    for (auto feature : CreateFeatures())
+    {
+      feature->SetMorphMask(mask);
+      feature->CalculateAndAppendFeatures(image, mask, mask, result, false);
+    }
+    return result;
+  }
+
+  static void AssertEqualFeatures(const mitk::AbstractGlobalImageFeature::FeatureListType& expected,
+                                  const mitk::AbstractGlobalImageFeature::FeatureListType& actual)
+  {
+    CPPUNIT_ASSERT_EQUAL(expected.size(), actual.size());
+
+    for (std::size_t i = 0; i < expected.size(); ++i)
+    {
+      CPPUNIT_ASSERT_EQUAL(expected[i].first.legacyName, actual[i].first.legacyName);
+
+      if (expected[i].second == expected[i].second)
+      {
+        CPPUNIT_ASSERT_DOUBLES_EQUAL_MESSAGE(expected[i].first.legacyName, expected[i].second, actual[i].second, 1e-10);
+      }
+      else
+      {
+        CPPUNIT_ASSERT_MESSAGE(expected[i].first.legacyName, actual[i].second != actual[i].second);
+      }
+    }
+  }
+
+public:
+
+  void setUp(void) override
+  {
+    m_IBSI_Phantom_Image_Small = mitk::IOUtil::Load<mitk::Image>(GetTestDataFilePath("Radiomics/IBSI_Phantom_Image_Small.nrrd"));
+    m_IBSI_Phantom_Image_Large = mitk::IOUtil::Load<mitk::Image>(GetTestDataFilePath("Radiomics/IBSI_Phantom_Image_Large.nrrd"));
+    m_IBSI_Phantom_Mask_Small = mitk::IOUtil::Load<mitk::Image>(GetTestDataFilePath("Radiomics/IBSI_Phantom_Mask_Small.nrrd"));
+    m_IBSI_Phantom_Mask_Large = mitk::IOUtil::Load<mitk::Image>(GetTestDataFilePath("Radiomics/IBSI_Phantom_Mask_Large.nrrd"));
+  }
+
+  void ConcurrentFeaturesEqualSerialFeatures()
+  {
+    const auto expected = CalculateSerial(m_IBSI_Phantom_Image_Large, m_IBSI_Phantom_Mask_Large);
+
+    mitk::GlobalImageFeaturesEngine engine(&CreateFeatures);
+    engine.SetCheckParameterActivation(false);
+
+    mitk::GlobalImageFeaturesEngine::Input input{ m_IBSI_Phantom_Image_Large, m_IBSI_Phantom_Mask_Large, m_IBSI_Phantom_Mask_Large, nullptr };
+
+    for (unsigned int threads : { 1u, 4u })
+    {
+      engine.SetNumberOfThreads(threads);
+      auto actual = engine.CalculateFeatures(input);
+      AssertEqualFeatures(expected, actual);
+    }
+  }
+
+  void ResultsAreInOrderOfInputs()
+  {
+    const auto expectedSmall = CalculateSerial(m_IBSI_Phantom_Image_Small, m_IBSI_Phantom_Mask_Small);
+    const auto expectedLarge = CalculateSerial(m_IBSI_Phantom_Image_Large, m_IBSI_Phantom_Mask_Large);
+
+    mitk::GlobalImageFeaturesEngine engine(&CreateFeatures);
+    engine.SetCheckParameterActivation(false);
+    engine.SetNumberOfThreads(8);
+
+    std::vector<mitk::GlobalImageFeaturesEngine::Input> inputs;
+    inputs.push_back({ m_IBSI_Phantom_Image_Large, m_IBSI_Phantom_Mask_Large, m_IBSI_Phantom_Mask_Large, nullptr });
+    inputs.push_back({ m_IBSI_Phantom_Image_Small, m_IBSI_Phantom_Mask_Small, m_IBSI_Phantom_Mask_Small, nullptr });
+    inputs.push_back({ m_IBSI_Phantom_Image_Large, m_IBSI_Phantom_Mask_Large, m_IBSI_Phantom_Mask_Large, nullptr });
+
+    auto results = engine.CalculateFeatures(inputs);
+
+    CPPUNIT_ASSERT_EQUAL(std::size_t(3), results.size());
+    AssertEqualFeatures(expectedLarge, results[0]);
+    AssertEqualFeatures(expectedSmall, results[1]);
+    AssertEqualFeatures(expectedLarge, results[2]);
+  }
+
+  void InactiveFeatureClassesAreSkipped()
+  {
+    mitk::GlobalImageFeaturesEngine engine(&CreateFeatures);
+    CPPUNIT_ASSERT(engine.GetCheckParameterActivation());
+
+    mitk::GlobalImageFeaturesEngine::Input input{ m_IBSI_Phantom_Image_Small, m_IBSI_Phantom_Mask_Small, m_IBSI_Phantom_Mask_Small, nullptr };
+    auto result = engine.CalculateFeatures(input);
+    CPPUNIT_ASSERT(result.empty());
+  }
+
+  void SharedRangeCacheEqualsImageScan()
+  {
+    auto cache = mitk::IntensityRangeCache::New();
+
+    for (auto mask : { static_cast<mitk::Image*>(nullptr), m_IBSI_Phantom_Mask_Large.GetPointer() })
+    {
+      auto expected = mitk::IntensityQuantifier::New();
+      auto actual = mitk::IntensityQuantifier::New();
+      actual->SetIntensityRangeCache(cache);
+
+      if (nullptr == mask)
+      {
+        expected->InitializeByImage(m_IBSI_Phantom_Image_Large, 6);
+        actual->InitializeByImage(m_IBSI_Phantom_Image_Large, 6);
+      }
+      else
+      {
+        expected->InitializeByImageRegion(m_IBSI_Phantom_Image_Large, mask, 6);
+        actual->InitializeByImageRegion(m_IBSI_Phantom_Image_Large, mask, 6);
+      }
+
+      CPPUNIT_ASSERT_EQUAL(expected->GetMinimum(), actual->GetMinimum());
+      CPPUNIT_ASSERT_EQUAL(expected->GetMaximum(), actual->GetMaximum());
+    }
+  }
+};
+
+MITK_TEST_SUITE_REGISTRATION(mitkGlobalImageFeaturesEngine)
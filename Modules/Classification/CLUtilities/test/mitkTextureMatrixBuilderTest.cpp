@@ -0,0 +1,187 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include <mitkTestingMacros.h>
+#include <mitkTestFixture.h>
+#include "mitkIOUtil.h"
+
+#include <mitkImageCast.h>
+#include <mitkTextureMatrixBuilder.h>
+
+#include <itkImageRegionConstIteratorWithIndex.h>
+#include <itkNeighborhood.h>
+
+#include <cmath>
+
+class mitkTextureMatrixBuilderTestSuite : public mitk::TestFixture
+{
+  CPPUNIT_TEST_SUITE(mitkTextureMatrixBuilderTestSuite);
+
+  MITK_TEST(CooccurrenceMatricesEqualPairCount);
+  MITK_TEST(RunLengthMatricesEqualITKFilter);
+  MITK_TEST(ResultIsIndependentOfNumberOfThreads);
+
+  CPPUNIT_TEST_SUITE_END();
+
+private:
+  typedef itk::Image<double, 3> ImageType;
+  typedef itk::Image<unsigned short, 3> MaskType;
+  typedef mitk::TextureMatrixBuilder<double, 3> BuilderType;
+
+  mitk::Image::Pointer m_MitkMask;
+  ImageType::Pointer m_Image;
+  MaskType::Pointer m_Mask;
+
+  static BuilderType::OffsetVectorType GetOffsets()
+  {
+    itk::Neighborhood<double, 3> hood;
+    hood.SetRadius(1);
+
+    BuilderType::OffsetVectorType offsets;
+    for (unsigned int d = 0; d < hood.GetCenterNeighborhoodIndex(); ++d)
+      offsets.push_back(hood.GetOffset(d));
+    return offsets;
+  }
+
+public:
+
+  void setUp(void) override
+  {
+    auto image = mitk::IOUtil::Load<mitk::Image>(GetTestDataFilePath("Radiomics/IBSI_Phantom_Image_Large.nrrd"));
+    m_MitkMask = mitk::IOUtil::Load<mitk::Image>(GetTestDataFilePath("Radiomics/IBSI_Phantom_Mask_Large.nrrd"));
+
+    mitk::CastToItkImage(image, m_Image);
+    mitk::CastToItkImage(m_MitkMask, m_Mask);
+  }
+
+  void tearDown(void) override
+  {
+    m_MitkMask = nullptr;
+    m_Image = nullptr;
+    m_Mask = nullptr;
+  }
+
+  void CooccurrenceMatricesEqualPairCount()
+  {
+    const auto offsets = GetOffsets();
+    const double minimum = 0.5;
+    const double maximum = 6.5;
+    const int bins = 6;
+
+    BuilderType builder(m_Image, m_Mask);
+    builder.SetCooccurrenceBinning(minimum, maximum, bins);
+    builder.SetCooccurrenceOffsets(offsets);
+    builder.Update();
+
+    const auto &matrices = builder.GetCooccurrenceMatrices();
+    CPPUNIT_ASSERT_EQUAL(offsets.size(), matrices.size());
+
+    auto toBin = [&](double value) {
+      int index = std::floor((value - minimum) / ((maximum - minimum) / bins));
+      return std::max(0, std::min(index, bins - 1));
+    };
+
+    const auto region = m_Mask->GetLargestPossibleRegion();
+    for (std::size_t k = 0; k < offsets.size(); ++k)
+    {
+      Eigen::MatrixXd expected = Eigen::MatrixXd::Zero(bins, bins);
+
+      itk::ImageRegionConstIteratorWithIndex<MaskType> iter(m_Mask, region);
+      for (; !iter.IsAtEnd(); ++iter)
+      {
+        const auto neighbour = iter.GetIndex() + offsets[k];
+        if (iter.Get() == 0 || !region.IsInside(neighbour) || m_Mask->GetPixel(neighbour) == 0)
+          continue;
+
+        const int i = toBin(m_Image->GetPixel(iter.GetIndex()));
+        const int j = toBin(m_Image->GetPixel(neighbour));
+        expected(i, j) += 1;
+        expected(j, i) += 1;
+      }
+
+      CPPUNIT_ASSERT_MESSAGE("Co-occurrence matrix of offset " + std::to_string(k), expected == matrices[k]);
+    }
+  }
+
+  void RunLengthMatricesEqualITKFilter()
+  {
+    typedef itk::Statistics::EnhancedScalarImageToRunLengthMatrixFilter<ImageType> FilterType;
+
+    const auto offsets = GetOffsets();
+    const int bins = 6;
+
+    ImageType::Pointer mask;
+    mitk::CastToItkImage(m_MitkMask, mask);
+
+    BuilderType builder(m_Image, m_Mask);
+    builder.SetRunLengthBinning(1, 6, bins);
+    builder.SetRunLengthOffsets(offsets);
+    builder.Update();
+
+    const auto &matrices = builder.GetRunLengthMatrices();
+    CPPUNIT_ASSERT_EQUAL(offsets.size(), matrices.size());
+
+    for (std::size_t k = 0; k < offsets.size(); ++k)
+    {
+      auto filter = FilterType::New();
+      filter->SetInput(m_Image);
+      filter->SetMaskImage(mask);
+      filter->SetOffset(offsets[k]);
+      filter->SetPixelValueMinMax(1, 6);
+      filter->SetNumberOfBinsPerAxis(bins);
+      filter->SetDistanceValueMinMax(0, bins);
+      filter->Update();
+
+      auto histogram = filter->GetOutput();
+      FilterType::HistogramType::IndexType index(2);
+      for (int i = 0; i < bins; ++i)
+      {
+        for (int j = 0; j < bins; ++j)
+        {
+          index[0] = i;
+          index[1] = j;
+          CPPUNIT_ASSERT_EQUAL_MESSAGE("Run-length matrix of offset " + std::to_string(k),
+            static_cast<double>(histogram->GetFrequency(index)), matrices[k](i, j));
+        }
+      }
+    }
+  }
+
+  void ResultIsIndependentOfNumberOfThreads()
+  {
+    const auto offsets = GetOffsets();
+
+    BuilderType singleThreaded(m_Image, m_Mask);
+    singleThreaded.SetNumberOfThreads(1);
+    singleThreaded.SetCooccurrenceBinning(0.5, 6.5, 6);
+    singleThreaded.SetCooccurrenceOffsets(offsets);
+    singleThreaded.SetRunLengthBinning(1, 6, 6);
+    singleThreaded.SetRunLengthOffsets(offsets);
+    singleThreaded.Update();
+
+    BuilderType multiThreaded(m_Image, m_Mask);
+    multiThreaded.SetNumberOfThreads(8);
+    multiThreaded.SetCooccurrenceBinning(0.5, 6.5, 6);
+    multiThreaded.SetCooccurrenceOffsets(offsets);
+    multiThreaded.SetRunLengthBinning(1, 6, 6);
+    multiThreaded.SetRunLengthOffsets(offsets);
+    multiThreaded.Update();
+
+    for (std::size_t k = 0; k < offsets.size(); ++k)
+    {
+      CPPUNIT_ASSERT(singleThreaded.GetCooccurrenceMatrices()[k] == multiThreaded.GetCooccurrenceMatrices()[k]);
+      CPPUNIT_ASSERT(singleThreaded.GetRunLengthMatrices()[k] == multiThreaded.GetRunLengthMatrices()[k]);
+    }
+  }
+};
+
+MITK_TEST_SUITE_REGISTRATION(mitkTextureMatrixBuilder)
@@ -135,6 +135,8 @@ set(CPP_FILES
   DataManagement/mitkNodePredicateSubGeometry.cpp
   DataManagement/mitkNodeSelectionService.cpp
   DataManagement/mitkNumericConstants.cpp
+  DataManagement/mitkPagedMemory.cpp
+  DataManagement/mitkPagedMemoryManager.cpp
   DataManagement/mitkPlaneGeometry.cpp
   DataManagement/mitkPlaneGeometryData.cpp
   DataManagement/mitkPlaneOperation.cpp
@@ -150,6 +152,7 @@ set(CPP_FILES
   DataManagement/mitkPropertyExtensions.cpp
   DataManagement/mitkPropertyFilter.cpp
   DataManagement/mitkPropertyFilters.cpp
+  DataManagement/mitkPropertyKeyAtom.cpp
   DataManagement/mitkPropertyKeyPath.cpp
   DataManagement/mitkPropertyList.cpp
   DataManagement/mitkPropertyListReplacedObserver.cpp
@@ -229,11 +232,13 @@ set(CPP_FILES
   IO/mitkAbstractFileIO.cpp
   IO/mitkAbstractFileReader.cpp
   IO/mitkAbstractFileWriter.cpp
+  IO/mitkBatchFileLoader.cpp
   IO/mitkCustomMimeType.cpp
   IO/mitkFileReader.cpp
   IO/mitkFileReaderRegistry.cpp
   IO/mitkFileReaderSelector.cpp
   IO/mitkFileReaderWriterBase.cpp
+  IO/mitkFileSignature.cpp
   IO/mitkFileWriter.cpp
   IO/mitkFileWriterRegistry.cpp
   IO/mitkFileWriterSelector.cpp
@@ -260,8 +265,10 @@ set(CPP_FILES
   IO/mitkLegacyFileWriterService.cpp
   IO/mitkLocaleSwitch.cpp
   IO/mitkLogBackend.cpp
+  IO/mitkMemoryMappedFile.cpp
   IO/mitkMimeType.cpp
   IO/mitkMimeTypeProvider.cpp
+  IO/mitkNrrdCompression.cpp
   IO/mitkOperation.cpp
   IO/mitkPixelType.cpp
   IO/mitkPointSetReaderService.cpp
@@ -283,6 +290,7 @@ set(CPP_FILES
   Rendering/mitkAbstractAnnotationRenderer.cpp
   Rendering/mitkAnnotation.cpp
   Rendering/mitkAnnotationUtils.cpp
+  Rendering/mitkAsyncSliceProducer.cpp
   Rendering/mitkBaseRenderer.cpp
   Rendering/mitkBaseRendererHelper.cpp
   Rendering/mitkCrosshairVtkMapper2D.cpp
@@ -0,0 +1,101 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#ifndef mitkAsyncSliceProducer_h
+#define mitkAsyncSliceProducer_h
+
+#include <MitkCoreExports.h>
+#include <mitkExtractSliceFilter.h>
+
+#include <memory>
+
+namespace mitk
+{
+  class BaseRenderer;
+
+  /**
+   * \brief Extracts slices for 2D mappers on background worker threads.
+   *
+   * A producer belongs to a single mapper and renderer (see ImageVtkMapper2D::LocalStorage).
+   * Submit() hands a completely configured ExtractSliceFilter over to a small pool of worker
+   * threads that is shared by all producers. The filter must not be touched by the caller
+   * afterwards.
+   *
+   * Every submission supersedes all earlier submissions of the same producer: a superseded
+   * request that was not started yet is dropped without being executed and the result of a
+   * superseded request that is already running is discarded. Thus at most one outdated slice
+   * per producer is computed while the user is still navigating.
+   *
+   * As soon as the slice of the latest request is finished, an update of the render window of the
+   * renderer is requested (see RenderingManager::RequestUpdateFromWorkerThread()) and the mapper takes
+   * the filter with TakeResult() during rendering. Until then the mapper keeps showing the last
+   * finished slice.
+   *
+   * While a slice is extracted, the worker holds an ImageReadAccessor of the input image, so
+   * tools writing to the image through an ImageWriteAccessor wait for the extraction to finish.
+   *
+   * The latency between submitting a request and taking its result is recorded per renderer,
+   * see GetLatencyMetrics(). The metrics of a renderer are removed when it is unregistered.
+   */
+  class MITKCORE_EXPORT AsyncSliceProducer
+  {
+  public:
+    struct MITKCORE_EXPORT LatencyMetrics
+    {
+      std::size_t numberOfSubmittedSlices = 0;
+      std::size_t numberOfDeliveredSlices = 0;
+      /** Slices that were superseded or cancelled before they were delivered.*/
+      std::size_t numberOfCancelledSlices = 0;
+      /** Latencies in milliseconds from Submit() to TakeResult() of delivered slices.*/
+      double lastLatency = 0.0;
+      double meanLatency = 0.0;
+      double maximumLatency = 0.0;
+    };
+
+    AsyncSliceProducer();
+    ~AsyncSliceProducer();
+
+    AsyncSliceProducer(const AsyncSliceProducer&) = delete;
+    AsyncSliceProducer& operator=(const AsyncSliceProducer&) = delete;
+
+    /** \brief Extracts a slice with the passed filter in the background.
+     * The filter is updated on a worker thread and must be completely configured, including the
+     * VTK output request. Geometries that are modified on the rendering thread (e.g. the current
+     * world plane geometry of the renderer) have to be passed as copies.
+     */
+    void Submit(ExtractSliceFilter* reslicer, const BaseRenderer* renderer);
+
+    /** Indicates if the slice of the latest request is finished and can be taken.*/
+    bool IsResultAvailable() const;
+
+    /** Indicates if a submitted request was neither delivered nor cancelled yet.*/
+    bool IsBusy() const;
+
+    /** Returns the updated filter of the latest request or nullptr if it is not finished yet.*/
+    ExtractSliceFilter::Pointer TakeResult();
+
+    /** Drops all outstanding requests and results.*/
+    void Cancel();
+
+    static LatencyMetrics GetLatencyMetrics(const BaseRenderer* renderer);
+    static void ResetLatencyMetrics(const BaseRenderer* renderer);
+
+  private:
+    class WorkerPool;
+    struct State;
+
+    std::shared_ptr<WorkerPool> m_WorkerPool;
+    std::shared_ptr<State> m_State;
+  };
+}
+
+#endif
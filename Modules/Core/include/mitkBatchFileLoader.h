@@ -0,0 +1,124 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#ifndef mitkBatchFileLoader_h
+#define mitkBatchFileLoader_h
+
+#include <MitkCoreExports.h>
+#include <mitkDataStorage.h>
+
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace mitk
+{
+  /**
+   * \brief Loads a list of files concurrently on a bounded pool of worker threads.
+   *
+   * Start() returns immediately. Readers are selected and files are decoded on up to
+   * GetNumberOfThreads() worker threads, while the calling thread collects the results
+   * with AddCompleted() (e.g. from a GUI timer) or WaitAndAddAll(). Results are always
+   * added to the data storage on the calling thread and in the order of the paths, no
+   * matter in which order the workers finish, so the content of the data storage does
+   * not depend on the number of threads.
+   *
+   * A memory limit bounds the amount of data that is decoded but not yet added to the
+   * data storage. The memory needed by a file is estimated from its size on disk
+   * (four times the size for compressed files). A worker does not start a file that
+   * would exceed the limit as long as other files are pending, so a single file larger
+   * than the limit is still loaded.
+   *
+   * The progress callback is called on the calling thread, once per file and in the
+   * order of the paths, from within AddCompleted() and WaitAndAddAll(). Files that cannot
+   * be loaded do not stop the remaining files; their errors are reported by the progress
+   * callback and GetErrors().
+   *
+   * Readers that load several files at once (e.g. a DICOM series from one of its files)
+   * report the files they read. Paths that were already read as part of an earlier path
+   * are skipped as in IOUtil::Load(), before they are decoded if the earlier path is
+   * finished when they are started. DICOM files of the same directory are decoded one
+   * at a time, so that the remaining files of a series are not decoded again while its
+   * first file is read.
+   *
+   * \sa IOUtil::LoadConcurrently()
+   */
+  class MITKCORE_EXPORT BatchFileLoader
+  {
+  public:
+    struct MITKCORE_EXPORT Progress
+    {
+      /** Index of the file in the list of paths.*/
+      std::size_t m_Index = 0;
+      std::string m_Path;
+      /** Empty if the file was loaded successfully.*/
+      std::string m_Error;
+      std::size_t m_NumberOfProcessedFiles = 0;
+      std::size_t m_NumberOfFiles = 0;
+    };
+
+    using ProgressCallback = std::function<void(const Progress &)>;
+
+    explicit BatchFileLoader(const std::vector<std::string> &paths);
+
+    /** Cancels pending files and waits for the worker threads.*/
+    ~BatchFileLoader();
+
+    BatchFileLoader(const BatchFileLoader &) = delete;
+    BatchFileLoader &operator=(const BatchFileLoader &) = delete;
+
+    /** Number of worker threads. 0 (default) uses the number of hardware threads.*/
+    void SetNumberOfThreads(unsigned int numberOfThreads);
+    unsigned int GetNumberOfThreads() const;
+
+    /** Upper bound in bytes for decoded data that was not added yet. 0 (default) is unlimited.*/
+    void SetMemoryLimit(std::size_t memoryLimit);
+    std::size_t GetMemoryLimit() const;
+
+    void SetProgressCallback(const ProgressCallback &callback);
+
+    /** \brief Starts loading in the background.
+     * \throws mitk::Exception if the loader was already started.
+     */
+    void Start();
+
+    /** \brief Skips all files that were not started yet.
+     * Files that are currently decoded are finished and can still be added.
+     */
+    void Cancel();
+
+    /** Indicates if the results of all files were added (or skipped after Cancel()).*/
+    bool IsFinished() const;
+
+    /** \brief Adds the results of all files that are finished without a gap in the order of paths.
+     * Does not block.
+     * \return The added data nodes.
+     */
+    DataStorage::SetOfObjects::Pointer AddCompleted(DataStorage &storage);
+
+    /** \brief Waits for all files and adds their results as soon as they are available.
+     * Starts the loader if necessary.
+     * \return The data nodes added by this call.
+     */
+    DataStorage::SetOfObjects::Pointer WaitAndAddAll(DataStorage &storage);
+
+    /** Errors of all files processed so far, one entry per failed file.*/
+    std::vector<std::string> GetErrors() const;
+
+  private:
+    struct Impl;
+    std::unique_ptr<Impl> m_Impl;
+  };
+}
+
+#endif
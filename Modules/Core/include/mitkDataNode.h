@@ -65,7 +65,7 @@ namespace mitk
   public:
     typedef mitk::Geometry3D::Pointer Geometry3DPointer;
     typedef std::vector<itk::SmartPointer<Mapper>> MapperVector;
-    typedef std::map<std::string, mitk::PropertyList::Pointer> MapOfPropertyLists;
+    typedef std::map<std::string, mitk::PropertyList::Pointer, std::less<>> MapOfPropertyLists;
     typedef std::vector<MapOfPropertyLists::key_type> PropertyListKeyNames;
     typedef std::set<std::string> GroupTagList;
 
@@ -237,6 +237,17 @@ namespace mitk
      */
     mitk::BaseProperty *GetProperty(const char *propertyKey, const mitk::BaseRenderer *renderer = nullptr, bool fallBackOnDataProperties = true) const;
 
+    /**
+     * \brief Get the property with the interned key \a propertyKey, following the same
+     * lookup order as GetProperty(const char*, const mitk::BaseRenderer*, bool).
+     *
+     * Neither compares property keys as strings nor allocates memory, which makes it the
+     * method of choice for mappers.
+     *
+     * \sa PropertyKeyAtom
+     */
+    mitk::BaseProperty *GetProperty(const PropertyKeyAtom &propertyKey, const mitk::BaseRenderer *renderer = nullptr, bool fallBackOnDataProperties = true) const;
+
     /**
      * \brief Get the property of type T with key \a propertyKey from the PropertyList
      * of the \a renderer, if available there, otherwise use the BaseRenderer-independent PropertyList.
@@ -302,6 +313,13 @@ namespace mitk
      */
     bool GetBoolProperty(const char *propertyKey, bool &boolValue, const mitk::BaseRenderer *renderer = nullptr) const;
 
+    /**
+     * \brief Convenience access method for bool properties (instances of
+     * BoolProperty) by interned key
+     * \return \a true property was found
+     */
+    bool GetBoolProperty(const PropertyKeyAtom &propertyKey, bool &boolValue, const mitk::BaseRenderer *renderer = nullptr) const;
+
     /**
      * \brief Convenience access method for int properties (instances of
      * IntProperty)
@@ -309,6 +327,13 @@ namespace mitk
      */
     bool GetIntProperty(const char *propertyKey, int &intValue, const mitk::BaseRenderer *renderer = nullptr) const;
 
+    /**
+     * \brief Convenience access method for int properties (instances of
+     * IntProperty) by interned key
+     * \return \a true property was found
+     */
+    bool GetIntProperty(const PropertyKeyAtom &propertyKey, int &intValue, const mitk::BaseRenderer *renderer = nullptr) const;
+
     /**
      * \brief Convenience access method for float properties (instances of
      * FloatProperty)
@@ -318,6 +343,15 @@ namespace mitk
                           float &floatValue,
                           const mitk::BaseRenderer *renderer = nullptr) const;
 
+    /**
+     * \brief Convenience access method for float properties (instances of
+     * FloatProperty) by interned key
+     * \return \a true property was found
+     */
+    bool GetFloatProperty(const PropertyKeyAtom &propertyKey,
+                          float &floatValue,
+                          const mitk::BaseRenderer *renderer = nullptr) const;
+
     /**
      * \brief Convenience access method for double properties (instances of
      * DoubleProperty)
@@ -347,6 +381,13 @@ namespace mitk
      */
     bool GetColor(float rgb[3], const mitk::BaseRenderer *renderer = nullptr, const char *propertyKey = "color") const;
 
+    /**
+     * \brief Convenience access method for color properties (instances of
+     * ColorProperty) by interned key, e.g. PropertyKeyAtom::Color()
+     * \return \a true property was found
+     */
+    bool GetColor(float rgb[3], const mitk::BaseRenderer *renderer, const PropertyKeyAtom &propertyKey) const;
+
     /**
      * \brief Convenience access method for level-window properties (instances of
      * LevelWindowProperty)
@@ -450,6 +491,16 @@ namespace mitk
       return GetBoolProperty(propertyKey, visible, renderer);
     }
 
+    /**
+     * \brief Convenience access method for visibility properties by interned key,
+     * e.g. PropertyKeyAtom::Visible()
+     * \return \a true property was found
+     */
+    bool GetVisibility(bool &visible, const mitk::BaseRenderer *renderer, const PropertyKeyAtom &propertyKey) const
+    {
+      return GetBoolProperty(propertyKey, visible, renderer);
+    }
+
     /**
      * \brief Convenience access method for opacity properties (instances of
      * FloatProperty)
@@ -457,6 +508,13 @@ namespace mitk
      */
     bool GetOpacity(float &opacity, const mitk::BaseRenderer *renderer, const char *propertyKey = "opacity") const;
 
+    /**
+     * \brief Convenience access method for opacity properties by interned key,
+     * e.g. PropertyKeyAtom::Opacity()
+     * \return \a true property was found
+     */
+    bool GetOpacity(float &opacity, const mitk::BaseRenderer *renderer, const PropertyKeyAtom &propertyKey) const;
+
     /**
      * \brief Convenience access method for boolean properties (instances
      * of BoolProperty). Return value is the value of the property. If the property is
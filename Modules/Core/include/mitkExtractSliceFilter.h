@@ -14,6 +14,7 @@ found in the LICENSE file.
 #define mitkExtractSliceFilter_h
 
 #include "MitkCoreExports.h"
+#include "mitkExtractSliceFilter2.h"
 #include "mitkImageToImageFilter.h"
 
 #include <vtkAbstractTransform.h>
@@ -79,6 +80,8 @@ namespace mitk
       }
     }
 
+    const PlaneGeometry *GetWorldGeometry() const { return m_WorldGeometry; }
+
     /** \brief Set the time step in the 4D volume */
     void SetTimeStep(unsigned int timestep) { m_TimeStep = timestep; }
     unsigned int GetTimeStep() { return m_TimeStep; }
@@ -135,6 +138,8 @@ namespace mitk
     vtkImageData *GetVtkOutput()
     {
       m_VtkOutputRequested = true;
+      if (m_ExtractSliceFilter2OutputValid && 2 == m_OutputDimension)
+        return m_ExtractSliceFilter2Output;
       return m_Reslicer->GetOutput();
     }
 
@@ -162,6 +167,17 @@ namespace mitk
       this->m_InterpolationMode = interpolation;
     }
 
+    /** \brief Use the multithreaded mitk::ExtractSliceFilter2 instead of vtkImageReslice where possible.
+    * This applies to 2D VTK output (see SetVtkOutputRequest()) of single component 3D or 4D images
+    * resliced along a plane geometry with a reslice transform (see SetResliceTransformByGeometry()),
+    * which is the typical use in 2D mappers. In all other cases vtkImageReslice is used. The reslice axes
+    * and the extent, spacing and origin of the VTK output are the same for both ways. Pixels outside
+    * of the input image are set to the lowest possible pixel value instead of the background level.
+    * Default is false.
+    */
+    void SetUseExtractSliceFilter2(bool useExtractSliceFilter2) { m_UseExtractSliceFilter2 = useExtractSliceFilter2; }
+    bool GetUseExtractSliceFilter2() const { return m_UseExtractSliceFilter2; }
+
   protected:
     ExtractSliceFilter(vtkImageReslice *reslicer = nullptr);
     ~ExtractSliceFilter() override;
@@ -195,7 +211,17 @@ namespace mitk
 
     unsigned int m_Component;
 
+    bool m_UseExtractSliceFilter2;
+
   private:
+    /** Reslices with m_ExtractSliceFilter2 into m_ExtractSliceFilter2Output. Returns false if
+     * the input cannot be resliced this way.*/
+    bool GenerateDataWithExtractSliceFilter2(const Point3D &origin);
+
+    ExtractSliceFilter2::Pointer m_ExtractSliceFilter2;
+    vtkSmartPointer<vtkImageData> m_ExtractSliceFilter2Output;
+    bool m_ExtractSliceFilter2OutputValid;
+
     BaseGeometry::ConstPointer m_ResliceTransform;
     /* Axis vectors of the relevant geometry. Set in GenerateOutputInformation() and also used in GenerateData().*/
     Vector3D m_Right, m_Bottom;
@@ -32,10 +32,17 @@ namespace mitk
    * faster by several orders of magnitude as long as the input image was
    * neither changed nor modified.
    *
+   * Nearest neighbor and linear interpolation are done by specialized
+   * kernels that work directly on the pixel buffer: the affine mapping from
+   * output pixels to input indices is determined once, every row is clipped
+   * against the input image in advance, and the inner loops neither call
+   * virtual functions nor check bounds. The output is split into tiles that
+   * are processed in parallel.
+   *
    * This filter is completely based on ITK compared to the VTK-based
    * mitk::ExtractSliceFilter. It is more robust, easy to use, and produces
-   * an mitk::Image with valid geometry. Generally it is not as fast as
-   * mitk::ExtractSliceFilter, though.
+   * an mitk::Image with valid geometry. mitk::ExtractSliceFilter can use it
+   * for plane geometries (see ExtractSliceFilter::SetUseExtractSliceFilter2()).
    */
   class MITKCORE_EXPORT ExtractSliceFilter2 final : public ImageToImageFilter
   {
@@ -67,8 +74,6 @@ namespace mitk
     ~ExtractSliceFilter2() override;
 
     void AllocateOutputs() override;
-    // void BeforeThreadedGenerateData() override;
-    // void ThreadedGenerateData(const OutputImageRegionType& outputRegionForThread, itk::ThreadIdType threadId) override;
     void GenerateData() override;
     void VerifyInputInformation() const override;
 
@@ -19,6 +19,7 @@ found in the LICENSE file.
 
 #include <usServiceReference.h>
 
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -55,8 +56,41 @@ namespace mitk
       us::SharedDataPointer<Impl> d;
     };
 
+    /**
+     * @brief Shares reader confidence levels between selectors for files of the same directory.
+     *
+     * Selecting readers for every file of a large DICOM series asks each reader
+     * for its confidence level over and over again with the same outcome. A
+     * selector constructed with a cache re-uses the confidence levels computed
+     * for a previous file in the same directory with the same extension, file
+     * signature and detected mime types.
+     *
+     * Only files identified as DICOM by their signature (see FileSignature) are
+     * cached, since readers of other formats may inspect the file content to
+     * decide about their confidence. The cache is thread-safe and intended to
+     * live for the duration of a single batch load.
+     */
+    class MITKCORE_EXPORT ConfidenceCache
+    {
+    public:
+      ConfidenceCache();
+      ~ConfidenceCache();
+
+      ConfidenceCache(const ConfidenceCache &) = delete;
+      ConfidenceCache &operator=(const ConfidenceCache &) = delete;
+
+      void Clear();
+
+    private:
+      friend class FileReaderSelector;
+
+      struct Impl;
+      std::unique_ptr<Impl> d;
+    };
+
     FileReaderSelector(const FileReaderSelector &other);
     FileReaderSelector(const std::string &path);
+    FileReaderSelector(const std::string &path, ConfidenceCache *confidenceCache);
 
     ~FileReaderSelector();
 
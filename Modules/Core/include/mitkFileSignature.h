@@ -0,0 +1,86 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#ifndef mitkFileSignature_h
+#define mitkFileSignature_h
+
+#include <MitkCoreExports.h>
+
+#include <cstddef>
+#include <string>
+
+namespace mitk
+{
+  /**
+   * @ingroup IO
+   *
+   * @brief The leading bytes of a file and the format identified by its magic bytes.
+   *
+   * Mime type detection and reader selection frequently need to look at the
+   * beginning of a file. FileSignature reads a small header once per file and
+   * keeps it in a process-wide cache, so that mime types and readers can share
+   * the result instead of each opening the file again. Cache entries are
+   * invalidated when the size or modification time of a file changes.
+   *
+   * Only formats with an unambiguous signature are identified. A format of
+   * FileSignature::Format::Unknown does not mean the file cannot be read, e.g.
+   * DICOM files without preamble are reported as unknown.
+   *
+   * This class is thread-safe.
+   */
+  class MITKCORE_EXPORT FileSignature
+  {
+  public:
+    enum class Format
+    {
+      Unknown,
+      Dicom,
+      Nrrd,
+      Nifti,
+      VtkLegacy,
+      VtkXml,
+      Gzip
+    };
+
+    /** Number of bytes read from the beginning of a file. */
+    static constexpr std::size_t HeaderSize = 512;
+
+    FileSignature();
+
+    /**
+     * @brief Get the (possibly cached) signature of the file at the given path.
+     *
+     * Returns an invalid signature for directories and files that cannot be opened.
+     */
+    static FileSignature Get(const std::string &path);
+
+    /** @brief Identify the format of an in-memory header. */
+    static Format DetectFormat(const std::string &header);
+
+    static void ClearCache();
+
+    static std::string GetFormatName(Format format);
+
+    bool IsValid() const;
+    Format GetFormat() const;
+
+    /** @brief The first (up to) HeaderSize bytes of the file. */
+    const std::string &GetHeader() const;
+
+  private:
+    bool m_Valid;
+    Format m_Format;
+    std::string m_Header;
+  };
+}
+
+#endif
@@ -56,6 +56,7 @@ namespace mitk
     struct MITKCORE_EXPORT LoadInfo
     {
       LoadInfo(const std::string &path);
+      LoadInfo(const std::string &path, const FileReaderSelector &readerSelector);
 
       std::string m_Path;
       std::vector<BaseData::Pointer> m_Output;
@@ -307,6 +308,10 @@ namespace mitk
      * If an entry in \c paths cannot be loaded, this method will continue to load
      * the remaining entries into \c storage and throw an exception afterwards.
      *
+     * Readers for all entries are selected concurrently before loading starts.
+     * Reader confidence levels are shared between DICOM files of the same
+     * directory (see FileReaderSelector::ConfidenceCache).
+     *
      * @param paths A list of absolute file names including the file extension.
      * @param storage A DataStorage object to which the loaded data will be added.
      * @param optionsCallback Pointer to a callback instance. The callback is used by
@@ -321,6 +326,32 @@ namespace mitk
     static std::vector<BaseData::Pointer> Load(const std::vector<std::string> &paths,
                                                const ReaderOptionsFunctorBase *optionsCallback = nullptr);
 
+    /**
+     * @brief Loads a list of file paths concurrently into the given DataStorage.
+     *
+     * Files are decoded on a bounded pool of worker threads and added to \c storage on
+     * the calling thread in the order of \c paths. Reader options cannot be set, the
+     * default reader of every file is used. Use BatchFileLoader directly to load files
+     * asynchronously or to observe the progress of individual files.
+     *
+     * If an entry in \c paths cannot be loaded, this method will continue to load
+     * the remaining entries into \c storage and throw an exception afterwards.
+     *
+     * @param paths A list of absolute file names including the file extension.
+     * @param storage A DataStorage object to which the loaded data will be added.
+     * @param numberOfThreads Number of worker threads. 0 uses the number of hardware threads.
+     * @param memoryLimit Upper bound in bytes for decoded data that was not added to \c storage
+     * yet. 0 is unlimited.
+     * @return The set of added DataNode objects.
+     * @throws mitk::Exception if an entry in \c paths could not be loaded.
+     *
+     * @sa BatchFileLoader
+     */
+    static DataStorage::SetOfObjects::Pointer LoadConcurrently(const std::vector<std::string> &paths,
+                                                               DataStorage &storage,
+                                                               unsigned int numberOfThreads = 0,
+                                                               std::size_t memoryLimit = 0);
+
     /**
      * @brief Loads the contents of a us::ModuleResource and returns the corresponding mitk::BaseData
      * @param usResource a ModuleResource, representing a BaseData object
@@ -24,6 +24,8 @@ found in the LICENSE file.
 #include <MitkCoreExports.h>
 #include <mitkProportionalTimeGeometry.h>
 
+#include <atomic>
+
 #ifndef __itkHistogram_h
 #include <itkHistogram.h>
 #endif
@@ -215,6 +217,21 @@ namespace mitk
 
     virtual bool SetImportVolume(const void *const_data, int t = 0, int n = 0);
 
+    /**
+      * @brief Use the paged memory block @a pagedMemory as volume at time @a t in channel @a n.
+      *
+      * The volume is not copied and may be evicted from physical memory under the memory
+      * budget of the PagedMemoryManager. It is restored transparently by image accessors,
+      * GetVolumeData() and GetSliceData(). Once the vtkImageData of the volume or of one of its
+      * slices was requested (see GetVtkImageData()), the volume is not evicted anymore, as the
+      * vtkImageData references the memory without an accessor. The block must have the size of a
+      * volume. Combining the volumes to a channel (e.g. by accessing the whole image of a 3D+t image)
+      * copies them into regular memory.
+      *
+      * Returns false if the channel is already set as a whole or the size does not match.
+      */
+    bool SetPagedVolume(std::shared_ptr<PagedMemory> pagedMemory, int t = 0, int n = 0);
+
     /**
       * @brief Set @a data in channel @a n. It is in
       * the responsibility of the caller to ensure that the data vector @a data
@@ -517,6 +534,14 @@ namespace mitk
       */
     StatisticsHolderPointer GetStatistics() const { return m_ImageStatistics; }
 
+    /**
+      \brief Modification time stamp of the last release of a write accessor of the image.
+
+      Writing through an ImageWriteAccessor (or ImagePixelWriteAccessor) does not call Modified(). Caches
+      of the pixel content can compare this time stamp with GetMTime() to notice such writes.
+      */
+    itk::ModifiedTimeType GetLastWriteAccessTime() const { return m_LastWriteAccessTime; }
+
   protected:
     mitkCloneMacro(Self);
 
@@ -612,6 +637,11 @@ namespace mitk
     mutable std::mutex m_ReadWriteLock;
     /** A mutex, which needs to be locked to manage m_VtkReaders */
     mutable std::mutex m_VtkReadersLock;
+
+    /** Called by the write accessors when they are released */
+    void WriteAccessReleased() const;
+
+    mutable std::atomic<itk::ModifiedTimeType> m_LastWriteAccessTime;
   };
 
 
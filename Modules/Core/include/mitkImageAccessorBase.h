@@ -141,6 +141,17 @@ namespace mitk
     /** \brief Prevents a recursive mutex lock by comparing thread ids of competing image accessors */
     void PreventRecursiveMutexLock(ImageAccessorBase *iAB);
 
+    /** \brief Prevents the eviction of the accessed image part, if it is paged memory (see
+     * ImageDataItem::GetPagedMemory()), until the accessor is destroyed. The memory is restored if
+     * it was evicted. Long-living accessors (e.g. of the vtkImageData of an image item) must not pin,
+     * their memory is restored by Image::GetVtkImageData() instead.*/
+    void PinPagedMemory();
+
+    /** \brief Paged memory of the accessed image part, if any.*/
+    std::shared_ptr<PagedMemory> m_PagedMemory;
+
+    bool m_IsPagedMemoryPinned;
+
     virtual const Image *GetImage() const = 0;
 
   private:
@@ -17,10 +17,13 @@ found in the LICENSE file.
 #include <MitkCoreExports.h>
 #include "mitkImageDescriptor.h"
 
+#include <memory>
+
 class vtkImageData;
 
 namespace mitk
 {
+  class PagedMemory;
   class PixelType;
   class ImageVtkReadAccessor;
   class ImageVtkWriteAccessor;
@@ -117,6 +120,31 @@ namespace mitk
 
     // Returns if image data should be deleted on destruction of ImageDataItem.
     bool GetManageMemory() const { return m_ManageMemory; }
+
+    /**
+     * @brief Keeps an arbitrary object alive as long as this item exists.
+     *
+     * Meant for data that is neither managed by the item itself nor referenced from memory
+     * that outlives the image, e.g. the pages of a memory mapped file (see
+     * ItkImageIO::LoadMode::MemoryMapped). Sub-items reference their parent, so it is sufficient
+     * to set the owner on the channel item. The data must not be managed by the item.
+     */
+    void SetMemoryOwner(std::shared_ptr<const void> owner) { m_MemoryOwner = owner; }
+    std::shared_ptr<const void> GetMemoryOwner() const { return m_MemoryOwner; }
+
+    /**
+     * @brief Returns the PagedMemory block of this item or of its parent, if any.
+     *
+     * Data of items with paged memory may be evicted from physical memory. Image accessors pin
+     * the block for their lifetime, Image::GetVolumeData() and Image::GetSliceData() restore it.
+     * The vtkImageData of an item references the data without pinning the block. It is restored
+     * by Image::GetVtkImageData(), consumers that read it over a longer period pin the block meanwhile.
+     */
+    std::shared_ptr<PagedMemory> GetPagedMemory() const;
+
+    /** @brief Restores the data if it is paged memory that was evicted and marks it as recently used.*/
+    void MakeResident() const;
+
     virtual void ConstructVtkImageData(ImageConstPointer) const;
 
     size_t GetSize() const { return m_Size; }
@@ -150,6 +178,10 @@ namespace mitk
 
     ImageDataItem::ConstPointer m_Parent;
 
+    std::shared_ptr<const void> m_MemoryOwner;
+
+    std::shared_ptr<PagedMemory> m_PagedMemory;
+
     unsigned int m_Dimension;
 
     unsigned int m_Dimensions[MAX_IMAGE_DIMENSIONS];
@@ -17,6 +17,7 @@ found in the LICENSE file.
 #include <mitkCommon.h>
 
 // MITK Rendering
+#include "mitkAsyncSliceProducer.h"
 #include "mitkBaseRenderer.h"
 #include "mitkExtractSliceFilter.h"
 #include "mitkVtkMapper.h"
@@ -88,6 +89,9 @@ namespace mitk
    *   - \b "texture interpolation": (BoolProperty) texture interpolation of the image
    *   - \b "reslice interpolation": (VtkResliceInterpolationProperty) reslice interpolation of the image
    *   - \b "in plane resample extent by geometry": (BoolProperty) Do it or not
+   *   - \b "multithreaded reslicing": (BoolProperty) Extract slices with mitk::ExtractSliceFilter2 where possible (default: true)
+   *   - \b "asynchronous reslicing": (BoolProperty) Extract slices on a worker thread and show the last slice until
+   *          the new one is finished (default: false), see mitk::AsyncSliceProducer
    *   - \b "bounding box": (BoolProperty) Is the Bounding Box of the image shown or not
    *   - \b "layer": (IntProperty) Layer of the image
    *   - \b "volume annotation color": (ColorProperty) color of the volume annotation, TODO has to be reimplemented
@@ -181,6 +185,8 @@ namespace mitk
       vtkSmartPointer<vtkLookupTable> m_ColorLookupTable;
       /** \brief The actual reslicer (one per renderer) */
       mitk::ExtractSliceFilter::Pointer m_Reslicer;
+      /** \brief Extracts slices in the background if asynchronous reslicing is enabled. */
+      mitk::AsyncSliceProducer m_SliceProducer;
       /** \brief Filter for thick slices */
       vtkSmartPointer<vtkMitkThickSlicesFilter> m_TSFilter;
       /** \brief PolyData object containing all lines/points needed for outlining the contour.
@@ -267,6 +273,10 @@ namespace mitk
       */
     void GenerateDataForRenderer(mitk::BaseRenderer *renderer) override;
 
+    /** \brief Sets up the level window filter, the texture and the textured plane (or the outline)
+      * for the slice in m_ReslicedImage that was extracted by m_Reslicer.*/
+    void ApplySlice(mitk::BaseRenderer *renderer);
+
     /** \brief This method uses the vtkCamera clipping range and the layer property
       * to calculate the depth of the object (e.g. image or contour). The depth is used
       * to keep the correct order for the final VTK rendering.*/
@@ -56,9 +56,42 @@ namespace mitk
     @param dictionary Reference to the meta data dictionary that contains the information that should be extracted.*/
     static PropertyList::Pointer ExtractMetaDataAsPropertyList(const itk::MetaDataDictionary& dictionary, const std::string& mimeTypeName, const std::vector<std::string>& defaultMetaDataKeys);
 
+    /** Strategies to get the pixel data of a file into an mitk::Image.*/
+    enum class LoadMode
+    {
+      /** The complete pixel data is read into a single buffer with one read call.*/
+      Complete,
+      /** The pixel data is read time step by time step, each in slabs of slices, via the streaming region API of
+      the ImageIO. Every time step becomes a separately allocated volume of the image. Requires an ImageIO that can
+      stream the requested regions and at least three dimensions, otherwise the image is loaded completely.*/
+      Streamed,
+      /** The pixel data of uncompressed NRRD, NIfTI (.nii) and MetaImage (.mha) files with a single component
+      and native byte order is mapped into memory copy-on-write instead of being read. Pages are loaded from disk when
+      they are accessed and modifications are never written back to the file. The file must not be modified
+      while the image exists, saving an image to a mapped file replaces the file instead. Files that cannot be
+      mapped, e.g. because their pixel data is not aligned to the component size, are loaded streamed.*/
+      MemoryMapped,
+      /** Every time step becomes a PagedMemory volume (see Image::SetPagedVolume()), which is evicted from physical
+      memory under the budget of the PagedMemoryManager. For files that qualify for LoadMode::MemoryMapped, no time
+      step is read before it is accessed for the first time and evicted time steps are read again from the file.
+      Other files are read streamed and evicted time steps are written to spill files. 2D images and files that can
+      neither be mapped nor streamed are loaded completely.*/
+      Paged
+    };
+
     /** Helper function that can be used to extract a raw mitk image for the passed path using the also passed ImageIOBase instance.
-    Raw means, that only the pixel data and geometry information is loaded. But e.g. no properties etc...*/
-    static Image::Pointer LoadRawMitkImageFromImageIO(itk::ImageIOBase* imageIO, const std::string& path);
+    Raw means, that only the pixel data and geometry information is loaded. But e.g. no properties etc...
+    @param loadMode Determines how the pixel data is loaded, see LoadMode.*/
+    static Image::Pointer LoadRawMitkImageFromImageIO(itk::ImageIOBase* imageIO, const std::string& path, LoadMode loadMode = LoadMode::Complete);
+
+    /** Indicates if the pixel data of the file, whose image information was already read by the passed ImageIO, can be
+    loaded with LoadMode::MemoryMapped.*/
+    static bool CanLoadMemoryMapped(itk::ImageIOBase* imageIO, const std::string& path);
+
+    /** Load mode that is used by all ItkImageIO readers. Default is LoadMode::Complete. The workbench sets it
+    according to the general preferences.*/
+    static void SetDefaultLoadMode(LoadMode loadMode);
+    static LoadMode GetDefaultLoadMode();
 
     /** Helper function that can be used to prepare a mitk image being written to file using the also passed ImageIOBase instance.*/
     static void PreparImageIOToWriteImage(itk::ImageIOBase* imageIO, const Image* image);
@@ -73,6 +106,9 @@ namespace mitk
     // Fills the m_DefaultMetaDataKeys vector with default values
     virtual void InitializeDefaultMetaDataKeys();
 
+    // Offers the compression options of NrrdCompression if the ImageIO writes NRRD files
+    void InitializeDefaultWriterOptions();
+
     // -------------- AbstractFileReader -------------
     std::vector<itk::SmartPointer<BaseData>> DoRead() override;
 
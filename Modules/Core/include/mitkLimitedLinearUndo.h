@@ -104,6 +104,26 @@ namespace mitk
     //## @param limit the maximum number of items on the stack
     void SetUndoLimit(std::size_t limit) override;
 
+    //##Documentation
+    //## @brief Gets the limit on the memory occupied by the undo history in megabytes.
+    //## If the value is 0 that means that there is no limit.
+    std::size_t GetMemoryLimit() const;
+
+    //##Documentation
+    //## @brief Sets a limit on the memory occupied by the undo history.
+    //## The memory of an item is reported by UndoStackItem::GetMemorySize().
+    //## If the limit is exceeded, the oldest undo items will be dropped
+    //## from the bottom of the undo stack. The newest item is always kept,
+    //## even if it alone exceeds the limit. The limit applies in addition
+    //## to the undo limit (number of items).
+    //## The 0 value means that there is no limit.
+    //## @param megaBytes the maximum memory of all items on the undo stack in megabytes
+    void SetMemoryLimit(std::size_t megaBytes);
+
+    //##Documentation
+    //## @brief Returns the memory in bytes currently occupied by the items of the undo and redo stack.
+    std::size_t GetMemorySize() const;
+
     //##Documentation
     //## @brief Returns the ObjectEventId of the
     //## top element in the OperationHistory
@@ -139,6 +159,9 @@ namespace mitk
     //## elements in the list and to clear the list
     void ClearList(UndoContainer *list);
 
+    //## @brief Drops the oldest undo items until the undo stack meets the memory limit.
+    void EnforceMemoryLimit();
+
     UndoContainer m_UndoList;
 
     UndoContainer m_RedoList;
@@ -148,6 +171,8 @@ namespace mitk
 
     std::size_t m_UndoLimit;
 
+    std::size_t m_MemoryLimit;
+
   };
 
 #pragma GCC visibility push(default)
@@ -29,8 +29,10 @@ namespace mitk
     printing numbers, in order to consistently get "." and not "," as
     a decimal separator.
 
-    WARNING: Please be aware that using setlocale and there for is not thread
-    safe. So use this class with care (see task T24295 for more information.
+    The locale is only switched for the calling thread (uselocale() on POSIX
+    systems, a per-thread locale on Windows), so readers and writers running
+    concurrently (e.g. mitk::BatchFileLoader) do not change the locale of each
+    other or of the GUI thread (see task T24295).
     This switch is especially use full if you have to deal with third party code
     where you have to control the locale via set locale
     \code
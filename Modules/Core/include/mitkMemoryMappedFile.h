@@ -0,0 +1,65 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#ifndef mitkMemoryMappedFile_h
+#define mitkMemoryMappedFile_h
+
+#include <MitkCoreExports.h>
+
+#include <cstddef>
+#include <string>
+
+namespace mitk
+{
+  /**
+   * \brief Maps a part of a file into memory.
+   *
+   * The mapping is copy-on-write: the data can be modified, but modifications are private to the
+   * process and never written back to the file. Pages of the file are only read when they are
+   * accessed for the first time, and unmodified pages can be dropped by the operating system at any
+   * time, so they do not count as resident memory of the process.
+   *
+   * The file is unmapped on destruction.
+   *
+   * Truncating or overwriting a mapped file invalidates the mapping, i.e. accessing pages that were not
+   * read yet may crash the process (SIGBUS). Writers have to check IsMapped() and must replace such files
+   * instead of writing to them in place.
+   */
+  class MITKCORE_EXPORT MemoryMappedFile
+  {
+  public:
+    /** \brief Maps length bytes of the file, starting at offset.
+     * \throw mitk::Exception if the file cannot be opened or mapped.
+     */
+    MemoryMappedFile(const std::string& path, std::size_t offset, std::size_t length);
+    ~MemoryMappedFile();
+
+    MemoryMappedFile(const MemoryMappedFile&) = delete;
+    MemoryMappedFile& operator=(const MemoryMappedFile&) = delete;
+
+    /** Mapped data, i.e. the byte at the offset passed to the constructor.*/
+    void* GetData() const;
+    std::size_t GetSize() const;
+
+    /** Indicates if any part of the file is currently mapped by a MemoryMappedFile of this process.*/
+    static bool IsMapped(const std::string& path);
+
+  private:
+    std::string m_Path;
+    void* m_Mapping;
+    std::size_t m_MappingSize;
+    std::size_t m_DataOffset;
+    std::size_t m_Size;
+  };
+}
+
+#endif
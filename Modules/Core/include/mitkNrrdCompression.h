@@ -0,0 +1,97 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#ifndef mitkNrrdCompression_h
+#define mitkNrrdCompression_h
+
+#include <mitkIFileWriter.h>
+#include <MitkCoreExports.h>
+
+#include <itkImageIOBase.h>
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace mitk
+{
+  /**
+   * \brief Compression backends for writing and reading the pixel data of NRRD files.
+   *
+   * The parallel codecs split the pixel data into blocks that are deflated concurrently and
+   * concatenated into a single gzip member, like pigz does. The result is a regular "encoding: gzip"
+   * NRRD file that can be read by any NRRD reader. Additionally, the compressed size of every block
+   * is stored in an extra field of the gzip header, so that MITK can inflate the blocks concurrently
+   * as well (see Read()).
+   *
+   * Writing with the parallel codecs requires an itk::NrrdImageIO, for any other ImageIO or codec the
+   * ImageIO writes the file itself.
+   */
+  class MITKCORE_EXPORT NrrdCompression
+  {
+  public:
+    enum class Codec
+    {
+      /** Single-threaded gzip compression of the ImageIO.*/
+      Default,
+      /** Uncompressed ("encoding: raw").*/
+      None,
+      /** Block-parallel deflate.*/
+      Parallel,
+      /** Block-parallel deflate restricted to run-length matches (zlib's Z_RLE strategy). Considerably
+      faster than Parallel for label images, which mostly consist of long runs of equal pixels.*/
+      ParallelRunLength
+    };
+
+    /** Speed/size trade-off of the parallel codecs.*/
+    enum class Level
+    {
+      Fast,
+      Balanced,
+      Small
+    };
+
+    /** Names of the writer options, see CreateWriterOptions().*/
+    static std::string OPTION_CODEC();
+    static std::string OPTION_LEVEL();
+
+    static std::string GetCodecName(Codec codec);
+    static std::string GetLevelName(Level level);
+
+    /** Writer options to choose the codec and level. The passed defaults are the first choices.*/
+    static IFileWriter::Options CreateWriterOptions(Codec defaultCodec, Level defaultLevel = Level::Balanced);
+
+    /** Extracts codec and level from writer options created by CreateWriterOptions(). Missing or
+    unknown values are left untouched.*/
+    static void GetWriterOptions(const IFileWriter::Options& options, Codec& codec, Level& level);
+
+    /** Writes the image with the prepared imageIO to the file name of the imageIO.
+    \param buffer Complete pixel data as described by the image information of the imageIO.
+    \throw mitk::Exception or itk::ExceptionObject if the file cannot be written.*/
+    static void Write(itk::ImageIOBase* imageIO, const void* buffer, Codec codec, Level level);
+
+    /** Inflates the pixel data of an NRRD file that was written with a parallel codec.
+    \return false if the file was not written with a parallel codec or does not hold exactly size
+    bytes of pixel data in native byte order. The content of buffer is undefined in that case.*/
+    static bool Read(const std::string& path, void* buffer, std::size_t size);
+
+    /** Compresses data to a single gzip member with a block table, see class description.
+    \param level zlib compression level (1-9)*/
+    static std::vector<char> Compress(const void* data, std::size_t size, int level, bool runLength);
+
+    /** Inflates a gzip member created by Compress().
+    \return false if the member has no block table or does not hold exactly size bytes.*/
+    static bool Decompress(const char* member, std::size_t memberSize, void* buffer, std::size_t size);
+  };
+}
+
+#endif
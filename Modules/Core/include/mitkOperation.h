@@ -35,6 +35,10 @@ namespace mitk
      could be conducted. Default implementation returns always true.*/
     virtual bool IsValid() const;
 
+    /** Returns the number of bytes of data held by the operation (e.g. image content stored for undo).
+     Undo models use it to limit the memory occupied by their stacks. Default implementation returns 0.*/
+    virtual std::size_t GetMemorySize() const;
+
     virtual ~Operation() = default;
     OperationType GetOperationType();
 
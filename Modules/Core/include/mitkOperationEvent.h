@@ -83,6 +83,11 @@ namespace mitk
     //## are still valid. Returns falso if one of the conditions is not true.
     virtual bool IsValid() const = 0;
 
+    //##Documentation
+    //## @brief Returns the number of bytes of data held by this item (e.g. by its operations).
+    //## Default implementation returns 0.
+    virtual std::size_t GetMemorySize() const;
+
     //##Documentation
     //## @brief Increases the current ObjectEventId
     //## For example if a button click generates operations the ObjectEventId has to be incremented to be able to undo
@@ -179,6 +184,9 @@ namespace mitk
     //## are still valid. Returns false if one of the conditions is not true.
     bool IsValid() const override;
 
+    //## @brief returns the summed memory size of the operation and the undo operation
+    std::size_t GetMemorySize() const override;
+
   protected:
     void OnObjectDeleted();
 
@@ -0,0 +1,136 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#ifndef mitkPagedMemory_h
+#define mitkPagedMemory_h
+
+#include <MitkCoreExports.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+namespace mitk
+{
+  class PagedMemoryManager;
+
+  /**
+   * \brief Memory block whose content can be evicted from physical memory.
+   *
+   * The block reserves its address range for its whole lifetime, so pointers into the block (e.g.
+   * of slice items or vtkImageData objects that reference a volume) stay valid. Evicting the block
+   * saves the content to a spill file (unless an unmodified copy is available in the spill file or
+   * in the source file, see SetSource()) and replaces the pages with untouched zero pages, which do
+   * not occupy physical memory. Pin() and Touch() restore the content transparently.
+   *
+   * Blocks are evicted by the PagedMemoryManager in least recently used order as soon as the resident
+   * blocks exceed the memory budget. Pinned blocks are never evicted. Memory that is accessed
+   * without pinning is valid until the block is evicted again. This includes the vtkImageData of image
+   * items, which references the block without pinning it: Image::GetVtkImageData() restores the
+   * content, and consumers that read the vtkImageData over a longer period (e.g. ExtractSliceFilter)
+   * pin the block meanwhile. The most recently used block is only evicted by
+   * PagedMemoryManager::EvictAll().
+   *
+   * A newly constructed block is resident. It has to be pinned while it is filled.
+   *
+   * \sa Image::SetPagedVolume()
+   */
+  class MITKCORE_EXPORT PagedMemory
+  {
+  public:
+    /** \throw mitk::Exception if the memory cannot be reserved.*/
+    explicit PagedMemory(std::size_t size);
+    ~PagedMemory();
+
+    PagedMemory(const PagedMemory&) = delete;
+    PagedMemory& operator=(const PagedMemory&) = delete;
+
+    void* GetData() const;
+    std::size_t GetSize() const;
+
+    /** \brief Declares that the content of the block equals GetSize() bytes of a file, starting at offset.
+     * The block is evicted immediately and the content is read from the file when it is needed for
+     * the first time. The file must not be modified while the block exists.
+     */
+    void SetSource(const std::string& path, std::size_t offset);
+
+    /** \brief Restores the content if necessary and prevents its eviction until Unpin() is called.
+     * \throw mitk::Exception if the content cannot be restored.
+     */
+    void Pin();
+    void Unpin();
+
+    /** \brief Restores the content if necessary and marks the block as most recently used.
+     * \throw mitk::Exception if the content cannot be restored.
+     */
+    void Touch();
+
+    bool IsResident() const;
+    bool IsPinned() const;
+
+  private:
+    friend class PagedMemoryManager;
+
+    /** Reads the content from the backup. Called by the manager while the block is in transition.*/
+    void Restore();
+
+    /** Saves the content if necessary and releases the pages. Called by the manager while the block is in transition.
+     * \return True if the content was written to the spill file.*/
+    bool Evict(const std::string& spillDirectory);
+
+    void ReleasePages();
+
+    std::uint64_t ComputeHash() const;
+
+    /** The manager is not accessed via PagedMemoryManager::GetInstance() on destruction, which may happen
+     * during static destruction.*/
+    std::shared_ptr<PagedMemoryManager> m_Manager;
+
+    void* m_Data;
+    std::size_t m_Size;
+
+    bool m_IsResident;
+    /** The content is restored or evicted by a thread that does not hold the lock of the manager.*/
+    bool m_IsInTransition;
+    unsigned int m_PinCount;
+
+    /** File that contains a copy of the content, either the source file or the spill file.*/
+    std::string m_BackupPath;
+    std::size_t m_BackupOffset;
+    /** Hash of the content at the time it was saved to or restored from the backup.
+     * Used to detect modifications, so that unmodified content is not written again.*/
+    std::uint64_t m_BackupHash;
+    std::string m_SpillPath;
+  };
+
+  /**
+   * \brief Pins a PagedMemory block for the lifetime of the object.
+   *
+   * A null block is ignored, so that the pin can be used for data that may or may not be paged.
+   */
+  class MITKCORE_EXPORT PagedMemoryPin
+  {
+  public:
+    /** \throw mitk::Exception if the content cannot be restored.*/
+    explicit PagedMemoryPin(std::shared_ptr<PagedMemory> memory);
+    ~PagedMemoryPin();
+
+    PagedMemoryPin(const PagedMemoryPin&) = delete;
+    PagedMemoryPin& operator=(const PagedMemoryPin&) = delete;
+
+  private:
+    std::shared_ptr<PagedMemory> m_Memory;
+  };
+}
+
+#endif
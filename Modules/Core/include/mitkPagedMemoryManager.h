@@ -0,0 +1,120 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#ifndef mitkPagedMemoryManager_h
+#define mitkPagedMemoryManager_h
+
+#include <MitkCoreExports.h>
+
+#include <cstddef>
+#include <condition_variable>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+
+namespace mitk
+{
+  class PagedMemory;
+
+  /**
+   * \brief Keeps the resident PagedMemory blocks of the process under a global memory budget.
+   *
+   * Whenever a block is used and the resident blocks exceed the budget, the least recently used
+   * blocks that are not pinned are evicted. The default budget is half of the physical memory.
+   *
+   * Content that is neither available in a spill file nor in a source file is written to a spill
+   * file in the spill directory on eviction. The default spill directory is IOUtil::GetTempPath().
+   *
+   * The bookkeeping of all blocks is serialized by a single lock. The content of a block is read
+   * and written without holding the lock, while the block is marked as being in transition. Other
+   * threads that use the same block wait until the transition is finished, all other blocks can be
+   * used concurrently.
+   */
+  class MITKCORE_EXPORT PagedMemoryManager
+  {
+  public:
+    struct MITKCORE_EXPORT Statistics
+    {
+      /** Number of times the content of an evicted block was restored.*/
+      std::size_t numberOfFaults = 0;
+      std::size_t numberOfEvictions = 0;
+      /** Number of evictions that wrote the content to a spill file.*/
+      std::size_t numberOfSpills = 0;
+    };
+
+    static PagedMemoryManager& GetInstance();
+
+    void SetMemoryBudget(std::size_t budget);
+    std::size_t GetMemoryBudget() const;
+
+    /** Sum of the sizes of all resident blocks that were used at least once.*/
+    std::size_t GetResidentSize() const;
+
+    void SetSpillDirectory(const std::string& spillDirectory);
+    std::string GetSpillDirectory() const;
+
+    Statistics GetStatistics() const;
+    void ResetStatistics();
+
+    /** Evicts all blocks that are not pinned, regardless of the budget.*/
+    void EvictAll();
+
+    PagedMemoryManager(const PagedMemoryManager&) = delete;
+    PagedMemoryManager& operator=(const PagedMemoryManager&) = delete;
+
+  private:
+    friend class PagedMemory;
+
+    PagedMemoryManager();
+
+    /** Blocks keep the manager alive, so that blocks that are destroyed during static destruction
+     * (e.g. of static images) do not access a destroyed manager.*/
+    static std::shared_ptr<PagedMemoryManager> GetSharedInstance();
+
+    void Use(PagedMemory* memory, bool pin);
+    void Unpin(PagedMemory* memory);
+    void SetSource(PagedMemory* memory, const std::string& path, std::size_t offset);
+    void Unregister(PagedMemory* memory);
+    bool IsResident(const PagedMemory* memory) const;
+    bool IsPinned(const PagedMemory* memory) const;
+
+    void WaitForTransition(const PagedMemory* memory, std::unique_lock<std::mutex>& lock);
+    void Remove(PagedMemory* memory);
+
+    /** Releases the lock while the content is saved. The block must not be accessed by the caller afterwards,
+     * as it may have been destroyed in the meantime.*/
+    bool Evict(PagedMemory* memory, std::unique_lock<std::mutex>& lock);
+
+    /** Least recently used block that is neither pinned nor excluded.*/
+    PagedMemory* FindEvictionCandidate(const std::unordered_set<PagedMemory*>& excluded, bool includeMostRecentlyUsed) const;
+
+    void EnforceBudget(std::unique_lock<std::mutex>& lock);
+
+    mutable std::mutex m_Mutex;
+    /** Signaled whenever a block finished its transition.*/
+    std::condition_variable m_StateChanged;
+
+    /** Resident blocks, most recently used first.*/
+    std::list<PagedMemory*> m_LeastRecentlyUsed;
+    std::unordered_map<PagedMemory*, std::list<PagedMemory*>::iterator> m_Positions;
+
+    std::size_t m_MemoryBudget;
+    std::size_t m_ResidentSize;
+    std::string m_SpillDirectory;
+    Statistics m_Statistics;
+  };
+}
+
+#endif
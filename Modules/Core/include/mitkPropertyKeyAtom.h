@@ -0,0 +1,78 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#ifndef mitkPropertyKeyAtom_h
+#define mitkPropertyKeyAtom_h
+
+#include <string>
+
+#include <MitkCoreExports.h>
+
+namespace mitk
+{
+  /** @brief Interned property key.
+   *
+   * The key string is resolved once into a small integer id, which is shared by all atoms
+   * of the same key for the lifetime of the process. Property lookups by atom (see
+   * PropertyList::GetProperty(const PropertyKeyAtom&) and DataNode) therefore neither hash
+   * nor compare strings nor allocate memory.
+   *
+   * Creating an atom locks a global registry, so atoms are meant to be created once and
+   * reused, e.g. as static or member variables:
+   *
+   * \code
+   * static const mitk::PropertyKeyAtom shadingKey("material.shading");
+   * node->GetPropertyList()->GetProperty(shadingKey);
+   * \endcode
+   *
+   * Atoms of frequently used rendering properties are provided by Visible(), Opacity(),
+   * Color(), and Layer().
+   */
+  class MITKCORE_EXPORT PropertyKeyAtom final
+  {
+  public:
+    using IdType = unsigned int;
+
+    /** @brief Intern the given key.
+     *
+     * @throw mitk::Exception if the key is empty.
+     */
+    explicit PropertyKeyAtom(const std::string &key);
+
+    IdType GetId() const { return m_Id; }
+
+    /** @brief The interned key string, which stays valid for the lifetime of the process.
+     */
+    const std::string &GetKey() const;
+
+    bool operator==(const PropertyKeyAtom &other) const { return m_Id == other.m_Id; }
+    bool operator!=(const PropertyKeyAtom &other) const { return m_Id != other.m_Id; }
+    bool operator<(const PropertyKeyAtom &other) const { return m_Id < other.m_Id; }
+
+    /** @brief Atom of the "visible" property. */
+    static const PropertyKeyAtom &Visible();
+
+    /** @brief Atom of the "opacity" property. */
+    static const PropertyKeyAtom &Opacity();
+
+    /** @brief Atom of the "color" property. */
+    static const PropertyKeyAtom &Color();
+
+    /** @brief Atom of the "layer" property. */
+    static const PropertyKeyAtom &Layer();
+
+  private:
+    IdType m_Id;
+  };
+}
+
+#endif
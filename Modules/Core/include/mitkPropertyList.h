@@ -15,11 +15,33 @@ found in the LICENSE file.
 
 #include <mitkIPropertyOwner.h>
 #include <mitkGenericProperty.h>
+#include <mitkPropertyKeyAtom.h>
+
+#include <typeinfo>
+#include <utility>
+#include <vector>
 
 #include <nlohmann/json_fwd.hpp>
 
 namespace mitk
 {
+  /**
+   * @brief Cast a property to TPropertyType, avoiding a dynamic_cast if the types match exactly.
+   *
+   * @return nullptr if the property is nullptr or not of type TPropertyType
+   */
+  template <class TPropertyType>
+  TPropertyType *PropertyCast(BaseProperty *property)
+  {
+    if (nullptr == property)
+      return nullptr;
+
+    if (typeid(*property) == typeid(TPropertyType))
+      return static_cast<TPropertyType *>(property);
+
+    return dynamic_cast<TPropertyType *>(property);
+  }
+
   /**
    * @brief Key-value list holding instances of BaseProperty
    *
@@ -51,6 +73,10 @@ namespace mitk
    * Please also regard, that the key of a property must be a none empty string.
    * This is a precondition. Setting properties with empty keys will raise an exception.
    *
+   * Besides the map, the list maintains an index sorted by PropertyKeyAtom ids, so that
+   * properties can be looked up by interned keys without string comparisons. Use the
+   * methods taking a PropertyKeyAtom in performance critical code like mappers.
+   *
    * @ingroup DataManagement
    */
   class MITKCORE_EXPORT PropertyList : public itk::Object, public IPropertyOwner
@@ -86,6 +112,24 @@ namespace mitk
      */
     mitk::BaseProperty *GetProperty(const std::string &propertyKey) const;
 
+    /**
+     * @brief Get a property by its interned name.
+     *
+     * Neither compares strings nor allocates memory.
+     */
+    mitk::BaseProperty *GetProperty(const PropertyKeyAtom &propertyKey) const;
+
+    /**
+     * @brief Get a property by its interned name if it is of type TPropertyType.
+     *
+     * @sa PropertyCast
+     */
+    template <class TPropertyType>
+    TPropertyType *GetPropertyAs(const PropertyKeyAtom &propertyKey) const
+    {
+      return PropertyCast<TPropertyType>(this->GetProperty(propertyKey));
+    }
+
     /**
      * @brief Set a property object in the list/map by reference.
      *
@@ -121,6 +165,11 @@ namespace mitk
     * @brief Convenience method to access the value of a BoolProperty
     */
     bool GetBoolProperty(const char *propertyKey, bool &boolValue) const;
+    /**
+    * @brief Convenience method to access the value of a BoolProperty by its interned name
+    */
+    bool GetBoolProperty(const PropertyKeyAtom &propertyKey, bool &boolValue) const;
+
     /**
     * @brief ShortCut for the above method
     */
@@ -139,6 +188,11 @@ namespace mitk
     * @brief Convenience method to access the value of an IntProperty
     */
     bool GetIntProperty(const char *propertyKey, int &intValue) const;
+    /**
+    * @brief Convenience method to access the value of an IntProperty by its interned name
+    */
+    bool GetIntProperty(const PropertyKeyAtom &propertyKey, int &intValue) const;
+
     /**
     * @brief ShortCut for the above method
     */
@@ -157,6 +211,11 @@ namespace mitk
     * @brief Convenience method to access the value of a FloatProperty
     */
     bool GetFloatProperty(const char *propertyKey, float &floatValue) const;
+    /**
+    * @brief Convenience method to access the value of a FloatProperty by its interned name
+    */
+    bool GetFloatProperty(const PropertyKeyAtom &propertyKey, float &floatValue) const;
+
     /**
     * @brief ShortCut for the above method
     */
@@ -256,11 +315,24 @@ namespace mitk
 
     /**
      * @brief Map of properties.
+     *
+     * Must not be modified directly, as it is mirrored by m_PropertyIndex.
      */
     PropertyMap m_Properties;
 
   private:
+    using PropertyIndexType = std::vector<std::pair<PropertyKeyAtom::IdType, BaseProperty *>>;
+
     itk::LightObject::Pointer InternalClone() const override;
+
+    void UpdatePropertyIndex(const std::string &propertyKey, BaseProperty *property);
+    void RemoveFromPropertyIndex(const std::string &propertyKey);
+    void RebuildPropertyIndex();
+
+    /**
+     * @brief Properties of m_Properties sorted by the ids of their interned keys.
+     */
+    PropertyIndexType m_PropertyIndex;
   };
 
 } // namespace mitk
@@ -25,6 +25,9 @@ found in the LICENSE file.
 #include <mitkTimeGeometry.h>
 #include <mitkAntiAliasing.h>
 
+#include <mutex>
+#include <set>
+
 class vtkRenderWindow;
 class vtkObject;
 
@@ -122,6 +125,13 @@ namespace mitk
    * soon as the main loop is ready for rendering. */
     void RequestUpdate(vtkRenderWindow *renderWindow);
 
+    /** Requests an update for the specified RenderWindow from a thread other than
+   * the rendering thread (e.g. a worker thread producing slices in the background).
+   * The request is passed to RequestUpdate() with the next ExecutePendingRequests(),
+   * so GenerateRenderingRequestEvent() of the concrete rendering manager has to be
+   * thread-safe. */
+    void RequestUpdateFromWorkerThread(vtkRenderWindow *renderWindow);
+
     /** Immediately executes an update of the specified RenderWindow. */
     void ForceImmediateUpdate(vtkRenderWindow *renderWindow);
 
@@ -431,6 +441,9 @@ namespace mitk
 
     bool m_ConstrainedPanningZooming;
 
+    std::mutex m_WorkerThreadRequestsMutex;
+    std::set<vtkRenderWindow *> m_WorkerThreadRequests;
+
   private:
 
     /**
@@ -13,6 +13,9 @@ found in the LICENSE file.
 #include "mitkExtractSliceFilter.h"
 
 #include <mitkAbstractTransformGeometry.h>
+#include <mitkImageReadAccessor.h>
+#include <mitkImageTimeSelector.h>
+#include <mitkPagedMemory.h>
 #include <mitkPlaneClipping.h>
 
 #include <vtkGeneralTransform.h>
@@ -21,6 +24,8 @@ found in the LICENSE file.
 #include <vtkImageExtractComponents.h>
 #include <vtkLinearTransform.h>
 
+#include <cstring>
+
 mitk::ExtractSliceFilter::ExtractSliceFilter(vtkImageReslice *reslicer): m_XMin(0), m_XMax(0), m_YMin(0), m_YMax(0)
 {
   if (reslicer == nullptr)
@@ -45,6 +50,8 @@ mitk::ExtractSliceFilter::ExtractSliceFilter(vtkImageReslice *reslicer): m_XMin(
   m_VtkOutputRequested = false;
   m_BackgroundLevel = -32768.0;
   m_Component = 0;
+  m_UseExtractSliceFilter2 = false;
+  m_ExtractSliceFilter2OutputValid = false;
 }
 
 mitk::ExtractSliceFilter::~ExtractSliceFilter()
@@ -269,6 +276,12 @@ void mitk::ExtractSliceFilter::GenerateData()
     return;
   }
 
+  // The vtkImageData of a paged volume does not pin it, so the volume is kept resident while it is resliced
+  auto volume = input->GetVolumeData(m_TimeStep);
+  PagedMemoryPin pagedMemoryPin(volume.IsNotNull() ? volume->GetPagedMemory() : nullptr);
+
+  m_ExtractSliceFilter2OutputValid = false;
+
   /*================#BEGIN setup vtkImageReslice properties================*/
   Point3D origin;
   Vector3D normal;
@@ -416,6 +429,13 @@ void mitk::ExtractSliceFilter::GenerateData()
 
   m_Reslicer->SetOutputSpacing(m_OutPutSpacing[0], m_OutPutSpacing[1], m_ZSpacing);
 
+  // The reslice axes are set up above in any case, because they are also queried by the mappers.
+  if (m_UseExtractSliceFilter2 && m_VtkOutputRequested && 2 == m_OutputDimension && nullptr == abstractGeometry &&
+      m_ResliceTransform.IsNotNull() && this->GenerateDataWithExtractSliceFilter2(origin))
+  {
+    return;
+  }
+
   // TODO check the following lines, they are responsible whether vtk error outputs appear or not
   m_Reslicer->UpdateWholeExtent(); // this produces a bad allocation error for 2D images
   // m_Reslicer->GetOutput()->UpdateInformation();
@@ -502,3 +522,79 @@ bool mitk::ExtractSliceFilter::GetClippedPlaneBounds(const BaseGeometry *boundin
 
   return b;
 }
+
+bool mitk::ExtractSliceFilter::GenerateDataWithExtractSliceFilter2(const Point3D &origin)
+{
+  const Image *input = this->GetInput();
+
+  if (1 != input->GetPixelType().GetNumberOfComponents() || input->GetDimension() < 3 || input->GetDimension() > 4)
+    return false;
+
+  // 4D images are resliced via a view of the volume of the current time step
+  Image::ConstPointer volume = SelectImageByTimeStep(input, m_TimeStep);
+
+  if (volume.IsNull() || 3 != volume->GetDimension())
+    return false;
+
+  const int width = std::max(m_XMax - m_XMin, 1);
+  const int height = std::max(m_YMax - m_YMin, 1);
+
+  // the sampling grid of vtkImageReslice: pixel (x, y) of the output extent is located at
+  // origin + x * right * spacing[0] + y * bottom * spacing[1]
+  Vector3D spacing;
+  spacing[0] = m_OutPutSpacing[0];
+  spacing[1] = m_OutPutSpacing[1];
+  spacing[2] = 1.0;
+
+  auto outputGeometry = PlaneGeometry::New();
+  outputGeometry->InitializeStandardPlane(width, height, m_Right, m_Bottom, &spacing);
+  outputGeometry->SetOrigin(origin + m_Right * (m_XMin * m_OutPutSpacing[0]) + m_Bottom * (m_YMin * m_OutPutSpacing[1]));
+  outputGeometry->ImageGeometryOn();
+
+  if (m_ExtractSliceFilter2.IsNull())
+    m_ExtractSliceFilter2 = ExtractSliceFilter2::New();
+
+  switch (m_InterpolationMode)
+  {
+    case RESLICE_LINEAR:
+      m_ExtractSliceFilter2->SetInterpolator(ExtractSliceFilter2::Linear);
+      break;
+    case RESLICE_CUBIC:
+      m_ExtractSliceFilter2->SetInterpolator(ExtractSliceFilter2::Cubic);
+      break;
+    default:
+      m_ExtractSliceFilter2->SetInterpolator(ExtractSliceFilter2::NearestNeighbor);
+  }
+
+  try
+  {
+    m_ExtractSliceFilter2->SetInput(volume);
+    m_ExtractSliceFilter2->SetOutputGeometry(outputGeometry);
+    m_ExtractSliceFilter2->Update();
+  }
+  catch (const mitk::Exception &e)
+  {
+    // e.g. pixel types that are not supported by the AccessByItk macros
+    MITK_DEBUG << "Falling back to vtkImageReslice: " << e.GetDescription();
+    return false;
+  }
+
+  auto slice = m_ExtractSliceFilter2->GetOutput();
+
+  if (m_ExtractSliceFilter2Output == nullptr)
+    m_ExtractSliceFilter2Output = vtkSmartPointer<vtkImageData>::New();
+
+  m_ExtractSliceFilter2Output->SetExtent(m_XMin, m_XMin + width - 1, m_YMin, m_YMin + height - 1, m_ZMin, m_ZMax);
+  m_ExtractSliceFilter2Output->SetSpacing(m_OutPutSpacing[0], m_OutPutSpacing[1], m_ZSpacing);
+  m_ExtractSliceFilter2Output->SetOrigin(0.0, 0.0, 0.0);
+  m_ExtractSliceFilter2Output->AllocateScalars(input->GetVtkImageData(m_TimeStep)->GetScalarType(), 1);
+
+  ImageReadAccessor sliceAccessor(slice);
+  std::memcpy(m_ExtractSliceFilter2Output->GetScalarPointer(), sliceAccessor.GetData(),
+    static_cast<std::size_t>(width) * height * input->GetPixelType().GetSize());
+
+  m_ExtractSliceFilter2Output->Modified();
+  m_ExtractSliceFilter2OutputValid = true;
+
+  return true;
+}
@@ -17,8 +17,13 @@ found in the LICENSE file.
 
 #include <itkBSplineInterpolateImageFunction.h>
 #include <itkLinearInterpolateImageFunction.h>
+#include <itkMultiThreaderBase.h>
 #include <itkNearestNeighborInterpolateImageFunction.h>
+#include <itkWeakPointer.h>
 
+#include <algorithm>
+#include <array>
+#include <cmath>
 #include <limits>
 
 struct mitk::ExtractSliceFilter2::Impl
@@ -29,10 +34,13 @@ struct mitk::ExtractSliceFilter2::Impl
   PlaneGeometry::Pointer OutputGeometry;
   mitk::ExtractSliceFilter2::Interpolator Interpolator;
   itk::Object::Pointer InterpolateImageFunction;
+  itk::WeakPointer<const mitk::Image> InterpolateImageFunctionInput;
+  itk::ModifiedTimeType InterpolateImageFunctionMTime;
 };
 
 mitk::ExtractSliceFilter2::Impl::Impl()
-  : Interpolator(NearestNeighbor)
+  : Interpolator(NearestNeighbor),
+    InterpolateImageFunctionMTime(0)
 {
 }
 
@@ -42,6 +50,11 @@ mitk::ExtractSliceFilter2::Impl::~Impl()
 
 namespace
 {
+  /** Edge length of the square output tiles that are processed in parallel.*/
+  constexpr std::size_t TILE_SIZE = 64;
+
+  using ContinuousIndexType = std::array<double, 3>;
+
   template <class TInputImage>
   void CreateInterpolateImageFunction(const TInputImage* inputImage, mitk::ExtractSliceFilter2::Interpolator interpolator, itk::Object::Pointer& result)
   {
@@ -74,14 +87,145 @@ namespace
     result = interpolateImageFunction.GetPointer();
   }
 
+  /** Buffer of the input image and the mapping of output pixels to continuous indices of the input image.
+   * As the mapping is affine, the continuous index of an output pixel (x, y) is origin + x * xStep + y * yStep.*/
+  template <typename TPixel>
+  struct SamplingGrid
+  {
+    const TPixel* buffer;
+    std::array<long, 3> size;
+    std::array<std::size_t, 3> strides;
+    ContinuousIndexType origin;
+    ContinuousIndexType xStep;
+    ContinuousIndexType yStep;
+  };
+
+  /** Same test as itk::ImageRegion::IsInside() for continuous indices.*/
+  template <typename TPixel>
+  bool IsInside(const SamplingGrid<TPixel>& grid, const ContinuousIndexType& rowStart, std::size_t x)
+  {
+    for (int d = 0; d < 3; ++d)
+    {
+      const double index = rowStart[d] + grid.xStep[d] * x;
+      if (!(index >= -0.5 && index < grid.size[d] - 0.5))
+        return false;
+    }
+
+    return true;
+  }
+
+  /** Determines the range [begin, end) of a row segment that is located inside the input image.
+   * Since the input image is convex, the pixels inside form one contiguous range. This allows
+   * the sampling kernels to run without any bounds checks.*/
+  template <typename TPixel>
+  void ClipRow(const SamplingGrid<TPixel>& grid, const ContinuousIndexType& rowStart, std::size_t xBegin, std::size_t xEnd, std::size_t& begin, std::size_t& end)
+  {
+    double lower = static_cast<double>(xBegin);
+    double upper = static_cast<double>(xEnd);
+
+    for (int d = 0; d < 3 && lower < upper; ++d)
+    {
+      const double minIndex = -0.5;
+      const double maxIndex = grid.size[d] - 0.5;
+
+      if (0.0 == grid.xStep[d])
+      {
+        if (!(rowStart[d] >= minIndex && rowStart[d] < maxIndex))
+          upper = lower;
+      }
+      else
+      {
+        double t0 = (minIndex - rowStart[d]) / grid.xStep[d];
+        double t1 = (maxIndex - rowStart[d]) / grid.xStep[d];
+        if (t0 > t1)
+          std::swap(t0, t1);
+
+        lower = std::max(lower, std::ceil(t0));
+        upper = std::min(upper, std::ceil(t1));
+      }
+    }
+
+    if (!(lower < upper))
+    {
+      begin = end = xBegin;
+      return;
+    }
+
+    begin = static_cast<std::size_t>(lower);
+    end = static_cast<std::size_t>(upper);
+
+    // The analytic bounds may be off by one due to rounding; correct them with the exact test.
+    while (begin < end && !IsInside(grid, rowStart, begin))
+      ++begin;
+    while (begin > xBegin && IsInside(grid, rowStart, begin - 1))
+      --begin;
+    while (end > begin && !IsInside(grid, rowStart, end - 1))
+      --end;
+    while (end < xEnd && end > begin && IsInside(grid, rowStart, end))
+      ++end;
+  }
+
+  template <typename TPixel>
+  void SampleRowNearestNeighbor(const SamplingGrid<TPixel>& grid, const ContinuousIndexType& rowStart, std::size_t begin, std::size_t end, TPixel* output)
+  {
+    const auto* buffer = grid.buffer;
+    const auto strides = grid.strides;
+
+    for (auto x = begin; x < end; ++x)
+    {
+      // rounding half integers up like itk::NearestNeighborInterpolateImageFunction
+      const auto i = static_cast<std::size_t>(std::floor(rowStart[0] + grid.xStep[0] * x + 0.5));
+      const auto j = static_cast<std::size_t>(std::floor(rowStart[1] + grid.xStep[1] * x + 0.5));
+      const auto k = static_cast<std::size_t>(std::floor(rowStart[2] + grid.xStep[2] * x + 0.5));
+
+      output[x] = buffer[i * strides[0] + j * strides[1] + k * strides[2]];
+    }
+  }
+
+  template <typename TPixel>
+  void SampleRowLinear(const SamplingGrid<TPixel>& grid, const ContinuousIndexType& rowStart, std::size_t begin, std::size_t end, TPixel* output)
+  {
+    const auto* buffer = grid.buffer;
+    const auto strides = grid.strides;
+    const auto size = grid.size;
+
+    for (auto x = begin; x < end; ++x)
+    {
+      std::array<std::size_t, 3> lowerOffset;
+      std::array<std::size_t, 3> upperOffset;
+      std::array<double, 3> weight;
+
+      for (int d = 0; d < 3; ++d)
+      {
+        // border handling like itk::LinearInterpolateImageFunction
+        const double index = rowStart[d] + grid.xStep[d] * x;
+        const long base = std::max(static_cast<long>(std::floor(index)), 0L);
+        const long next = std::min(base + 1, size[d] - 1);
+
+        weight[d] = std::max(index - base, 0.0);
+        lowerOffset[d] = base * strides[d];
+        upperOffset[d] = next * strides[d];
+      }
+
+      const double v00 = buffer[lowerOffset[0] + lowerOffset[1] + lowerOffset[2]] * (1.0 - weight[0]) + buffer[upperOffset[0] + lowerOffset[1] + lowerOffset[2]] * weight[0];
+      const double v10 = buffer[lowerOffset[0] + upperOffset[1] + lowerOffset[2]] * (1.0 - weight[0]) + buffer[upperOffset[0] + upperOffset[1] + lowerOffset[2]] * weight[0];
+      const double v01 = buffer[lowerOffset[0] + lowerOffset[1] + upperOffset[2]] * (1.0 - weight[0]) + buffer[upperOffset[0] + lowerOffset[1] + upperOffset[2]] * weight[0];
+      const double v11 = buffer[lowerOffset[0] + upperOffset[1] + upperOffset[2]] * (1.0 - weight[0]) + buffer[upperOffset[0] + upperOffset[1] + upperOffset[2]] * weight[0];
+
+      const double v0 = v00 * (1.0 - weight[1]) + v10 * weight[1];
+      const double v1 = v01 * (1.0 - weight[1]) + v11 * weight[1];
+
+      output[x] = static_cast<TPixel>(v0 * (1.0 - weight[2]) + v1 * weight[2]);
+    }
+  }
+
   template <typename TPixel, unsigned int VImageDimension>
-  void GenerateData(const itk::Image<TPixel, VImageDimension>* inputImage, mitk::Image* outputImage, const mitk::ExtractSliceFilter2::OutputImageRegionType& outputRegion, itk::Object* interpolateImageFunction)
+  void GenerateData(const itk::Image<TPixel, VImageDimension>* inputImage, mitk::Image* outputImage, mitk::ExtractSliceFilter2::Interpolator interpolator, itk::Object* interpolateImageFunction)
   {
     typedef itk::Image<TPixel, VImageDimension> TInputImage;
     typedef itk::InterpolateImageFunction<TInputImage> TInterpolateImageFunction;
 
     auto outputGeometry = outputImage->GetSlicedGeometry()->GetPlaneGeometry(0);
-    auto interpolator = static_cast<TInterpolateImageFunction*>(interpolateImageFunction);
 
     auto origin = outputGeometry->GetOrigin();
     auto spacing = outputGeometry->GetSpacing();
@@ -94,42 +238,87 @@ namespace
     auto spacingAlongXDirection = xDirection * spacing[0];
     auto spacingAlongYDirection = yDirection * spacing[1];
 
-    const std::size_t pixelSize = outputImage->GetPixelType().GetSize();
+    // The mapping from output pixels to continuous input indices is affine, so it is determined once
+    // instead of transforming every output pixel individually.
+    const auto originIndex = inputImage->template TransformPhysicalPointToContinuousIndex<mitk::ScalarType>(origin);
+    const auto xIndex = inputImage->template TransformPhysicalPointToContinuousIndex<mitk::ScalarType>(origin + spacingAlongXDirection);
+    const auto yIndex = inputImage->template TransformPhysicalPointToContinuousIndex<mitk::ScalarType>(origin + spacingAlongYDirection);
+
+    const auto& region = inputImage->GetBufferedRegion();
+
+    SamplingGrid<TPixel> grid;
+    grid.buffer = inputImage->GetBufferPointer();
+
+    for (int d = 0; d < 3; ++d)
+    {
+      grid.size[d] = static_cast<long>(region.GetSize(d));
+      grid.origin[d] = originIndex[d] - region.GetIndex(d);
+      grid.xStep[d] = xIndex[d] - originIndex[d];
+      grid.yStep[d] = yIndex[d] - originIndex[d];
+    }
+
+    grid.strides[0] = 1;
+    grid.strides[1] = region.GetSize(0);
+    grid.strides[2] = region.GetSize(0) * region.GetSize(1);
+
     const std::size_t width = outputGeometry->GetExtent(0);
-    const std::size_t xBegin = outputRegion.GetIndex(0);
-    const std::size_t yBegin = outputRegion.GetIndex(1);
-    const std::size_t xEnd = xBegin + outputRegion.GetSize(0);
-    const std::size_t yEnd = yBegin + outputRegion.GetSize(1);
+    const std::size_t height = outputGeometry->GetExtent(1);
 
     mitk::ImageWriteAccessor writeAccess(outputImage, nullptr, mitk::ImageAccessorBase::IgnoreLock);
-    auto data = static_cast<char*>(writeAccess.GetData());
+    auto data = static_cast<TPixel*>(writeAccess.GetData());
 
     const TPixel backgroundPixel = std::numeric_limits<TPixel>::lowest();
-    TPixel pixel;
+    auto function = static_cast<TInterpolateImageFunction*>(interpolateImageFunction);
 
-    itk::ContinuousIndex<mitk::ScalarType, 3> index;
-    mitk::Point3D yPoint;
-    mitk::Point3D point;
+    const std::size_t numberOfTilesX = (width + TILE_SIZE - 1) / TILE_SIZE;
+    const std::size_t numberOfTilesY = (height + TILE_SIZE - 1) / TILE_SIZE;
 
-    for (std::size_t y = yBegin; y < yEnd; ++y)
+    auto multiThreader = itk::MultiThreaderBase::New();
+
+    multiThreader->ParallelizeArray(0, numberOfTilesX * numberOfTilesY, [&](itk::SizeValueType tile)
     {
-      yPoint = origin + spacingAlongYDirection * y;
+      const std::size_t xBegin = (tile % numberOfTilesX) * TILE_SIZE;
+      const std::size_t yBegin = (tile / numberOfTilesX) * TILE_SIZE;
+      const std::size_t xEnd = std::min(xBegin + TILE_SIZE, width);
+      const std::size_t yEnd = std::min(yBegin + TILE_SIZE, height);
+
+      ContinuousIndexType rowStart;
+      itk::ContinuousIndex<mitk::ScalarType, 3> index;
 
-      for (std::size_t x = xBegin; x < xEnd; ++x)
+      for (std::size_t y = yBegin; y < yEnd; ++y)
       {
-        point = yPoint + spacingAlongXDirection * x;
+        for (int d = 0; d < 3; ++d)
+          rowStart[d] = grid.origin[d] + grid.yStep[d] * y;
 
-        if (inputImage->TransformPhysicalPointToContinuousIndex(point, index))
-        {
-          pixel = interpolator->EvaluateAtContinuousIndex(index);
-          memcpy(static_cast<void*>(data + pixelSize * (width * y + x)), static_cast<const void*>(&pixel), pixelSize);
-        }
-        else
+        std::size_t begin, end;
+        ClipRow(grid, rowStart, xBegin, xEnd, begin, end);
+
+        auto* row = data + width * y;
+
+        std::fill(row + xBegin, row + begin, backgroundPixel);
+        std::fill(row + end, row + xEnd, backgroundPixel);
+
+        switch (interpolator)
         {
-          memcpy(static_cast<void*>(data + pixelSize * (width * y + x)), static_cast<const void*>(&backgroundPixel), pixelSize);
+          case mitk::ExtractSliceFilter2::NearestNeighbor:
+            SampleRowNearestNeighbor(grid, rowStart, begin, end, row);
+            break;
+
+          case mitk::ExtractSliceFilter2::Linear:
+            SampleRowLinear(grid, rowStart, begin, end, row);
+            break;
+
+          default:
+            for (auto x = begin; x < end; ++x)
+            {
+              for (int d = 0; d < 3; ++d)
+                index[d] = rowStart[d] + grid.xStep[d] * x + region.GetIndex(d);
+
+              row[x] = static_cast<TPixel>(function->EvaluateAtContinuousIndex(index));
+            }
         }
       }
-    }
+    }, nullptr);
   }
 
   void VerifyInputImage(const mitk::Image* inputImage)
@@ -185,45 +374,39 @@ void mitk::ExtractSliceFilter2::AllocateOutputs()
 
   auto data = new char[static_cast<std::size_t>(pixelType.GetSize() * outputGeometry->GetExtent(0) * outputGeometry->GetExtent(1))];
 
+  // the output image takes ownership of the buffer, so it is not leaked on repeated updates
   try
   {
-    if (!outputImage->SetImportVolume(data, 0, 0, mitk::Image::ReferenceMemory))
-      throw;
+    if (!outputImage->SetImportVolume(data, 0, 0, mitk::Image::ManageMemory))
+      delete[] data;
   }
   catch (...)
   {
     delete[] data;
+    throw;
   }
 }
 
-/*void mitk::ExtractSliceFilter2::BeforeThreadedGenerateData()
-{
-  if (nullptr != m_Impl->InterpolateImageFunction && this->GetInput()->GetMTime() < this->GetMTime())
-    return;
-
-  const auto* inputImage = this->GetInput();
-  AccessFixedDimensionByItk_2(inputImage, CreateInterpolateImageFunction, 3, this->GetInterpolator(), m_Impl->InterpolateImageFunction);
-}
-
-void mitk::ExtractSliceFilter2::ThreadedGenerateData(const OutputImageRegionType& outputRegionForThread, itk::ThreadIdType)
-{
-  const auto* inputImage = this->GetInput();
-  AccessFixedDimensionByItk_3(inputImage, ::GenerateData, 3, this->GetOutput(), outputRegionForThread, m_Impl->InterpolateImageFunction);
-}*/
-
 void mitk::ExtractSliceFilter2::GenerateData()
 {
-  if (nullptr != m_Impl->InterpolateImageFunction && this->GetInput()->GetMTime() < this->GetMTime())
-    return;
-
   const auto* inputImage = this->GetInput();
-
-  AccessFixedDimensionByItk_2(inputImage, CreateInterpolateImageFunction, 3, this->GetInterpolator(), m_Impl->InterpolateImageFunction);
+  const auto interpolator = this->GetInterpolator();
+
+  // Nearest neighbor and linear interpolation are done by specialized kernels. The interpolate image
+  // function is only needed for cubic interpolation and reused as long as the same input was not modified.
+  // Inputs may be replaced through the pipeline without calling SetInput(), so the input is part of the key.
+  if (Cubic == interpolator && (nullptr == m_Impl->InterpolateImageFunction ||
+                                inputImage != m_Impl->InterpolateImageFunctionInput.GetPointer() ||
+                                inputImage->GetMTime() != m_Impl->InterpolateImageFunctionMTime))
+  {
+    AccessFixedDimensionByItk_2(inputImage, CreateInterpolateImageFunction, 3, interpolator, m_Impl->InterpolateImageFunction);
+    m_Impl->InterpolateImageFunctionInput = inputImage;
+    m_Impl->InterpolateImageFunctionMTime = inputImage->GetMTime();
+  }
 
   this->AllocateOutputs();
-  auto outputRegion = this->GetOutput()->GetLargestPossibleRegion();
 
-  AccessFixedDimensionByItk_3(inputImage, ::GenerateData, 3, this->GetOutput(), outputRegion, m_Impl->InterpolateImageFunction);
+  AccessFixedDimensionByItk_3(inputImage, ::GenerateData, 3, this->GetOutput(), interpolator, m_Impl->InterpolateImageFunction.GetPointer());
 }
 
 void mitk::ExtractSliceFilter2::SetInput(const InputImageType* image)
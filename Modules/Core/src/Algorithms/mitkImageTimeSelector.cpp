@@ -68,6 +68,8 @@ void mitk::ImageTimeSelector::GenerateData()
   // do we really need a complete volume at a time?
   if (requestedRegion.GetSize(2) > 1)
   {
+    // The clone references the data of the input volume. If it is paged memory, the clone shares
+    // the block, so accessors of the output restore it after an eviction (see ImageDataItem::GetPagedMemory()).
     mitk::ImageDataItem::Pointer im = this->GetVolumeData(m_TimeNr, m_ChannelNr)->Clone();
     im->SetTimestep(0);
     im->SetManageMemory(false);
@@ -25,7 +25,7 @@ namespace mitk
 }
 
 mitk::LimitedLinearUndo::LimitedLinearUndo()
-: m_UndoLimit(0)
+: m_UndoLimit(0), m_MemoryLimit(0)
 {
   // nothing to do
 }
@@ -67,6 +67,7 @@ bool mitk::LimitedLinearUndo::SetOperationEvent(UndoStackItem *stackItem)
     delete item;
   }
   m_UndoList.push_back(operationEvent);
+  this->EnforceMemoryLimit();
 
   InvokeEvent(UndoNotEmptyEvent());
 
@@ -198,16 +199,68 @@ void mitk::LimitedLinearUndo::SetUndoLimit(std::size_t undoLimit)
 {
   if (undoLimit != m_UndoLimit)
   {
-    if (m_UndoList.size() > undoLimit)
+    m_UndoLimit = undoLimit;
+
+    while (0 != m_UndoLimit && m_UndoList.size() > m_UndoLimit)
     {
-      m_UndoList.erase(m_UndoList.begin(), m_UndoList.end() - undoLimit);
+      auto item = m_UndoList.front();
+      m_UndoList.pop_front();
+      delete item;
     }
-    m_UndoLimit = undoLimit;
 
     InvokeEvent(UndoStackEvent());
   }
 }
 
+std::size_t mitk::LimitedLinearUndo::GetMemoryLimit() const
+{
+  return m_MemoryLimit;
+}
+
+void mitk::LimitedLinearUndo::SetMemoryLimit(std::size_t megaBytes)
+{
+  if (megaBytes != m_MemoryLimit)
+  {
+    m_MemoryLimit = megaBytes;
+    this->EnforceMemoryLimit();
+
+    InvokeEvent(UndoStackEvent());
+  }
+}
+
+std::size_t mitk::LimitedLinearUndo::GetMemorySize() const
+{
+  std::size_t size = 0;
+
+  for (auto item : m_UndoList)
+    size += item->GetMemorySize();
+
+  for (auto item : m_RedoList)
+    size += item->GetMemorySize();
+
+  return size;
+}
+
+void mitk::LimitedLinearUndo::EnforceMemoryLimit()
+{
+  if (0 == m_MemoryLimit || m_UndoList.size() < 2)
+    return;
+
+  const std::size_t memoryLimit = m_MemoryLimit * 1024 * 1024;
+  std::size_t memorySize = 0;
+
+  for (auto item : m_UndoList)
+    memorySize += item->GetMemorySize();
+
+  while (m_UndoList.size() > 1 && memorySize > memoryLimit)
+  {
+    auto item = m_UndoList.front();
+    memorySize -= item->GetMemorySize();
+    m_UndoList.pop_front();
+    delete item;
+  }
+}
+
 int mitk::LimitedLinearUndo::GetLastObjectEventIdInList()
 {
   return m_UndoList.back()->GetObjectEventId();
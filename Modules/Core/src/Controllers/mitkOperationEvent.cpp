@@ -72,6 +72,11 @@ void mitk::UndoStackItem::ReverseAndExecute()
   ReverseOperations();
 }
 
+std::size_t mitk::UndoStackItem::GetMemorySize() const
+{
+  return 0;
+}
+
 // ******************** mitk::OperationEvent ********************
 
 mitk::Operation *mitk::OperationEvent::GetOperation()
@@ -139,3 +144,16 @@ bool mitk::OperationEvent::IsValid() const
     && m_Operation != nullptr && m_Operation->IsValid()
     && m_UndoOperation != nullptr && m_UndoOperation->IsValid();
 }
+
+std::size_t mitk::OperationEvent::GetMemorySize() const
+{
+  std::size_t size = 0;
+
+  if (nullptr != m_Operation)
+    size += m_Operation->GetMemorySize();
+
+  if (nullptr != m_UndoOperation)
+    size += m_UndoOperation->GetMemorySize();
+
+  return size;
+}
@@ -211,6 +211,18 @@ namespace mitk
     }
   }
 
+  void RenderingManager::RequestUpdateFromWorkerThread(vtkRenderWindow *renderWindow)
+  {
+    {
+      std::lock_guard<std::mutex> lock(m_WorkerThreadRequestsMutex);
+
+      if (!m_WorkerThreadRequests.insert(renderWindow).second)
+        return;
+    }
+
+    this->GenerateRenderingRequestEvent();
+  }
+
   void RenderingManager::ForceImmediateUpdate(vtkRenderWindow *renderWindow)
   {
     // If the renderWindow is not valid, we do not want to inadvertently create
@@ -541,6 +553,22 @@ namespace mitk
 
   void RenderingManager::ExecutePendingRequests()
   {
+    std::set<vtkRenderWindow *> workerThreadRequests;
+
+    {
+      std::lock_guard<std::mutex> lock(m_WorkerThreadRequestsMutex);
+      workerThreadRequests.swap(m_WorkerThreadRequests);
+    }
+
+    // Render windows that were removed in the meantime are ignored
+    for (auto renderWindow : workerThreadRequests)
+    {
+      auto it = m_RenderWindowList.find(renderWindow);
+
+      if (it != m_RenderWindowList.end())
+        it->second = RENDERING_REQUESTED;
+    }
+
     m_UpdatePending = false;
 
     // Satisfy all pending update requests
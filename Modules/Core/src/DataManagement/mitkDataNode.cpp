@@ -247,6 +247,29 @@ mitk::BaseProperty *mitk::DataNode::GetProperty(const char *propertyKey, const m
   return property;
 }
 
+mitk::BaseProperty *mitk::DataNode::GetProperty(const PropertyKeyAtom &propertyKey, const mitk::BaseRenderer *renderer, bool fallBackOnDataProperties) const
+{
+  if (nullptr != renderer)
+  {
+    auto it = m_MapOfPropertyLists.find(renderer->GetName());
+
+    if (m_MapOfPropertyLists.end() != it)
+    {
+      auto property = it->second->GetProperty(propertyKey);
+
+      if (nullptr != property)
+        return property;
+    }
+  }
+
+  auto property = m_PropertyList->GetProperty(propertyKey);
+
+  if (nullptr == property && fallBackOnDataProperties && m_Data.IsNotNull())
+    property = m_Data->GetPropertyList()->GetProperty(propertyKey);
+
+  return property;
+}
+
 mitk::DataNode::GroupTagList mitk::DataNode::GetGroupTags() const
 {
   GroupTagList groups;
@@ -277,6 +300,16 @@ bool mitk::DataNode::GetBoolProperty(const char *propertyKey, bool &boolValue, c
   return true;
 }
 
+bool mitk::DataNode::GetBoolProperty(const PropertyKeyAtom &propertyKey, bool &boolValue, const mitk::BaseRenderer *renderer) const
+{
+  auto boolprop = PropertyCast<mitk::BoolProperty>(GetProperty(propertyKey, renderer));
+  if (nullptr == boolprop)
+    return false;
+
+  boolValue = boolprop->GetValue();
+  return true;
+}
+
 bool mitk::DataNode::GetIntProperty(const char *propertyKey, int &intValue, const mitk::BaseRenderer *renderer) const
 {
   mitk::IntProperty::Pointer intprop = dynamic_cast<mitk::IntProperty *>(GetProperty(propertyKey, renderer));
@@ -287,6 +320,16 @@ bool mitk::DataNode::GetIntProperty(const char *propertyKey, int &intValue, cons
   return true;
 }
 
+bool mitk::DataNode::GetIntProperty(const PropertyKeyAtom &propertyKey, int &intValue, const mitk::BaseRenderer *renderer) const
+{
+  auto intprop = PropertyCast<mitk::IntProperty>(GetProperty(propertyKey, renderer));
+  if (nullptr == intprop)
+    return false;
+
+  intValue = intprop->GetValue();
+  return true;
+}
+
 bool mitk::DataNode::GetFloatProperty(const char *propertyKey,
                                       float &floatValue,
                                       const mitk::BaseRenderer *renderer) const
@@ -299,6 +342,18 @@ bool mitk::DataNode::GetFloatProperty(const char *propertyKey,
   return true;
 }
 
+bool mitk::DataNode::GetFloatProperty(const PropertyKeyAtom &propertyKey,
+                                      float &floatValue,
+                                      const mitk::BaseRenderer *renderer) const
+{
+  auto floatprop = PropertyCast<mitk::FloatProperty>(GetProperty(propertyKey, renderer));
+  if (nullptr == floatprop)
+    return false;
+
+  floatValue = floatprop->GetValue();
+  return true;
+}
+
 bool mitk::DataNode::GetDoubleProperty(const char *propertyKey,
                                        double &doubleValue,
                                        const mitk::BaseRenderer *renderer) const
@@ -347,6 +402,16 @@ bool mitk::DataNode::GetColor(float rgb[3], const mitk::BaseRenderer *renderer,
   return true;
 }
 
+bool mitk::DataNode::GetColor(float rgb[3], const mitk::BaseRenderer *renderer, const PropertyKeyAtom &propertyKey) const
+{
+  auto colorprop = PropertyCast<mitk::ColorProperty>(GetProperty(propertyKey, renderer));
+  if (nullptr == colorprop)
+    return false;
+
+  memcpy(rgb, colorprop->GetColor().GetDataPointer(), 3 * sizeof(float));
+  return true;
+}
+
 bool mitk::DataNode::GetOpacity(float &opacity, const mitk::BaseRenderer *renderer, const char *propertyKey) const
 {
   mitk::FloatProperty::Pointer opacityprop = dynamic_cast<mitk::FloatProperty *>(GetProperty(propertyKey, renderer));
@@ -357,6 +422,11 @@ bool mitk::DataNode::GetOpacity(float &opacity, const mitk::BaseRenderer *render
   return true;
 }
 
+bool mitk::DataNode::GetOpacity(float &opacity, const mitk::BaseRenderer *renderer, const PropertyKeyAtom &propertyKey) const
+{
+  return this->GetFloatProperty(propertyKey, opacity, renderer);
+}
+
 bool mitk::DataNode::GetLevelWindow(mitk::LevelWindow &levelWindow,
                                     const mitk::BaseRenderer *renderer,
                                     const char *propertyKey) const
@@ -15,6 +15,7 @@ found in the LICENSE file.
 #include "mitkCompareImageDataFilter.h"
 #include "mitkImageStatisticsHolder.h"
 #include "mitkImageVtkReadAccessor.h"
+#include "mitkPagedMemory.h"
 #include "mitkPixelTypeMultiplex.h"
 #include <mitkProportionalTimeGeometry.h>
 
@@ -37,7 +38,8 @@ mitk::Image::Image()
     m_ImageDescriptor(nullptr),
     m_OffsetTable(nullptr),
     m_CompleteData(nullptr),
-    m_ImageStatistics(nullptr)
+    m_ImageStatistics(nullptr),
+    m_LastWriteAccessTime(0)
 {
   m_Dimensions = new unsigned int[MAX_IMAGE_DIMENSIONS];
   FILL_C_ARRAY(m_Dimensions, MAX_IMAGE_DIMENSIONS, 0u);
@@ -52,7 +54,8 @@ mitk::Image::Image(const Image &other)
     m_ImageDescriptor(nullptr),
     m_OffsetTable(nullptr),
     m_CompleteData(nullptr),
-    m_ImageStatistics(nullptr)
+    m_ImageStatistics(nullptr),
+    m_LastWriteAccessTime(0)
 {
   m_Dimensions = new unsigned int[MAX_IMAGE_DIMENSIONS];
   FILL_C_ARRAY(m_Dimensions, MAX_IMAGE_DIMENSIONS, 0u);
@@ -83,6 +86,14 @@ mitk::Image::Image(const Image &other)
   }
 }
 
+void mitk::Image::WriteAccessReleased() const
+{
+  // a time stamp of the global modification counter, comparable to GetMTime()
+  itk::TimeStamp timeStamp;
+  timeStamp.Modified();
+  m_LastWriteAccessTime = timeStamp.GetMTime();
+}
+
 mitk::Image::~Image()
 {
   this->Clear();
@@ -163,7 +174,12 @@ mitk::Image::ImageDataItemPointer mitk::Image::GetSliceData(
   int s, int t, int n, void *data, ImportMemoryManagementType importMemoryManagement) const
 {
   MutexHolder lock(m_ImageDataArraysLock);
-  return GetSliceData_unlocked(s, t, n, data, importMemoryManagement);
+  auto slice = GetSliceData_unlocked(s, t, n, data, importMemoryManagement);
+
+  if (slice.GetPointer() != nullptr)
+    slice->MakeResident();
+
+  return slice;
 }
 
 mitk::Image::ImageDataItemPointer mitk::Image::GetSliceData_unlocked(
@@ -248,7 +264,12 @@ mitk::Image::ImageDataItemPointer mitk::Image::GetVolumeData(int t,
                                                              ImportMemoryManagementType importMemoryManagement) const
 {
   MutexHolder lock(m_ImageDataArraysLock);
-  return GetVolumeData_unlocked(t, n, data, importMemoryManagement);
+  auto volume = GetVolumeData_unlocked(t, n, data, importMemoryManagement);
+
+  if (volume.GetPointer() != nullptr)
+    volume->MakeResident();
+
+  return volume;
 }
 mitk::Image::ImageDataItemPointer mitk::Image::GetVolumeData_unlocked(
   int t, int n, void *data, ImportMemoryManagementType importMemoryManagement) const
@@ -423,6 +444,8 @@ mitk::Image::ImageDataItemPointer mitk::Image::GetChannelData_unlocked(
 
         if (vol->GetParent() != ch)
         {
+          vol->MakeResident();
+
           // copy data of volume in channel
           size_t offset = ((size_t)t) * m_OffsetTable[3] * (ptypeSize);
           std::memcpy(static_cast<char *>(ch->GetData()) + offset, vol->GetData(), size);
@@ -666,6 +689,43 @@ bool mitk::Image::SetImportVolume(const void *const_data, int t, int n)
   return this->SetImportVolume(const_cast<void*>(const_data), t, n, CopyMemory);
 }
 
+bool mitk::Image::SetPagedVolume(std::shared_ptr<PagedMemory> pagedMemory, int t, int n)
+{
+  if (IsValidVolume(t, n) == false || nullptr == pagedMemory)
+    return false;
+
+  const size_t ptypeSize = this->m_ImageDescriptor->GetChannelTypeById(n).GetSize();
+
+  if (pagedMemory->GetSize() != m_OffsetTable[3] * ptypeSize)
+    return false;
+
+  MutexHolder lock(m_ImageDataArraysLock);
+
+  // volumes that are part of a channel cannot be paged individually
+  if (m_Channels[n].GetPointer() != nullptr)
+    return false;
+
+  mitk::PixelType chPixelType = this->m_ImageDescriptor->GetChannelTypeById(n);
+
+  ImageDataItemPointer vol = new ImageDataItem(chPixelType, t, 3, m_Dimensions, pagedMemory->GetData(), false);
+  vol->m_PagedMemory = pagedMemory;
+  vol->SetComplete(true);
+
+  const int pos = GetVolumeIndex(t, n);
+  const bool isReplacement = m_Volumes[pos].GetPointer() != nullptr;
+  m_Volumes[pos] = vol;
+
+  // get rid of slices - they may point to the old volume
+  auto slicesIt = m_Slices.begin() + GetSliceIndex(0, t, n);
+  for (unsigned int i = 0; i < m_Dimensions[2]; ++i, ++slicesIt)
+    *slicesIt = nullptr;
+
+  if (isReplacement)
+    Modified();
+
+  return true;
+}
+
 bool mitk::Image::SetImportChannel(void *data, int n, ImportMemoryManagementType importMemoryManagement)
 {
   if (IsValidChannel(n) == false)
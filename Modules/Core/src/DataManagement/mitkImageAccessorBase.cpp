@@ -12,6 +12,7 @@ found in the LICENSE file.
 
 #include "mitkImageAccessorBase.h"
 #include "mitkImage.h"
+#include "mitkPagedMemory.h"
 
 mitk::ImageAccessorBase::ThreadIDType mitk::ImageAccessorBase::CurrentThreadHandle()
 {
@@ -36,6 +37,8 @@ bool mitk::ImageAccessorBase::CompareThreadHandles(mitk::ImageAccessorBase::Thre
 
 mitk::ImageAccessorBase::~ImageAccessorBase()
 {
+  if (m_IsPagedMemoryPinned)
+    m_PagedMemory->Unpin();
 }
 
 mitk::ImageAccessorBase::ImageAccessorBase(ImageConstPointer image,
@@ -45,7 +48,8 @@ mitk::ImageAccessorBase::ImageAccessorBase(ImageConstPointer image,
     //, imageDataItem(iDI)
     m_SubRegion(nullptr),
     m_Options(OptionFlags),
-    m_CoherentMemory(false)
+    m_CoherentMemory(false),
+    m_IsPagedMemoryPinned(false)
 {
   m_Thread = CurrentThreadHandle();
 
@@ -108,6 +112,9 @@ mitk::ImageAccessorBase::ImageAccessorBase(ImageConstPointer image,
     m_AddressEnd = (unsigned char *)m_AddressBegin + imageDataItem->m_Size;
   }
 
+  if (imageDataItem != nullptr)
+    m_PagedMemory = imageDataItem->GetPagedMemory();
+
   // Case 3: No ImageDataItem but a SubRegion
   if (imageDataItem == nullptr && m_SubRegion)
   {
@@ -148,6 +155,15 @@ bool mitk::ImageAccessorBase::Overlap(const ImageAccessorBase *iAB)
   return false;
 }
 
+void mitk::ImageAccessorBase::PinPagedMemory()
+{
+  if (m_PagedMemory == nullptr || m_IsPagedMemoryPinned)
+    return;
+
+  m_PagedMemory->Pin();
+  m_IsPagedMemoryPinned = true;
+}
+
 /** \brief Uses the WaitLock to wait for another ImageAccessor*/
 void mitk::ImageAccessorBase::WaitForReleaseOf(ImageAccessorWaitLock *wL)
 {
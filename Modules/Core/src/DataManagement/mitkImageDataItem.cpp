@@ -29,6 +29,7 @@ found in the LICENSE file.
 #include <mitkImage.h>
 #include <mitkImageVtkReadAccessor.h>
 #include <mitkImageVtkWriteAccessor.h>
+#include <mitkPagedMemory.h>
 
 mitk::ImageDataItem::ImageDataItem(const ImageDataItem &aParent,
                                    const mitk::ImageDescriptor::Pointer desc,
@@ -175,6 +176,8 @@ mitk::ImageDataItem::ImageDataItem(const ImageDataItem &other)
     m_IsComplete(other.m_IsComplete),
     m_Size(other.m_Size),
     m_Parent(other.m_Parent),
+    m_MemoryOwner(other.m_MemoryOwner),
+    m_PagedMemory(other.m_PagedMemory),
     m_Dimension(other.m_Dimension),
     m_Timestep(other.m_Timestep)
 {
@@ -183,6 +186,22 @@ mitk::ImageDataItem::ImageDataItem(const ImageDataItem &other)
     m_Dimensions[i] = other.m_Dimensions[i];
 }
 
+std::shared_ptr<mitk::PagedMemory> mitk::ImageDataItem::GetPagedMemory() const
+{
+  if (nullptr != m_PagedMemory || m_Parent.IsNull())
+    return m_PagedMemory;
+
+  return m_Parent->GetPagedMemory();
+}
+
+void mitk::ImageDataItem::MakeResident() const
+{
+  auto pagedMemory = this->GetPagedMemory();
+
+  if (nullptr != pagedMemory)
+    pagedMemory->Touch();
+}
+
 itk::LightObject::Pointer mitk::ImageDataItem::InternalClone() const
 {
   Self::Pointer newGeometry = new Self(*this);
@@ -290,6 +309,18 @@ void mitk::ImageDataItem::ConstructVtkImageData(ImageConstPointer iP) const
     return;
   }
 
+  // The vtkImageData does not pin paged memory, its content is restored by Image::GetVtkImageData()
+  try
+  {
+    this->MakeResident();
+  }
+  catch (...)
+  {
+    scalars->Delete();
+    inData->Delete();
+    throw;
+  }
+
   m_VtkImageData = inData;
 
   // set mitk imageDataItem void array to vtk scalar values
@@ -17,6 +17,8 @@ found in the LICENSE file.
 mitk::ImageReadAccessor::ImageReadAccessor(ImageConstPointer image, const mitk::ImageDataItem *iDI, int OptionFlags)
   : ImageAccessorBase(image, iDI, OptionFlags), m_Image(image)
 {
+  PinPagedMemory();
+
   if (!(OptionFlags & ImageAccessorBase::IgnoreLock))
   {
     try
@@ -34,6 +36,8 @@ mitk::ImageReadAccessor::ImageReadAccessor(ImageConstPointer image, const mitk::
 mitk::ImageReadAccessor::ImageReadAccessor(ImagePointer image, const mitk::ImageDataItem *iDI, int OptionFlags)
   : ImageAccessorBase(image.GetPointer(), iDI, OptionFlags), m_Image(image.GetPointer())
 {
+  PinPagedMemory();
+
   if (!(OptionFlags & ImageAccessorBase::IgnoreLock))
   {
     try
@@ -51,6 +55,7 @@ mitk::ImageReadAccessor::ImageReadAccessor(ImagePointer image, const mitk::Image
 mitk::ImageReadAccessor::ImageReadAccessor(const mitk::Image *image, const ImageDataItem *iDI)
   : ImageAccessorBase(image, iDI, ImageAccessorBase::DefaultBehavior), m_Image(image)
 {
+  PinPagedMemory();
   OrganizeReadAccess();
 }
 
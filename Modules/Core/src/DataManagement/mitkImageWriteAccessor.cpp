@@ -16,6 +16,7 @@ mitk::ImageWriteAccessor::ImageWriteAccessor(ImagePointer image, const mitk::Ima
   : ImageAccessorBase(image.GetPointer(), iDI, OptionFlags), m_Image(image)
 
 {
+  PinPagedMemory();
   OrganizeWriteAccess();
 }
 
@@ -42,6 +43,8 @@ mitk::ImageWriteAccessor::~ImageWriteAccessor()
   }
 
   m_Image->m_ReadWriteLock.unlock();
+
+  m_Image->WriteAccessReleased();
 }
 
 const mitk::Image *mitk::ImageWriteAccessor::GetImage() const
@@ -0,0 +1,213 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include <mitkPagedMemory.h>
+
+#include <mitkExceptionMacro.h>
+#include <mitkIOUtil.h>
+#include <mitkPagedMemoryManager.h>
+
+#include <itksys/SystemTools.hxx>
+
+#include <cstring>
+#include <fstream>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#endif
+
+mitk::PagedMemory::PagedMemory(std::size_t size)
+  : m_Manager(PagedMemoryManager::GetSharedInstance()),
+    m_Data(nullptr),
+    m_Size(size),
+    m_IsResident(true),
+    m_IsInTransition(false),
+    m_PinCount(0),
+    m_BackupOffset(0),
+    m_BackupHash(0)
+{
+  if (0 == size)
+    mitkThrow() << "Cannot create paged memory of zero bytes.";
+
+#ifdef _WIN32
+  m_Data = VirtualAlloc(nullptr, size, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE);
+
+  if (nullptr == m_Data)
+    mitkThrow() << "Cannot reserve " << size << " bytes of paged memory.";
+#else
+  auto data = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+
+  if (MAP_FAILED == data)
+    mitkThrow() << "Cannot reserve " << size << " bytes of paged memory.";
+
+  m_Data = data;
+#endif
+}
+
+mitk::PagedMemory::~PagedMemory()
+{
+  m_Manager->Unregister(this);
+
+#ifdef _WIN32
+  VirtualFree(m_Data, 0, MEM_RELEASE);
+#else
+  munmap(m_Data, m_Size);
+#endif
+
+  if (!m_SpillPath.empty())
+    itksys::SystemTools::RemoveFile(m_SpillPath);
+}
+
+void* mitk::PagedMemory::GetData() const
+{
+  return m_Data;
+}
+
+std::size_t mitk::PagedMemory::GetSize() const
+{
+  return m_Size;
+}
+
+void mitk::PagedMemory::SetSource(const std::string& path, std::size_t offset)
+{
+  m_Manager->SetSource(this, path, offset);
+}
+
+void mitk::PagedMemory::Pin()
+{
+  m_Manager->Use(this, true);
+}
+
+void mitk::PagedMemory::Unpin()
+{
+  m_Manager->Unpin(this);
+}
+
+void mitk::PagedMemory::Touch()
+{
+  m_Manager->Use(this, false);
+}
+
+bool mitk::PagedMemory::IsResident() const
+{
+  return m_Manager->IsResident(this);
+}
+
+bool mitk::PagedMemory::IsPinned() const
+{
+  return m_Manager->IsPinned(this);
+}
+
+void mitk::PagedMemory::Restore()
+{
+  std::ifstream stream(m_BackupPath, std::ios::binary);
+
+  if (stream.is_open())
+  {
+    stream.seekg(static_cast<std::streamoff>(m_BackupOffset));
+    stream.read(static_cast<char*>(m_Data), static_cast<std::streamsize>(m_Size));
+  }
+
+  if (!stream.is_open() || static_cast<std::size_t>(stream.gcount()) != m_Size)
+  {
+    // leave the block in a defined state
+    this->ReleasePages();
+    mitkThrow() << "Cannot restore " << m_Size << " bytes of paged memory from \"" << m_BackupPath << "\".";
+  }
+
+  m_BackupHash = this->ComputeHash();
+}
+
+bool mitk::PagedMemory::Evict(const std::string& spillDirectory)
+{
+  bool spilled = false;
+  const auto hash = this->ComputeHash();
+
+  if (m_BackupPath.empty() || hash != m_BackupHash)
+  {
+    std::ofstream stream;
+
+    if (m_SpillPath.empty())
+    {
+      m_SpillPath = IOUtil::CreateTemporaryFile(stream, std::ios_base::binary, "MITK-PagedMemory-XXXXXX", spillDirectory);
+    }
+    else
+    {
+      stream.open(m_SpillPath, std::ios::binary | std::ios::trunc);
+    }
+
+    stream.write(static_cast<const char*>(m_Data), static_cast<std::streamsize>(m_Size));
+    stream.close();
+
+    if (stream.fail())
+      mitkThrow() << "Cannot write " << m_Size << " bytes of paged memory to \"" << m_SpillPath << "\".";
+
+    // the content of the source file is outdated now
+    m_BackupPath = m_SpillPath;
+    m_BackupOffset = 0;
+    m_BackupHash = hash;
+    spilled = true;
+  }
+
+  this->ReleasePages();
+
+  return spilled;
+}
+
+void mitk::PagedMemory::ReleasePages()
+{
+  // The address range stays reserved, it is just backed by new zero pages that occupy
+  // physical memory only after they were touched.
+#ifdef _WIN32
+  VirtualFree(m_Data, m_Size, MEM_DECOMMIT);
+  VirtualAlloc(m_Data, m_Size, MEM_COMMIT, PAGE_READWRITE);
+#else
+  mmap(m_Data, m_Size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_FIXED, -1, 0);
+#endif
+}
+
+std::uint64_t mitk::PagedMemory::ComputeHash() const
+{
+  // 64 bit FNV-1a over words is fast enough compared to writing the content to disk
+  constexpr std::uint64_t prime = 0x100000001b3ULL;
+  std::uint64_t hash = 0xcbf29ce484222325ULL;
+
+  const auto bytes = static_cast<const unsigned char*>(m_Data);
+  const auto numberOfWords = m_Size / sizeof(std::uint64_t);
+
+  for (std::size_t i = 0; i < numberOfWords; ++i)
+  {
+    std::uint64_t word;
+    std::memcpy(&word, bytes + i * sizeof(word), sizeof(word));
+    hash = (hash ^ word) * prime;
+  }
+
+  for (auto i = numberOfWords * sizeof(std::uint64_t); i < m_Size; ++i)
+    hash = (hash ^ bytes[i]) * prime;
+
+  return hash;
+}
+
+mitk::PagedMemoryPin::PagedMemoryPin(std::shared_ptr<PagedMemory> memory)
+  : m_Memory(memory)
+{
+  if (nullptr != m_Memory)
+    m_Memory->Pin();
+}
+
+mitk::PagedMemoryPin::~PagedMemoryPin()
+{
+  if (nullptr != m_Memory)
+    m_Memory->Unpin();
+}
@@ -0,0 +1,313 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include <mitkPagedMemoryManager.h>
+
+#include <mitkExceptionMacro.h>
+#include <mitkIOUtil.h>
+#include <mitkLog.h>
+#include <mitkMemoryUtilities.h>
+#include <mitkPagedMemory.h>
+
+#include <iterator>
+
+mitk::PagedMemoryManager& mitk::PagedMemoryManager::GetInstance()
+{
+  return *GetSharedInstance();
+}
+
+std::shared_ptr<mitk::PagedMemoryManager> mitk::PagedMemoryManager::GetSharedInstance()
+{
+  static std::shared_ptr<PagedMemoryManager> instance(new PagedMemoryManager);
+  return instance;
+}
+
+mitk::PagedMemoryManager::PagedMemoryManager()
+  : m_MemoryBudget(MemoryUtilities::GetTotalSizeOfPhysicalRam() / 2),
+    m_ResidentSize(0)
+{
+}
+
+void mitk::PagedMemoryManager::SetMemoryBudget(std::size_t budget)
+{
+  std::unique_lock<std::mutex> lock(m_Mutex);
+
+  m_MemoryBudget = budget;
+  this->EnforceBudget(lock);
+}
+
+std::size_t mitk::PagedMemoryManager::GetMemoryBudget() const
+{
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  return m_MemoryBudget;
+}
+
+std::size_t mitk::PagedMemoryManager::GetResidentSize() const
+{
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  return m_ResidentSize;
+}
+
+void mitk::PagedMemoryManager::SetSpillDirectory(const std::string& spillDirectory)
+{
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  m_SpillDirectory = spillDirectory;
+}
+
+std::string mitk::PagedMemoryManager::GetSpillDirectory() const
+{
+  std::lock_guard<std::mutex> lock(m_Mutex);
+
+  return m_SpillDirectory.empty()
+    ? IOUtil::GetTempPath()
+    : m_SpillDirectory;
+}
+
+mitk::PagedMemoryManager::Statistics mitk::PagedMemoryManager::GetStatistics() const
+{
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  return m_Statistics;
+}
+
+void mitk::PagedMemoryManager::ResetStatistics()
+{
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  m_Statistics = Statistics();
+}
+
+void mitk::PagedMemoryManager::EvictAll()
+{
+  std::unique_lock<std::mutex> lock(m_Mutex);
+  std::unordered_set<PagedMemory*> failed;
+
+  // The list may change while a block is evicted, so the candidate is searched again each time
+  while (auto memory = this->FindEvictionCandidate(failed, true))
+  {
+    if (!this->Evict(memory, lock))
+      failed.insert(memory);
+  }
+}
+
+void mitk::PagedMemoryManager::Use(PagedMemory* memory, bool pin)
+{
+  std::unique_lock<std::mutex> lock(m_Mutex);
+  this->WaitForTransition(memory, lock);
+
+  // pinning first prevents the eviction of the block by other threads while it is restored
+  if (pin)
+    ++memory->m_PinCount;
+
+  if (!memory->m_IsResident)
+  {
+    memory->m_IsInTransition = true;
+    lock.unlock();
+
+    try
+    {
+      memory->Restore();
+    }
+    catch (...)
+    {
+      lock.lock();
+
+      if (pin)
+        --memory->m_PinCount;
+
+      memory->m_IsInTransition = false;
+      m_StateChanged.notify_all();
+      throw;
+    }
+
+    lock.lock();
+
+    memory->m_IsResident = true;
+    memory->m_IsInTransition = false;
+    ++m_Statistics.numberOfFaults;
+    m_StateChanged.notify_all();
+  }
+
+  auto it = m_Positions.find(memory);
+
+  if (m_Positions.end() != it)
+  {
+    m_LeastRecentlyUsed.splice(m_LeastRecentlyUsed.begin(), m_LeastRecentlyUsed, it->second);
+  }
+  else
+  {
+    m_Positions[memory] = m_LeastRecentlyUsed.insert(m_LeastRecentlyUsed.begin(), memory);
+    m_ResidentSize += memory->m_Size;
+  }
+
+  this->EnforceBudget(lock);
+}
+
+void mitk::PagedMemoryManager::Unpin(PagedMemory* memory)
+{
+  std::unique_lock<std::mutex> lock(m_Mutex);
+
+  if (0 == memory->m_PinCount)
+  {
+    MITK_WARN << "Paged memory was unpinned more often than it was pinned.";
+    return;
+  }
+
+  // the budget may have been exceeded because of this pin
+  if (0 == --memory->m_PinCount)
+    this->EnforceBudget(lock);
+}
+
+void mitk::PagedMemoryManager::SetSource(PagedMemory* memory, const std::string& path, std::size_t offset)
+{
+  std::unique_lock<std::mutex> lock(m_Mutex);
+  this->WaitForTransition(memory, lock);
+
+  if (0 != memory->m_PinCount)
+    mitkThrow() << "Cannot set source of pinned paged memory.";
+
+  this->Remove(memory);
+
+  memory->ReleasePages();
+  memory->m_IsResident = false;
+  memory->m_BackupPath = path;
+  memory->m_BackupOffset = offset;
+}
+
+void mitk::PagedMemoryManager::Unregister(PagedMemory* memory)
+{
+  std::unique_lock<std::mutex> lock(m_Mutex);
+
+  // another thread may still evict the block
+  this->WaitForTransition(memory, lock);
+  this->Remove(memory);
+}
+
+bool mitk::PagedMemoryManager::IsResident(const PagedMemory* memory) const
+{
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  return memory->m_IsResident;
+}
+
+bool mitk::PagedMemoryManager::IsPinned(const PagedMemory* memory) const
+{
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  return 0 != memory->m_PinCount;
+}
+
+void mitk::PagedMemoryManager::WaitForTransition(const PagedMemory* memory, std::unique_lock<std::mutex>& lock)
+{
+  m_StateChanged.wait(lock, [memory]() { return !memory->m_IsInTransition; });
+}
+
+void mitk::PagedMemoryManager::Remove(PagedMemory* memory)
+{
+  auto it = m_Positions.find(memory);
+
+  if (m_Positions.end() == it)
+    return;
+
+  m_LeastRecentlyUsed.erase(it->second);
+  m_Positions.erase(it);
+  m_ResidentSize -= memory->m_Size;
+}
+
+bool mitk::PagedMemoryManager::Evict(PagedMemory* memory, std::unique_lock<std::mutex>& lock)
+{
+  if (0 != memory->m_PinCount || memory->m_IsInTransition)
+    return false;
+
+  const auto spillDirectory = m_SpillDirectory.empty()
+    ? IOUtil::GetTempPath()
+    : m_SpillDirectory;
+
+  // The block leaves the list before the lock is released, so that it is not selected by other threads
+  memory->m_IsInTransition = true;
+  this->Remove(memory);
+
+  lock.unlock();
+
+  bool evicted = false;
+  bool spilled = false;
+  std::string error;
+
+  try
+  {
+    spilled = memory->Evict(spillDirectory);
+    evicted = true;
+  }
+  catch (const Exception& e)
+  {
+    error = e.GetDescription();
+  }
+  catch (const std::exception& e)
+  {
+    error = e.what();
+  }
+
+  lock.lock();
+
+  if (evicted)
+  {
+    memory->m_IsResident = false;
+    ++m_Statistics.numberOfEvictions;
+
+    if (spilled)
+      ++m_Statistics.numberOfSpills;
+  }
+  else
+  {
+    MITK_ERROR << "Paged memory could not be evicted: " << error;
+
+    m_Positions[memory] = m_LeastRecentlyUsed.insert(m_LeastRecentlyUsed.begin(), memory);
+    m_ResidentSize += memory->m_Size;
+  }
+
+  // The block must not be accessed after this point, as it may be destroyed as soon as the lock is released
+  memory->m_IsInTransition = false;
+  m_StateChanged.notify_all();
+
+  return evicted;
+}
+
+mitk::PagedMemory* mitk::PagedMemoryManager::FindEvictionCandidate(const std::unordered_set<PagedMemory*>& excluded, bool includeMostRecentlyUsed) const
+{
+  if (m_LeastRecentlyUsed.empty())
+    return nullptr;
+
+  const auto first = includeMostRecentlyUsed
+    ? m_LeastRecentlyUsed.rend()
+    : std::prev(m_LeastRecentlyUsed.rend());
+
+  for (auto it = m_LeastRecentlyUsed.rbegin(); it != first; ++it)
+  {
+    if (0 == (*it)->m_PinCount && 0 == excluded.count(*it))
+      return *it;
+  }
+
+  return nullptr;
+}
+
+void mitk::PagedMemoryManager::EnforceBudget(std::unique_lock<std::mutex>& lock)
+{
+  std::unordered_set<PagedMemory*> failed;
+
+  // The most recently used block is kept in any case, as its memory is most likely about to be accessed
+  while (m_ResidentSize > m_MemoryBudget)
+  {
+    auto memory = this->FindEvictionCandidate(failed, false);
+
+    if (nullptr == memory)
+      break;
+
+    if (!this->Evict(memory, lock))
+      failed.insert(memory);
+  }
+}
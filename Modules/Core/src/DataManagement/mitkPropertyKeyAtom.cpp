@@ -0,0 +1,82 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include <mitkPropertyKeyAtom.h>
+#include <mitkExceptionMacro.h>
+
+#include <deque>
+#include <mutex>
+#include <unordered_map>
+
+namespace
+{
+  struct PropertyKeyRegistry
+  {
+    std::mutex Mutex;
+    std::unordered_map<std::string, mitk::PropertyKeyAtom::IdType> Ids;
+    std::deque<std::string> Keys; // Indexed by id, references are stable
+  };
+
+  PropertyKeyRegistry &GetRegistry()
+  {
+    static PropertyKeyRegistry registry;
+    return registry;
+  }
+}
+
+mitk::PropertyKeyAtom::PropertyKeyAtom(const std::string &key)
+{
+  if (key.empty())
+    mitkThrow() << "Property key is empty.";
+
+  auto &registry = GetRegistry();
+  std::lock_guard<std::mutex> lock(registry.Mutex);
+
+  auto result = registry.Ids.emplace(key, static_cast<IdType>(registry.Keys.size()));
+
+  if (result.second)
+    registry.Keys.push_back(key);
+
+  m_Id = result.first->second;
+}
+
+const std::string &mitk::PropertyKeyAtom::GetKey() const
+{
+  auto &registry = GetRegistry();
+  std::lock_guard<std::mutex> lock(registry.Mutex);
+
+  return registry.Keys[m_Id];
+}
+
+const mitk::PropertyKeyAtom &mitk::PropertyKeyAtom::Visible()
+{
+  static const PropertyKeyAtom atom("visible");
+  return atom;
+}
+
+const mitk::PropertyKeyAtom &mitk::PropertyKeyAtom::Opacity()
+{
+  static const PropertyKeyAtom atom("opacity");
+  return atom;
+}
+
+const mitk::PropertyKeyAtom &mitk::PropertyKeyAtom::Color()
+{
+  static const PropertyKeyAtom atom("color");
+  return atom;
+}
+
+const mitk::PropertyKeyAtom &mitk::PropertyKeyAtom::Layer()
+{
+  static const PropertyKeyAtom atom("layer");
+  return atom;
+}
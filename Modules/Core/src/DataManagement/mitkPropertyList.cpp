@@ -16,6 +16,8 @@ found in the LICENSE file.
 #include <mitkProperties.h>
 #include <mitkStringProperty.h>
 
+#include <algorithm>
+
 mitk::BaseProperty::ConstPointer mitk::PropertyList::GetConstProperty(const std::string &propertyKey, const std::string &/*contextName*/, bool /*fallBackOnDefaultContext*/) const
 {
   PropertyMap::const_iterator it;
@@ -56,6 +58,19 @@ mitk::BaseProperty *mitk::PropertyList::GetProperty(const std::string &propertyK
     return nullptr;
 }
 
+mitk::BaseProperty *mitk::PropertyList::GetProperty(const PropertyKeyAtom &propertyKey) const
+{
+  const auto id = propertyKey.GetId();
+
+  auto it = std::lower_bound(m_PropertyIndex.cbegin(), m_PropertyIndex.cend(), id,
+    [](const PropertyIndexType::value_type &entry, PropertyKeyAtom::IdType value) { return entry.first < value; });
+
+  if (it != m_PropertyIndex.cend() && it->first == id)
+    return it->second;
+  else
+    return nullptr;
+}
+
 mitk::BaseProperty * mitk::PropertyList::GetNonConstProperty(const std::string &propertyKey, const std::string &/*contextName*/, bool /*fallBackOnDefaultContext*/)
 {
   return this->GetProperty(propertyKey);
@@ -104,6 +119,7 @@ void mitk::PropertyList::SetProperty(const std::string &propertyKey, BasePropert
 
   // no? add it.
   m_Properties.insert(PropertyMap::value_type(propertyKey, property));
+  this->UpdatePropertyIndex(propertyKey, property);
   this->Modified();
 }
 
@@ -123,6 +139,7 @@ void mitk::PropertyList::ReplaceProperty(const std::string &propertyKey, BasePro
 
   // no? add/replace it.
   m_Properties.insert(PropertyMap::value_type(propertyKey, property));
+  this->UpdatePropertyIndex(propertyKey, property);
   Modified();
 }
 
@@ -135,6 +152,7 @@ void mitk::PropertyList::RemoveProperty(const std::string &propertyKey, const st
   {
     it->second = nullptr;
     m_Properties.erase(it);
+    this->RemoveFromPropertyIndex(propertyKey);
     Modified();
   }
 }
@@ -149,6 +167,8 @@ mitk::PropertyList::PropertyList(const mitk::PropertyList &other) : itk::Object(
   {
     m_Properties.insert(std::make_pair(i->first, i->second->Clone()));
   }
+
+  this->RebuildPropertyIndex();
 }
 
 mitk::PropertyList::~PropertyList()
@@ -186,6 +206,7 @@ bool mitk::PropertyList::DeleteProperty(const std::string &propertyKey)
   {
     it->second = nullptr;
     m_Properties.erase(it);
+    this->RemoveFromPropertyIndex(propertyKey);
     Modified();
     return true;
   }
@@ -201,6 +222,7 @@ void mitk::PropertyList::Clear()
     ++it;
   }
   m_Properties.clear();
+  m_PropertyIndex.clear();
 }
 
 itk::LightObject::Pointer mitk::PropertyList::InternalClone() const
@@ -247,6 +269,17 @@ bool mitk::PropertyList::GetBoolProperty(const char *propertyKey, bool &boolValu
   // return GetPropertyValue<bool>(propertyKey, boolValue);
 }
 
+bool mitk::PropertyList::GetBoolProperty(const PropertyKeyAtom &propertyKey, bool &boolValue) const
+{
+  auto gp = this->GetPropertyAs<BoolProperty>(propertyKey);
+  if (gp != nullptr)
+  {
+    boolValue = gp->GetValue();
+    return true;
+  }
+  return false;
+}
+
 bool mitk::PropertyList::GetIntProperty(const char *propertyKey, int &intValue) const
 {
   IntProperty *gp = dynamic_cast<IntProperty *>(GetProperty(propertyKey));
@@ -260,6 +293,17 @@ bool mitk::PropertyList::GetIntProperty(const char *propertyKey, int &intValue)
   // return GetPropertyValue<int>(propertyKey, intValue);
 }
 
+bool mitk::PropertyList::GetIntProperty(const PropertyKeyAtom &propertyKey, int &intValue) const
+{
+  auto gp = this->GetPropertyAs<IntProperty>(propertyKey);
+  if (gp != nullptr)
+  {
+    intValue = gp->GetValue();
+    return true;
+  }
+  return false;
+}
+
 bool mitk::PropertyList::GetFloatProperty(const char *propertyKey, float &floatValue) const
 {
   FloatProperty *gp = dynamic_cast<FloatProperty *>(GetProperty(propertyKey));
@@ -273,6 +317,17 @@ bool mitk::PropertyList::GetFloatProperty(const char *propertyKey, float &floatV
   // return GetPropertyValue<float>(propertyKey, floatValue);
 }
 
+bool mitk::PropertyList::GetFloatProperty(const PropertyKeyAtom &propertyKey, float &floatValue) const
+{
+  auto gp = this->GetPropertyAs<FloatProperty>(propertyKey);
+  if (gp != nullptr)
+  {
+    floatValue = gp->GetValue();
+    return true;
+  }
+  return false;
+}
+
 bool mitk::PropertyList::GetStringProperty(const char *propertyKey, std::string &stringValue) const
 {
   StringProperty *sp = dynamic_cast<StringProperty *>(GetProperty(propertyKey));
@@ -419,4 +474,55 @@ void mitk::PropertyList::FromJSON(const nlohmann::json& j)
   }
 
   m_Properties = properties;
+  this->RebuildPropertyIndex();
+}
+
+void mitk::PropertyList::UpdatePropertyIndex(const std::string &propertyKey, BaseProperty *property)
+{
+  // Empty keys cannot be interned (ReplaceProperty() does not reject them)
+  if (propertyKey.empty())
+    return;
+
+  const auto id = PropertyKeyAtom(propertyKey).GetId();
+
+  auto it = std::lower_bound(m_PropertyIndex.begin(), m_PropertyIndex.end(), id,
+    [](const PropertyIndexType::value_type &entry, PropertyKeyAtom::IdType value) { return entry.first < value; });
+
+  if (it != m_PropertyIndex.end() && it->first == id)
+  {
+    it->second = property;
+  }
+  else
+  {
+    m_PropertyIndex.emplace(it, id, property);
+  }
+}
+
+void mitk::PropertyList::RemoveFromPropertyIndex(const std::string &propertyKey)
+{
+  if (propertyKey.empty())
+    return;
+
+  const auto id = PropertyKeyAtom(propertyKey).GetId();
+
+  auto it = std::lower_bound(m_PropertyIndex.begin(), m_PropertyIndex.end(), id,
+    [](const PropertyIndexType::value_type &entry, PropertyKeyAtom::IdType value) { return entry.first < value; });
+
+  if (it != m_PropertyIndex.end() && it->first == id)
+    m_PropertyIndex.erase(it);
+}
+
+void mitk::PropertyList::RebuildPropertyIndex()
+{
+  m_PropertyIndex.clear();
+  m_PropertyIndex.reserve(m_Properties.size());
+
+  for (const auto &[key, property] : m_Properties)
+  {
+    if (!key.empty())
+      m_PropertyIndex.emplace_back(PropertyKeyAtom(key).GetId(), property.GetPointer());
+  }
+
+  std::sort(m_PropertyIndex.begin(), m_PropertyIndex.end(),
+    [](const PropertyIndexType::value_type &left, const PropertyIndexType::value_type &right) { return left.first < right.first; });
 }
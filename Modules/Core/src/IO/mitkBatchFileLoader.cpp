@@ -0,0 +1,423 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include <mitkBatchFileLoader.h>
+
+#include <mitkExceptionMacro.h>
+#include <mitkFileReaderSelector.h>
+#include <mitkFileSignature.h>
+#include <mitkProgressBar.h>
+#include <mitkStandaloneDataStorage.h>
+#include <mitkStringProperty.h>
+#include <mitkUtf8Util.h>
+
+#include <itksys/SystemTools.hxx>
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <map>
+#include <mutex>
+#include <set>
+#include <thread>
+
+namespace
+{
+  /** Estimated size of the decoded data of a file. Compressed files are assumed to
+   * decode to four times their size on disk.*/
+  std::size_t EstimateMemory(const std::string &path)
+  {
+    const std::size_t length = itksys::SystemTools::FileLength(mitk::Utf8Util::Local8BitToUtf8(path));
+    const auto signature = mitk::FileSignature::Get(path);
+
+    bool isCompressed = signature.GetFormat() == mitk::FileSignature::Format::Gzip;
+    if (signature.GetFormat() == mitk::FileSignature::Format::Nrrd)
+    {
+      const auto &header = signature.GetHeader();
+      isCompressed = header.find("encoding: gz") != std::string::npos ||
+                     header.find("encoding: bz") != std::string::npos;
+    }
+
+    return isCompressed ? 4 * length : length;
+  }
+
+  /** Directory of a DICOM file, empty for other files. DICOM readers usually read the
+   * whole series of a file, so files of the same directory are decoded one at a time.*/
+  std::string GetSeriesDirectory(const std::string &path)
+  {
+    if (mitk::FileSignature::Get(path).GetFormat() != mitk::FileSignature::Format::Dicom)
+      return std::string();
+
+    return itksys::SystemTools::GetFilenamePath(path);
+  }
+
+  /** Adds a node and (first) its sources in the reader's data storage to the target data storage.*/
+  void AddNode(mitk::DataStorage &target,
+               const mitk::DataStorage &source,
+               mitk::DataNode *node,
+               mitk::DataStorage::SetOfObjects *addedNodes)
+  {
+    if (target.Exists(node))
+      return;
+
+    auto parents = mitk::DataStorage::SetOfObjects::New();
+    auto sources = source.GetSources(node);
+    for (auto iter = sources->Begin(); iter != sources->End(); ++iter)
+    {
+      mitk::DataNode *parent = iter->Value();
+      AddNode(target, source, parent, addedNodes);
+      parents->push_back(parent);
+    }
+
+    target.Add(node, parents);
+    addedNodes->push_back(node);
+  }
+}
+
+struct mitk::BatchFileLoader::Impl
+{
+  struct Result
+  {
+    bool m_Done = false;
+    bool m_Cancelled = false;
+    bool m_AlreadyRead = false;
+    std::size_t m_Reservation = 0;
+    StandaloneDataStorage::Pointer m_Storage;
+    DataStorage::SetOfObjects::Pointer m_Nodes;
+    std::vector<std::string> m_ReadFiles;
+    std::string m_Error;
+  };
+
+  explicit Impl(const std::vector<std::string> &paths)
+    : m_Paths(paths),
+      m_NumberOfThreads(0),
+      m_MemoryLimit(0),
+      m_Results(paths.size()),
+      m_NextFile(0),
+      m_Cancelled(false),
+      m_Started(false),
+      m_ReservedMemory(0),
+      m_NextResult(0)
+  {
+  }
+
+  void Work();
+  void Load(const std::string &path, Result &result);
+  DataStorage::SetOfObjects::Pointer Add(DataStorage &storage, bool wait);
+
+  const std::vector<std::string> m_Paths;
+  unsigned int m_NumberOfThreads;
+  std::size_t m_MemoryLimit;
+  ProgressCallback m_ProgressCallback;
+
+  FileReaderSelector::ConfidenceCache m_ConfidenceCache;
+  std::vector<Result> m_Results;
+  std::vector<std::thread> m_Threads;
+  std::atomic<std::size_t> m_NextFile;
+  std::atomic<bool> m_Cancelled;
+  bool m_Started;
+
+  mutable std::mutex m_Mutex;
+  std::condition_variable m_ResultAvailable;
+  std::condition_variable m_MemoryAvailable;
+  std::size_t m_ReservedMemory;
+  std::size_t m_NextResult;
+  std::vector<std::string> m_Errors;
+  std::map<std::string, std::size_t> m_DecodedFiles; // index of the first path that read a file
+  std::set<std::string> m_SeriesInProgress;
+
+  // Accessed by the calling thread only
+  std::set<std::string> m_ReadFiles;
+};
+
+void mitk::BatchFileLoader::Impl::Work()
+{
+  for (auto i = m_NextFile++; i < m_Paths.size(); i = m_NextFile++)
+  {
+    auto &result = m_Results[i];
+    const auto &path = m_Paths[i];
+    const auto estimate = m_MemoryLimit > 0 ? EstimateMemory(path) : 0;
+    const auto seriesDirectory = GetSeriesDirectory(path);
+
+    {
+      // The file that is added next is always admitted, otherwise workers holding
+      // later files could exhaust the limit while waiting for it to be added.
+      // Waiting for the series and the memory at once never holds one while
+      // waiting for the other.
+      std::unique_lock<std::mutex> lock(m_Mutex);
+      m_MemoryAvailable.wait(lock, [&]() {
+        if (m_Cancelled)
+          return true;
+
+        if (!seriesDirectory.empty() && m_SeriesInProgress.count(seriesDirectory) != 0)
+          return false;
+
+        return m_MemoryLimit == 0 || i == m_NextResult || m_ReservedMemory + estimate <= m_MemoryLimit;
+      });
+
+      if (m_Cancelled)
+      {
+        result.m_Cancelled = true;
+        result.m_Done = true;
+        m_ResultAvailable.notify_all();
+        continue;
+      }
+
+      // The file was read as part of an earlier path and is not decoded again.
+      auto decodedFile = m_DecodedFiles.find(path);
+      if (decodedFile != m_DecodedFiles.end() && decodedFile->second < i)
+      {
+        result.m_AlreadyRead = true;
+        result.m_Done = true;
+        m_ResultAvailable.notify_all();
+        continue;
+      }
+
+      m_ReservedMemory += estimate;
+      result.m_Reservation = estimate;
+
+      if (!seriesDirectory.empty())
+        m_SeriesInProgress.insert(seriesDirectory);
+    }
+
+    Result loaded;
+    this->Load(path, loaded);
+
+    {
+      std::lock_guard<std::mutex> lock(m_Mutex);
+      result.m_Storage = loaded.m_Storage;
+      result.m_Nodes = loaded.m_Nodes;
+      result.m_ReadFiles = loaded.m_ReadFiles;
+      result.m_Error = loaded.m_Error;
+      result.m_Done = true;
+
+      if (loaded.m_Error.empty())
+      {
+        for (const auto &readFile : loaded.m_ReadFiles)
+        {
+          auto decodedFile = m_DecodedFiles.emplace(readFile, i).first;
+          decodedFile->second = std::min(decodedFile->second, i);
+        }
+      }
+
+      if (!seriesDirectory.empty())
+        m_SeriesInProgress.erase(seriesDirectory);
+    }
+    m_ResultAvailable.notify_all();
+
+    if (!seriesDirectory.empty())
+      m_MemoryAvailable.notify_all();
+  }
+}
+
+void mitk::BatchFileLoader::Impl::Load(const std::string &path, Result &result)
+{
+  try
+  {
+    FileReaderSelector readerSelector(path, &m_ConfidenceCache);
+
+    if (readerSelector.IsEmpty())
+    {
+      result.m_Error = itksys::SystemTools::FileExists(Utf8Util::Local8BitToUtf8(path).c_str())
+                         ? "No reader available for '" + path + "'"
+                         : "File '" + path + "' does not exist";
+      return;
+    }
+
+    IFileReader *reader = readerSelector.GetSelected().GetReader();
+    if (reader == nullptr)
+    {
+      result.m_Error = "Unexpected nullptr reader.";
+      return;
+    }
+
+    // Readers may create several nodes with parent/child relations, so they read
+    // into a data storage of their own that is merged on the calling thread.
+    result.m_Storage = StandaloneDataStorage::New();
+    result.m_Nodes = reader->Read(*result.m_Storage);
+    result.m_ReadFiles = reader->GetReadFiles();
+
+    for (auto iter = result.m_Nodes->Begin(); iter != result.m_Nodes->End(); ++iter)
+    {
+      BaseData *data = iter->Value()->GetData();
+      if (data != nullptr)
+        data->SetProperty("path", StringProperty::New(Utf8Util::Local8BitToUtf8(path)));
+    }
+
+    if (result.m_Nodes->Size() == 0)
+      result.m_Error = "Unknown read error occurred reading " + path;
+  }
+  catch (const std::exception &e)
+  {
+    result.m_Error = "Exception occurred when reading file " + path + ":\n" + e.what();
+  }
+  catch (...)
+  {
+    result.m_Error = "Unknown exception occurred when reading file " + path;
+  }
+}
+
+mitk::DataStorage::SetOfObjects::Pointer mitk::BatchFileLoader::Impl::Add(DataStorage &storage, bool wait)
+{
+  auto addedNodes = DataStorage::SetOfObjects::New();
+
+  while (m_NextResult < m_Paths.size())
+  {
+    Result result;
+
+    {
+      std::unique_lock<std::mutex> lock(m_Mutex);
+      auto &pending = m_Results[m_NextResult];
+
+      if (!pending.m_Done)
+      {
+        if (!wait)
+          break;
+
+        m_ResultAvailable.wait(lock, [&]() { return pending.m_Done; });
+      }
+
+      std::swap(result, pending);
+      m_ReservedMemory -= result.m_Reservation;
+      ++m_NextResult;
+
+      if (!result.m_Error.empty())
+        m_Errors.push_back(result.m_Error);
+    }
+    m_MemoryAvailable.notify_all();
+
+    const auto index = m_NextResult - 1;
+    const auto &path = m_Paths[index];
+
+    if (result.m_Cancelled)
+    {
+      ProgressBar::GetInstance()->Progress();
+      continue;
+    }
+
+    if (!result.m_AlreadyRead && result.m_Error.empty() && m_ReadFiles.count(path) == 0)
+    {
+      for (auto iter = result.m_Nodes->Begin(); iter != result.m_Nodes->End(); ++iter)
+        AddNode(storage, *result.m_Storage, iter->Value(), addedNodes);
+
+      m_ReadFiles.insert(result.m_ReadFiles.begin(), result.m_ReadFiles.end());
+    }
+    else if (!result.m_Error.empty())
+    {
+      MITK_ERROR << result.m_Error;
+    }
+
+    ProgressBar::GetInstance()->Progress();
+
+    if (m_ProgressCallback)
+    {
+      Progress progress;
+      progress.m_Index = index;
+      progress.m_Path = path;
+      progress.m_Error = result.m_Error;
+      progress.m_NumberOfProcessedFiles = m_NextResult;
+      progress.m_NumberOfFiles = m_Paths.size();
+      m_ProgressCallback(progress);
+    }
+  }
+
+  return addedNodes;
+}
+
+mitk::BatchFileLoader::BatchFileLoader(const std::vector<std::string> &paths) : m_Impl(new Impl(paths))
+{
+}
+
+mitk::BatchFileLoader::~BatchFileLoader()
+{
+  this->Cancel();
+
+  for (auto &thread : m_Impl->m_Threads)
+    thread.join();
+
+  if (m_Impl->m_Started)
+    ProgressBar::GetInstance()->Progress(static_cast<unsigned int>(m_Impl->m_Paths.size() - m_Impl->m_NextResult));
+}
+
+void mitk::BatchFileLoader::SetNumberOfThreads(unsigned int numberOfThreads)
+{
+  m_Impl->m_NumberOfThreads = numberOfThreads;
+}
+
+unsigned int mitk::BatchFileLoader::GetNumberOfThreads() const
+{
+  return m_Impl->m_NumberOfThreads > 0 ? m_Impl->m_NumberOfThreads : std::max(1u, std::thread::hardware_concurrency());
+}
+
+void mitk::BatchFileLoader::SetMemoryLimit(std::size_t memoryLimit)
+{
+  m_Impl->m_MemoryLimit = memoryLimit;
+}
+
+std::size_t mitk::BatchFileLoader::GetMemoryLimit() const
+{
+  return m_Impl->m_MemoryLimit;
+}
+
+void mitk::BatchFileLoader::SetProgressCallback(const ProgressCallback &callback)
+{
+  m_Impl->m_ProgressCallback = callback;
+}
+
+void mitk::BatchFileLoader::Start()
+{
+  if (m_Impl->m_Started)
+    mitkThrow() << "BatchFileLoader was already started.";
+
+  m_Impl->m_Started = true;
+  ProgressBar::GetInstance()->AddStepsToDo(static_cast<unsigned int>(m_Impl->m_Paths.size()));
+
+  const auto numberOfThreads = std::min<std::size_t>(this->GetNumberOfThreads(), m_Impl->m_Paths.size());
+  for (std::size_t i = 0; i < numberOfThreads; ++i)
+    m_Impl->m_Threads.emplace_back(&Impl::Work, m_Impl.get());
+}
+
+void mitk::BatchFileLoader::Cancel()
+{
+  {
+    std::lock_guard<std::mutex> lock(m_Impl->m_Mutex);
+    m_Impl->m_Cancelled = true;
+  }
+  m_Impl->m_MemoryAvailable.notify_all();
+}
+
+bool mitk::BatchFileLoader::IsFinished() const
+{
+  return m_Impl->m_NextResult == m_Impl->m_Paths.size();
+}
+
+mitk::DataStorage::SetOfObjects::Pointer mitk::BatchFileLoader::AddCompleted(DataStorage &storage)
+{
+  if (!m_Impl->m_Started)
+    return DataStorage::SetOfObjects::New();
+
+  return m_Impl->Add(storage, false);
+}
+
+mitk::DataStorage::SetOfObjects::Pointer mitk::BatchFileLoader::WaitAndAddAll(DataStorage &storage)
+{
+  if (!m_Impl->m_Started)
+    this->Start();
+
+  return m_Impl->Add(storage, true);
+}
+
+std::vector<std::string> mitk::BatchFileLoader::GetErrors() const
+{
+  std::lock_guard<std::mutex> lock(m_Impl->m_Mutex);
+  return m_Impl->m_Errors;
+}
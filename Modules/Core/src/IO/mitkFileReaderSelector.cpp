@@ -14,6 +14,7 @@ found in the LICENSE file.
 
 #include <mitkCoreServices.h>
 #include <mitkFileReaderRegistry.h>
+#include <mitkFileSignature.h>
 #include <mitkIMimeTypeProvider.h>
 #include <mitkUtf8Util.h>
 
@@ -23,6 +24,8 @@ found in the LICENSE file.
 
 #include <itksys/SystemTools.hxx>
 
+#include <mutex>
+
 namespace mitk
 {
   struct FileReaderSelector::Item::Impl : us::SharedData
@@ -46,8 +49,41 @@ namespace mitk
     long m_SelectedId;
   };
 
+  struct FileReaderSelector::ConfidenceCache::Impl
+  {
+    typedef std::map<long, IFileReader::ConfidenceLevel> ConfidenceMap;
+
+    std::mutex m_Mutex;
+    std::map<std::string, ConfidenceMap> m_Confidences;
+  };
+
+  FileReaderSelector::ConfidenceCache::ConfidenceCache() : d(new Impl) {}
+  FileReaderSelector::ConfidenceCache::~ConfidenceCache() {}
+
+  void FileReaderSelector::ConfidenceCache::Clear()
+  {
+    std::lock_guard<std::mutex> lock(d->m_Mutex);
+    d->m_Confidences.clear();
+  }
+
+  namespace
+  {
+    std::string GetConfidenceCacheKey(const std::string &path, const std::vector<MimeType> &mimeTypes)
+    {
+      if (FileSignature::Get(path).GetFormat() != FileSignature::Format::Dicom)
+        return std::string();
+
+      std::string key = itksys::SystemTools::GetFilenamePath(path) + '\n' +
+                        itksys::SystemTools::GetFilenameLastExtension(path);
+      for (const auto &mimeType : mimeTypes)
+        key += '\n' + mimeType.GetName();
+      return key;
+    }
+  }
+
   FileReaderSelector::FileReaderSelector(const FileReaderSelector &other) : m_Data(other.m_Data) {}
-  FileReaderSelector::FileReaderSelector(const std::string &path) : m_Data(new Impl)
+  FileReaderSelector::FileReaderSelector(const std::string &path) : FileReaderSelector(path, nullptr) {}
+  FileReaderSelector::FileReaderSelector(const std::string &path, ConfidenceCache *confidenceCache) : m_Data(new Impl)
   {
     if (!itksys::SystemTools::FileExists(Utf8Util::Local8BitToUtf8(path).c_str()))
     {
@@ -62,6 +98,25 @@ namespace mitk
     if (m_Data->m_MimeTypes.empty())
       return;
 
+    // Confidence levels of another file with the same characteristics in the
+    // same directory, if any
+
+    std::string cacheKey;
+    ConfidenceCache::Impl::ConfidenceMap cachedConfidences;
+    ConfidenceCache::Impl::ConfidenceMap computedConfidences;
+
+    if (confidenceCache != nullptr)
+    {
+      cacheKey = GetConfidenceCacheKey(path, m_Data->m_MimeTypes);
+      if (!cacheKey.empty())
+      {
+        std::lock_guard<std::mutex> lock(confidenceCache->d->m_Mutex);
+        auto iter = confidenceCache->d->m_Confidences.find(cacheKey);
+        if (iter != confidenceCache->d->m_Confidences.end())
+          cachedConfidences = iter->second;
+      }
+    }
+
     for (std::vector<MimeType>::const_iterator mimeTypeIter = m_Data->m_MimeTypes.begin(),
                                                mimeTypeIterEnd = m_Data->m_MimeTypes.end();
          mimeTypeIter != mimeTypeIterEnd;
@@ -78,8 +133,13 @@ namespace mitk
           continue;
         try
         {
+          const long id = us::any_cast<long>(readerIter->GetProperty(us::ServiceConstants::SERVICE_ID()));
+
           reader->SetInput(path);
-          IFileReader::ConfidenceLevel confidenceLevel = reader->GetConfidenceLevel();
+          auto cachedIter = cachedConfidences.find(id);
+          IFileReader::ConfidenceLevel confidenceLevel =
+            cachedIter != cachedConfidences.end() ? cachedIter->second : reader->GetConfidenceLevel();
+          computedConfidences[id] = confidenceLevel;
           if (confidenceLevel == IFileReader::Unsupported)
           {
             continue;
@@ -90,7 +150,7 @@ namespace mitk
           item.d->m_FileReader = reader;
           item.d->m_ConfidenceLevel = confidenceLevel;
           item.d->m_MimeType = *mimeTypeIter;
-          item.d->m_Id = us::any_cast<long>(readerIter->GetProperty(us::ServiceConstants::SERVICE_ID()));
+          item.d->m_Id = id;
           m_Data->m_Items.insert(std::make_pair(item.d->m_Id, item));
           // m_Data->m_MimeTypes.insert(mimeType);
         }
@@ -106,6 +166,12 @@ namespace mitk
       }
     }
 
+    if (!cacheKey.empty() && computedConfidences.size() > cachedConfidences.size())
+    {
+      std::lock_guard<std::mutex> lock(confidenceCache->d->m_Mutex);
+      confidenceCache->d->m_Confidences[cacheKey] = computedConfidences;
+    }
+
     // get the "best" reader
 
     if (!m_Data->m_Items.empty())
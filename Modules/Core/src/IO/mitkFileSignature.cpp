@@ -0,0 +1,161 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include "mitkFileSignature.h"
+
+#include <mitkUtf8Util.h>
+
+#include <itksys/SystemTools.hxx>
+
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <map>
+#include <mutex>
+
+namespace
+{
+  struct CacheEntry
+  {
+    long m_ModifiedTime;
+    unsigned long m_Length;
+    mitk::FileSignature m_Signature;
+  };
+
+  // Directory listings of large DICOM series are the typical workload, so
+  // the cache is simply flushed when it grows beyond this bound.
+  const std::size_t MaximumCacheSize = 4096;
+
+  std::mutex CacheMutex;
+  std::map<std::string, CacheEntry> Cache;
+
+  bool StartsWith(const std::string &header, std::size_t offset, const char *magic)
+  {
+    const auto length = std::strlen(magic);
+    return header.size() >= offset + length && header.compare(offset, length, magic) == 0;
+  }
+
+  bool IsNiftiHeader(const std::string &header)
+  {
+    if (header.size() < 348)
+      return false;
+
+    std::int32_t sizeOfHeader = 0;
+    std::memcpy(&sizeOfHeader, header.data(), sizeof(sizeOfHeader));
+    const bool isLittleEndian = sizeOfHeader == 348;
+    const bool isBigEndian = sizeOfHeader == 0x5C010000;
+
+    if (!isLittleEndian && !isBigEndian)
+      return false;
+
+    // Single file (.nii) and header/image pair (.hdr/.img) magic
+    return header.compare(344, 4, std::string("n+1\0", 4)) == 0 ||
+           header.compare(344, 4, std::string("ni1\0", 4)) == 0;
+  }
+}
+
+namespace mitk
+{
+  FileSignature::FileSignature() : m_Valid(false), m_Format(Format::Unknown) {}
+
+  FileSignature FileSignature::Get(const std::string &path)
+  {
+    const auto utf8Path = Utf8Util::Local8BitToUtf8(path);
+
+    if (itksys::SystemTools::FileIsDirectory(utf8Path))
+      return FileSignature();
+
+    const long modifiedTime = itksys::SystemTools::ModifiedTime(utf8Path);
+    const unsigned long length = itksys::SystemTools::FileLength(utf8Path);
+
+    {
+      std::lock_guard<std::mutex> lock(CacheMutex);
+      auto iter = Cache.find(path);
+      if (iter != Cache.end() && iter->second.m_ModifiedTime == modifiedTime && iter->second.m_Length == length)
+        return iter->second.m_Signature;
+    }
+
+    FileSignature signature;
+
+    std::ifstream stream(path, std::ios::binary);
+    if (!stream.is_open())
+      return signature;
+
+    signature.m_Header.resize(HeaderSize);
+    stream.read(&signature.m_Header[0], HeaderSize);
+    signature.m_Header.resize(static_cast<std::size_t>(stream.gcount()));
+    signature.m_Format = DetectFormat(signature.m_Header);
+    signature.m_Valid = true;
+
+    std::lock_guard<std::mutex> lock(CacheMutex);
+    if (Cache.size() >= MaximumCacheSize)
+      Cache.clear();
+    Cache[path] = CacheEntry{ modifiedTime, length, signature };
+
+    return signature;
+  }
+
+  FileSignature::Format FileSignature::DetectFormat(const std::string &header)
+  {
+    if (StartsWith(header, 128, "DICM"))
+      return Format::Dicom;
+
+    if (StartsWith(header, 0, "NRRD000"))
+      return Format::Nrrd;
+
+    if (IsNiftiHeader(header))
+      return Format::Nifti;
+
+    if (StartsWith(header, 0, "# vtk DataFile"))
+      return Format::VtkLegacy;
+
+    if (StartsWith(header, 0, "<VTKFile") ||
+        (StartsWith(header, 0, "<?xml") && header.find("<VTKFile") != std::string::npos))
+      return Format::VtkXml;
+
+    if (StartsWith(header, 0, "\x1f\x8b"))
+      return Format::Gzip;
+
+    return Format::Unknown;
+  }
+
+  void FileSignature::ClearCache()
+  {
+    std::lock_guard<std::mutex> lock(CacheMutex);
+    Cache.clear();
+  }
+
+  std::string FileSignature::GetFormatName(Format format)
+  {
+    switch (format)
+    {
+      case Format::Dicom:
+        return "DICOM";
+      case Format::Nrrd:
+        return "NRRD";
+      case Format::Nifti:
+        return "NIfTI";
+      case Format::VtkLegacy:
+        return "VTK legacy";
+      case Format::VtkXml:
+        return "VTK XML";
+      case Format::Gzip:
+        return "gzip";
+      default:
+        return "unknown";
+    }
+  }
+
+  bool FileSignature::IsValid() const { return m_Valid; }
+  FileSignature::Format FileSignature::GetFormat() const { return m_Format; }
+  const std::string &FileSignature::GetHeader() const { return m_Header; }
+}
@@ -13,6 +13,7 @@ found in the LICENSE file.
 #include "mitkIOMimeTypes.h"
 
 #include "mitkCustomMimeType.h"
+#include "mitkFileSignature.h"
 #include "mitkLog.h"
 #include <mitkUtf8Util.h>
 
@@ -81,6 +82,12 @@ namespace mitk
     }
     else
     {
+      // Files positively identified as another format by their magic bytes
+      // cannot be DICOM, so spare the comparatively expensive GDCM parse
+      const auto format = FileSignature::Get(filepath).GetFormat();
+      if (format != FileSignature::Format::Unknown && format != FileSignature::Format::Dicom)
+        return false;
+
       // Ask the GDCM ImageIO class directly
       gdcmIO->SetFileName(filepath);
       try {
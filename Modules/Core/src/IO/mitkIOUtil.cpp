@@ -12,6 +12,7 @@ found in the LICENSE file.
 
 #include "mitkIOUtil.h"
 
+#include <mitkBatchFileLoader.h>
 #include <mitkCoreObjectFactory.h>
 #include <mitkCoreServices.h>
 #include <mitkExceptionMacro.h>
@@ -36,8 +37,11 @@ found in the LICENSE file.
 #include <vtkSmartPointer.h>
 #include <vtkTriangleFilter.h>
 
+#include <atomic>
 #include <cerrno>
 #include <cstdlib>
+#include <mutex>
+#include <thread>
 
 static std::string GetLastErrorStr()
 {
@@ -313,6 +317,9 @@ namespace mitk
     };
 
     static BaseData::Pointer LoadBaseDataFromFile(const std::string &path, const ReaderOptionsFunctorBase* optionsCallback = nullptr);
+
+    /** Selects the readers of all paths concurrently. The order of the returned load infos matches the paths.*/
+    static std::vector<LoadInfo> CreateLoadInfos(const std::vector<std::string> &paths);
   };
 
   BaseData::Pointer IOUtil::Impl::LoadBaseDataFromFile(const std::string &path,
@@ -325,6 +332,53 @@ namespace mitk
     return baseDataList.front();
   }
 
+  std::vector<IOUtil::LoadInfo> IOUtil::Impl::CreateLoadInfos(const std::vector<std::string> &paths)
+  {
+    // Mime type detection and reader confidence checks open every file, which
+    // dominates the time to select readers for large batches like DICOM series.
+    // Reader services are prototype-scoped, so every selector works on its own
+    // reader instances and the selectors can be created independently.
+    FileReaderSelector::ConfidenceCache confidenceCache;
+    std::vector<std::unique_ptr<FileReaderSelector>> selectors(paths.size());
+
+    std::atomic<std::size_t> nextPath(0);
+    std::exception_ptr error;
+    std::mutex errorMutex;
+
+    auto worker = [&]() {
+      for (auto i = nextPath++; i < paths.size(); i = nextPath++)
+      {
+        try
+        {
+          selectors[i].reset(new FileReaderSelector(paths[i], &confidenceCache));
+        }
+        catch (...)
+        {
+          std::lock_guard<std::mutex> lock(errorMutex);
+          if (!error)
+            error = std::current_exception();
+        }
+      }
+    };
+
+    const auto numberOfThreads = std::min<std::size_t>(paths.size(), std::max(1u, std::thread::hardware_concurrency()));
+    std::vector<std::thread> threads;
+    for (std::size_t i = 1; i < numberOfThreads; ++i)
+      threads.emplace_back(worker);
+    worker();
+    for (auto &thread : threads)
+      thread.join();
+
+    if (error)
+      std::rethrow_exception(error);
+
+    std::vector<LoadInfo> loadInfos;
+    loadInfos.reserve(paths.size());
+    for (std::size_t i = 0; i < paths.size(); ++i)
+      loadInfos.emplace_back(paths[i], *selectors[i]);
+    return loadInfos;
+  }
+
 #ifdef US_PLATFORM_WINDOWS
   std::string IOUtil::GetProgramPath()
   {
@@ -531,11 +585,7 @@ namespace mitk
   DataStorage::SetOfObjects::Pointer IOUtil::Load(const std::vector<std::string> &paths, DataStorage &storage, const ReaderOptionsFunctorBase *optionsCallback)
   {
     DataStorage::SetOfObjects::Pointer nodeResult = DataStorage::SetOfObjects::New();
-    std::vector<LoadInfo> loadInfos;
-    for (const auto &loadInfo : paths)
-    {
-      loadInfos.emplace_back(loadInfo);
-    }
+    std::vector<LoadInfo> loadInfos = Impl::CreateLoadInfos(paths);
     std::string errMsg = Load(loadInfos, nodeResult, &storage, optionsCallback);
     if (!errMsg.empty())
     {
@@ -547,11 +597,7 @@ namespace mitk
   std::vector<BaseData::Pointer> IOUtil::Load(const std::vector<std::string> &paths, const ReaderOptionsFunctorBase *optionsCallback)
   {
     std::vector<BaseData::Pointer> result;
-    std::vector<LoadInfo> loadInfos;
-    for (const auto &loadInfo : paths)
-    {
-      loadInfos.emplace_back(loadInfo);
-    }
+    std::vector<LoadInfo> loadInfos = Impl::CreateLoadInfos(paths);
     std::string errMsg = Load(loadInfos, nullptr, nullptr, optionsCallback);
     if (!errMsg.empty())
     {
@@ -566,6 +612,34 @@ namespace mitk
     return result;
   }
 
+  DataStorage::SetOfObjects::Pointer IOUtil::LoadConcurrently(const std::vector<std::string> &paths,
+                                                              DataStorage &storage,
+                                                              unsigned int numberOfThreads,
+                                                              std::size_t memoryLimit)
+  {
+    if (paths.empty())
+    {
+      mitkThrow() << "No input files given";
+    }
+
+    BatchFileLoader loader(paths);
+    loader.SetNumberOfThreads(numberOfThreads);
+    loader.SetMemoryLimit(memoryLimit);
+
+    DataStorage::SetOfObjects::Pointer nodeResult = loader.WaitAndAddAll(storage);
+
+    std::string errMsg;
+    for (const auto &error : loader.GetErrors())
+    {
+      errMsg += error + "\n";
+    }
+    if (!errMsg.empty())
+    {
+      mitkThrow() << errMsg;
+    }
+    return nodeResult;
+  }
+
   std::string IOUtil::Load(std::vector<LoadInfo> &loadInfos,
                            DataStorage::SetOfObjects *nodeResult,
                            DataStorage *ds,
@@ -1012,4 +1086,12 @@ namespace mitk
       m_Properties(nullptr)
   {
   }
+
+  IOUtil::LoadInfo::LoadInfo(const std::string &path, const FileReaderSelector &readerSelector)
+    : m_Path(path),
+      m_ReaderSelector(readerSelector),
+      m_Cancel(false),
+      m_Properties(nullptr)
+  {
+  }
 }
@@ -19,16 +19,409 @@ found in the LICENSE file.
 #include <mitkIPropertyPersistence.h>
 #include <mitkImage.h>
 #include <mitkImageReadAccessor.h>
+#include <mitkIOUtil.h>
 #include <mitkLocaleSwitch.h>
+#include <mitkMemoryMappedFile.h>
+#include <mitkNrrdCompression.h>
+#include <mitkPagedMemory.h>
 #include <mitkUIDManipulator.h>
 
 #include <itkImage.h>
 #include <itkImageFileReader.h>
+#include <itkByteSwapper.h>
 #include <itkImageIOFactory.h>
 #include <itkImageIORegion.h>
 #include <itkMetaDataObject.h>
 
+#include <itksys/SystemTools.hxx>
+
 #include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <optional>
+
+namespace
+{
+  /** Upper bound of the pixel data that is requested from the ImageIO at once in LoadMode::Streamed.*/
+  constexpr std::size_t StreamedSlabSizeInBytes = 64 * 1024 * 1024;
+
+  std::atomic<mitk::ItkImageIO::LoadMode> DefaultLoadMode(mitk::ItkImageIO::LoadMode::Complete);
+
+  std::string Trim(const std::string& str)
+  {
+    const auto first = str.find_first_not_of(" \t\r");
+
+    if (std::string::npos == first)
+      return std::string();
+
+    return str.substr(first, str.find_last_not_of(" \t\r") - first + 1);
+  }
+
+  std::string ToLower(std::string str)
+  {
+    std::transform(str.begin(), str.end(), str.begin(), [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+    return str;
+  }
+
+  /** Splits a header line like "key: value" or "Key = Value" into its lower case key and trimmed value.*/
+  bool SplitHeaderLine(const std::string& line, const std::string& separator, std::string& key, std::string& value)
+  {
+    const auto pos = line.find(separator);
+
+    if (std::string::npos == pos)
+      return false;
+
+    key = ToLower(Trim(line.substr(0, pos)));
+    value = Trim(line.substr(pos + separator.size()));
+    return true;
+  }
+
+  /** The pixel data of a detached NRRD header ("data file") or with "line skip"/"byte skip" is not mapped.*/
+  std::optional<std::size_t> GetNrrdPixelDataOffset(std::istream& stream)
+  {
+    std::string line;
+
+    if (!std::getline(stream, line) || 0 != line.compare(0, 4, "NRRD"))
+      return std::nullopt;
+
+    bool isRaw = false;
+
+    while (std::getline(stream, line))
+    {
+      if (Trim(line).empty())
+        return isRaw ? std::optional<std::size_t>(static_cast<std::size_t>(stream.tellg())) : std::nullopt;
+
+      if ('#' == line[0])
+        continue;
+
+      std::string key, value;
+
+      if (!SplitHeaderLine(line, ":", key, value))
+        continue; // key/value pairs (":=") are covered as well, their keys just contain a trailing '='
+
+      if ("encoding" == key)
+      {
+        isRaw = "raw" == ToLower(value);
+      }
+      else if ("data file" == key || "datafile" == key)
+      {
+        return std::nullopt;
+      }
+      else if ("line skip" == key || "lineskip" == key || "byte skip" == key || "byteskip" == key)
+      {
+        if ("0" != value)
+          return std::nullopt;
+      }
+    }
+
+    return std::nullopt;
+  }
+
+  /** Only MetaImages with local (i.e. appended) and uncompressed pixel data are mapped.*/
+  std::optional<std::size_t> GetMetaImagePixelDataOffset(std::istream& stream)
+  {
+    std::string line;
+
+    while (std::getline(stream, line))
+    {
+      std::string key, value;
+
+      if (!SplitHeaderLine(line, "=", key, value))
+        return std::nullopt;
+
+      if ("compresseddata" == key)
+      {
+        if ("false" != ToLower(value))
+          return std::nullopt;
+      }
+      else if ("headersize" == key)
+      {
+        if ("0" != value)
+          return std::nullopt;
+      }
+      else if ("elementdatafile" == key)
+      {
+        // ElementDataFile is always the last field of the header
+        return "local" == ToLower(value)
+          ? std::optional<std::size_t>(static_cast<std::size_t>(stream.tellg()))
+          : std::nullopt;
+      }
+    }
+
+    return std::nullopt;
+  }
+
+  /** Only single file NIfTI-1 images in native byte order without intensity scaling are mapped.*/
+  std::optional<std::size_t> GetNiftiPixelDataOffset(std::istream& stream)
+  {
+    char header[348];
+
+    if (!stream.read(header, sizeof(header)))
+      return std::nullopt;
+
+    std::int32_t headerSize;
+    float voxOffset, sclSlope, sclInter;
+
+    std::memcpy(&headerSize, header, sizeof(headerSize));
+    std::memcpy(&voxOffset, header + 108, sizeof(voxOffset));
+    std::memcpy(&sclSlope, header + 112, sizeof(sclSlope));
+    std::memcpy(&sclInter, header + 116, sizeof(sclInter));
+
+    // a swapped header size indicates foreign byte order
+    if (348 != headerSize || 0 != std::strncmp(header + 344, "n+1", 4))
+      return std::nullopt;
+
+    // scaled intensities are converted by the ImageIO on reading
+    if ((0.0f != sclSlope && 1.0f != sclSlope) || 0.0f != sclInter)
+      return std::nullopt;
+
+    if (voxOffset < 352.0f)
+      return std::nullopt;
+
+    return static_cast<std::size_t>(voxOffset);
+  }
+
+  std::optional<std::size_t> GetMemoryMappablePixelDataOffset(itk::ImageIOBase* imageIO, const std::string& path)
+  {
+    if (1 != imageIO->GetNumberOfComponents())
+      return std::nullopt;
+
+    const auto systemByteOrder = itk::ByteSwapper<int>::SystemIsBigEndian()
+      ? itk::IOByteOrderEnum::BigEndian
+      : itk::IOByteOrderEnum::LittleEndian;
+
+    if (1 != imageIO->GetComponentSize() && systemByteOrder != imageIO->GetByteOrder())
+      return std::nullopt;
+
+    std::ifstream stream(path, std::ios::binary);
+
+    if (!stream.is_open())
+      return std::nullopt;
+
+    const std::string imageIOName = imageIO->GetNameOfClass();
+    std::optional<std::size_t> offset;
+
+    if ("NrrdImageIO" == imageIOName)
+    {
+      offset = GetNrrdPixelDataOffset(stream);
+    }
+    else if ("MetaImageIO" == imageIOName)
+    {
+      offset = GetMetaImagePixelDataOffset(stream);
+    }
+    else if ("NiftiImageIO" == imageIOName)
+    {
+      offset = GetNiftiPixelDataOffset(stream);
+    }
+
+    if (!offset.has_value())
+      return std::nullopt;
+
+    stream.clear();
+    stream.seekg(0, std::ios::end);
+    const auto fileSize = static_cast<std::size_t>(stream.tellg());
+
+    if (offset.value() + imageIO->GetImageSizeInBytes() > fileSize)
+      return std::nullopt;
+
+    return offset;
+  }
+
+  /** Pixel data is accessed in place, so every component has to be aligned to its size.*/
+  std::optional<std::size_t> GetAlignedPixelDataOffset(itk::ImageIOBase* imageIO, const std::string& path)
+  {
+    const auto offset = GetMemoryMappablePixelDataOffset(imageIO, path);
+
+    if (!offset.has_value() || 0 != offset.value() % std::max<std::size_t>(imageIO->GetComponentSize(), 1))
+      return std::nullopt;
+
+    return offset;
+  }
+
+  bool LoadMemoryMappedPixelData(itk::ImageIOBase* imageIO, const std::string& path, mitk::Image* image)
+  {
+    const auto offset = GetAlignedPixelDataOffset(imageIO, path);
+
+    if (!offset.has_value())
+      return false;
+
+    std::shared_ptr<mitk::MemoryMappedFile> file;
+
+    try
+    {
+      file = std::make_shared<mitk::MemoryMappedFile>(path, offset.value(), imageIO->GetImageSizeInBytes());
+    }
+    catch (const mitk::Exception& e)
+    {
+      MITK_WARN << e.GetDescription();
+      return false;
+    }
+
+    image->SetImportChannel(file->GetData(), 0, mitk::Image::ReferenceMemory);
+    image->GetChannelData(0)->SetMemoryOwner(file);
+
+    return true;
+  }
+
+  std::size_t GetSliceSizeInBytes(itk::ImageIOBase* imageIO)
+  {
+    return static_cast<std::size_t>(imageIO->GetDimensions(0)) * imageIO->GetDimensions(1) * imageIO->GetPixelSize();
+  }
+
+  itk::ImageIORegion GetSlabRegion(itk::ImageIOBase* imageIO, unsigned int timeStep, std::size_t slice, std::size_t slabThickness)
+  {
+    const auto numberOfDimensions = imageIO->GetNumberOfDimensions();
+
+    itk::ImageIORegion region(numberOfDimensions);
+    region.SetSize(0, imageIO->GetDimensions(0));
+    region.SetSize(1, imageIO->GetDimensions(1));
+    region.SetIndex(2, slice);
+    region.SetSize(2, std::min<std::size_t>(slabThickness, imageIO->GetDimensions(2) - slice));
+
+    if (4 == numberOfDimensions)
+    {
+      region.SetIndex(3, timeStep);
+      region.SetSize(3, 1);
+    }
+
+    return region;
+  }
+
+  /** Enables streamed reading of the ImageIO and returns the number of slices that are read at once,
+   * or 0 if the ImageIO cannot read single slabs of 3D or 3D+t images.*/
+  std::size_t PrepareStreamedReading(itk::ImageIOBase* imageIO)
+  {
+    const auto numberOfDimensions = imageIO->GetNumberOfDimensions();
+
+    if (numberOfDimensions < 3 || numberOfDimensions > 4 || !imageIO->CanStreamRead())
+      return 0;
+
+    const auto numberOfSlices = imageIO->GetDimensions(2);
+    const auto slabThickness = std::clamp<std::size_t>(StreamedSlabSizeInBytes / std::max<std::size_t>(GetSliceSizeInBytes(imageIO), 1), 1, numberOfSlices);
+
+    imageIO->SetUseStreamedReading(true);
+
+    // The ImageIO must not read more than requested, otherwise the slab would not fit into the buffer
+    const auto requestedRegion = GetSlabRegion(imageIO, 0, 0, slabThickness);
+
+    if (imageIO->GenerateStreamableReadRegionFromRequestedRegion(requestedRegion) != requestedRegion)
+    {
+      imageIO->SetUseStreamedReading(false);
+      return 0;
+    }
+
+    return slabThickness;
+  }
+
+  void ReadTimeStepStreamed(itk::ImageIOBase* imageIO, unsigned int timeStep, std::size_t slabThickness, void* buffer)
+  {
+    const auto numberOfSlices = imageIO->GetDimensions(2);
+    const auto sliceSizeInBytes = GetSliceSizeInBytes(imageIO);
+
+    for (std::size_t slice = 0; slice < numberOfSlices; slice += slabThickness)
+    {
+      imageIO->SetIORegion(GetSlabRegion(imageIO, timeStep, slice, slabThickness));
+      imageIO->Read(static_cast<unsigned char*>(buffer) + slice * sliceSizeInBytes);
+    }
+  }
+
+  bool LoadStreamedPixelData(itk::ImageIOBase* imageIO, mitk::Image* image)
+  {
+    const auto slabThickness = PrepareStreamedReading(imageIO);
+
+    if (0 == slabThickness)
+      return false;
+
+    const auto numberOfTimeSteps = 4 == imageIO->GetNumberOfDimensions() ? imageIO->GetDimensions(3) : 1;
+    const auto volumeSizeInBytes = GetSliceSizeInBytes(imageIO) * imageIO->GetDimensions(2);
+
+    for (unsigned int t = 0; t < numberOfTimeSteps; ++t)
+    {
+      std::unique_ptr<unsigned char[]> buffer(new unsigned char[volumeSizeInBytes]);
+      ReadTimeStepStreamed(imageIO, t, slabThickness, buffer.get());
+
+      if (1 == numberOfTimeSteps)
+      {
+        image->SetImportChannel(buffer.release(), 0, mitk::Image::ManageMemory);
+      }
+      else
+      {
+        image->SetImportVolume(buffer.release(), t, 0, mitk::Image::ManageMemory);
+      }
+    }
+
+    imageIO->SetUseStreamedReading(false);
+    return true;
+  }
+
+  /** Time steps of files with directly accessible pixel data are read lazily from the file. All other
+   * time steps are read streamed and spilled to disk under the memory budget.*/
+  bool LoadPagedPixelData(itk::ImageIOBase* imageIO, const std::string& path, mitk::Image* image)
+  {
+    const auto numberOfDimensions = imageIO->GetNumberOfDimensions();
+
+    if (numberOfDimensions < 3 || numberOfDimensions > 4)
+      return false;
+
+    const auto offset = GetMemoryMappablePixelDataOffset(imageIO, path);
+    std::size_t slabThickness = 0;
+
+    if (!offset.has_value())
+    {
+      slabThickness = PrepareStreamedReading(imageIO);
+
+      if (0 == slabThickness)
+        return false;
+    }
+
+    const auto numberOfTimeSteps = 4 == numberOfDimensions ? imageIO->GetDimensions(3) : 1;
+    const auto volumeSizeInBytes = GetSliceSizeInBytes(imageIO) * imageIO->GetDimensions(2);
+
+    for (unsigned int t = 0; t < numberOfTimeSteps; ++t)
+    {
+      auto pagedMemory = std::make_shared<mitk::PagedMemory>(volumeSizeInBytes);
+
+      if (offset.has_value())
+      {
+        pagedMemory->SetSource(path, offset.value() + t * volumeSizeInBytes);
+      }
+      else
+      {
+        // pinned, so that the budget cannot evict the time step while it is filled
+        pagedMemory->Pin();
+
+        try
+        {
+          ReadTimeStepStreamed(imageIO, t, slabThickness, pagedMemory->GetData());
+        }
+        catch (...)
+        {
+          pagedMemory->Unpin();
+          throw;
+        }
+
+        pagedMemory->Unpin();
+      }
+
+      if (!image->SetPagedVolume(pagedMemory, t))
+      {
+        imageIO->SetUseStreamedReading(false);
+
+        // nothing was set yet, so the image can still be loaded differently
+        if (0 == t)
+          return false;
+
+        mitkThrow() << "Cannot set paged volume of time step " << t << ".";
+      }
+    }
+
+    imageIO->SetUseStreamedReading(false);
+    return true;
+  }
+}
 
 namespace mitk
 {
@@ -192,6 +585,7 @@ namespace mitk
     std::string description = std::string("ITK ") + imageIO->GetNameOfClass();
     this->SetReaderDescription(description);
     this->SetWriterDescription(description);
+    this->InitializeDefaultWriterOptions();
 
     this->RegisterService();
   }
@@ -214,6 +608,7 @@ namespace mitk
       this->AbstractFileWriter::SetRanking(rank);
     }
 
+    this->InitializeDefaultWriterOptions();
     this->RegisterService();
   }
 
@@ -237,7 +632,7 @@ namespace mitk
     return result;
   };
 
-  Image::Pointer ItkImageIO::LoadRawMitkImageFromImageIO(itk::ImageIOBase* imageIO, const std::string& path)
+  Image::Pointer ItkImageIO::LoadRawMitkImageFromImageIO(itk::ImageIOBase* imageIO, const std::string& path, LoadMode loadMode)
   {
     LocaleSwitch localeSwitch("C");
 
@@ -307,13 +702,45 @@ namespace mitk
     ioRegion.SetSize(ioSize);
     ioRegion.SetIndex(ioStart);
 
-    MITK_INFO << "ioRegion: " << ioRegion << std::endl;
+    MITK_DEBUG << "ioRegion: " << ioRegion << std::endl;
     imageIO->SetIORegion(ioRegion);
-    void* buffer = new unsigned char[imageIO->GetImageSizeInBytes()];
-    imageIO->Read(buffer);
 
     image->Initialize(MakePixelType(imageIO), ndim, dimensions);
-    image->SetImportChannel(buffer, 0, Image::ManageMemory);
+
+    // Files with more than four dimensions are read as a whole and reinterpreted as 4D image
+    if (imageIO->GetNumberOfDimensions() != ndim)
+      loadMode = LoadMode::Complete;
+
+    if (LoadMode::Paged == loadMode && !LoadPagedPixelData(imageIO, path, image))
+    {
+      MITK_INFO << "Pixel data cannot be paged. Falling back to complete loading.";
+      loadMode = LoadMode::Complete;
+    }
+
+    if (LoadMode::MemoryMapped == loadMode && !LoadMemoryMappedPixelData(imageIO, path, image))
+    {
+      MITK_INFO << "Pixel data cannot be memory mapped. Falling back to streamed loading.";
+      loadMode = LoadMode::Streamed;
+    }
+
+    if (LoadMode::Streamed == loadMode && !LoadStreamedPixelData(imageIO, image))
+    {
+      MITK_INFO << "Pixel data cannot be loaded streamed. Falling back to complete loading.";
+      loadMode = LoadMode::Complete;
+    }
+
+    if (LoadMode::Complete == loadMode)
+    {
+      imageIO->SetIORegion(ioRegion);
+      const auto size = static_cast<std::size_t>(imageIO->GetImageSizeInBytes());
+      void* buffer = new unsigned char[size];
+
+      // Files written with a parallel codec are inflated in parallel as well
+      if (std::string("NrrdImageIO") != imageIO->GetNameOfClass() || !NrrdCompression::Read(path, buffer, size))
+        imageIO->Read(buffer);
+
+      image->SetImportChannel(buffer, 0, Image::ManageMemory);
+    }
 
     const itk::MetaDataDictionary& dictionary = imageIO->GetMetaDataDictionary();
 
@@ -406,11 +833,25 @@ namespace mitk
 
     image->SetTimeGeometry(timeGeometry);
 
-    buffer = nullptr;
     MITK_INFO << "number of image components: " << image->GetPixelType().GetNumberOfComponents();
     return image;
   }
 
+  bool ItkImageIO::CanLoadMemoryMapped(itk::ImageIOBase* imageIO, const std::string& path)
+  {
+    return GetAlignedPixelDataOffset(imageIO, path).has_value();
+  }
+
+  void ItkImageIO::SetDefaultLoadMode(LoadMode loadMode)
+  {
+    DefaultLoadMode = loadMode;
+  }
+
+  ItkImageIO::LoadMode ItkImageIO::GetDefaultLoadMode()
+  {
+    return DefaultLoadMode;
+  }
+
   itk::MetaDataObjectBase::Pointer ConvertTimePointListToMetaDataObject(const mitk::TimeGeometry* timeGeometry)
   {
     std::stringstream stream;
@@ -526,7 +967,13 @@ namespace mitk
   {
     std::vector<BaseData::Pointer> result;
 
-    auto image = LoadRawMitkImageFromImageIO(this->m_ImageIO, this->GetLocalFileName());
+    auto loadMode = GetDefaultLoadMode();
+
+    // A local copy of a stream is temporary and therefore neither mapped nor used as source of paged memory
+    if ((LoadMode::MemoryMapped == loadMode || LoadMode::Paged == loadMode) && nullptr != this->GetInputStream())
+      loadMode = LoadMode::Streamed;
+
+    auto image = LoadRawMitkImageFromImageIO(this->m_ImageIO, this->GetLocalFileName(), loadMode);
 
     const itk::MetaDataDictionary& dictionary = this->m_ImageIO->GetMetaDataDictionary();
 
@@ -730,12 +1177,44 @@ namespace mitk
       itk::EncapsulateMetaData<std::string>(m_ImageIO->GetMetaDataDictionary(), PROPERTY_KEY_UID, image->GetUID());
 
       // use compression if available
-      m_ImageIO->UseCompressionOn();
-      m_ImageIO->SetFileName(path);
+      auto codec = NrrdCompression::Codec::Default;
+      auto level = NrrdCompression::Level::Balanced;
+      NrrdCompression::GetWriterOptions(this->GetWriterOptions(), codec, level);
+
+      // Writing in place would invalidate mappings of the file (including the one of the image that
+      // is written), so mapped files are replaced by a new file instead. Existing mappings keep
+      // the content of the replaced file.
+      const bool isMapped = MemoryMappedFile::IsMapped(path);
+      std::string writePath = path;
 
-      ImageReadAccessor imageAccess(image);
-      LocaleSwitch localeSwitch2("C");
-      m_ImageIO->Write(imageAccess.GetData());
+      if (isMapped)
+      {
+        auto directory = itksys::SystemTools::GetFilenamePath(path);
+        directory = directory.empty() ? "./" : directory + '/';
+        writePath = IOUtil::CreateTemporaryFile("XXXXXX-" + itksys::SystemTools::GetFilenameName(path), directory);
+      }
+
+      m_ImageIO->SetFileName(writePath);
+
+      try
+      {
+        ImageReadAccessor imageAccess(image);
+        LocaleSwitch localeSwitch2("C");
+        NrrdCompression::Write(m_ImageIO, imageAccess.GetData(), codec, level);
+      }
+      catch (...)
+      {
+        if (isMapped)
+          itksys::SystemTools::RemoveFile(writePath);
+
+        throw;
+      }
+
+      if (isMapped && !itksys::SystemTools::RenameFile(writePath, path))
+      {
+        itksys::SystemTools::RemoveFile(writePath);
+        mitkThrow() << "Cannot replace \"" << path << "\", which is memory mapped by a loaded image. Save the image to another file.";
+      }
     }
     catch (const std::exception &e)
     {
@@ -772,6 +1251,13 @@ namespace mitk
   }
 
   ItkImageIO *ItkImageIO::IOClone() const { return new ItkImageIO(*this); }
+
+  void ItkImageIO::InitializeDefaultWriterOptions()
+  {
+    if (std::string("NrrdImageIO") == m_ImageIO->GetNameOfClass())
+      this->SetDefaultWriterOptions(NrrdCompression::CreateWriterOptions(NrrdCompression::Codec::Parallel));
+  }
+
   void ItkImageIO::InitializeDefaultMetaDataKeys()
   {
     this->m_DefaultMetaDataKeys.push_back("NRRD.space");
@@ -15,8 +15,13 @@ found in the LICENSE file.
 #include "mitkLog.h"
 
 #include <clocale>
+#include <locale.h>
 #include <string>
 
+#ifdef __APPLE__
+#include <xlocale.h>
+#endif
+
 namespace mitk
 {
   struct LocaleSwitch::Impl
@@ -26,15 +31,30 @@ namespace mitk
     ~Impl();
 
   private:
+#ifdef _WIN32
+    /// per-thread locale setting of the thread at instantiation of object
+    int m_OldThreadLocaleSetting;
+
     /// locale at instantiation of object
     std::string m_OldLocale;
+#else
+    /// locale of the thread at instantiation of object
+    locale_t m_OldLocaleHandle;
+
+    /// thread locale during life-time of object
+    locale_t m_NewLocaleHandle;
+#endif
 
     /// locale during life-time of object
     const std::string m_NewLocale;
   };
 
+#ifdef _WIN32
   LocaleSwitch::Impl::Impl(const std::string &newLocale) : m_NewLocale(newLocale)
   {
+    // setlocale only affects the calling thread from now on
+    m_OldThreadLocaleSetting = _configthreadlocale(_ENABLE_PER_THREAD_LOCALE);
+
     // query and keep the current locale
     const char *currentLocale = std::setlocale(LC_ALL, nullptr);
     if (currentLocale != nullptr)
@@ -59,7 +79,36 @@ namespace mitk
     {
       MITK_INFO << "Could not reset original locale " << m_OldLocale;
     }
+
+    if (-1 != m_OldThreadLocaleSetting)
+      _configthreadlocale(m_OldThreadLocaleSetting);
+  }
+#else
+  LocaleSwitch::Impl::Impl(const std::string &newLocale)
+    : m_OldLocaleHandle(static_cast<locale_t>(0)), m_NewLocaleHandle(static_cast<locale_t>(0)), m_NewLocale(newLocale)
+  {
+    // install the new locale for the calling thread only; the global locale stays untouched
+    m_NewLocaleHandle = newlocale(LC_ALL_MASK, m_NewLocale.c_str(), static_cast<locale_t>(0));
+
+    if (static_cast<locale_t>(0) == m_NewLocaleHandle)
+    {
+      MITK_INFO << "Could not switch to locale " << m_NewLocale;
+      return;
+    }
+
+    m_OldLocaleHandle = uselocale(m_NewLocaleHandle);
+  }
+
+  LocaleSwitch::Impl::~Impl()
+  {
+    if (static_cast<locale_t>(0) == m_NewLocaleHandle)
+      return;
+
+    // the old locale may be LC_GLOBAL_LOCALE, which makes the thread use the global locale again
+    uselocale(m_OldLocaleHandle);
+    freelocale(m_NewLocaleHandle);
   }
+#endif
 
   LocaleSwitch::LocaleSwitch(const char *newLocale) : m_LocaleSwitchImpl(new Impl(newLocale)) {}
   LocaleSwitch::~LocaleSwitch() { delete m_LocaleSwitchImpl; }
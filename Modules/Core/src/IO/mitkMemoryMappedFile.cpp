@@ -0,0 +1,149 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include <mitkMemoryMappedFile.h>
+
+#include <mitkExceptionMacro.h>
+#include <mitkUtf8Util.h>
+
+#include <itksys/SystemTools.hxx>
+
+#include <mutex>
+#include <set>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+namespace
+{
+  std::size_t GetMappingGranularity()
+  {
+#ifdef _WIN32
+    SYSTEM_INFO systemInfo;
+    GetSystemInfo(&systemInfo);
+    return systemInfo.dwAllocationGranularity;
+#else
+    return static_cast<std::size_t>(sysconf(_SC_PAGESIZE));
+#endif
+  }
+
+  std::mutex& GetMappedPathsMutex()
+  {
+    static std::mutex mutex;
+    return mutex;
+  }
+
+  /** Real paths of all mapped files, once per mapping.*/
+  std::multiset<std::string>& GetMappedPaths()
+  {
+    static std::multiset<std::string> mappedPaths;
+    return mappedPaths;
+  }
+}
+
+mitk::MemoryMappedFile::MemoryMappedFile(const std::string& path, std::size_t offset, std::size_t length)
+  : m_Mapping(nullptr),
+    m_MappingSize(0),
+    m_DataOffset(0),
+    m_Size(length)
+{
+  if (0 == length)
+    mitkThrow() << "Cannot map zero bytes of \"" << path << "\".";
+
+  // Mappings have to start at a multiple of the page size (or allocation granularity on Windows)
+  const auto granularity = GetMappingGranularity();
+  const auto mappingOffset = offset - offset % granularity;
+
+  m_DataOffset = offset - mappingOffset;
+  m_MappingSize = m_DataOffset + length;
+
+#ifdef _WIN32
+  auto file = CreateFileA(Utf8Util::Utf8ToLocal8Bit(path).c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+
+  if (INVALID_HANDLE_VALUE == file)
+    mitkThrow() << "Cannot open \"" << path << "\" for memory mapping.";
+
+  auto fileMapping = CreateFileMappingA(file, nullptr, PAGE_WRITECOPY, 0, 0, nullptr);
+  CloseHandle(file);
+
+  if (nullptr == fileMapping)
+    mitkThrow() << "Cannot create file mapping of \"" << path << "\".";
+
+  const auto mappingOffset64 = static_cast<unsigned long long>(mappingOffset);
+  m_Mapping = MapViewOfFile(fileMapping, FILE_MAP_COPY, static_cast<DWORD>(mappingOffset64 >> 32), static_cast<DWORD>(mappingOffset64 & 0xFFFFFFFF), m_MappingSize);
+
+  // the view keeps the file mapping alive
+  CloseHandle(fileMapping);
+
+  if (nullptr == m_Mapping)
+    mitkThrow() << "Cannot map " << length << " bytes at offset " << offset << " of \"" << path << "\".";
+#else
+  const int file = open(path.c_str(), O_RDONLY);
+
+  if (-1 == file)
+    mitkThrow() << "Cannot open \"" << path << "\" for memory mapping.";
+
+  auto mapping = mmap(nullptr, m_MappingSize, PROT_READ | PROT_WRITE, MAP_PRIVATE, file, static_cast<off_t>(mappingOffset));
+
+  // the mapping keeps the file open
+  close(file);
+
+  if (MAP_FAILED == mapping)
+    mitkThrow() << "Cannot map " << length << " bytes at offset " << offset << " of \"" << path << "\".";
+
+  m_Mapping = mapping;
+#endif
+
+  m_Path = itksys::SystemTools::GetRealPath(path);
+
+  std::lock_guard<std::mutex> lock(GetMappedPathsMutex());
+  GetMappedPaths().insert(m_Path);
+}
+
+mitk::MemoryMappedFile::~MemoryMappedFile()
+{
+#ifdef _WIN32
+  UnmapViewOfFile(m_Mapping);
+#else
+  munmap(m_Mapping, m_MappingSize);
+#endif
+
+  std::lock_guard<std::mutex> lock(GetMappedPathsMutex());
+  auto& mappedPaths = GetMappedPaths();
+  auto it = mappedPaths.find(m_Path);
+
+  if (it != mappedPaths.end())
+    mappedPaths.erase(it);
+}
+
+void* mitk::MemoryMappedFile::GetData() const
+{
+  return static_cast<char*>(m_Mapping) + m_DataOffset;
+}
+
+std::size_t mitk::MemoryMappedFile::GetSize() const
+{
+  return m_Size;
+}
+
+bool mitk::MemoryMappedFile::IsMapped(const std::string& path)
+{
+  const auto realPath = itksys::SystemTools::GetRealPath(path);
+
+  std::lock_guard<std::mutex> lock(GetMappedPathsMutex());
+  return 0 != GetMappedPaths().count(realPath);
+}
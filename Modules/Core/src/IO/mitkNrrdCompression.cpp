@@ -0,0 +1,619 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include <mitkNrrdCompression.h>
+
+#include <mitkExceptionMacro.h>
+#include <mitkIOUtil.h>
+
+#include <itkByteSwapper.h>
+#include <itkMultiThreaderBase.h>
+#include <itk_zlib.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <sstream>
+
+namespace
+{
+  /** The block table is stored in a gzip extra subfield, whose length is limited to 65535 bytes.*/
+  constexpr std::size_t MaxNumberOfBlocks = 16000;
+  constexpr std::size_t MinBlockSize = 1024 * 1024;
+  constexpr std::size_t MaxBlockSize = 1024 * 1024 * 1024;
+
+  constexpr char SubfieldId[] = { 'M', 'K' };
+  constexpr unsigned char BlockTableVersion = 1;
+
+  const std::vector<mitk::NrrdCompression::Codec> Codecs = {
+    mitk::NrrdCompression::Codec::Default,
+    mitk::NrrdCompression::Codec::None,
+    mitk::NrrdCompression::Codec::Parallel,
+    mitk::NrrdCompression::Codec::ParallelRunLength };
+
+  const std::vector<mitk::NrrdCompression::Level> Levels = {
+    mitk::NrrdCompression::Level::Fast,
+    mitk::NrrdCompression::Level::Balanced,
+    mitk::NrrdCompression::Level::Small };
+
+  int GetZlibLevel(mitk::NrrdCompression::Level level)
+  {
+    switch (level)
+    {
+      case mitk::NrrdCompression::Level::Fast:
+        return 1;
+      case mitk::NrrdCompression::Level::Small:
+        return 9;
+      default:
+        return 6;
+    }
+  }
+
+  void AppendUInt16(std::vector<char>& data, std::uint16_t value)
+  {
+    data.push_back(static_cast<char>(value & 0xff));
+    data.push_back(static_cast<char>((value >> 8) & 0xff));
+  }
+
+  void AppendUInt32(std::vector<char>& data, std::uint32_t value)
+  {
+    for (int i = 0; i < 4; ++i)
+      data.push_back(static_cast<char>((value >> (8 * i)) & 0xff));
+  }
+
+  std::uint32_t ReadUInt(const char* data, int numberOfBytes)
+  {
+    std::uint32_t value = 0;
+
+    for (int i = 0; i < numberOfBytes; ++i)
+      value |= static_cast<std::uint32_t>(static_cast<unsigned char>(data[i])) << (8 * i);
+
+    return value;
+  }
+
+  std::size_t GetBlockSize(std::size_t size)
+  {
+    const auto blockSize = std::max(MinBlockSize, (size + MaxNumberOfBlocks - 1) / MaxNumberOfBlocks);
+
+    if (blockSize > MaxBlockSize)
+      mitkThrow() << "Cannot compress " << size << " bytes of pixel data in parallel.";
+
+    return blockSize;
+  }
+
+  std::size_t GetNumberOfBlocks(std::size_t size, std::size_t blockSize)
+  {
+    return std::max<std::size_t>(1, (size + blockSize - 1) / blockSize);
+  }
+
+  /** Deflates a block as raw deflate stream without history. All blocks but the last one end with a
+  sync flush instead of a final block, so that the concatenation of all blocks is a single stream.*/
+  bool CompressBlock(const unsigned char* data, std::size_t size, int level, int strategy, bool isLast, std::vector<char>& result)
+  {
+    z_stream stream = {};
+
+    if (Z_OK != deflateInit2(&stream, level, Z_DEFLATED, -15, 8, strategy))
+      return false;
+
+    // A sync flush appends an empty stored block, which is not covered by deflateBound()
+    result.resize(deflateBound(&stream, static_cast<uLong>(size)) + 16);
+
+    stream.next_in = const_cast<Bytef*>(data);
+    stream.avail_in = static_cast<uInt>(size);
+    stream.next_out = reinterpret_cast<Bytef*>(result.data());
+    stream.avail_out = static_cast<uInt>(result.size());
+
+    const auto ret = deflate(&stream, isLast ? Z_FINISH : Z_SYNC_FLUSH);
+    const bool success = isLast
+      ? Z_STREAM_END == ret
+      : Z_OK == ret && 0 == stream.avail_in && 0 != stream.avail_out;
+
+    result.resize(stream.total_out);
+    deflateEnd(&stream);
+
+    return success;
+  }
+
+  bool DecompressBlock(const char* data, std::size_t size, unsigned char* buffer, std::size_t bufferSize, bool isLast)
+  {
+    z_stream stream = {};
+
+    if (Z_OK != inflateInit2(&stream, -15))
+      return false;
+
+    stream.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(data));
+    stream.avail_in = static_cast<uInt>(size);
+    stream.next_out = buffer;
+    stream.avail_out = static_cast<uInt>(bufferSize);
+
+    const auto ret = inflate(&stream, Z_SYNC_FLUSH);
+    const bool success = 0 == stream.avail_out && (isLast ? Z_STREAM_END == ret : Z_OK == ret || Z_BUF_ERROR == ret);
+
+    inflateEnd(&stream);
+
+    return success;
+  }
+
+  std::string Trim(const std::string& str)
+  {
+    const auto first = str.find_first_not_of(" \t\r");
+
+    if (std::string::npos == first)
+      return std::string();
+
+    return str.substr(first, str.find_last_not_of(" \t\r") - first + 1);
+  }
+
+  std::string ToLower(std::string str)
+  {
+    std::transform(str.begin(), str.end(), str.begin(), [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+    return str;
+  }
+
+  /** Replaces the last sizes of the "sizes:" field of an NRRD header, the first size may belong to a component axis.*/
+  std::string PatchNrrdSizes(const std::string& header, const std::vector<itk::SizeValueType>& dimensions)
+  {
+    std::istringstream stream(header);
+    std::ostringstream result;
+    std::string line;
+    bool patched = false;
+
+    while (std::getline(stream, line))
+    {
+      if (!patched && 0 == ToLower(line).compare(0, 6, "sizes:"))
+      {
+        std::istringstream sizeStream(line.substr(6));
+        std::vector<std::string> sizes{ std::istream_iterator<std::string>(sizeStream), std::istream_iterator<std::string>() };
+
+        if (sizes.size() < dimensions.size())
+          mitkThrow() << "Unexpected NRRD header line \"" << line << "\".";
+
+        const auto offset = sizes.size() - dimensions.size();
+
+        for (std::size_t i = 0; i < dimensions.size(); ++i)
+          sizes[offset + i] = std::to_string(dimensions[i]);
+
+        line = "sizes:";
+
+        for (const auto& size : sizes)
+          line += ' ' + size;
+
+        patched = true;
+      }
+
+      result << line << '\n';
+    }
+
+    if (!patched)
+      mitkThrow() << "NRRD header without sizes field.";
+
+    return result.str();
+  }
+
+  /** Writes a single pixel with the imageIO to a temporary file, to get the complete NRRD header without
+  compressing the actual pixel data single-threaded. The image information of the imageIO is restored afterwards.*/
+  std::string CreateNrrdHeader(itk::ImageIOBase* imageIO)
+  {
+    const std::string path = imageIO->GetFileName();
+    const auto ioRegion = imageIO->GetIORegion();
+    const auto numberOfDimensions = imageIO->GetNumberOfDimensions();
+
+    std::vector<itk::SizeValueType> dimensions(numberOfDimensions);
+    itk::ImageIORegion pixelRegion(numberOfDimensions);
+
+    for (unsigned int i = 0; i < numberOfDimensions; ++i)
+    {
+      dimensions[i] = imageIO->GetDimensions(i);
+      imageIO->SetDimensions(i, 1);
+      pixelRegion.SetSize(i, 1);
+    }
+
+    std::ofstream tmpStream;
+    const auto tmpPath = mitk::IOUtil::CreateTemporaryFile(tmpStream, std::ios_base::binary, "XXXXXX.nrrd");
+    tmpStream.close();
+
+    auto restore = [&]() {
+      for (unsigned int i = 0; i < numberOfDimensions; ++i)
+        imageIO->SetDimensions(i, dimensions[i]);
+
+      imageIO->SetIORegion(ioRegion);
+      imageIO->SetFileName(path);
+      std::remove(tmpPath.c_str());
+    };
+
+    std::string content;
+
+    try
+    {
+      std::vector<char> pixel(imageIO->GetPixelSize());
+
+      imageIO->SetIORegion(pixelRegion);
+      imageIO->SetUseCompression(true);
+      imageIO->SetFileName(tmpPath);
+      imageIO->Write(pixel.data());
+
+      std::ifstream stream(tmpPath, std::ios::binary);
+      std::ostringstream contentStream;
+      contentStream << stream.rdbuf();
+      content = contentStream.str();
+    }
+    catch (...)
+    {
+      restore();
+      throw;
+    }
+
+    restore();
+
+    const auto headerEnd = content.find("\n\n");
+
+    if (0 != content.compare(0, 4, "NRRD") || std::string::npos == headerEnd)
+      mitkThrow() << "Cannot create NRRD header for \"" << path << "\".";
+
+    return PatchNrrdSizes(content.substr(0, headerEnd + 1), dimensions) + '\n';
+  }
+
+  /** Offset of the pixel data of an attached, gzip encoded NRRD file in native byte order.*/
+  std::size_t GetGzipPixelDataOffset(std::istream& stream)
+  {
+    std::string line;
+
+    if (!std::getline(stream, line) || 0 != line.compare(0, 4, "NRRD"))
+      return 0;
+
+    const std::string nativeEndian = itk::ByteSwapper<int>::SystemIsLittleEndian() ? "little" : "big";
+
+    bool isGzip = false;
+    bool isNativeEndian = true;
+
+    while (std::getline(stream, line))
+    {
+      if (Trim(line).empty())
+        return isGzip && isNativeEndian ? static_cast<std::size_t>(stream.tellg()) : 0;
+
+      if ('#' == line[0])
+        continue;
+
+      const auto pos = line.find(':');
+
+      if (std::string::npos == pos)
+        continue;
+
+      const auto key = ToLower(Trim(line.substr(0, pos)));
+      const auto value = ToLower(Trim(line.substr(pos + 1)));
+
+      if ("encoding" == key)
+      {
+        isGzip = "gzip" == value || "gz" == value;
+      }
+      else if ("endian" == key)
+      {
+        isNativeEndian = nativeEndian == value;
+      }
+      else if ("data file" == key || "datafile" == key)
+      {
+        return 0;
+      }
+      else if ("line skip" == key || "lineskip" == key || "byte skip" == key || "byteskip" == key)
+      {
+        if ("0" != value)
+          return 0;
+      }
+    }
+
+    return 0;
+  }
+}
+
+std::string mitk::NrrdCompression::OPTION_CODEC()
+{
+  return "Compression";
+}
+
+std::string mitk::NrrdCompression::OPTION_LEVEL()
+{
+  return "Compression level";
+}
+
+std::string mitk::NrrdCompression::GetCodecName(Codec codec)
+{
+  switch (codec)
+  {
+    case Codec::None:
+      return "none";
+    case Codec::Parallel:
+      return "gzip (multithreaded)";
+    case Codec::ParallelRunLength:
+      return "gzip (multithreaded, run-length)";
+    default:
+      return "gzip (single-threaded)";
+  }
+}
+
+std::string mitk::NrrdCompression::GetLevelName(Level level)
+{
+  switch (level)
+  {
+    case Level::Fast:
+      return "fast";
+    case Level::Small:
+      return "small";
+    default:
+      return "balanced";
+  }
+}
+
+mitk::IFileWriter::Options mitk::NrrdCompression::CreateWriterOptions(Codec defaultCodec, Level defaultLevel)
+{
+  std::vector<std::string> codecNames = { GetCodecName(defaultCodec) };
+
+  for (auto codec : Codecs)
+  {
+    if (codec != defaultCodec)
+      codecNames.push_back(GetCodecName(codec));
+  }
+
+  std::vector<std::string> levelNames = { GetLevelName(defaultLevel) };
+
+  for (auto level : Levels)
+  {
+    if (level != defaultLevel)
+      levelNames.push_back(GetLevelName(level));
+  }
+
+  IFileWriter::Options options;
+  options[OPTION_CODEC()] = codecNames;
+  options[OPTION_LEVEL()] = levelNames;
+
+  return options;
+}
+
+void mitk::NrrdCompression::GetWriterOptions(const IFileWriter::Options& options, Codec& codec, Level& level)
+{
+  // Options that were not chosen by the user still hold all choices, the first one is the default
+  auto getValue = [&options](const std::string& name) {
+    auto iter = options.find(name);
+
+    if (options.end() == iter)
+      return std::string();
+
+    if (iter->second.Type() == typeid(std::vector<std::string>))
+    {
+      const auto& choices = us::ref_any_cast<std::vector<std::string>>(iter->second);
+      return choices.empty() ? std::string() : choices.front();
+    }
+
+    return iter->second.ToString();
+  };
+
+  const auto codecName = getValue(OPTION_CODEC());
+
+  for (auto candidate : Codecs)
+  {
+    if (GetCodecName(candidate) == codecName)
+      codec = candidate;
+  }
+
+  const auto levelName = getValue(OPTION_LEVEL());
+
+  for (auto candidate : Levels)
+  {
+    if (GetLevelName(candidate) == levelName)
+      level = candidate;
+  }
+}
+
+void mitk::NrrdCompression::Write(itk::ImageIOBase* imageIO, const void* buffer, Codec codec, Level level)
+{
+  const std::string path = imageIO->GetFileName();
+  const bool isDetached = path.size() >= 5 && ".nhdr" == ToLower(path.substr(path.size() - 5));
+
+  if (Codec::Default == codec || Codec::None == codec || isDetached || std::string("NrrdImageIO") != imageIO->GetNameOfClass())
+  {
+    imageIO->SetUseCompression(Codec::None != codec);
+    imageIO->Write(buffer);
+    return;
+  }
+
+  const auto size = static_cast<std::size_t>(imageIO->GetImageSizeInBytes());
+  const auto header = CreateNrrdHeader(imageIO);
+  const auto member = Compress(buffer, size, GetZlibLevel(level), Codec::ParallelRunLength == codec);
+
+  std::ofstream stream(path, std::ios::binary | std::ios::trunc);
+  stream.write(header.data(), static_cast<std::streamsize>(header.size()));
+  stream.write(member.data(), static_cast<std::streamsize>(member.size()));
+  stream.close();
+
+  if (stream.fail())
+    mitkThrow() << "Cannot write \"" << path << "\".";
+}
+
+bool mitk::NrrdCompression::Read(const std::string& path, void* buffer, std::size_t size)
+{
+  std::ifstream stream(path, std::ios::binary);
+
+  if (!stream.is_open())
+    return false;
+
+  const auto offset = GetGzipPixelDataOffset(stream);
+
+  if (0 == offset)
+    return false;
+
+  // Reject regular gzip members before reading the whole file
+  char magic[4];
+
+  if (!stream.read(magic, 4) || '\x1f' != magic[0] || '\x8b' != magic[1] || 8 != magic[2] || 4 != magic[3])
+    return false;
+
+  stream.seekg(0, std::ios::end);
+  const auto memberSize = static_cast<std::size_t>(stream.tellg()) - offset;
+  stream.seekg(static_cast<std::streamoff>(offset));
+
+  std::vector<char> member(memberSize);
+
+  if (!stream.read(member.data(), static_cast<std::streamsize>(memberSize)))
+    return false;
+
+  return Decompress(member.data(), memberSize, buffer, size);
+}
+
+std::vector<char> mitk::NrrdCompression::Compress(const void* data, std::size_t size, int level, bool runLength)
+{
+  const auto blockSize = GetBlockSize(size);
+  const auto numberOfBlocks = GetNumberOfBlocks(size, blockSize);
+  const auto bytes = static_cast<const unsigned char*>(data);
+  const int strategy = runLength ? Z_RLE : Z_DEFAULT_STRATEGY;
+
+  std::vector<std::vector<char>> blocks(numberOfBlocks);
+  std::vector<uLong> checksums(numberOfBlocks);
+  std::atomic<bool> failed(false);
+
+  auto compressBlock = [&](itk::SizeValueType i) {
+    const auto begin = i * blockSize;
+    const auto length = std::min(blockSize, size - begin);
+
+    if (!CompressBlock(bytes + begin, length, level, strategy, numberOfBlocks - 1 == i, blocks[i]))
+      failed = true;
+
+    checksums[i] = crc32(crc32(0, Z_NULL, 0), bytes + begin, static_cast<uInt>(length));
+  };
+
+  itk::MultiThreaderBase::New()->ParallelizeArray(0, numberOfBlocks, compressBlock, nullptr);
+
+  if (failed)
+    mitkThrow() << "Cannot compress " << size << " bytes of pixel data.";
+
+  std::vector<char> extra;
+  extra.push_back(static_cast<char>(BlockTableVersion));
+  AppendUInt32(extra, static_cast<std::uint32_t>(blockSize));
+  AppendUInt32(extra, static_cast<std::uint32_t>(numberOfBlocks));
+
+  std::size_t compressedSize = 0;
+
+  for (const auto& block : blocks)
+  {
+    AppendUInt32(extra, static_cast<std::uint32_t>(block.size()));
+    compressedSize += block.size();
+  }
+
+  // gzip header with FEXTRA flag, no modification time and unknown OS
+  std::vector<char> member = { '\x1f', '\x8b', 8, 4, 0, 0, 0, 0, 0, '\xff' };
+  member.reserve(member.size() + 6 + extra.size() + compressedSize + 8);
+
+  AppendUInt16(member, static_cast<std::uint16_t>(4 + extra.size()));
+  member.insert(member.end(), SubfieldId, SubfieldId + 2);
+  AppendUInt16(member, static_cast<std::uint16_t>(extra.size()));
+  member.insert(member.end(), extra.begin(), extra.end());
+
+  uLong checksum = crc32(0, Z_NULL, 0);
+
+  for (std::size_t i = 0; i < numberOfBlocks; ++i)
+  {
+    member.insert(member.end(), blocks[i].begin(), blocks[i].end());
+    std::vector<char>().swap(blocks[i]);
+
+    const auto length = std::min(blockSize, size - i * blockSize);
+    checksum = crc32_combine(checksum, checksums[i], static_cast<z_off_t>(length));
+  }
+
+  AppendUInt32(member, static_cast<std::uint32_t>(checksum));
+  AppendUInt32(member, static_cast<std::uint32_t>(size & 0xffffffff));
+
+  return member;
+}
+
+bool mitk::NrrdCompression::Decompress(const char* member, std::size_t memberSize, void* buffer, std::size_t size)
+{
+  constexpr std::size_t HeaderSize = 10;
+  constexpr std::size_t TrailerSize = 8;
+
+  // Only the members written by Compress() have the FEXTRA flag set exclusively
+  if (memberSize < HeaderSize + 2 + TrailerSize || '\x1f' != member[0] || '\x8b' != member[1] || 8 != member[2] || 4 != member[3])
+    return false;
+
+  const auto extraSize = ReadUInt(member + HeaderSize, 2);
+  const auto dataOffset = HeaderSize + 2 + extraSize;
+
+  if (dataOffset + TrailerSize > memberSize)
+    return false;
+
+  const char* table = nullptr;
+  std::size_t tableSize = 0;
+
+  for (auto subfield = member + HeaderSize + 2; subfield + 4 <= member + dataOffset;)
+  {
+    const auto length = ReadUInt(subfield + 2, 2);
+
+    if (subfield + 4 + length > member + dataOffset)
+      return false;
+
+    if (SubfieldId[0] == subfield[0] && SubfieldId[1] == subfield[1])
+    {
+      table = subfield + 4;
+      tableSize = length;
+      break;
+    }
+
+    subfield += 4 + length;
+  }
+
+  if (nullptr == table || tableSize < 9 || BlockTableVersion != static_cast<unsigned char>(table[0]))
+    return false;
+
+  const std::size_t blockSize = ReadUInt(table + 1, 4);
+  const std::size_t numberOfBlocks = ReadUInt(table + 5, 4);
+
+  if (0 == blockSize || tableSize != 9 + 4 * numberOfBlocks || GetNumberOfBlocks(size, blockSize) != numberOfBlocks)
+    return false;
+
+  std::vector<std::size_t> offsets(numberOfBlocks + 1, dataOffset);
+
+  for (std::size_t i = 0; i < numberOfBlocks; ++i)
+    offsets[i + 1] = offsets[i] + ReadUInt(table + 9 + 4 * i, 4);
+
+  if (offsets.back() + TrailerSize != memberSize || ReadUInt(member + memberSize - 4, 4) != (size & 0xffffffff))
+    return false;
+
+  auto bytes = static_cast<unsigned char*>(buffer);
+  std::vector<uLong> checksums(numberOfBlocks);
+  std::atomic<bool> failed(false);
+
+  auto decompressBlock = [&](itk::SizeValueType i) {
+    const auto begin = i * blockSize;
+    const auto length = std::min(blockSize, size - begin);
+
+    if (!DecompressBlock(member + offsets[i], offsets[i + 1] - offsets[i], bytes + begin, length, numberOfBlocks - 1 == i))
+    {
+      failed = true;
+      return;
+    }
+
+    checksums[i] = crc32(crc32(0, Z_NULL, 0), bytes + begin, static_cast<uInt>(length));
+  };
+
+  itk::MultiThreaderBase::New()->ParallelizeArray(0, numberOfBlocks, decompressBlock, nullptr);
+
+  if (failed)
+    return false;
+
+  uLong checksum = crc32(0, Z_NULL, 0);
+
+  for (std::size_t i = 0; i < numberOfBlocks; ++i)
+    checksum = crc32_combine(checksum, checksums[i], static_cast<z_off_t>(std::min(blockSize, size - i * blockSize)));
+
+  return ReadUInt(member + memberSize - 8, 4) == static_cast<std::uint32_t>(checksum);
+}
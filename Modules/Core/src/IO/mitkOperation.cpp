@@ -24,4 +24,9 @@ mitk::OperationType mitk::Operation::GetOperationType()
 bool mitk::Operation::IsValid() const
 {
   return true;
+}
+
+std::size_t mitk::Operation::GetMemorySize() const
+{
+  return 0;
 }
\ No newline at end of file
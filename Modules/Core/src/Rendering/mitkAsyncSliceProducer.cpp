@@ -0,0 +1,373 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include <mitkAsyncSliceProducer.h>
+
+#include <mitkBaseRenderer.h>
+#include <mitkExceptionMacro.h>
+#include <mitkImageReadAccessor.h>
+#include <mitkRenderingManager.h>
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace
+{
+  using Clock = std::chrono::steady_clock;
+
+  std::mutex& GetLatencyMetricsMutex()
+  {
+    static std::mutex mutex;
+    return mutex;
+  }
+
+  std::map<const mitk::BaseRenderer*, mitk::AsyncSliceProducer::LatencyMetrics>& GetLatencyMetricsMap()
+  {
+    static std::map<const mitk::BaseRenderer*, mitk::AsyncSliceProducer::LatencyMetrics> latencyMetrics;
+    return latencyMetrics;
+  }
+
+  /** Only submissions create metrics. Other updates are ignored for renderers whose metrics were
+   * reset in the meantime, e.g. because the renderer was unregistered (see BaseRenderer::RemoveInstance()).*/
+  void UpdateLatencyMetrics(const mitk::BaseRenderer* renderer, const std::function<void(mitk::AsyncSliceProducer::LatencyMetrics&)>& update, bool isSubmission = false)
+  {
+    std::lock_guard<std::mutex> lock(GetLatencyMetricsMutex());
+    auto& latencyMetrics = GetLatencyMetricsMap();
+
+    if (isSubmission)
+    {
+      update(latencyMetrics[renderer]);
+      return;
+    }
+
+    auto it = latencyMetrics.find(renderer);
+
+    if (it != latencyMetrics.end())
+      update(it->second);
+  }
+}
+
+/** Worker threads shared by all producers. The extraction of a single slice is multithreaded
+ * itself (see ExtractSliceFilter2), so a few workers are sufficient to decouple the reslicing
+ * from the rendering thread.
+ *
+ * The pool is owned by the producers and stopped as soon as the last producer is destroyed,
+ * i.e. when the last mapper or renderer is gone and long before static objects like the
+ * RenderingManager are destroyed.*/
+class mitk::AsyncSliceProducer::WorkerPool
+{
+public:
+  static std::shared_ptr<WorkerPool> GetInstance()
+  {
+    static std::mutex mutex;
+    static std::weak_ptr<WorkerPool> instance;
+
+    std::lock_guard<std::mutex> lock(mutex);
+    auto pool = instance.lock();
+
+    if (nullptr == pool)
+    {
+      pool.reset(new WorkerPool);
+      instance = pool;
+    }
+
+    return pool;
+  }
+
+  ~WorkerPool()
+  {
+    {
+      std::lock_guard<std::mutex> lock(m_Mutex);
+      m_Stop = true;
+    }
+
+    m_Condition.notify_all();
+
+    for (auto& thread : m_Threads)
+      thread.join();
+  }
+
+  void Post(std::function<void()> task)
+  {
+    {
+      std::lock_guard<std::mutex> lock(m_Mutex);
+      m_Tasks.push_back(std::move(task));
+    }
+
+    m_Condition.notify_one();
+  }
+
+private:
+  WorkerPool()
+    : m_Stop(false)
+  {
+    const auto numberOfThreads = std::clamp(std::thread::hardware_concurrency() / 2, 2u, 4u);
+
+    for (unsigned int i = 0; i < numberOfThreads; ++i)
+      m_Threads.emplace_back([this]() { this->Run(); });
+  }
+
+  void Run()
+  {
+    while (true)
+    {
+      std::function<void()> task;
+
+      {
+        std::unique_lock<std::mutex> lock(m_Mutex);
+        m_Condition.wait(lock, [this]() { return m_Stop || !m_Tasks.empty(); });
+
+        // all producers are gone, so outstanding slices are of no interest anymore
+        if (m_Stop)
+          return;
+
+        task = std::move(m_Tasks.front());
+        m_Tasks.pop_front();
+      }
+
+      task();
+    }
+  }
+
+  std::mutex m_Mutex;
+  std::condition_variable m_Condition;
+  std::deque<std::function<void()>> m_Tasks;
+  std::vector<std::thread> m_Threads;
+  bool m_Stop;
+};
+
+struct mitk::AsyncSliceProducer::State
+{
+  std::mutex mutex;
+
+  /** Latest request that was not started yet.*/
+  ExtractSliceFilter::Pointer pendingReslicer;
+  /** Finished filter of the latest request.*/
+  ExtractSliceFilter::Pointer result;
+
+  /** Incremented with every submission and cancellation. Results of older generations are discarded.*/
+  std::size_t generation = 0;
+  /** A request was submitted but neither delivered nor cancelled yet.*/
+  bool isOutstanding = false;
+  /** A task of this producer is queued or running in the worker pool.*/
+  bool isScheduled = false;
+
+  Clock::time_point submissionTime;
+  const BaseRenderer* renderer = nullptr;
+  vtkRenderWindow* renderWindow = nullptr;
+
+  /** Runs on a worker thread until no pending request is left.*/
+  static void Process(const std::shared_ptr<State>& state);
+};
+
+void mitk::AsyncSliceProducer::State::Process(const std::shared_ptr<State>& state)
+{
+  while (true)
+  {
+    ExtractSliceFilter::Pointer reslicer;
+    std::size_t generation;
+
+    {
+      std::lock_guard<std::mutex> lock(state->mutex);
+
+      if (state->pendingReslicer.IsNull())
+      {
+        state->isScheduled = false;
+        return;
+      }
+
+      reslicer = state->pendingReslicer;
+      state->pendingReslicer = nullptr;
+      generation = state->generation;
+    }
+
+    bool succeeded = true;
+
+    try
+    {
+      // The input is shared with the rendering thread and tools, so writers have to wait until the
+      // slice is extracted.
+      ImageReadAccessor inputAccessor(reslicer->GetInput());
+
+      // The reslicer is a vtk-mitk-vtk pipeline, so it has to be updated explicitly (see ImageVtkMapper2D)
+      reslicer->Modified();
+      reslicer->UpdateLargestPossibleRegion();
+    }
+    catch (const std::exception& e)
+    {
+      MITK_ERROR << "Asynchronous slice extraction failed: " << e.what();
+      succeeded = false;
+    }
+
+    vtkRenderWindow* renderWindow = nullptr;
+
+    {
+      std::lock_guard<std::mutex> lock(state->mutex);
+
+      // the request was superseded or cancelled in the meantime
+      if (generation != state->generation)
+        continue;
+
+      if (!succeeded)
+      {
+        state->isOutstanding = false;
+        continue;
+      }
+
+      state->result = reslicer;
+      renderWindow = state->renderWindow;
+    }
+
+    if (nullptr != renderWindow)
+      RenderingManager::GetInstance()->RequestUpdateFromWorkerThread(renderWindow);
+  }
+}
+
+mitk::AsyncSliceProducer::AsyncSliceProducer()
+  : m_WorkerPool(WorkerPool::GetInstance()),
+    m_State(std::make_shared<State>())
+{
+}
+
+mitk::AsyncSliceProducer::~AsyncSliceProducer()
+{
+  // A running task keeps the state alive and discards its result
+  this->Cancel();
+}
+
+void mitk::AsyncSliceProducer::Submit(ExtractSliceFilter* reslicer, const BaseRenderer* renderer)
+{
+  if (nullptr == reslicer)
+    mitkThrow() << "Cannot submit slice request without reslicer.";
+
+  bool isSuperseding = false;
+  bool isScheduled = false;
+
+  {
+    std::lock_guard<std::mutex> lock(m_State->mutex);
+
+    isSuperseding = m_State->isOutstanding;
+
+    ++m_State->generation;
+    m_State->pendingReslicer = reslicer;
+    m_State->result = nullptr;
+    m_State->isOutstanding = true;
+    m_State->submissionTime = Clock::now();
+    m_State->renderer = renderer;
+    m_State->renderWindow = nullptr != renderer ? renderer->GetRenderWindow() : nullptr;
+
+    isScheduled = m_State->isScheduled;
+    m_State->isScheduled = true;
+  }
+
+  UpdateLatencyMetrics(renderer, [isSuperseding](LatencyMetrics& metrics) {
+    ++metrics.numberOfSubmittedSlices;
+
+    if (isSuperseding)
+      ++metrics.numberOfCancelledSlices;
+  }, true);
+
+  // A task that is already scheduled picks up the new request when it is done with the current one
+  if (!isScheduled)
+  {
+    auto state = m_State;
+    m_WorkerPool->Post([state]() { State::Process(state); });
+  }
+}
+
+bool mitk::AsyncSliceProducer::IsResultAvailable() const
+{
+  std::lock_guard<std::mutex> lock(m_State->mutex);
+  return m_State->result.IsNotNull();
+}
+
+bool mitk::AsyncSliceProducer::IsBusy() const
+{
+  std::lock_guard<std::mutex> lock(m_State->mutex);
+  return m_State->isOutstanding;
+}
+
+mitk::ExtractSliceFilter::Pointer mitk::AsyncSliceProducer::TakeResult()
+{
+  ExtractSliceFilter::Pointer result;
+  const BaseRenderer* renderer = nullptr;
+  double latency = 0.0;
+
+  {
+    std::lock_guard<std::mutex> lock(m_State->mutex);
+
+    if (m_State->result.IsNull())
+      return nullptr;
+
+    result = m_State->result;
+    m_State->result = nullptr;
+    m_State->isOutstanding = false;
+
+    renderer = m_State->renderer;
+    latency = std::chrono::duration<double, std::milli>(Clock::now() - m_State->submissionTime).count();
+  }
+
+  UpdateLatencyMetrics(renderer, [latency](LatencyMetrics& metrics) {
+    ++metrics.numberOfDeliveredSlices;
+    metrics.lastLatency = latency;
+    metrics.meanLatency += (latency - metrics.meanLatency) / metrics.numberOfDeliveredSlices;
+    metrics.maximumLatency = std::max(metrics.maximumLatency, latency);
+  });
+
+  return result;
+}
+
+void mitk::AsyncSliceProducer::Cancel()
+{
+  bool wasOutstanding = false;
+  const BaseRenderer* renderer = nullptr;
+
+  {
+    std::lock_guard<std::mutex> lock(m_State->mutex);
+
+    wasOutstanding = m_State->isOutstanding;
+    renderer = m_State->renderer;
+
+    ++m_State->generation;
+    m_State->pendingReslicer = nullptr;
+    m_State->result = nullptr;
+    m_State->isOutstanding = false;
+  }
+
+  if (wasOutstanding)
+    UpdateLatencyMetrics(renderer, [](LatencyMetrics& metrics) { ++metrics.numberOfCancelledSlices; });
+}
+
+mitk::AsyncSliceProducer::LatencyMetrics mitk::AsyncSliceProducer::GetLatencyMetrics(const BaseRenderer* renderer)
+{
+  std::lock_guard<std::mutex> lock(GetLatencyMetricsMutex());
+
+  const auto& latencyMetrics = GetLatencyMetricsMap();
+  auto it = latencyMetrics.find(renderer);
+
+  return it != latencyMetrics.end()
+    ? it->second
+    : LatencyMetrics();
+}
+
+void mitk::AsyncSliceProducer::ResetLatencyMetrics(const BaseRenderer* renderer)
+{
+  std::lock_guard<std::mutex> lock(GetLatencyMetricsMutex());
+  GetLatencyMetricsMap().erase(renderer);
+}
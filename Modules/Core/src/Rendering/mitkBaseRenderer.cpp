@@ -11,6 +11,7 @@ found in the LICENSE file.
 ============================================================================*/
 
 #include "mitkBaseRenderer.h"
+#include "mitkAsyncSliceProducer.h"
 #include "mitkBaseRendererHelper.h"
 
 #include "mitkMapper.h"
@@ -65,7 +66,10 @@ void mitk::BaseRenderer::RemoveInstance(vtkRenderWindow *renWin)
 {
   auto mapit = baseRendererMap.find(renWin);
   if (mapit != baseRendererMap.end())
+  {
+    mitk::AsyncSliceProducer::ResetLatencyMetrics(mapit->second);
     baseRendererMap.erase(mapit);
+  }
 }
 
 mitk::BaseRenderer *mitk::BaseRenderer::GetByName(const std::string &name)
@@ -229,6 +233,7 @@ mitk::BaseRenderer::~BaseRenderer()
   mitk::VtkLayerController::RemoveInstance(m_RenderWindow);
 
   RemoveAllLocalStorages();
+  AsyncSliceProducer::ResetLatencyMetrics(this);
 
   m_DataStorage = nullptr;
 
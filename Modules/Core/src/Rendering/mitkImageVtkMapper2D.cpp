@@ -159,6 +159,7 @@ vtkProp *mitk::ImageVtkMapper2D::GetVtkProp(mitk::BaseRenderer *renderer)
 void mitk::ImageVtkMapper2D::GenerateDataForRenderer(mitk::BaseRenderer *renderer)
 {
   LocalStorage *localStorage = m_LSH.GetLocalStorage(renderer);
+  const bool isSliceShown = localStorage->m_PublicActors == localStorage->m_Actors.Get() && nullptr != localStorage->m_ReslicedImage;
 
   auto *image = const_cast<mitk::Image *>(this->GetInput());
   mitk::DataNode *datanode = this->GetDataNode();
@@ -188,19 +189,72 @@ void mitk::ImageVtkMapper2D::GenerateDataForRenderer(mitk::BaseRenderer *rendere
     return;
   }
 
+  // Thickslicing
+  int thickSlicesMode = 0;
+  int thickSlicesNum = 1;
+  // Thick slices parameters
+  if (image->GetPixelType().GetNumberOfComponents() == 1) // for now only single component are allowed
+  {
+    DataNode *dn = renderer->GetCurrentWorldPlaneGeometryNode();
+    if (dn)
+    {
+      ResliceMethodProperty *resliceMethodEnumProperty = nullptr;
+
+      if (dn->GetProperty(resliceMethodEnumProperty, "reslice.thickslices", renderer) && resliceMethodEnumProperty)
+        thickSlicesMode = resliceMethodEnumProperty->GetValueAsId();
+
+      IntProperty *intProperty = nullptr;
+      if (dn->GetProperty(intProperty, "reslice.thickslices.num", renderer) && intProperty)
+      {
+        thickSlicesNum = intProperty->GetValue();
+        if (thickSlicesNum < 1)
+          thickSlicesNum = 1;
+      }
+    }
+    else
+    {
+      MITK_WARN << "no associated widget plane data tree node found";
+    }
+  }
+
+  // With asynchronous reslicing, a new reslicer extracts the slice on a worker thread while the last
+  // slice stays visible until the new one is delivered (see Update()). Thick slices and the very first
+  // slice are always extracted synchronously.
+  bool asynchronousReslicing = false;
+  datanode->GetBoolProperty("asynchronous reslicing", asynchronousReslicing, renderer);
+  asynchronousReslicing = asynchronousReslicing && 0 == thickSlicesMode && isSliceShown;
+
+  ExtractSliceFilter::Pointer reslicer = localStorage->m_Reslicer;
+  PlaneGeometry::ConstPointer sliceGeometry = worldGeometry;
+  BaseGeometry::ConstPointer imageGeometry = image->GetTimeGeometry()->GetGeometryForTimeStep(this->GetTimestep());
+
+  if (asynchronousReslicing)
+  {
+    // the geometries may be modified on the rendering thread while the worker extracts the slice
+    reslicer = ExtractSliceFilter::New();
+    sliceGeometry = worldGeometry->Clone();
+    imageGeometry = imageGeometry->Clone();
+
+    // make sure that the vtkImageData of the input is not created concurrently by the worker
+    image->GetVtkImageData(this->GetTimestep());
+  }
+  else
+  {
+    localStorage->m_SliceProducer.Cancel();
+  }
+
   // set main input for ExtractSliceFilter
-  localStorage->m_Reslicer->SetInput(image);
-  localStorage->m_Reslicer->SetWorldGeometry(worldGeometry);
-  localStorage->m_Reslicer->SetTimeStep(this->GetTimestep());
+  reslicer->SetInput(image);
+  reslicer->SetWorldGeometry(sliceGeometry);
+  reslicer->SetTimeStep(this->GetTimestep());
 
   // set the transformation of the image to adapt reslice axis
-  localStorage->m_Reslicer->SetResliceTransformByGeometry(
-    image->GetTimeGeometry()->GetGeometryForTimeStep(this->GetTimestep()));
+  reslicer->SetResliceTransformByGeometry(imageGeometry);
 
   // is the geometry of the slice based on the input image or the worldgeometry?
   bool inPlaneResampleExtentByGeometry = false;
   datanode->GetBoolProperty("in plane resample extent by geometry", inPlaneResampleExtentByGeometry, renderer);
-  localStorage->m_Reslicer->SetInPlaneResampleExtentByGeometry(inPlaneResampleExtentByGeometry);
+  reslicer->SetInPlaneResampleExtentByGeometry(inPlaneResampleExtentByGeometry);
 
   // Initialize the interpolation mode for resampling; switch to nearest
   // neighbor if the input image is too small.
@@ -218,52 +272,29 @@ void mitk::ImageVtkMapper2D::GenerateDataForRenderer(mitk::BaseRenderer *rendere
     switch (interpolationMode)
     {
       case VTK_RESLICE_NEAREST:
-        localStorage->m_Reslicer->SetInterpolationMode(ExtractSliceFilter::RESLICE_NEAREST);
+        reslicer->SetInterpolationMode(ExtractSliceFilter::RESLICE_NEAREST);
         break;
       case VTK_RESLICE_LINEAR:
-        localStorage->m_Reslicer->SetInterpolationMode(ExtractSliceFilter::RESLICE_LINEAR);
+        reslicer->SetInterpolationMode(ExtractSliceFilter::RESLICE_LINEAR);
         break;
       case VTK_RESLICE_CUBIC:
-        localStorage->m_Reslicer->SetInterpolationMode(ExtractSliceFilter::RESLICE_CUBIC);
+        reslicer->SetInterpolationMode(ExtractSliceFilter::RESLICE_CUBIC);
         break;
     }
   }
   else
   {
-    localStorage->m_Reslicer->SetInterpolationMode(ExtractSliceFilter::RESLICE_NEAREST);
+    reslicer->SetInterpolationMode(ExtractSliceFilter::RESLICE_NEAREST);
   }
 
   // set the vtk output property to true, makes sure that no unneeded mitk image conversion
   // is done.
-  localStorage->m_Reslicer->SetVtkOutputRequest(true);
+  reslicer->SetVtkOutputRequest(true);
 
-  // Thickslicing
-  int thickSlicesMode = 0;
-  int thickSlicesNum = 1;
-  // Thick slices parameters
-  if (image->GetPixelType().GetNumberOfComponents() == 1) // for now only single component are allowed
-  {
-    DataNode *dn = renderer->GetCurrentWorldPlaneGeometryNode();
-    if (dn)
-    {
-      ResliceMethodProperty *resliceMethodEnumProperty = nullptr;
-
-      if (dn->GetProperty(resliceMethodEnumProperty, "reslice.thickslices", renderer) && resliceMethodEnumProperty)
-        thickSlicesMode = resliceMethodEnumProperty->GetValueAsId();
-
-      IntProperty *intProperty = nullptr;
-      if (dn->GetProperty(intProperty, "reslice.thickslices.num", renderer) && intProperty)
-      {
-        thickSlicesNum = intProperty->GetValue();
-        if (thickSlicesNum < 1)
-          thickSlicesNum = 1;
-      }
-    }
-    else
-    {
-      MITK_WARN << "no associated widget plane data tree node found";
-    }
-  }
+  // reslice with the multithreaded ExtractSliceFilter2 unless it is disabled for the node
+  bool multithreadedReslicing = true;
+  datanode->GetBoolProperty("multithreaded reslicing", multithreadedReslicing, renderer);
+  reslicer->SetUseExtractSliceFilter2(multithreadedReslicing);
 
   const auto *planeGeometry = dynamic_cast<const PlaneGeometry *>(worldGeometry);
 
@@ -292,19 +323,19 @@ void mitk::ImageVtkMapper2D::GenerateDataForRenderer(mitk::BaseRenderer *rendere
 
     dataZSpacing = 1.0 / normInIndex.GetNorm();
 
-    localStorage->m_Reslicer->SetOutputDimensionality(3);
-    localStorage->m_Reslicer->SetOutputSpacingZDirection(dataZSpacing);
-    localStorage->m_Reslicer->SetOutputExtentZDirection(-thickSlicesNum, 0 + thickSlicesNum);
+    reslicer->SetOutputDimensionality(3);
+    reslicer->SetOutputSpacingZDirection(dataZSpacing);
+    reslicer->SetOutputExtentZDirection(-thickSlicesNum, 0 + thickSlicesNum);
 
     // Do the reslicing. Modified() is called to make sure that the reslicer is
     // executed even though the input geometry information did not change; this
     // is necessary when the input /em data, but not the /em geometry changes.
     localStorage->m_TSFilter->SetThickSliceMode(thickSlicesMode - 1);
-    localStorage->m_TSFilter->SetInputData(localStorage->m_Reslicer->GetVtkOutput());
+    localStorage->m_TSFilter->SetInputData(reslicer->GetVtkOutput());
 
     // vtkFilter=>mitkFilter=>vtkFilter update mechanism will fail without calling manually
-    localStorage->m_Reslicer->Modified();
-    localStorage->m_Reslicer->Update();
+    reslicer->Modified();
+    reslicer->Update();
 
     localStorage->m_TSFilter->Modified();
     localStorage->m_TSFilter->Update();
@@ -313,16 +344,32 @@ void mitk::ImageVtkMapper2D::GenerateDataForRenderer(mitk::BaseRenderer *rendere
   else
   {
     // this is needed when thick mode was enable before. These variable have to be reset to default values
-    localStorage->m_Reslicer->SetOutputDimensionality(2);
-    localStorage->m_Reslicer->SetOutputSpacingZDirection(1.0);
-    localStorage->m_Reslicer->SetOutputExtentZDirection(0, 0);
+    reslicer->SetOutputDimensionality(2);
+    reslicer->SetOutputSpacingZDirection(1.0);
+    reslicer->SetOutputExtentZDirection(0, 0);
 
-    localStorage->m_Reslicer->Modified();
+    if (asynchronousReslicing)
+    {
+      localStorage->m_SliceProducer.Submit(reslicer, renderer);
+      return;
+    }
+
+    reslicer->Modified();
     // start the pipeline with updating the largest possible, needed if the geometry of the input has changed
-    localStorage->m_Reslicer->UpdateLargestPossibleRegion();
-    localStorage->m_ReslicedImage = localStorage->m_Reslicer->GetVtkOutput();
+    reslicer->UpdateLargestPossibleRegion();
+    localStorage->m_ReslicedImage = reslicer->GetVtkOutput();
   }
 
+  this->ApplySlice(renderer);
+}
+
+void mitk::ImageVtkMapper2D::ApplySlice(mitk::BaseRenderer *renderer)
+{
+  LocalStorage *localStorage = m_LSH.GetLocalStorage(renderer);
+  const auto *image = this->GetInput();
+  mitk::DataNode *datanode = this->GetDataNode();
+  const auto *planeGeometry = localStorage->m_Reslicer->GetWorldGeometry();
+
   // Bounds information for reslicing (only required if reference geometry
   // is present)
   // this used for generating a vtkPLaneSource with the right size
@@ -664,6 +711,7 @@ void mitk::ImageVtkMapper2D::ApplyColorTransferFunction(mitk::BaseRenderer *rend
 void mitk::ImageVtkMapper2D::SetToInvalidState(mitk::ImageVtkMapper2D::LocalStorage* localStorage)
 {
   localStorage->m_PublicActors = localStorage->m_EmptyActors.Get();
+  localStorage->m_SliceProducer.Cancel();
   // set image to nullptr, to clear the texture in 3D, because
   // the latest image is used there if the plane is out of the geometry
   // see bug-13275
@@ -715,6 +763,13 @@ void mitk::ImageVtkMapper2D::Update(mitk::BaseRenderer *renderer)
   {
     this->GenerateDataForRenderer(renderer);
   }
+  else if (localStorage->m_SliceProducer.IsResultAvailable())
+  {
+    // a slice that was requested asynchronously is finished
+    localStorage->m_Reslicer = localStorage->m_SliceProducer.TakeResult();
+    localStorage->m_ReslicedImage = localStorage->m_Reslicer->GetVtkOutput();
+    this->ApplySlice(renderer);
+  }
 
   // since we have checked that nothing important has changed, we can set
   // m_LastUpdateTime to the current time
@@ -47,7 +47,7 @@ bool mitk::VtkMapper::IsVtkBased() const
 void mitk::VtkMapper::MitkRenderOverlay(BaseRenderer *renderer)
 {
   bool visible = true;
-  GetDataNode()->GetVisibility(visible, renderer, "visible");
+  GetDataNode()->GetVisibility(visible, renderer, PropertyKeyAtom::Visible());
   if (!visible)
     return;
 
@@ -61,7 +61,7 @@ void mitk::VtkMapper::MitkRenderOpaqueGeometry(BaseRenderer *renderer)
 {
   bool visible = true;
 
-  GetDataNode()->GetVisibility(visible, renderer, "visible");
+  GetDataNode()->GetVisibility(visible, renderer, PropertyKeyAtom::Visible());
   if (!visible)
     return;
 
@@ -74,7 +74,7 @@ void mitk::VtkMapper::MitkRenderOpaqueGeometry(BaseRenderer *renderer)
 void mitk::VtkMapper::MitkRenderTranslucentGeometry(BaseRenderer *renderer)
 {
   bool visible = true;
-  GetDataNode()->GetVisibility(visible, renderer, "visible");
+  GetDataNode()->GetVisibility(visible, renderer, PropertyKeyAtom::Visible());
   if (!visible)
     return;
 
@@ -87,7 +87,7 @@ void mitk::VtkMapper::MitkRenderTranslucentGeometry(BaseRenderer *renderer)
 void mitk::VtkMapper::MitkRenderVolumetricGeometry(BaseRenderer *renderer)
 {
   bool visible = true;
-  GetDataNode()->GetVisibility(visible, renderer, "visible");
+  GetDataNode()->GetVisibility(visible, renderer, PropertyKeyAtom::Visible());
   if (!visible)
     return;
 
@@ -120,9 +120,9 @@ void mitk::VtkMapper::ApplyColorAndOpacityProperties(BaseRenderer *renderer, vtk
   DataNode *node = GetDataNode();
 
   // check for color prop and use it for rendering if it exists
-  node->GetColor(rgba, renderer, "color");
+  node->GetColor(rgba, renderer, PropertyKeyAtom::Color());
   // check for opacity prop and use it for rendering if it exists
-  node->GetOpacity(rgba[3], renderer, "opacity");
+  node->GetOpacity(rgba[3], renderer, PropertyKeyAtom::Opacity());
 
   double drgba[4] = {rgba[0], rgba[1], rgba[2], rgba[3]};
   actor->GetProperty()->SetColor(drgba);
@@ -241,7 +241,7 @@ void mitk::VtkPropRenderer::PrepareMapperQueue()
       continue;
 
     bool visible = true;
-    node->GetVisibility(visible, this, "visible");
+    node->GetVisibility(visible, this, PropertyKeyAtom::Visible());
 
     // The information about LOD-enabled mappers is required by RenderingManager
     if (mapper->IsLODEnabled(this) && visible)
@@ -250,7 +250,7 @@ void mitk::VtkPropRenderer::PrepareMapperQueue()
     }
     // mapper without a layer property get layer number 1
     int layer = 1;
-    node->GetIntProperty("layer", layer, this);
+    node->GetIntProperty(PropertyKeyAtom::Layer(), layer, this);
     int nr = (layer << 16) + mapperNo;
     m_MappersMap.insert(std::pair<int, Mapper *>(nr, mapper));
     mapperNo++;
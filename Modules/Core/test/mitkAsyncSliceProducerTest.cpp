@@ -0,0 +1,202 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+// Testing
+#include <mitkTestFixture.h>
+#include <mitkTestingMacros.h>
+
+// MITK includes
+#include <mitkAsyncSliceProducer.h>
+#include <mitkImageCast.h>
+#include <mitkImageWriteAccessor.h>
+
+#include <itkImage.h>
+#include <itkImageRegionIterator.h>
+
+#include <vtkImageData.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <thread>
+
+class mitkAsyncSliceProducerTestSuite : public mitk::TestFixture
+{
+  CPPUNIT_TEST_SUITE(mitkAsyncSliceProducerTestSuite);
+  MITK_TEST(AsynchronousSliceEqualsSynchronousSlice);
+  MITK_TEST(NewerRequestSupersedesOlderOne);
+  MITK_TEST(CancelDropsResult);
+  MITK_TEST(WriterBlocksExtraction);
+  MITK_TEST(ResetLatencyMetricsIsNotUndoneByCancel);
+  CPPUNIT_TEST_SUITE_END();
+
+private:
+  mitk::Image::Pointer m_Image;
+
+  mitk::ExtractSliceFilter::Pointer CreateReslicer(mitk::ScalarType zPosition) const
+  {
+    auto plane = mitk::PlaneGeometry::New();
+    plane->InitializeStandardPlane(m_Image->GetGeometry(), mitk::AnatomicalPlane::Axial, zPosition, true, false);
+
+    auto reslicer = mitk::ExtractSliceFilter::New();
+    reslicer->SetInput(m_Image);
+    reslicer->SetWorldGeometry(plane);
+    reslicer->SetResliceTransformByGeometry(m_Image->GetGeometry());
+    reslicer->SetVtkOutputRequest(true);
+
+    return reslicer;
+  }
+
+  /** Polls the producer like the rendering loop would do.*/
+  static mitk::ExtractSliceFilter::Pointer WaitForResult(mitk::AsyncSliceProducer& producer)
+  {
+    const auto timeout = std::chrono::steady_clock::now() + std::chrono::seconds(30);
+
+    while (!producer.IsResultAvailable() && std::chrono::steady_clock::now() < timeout)
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+
+    return producer.TakeResult();
+  }
+
+  static bool AreEqual(vtkImageData* expected, vtkImageData* actual)
+  {
+    int expectedDimensions[3];
+    int actualDimensions[3];
+    expected->GetDimensions(expectedDimensions);
+    actual->GetDimensions(actualDimensions);
+
+    if (!std::equal(expectedDimensions, expectedDimensions + 3, actualDimensions))
+      return false;
+
+    const auto numberOfBytes = static_cast<std::size_t>(expected->GetNumberOfPoints()) * expected->GetScalarSize();
+    return 0 == std::memcmp(expected->GetScalarPointer(), actual->GetScalarPointer(), numberOfBytes);
+  }
+
+public:
+  void setUp() override
+  {
+    using ImageType = itk::Image<short, 3>;
+
+    ImageType::SizeType size = {{ 64, 48, 32 }};
+
+    auto image = ImageType::New();
+    image->SetRegions(ImageType::RegionType(size));
+    image->Allocate();
+
+    for (itk::ImageRegionIterator<ImageType> it(image, image->GetLargestPossibleRegion()); !it.IsAtEnd(); ++it)
+    {
+      const auto index = it.GetIndex();
+      it.Set(static_cast<short>(index[0] + 100 * index[1] - 50 * index[2]));
+    }
+
+    mitk::CastToMitkImage(image, m_Image);
+
+    mitk::AsyncSliceProducer::ResetLatencyMetrics(nullptr);
+  }
+
+  void tearDown() override
+  {
+    m_Image = nullptr;
+  }
+
+  void AsynchronousSliceEqualsSynchronousSlice()
+  {
+    auto expectedReslicer = this->CreateReslicer(7);
+    expectedReslicer->Update();
+
+    mitk::AsyncSliceProducer producer;
+    producer.Submit(this->CreateReslicer(7), nullptr);
+
+    auto reslicer = WaitForResult(producer);
+    CPPUNIT_ASSERT(reslicer.IsNotNull());
+    CPPUNIT_ASSERT(!producer.IsBusy());
+    CPPUNIT_ASSERT(AreEqual(expectedReslicer->GetVtkOutput(), reslicer->GetVtkOutput()));
+
+    auto metrics = mitk::AsyncSliceProducer::GetLatencyMetrics(nullptr);
+    CPPUNIT_ASSERT_EQUAL(std::size_t(1), metrics.numberOfSubmittedSlices);
+    CPPUNIT_ASSERT_EQUAL(std::size_t(1), metrics.numberOfDeliveredSlices);
+    CPPUNIT_ASSERT(metrics.lastLatency >= 0.0);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(metrics.lastLatency, metrics.maximumLatency, mitk::eps);
+  }
+
+  void NewerRequestSupersedesOlderOne()
+  {
+    auto expectedReslicer = this->CreateReslicer(20);
+    expectedReslicer->Update();
+
+    mitk::AsyncSliceProducer producer;
+    producer.Submit(this->CreateReslicer(3), nullptr);
+    producer.Submit(this->CreateReslicer(11), nullptr);
+    producer.Submit(this->CreateReslicer(20), nullptr);
+
+    // only the slice of the latest request is delivered
+    auto reslicer = WaitForResult(producer);
+    CPPUNIT_ASSERT(reslicer.IsNotNull());
+    CPPUNIT_ASSERT(AreEqual(expectedReslicer->GetVtkOutput(), reslicer->GetVtkOutput()));
+
+    auto metrics = mitk::AsyncSliceProducer::GetLatencyMetrics(nullptr);
+    CPPUNIT_ASSERT_EQUAL(std::size_t(3), metrics.numberOfSubmittedSlices);
+    CPPUNIT_ASSERT_EQUAL(std::size_t(2), metrics.numberOfCancelledSlices);
+    CPPUNIT_ASSERT_EQUAL(std::size_t(1), metrics.numberOfDeliveredSlices);
+  }
+
+  void CancelDropsResult()
+  {
+    mitk::AsyncSliceProducer producer;
+    producer.Submit(this->CreateReslicer(5), nullptr);
+    producer.Cancel();
+
+    CPPUNIT_ASSERT(!producer.IsBusy());
+
+    // give a possibly running task the chance to finish, its result must be discarded
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    CPPUNIT_ASSERT(!producer.IsResultAvailable());
+    CPPUNIT_ASSERT(producer.TakeResult().IsNull());
+
+    auto metrics = mitk::AsyncSliceProducer::GetLatencyMetrics(nullptr);
+    CPPUNIT_ASSERT_EQUAL(std::size_t(1), metrics.numberOfCancelledSlices);
+    CPPUNIT_ASSERT_EQUAL(std::size_t(0), metrics.numberOfDeliveredSlices);
+  }
+
+  void WriterBlocksExtraction()
+  {
+    mitk::AsyncSliceProducer producer;
+
+    {
+      mitk::ImageWriteAccessor writeAccessor(m_Image);
+      producer.Submit(this->CreateReslicer(5), nullptr);
+
+      // the worker must not read the image while it is written
+      std::this_thread::sleep_for(std::chrono::milliseconds(100));
+      CPPUNIT_ASSERT(!producer.IsResultAvailable());
+      CPPUNIT_ASSERT(producer.IsBusy());
+    }
+
+    CPPUNIT_ASSERT(WaitForResult(producer).IsNotNull());
+  }
+
+  void ResetLatencyMetricsIsNotUndoneByCancel()
+  {
+    mitk::AsyncSliceProducer producer;
+    producer.Submit(this->CreateReslicer(5), nullptr);
+
+    // emulates unregistering the renderer while its mapper still has an outstanding request
+    mitk::AsyncSliceProducer::ResetLatencyMetrics(nullptr);
+    producer.Cancel();
+
+    auto metrics = mitk::AsyncSliceProducer::GetLatencyMetrics(nullptr);
+    CPPUNIT_ASSERT_EQUAL(std::size_t(0), metrics.numberOfSubmittedSlices);
+    CPPUNIT_ASSERT_EQUAL(std::size_t(0), metrics.numberOfCancelledSlices);
+  }
+};
+
+MITK_TEST_SUITE_REGISTRATION(mitkAsyncSliceProducer)
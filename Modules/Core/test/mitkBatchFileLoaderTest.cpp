@@ -0,0 +1,330 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include <mitkTestFixture.h>
+#include <mitkTestingMacros.h>
+
+#include <mitkAbstractFileReader.h>
+#include <mitkBatchFileLoader.h>
+#include <mitkCustomMimeType.h>
+#include <mitkIOMimeTypes.h>
+#include <mitkIOUtil.h>
+#include <mitkImageGenerator.h>
+#include <mitkStandaloneDataStorage.h>
+
+#include <itksys/SystemTools.hxx>
+#include <usModuleContext.h>
+
+#include <atomic>
+#include <clocale>
+#include <fstream>
+#include <memory>
+
+namespace
+{
+  /** Reads all files of a series from any of its files, like a DICOM reader, and counts the decoded series.*/
+  class SeriesFileReader : public mitk::AbstractFileReader
+  {
+  public:
+    SeriesFileReader() : AbstractFileReader(mitk::CustomMimeType("BatchFileLoaderTestSeries"), "Test series reader")
+    {
+      m_ServiceRegistration = this->RegisterService();
+    }
+
+    using AbstractFileReader::Read;
+
+    std::vector<itk::SmartPointer<mitk::BaseData>> DoRead() override
+    {
+      ++s_NumberOfDecodedSeries;
+      m_ReadFiles = s_SeriesFiles;
+
+      // Slow enough that the workers of the other files start while the series is decoded
+      itksys::SystemTools::Delay(50);
+
+      std::vector<itk::SmartPointer<mitk::BaseData>> result;
+      result.push_back(mitk::ImageGenerator::GenerateRandomImage<float>(4, 4, 4).GetPointer());
+      return result;
+    }
+
+    static std::atomic<unsigned int> s_NumberOfDecodedSeries;
+    static std::vector<std::string> s_SeriesFiles;
+
+  private:
+    SeriesFileReader(const SeriesFileReader &other) : AbstractFileReader(other) {}
+
+    SeriesFileReader *Clone() const override { return new SeriesFileReader(*this); }
+
+    us::ServiceRegistration<mitk::IFileReader> m_ServiceRegistration;
+  };
+
+  std::atomic<unsigned int> SeriesFileReader::s_NumberOfDecodedSeries(0);
+  std::vector<std::string> SeriesFileReader::s_SeriesFiles;
+}
+
+class mitkBatchFileLoaderTestSuite : public mitk::TestFixture
+{
+  CPPUNIT_TEST_SUITE(mitkBatchFileLoaderTestSuite);
+  MITK_TEST(WaitAndAddAll_AddsNodesInOrderOfPaths);
+  MITK_TEST(WaitAndAddAll_MemoryLimitSmallerThanFiles_LoadsAllFiles);
+  MITK_TEST(AddCompleted_Polling_ReportsProgressInOrder);
+  MITK_TEST(WaitAndAddAll_MissingFile_ReportsErrorAndLoadsRemainingFiles);
+  MITK_TEST(LoadConcurrently_MissingFile_Throws);
+  MITK_TEST(WaitAndAddAll_SeriesFiles_DecodesSeriesOnce);
+  MITK_TEST(LoadConcurrently_GermanLocale_ReadsGeometryCorrectly);
+  CPPUNIT_TEST_SUITE_END();
+
+private:
+  std::string m_TempDirectory;
+  std::vector<std::string> m_Paths;
+
+  void CheckOrder(const mitk::DataStorage::SetOfObjects *nodes, const std::vector<std::string> &paths)
+  {
+    CPPUNIT_ASSERT_EQUAL(paths.size(), static_cast<std::size_t>(nodes->Size()));
+
+    for (std::size_t i = 0; i < paths.size(); ++i)
+    {
+      std::string path;
+      nodes->ElementAt(i)->GetData()->GetPropertyList()->GetStringProperty("path", path);
+      CPPUNIT_ASSERT_EQUAL(paths[i], path);
+    }
+  }
+
+  /** Empty file with the preamble of a DICOM file.*/
+  static void WriteSeriesFile(const std::string &path)
+  {
+    std::ofstream file(path, std::ios::binary);
+    file << std::string(128, '\0') << "DICM" << std::string(124, '\0');
+  }
+
+public:
+  void setUp() override
+  {
+    m_TempDirectory = mitk::IOUtil::CreateTemporaryDirectory("mitkBatchFileLoaderTest_XXXXXX");
+    m_Paths.clear();
+
+    // Different sizes, so files finish decoding in a different order than they were started
+    for (unsigned int i = 0; i < 8; ++i)
+    {
+      const unsigned int size = (i % 2 == 0) ? 64 : 8;
+      auto image = mitk::ImageGenerator::GenerateRandomImage<float>(size, size, size);
+      m_Paths.push_back(m_TempDirectory + "/image" + std::to_string(i) + ".nrrd");
+      mitk::IOUtil::Save(image, m_Paths.back());
+    }
+  }
+
+  void tearDown() override
+  {
+    itksys::SystemTools::RemoveADirectory(m_TempDirectory);
+  }
+
+  void WaitAndAddAll_AddsNodesInOrderOfPaths()
+  {
+    for (unsigned int numberOfThreads : { 1u, 4u })
+    {
+      auto storage = mitk::StandaloneDataStorage::New();
+
+      mitk::BatchFileLoader loader(m_Paths);
+      loader.SetNumberOfThreads(numberOfThreads);
+      auto nodes = loader.WaitAndAddAll(*storage);
+
+      CPPUNIT_ASSERT(loader.IsFinished());
+      CPPUNIT_ASSERT(loader.GetErrors().empty());
+      CPPUNIT_ASSERT_EQUAL(m_Paths.size(), static_cast<std::size_t>(storage->GetAll()->Size()));
+      CheckOrder(nodes, m_Paths);
+    }
+  }
+
+  void WaitAndAddAll_MemoryLimitSmallerThanFiles_LoadsAllFiles()
+  {
+    auto storage = mitk::StandaloneDataStorage::New();
+
+    mitk::BatchFileLoader loader(m_Paths);
+    loader.SetNumberOfThreads(4);
+    loader.SetMemoryLimit(1024);
+    auto nodes = loader.WaitAndAddAll(*storage);
+
+    CPPUNIT_ASSERT(loader.GetErrors().empty());
+    CheckOrder(nodes, m_Paths);
+  }
+
+  void AddCompleted_Polling_ReportsProgressInOrder()
+  {
+    auto storage = mitk::StandaloneDataStorage::New();
+    std::vector<std::size_t> reportedIndices;
+
+    mitk::BatchFileLoader loader(m_Paths);
+    loader.SetNumberOfThreads(4);
+    loader.SetProgressCallback([&](const mitk::BatchFileLoader::Progress &progress) {
+      CPPUNIT_ASSERT(progress.m_Error.empty());
+      CPPUNIT_ASSERT_EQUAL(m_Paths.size(), progress.m_NumberOfFiles);
+      CPPUNIT_ASSERT_EQUAL(progress.m_Index + 1, progress.m_NumberOfProcessedFiles);
+      reportedIndices.push_back(progress.m_Index);
+    });
+
+    CPPUNIT_ASSERT_EQUAL(0u, loader.AddCompleted(*storage)->Size());
+
+    loader.Start();
+    CPPUNIT_ASSERT_THROW(loader.Start(), mitk::Exception);
+
+    auto nodes = mitk::DataStorage::SetOfObjects::New();
+    while (!loader.IsFinished())
+    {
+      auto addedNodes = loader.AddCompleted(*storage);
+      for (auto iter = addedNodes->Begin(); iter != addedNodes->End(); ++iter)
+        nodes->push_back(iter->Value());
+      itksys::SystemTools::Delay(1);
+    }
+
+    CheckOrder(nodes, m_Paths);
+    CPPUNIT_ASSERT_EQUAL(m_Paths.size(), reportedIndices.size());
+    for (std::size_t i = 0; i < reportedIndices.size(); ++i)
+      CPPUNIT_ASSERT_EQUAL(i, reportedIndices[i]);
+  }
+
+  void WaitAndAddAll_MissingFile_ReportsErrorAndLoadsRemainingFiles()
+  {
+    auto paths = m_Paths;
+    paths.insert(paths.begin() + 2, m_TempDirectory + "/doesNotExist.nrrd");
+
+    auto storage = mitk::StandaloneDataStorage::New();
+    std::string reportedError;
+
+    mitk::BatchFileLoader loader(paths);
+    loader.SetProgressCallback([&](const mitk::BatchFileLoader::Progress &progress) {
+      if (progress.m_Index == 2)
+        reportedError = progress.m_Error;
+    });
+    auto nodes = loader.WaitAndAddAll(*storage);
+
+    CPPUNIT_ASSERT_EQUAL(std::size_t(1), loader.GetErrors().size());
+    CPPUNIT_ASSERT(!reportedError.empty());
+    CheckOrder(nodes, m_Paths);
+  }
+
+  void LoadConcurrently_MissingFile_Throws()
+  {
+    auto paths = m_Paths;
+    paths.push_back(m_TempDirectory + "/doesNotExist.nrrd");
+
+    auto storage = mitk::StandaloneDataStorage::New();
+    CPPUNIT_ASSERT_THROW(mitk::IOUtil::LoadConcurrently(paths, *storage, 2), mitk::Exception);
+    CPPUNIT_ASSERT_EQUAL(m_Paths.size(), static_cast<std::size_t>(storage->GetAll()->Size()));
+
+    auto otherStorage = mitk::StandaloneDataStorage::New();
+    CheckOrder(mitk::IOUtil::LoadConcurrently(m_Paths, *otherStorage), m_Paths);
+  }
+
+  void WaitAndAddAll_SeriesFiles_DecodesSeriesOnce()
+  {
+    mitk::CustomMimeType mimeType("BatchFileLoaderTestSeries");
+    mimeType.AddExtension("batchseries");
+    mimeType.SetCategory(mitk::IOMimeTypes::CATEGORY_IMAGES());
+    mimeType.SetComment("Test series");
+
+    us::ServiceProperties props;
+    props[us::ServiceConstants::SERVICE_RANKING()] = 100;
+    auto mimeTypeRegistration = us::GetModuleContext()->RegisterService(&mimeType, props);
+    auto reader = std::make_unique<SeriesFileReader>();
+
+    SeriesFileReader::s_NumberOfDecodedSeries = 0;
+    SeriesFileReader::s_SeriesFiles.clear();
+    for (unsigned int i = 0; i < 6; ++i)
+    {
+      SeriesFileReader::s_SeriesFiles.push_back(m_TempDirectory + "/slice" + std::to_string(i) + ".batchseries");
+      WriteSeriesFile(SeriesFileReader::s_SeriesFiles.back());
+    }
+
+    auto paths = SeriesFileReader::s_SeriesFiles;
+    paths.push_back(m_Paths.front());
+
+    auto storage = mitk::StandaloneDataStorage::New();
+    std::size_t numberOfReports = 0;
+
+    mitk::BatchFileLoader loader(paths);
+    loader.SetNumberOfThreads(4);
+    loader.SetProgressCallback([&](const mitk::BatchFileLoader::Progress &progress) {
+      CPPUNIT_ASSERT(progress.m_Error.empty());
+      ++numberOfReports;
+    });
+    auto nodes = loader.WaitAndAddAll(*storage);
+
+    reader->UnregisterService();
+    mimeTypeRegistration.Unregister();
+
+    // The remaining files of the series are skipped instead of being decoded again
+    CPPUNIT_ASSERT_EQUAL(1u, SeriesFileReader::s_NumberOfDecodedSeries.load());
+    CPPUNIT_ASSERT(loader.GetErrors().empty());
+    CPPUNIT_ASSERT_EQUAL(paths.size(), numberOfReports);
+    CheckOrder(nodes, { paths.front(), paths.back() });
+  }
+
+  void LoadConcurrently_GermanLocale_ReadsGeometryCorrectly()
+  {
+    // Fractional spacings and origins are misparsed if a reader sees a locale with a decimal comma
+    std::vector<std::string> paths;
+    for (unsigned int i = 0; i < 8; ++i)
+    {
+      auto image = mitk::ImageGenerator::GenerateRandomImage<float>(16, 16, 16, 1, 0.25 * (i + 1), 0.5, 1.5);
+      mitk::Point3D origin;
+      origin[0] = 10.25 * i;
+      origin[1] = -3.75;
+      origin[2] = 0.5;
+      image->SetOrigin(origin);
+      paths.push_back(m_TempDirectory + "/geometry" + std::to_string(i) + ".nrrd");
+      mitk::IOUtil::Save(image, paths.back());
+    }
+
+    const std::string originalLocale = std::setlocale(LC_ALL, nullptr);
+    std::string germanLocale;
+    for (const auto *locale : { "de_DE.UTF-8", "de_DE.utf8", "de_DE", "de_DE@euro", "German_Germany" })
+    {
+      if (nullptr != std::setlocale(LC_ALL, locale))
+      {
+        germanLocale = std::setlocale(LC_ALL, nullptr);
+        break;
+      }
+    }
+
+    if (germanLocale.empty())
+      MITK_TEST_OUTPUT(<< "Warning: No German locale was found on the system. Loading with the current locale.");
+
+    mitk::DataStorage::SetOfObjects::Pointer nodes;
+    auto storage = mitk::StandaloneDataStorage::New();
+    CPPUNIT_ASSERT_NO_THROW(nodes = mitk::IOUtil::LoadConcurrently(paths, *storage, 4));
+
+    // The readers switch the locale of their own thread only
+    const std::string localeAfterLoading = std::setlocale(LC_ALL, nullptr);
+    std::setlocale(LC_ALL, originalLocale.c_str());
+
+    if (!germanLocale.empty())
+      CPPUNIT_ASSERT_EQUAL(germanLocale, localeAfterLoading);
+
+    CPPUNIT_ASSERT_EQUAL(paths.size(), static_cast<std::size_t>(nodes->Size()));
+    for (unsigned int i = 0; i < paths.size(); ++i)
+    {
+      auto image = dynamic_cast<mitk::Image *>(nodes->ElementAt(i)->GetData());
+      CPPUNIT_ASSERT(nullptr != image);
+
+      const auto spacing = image->GetGeometry()->GetSpacing();
+      CPPUNIT_ASSERT_DOUBLES_EQUAL(0.25 * (i + 1), spacing[0], mitk::eps);
+      CPPUNIT_ASSERT_DOUBLES_EQUAL(0.5, spacing[1], mitk::eps);
+      CPPUNIT_ASSERT_DOUBLES_EQUAL(1.5, spacing[2], mitk::eps);
+
+      const auto origin = image->GetGeometry()->GetOrigin();
+      CPPUNIT_ASSERT_DOUBLES_EQUAL(10.25 * i, origin[0], mitk::eps);
+      CPPUNIT_ASSERT_DOUBLES_EQUAL(-3.75, origin[1], mitk::eps);
+      CPPUNIT_ASSERT_DOUBLES_EQUAL(0.5, origin[2], mitk::eps);
+    }
+  }
+};
+
+MITK_TEST_SUITE_REGISTRATION(mitkBatchFileLoader)
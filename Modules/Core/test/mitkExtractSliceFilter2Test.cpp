@@ -0,0 +1,198 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+// Testing
+#include <mitkTestFixture.h>
+#include <mitkTestingMacros.h>
+
+// MITK includes
+#include <mitkExtractSliceFilter2.h>
+#include <mitkImageCast.h>
+#include <mitkImagePixelReadAccessor.h>
+
+#include <itkImage.h>
+#include <itkImageRegionIterator.h>
+#include <itkLinearInterpolateImageFunction.h>
+#include <itkNearestNeighborInterpolateImageFunction.h>
+
+#include <limits>
+
+class mitkExtractSliceFilter2TestSuite : public mitk::TestFixture
+{
+  CPPUNIT_TEST_SUITE(mitkExtractSliceFilter2TestSuite);
+  MITK_TEST(NearestNeighborMatchesITK);
+  MITK_TEST(LinearMatchesITK);
+  MITK_TEST(LinearAtLowerBorderMatchesITK);
+  CPPUNIT_TEST_SUITE_END();
+
+  using ImageType = itk::Image<float, 3>;
+
+private:
+  ImageType::Pointer m_ItkImage;
+  mitk::Image::Pointer m_Image;
+  mitk::PlaneGeometry::Pointer m_Plane;
+
+  /** Reslices m_Image along m_Plane and compares every output pixel to the value of the ITK interpolator.*/
+  template <class TInterpolateImageFunction>
+  void CheckAgainstITK(mitk::ExtractSliceFilter2::Interpolator interpolator)
+  {
+    auto filter = mitk::ExtractSliceFilter2::New();
+    filter->SetInput(m_Image);
+    filter->SetOutputGeometry(m_Plane);
+    filter->SetInterpolator(interpolator);
+    filter->Update();
+
+    auto interpolateImageFunction = TInterpolateImageFunction::New();
+    interpolateImageFunction->SetInputImage(m_ItkImage);
+
+    mitk::Image::Pointer slice = filter->GetOutput();
+    mitk::ImagePixelReadAccessor<float, 2> accessor(slice);
+
+    const auto width = static_cast<itk::IndexValueType>(slice->GetDimension(0));
+    const auto height = static_cast<itk::IndexValueType>(slice->GetDimension(1));
+    std::size_t numberOfInsidePixels = 0;
+
+    for (itk::IndexValueType y = 0; y < height; ++y)
+    {
+      for (itk::IndexValueType x = 0; x < width; ++x)
+      {
+        mitk::Point3D index;
+        index[0] = x;
+        index[1] = y;
+        index[2] = 0;
+
+        mitk::Point3D world;
+        m_Plane->IndexToWorld(index, world);
+
+        ImageType::PointType point;
+        point.CastFrom(world);
+        const auto continuousIndex = m_ItkImage->TransformPhysicalPointToContinuousIndex<double>(point);
+
+        float expected = std::numeric_limits<float>::lowest();
+
+        if (interpolateImageFunction->IsInsideBuffer(continuousIndex))
+        {
+          expected = static_cast<float>(interpolateImageFunction->EvaluateAtContinuousIndex(continuousIndex));
+          ++numberOfInsidePixels;
+        }
+
+        CPPUNIT_ASSERT_DOUBLES_EQUAL(expected, accessor.GetPixelByIndex({{ x, y }}), 1e-3);
+      }
+    }
+
+    // the plane has to cut the image, otherwise the test is meaningless
+    CPPUNIT_ASSERT(numberOfInsidePixels > 0);
+    CPPUNIT_ASSERT(numberOfInsidePixels < static_cast<std::size_t>(width * height));
+  }
+
+public:
+  void setUp() override
+  {
+    ImageType::SizeType size = {{ 40, 30, 20 }};
+    ImageType::SpacingType spacing;
+    spacing[0] = 1.0;
+    spacing[1] = 0.8;
+    spacing[2] = 2.5;
+    ImageType::PointType origin;
+    origin[0] = -3.0;
+    origin[1] = 2.0;
+    origin[2] = 1.0;
+
+    m_ItkImage = ImageType::New();
+    m_ItkImage->SetRegions(ImageType::RegionType(size));
+    m_ItkImage->SetSpacing(spacing);
+    m_ItkImage->SetOrigin(origin);
+    m_ItkImage->Allocate();
+
+    for (itk::ImageRegionIterator<ImageType> it(m_ItkImage, m_ItkImage->GetLargestPossibleRegion()); !it.IsAtEnd(); ++it)
+    {
+      const auto index = it.GetIndex();
+      it.Set(static_cast<float>(index[0] * index[1] % 17 + 3 * index[2] - 0.5 * index[0]));
+    }
+
+    mitk::CastToMitkImage(m_ItkImage, m_Image);
+
+    // oblique plane that is larger than the image, so that some of its pixels are outside
+    mitk::Vector3D right;
+    right[0] = 1.0;
+    right[1] = 0.3;
+    right[2] = 0.2;
+    mitk::Vector3D bottom;
+    bottom[0] = -0.25;
+    bottom[1] = 1.0;
+    bottom[2] = 0.4;
+    bottom -= right * ((right * bottom) / right.GetSquaredNorm());
+
+    mitk::Vector3D planeSpacing;
+    planeSpacing[0] = 0.7;
+    planeSpacing[1] = 0.9;
+    planeSpacing[2] = 1.0;
+
+    m_Plane = mitk::PlaneGeometry::New();
+    m_Plane->InitializeStandardPlane(80, 70, right, bottom, &planeSpacing);
+
+    mitk::Point3D planeOrigin;
+    planeOrigin[0] = -10.3;
+    planeOrigin[1] = -5.1;
+    planeOrigin[2] = 3.7;
+    m_Plane->SetOrigin(planeOrigin);
+    m_Plane->ImageGeometryOn();
+  }
+
+  void tearDown() override
+  {
+    m_Plane = nullptr;
+    m_Image = nullptr;
+    m_ItkImage = nullptr;
+  }
+
+  void NearestNeighborMatchesITK()
+  {
+    this->CheckAgainstITK<itk::NearestNeighborInterpolateImageFunction<ImageType>>(mitk::ExtractSliceFilter2::NearestNeighbor);
+  }
+
+  void LinearMatchesITK()
+  {
+    this->CheckAgainstITK<itk::LinearInterpolateImageFunction<ImageType>>(mitk::ExtractSliceFilter2::Linear);
+  }
+
+  void LinearAtLowerBorderMatchesITK()
+  {
+    // axial plane shifted by a quarter voxel below the first column, so that the first
+    // output column samples continuous indices in [-0.5, 0)
+    mitk::Vector3D right;
+    right.Fill(0.0);
+    right[0] = 1.0;
+    mitk::Vector3D bottom;
+    bottom.Fill(0.0);
+    bottom[1] = 1.0;
+
+    mitk::Vector3D planeSpacing;
+    planeSpacing[0] = 1.0;
+    planeSpacing[1] = 0.8;
+    planeSpacing[2] = 1.0;
+
+    m_Plane = mitk::PlaneGeometry::New();
+    m_Plane->InitializeStandardPlane(41, 30, right, bottom, &planeSpacing);
+
+    mitk::Point3D planeOrigin;
+    planeOrigin[0] = -3.25;
+    planeOrigin[1] = 2.0;
+    planeOrigin[2] = 6.0;
+    m_Plane->SetOrigin(planeOrigin);
+    m_Plane->ImageGeometryOn();
+
+    this->CheckAgainstITK<itk::LinearInterpolateImageFunction<ImageType>>(mitk::ExtractSliceFilter2::Linear);
+  }
+};
+
+MITK_TEST_SUITE_REGISTRATION(mitkExtractSliceFilter2)
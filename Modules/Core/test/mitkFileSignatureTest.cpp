@@ -0,0 +1,122 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include <mitkTestFixture.h>
+#include <mitkTestingMacros.h>
+
+#include <mitkFileSignature.h>
+#include <mitkIOUtil.h>
+
+#include <itksys/SystemTools.hxx>
+
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+
+class mitkFileSignatureTestSuite : public mitk::TestFixture
+{
+  CPPUNIT_TEST_SUITE(mitkFileSignatureTestSuite);
+  MITK_TEST(DetectFormat_KnownMagicBytes_ReturnsFormat);
+  MITK_TEST(DetectFormat_UnknownOrShortHeader_ReturnsUnknown);
+  MITK_TEST(Get_TestDataFile_ReturnsNrrd);
+  MITK_TEST(Get_Directory_ReturnsInvalidSignature);
+  MITK_TEST(Get_ModifiedFile_InvalidatesCache);
+  CPPUNIT_TEST_SUITE_END();
+
+private:
+  std::string m_TempDirectory;
+
+  static std::string CreateNiftiHeader(const char *magic)
+  {
+    std::string header(348, '\0');
+    const std::int32_t sizeOfHeader = 348;
+    std::memcpy(&header[0], &sizeOfHeader, sizeof(sizeOfHeader));
+    header.replace(344, 4, magic, 4);
+    return header;
+  }
+
+  void WriteFile(const std::string &path, const std::string &content)
+  {
+    std::ofstream stream(path, std::ios::binary | std::ios::trunc);
+    stream << content;
+  }
+
+public:
+  void setUp() override
+  {
+    m_TempDirectory = mitk::IOUtil::CreateTemporaryDirectory("mitkFileSignatureTest_XXXXXX");
+    mitk::FileSignature::ClearCache();
+  }
+
+  void tearDown() override
+  {
+    itksys::SystemTools::RemoveADirectory(m_TempDirectory);
+  }
+
+  void DetectFormat_KnownMagicBytes_ReturnsFormat()
+  {
+    using Format = mitk::FileSignature::Format;
+
+    std::string dicom(128, '\0');
+    dicom += "DICM";
+
+    CPPUNIT_ASSERT(Format::Dicom == mitk::FileSignature::DetectFormat(dicom));
+    CPPUNIT_ASSERT(Format::Nrrd == mitk::FileSignature::DetectFormat("NRRD0004\n# Complete NRRD file format specification"));
+    CPPUNIT_ASSERT(Format::Nifti == mitk::FileSignature::DetectFormat(CreateNiftiHeader("n+1\0")));
+    CPPUNIT_ASSERT(Format::Nifti == mitk::FileSignature::DetectFormat(CreateNiftiHeader("ni1\0")));
+    CPPUNIT_ASSERT(Format::VtkLegacy == mitk::FileSignature::DetectFormat("# vtk DataFile Version 3.0\n"));
+    CPPUNIT_ASSERT(Format::VtkXml == mitk::FileSignature::DetectFormat("<?xml version=\"1.0\"?>\n<VTKFile type=\"ImageData\">"));
+    CPPUNIT_ASSERT(Format::VtkXml == mitk::FileSignature::DetectFormat("<VTKFile type=\"PolyData\">"));
+    CPPUNIT_ASSERT(Format::Gzip == mitk::FileSignature::DetectFormat(std::string("\x1f\x8b\x08\x00", 4)));
+  }
+
+  void DetectFormat_UnknownOrShortHeader_ReturnsUnknown()
+  {
+    using Format = mitk::FileSignature::Format;
+
+    CPPUNIT_ASSERT(Format::Unknown == mitk::FileSignature::DetectFormat(""));
+    CPPUNIT_ASSERT(Format::Unknown == mitk::FileSignature::DetectFormat(std::string(130, '\0') + "DICM"));
+    CPPUNIT_ASSERT(Format::Unknown == mitk::FileSignature::DetectFormat("<?xml version=\"1.0\"?>\n<MITK/>"));
+    CPPUNIT_ASSERT(Format::Unknown == mitk::FileSignature::DetectFormat(CreateNiftiHeader("abc\0")));
+    CPPUNIT_ASSERT(Format::Unknown == mitk::FileSignature::DetectFormat(CreateNiftiHeader("n+1\0").substr(0, 300)));
+  }
+
+  void Get_TestDataFile_ReturnsNrrd()
+  {
+    auto signature = mitk::FileSignature::Get(GetTestDataFilePath("Pic3D.nrrd"));
+
+    CPPUNIT_ASSERT(signature.IsValid());
+    CPPUNIT_ASSERT(mitk::FileSignature::Format::Nrrd == signature.GetFormat());
+    CPPUNIT_ASSERT_EQUAL(mitk::FileSignature::HeaderSize, signature.GetHeader().size());
+  }
+
+  void Get_Directory_ReturnsInvalidSignature()
+  {
+    CPPUNIT_ASSERT(!mitk::FileSignature::Get(m_TempDirectory).IsValid());
+    CPPUNIT_ASSERT(!mitk::FileSignature::Get(m_TempDirectory + "/doesNotExist.nrrd").IsValid());
+  }
+
+  void Get_ModifiedFile_InvalidatesCache()
+  {
+    const std::string path = m_TempDirectory + "/file.vtk";
+
+    WriteFile(path, "NRRD0004\n");
+    CPPUNIT_ASSERT(mitk::FileSignature::Format::Nrrd == mitk::FileSignature::Get(path).GetFormat());
+
+    WriteFile(path, "# vtk DataFile Version 3.0\n");
+    auto signature = mitk::FileSignature::Get(path);
+    CPPUNIT_ASSERT(mitk::FileSignature::Format::VtkLegacy == signature.GetFormat());
+    CPPUNIT_ASSERT_EQUAL(std::string("# vtk DataFile Version 3.0\n"), signature.GetHeader());
+  }
+};
+
+MITK_TEST_SUITE_REGISTRATION(mitkFileSignature)
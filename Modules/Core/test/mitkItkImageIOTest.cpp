@@ -19,12 +19,19 @@ found in the LICENSE file.
 #include <mitkUtf8Util.h>
 #include "mitkITKImageImport.h"
 #include <mitkExtractSliceFilter.h>
+#include <mitkImageWriteAccessor.h>
+#include <mitkItkImageIO.h>
+#include <mitkMemoryMappedFile.h>
+#include <mitkPagedMemoryManager.h>
 
 #include "itksys/SystemTools.hxx"
+#include <itkImageFileWriter.h>
+#include <itkImageIOFactory.h>
 #include <itkImageRegionIterator.h>
 
 #include <fstream>
 #include <iostream>
+#include <iterator>
 
 #ifdef WIN32
 #include "process.h"
@@ -44,11 +51,198 @@ class mitkItkImageIOTestSuite : public mitk::TestFixture
   MITK_TEST(TestWrite3DImageWithTwoPlanes);
   MITK_TEST(TestWrite3DplusT_ArbitraryTG);
   MITK_TEST(TestWrite3DplusT_ProportionalTG);
+  MITK_TEST(TestLoadModesNrrd);
+  MITK_TEST(TestLoadModesNifti);
+  MITK_TEST(TestLoadModesMetaImage);
+  MITK_TEST(TestMemoryMappedFallbackForCompressedFile);
+  MITK_TEST(TestMemoryMappedImageIsCopyOnWrite);
+  MITK_TEST(TestMemoryMappedFallbackForMisalignedPixelData);
+  MITK_TEST(TestSaveOverMemoryMappedFile);
   CPPUNIT_TEST_SUITE_END();
 
+  std::vector<std::string> m_TemporaryFiles;
+
 public:
   void setUp() override {}
-  void tearDown() override {}
+
+  void tearDown() override
+  {
+    for (const auto& file : m_TemporaryFiles)
+      itksys::SystemTools::RemoveFile(file);
+
+    m_TemporaryFiles.clear();
+  }
+
+  /** Writes a 3D+t test image with plain ITK, i.e. without MITK meta data.*/
+  std::string WriteLoadModeTestImage(const std::string& extension, bool useCompression)
+  {
+    typedef itk::Image<short, 4> ImageType;
+
+    ImageType::SizeType size;
+    size[0] = 40;
+    size[1] = 30;
+    size[2] = 20;
+    size[3] = 3;
+
+    auto itkImage = ImageType::New();
+    itkImage->SetRegions(ImageType::RegionType(size));
+    itkImage->Allocate();
+
+    for (itk::ImageRegionIterator<ImageType> it(itkImage, itkImage->GetLargestPossibleRegion()); !it.IsAtEnd(); ++it)
+    {
+      const auto index = it.GetIndex();
+      it.Set(static_cast<short>(index[0] - 3 * index[1] + 70 * index[2] - 1000 * index[3]));
+    }
+
+    const auto path = mitk::IOUtil::CreateTemporaryFile("ItkImageIOLoadModeTestXXXXXX." + extension);
+    m_TemporaryFiles.push_back(path);
+
+    auto writer = itk::ImageFileWriter<ImageType>::New();
+    writer->SetInput(itkImage);
+    writer->SetFileName(path);
+    writer->SetUseCompression(useCompression);
+    writer->Update();
+
+    return path;
+  }
+
+  static itk::ImageIOBase::Pointer CreateImageIO(const std::string& path)
+  {
+    auto imageIO = itk::ImageIOFactory::CreateImageIO(path.c_str(), itk::IOFileModeEnum::ReadMode);
+    CPPUNIT_ASSERT(imageIO.IsNotNull());
+    return imageIO;
+  }
+
+  static mitk::Image::Pointer LoadImage(const std::string& path, mitk::ItkImageIO::LoadMode loadMode)
+  {
+    return mitk::ItkImageIO::LoadRawMitkImageFromImageIO(CreateImageIO(path), path, loadMode);
+  }
+
+  static bool CanLoadMemoryMapped(const std::string& path)
+  {
+    auto imageIO = CreateImageIO(path);
+    imageIO->SetFileName(path);
+    imageIO->ReadImageInformation();
+
+    return mitk::ItkImageIO::CanLoadMemoryMapped(imageIO, path);
+  }
+
+  void TestLoadModes(const std::string& extension)
+  {
+    const auto path = this->WriteLoadModeTestImage(extension, false);
+
+    CPPUNIT_ASSERT_MESSAGE("Uncompressed ." + extension + " file can be memory mapped", CanLoadMemoryMapped(path));
+
+    auto reference = LoadImage(path, mitk::ItkImageIO::LoadMode::Complete);
+    auto streamedImage = LoadImage(path, mitk::ItkImageIO::LoadMode::Streamed);
+    auto memoryMappedImage = LoadImage(path, mitk::ItkImageIO::LoadMode::MemoryMapped);
+
+    MITK_ASSERT_EQUAL(reference, streamedImage, "Streamed ." + extension + " image equals completely loaded image");
+    MITK_ASSERT_EQUAL(reference, memoryMappedImage, "Memory mapped ." + extension + " image equals completely loaded image");
+
+    CPPUNIT_ASSERT(nullptr != memoryMappedImage->GetChannelData(0)->GetMemoryOwner());
+    CPPUNIT_ASSERT(!memoryMappedImage->GetChannelData(0)->GetManageMemory());
+
+    // paged time steps are read from the file on first access
+    auto pagedImage = LoadImage(path, mitk::ItkImageIO::LoadMode::Paged);
+    CPPUNIT_ASSERT(nullptr != pagedImage->GetVolumeData(1)->GetPagedMemory());
+
+    mitk::PagedMemoryManager::GetInstance().EvictAll();
+    MITK_ASSERT_EQUAL(reference, pagedImage, "Paged ." + extension + " image equals completely loaded image");
+  }
+
+  void TestLoadModesNrrd() { TestLoadModes("nrrd"); }
+  void TestLoadModesNifti() { TestLoadModes("nii"); }
+  void TestLoadModesMetaImage() { TestLoadModes("mha"); }
+
+  void TestMemoryMappedFallbackForCompressedFile()
+  {
+    const auto path = this->WriteLoadModeTestImage("nrrd", true);
+
+    CPPUNIT_ASSERT(!CanLoadMemoryMapped(path));
+
+    auto reference = LoadImage(path, mitk::ItkImageIO::LoadMode::Complete);
+    auto image = LoadImage(path, mitk::ItkImageIO::LoadMode::MemoryMapped);
+
+    MITK_ASSERT_EQUAL(reference, image, "Compressed image is loaded despite requested memory mapping");
+    CPPUNIT_ASSERT(nullptr == image->GetChannelData(0)->GetMemoryOwner());
+  }
+
+  void TestMemoryMappedImageIsCopyOnWrite()
+  {
+    const auto path = this->WriteLoadModeTestImage("nrrd", false);
+
+    {
+      auto image = LoadImage(path, mitk::ItkImageIO::LoadMode::MemoryMapped);
+
+      mitk::ImageWriteAccessor accessor(image);
+      auto data = static_cast<short*>(accessor.GetData());
+      data[0] = 4711;
+
+      CPPUNIT_ASSERT_EQUAL(short(4711), data[0]);
+    }
+
+    auto reloadedImage = LoadImage(path, mitk::ItkImageIO::LoadMode::Complete);
+    mitk::ImageWriteAccessor accessor(reloadedImage);
+
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("Modification of memory mapped image is not written to file", short(0), static_cast<short*>(accessor.GetData())[0]);
+  }
+
+  void TestMemoryMappedFallbackForMisalignedPixelData()
+  {
+    const auto path = this->WriteLoadModeTestImage("nrrd", false);
+
+    std::string content;
+
+    {
+      std::ifstream stream(path, std::ios::binary);
+      content.assign(std::istreambuf_iterator<char>(stream), std::istreambuf_iterator<char>());
+    }
+
+    // a comment line after the magic shifts the (short) pixel data to an odd offset
+    const auto headerSize = content.find("\n\n") + 2;
+    const auto firstLineSize = content.find('\n') + 1;
+    content.insert(firstLineSize, 0 == headerSize % 2 ? "# \n" : "#\n");
+
+    {
+      std::ofstream stream(path, std::ios::binary | std::ios::trunc);
+      stream.write(content.data(), static_cast<std::streamsize>(content.size()));
+    }
+
+    CPPUNIT_ASSERT(!CanLoadMemoryMapped(path));
+
+    auto reference = LoadImage(path, mitk::ItkImageIO::LoadMode::Complete);
+    auto image = LoadImage(path, mitk::ItkImageIO::LoadMode::MemoryMapped);
+
+    MITK_ASSERT_EQUAL(reference, image, "Image with misaligned pixel data is loaded despite requested memory mapping");
+    CPPUNIT_ASSERT(nullptr == image->GetChannelData(0)->GetMemoryOwner());
+  }
+
+  void TestSaveOverMemoryMappedFile()
+  {
+    const auto path = this->WriteLoadModeTestImage("nrrd", false);
+    auto image = LoadImage(path, mitk::ItkImageIO::LoadMode::MemoryMapped);
+    CPPUNIT_ASSERT(mitk::MemoryMappedFile::IsMapped(path));
+
+    {
+      mitk::ImageWriteAccessor accessor(image);
+      static_cast<short*>(accessor.GetData())[0] = 4711;
+    }
+
+#ifdef _WIN32
+    // mapped files cannot be replaced on Windows
+    CPPUNIT_ASSERT_THROW(mitk::IOUtil::Save(image, path), mitk::Exception);
+#else
+    mitk::IOUtil::Save(image, path);
+
+    // the mapping still refers to the replaced file
+    auto reference = LoadImage(path, mitk::ItkImageIO::LoadMode::Complete);
+    MITK_ASSERT_EQUAL(reference, image, "Memory mapped image is intact after saving it over its file");
+
+    mitk::ImageWriteAccessor accessor(reference);
+    CPPUNIT_ASSERT_EQUAL(short(4711), static_cast<short*>(accessor.GetData())[0]);
+#endif
+  }
   void TestImageWriterJpg() { TestImageWriter("NrrdWritingTestImage.jpg"); }
   void TestImageWriterPng1() { TestImageWriter("Png2D-bw.png"); }
   void TestImageWriterPng2() { TestImageWriter("RenderingTestData/rgbImage.png"); }
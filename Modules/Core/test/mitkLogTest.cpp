@@ -18,7 +18,9 @@ found in the LICENSE file.
 #include <mitkLogBackendCout.h>
 #include <mitkNumericTypes.h>
 #include <mitkStandardFileLocations.h>
+#include <atomic>
 #include <thread>
+#include <vector>
 #include <mitkUtf8Util.h>
 
 /** Documentation
@@ -49,6 +51,45 @@ public:
 private:
   bool m_Called;
 };
+
+/** Documentation
+ *
+ * @brief this class counts the processed messages and remembers the thread they were processed in.
+ * It is needed for the asynchronous logging test.
+ */
+class TestBackendCounter : public mitk::LogBackendBase
+{
+public:
+  TestBackendCounter()
+    : m_NumberOfMessages(0)
+  {
+  }
+
+  void ProcessMessage(const mitk::LogMessage&) override
+  {
+    ++m_NumberOfMessages;
+    m_ThreadId = std::this_thread::get_id();
+  }
+
+  OutputType GetOutputType() const override
+  {
+    return OutputType::Other;
+  }
+
+  std::size_t GetNumberOfMessages() const
+  {
+    return m_NumberOfMessages;
+  }
+
+  std::thread::id GetThreadId() const
+  {
+    return m_ThreadId;
+  }
+
+private:
+  std::atomic<std::size_t> m_NumberOfMessages;
+  std::thread::id m_ThreadId;
+};
 /** Documentation
   *
   * @brief Objects of this class can start an internal thread by calling the Start() method.
@@ -275,6 +316,64 @@ public:
     mitk::UnregisterBackend(&myCoutBackend);
     MITK_TEST_CONDITION_REQUIRED(success, "Test disable / enable logging backends.")
   }
+
+  static void TestAsynchronousLog()
+  {
+    TestBackendCounter backend;
+    mitk::RegisterBackend(&backend);
+    mitk::DisableBackends(mitk::LogBackendBase::OutputType::Console);
+    mitk::DisableBackends(mitk::LogBackendBase::OutputType::File);
+
+    const std::size_t numberOfThreads = 4;
+    const std::size_t numberOfMessagesPerThread = 1000;
+
+    auto logFromThreads = [&]() {
+      std::vector<std::thread> threads;
+
+      for (std::size_t i = 0; i < numberOfThreads; ++i)
+      {
+        threads.emplace_back([&]() {
+          for (std::size_t j = 0; j < numberOfMessagesPerThread; ++j)
+            MITK_INFO << "Asynchronous message " << j;
+        });
+      }
+
+      for (auto& thread : threads)
+        thread.join();
+    };
+
+    // A small queue forces the producers to block regularly
+    mitk::EnableAsynchronousLogging(16, mitk::LogOverflowPolicy::Block);
+    MITK_TEST_CONDITION_REQUIRED(mitk::IsAsynchronousLoggingEnabled(), "Test enabling asynchronous logging.");
+
+    logFromThreads();
+    mitk::FlushLog();
+
+    MITK_TEST_CONDITION_REQUIRED(backend.GetNumberOfMessages() == numberOfThreads * numberOfMessagesPerThread,
+      "Test if no message is lost with the block policy.");
+    MITK_TEST_CONDITION(backend.GetThreadId() != std::this_thread::get_id(),
+      "Test if messages are processed in a background thread.");
+
+    const auto numberOfDroppedMessages = mitk::GetNumberOfDroppedLogMessages();
+    mitk::EnableAsynchronousLogging(4, mitk::LogOverflowPolicy::Drop);
+
+    logFromThreads();
+    mitk::DisableAsynchronousLogging();
+
+    MITK_TEST_CONDITION_REQUIRED(!mitk::IsAsynchronousLoggingEnabled(), "Test disabling asynchronous logging.");
+    MITK_TEST_CONDITION_REQUIRED(
+      backend.GetNumberOfMessages() + mitk::GetNumberOfDroppedLogMessages() - numberOfDroppedMessages ==
+        2 * numberOfThreads * numberOfMessagesPerThread,
+      "Test if each message is either processed or dropped with the drop policy.");
+
+    MITK_INFO << "Synchronous message";
+    MITK_TEST_CONDITION(backend.GetThreadId() == std::this_thread::get_id(),
+      "Test if messages are processed synchronously again.");
+
+    mitk::EnableBackends(mitk::LogBackendBase::OutputType::Console);
+    mitk::EnableBackends(mitk::LogBackendBase::OutputType::File);
+    mitk::UnregisterBackend(&backend);
+  }
 };
 
 int mitkLogTest(int /* argc */, char * /*argv*/ [])
@@ -292,6 +391,7 @@ int mitkLogTest(int /* argc */, char * /*argv*/ [])
   mitkLogTestClass::TestThreadSaveLog(false); // false = to console
   mitkLogTestClass::TestThreadSaveLog(true);  // true = to file
   mitkLogTestClass::TestEnableDisableBackends();
+  mitkLogTestClass::TestAsynchronousLog();
   // TODO actually test file somehow?
 
   // always end with this!
@@ -0,0 +1,339 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+// Testing
+#include <mitkTestFixture.h>
+#include <mitkTestingMacros.h>
+
+// MITK includes
+#include <mitkExtractSliceFilter.h>
+#include <mitkImage.h>
+#include <mitkImageReadAccessor.h>
+#include <mitkImageTimeSelector.h>
+#include <mitkPagedMemory.h>
+#include <mitkPagedMemoryManager.h>
+
+#include <vtkImageData.h>
+
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+
+class mitkPagedMemoryTestSuite : public mitk::TestFixture
+{
+  CPPUNIT_TEST_SUITE(mitkPagedMemoryTestSuite);
+  MITK_TEST(EvictedContentIsRestored);
+  MITK_TEST(UnmodifiedContentIsNotSpilledAgain);
+  MITK_TEST(PinnedMemoryIsNotEvicted);
+  MITK_TEST(LeastRecentlyUsedMemoryIsEvictedFirst);
+  MITK_TEST(AccessorsRestorePagedVolumes);
+  MITK_TEST(TimeSelectorRestoresPagedVolume);
+  MITK_TEST(VtkImageDataRestoresPagedVolume);
+  MITK_TEST(ExtractSliceFilterRestoresPagedVolume);
+  MITK_TEST(ConcurrentUseRestoresContent);
+  CPPUNIT_TEST_SUITE_END();
+
+private:
+  static constexpr std::size_t BlockSize = 1024 * 1024;
+
+  std::size_t m_OriginalBudget;
+
+  static std::shared_ptr<mitk::PagedMemory> CreateFilledMemory(std::size_t size, unsigned char seed)
+  {
+    auto memory = std::make_shared<mitk::PagedMemory>(size);
+
+    memory->Pin();
+    auto data = static_cast<unsigned char*>(memory->GetData());
+
+    for (std::size_t i = 0; i < size; ++i)
+      data[i] = static_cast<unsigned char>(i * 7 + seed);
+
+    memory->Unpin();
+
+    return memory;
+  }
+
+  static bool HasContent(const mitk::PagedMemory& memory, unsigned char seed)
+  {
+    auto data = static_cast<const unsigned char*>(memory.GetData());
+
+    for (std::size_t i = 0; i < memory.GetSize(); ++i)
+    {
+      if (data[i] != static_cast<unsigned char>(i * 7 + seed))
+        return false;
+    }
+
+    return true;
+  }
+
+  /** 3D+t image whose volumes are paged memory and hold the value 1000 * t + z at every voxel.*/
+  static mitk::Image::Pointer CreatePagedImage()
+  {
+    const unsigned int dimensions[] = { 32, 32, 16, 4 };
+
+    auto image = mitk::Image::New();
+    image->Initialize(mitk::MakeScalarPixelType<short>(), 4, dimensions);
+
+    const std::size_t sliceSize = dimensions[0] * dimensions[1];
+
+    for (unsigned int t = 0; t < dimensions[3]; ++t)
+    {
+      auto memory = std::make_shared<mitk::PagedMemory>(sliceSize * dimensions[2] * sizeof(short));
+
+      memory->Pin();
+      auto data = static_cast<short*>(memory->GetData());
+
+      for (unsigned int z = 0; z < dimensions[2]; ++z)
+        std::fill(data + z * sliceSize, data + (z + 1) * sliceSize, static_cast<short>(1000 * t + z));
+
+      memory->Unpin();
+
+      CPPUNIT_ASSERT(image->SetPagedVolume(memory, t));
+    }
+
+    return image;
+  }
+
+public:
+  void setUp() override
+  {
+    auto& manager = mitk::PagedMemoryManager::GetInstance();
+
+    m_OriginalBudget = manager.GetMemoryBudget();
+    manager.ResetStatistics();
+  }
+
+  void tearDown() override
+  {
+    auto& manager = mitk::PagedMemoryManager::GetInstance();
+
+    manager.SetMemoryBudget(m_OriginalBudget);
+    manager.ResetStatistics();
+  }
+
+  void EvictedContentIsRestored()
+  {
+    auto& manager = mitk::PagedMemoryManager::GetInstance();
+    auto memory = CreateFilledMemory(BlockSize, 3);
+
+    CPPUNIT_ASSERT(memory->IsResident());
+
+    manager.EvictAll();
+
+    CPPUNIT_ASSERT(!memory->IsResident());
+    CPPUNIT_ASSERT_EQUAL(std::size_t(1), manager.GetStatistics().numberOfSpills);
+
+    memory->Touch();
+
+    CPPUNIT_ASSERT(memory->IsResident());
+    CPPUNIT_ASSERT(HasContent(*memory, 3));
+    CPPUNIT_ASSERT_EQUAL(std::size_t(1), manager.GetStatistics().numberOfFaults);
+  }
+
+  void UnmodifiedContentIsNotSpilledAgain()
+  {
+    auto& manager = mitk::PagedMemoryManager::GetInstance();
+    auto memory = CreateFilledMemory(BlockSize, 5);
+
+    manager.EvictAll();
+    memory->Touch();
+    manager.EvictAll();
+
+    CPPUNIT_ASSERT_EQUAL(std::size_t(2), manager.GetStatistics().numberOfEvictions);
+    CPPUNIT_ASSERT_EQUAL(std::size_t(1), manager.GetStatistics().numberOfSpills);
+
+    // a modification has to be written to the spill file
+    memory->Pin();
+    static_cast<unsigned char*>(memory->GetData())[42] = 0;
+    memory->Unpin();
+    manager.EvictAll();
+
+    CPPUNIT_ASSERT_EQUAL(std::size_t(2), manager.GetStatistics().numberOfSpills);
+
+    memory->Touch();
+    CPPUNIT_ASSERT_EQUAL(0, static_cast<int>(static_cast<unsigned char*>(memory->GetData())[42]));
+  }
+
+  void PinnedMemoryIsNotEvicted()
+  {
+    auto& manager = mitk::PagedMemoryManager::GetInstance();
+    auto memory = CreateFilledMemory(BlockSize, 11);
+
+    memory->Pin();
+    manager.EvictAll();
+
+    CPPUNIT_ASSERT(memory->IsResident());
+    CPPUNIT_ASSERT(memory->IsPinned());
+
+    memory->Unpin();
+    manager.EvictAll();
+
+    CPPUNIT_ASSERT(!memory->IsResident());
+  }
+
+  void LeastRecentlyUsedMemoryIsEvictedFirst()
+  {
+    auto& manager = mitk::PagedMemoryManager::GetInstance();
+    manager.EvictAll();
+    manager.SetMemoryBudget(2 * BlockSize);
+
+    auto first = CreateFilledMemory(BlockSize, 1);
+    auto second = CreateFilledMemory(BlockSize, 2);
+
+    // the first block becomes the most recently used one
+    first->Touch();
+
+    auto third = CreateFilledMemory(BlockSize, 3);
+
+    CPPUNIT_ASSERT(first->IsResident());
+    CPPUNIT_ASSERT(!second->IsResident());
+    CPPUNIT_ASSERT(third->IsResident());
+    CPPUNIT_ASSERT(manager.GetResidentSize() <= 2 * BlockSize);
+
+    second->Touch();
+
+    CPPUNIT_ASSERT(!first->IsResident());
+    CPPUNIT_ASSERT(HasContent(*second, 2));
+  }
+
+  void AccessorsRestorePagedVolumes()
+  {
+    auto image = CreatePagedImage();
+    mitk::PagedMemoryManager::GetInstance().EvictAll();
+
+    {
+      mitk::ImageReadAccessor accessor(image, image->GetVolumeData(2));
+      auto data = static_cast<const short*>(accessor.GetData());
+
+      CPPUNIT_ASSERT_EQUAL(short(2000), data[0]);
+      CPPUNIT_ASSERT_EQUAL(short(2015), data[15 * 32 * 32]);
+
+      // volumes that are accessed cannot be evicted
+      mitk::PagedMemoryManager::GetInstance().EvictAll();
+      CPPUNIT_ASSERT(image->GetVolumeData(2)->GetPagedMemory()->IsResident());
+    }
+
+    mitk::PagedMemoryManager::GetInstance().EvictAll();
+
+    mitk::ImageReadAccessor sliceAccessor(image, image->GetSliceData(7, 3));
+    CPPUNIT_ASSERT_EQUAL(short(3007), static_cast<const short*>(sliceAccessor.GetData())[5]);
+
+    // accessing the whole image combines the volumes
+    mitk::ImageReadAccessor imageAccessor(image);
+    auto data = static_cast<const short*>(imageAccessor.GetData());
+    CPPUNIT_ASSERT_EQUAL(short(1), data[32 * 32]);
+    CPPUNIT_ASSERT_EQUAL(short(3015), data[(3 * 16 + 15) * 32 * 32]);
+  }
+
+  void TimeSelectorRestoresPagedVolume()
+  {
+    auto image = CreatePagedImage();
+
+    auto selector = mitk::ImageTimeSelector::New();
+    selector->SetInput(image);
+    selector->SetTimeNr(1);
+    selector->UpdateLargestPossibleRegion();
+
+    mitk::Image::Pointer timeStep = selector->GetOutput();
+    mitk::PagedMemoryManager::GetInstance().EvictAll();
+
+    mitk::ImageReadAccessor accessor(timeStep);
+    auto data = static_cast<const short*>(accessor.GetData());
+
+    CPPUNIT_ASSERT_EQUAL(short(1000), data[0]);
+    CPPUNIT_ASSERT_EQUAL(short(1009), data[9 * 32 * 32 + 17]);
+  }
+
+  void VtkImageDataRestoresPagedVolume()
+  {
+    auto image = CreatePagedImage();
+    mitk::PagedMemoryManager::GetInstance().EvictAll();
+
+    auto pagedMemory = image->GetVolumeData(2)->GetPagedMemory();
+    auto vtkImage = image->GetVtkImageData(2);
+    CPPUNIT_ASSERT(!pagedMemory->IsPinned());
+
+    // the vtkImageData does not keep the volume resident, but it stays valid and is restored on access
+    mitk::PagedMemoryManager::GetInstance().EvictAll();
+    CPPUNIT_ASSERT(!pagedMemory->IsResident());
+
+    CPPUNIT_ASSERT(vtkImage == image->GetVtkImageData(2));
+    CPPUNIT_ASSERT(pagedMemory->IsResident());
+    CPPUNIT_ASSERT_EQUAL(short(2015), static_cast<short*>(vtkImage->GetScalarPointer())[15 * 32 * 32]);
+  }
+
+  void ExtractSliceFilterRestoresPagedVolume()
+  {
+    auto image = CreatePagedImage();
+    image->GetVtkImageData(2);
+    mitk::PagedMemoryManager::GetInstance().EvictAll();
+
+    auto plane = mitk::PlaneGeometry::New();
+    plane->InitializeStandardPlane(image->GetGeometry(), mitk::AnatomicalPlane::Axial, 5, true, false);
+
+    auto reslicer = mitk::ExtractSliceFilter::New();
+    reslicer->SetInput(image);
+    reslicer->SetWorldGeometry(plane);
+    reslicer->SetTimeStep(2);
+    reslicer->SetResliceTransformByGeometry(image->GetGeometry());
+    reslicer->SetVtkOutputRequest(true);
+    reslicer->Update();
+
+    CPPUNIT_ASSERT_EQUAL(short(2005), *static_cast<short*>(reslicer->GetVtkOutput()->GetScalarPointer()));
+
+    // the volume is only pinned while it is resliced
+    CPPUNIT_ASSERT(!image->GetVolumeData(2)->GetPagedMemory()->IsPinned());
+  }
+
+  void ConcurrentUseRestoresContent()
+  {
+    auto& manager = mitk::PagedMemoryManager::GetInstance();
+    manager.EvictAll();
+    manager.SetMemoryBudget(BlockSize);
+
+    const unsigned int numberOfBlocks = 4;
+    std::vector<std::shared_ptr<mitk::PagedMemory>> memories;
+
+    for (unsigned int i = 0; i < numberOfBlocks; ++i)
+      memories.push_back(CreateFilledMemory(BlockSize, static_cast<unsigned char>(i)));
+
+    // the blocks are evicted and restored concurrently by the threads, as only one fits into the budget
+    std::atomic<unsigned int> numberOfErrors(0);
+    std::vector<std::thread> threads;
+
+    for (unsigned int i = 0; i < numberOfBlocks; ++i)
+    {
+      threads.emplace_back([&memories, &numberOfErrors, i]() {
+        for (int j = 0; j < 10; ++j)
+        {
+          auto& memory = memories[(i + j) % memories.size()];
+          mitk::PagedMemoryPin pin(memory);
+
+          if (!HasContent(*memory, static_cast<unsigned char>((i + j) % memories.size())))
+            ++numberOfErrors;
+        }
+      });
+    }
+
+    for (auto& thread : threads)
+      thread.join();
+
+    CPPUNIT_ASSERT_EQUAL(0u, numberOfErrors.load());
+    CPPUNIT_ASSERT(manager.GetStatistics().numberOfFaults > 0);
+
+    for (const auto& memory : memories)
+      CPPUNIT_ASSERT(!memory->IsPinned());
+  }
+};
+
+MITK_TEST_SUITE_REGISTRATION(mitkPagedMemory)
@@ -0,0 +1,136 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include "mitkPropertyKeyAtom.h"
+
+#include "mitkDataNode.h"
+#include "mitkException.h"
+#include "mitkPointSet.h"
+#include "mitkProperties.h"
+#include "mitkPropertyList.h"
+#include "mitkTestFixture.h"
+#include "mitkTestingMacros.h"
+
+class mitkPropertyKeyAtomTestSuite : public mitk::TestFixture
+{
+  CPPUNIT_TEST_SUITE(mitkPropertyKeyAtomTestSuite);
+
+  MITK_TEST(Interning);
+  MITK_TEST(EmptyKey);
+  MITK_TEST(PropertyListLookup);
+  MITK_TEST(PropertyListCopyAndClear);
+  MITK_TEST(DataNodeLookup);
+
+  CPPUNIT_TEST_SUITE_END();
+
+public:
+  void Interning()
+  {
+    const mitk::PropertyKeyAtom atom("test.atom");
+    const mitk::PropertyKeyAtom sameAtom(std::string("test.") + "atom");
+    const mitk::PropertyKeyAtom otherAtom("test.other atom");
+
+    CPPUNIT_ASSERT(atom == sameAtom);
+    CPPUNIT_ASSERT(atom != otherAtom);
+    CPPUNIT_ASSERT_EQUAL(std::string("test.atom"), atom.GetKey());
+    CPPUNIT_ASSERT_EQUAL(std::string("visible"), mitk::PropertyKeyAtom::Visible().GetKey());
+    CPPUNIT_ASSERT(mitk::PropertyKeyAtom("opacity") == mitk::PropertyKeyAtom::Opacity());
+  }
+
+  void EmptyKey()
+  {
+    CPPUNIT_ASSERT_THROW(mitk::PropertyKeyAtom(""), mitk::Exception);
+  }
+
+  void PropertyListLookup()
+  {
+    auto propertyList = mitk::PropertyList::New();
+    const mitk::PropertyKeyAtom layer = mitk::PropertyKeyAtom::Layer();
+
+    CPPUNIT_ASSERT(nullptr == propertyList->GetProperty(layer));
+
+    propertyList->SetIntProperty("layer", 3);
+    propertyList->SetBoolProperty("visible", false);
+    propertyList->SetFloatProperty("opacity", 0.5f);
+
+    int layerValue = 0;
+    CPPUNIT_ASSERT(propertyList->GetIntProperty(layer, layerValue));
+    CPPUNIT_ASSERT_EQUAL(3, layerValue);
+    CPPUNIT_ASSERT(propertyList->GetProperty(layer) == propertyList->GetProperty("layer"));
+
+    bool visible = true;
+    CPPUNIT_ASSERT(propertyList->GetBoolProperty(mitk::PropertyKeyAtom::Visible(), visible));
+    CPPUNIT_ASSERT(!visible);
+
+    // Type mismatches are not resolved
+    float floatValue = 0.0f;
+    CPPUNIT_ASSERT(!propertyList->GetFloatProperty(layer, floatValue));
+    CPPUNIT_ASSERT(nullptr == propertyList->GetPropertyAs<mitk::BoolProperty>(layer));
+
+    propertyList->ReplaceProperty("layer", mitk::FloatProperty::New(2.0f));
+    CPPUNIT_ASSERT(propertyList->GetFloatProperty(layer, floatValue));
+    CPPUNIT_ASSERT_EQUAL(2.0f, floatValue);
+
+    propertyList->RemoveProperty("visible");
+    CPPUNIT_ASSERT(nullptr == propertyList->GetProperty(mitk::PropertyKeyAtom::Visible()));
+
+    propertyList->DeleteProperty("layer");
+    CPPUNIT_ASSERT(nullptr == propertyList->GetProperty(layer));
+    CPPUNIT_ASSERT(nullptr != propertyList->GetProperty(mitk::PropertyKeyAtom::Opacity()));
+  }
+
+  void PropertyListCopyAndClear()
+  {
+    auto propertyList = mitk::PropertyList::New();
+    propertyList->SetIntProperty("layer", 3);
+
+    auto clone = propertyList->Clone();
+    auto property = clone->GetProperty(mitk::PropertyKeyAtom::Layer());
+
+    CPPUNIT_ASSERT(nullptr != property);
+    CPPUNIT_ASSERT(property == clone->GetProperty("layer"));
+    CPPUNIT_ASSERT(property != propertyList->GetProperty(mitk::PropertyKeyAtom::Layer()));
+
+    clone->Clear();
+    CPPUNIT_ASSERT(nullptr == clone->GetProperty(mitk::PropertyKeyAtom::Layer()));
+  }
+
+  void DataNodeLookup()
+  {
+    auto node = mitk::DataNode::New();
+    node->SetData(mitk::PointSet::New());
+    node->SetColor(1.0f, 0.5f, 0.25f);
+    node->SetOpacity(0.75f);
+    node->GetData()->SetProperty("layer", mitk::IntProperty::New(7));
+
+    float rgb[3] = { 0.0f, 0.0f, 0.0f };
+    CPPUNIT_ASSERT(node->GetColor(rgb, nullptr, mitk::PropertyKeyAtom::Color()));
+    CPPUNIT_ASSERT_EQUAL(0.5f, rgb[1]);
+
+    float opacity = 0.0f;
+    CPPUNIT_ASSERT(node->GetOpacity(opacity, nullptr, mitk::PropertyKeyAtom::Opacity()));
+    CPPUNIT_ASSERT_EQUAL(0.75f, opacity);
+
+    // Falls back on the data properties
+    int layer = 0;
+    CPPUNIT_ASSERT(node->GetIntProperty(mitk::PropertyKeyAtom::Layer(), layer));
+    CPPUNIT_ASSERT_EQUAL(7, layer);
+    CPPUNIT_ASSERT(nullptr == node->GetProperty(mitk::PropertyKeyAtom::Layer(), nullptr, false));
+
+    node->SetVisibility(false);
+    bool visible = true;
+    CPPUNIT_ASSERT(node->GetVisibility(visible, nullptr, mitk::PropertyKeyAtom::Visible()));
+    CPPUNIT_ASSERT(!visible);
+  }
+};
+
+MITK_TEST_SUITE_REGISTRATION(mitkPropertyKeyAtom)
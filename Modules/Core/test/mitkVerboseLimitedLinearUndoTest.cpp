@@ -29,8 +29,13 @@ namespace mitk
   class TestOperation : public Operation
   {
   public:
-    TestOperation(OperationType operationType) : Operation(operationType) { g_GlobalCounter++; };
+    TestOperation(OperationType operationType, std::size_t memorySize = 0)
+      : Operation(operationType), m_MemorySize(memorySize) { g_GlobalCounter++; };
     ~TestOperation() override { g_GlobalCounter--; };
+    std::size_t GetMemorySize() const override { return m_MemorySize; };
+
+  private:
+    std::size_t m_MemorySize;
   };
 } // namespace
 
@@ -107,6 +112,28 @@ int mitkVerboseLimitedLinearUndoTest(int /* argc */, char * /*argv*/ [])
   myUndoController->Clear();
   MITK_TEST_CONDITION_REQUIRED(g_GlobalCounter == 0, "checking deleting all operations in UndoModel");
 
+  // limit the undo history to 1 MB; every OperationEvent occupies 2 * 300 KB
+  auto *undoModel = dynamic_cast<mitk::LimitedLinearUndo *>(myUndoController->GetCurrentUndoModel());
+  MITK_TEST_CONDITION_REQUIRED(undoModel != nullptr, "checking current undo model is a LimitedLinearUndo");
+  undoModel->SetMemoryLimit(1);
+
+  for (int i = 0; i < 3; i++)
+  {
+    auto doOp = new mitk::TestOperation(mitk::OpTEST, 300 * 1024);
+    auto undoOp = new mitk::TestOperation(mitk::OpTEST, 300 * 1024);
+    mitk::OperationEvent *operationEvent = new mitk::OperationEvent(nullptr, doOp, undoOp, "Test");
+    myUndoController->SetOperationEvent(operationEvent);
+    mitk::OperationEvent::IncCurrObjectEventId();
+  }
+
+  // only the newest OperationEvent fits into the memory limit, the older ones must have been deleted
+  MITK_TEST_CONDITION_REQUIRED(g_GlobalCounter == 2, "checking memory limit of UndoModel");
+  MITK_TEST_CONDITION_REQUIRED(undoModel->GetMemorySize() == 600 * 1024, "checking memory size of UndoModel");
+
+  undoModel->SetMemoryLimit(0);
+  myUndoController->Clear();
+  MITK_TEST_CONDITION_REQUIRED(g_GlobalCounter == 0, "checking deleting all operations in UndoModel");
+
   // sending two new OperationEvents
   for (int i = 0; i < 2; i++)
   {
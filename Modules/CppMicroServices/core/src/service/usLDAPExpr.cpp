@@ -170,14 +170,19 @@ std::string LDAPExpr::Trim(std::string str)
 }
 
 bool LDAPExpr::GetMatchedObjectClasses(ObjectClassSet& objClasses) const
+{
+  return GetMatchedValues(ServiceConstants::OBJECTCLASS(), objClasses);
+}
+
+bool LDAPExpr::GetMatchedValues(const std::string& attrName, ObjectClassSet& values) const
 {
   if (d->m_operator == EQ)
   {
-    if (d->m_attrName.length() == ServiceConstants::OBJECTCLASS().length() &&
-        std::equal(d->m_attrName.begin(), d->m_attrName.end(), ServiceConstants::OBJECTCLASS().begin(), stricomp) &&
+    if (d->m_attrName.length() == attrName.length() &&
+        std::equal(d->m_attrName.begin(), d->m_attrName.end(), attrName.begin(), stricomp) &&
         d->m_attrValue.find(LDAPExprConstants::WILDCARD()) == std::string::npos)
     {
-      objClasses.insert( d->m_attrValue );
+      values.insert( d->m_attrValue );
       return true;
     }
     return false;
@@ -188,38 +193,28 @@ bool LDAPExpr::GetMatchedObjectClasses(ObjectClassSet& objClasses) const
     for (std::size_t i = 0; i < d->m_args.size( ); i++)
     {
       LDAPExpr::ObjectClassSet r;
-      if (d->m_args[i].GetMatchedObjectClasses(r))
+      if (d->m_args[i].GetMatchedValues(attrName, r))
       {
-        result = true;
-        if (objClasses.empty())
+        if (!result)
         {
-          objClasses = r;
+          values.insert(r.begin(), r.end());
+          result = true;
         }
         else
         {
-          // if AND op and classes in several operands,
+          // if AND op and values in several operands,
           // then only the intersection is possible.
-          LDAPExpr::ObjectClassSet::iterator it1 = objClasses.begin();
-          LDAPExpr::ObjectClassSet::iterator it2 = r.begin();
-          while ( (it1 != objClasses.end()) && (it2 != r.end()) )
+          for (LDAPExpr::ObjectClassSet::iterator it = values.begin(); it != values.end();)
           {
-            if (*it1 < *it2)
-            {
-              objClasses.erase(it1++);
-            }
-            else if (*it2 < *it1)
+            if (r.count(*it) == 0)
             {
-              ++it2;
+              it = values.erase(it);
             }
             else
-            { // *it1 == *it2
-              ++it1;
-              ++it2;
+            {
+              ++it;
             }
           }
-          // Anything left in set_1 from here on did not appear in set_2,
-          // so we remove it.
-          objClasses.erase(it1, objClasses.end());
         }
       }
     }
@@ -230,13 +225,13 @@ bool LDAPExpr::GetMatchedObjectClasses(ObjectClassSet& objClasses) const
     for (std::size_t i = 0; i < d->m_args.size( ); i++)
     {
       LDAPExpr::ObjectClassSet r;
-      if (d->m_args[i].GetMatchedObjectClasses(r))
+      if (d->m_args[i].GetMatchedValues(attrName, r))
       {
-        std::copy(r.begin(), r.end(), std::inserter(objClasses, objClasses.begin()));
+        values.insert(r.begin(), r.end());
       }
       else
       {
-        objClasses.clear();
+        values.clear();
         return false;
       }
     }
@@ -245,6 +240,24 @@ bool LDAPExpr::GetMatchedObjectClasses(ObjectClassSet& objClasses) const
   return false;
 }
 
+void LDAPExpr::GetEqualityAttributeNames(StringList& attrNames) const
+{
+  if (d->m_operator == EQ)
+  {
+    if (std::find(attrNames.begin(), attrNames.end(), d->m_attrName) == attrNames.end())
+    {
+      attrNames.push_back(d->m_attrName);
+    }
+  }
+  else if ((d->m_operator & COMPLEX) != 0)
+  {
+    for (std::size_t i = 0; i < d->m_args.size( ); i++)
+    {
+      d->m_args[i].GetEqualityAttributeNames(attrNames);
+    }
+  }
+}
+
 std::string LDAPExpr::ToLower(const std::string& str)
 {
   std::string lowerStr(str);
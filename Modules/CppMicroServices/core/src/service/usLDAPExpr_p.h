@@ -83,6 +83,26 @@ public:
    */
   bool GetMatchedObjectClasses(ObjectClassSet& objClasses) const;
 
+  /**
+   * Get the set of values one of which the attribute <code>attrName</code> must be
+   * equal to for this LDAP expression to match. Attribute names are compared case
+   * insensitively. This will not work with wildcards and NOT expressions. If a set
+   * can not be determined return <code>false</code>.
+   *
+   * \param attrName The attribute name to look for.
+   * \param values The set of matched values will be added to values.
+   * \return If the set cannot be determined, <code>false</code> is returned, <code>true</code> otherwise.
+   */
+  bool GetMatchedValues(const std::string& attrName, ObjectClassSet& values) const;
+
+  /**
+   * Get the names of all attributes which are compared for equality in this LDAP
+   * expression, in the case they are written in.
+   *
+   * \param attrNames The attribute names will be added to attrNames.
+   */
+  void GetEqualityAttributeNames(StringList& attrNames) const;
+
   /**
    * Checks if this LDAP expression is "simple". The definition of
    * a simple filter is:
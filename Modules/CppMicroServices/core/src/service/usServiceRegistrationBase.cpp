@@ -129,6 +129,8 @@ void ServiceRegistrationBase::SetProperties(const ServiceProperties& props)
         }
       }
 
+      d->module->coreCtx->services.InvalidatePropertyIndexes();
+
       if (old_rank != new_rank)
       {
         d->module->coreCtx->services.UpdateServiceRegistrationOrder(*this, classes);
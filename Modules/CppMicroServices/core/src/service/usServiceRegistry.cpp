@@ -19,9 +19,11 @@
 
 ============================================================================*/
 
+#include <algorithm>
 #include <iterator>
 #include <stdexcept>
 #include <cassert>
+#include <cctype>
 
 #include "usServiceRegistry_p.h"
 #include "usServiceFactory.h"
@@ -81,6 +83,8 @@ void ServiceRegistry::Clear()
   services.clear();
   serviceRegistrations.clear();
   classServices.clear();
+  filterCache.clear();
+  propertyIndexes.clear();
   core = nullptr;
 }
 
@@ -123,6 +127,7 @@ ServiceRegistrationBase ServiceRegistry::RegisterService(ModulePrivate* module,
           std::lower_bound(s.begin(), s.end(), res);
       s.insert(ip, res);
     }
+    propertyIndexes.clear();
   }
 
   ServiceReferenceBase r = res.GetReference(std::string());
@@ -145,6 +150,7 @@ void ServiceRegistry::UpdateServiceRegistrationOrder(const ServiceRegistrationBa
     s.erase(std::remove(s.begin(), s.end(), sr), s.end());
     s.insert(std::lower_bound(s.begin(), s.end(), sr), sr);
   }
+  propertyIndexes.clear();
 }
 
 void ServiceRegistry::Get(const std::string& clazz,
@@ -198,12 +204,14 @@ void ServiceRegistry::Get_unlocked(const std::string& clazz, const std::string&
   std::vector<ServiceRegistrationBase>::const_iterator s;
   std::vector<ServiceRegistrationBase>::const_iterator send;
   std::vector<ServiceRegistrationBase> v;
+  std::vector<std::size_t> positions;
+  bool useIndex = false;
   LDAPExpr ldap;
   if (clazz.empty())
   {
     if (!filter.empty())
     {
-      ldap = LDAPExpr(filter);
+      ldap = GetCompiledFilter_unlocked(filter).ldap;
       LDAPExpr::ObjectClassSet matched;
       if (ldap.GetMatchedObjectClasses(matched))
       {
@@ -253,17 +261,53 @@ void ServiceRegistry::Get_unlocked(const std::string& clazz, const std::string&
     }
     if (!filter.empty())
     {
-      ldap = LDAPExpr(filter);
+      const CompiledFilter& compiled = GetCompiledFilter_unlocked(filter);
+      ldap = compiled.ldap;
+
+      if (!compiled.indexKey.empty())
+      {
+        // Only services with one of the required property values can match,
+        // so the filter is evaluated for these candidates only.
+        const PropertyIndex& index = GetPropertyIndex_unlocked(clazz, compiled.indexKey, it->second);
+        positions = index.unindexedPositions;
+        for (LDAPExpr::ObjectClassSet::const_iterator value = compiled.indexValues.begin();
+             value != compiled.indexValues.end(); ++value)
+        {
+          US_UNORDERED_MAP_TYPE<std::string, std::vector<std::size_t> >::const_iterator i = index.positions.find(*value);
+          if (i != index.positions.end())
+          {
+            positions.insert(positions.end(), i->second.begin(), i->second.end());
+          }
+        }
+        // Keep the ranking order of classServices
+        std::sort(positions.begin(), positions.end());
+        positions.erase(std::unique(positions.begin(), positions.end()), positions.end());
+        useIndex = true;
+      }
     }
   }
 
-  for (; s != send; ++s)
+  if (useIndex)
   {
-    ServiceReferenceBase sri = s->GetReference(clazz);
-
-    if (filter.empty() || ldap.Evaluate(s->d->properties, false))
+    for (std::vector<std::size_t>::const_iterator i = positions.begin(); i != positions.end(); ++i)
+    {
+      const ServiceRegistrationBase& sr = *(s + *i);
+      if (ldap.Evaluate(sr.d->properties, false))
+      {
+        res.push_back(sr.GetReference(clazz));
+      }
+    }
+  }
+  else
+  {
+    for (; s != send; ++s)
     {
-      res.push_back(sri);
+      ServiceReferenceBase sri = s->GetReference(clazz);
+
+      if (filter.empty() || ldap.Evaluate(s->d->properties, false))
+      {
+        res.push_back(sri);
+      }
     }
   }
 
@@ -280,6 +324,99 @@ void ServiceRegistry::Get_unlocked(const std::string& clazz, const std::string&
   }
 }
 
+const ServiceRegistry::CompiledFilter& ServiceRegistry::GetCompiledFilter_unlocked(const std::string& filter) const
+{
+  MapFilterCache::const_iterator i = filterCache.find(filter);
+  if (i != filterCache.end())
+  {
+    return i->second;
+  }
+
+  // Filters are usually built from a small set of values, but
+  // make sure that arbitrary filters cannot exhaust the memory.
+  if (filterCache.size() >= 1024)
+  {
+    filterCache.clear();
+  }
+
+  CompiledFilter compiled;
+  compiled.ldap = LDAPExpr(filter); // throws std::invalid_argument for invalid filters
+
+  LDAPExpr::StringList attrNames;
+  compiled.ldap.GetEqualityAttributeNames(attrNames);
+  for (LDAPExpr::StringList::const_iterator attrName = attrNames.begin();
+       attrName != attrNames.end(); ++attrName)
+  {
+    // Services are already grouped by object class
+    if (attrName->size() == ServiceConstants::OBJECTCLASS().size() &&
+        std::equal(attrName->begin(), attrName->end(), ServiceConstants::OBJECTCLASS().begin(),
+                   [](char a, char b) { return ::tolower(a) == ::tolower(b); }))
+    {
+      continue;
+    }
+
+    LDAPExpr::ObjectClassSet values;
+    if (compiled.ldap.GetMatchedValues(*attrName, values))
+    {
+      compiled.indexKey = *attrName;
+      compiled.indexValues = values;
+      break;
+    }
+  }
+
+  return filterCache.insert(std::make_pair(filter, compiled)).first->second;
+}
+
+const ServiceRegistry::PropertyIndex& ServiceRegistry::GetPropertyIndex_unlocked(
+    const std::string& clazz, const std::string& key,
+    const std::vector<ServiceRegistrationBase>& serviceRegs) const
+{
+  US_UNORDERED_MAP_TYPE<std::string, PropertyIndex>& classIndexes = propertyIndexes[clazz];
+  US_UNORDERED_MAP_TYPE<std::string, PropertyIndex>::const_iterator i = classIndexes.find(key);
+  if (i != classIndexes.end())
+  {
+    return i->second;
+  }
+
+  PropertyIndex& index = classIndexes[key];
+  for (std::size_t pos = 0; pos < serviceRegs.size(); ++pos)
+  {
+    const ServicePropertiesImpl& props = serviceRegs[pos].d->properties;
+
+    // Same lookup as in LDAPExpr::Evaluate
+    int propIndex = props.FindCaseSensitive(key);
+    if (propIndex < 0) propIndex = props.Find(key);
+    if (propIndex < 0) continue; // cannot match an equality constraint
+
+    const Any& value = props.Value(propIndex);
+    if (value.Type() == typeid(std::string))
+    {
+      index.positions[ref_any_cast<std::string>(value)].push_back(pos);
+    }
+    else if (value.Type() == typeid(std::vector<std::string>))
+    {
+      const std::vector<std::string>& list = ref_any_cast<std::vector<std::string> >(value);
+      for (std::vector<std::string>::const_iterator item = list.begin(); item != list.end(); ++item)
+      {
+        index.positions[*item].push_back(pos);
+      }
+    }
+    else
+    {
+      // e.g. numbers, which are compared by value
+      index.unindexedPositions.push_back(pos);
+    }
+  }
+
+  return index;
+}
+
+void ServiceRegistry::InvalidatePropertyIndexes()
+{
+  MutexLock lock(mutex);
+  propertyIndexes.clear();
+}
+
 void ServiceRegistry::RemoveServiceRegistration(const ServiceRegistrationBase& sr)
 {
   MutexLock lock(mutex);
@@ -288,6 +425,7 @@ void ServiceRegistry::RemoveServiceRegistration(const ServiceRegistrationBase& s
   const std::vector<std::string>& classes = ref_any_cast<std::vector<std::string> >(
         sr.d->properties.Value(ServiceConstants::OBJECTCLASS()));
   services.erase(sr);
+  propertyIndexes.clear();
   serviceRegistrations.erase(std::remove(serviceRegistrations.begin(), serviceRegistrations.end(), sr),
                              serviceRegistrations.end());
   for (std::vector<std::string>::const_iterator i = classes.begin();
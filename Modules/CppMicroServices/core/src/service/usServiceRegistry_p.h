@@ -26,6 +26,7 @@
 #include "usServiceInterface.h"
 #include "usServiceRegistration.h"
 
+#include "usLDAPExpr_p.h"
 #include "usThreads_p.h"
 
 US_BEGIN_NAMESPACE
@@ -169,10 +170,59 @@ public:
    */
   void GetUsedByModule(Module* m, std::vector<ServiceRegistrationBase>& serviceRegs) const;
 
+  /**
+   * Discard the property indexes, e.g. because the properties of
+   * a registered service changed.
+   */
+  void InvalidatePropertyIndexes();
+
 private:
 
   friend class ServiceHooks;
 
+  /**
+   * A parsed filter string. If the filter requires a property to be equal
+   * to one of a set of values, the property is noted as index key.
+   */
+  struct CompiledFilter
+  {
+    LDAPExpr ldap;
+    std::string indexKey;
+    LDAPExpr::ObjectClassSet indexValues;
+  };
+
+  /**
+   * Positions in a vector of classServices, grouped by the (string)
+   * value of a service property. The positions of services which have
+   * a non-string value for the property are kept separately, since
+   * they need to be evaluated for any filter.
+   */
+  struct PropertyIndex
+  {
+    US_UNORDERED_MAP_TYPE<std::string, std::vector<std::size_t> > positions;
+    std::vector<std::size_t> unindexedPositions;
+  };
+
+  typedef US_UNORDERED_MAP_TYPE<std::string, CompiledFilter> MapFilterCache;
+  typedef US_UNORDERED_MAP_TYPE<std::string, US_UNORDERED_MAP_TYPE<std::string, PropertyIndex> > MapPropertyIndexes;
+
+  /**
+   * Cache of parsed filter strings, so that frequently used filters
+   * are not parsed over and over again.
+   */
+  mutable MapFilterCache filterCache;
+
+  /**
+   * Mapping of class name and property key to a lazily built index
+   * of the services registered under that class.
+   */
+  mutable MapPropertyIndexes propertyIndexes;
+
+  const CompiledFilter& GetCompiledFilter_unlocked(const std::string& filter) const;
+
+  const PropertyIndex& GetPropertyIndex_unlocked(const std::string& clazz, const std::string& key,
+                                                 const std::vector<ServiceRegistrationBase>& serviceRegs) const;
+
   void Get_unlocked(const std::string& clazz, std::vector<ServiceRegistrationBase>& serviceRegs) const;
 
   void Get_unlocked(const std::string& clazz, const std::string& filter,
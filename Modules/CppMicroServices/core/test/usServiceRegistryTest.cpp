@@ -20,6 +20,7 @@
 ============================================================================*/
 
 #include <usLDAPFilter.h>
+#include <usLDAPProp.h>
 
 #include "usTestingMacros.h"
 #include <usServiceInterface.h>
@@ -127,6 +128,68 @@ void TestServicePropertiesUpdate()
   US_TEST_CONDITION_REQUIRED(context->GetServiceReferences<ITestServiceA>().empty(), "Testing service count")
 }
 
+void TestFilteredServiceReferences()
+{
+  struct TestServiceA : public ITestServiceA
+  {
+  };
+
+  ModuleContext* context = GetModuleContext();
+
+  TestServiceA s1;
+  TestServiceA s2;
+  TestServiceA s3;
+  TestServiceA s4;
+
+  ServiceProperties props1;
+  props1["mimetype"] = std::string("text/plain");
+  ServiceProperties props2;
+  props2["mimetype"] = std::string("text/plain");
+  props2[ServiceConstants::SERVICE_RANKING()] = 10;
+  ServiceProperties props3;
+  props3["MimeType"] = std::vector<std::string>(1, std::string("image/png"));
+  ServiceProperties props4;
+  props4["mimetype"] = 42;
+
+  ServiceRegistration<ITestServiceA> reg1 = context->RegisterService<ITestServiceA>(&s1, props1);
+  ServiceRegistration<ITestServiceA> reg2 = context->RegisterService<ITestServiceA>(&s2, props2);
+  ServiceRegistration<ITestServiceA> reg3 = context->RegisterService<ITestServiceA>(&s3, props3);
+  ServiceRegistration<ITestServiceA> reg4 = context->RegisterService<ITestServiceA>(&s4, props4);
+
+  const std::string textFilter = LDAPProp(ServiceConstants::OBJECTCLASS()) == us_service_interface_iid<ITestServiceA>() &&
+                                 LDAPProp("mimetype") == "text/plain";
+
+  // query twice, the second query uses the cached filter and index
+  for (int i = 0; i < 2; ++i)
+  {
+    std::vector<ServiceReference<ITestServiceA> > refs = context->GetServiceReferences<ITestServiceA>(textFilter);
+    US_TEST_CONDITION_REQUIRED(refs.size() == 2, "Testing filter on string property")
+    US_TEST_CONDITION(context->GetService(refs.back()) == &s2, "Testing ranking order of filtered services")
+  }
+
+  std::vector<ServiceReference<ITestServiceA> > refs =
+    context->GetServiceReferences<ITestServiceA>("(|(mimetype=image/png)(mimetype=42))");
+  US_TEST_CONDITION(refs.size() == 2, "Testing filter on list and numeric properties")
+
+  refs = context->GetServiceReferences<ITestServiceA>("(mimetype=text/*)");
+  US_TEST_CONDITION(refs.size() == 2, "Testing filter with wildcard")
+
+  props1["mimetype"] = std::string("image/png");
+  reg1.SetProperties(props1);
+
+  refs = context->GetServiceReferences<ITestServiceA>(textFilter);
+  US_TEST_CONDITION(refs.size() == 1, "Testing filter after property update")
+  refs = context->GetServiceReferences<ITestServiceA>("(mimetype=image/png)");
+  US_TEST_CONDITION(refs.size() == 2, "Testing filter after property update")
+
+  reg2.Unregister();
+  refs = context->GetServiceReferences<ITestServiceA>(textFilter);
+  US_TEST_CONDITION(refs.empty(), "Testing filter after unregistering a service")
+
+  reg1.Unregister();
+  reg3.Unregister();
+  reg4.Unregister();
+}
 
 int usServiceRegistryTest(int /*argc*/, char* /*argv*/[])
 {
@@ -135,6 +198,7 @@ int usServiceRegistryTest(int /*argc*/, char* /*argv*/[])
   TestServiceInterfaceId();
   TestMultipleServiceRegistrations();
   TestServicePropertiesUpdate();
+  TestFilteredServiceReferences();
 
   US_TEST_END()
 }
@@ -19,6 +19,8 @@ found in the LICENSE file.
 #include "mitkDICOMEnums.h"
 #include "mitkDICOMGenericTagCache.h"
 
+class DcmPathProcessor;
+
 namespace mitk
 {
 
@@ -27,6 +29,10 @@ namespace mitk
     \brief Encapsulates the tag scanning process for a set of DICOM files.
 
     For the scanning process it uses DCMTK functionality.
+
+    If none of the scanned tag paths points to or behind the pixel data element,
+    the files are only parsed up to the pixel data. Use SetNumberOfWorkers() to
+    scan the files with several threads.
   */
   class MITKDICOM_EXPORT DICOMDCMTKTagScanner : public DICOMTagScanner
   {
@@ -83,6 +89,13 @@ namespace mitk
       DICOMDCMTKTagScanner();
       ~DICOMDCMTKTagScanner() override;
 
+      /**
+        \brief Scans one file for all tags of interest. Returns nullptr if the file
+        is a directory or could not be read; in the latter case errorMessage is set.
+        Can be called concurrently with different processors.
+      */
+      DICOMDatasetAccessingImageFrameInfo::Pointer ScanFile(const std::string& fileName, DcmPathProcessor& processor, bool stopAtPixelData, std::string& errorMessage) const;
+
       std::set<DICOMTagPath> m_ScannedTags;
       StringList m_InputFilenames;
       DICOMGenericTagCache::Pointer m_Cache;
@@ -43,8 +43,17 @@ namespace mitk
 
       void InitCache(const std::set<DICOMTag>& scannedTags, const std::shared_ptr<gdcm::Scanner>& scanner, const StringList& inputFiles);
 
+      /** Initializes the cache with the results of several scanners, each of them having
+       scanned a subset of the input files (e.g. by parallel scanning). The values of a file
+       are taken from the first scanner that contains the file.*/
+      void InitCache(const std::set<DICOMTag>& scannedTags, const std::vector<std::shared_ptr<gdcm::Scanner>>& scanners, const StringList& inputFiles);
+
+      /** Returns the (first) scanner that was used to fill the cache.*/
       const gdcm::Scanner& GetScanner() const;
 
+      /** Returns all scanners that were used to fill the cache.*/
+      const std::vector<std::shared_ptr<gdcm::Scanner>>& GetScanners() const;
+
   protected:
 
       DICOMGDCMTagCache();
@@ -52,7 +61,7 @@ namespace mitk
 
       std::set<DICOMTag> m_ScannedTags;
 
-      std::shared_ptr<gdcm::Scanner> m_Scanner;
+      std::vector<std::shared_ptr<gdcm::Scanner>> m_Scanners;
 
       DICOMDatasetAccessingImageFrameList m_ScanResult;
 
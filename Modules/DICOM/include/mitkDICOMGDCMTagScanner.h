@@ -41,6 +41,9 @@ namespace mitk
     results, care should be taken that all the tags and files of interest
     are communicated to DICOMGDCMTagScanner before requesting the results!
 
+    If more than one worker is requested (see SetNumberOfWorkers()), the files are
+    split into shards that are scanned by separate gdcm::Scanner instances in parallel.
+
     @remark This scanner does only support the scanning for simple value tag.
     If you need to scann for sequence items or non-top-level elements, this scanner
     will not be sufficient. See i.a. DICOMDCMTKTagScanner for these cases.
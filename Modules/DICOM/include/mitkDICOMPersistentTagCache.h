@@ -0,0 +1,125 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#ifndef mitkDICOMPersistentTagCache_h
+#define mitkDICOMPersistentTagCache_h
+
+#include <map>
+#include <set>
+
+#include "mitkDICOMGenericTagCache.h"
+#include "mitkDICOMTagPath.h"
+
+namespace mitk
+{
+
+  /**
+    \ingroup DICOMModule
+    \brief Tag cache that persists the scanned tag values in a flat binary file.
+
+    The cache stores the values of all scanned tag paths per file, together with
+    the size and the modification time of the file. When Update() is called for a
+    list of files, only files that are new, have changed (size or modification time)
+    or lack some of the requested tag paths are scanned again. All other values are
+    taken from the cache file. Afterwards the cache file is rewritten if anything changed;
+    entries of files that no longer exist are dropped when the file is written.
+
+    Files whose requested tag paths are all explicit single tags are (re)scanned with
+    DICOMGDCMTagScanner, so the values are identical to the values DICOMITKSeriesGDCMReader
+    would get by scanning itself. Other tag paths are scanned with DICOMDCMTKTagScanner.
+
+    Readers (DICOMITKSeriesGDCMReader, DICOMFileReaderSelector) use the persistent cache
+    automatically if a cache directory is set (see SetCacheDirectory()).
+
+    The frame info list of the cache contains one entry per input file in the order
+    of the input files.
+  */
+  class MITKDICOM_EXPORT DICOMPersistentTagCache : public DICOMGenericTagCache
+  {
+    public:
+
+      mitkClassMacro(DICOMPersistentTagCache, DICOMGenericTagCache);
+      itkFactorylessNewMacro( DICOMPersistentTagCache );
+
+      /** File the cache is read from and written to.*/
+      itkSetStringMacro(CacheFile);
+      itkGetStringMacro(CacheFile);
+
+      /** Number of files that had to be scanned by the last call of Update().*/
+      itkGetConstMacro(NumberOfScannedFiles, std::size_t);
+
+      /** Number of files the cache holds values for (including files not passed to the last Update()).*/
+      std::size_t GetNumberOfCachedFiles() const;
+
+      /**
+        \brief Makes the cache valid for the passed files and tag paths.
+        Loads the cache file (if not already loaded), scans all files that are
+        not validly cached and rewrites the cache file if needed.
+        Errors while reading or writing the cache file are reported as warnings;
+        the cache then behaves like a normal (not persistent) tag cache.
+      */
+      void Update(const StringList& inputFiles, const DICOMTagPathList& tagPaths);
+
+      /**
+        \brief Directory where the cache files of the readers are stored.
+        If no directory was set, the value of the environment variable
+        MITK_DICOM_TAG_CACHE_DIR is used. An empty directory disables the
+        persistent caching of the readers.
+      */
+      static void SetCacheDirectory(const std::string& directory);
+      static std::string GetCacheDirectory();
+
+      /** Returns true if a cache directory is defined.*/
+      static bool IsEnabled();
+
+      /** Returns the cache file that should be used for the given input files
+       (one cache file per directory in the cache directory). Returns an empty string
+       if no cache directory is defined.*/
+      static std::string GetDefaultCacheFile(const StringList& inputFiles);
+
+    protected:
+
+      DICOMPersistentTagCache();
+      ~DICOMPersistentTagCache() override;
+
+      struct CacheEntry
+      {
+        std::uint64_t size = 0;
+        std::int64_t modificationTime = 0;
+        std::set<DICOMTagPath> scannedPaths;
+        std::vector<std::pair<DICOMTagPath, std::string>> values;
+      };
+
+      using EntryMapType = std::map<std::string, CacheEntry>;
+
+      /** Reads the cache file into m_Entries. Returns false if the file could not be read.*/
+      bool ReadCacheFile();
+      /** Writes m_Entries to the cache file. Returns false if the file could not be written.*/
+      bool WriteCacheFile() const;
+
+      /** Removes the entries of files that do not exist anymore.*/
+      void PruneEntries();
+
+      /** Scans the passed files for the passed paths and stores the results in m_Entries.*/
+      void ScanFiles(const StringList& files, const std::set<DICOMTagPath>& paths);
+
+      std::string m_CacheFile;
+      std::string m_LoadedCacheFile;
+      EntryMapType m_Entries;
+      std::size_t m_NumberOfScannedFiles;
+
+    private:
+      DICOMPersistentTagCache(const DICOMPersistentTagCache&);
+  };
+}
+
+#endif
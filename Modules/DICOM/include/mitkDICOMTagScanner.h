@@ -15,6 +15,7 @@ found in the LICENSE file.
 
 #include <stack>
 #include <mutex>
+#include <functional>
 
 #include "mitkDICOMEnums.h"
 #include "mitkDICOMTagPath.h"
@@ -38,6 +39,11 @@ namespace mitk
     @remark When used in a process where multiple classes will access the scan
     results, care should be taken that all the tags and files of interest
     are communicated to DICOMTagScanner before requesting the results!
+
+    Scanners may distribute the input files over several worker threads
+    (see SetNumberOfWorkers()). The files are split into contiguous shards,
+    so the scan results are always in the order of the input files,
+    regardless of the number of workers.
   */
   class MITKDICOM_EXPORT DICOMTagScanner : public itk::Object
   {
@@ -86,8 +92,33 @@ namespace mitk
       */
       virtual DICOMTagCache::Pointer GetScanCache() const = 0;
 
+      /**
+      \brief Number of worker threads that are used by Scan().
+      1 (default) scans all files sequentially in the calling thread.
+      0 uses as many workers as hardware threads are available.
+      */
+      itkSetMacro(NumberOfWorkers, unsigned int);
+      itkGetConstMacro(NumberOfWorkers, unsigned int);
+
     protected:
 
+      /** Function that processes the files [begin, end) of one shard. */
+      using ShardFunctionType = std::function<void(unsigned int shard, std::size_t begin, std::size_t end)>;
+
+      /**
+      \brief Returns the number of shards the given number of files will be split into
+      by ProcessShards() (depends on NumberOfWorkers).
+      */
+      unsigned int GetNumberOfShards(std::size_t numberOfFiles) const;
+
+      /**
+      \brief Splits numberOfFiles into contiguous shards and calls shardFunction for every
+      shard. If more than one shard is used, each shard is processed in its own thread.
+      The call returns when all shards are processed. The first exception thrown by a
+      shard function is rethrown in the calling thread.
+      */
+      void ProcessShards(std::size_t numberOfFiles, const ShardFunctionType& shardFunction) const;
+
       /** \brief Return active C locale */
       static std::string GetActiveLocale();
       /**
@@ -104,6 +135,8 @@ namespace mitk
       DICOMTagScanner();
       ~DICOMTagScanner() override;
 
+      unsigned int m_NumberOfWorkers;
+
     private:
 
       static std::mutex s_LocaleMutex;
@@ -17,6 +17,7 @@ found in the LICENSE file.
 
 #include <dcmtk/dcmdata/dcfilefo.h>
 #include <dcmtk/dcmdata/dcpath.h>
+#include <dcmtk/dcmdata/dcdeftag.h>
 
 mitk::DICOMDCMTKTagScanner::DICOMDCMTKTagScanner()
 {
@@ -100,65 +101,127 @@ mitk::DICOMTagPath DcmPathToTagPath(DcmPath * dcmpath)
   return result;
 }
 
-void mitk::DICOMDCMTKTagScanner::Scan()
+namespace
 {
-  this->PushLocale();
-
-  try
+  /** Checks if all scanned tag paths are located before the pixel data element.
+   If this is the case, the parsing of the files can be stopped at the pixel data.*/
+  bool AllTagsBeforePixelData(const std::set<mitk::DICOMTagPath>& paths)
   {
-    DcmPathProcessor processor;
-    processor.setItemWildcardSupport(true);
+    const DcmTagKey pixelData = DCM_PixelData;
 
-    DICOMGenericTagCache::Pointer newCache = DICOMGenericTagCache::New();
-
-    for (const auto& fileName : this->m_InputFilenames)
+    for (const auto& path : paths)
     {
-      if (fs::is_directory(fileName))
+      if (path.Size() == 0)
         continue;
 
-      DcmFileFormat dfile;
-      OFCondition cond = dfile.loadFile(fileName.c_str());
-      if (cond.bad())
+      const auto& node = path.GetFirstNode();
+      if (node.type == mitk::DICOMTagPath::NodeInfo::NodeType::AnyElement
+          || node.type == mitk::DICOMTagPath::NodeInfo::NodeType::Invalid)
       {
-        MITK_ERROR << "Error when scanning for tags. Cannot open given file. File: " << fileName;
+        return false;
       }
-      else
+
+      if (DcmTagKey(node.tag.GetGroup(), node.tag.GetElement()) >= pixelData)
       {
-        DICOMGenericImageFrameInfo::Pointer info = DICOMGenericImageFrameInfo::New(fileName);
+        return false;
+      }
+    }
 
-        for (const auto& path : this->m_ScannedTags)
+    return true;
+  }
+}
+
+mitk::DICOMDatasetAccessingImageFrameInfo::Pointer
+mitk::DICOMDCMTKTagScanner::ScanFile(const std::string& fileName, DcmPathProcessor& processor, bool stopAtPixelData, std::string& errorMessage) const
+{
+  if (fs::is_directory(fileName))
+    return nullptr;
+
+  DcmFileFormat dfile;
+  OFCondition cond = stopAtPixelData
+    ? dfile.loadFileUntilTag(fileName.c_str(), EXS_Unknown, EGL_noChange, DCM_MaxReadLength, ERM_autoDetect, DCM_PixelData)
+    : dfile.loadFile(fileName.c_str());
+
+  if (cond.bad())
+  {
+    errorMessage = "Error when scanning for tags. Cannot open given file. File: " + fileName;
+    return nullptr;
+  }
+
+  DICOMGenericImageFrameInfo::Pointer info = DICOMGenericImageFrameInfo::New(fileName);
+
+  for (const auto& path : this->m_ScannedTags)
+  {
+    std::string tagPath = DICOMTagPathToDCMTKSearchPath(path);
+    cond = processor.findOrCreatePath(dfile.getDataset(), tagPath.c_str());
+    if (cond.good())
+    {
+      OFList< DcmPath * > findings;
+      processor.getResults(findings);
+      for (const auto& finding : findings)
+      {
+        auto element = dynamic_cast<DcmElement*>(finding->back()->m_obj);
+        if (!element)
         {
-          std::string tagPath = DICOMTagPathToDCMTKSearchPath(path);
-          cond = processor.findOrCreatePath(dfile.getDataset(), tagPath.c_str());
+          auto item = dynamic_cast<DcmItem*>(finding->back()->m_obj);
+          if (item)
+          {
+            element = item->getElement(finding->back()->m_itemNo);
+          }
+        }
+
+        if (element)
+        {
+          OFString value;
+          cond = element->getOFStringArray(value);
           if (cond.good())
           {
-            OFList< DcmPath * > findings;
-            processor.getResults(findings);
-            for (const auto& finding : findings)
-            {
-              auto element = dynamic_cast<DcmElement*>(finding->back()->m_obj);
-              if (!element)
-              {
-                auto item = dynamic_cast<DcmItem*>(finding->back()->m_obj);
-                if (item)
-                {
-                  element = item->getElement(finding->back()->m_itemNo);
-                }
-              }
-
-              if (element)
-              {
-                OFString value;
-                cond = element->getOFStringArray(value);
-                if (cond.good())
-                {
-                  info->SetTagValue(DcmPathToTagPath(finding), std::string(value.c_str()));
-                }
-              }
-            }
+            info->SetTagValue(DcmPathToTagPath(finding), std::string(value.c_str()));
           }
         }
-        newCache->AddFrameInfo(info);
+      }
+    }
+  }
+
+  return info.GetPointer();
+}
+
+void mitk::DICOMDCMTKTagScanner::Scan()
+{
+  this->PushLocale();
+
+  try
+  {
+    const bool stopAtPixelData = AllTagsBeforePixelData(this->m_ScannedTags);
+    const auto numberOfFiles = this->m_InputFilenames.size();
+
+    // Results are stored by file index, so the order of the cache does not
+    // depend on the number of workers.
+    std::vector<DICOMDatasetAccessingImageFrameInfo::Pointer> infos(numberOfFiles);
+    std::vector<std::string> errors(numberOfFiles);
+
+    this->ProcessShards(numberOfFiles, [this, stopAtPixelData, &infos, &errors](unsigned int, std::size_t begin, std::size_t end)
+    {
+      DcmPathProcessor processor;
+      processor.setItemWildcardSupport(true);
+
+      for (auto pos = begin; pos < end; ++pos)
+      {
+        infos[pos] = this->ScanFile(this->m_InputFilenames[pos], processor, stopAtPixelData, errors[pos]);
+      }
+    });
+
+    DICOMGenericTagCache::Pointer newCache = DICOMGenericTagCache::New();
+
+    for (std::size_t pos = 0; pos < numberOfFiles; ++pos)
+    {
+      if (!errors[pos].empty())
+      {
+        MITK_ERROR << errors[pos];
+      }
+      else if (infos[pos].IsNotNull())
+      {
+        newCache->AddFrameInfo(infos[pos]);
       }
     }
 
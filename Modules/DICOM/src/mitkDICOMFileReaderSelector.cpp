@@ -13,6 +13,7 @@ found in the LICENSE file.
 #include "mitkDICOMFileReaderSelector.h"
 #include "mitkDICOMReaderConfigurator.h"
 #include "mitkDICOMGDCMTagScanner.h"
+#include "mitkDICOMPersistentTagCache.h"
 
 #include <usModuleContext.h>
 #include <usGetModuleContext.h>
@@ -189,23 +190,37 @@ mitk::DICOMFileReaderSelector
   ReaderList workingCandidates;
 
   // do the tag scanning externally and just ONCE
-  DICOMGDCMTagScanner::Pointer gdcmScanner = DICOMGDCMTagScanner::New();
-  gdcmScanner->SetInputFiles( m_InputFilenames );
-
-  // let all readers analyze the file set
+  DICOMTagPathList tagsOfInterest;
   for ( auto rIter = m_Readers.cbegin(); rIter != m_Readers.cend(); ++rIter )
   {
-    gdcmScanner->AddTagPaths((*rIter)->GetTagsOfInterest());
+    const auto readerTags = (*rIter)->GetTagsOfInterest();
+    tagsOfInterest.insert(tagsOfInterest.end(), readerTags.cbegin(), readerTags.cend());
   }
 
-  gdcmScanner->Scan();
+  DICOMTagCache::Pointer tagCache;
+  if ( DICOMPersistentTagCache::IsEnabled() )
+  {
+    // reuse the values of previous scans of the same files
+    DICOMPersistentTagCache::Pointer persistentCache = DICOMPersistentTagCache::New();
+    persistentCache->SetCacheFile( DICOMPersistentTagCache::GetDefaultCacheFile( m_InputFilenames ) );
+    persistentCache->Update( m_InputFilenames, tagsOfInterest );
+    tagCache = persistentCache.GetPointer();
+  }
+  else
+  {
+    DICOMGDCMTagScanner::Pointer gdcmScanner = DICOMGDCMTagScanner::New();
+    gdcmScanner->SetInputFiles( m_InputFilenames );
+    gdcmScanner->AddTagPaths( tagsOfInterest );
+    gdcmScanner->Scan();
+    tagCache = gdcmScanner->GetScanCache();
+  }
 
   // let all readers analyze the file set
   unsigned int readerIndex(0);
   for ( auto rIter = m_Readers.cbegin(); rIter != m_Readers.cend(); ++readerIndex, ++rIter )
   {
     (*rIter)->SetInputFiles( m_InputFilenames );
-    (*rIter)->SetTagCache( gdcmScanner->GetScanCache() );
+    (*rIter)->SetTagCache( tagCache );
     try
     {
       (*rIter)->AnalyzeInputFiles();
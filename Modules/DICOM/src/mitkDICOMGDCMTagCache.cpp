@@ -14,6 +14,8 @@ found in the LICENSE file.
 #include "mitkDICOMEnums.h"
 #include "mitkDICOMGDCMImageFrameInfo.h"
 
+#include <algorithm>
+
 mitk::DICOMGDCMTagCache::DICOMGDCMTagCache()
 {
 }
@@ -83,22 +85,50 @@ mitk::DICOMDatasetAccessingImageFrameList mitk::DICOMGDCMTagCache::GetFrameInfoL
 void
 mitk::DICOMGDCMTagCache::InitCache(const std::set<DICOMTag>& scannedTags, const std::shared_ptr<gdcm::Scanner>& scanner, const StringList& inputFiles)
 {
+  this->InitCache(scannedTags, std::vector<std::shared_ptr<gdcm::Scanner>>({ scanner }), inputFiles);
+}
+
+void
+mitk::DICOMGDCMTagCache::InitCache(const std::set<DICOMTag>& scannedTags, const std::vector<std::shared_ptr<gdcm::Scanner>>& scanners, const StringList& inputFiles)
+{
+  if (scanners.empty())
+  {
+    mitkThrow() << "Invalid call to DICOMGDCMTagCache::InitCache(). No scanner passed.";
+  }
+
   m_ScannedTags = scannedTags;
   m_InputFilenames = inputFiles;
-  m_Scanner = scanner;
+  m_Scanners = scanners;
 
   m_ScanResult.clear();
   m_ScanResult.reserve(m_InputFilenames.size());
 
   for (auto inputIter = m_InputFilenames.cbegin(); inputIter != m_InputFilenames.cend(); ++inputIter)
   {
+    auto scanner = m_Scanners.front();
+    if (m_Scanners.size() > 1)
+    {
+      auto finding = std::find_if(m_Scanners.cbegin(), m_Scanners.cend(),
+        [inputIter](const std::shared_ptr<gdcm::Scanner>& candidate) { return candidate->IsKey(inputIter->c_str()); });
+      if (finding != m_Scanners.cend())
+      {
+        scanner = *finding;
+      }
+    }
+
     m_ScanResult.push_back(DICOMGDCMImageFrameInfo::New(DICOMImageFrameInfo::New(*inputIter, 0),
-      m_Scanner->GetMapping(inputIter->c_str())).GetPointer());
+      scanner->GetMapping(inputIter->c_str())).GetPointer());
   }
 }
 
 const gdcm::Scanner&
 mitk::DICOMGDCMTagCache::GetScanner() const
 {
-  return *(this->m_Scanner);
+  return *(this->m_Scanners.front());
+}
+
+const std::vector<std::shared_ptr<gdcm::Scanner>>&
+mitk::DICOMGDCMTagCache::GetScanners() const
+{
+  return this->m_Scanners;
 }
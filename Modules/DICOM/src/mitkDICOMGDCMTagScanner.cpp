@@ -93,10 +93,36 @@ void mitk::DICOMGDCMTagScanner::SetInputFiles( const StringList& filenames )
 void mitk::DICOMGDCMTagScanner::Scan()
 {
   // TODO integrate push/pop locale??
-  m_GDCMScanner->Scan( m_InputFilenames );
-
   DICOMGDCMTagCache::Pointer newCache = DICOMGDCMTagCache::New();
-  newCache->InitCache(m_ScannedTags, m_GDCMScanner, m_InputFilenames);
+
+  const auto numberOfShards = this->GetNumberOfShards(m_InputFilenames.size());
+
+  if (numberOfShards == 1)
+  {
+    m_GDCMScanner->Scan( m_InputFilenames );
+    newCache->InitCache(m_ScannedTags, m_GDCMScanner, m_InputFilenames);
+  }
+  else
+  {
+    // every shard gets its own gdcm::Scanner; the cache keeps all of them alive
+    // because the frame infos reference the values owned by the scanners.
+    std::vector<std::shared_ptr<gdcm::Scanner>> scanners(numberOfShards);
+
+    this->ProcessShards(m_InputFilenames.size(), [this, &scanners](unsigned int shard, std::size_t begin, std::size_t end)
+    {
+      auto scanner = std::make_shared<gdcm::Scanner>();
+      for (const auto& tag : m_ScannedTags)
+      {
+        scanner->AddTag(gdcm::Tag(tag.GetGroup(), tag.GetElement()));
+      }
+
+      gdcm::Directory::FilenamesType shardFiles(m_InputFilenames.begin() + begin, m_InputFilenames.begin() + end);
+      scanner->Scan(shardFiles);
+      scanners[shard] = scanner;
+    });
+
+    newCache->InitCache(m_ScannedTags, scanners, m_InputFilenames);
+  }
 
   m_Cache = newCache;
 }
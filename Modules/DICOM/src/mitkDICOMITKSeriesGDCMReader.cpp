@@ -20,6 +20,7 @@ found in the LICENSE file.
 #include "mitkGantryTiltInformation.h"
 #include "mitkDICOMTagBasedSorter.h"
 #include "mitkDICOMGDCMTagScanner.h"
+#include "mitkDICOMPersistentTagCache.h"
 
 std::mutex mitk::DICOMITKSeriesGDCMReader::s_LocaleMutex;
 
@@ -235,16 +236,31 @@ void mitk::DICOMITKSeriesGDCMReader::AnalyzeInputFiles()
   if ( m_TagCache.IsNull() || ( m_TagCache->GetMTime()<this->GetMTime() && !m_ExternalCache ))
   {
     timeStart( "Tag scanning" );
-    DICOMGDCMTagScanner::Pointer filescanner = DICOMGDCMTagScanner::New();
+    if ( DICOMPersistentTagCache::IsEnabled() )
+    {
+      // only new or changed files are scanned, all other values come from the cache file
+      DICOMPersistentTagCache::Pointer persistentCache = DICOMPersistentTagCache::New();
+      persistentCache->SetCacheFile( DICOMPersistentTagCache::GetDefaultCacheFile( inputFilenames ) );
 
-    filescanner->SetInputFiles( inputFilenames );
-    filescanner->AddTagPaths( this->GetTagsOfInterest() );
+      PushLocale();
+      persistentCache->Update( inputFilenames, this->GetTagsOfInterest() );
+      PopLocale();
 
-    PushLocale();
-    filescanner->Scan();
-    PopLocale();
+      m_TagCache = persistentCache.GetPointer(); // keep alive and make accessible to sub-classes
+    }
+    else
+    {
+      DICOMGDCMTagScanner::Pointer filescanner = DICOMGDCMTagScanner::New();
 
-    m_TagCache = filescanner->GetScanCache(); // keep alive and make accessible to sub-classes
+      filescanner->SetInputFiles( inputFilenames );
+      filescanner->AddTagPaths( this->GetTagsOfInterest() );
+
+      PushLocale();
+      filescanner->Scan();
+      PopLocale();
+
+      m_TagCache = filescanner->GetScanCache(); // keep alive and make accessible to sub-classes
+    }
 
     timeStop("Tag scanning");
   }
@@ -0,0 +1,528 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include "mitkDICOMPersistentTagCache.h"
+#include "mitkDICOMGDCMTagScanner.h"
+#include "mitkDICOMDCMTKTagScanner.h"
+
+#include <mitkFileSystem.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <mutex>
+#include <random>
+#include <sstream>
+#include <thread>
+
+namespace
+{
+  const char CacheFileMagic[8] = { 'M', 'I', 'T', 'K', 'D', 'T', 'C', '\0' };
+  const std::uint32_t CacheFileVersion = 1;
+
+  /** 64 bit FNV-1a hash. Unlike std::hash, it is identical for all builds and standard
+   * libraries, so the cache file names of a directory stay stable.*/
+  std::uint64_t HashFNV1a(const std::string& value)
+  {
+    std::uint64_t hash = 14695981039346656037ULL;
+    for (const auto c : value)
+    {
+      hash ^= static_cast<unsigned char>(c);
+      hash *= 1099511628211ULL;
+    }
+    return hash;
+  }
+
+  /** Name of a temporary file next to the passed file that is unique per writer
+   * (process and thread), so concurrent writers never share a temporary file.*/
+  std::string GetUniqueTemporaryFileName(const std::string& file)
+  {
+    static std::atomic<std::uint64_t> counter(0);
+    static const std::uint64_t seed = (static_cast<std::uint64_t>(std::random_device()()) << 32) ^ std::random_device()();
+
+    std::ostringstream name;
+    name << file << '.' << std::hex << seed << '.' << std::this_thread::get_id() << '.' << counter++ << ".tmp";
+    return name.str();
+  }
+
+  std::mutex s_CacheDirectoryMutex;
+  bool s_CacheDirectoryIsSet = false;
+  std::string s_CacheDirectory;
+
+  template <typename T>
+  void WriteValue(std::ostream& stream, T value)
+  {
+    stream.write(reinterpret_cast<const char*>(&value), sizeof(T));
+  }
+
+  template <typename T>
+  T ReadValue(std::istream& stream)
+  {
+    T value = T();
+    stream.read(reinterpret_cast<char*>(&value), sizeof(T));
+    if (!stream)
+    {
+      mitkThrow() << "Unexpected end of DICOM tag cache file.";
+    }
+    return value;
+  }
+
+  void WriteString(std::ostream& stream, const std::string& value)
+  {
+    WriteValue<std::uint32_t>(stream, static_cast<std::uint32_t>(value.size()));
+    stream.write(value.data(), value.size());
+  }
+
+  std::string ReadString(std::istream& stream)
+  {
+    const auto size = ReadValue<std::uint32_t>(stream);
+    std::string value(size, '\0');
+    stream.read(&value[0], size);
+    if (!stream)
+    {
+      mitkThrow() << "Unexpected end of DICOM tag cache file.";
+    }
+    return value;
+  }
+
+  void WritePath(std::ostream& stream, const mitk::DICOMTagPath& path)
+  {
+    WriteValue<std::uint32_t>(stream, static_cast<std::uint32_t>(path.Size()));
+    for (const auto& node : path.GetNodes())
+    {
+      WriteValue<std::uint8_t>(stream, static_cast<std::uint8_t>(node.type));
+      WriteValue<std::uint16_t>(stream, static_cast<std::uint16_t>(node.tag.GetGroup()));
+      WriteValue<std::uint16_t>(stream, static_cast<std::uint16_t>(node.tag.GetElement()));
+      WriteValue<std::int32_t>(stream, static_cast<std::int32_t>(node.selection));
+    }
+  }
+
+  mitk::DICOMTagPath ReadPath(std::istream& stream)
+  {
+    mitk::DICOMTagPath path;
+    const auto size = ReadValue<std::uint32_t>(stream);
+    for (std::uint32_t i = 0; i < size; ++i)
+    {
+      const auto type = static_cast<mitk::DICOMTagPath::NodeInfo::NodeType>(ReadValue<std::uint8_t>(stream));
+      const auto group = ReadValue<std::uint16_t>(stream);
+      const auto element = ReadValue<std::uint16_t>(stream);
+      const auto selection = ReadValue<std::int32_t>(stream);
+      path.AddNode(mitk::DICOMTagPath::NodeInfo(mitk::DICOMTag(group, element), type, selection));
+    }
+    return path;
+  }
+
+  /** Determines size and modification time of a file. Returns false if the file
+   cannot be accessed.*/
+  bool GetFileStamp(const std::string& fileName, std::uint64_t& size, std::int64_t& modificationTime)
+  {
+    std::error_code error;
+    size = static_cast<std::uint64_t>(fs::file_size(fileName, error));
+    if (error)
+      return false;
+
+    const auto time = fs::last_write_time(fileName, error);
+    if (error)
+      return false;
+
+    modificationTime = static_cast<std::int64_t>(time.time_since_epoch().count());
+    return true;
+  }
+}
+
+mitk::DICOMPersistentTagCache::DICOMPersistentTagCache() : m_NumberOfScannedFiles(0)
+{
+}
+
+mitk::DICOMPersistentTagCache::~DICOMPersistentTagCache()
+{
+}
+
+void mitk::DICOMPersistentTagCache::SetCacheDirectory(const std::string& directory)
+{
+  std::lock_guard<std::mutex> lock(s_CacheDirectoryMutex);
+  s_CacheDirectory = directory;
+  s_CacheDirectoryIsSet = true;
+}
+
+std::string mitk::DICOMPersistentTagCache::GetCacheDirectory()
+{
+  std::lock_guard<std::mutex> lock(s_CacheDirectoryMutex);
+  if (!s_CacheDirectoryIsSet)
+  {
+    const char* directory = std::getenv("MITK_DICOM_TAG_CACHE_DIR");
+    return nullptr != directory ? std::string(directory) : std::string();
+  }
+  return s_CacheDirectory;
+}
+
+bool mitk::DICOMPersistentTagCache::IsEnabled()
+{
+  return !GetCacheDirectory().empty();
+}
+
+std::string mitk::DICOMPersistentTagCache::GetDefaultCacheFile(const StringList& inputFiles)
+{
+  const auto directory = GetCacheDirectory();
+  if (directory.empty() || inputFiles.empty())
+  {
+    return std::string();
+  }
+
+  const auto inputDirectory = fs::absolute(fs::path(inputFiles.front())).parent_path().string();
+
+  std::ostringstream fileName;
+  fileName << "dicomtags_" << std::hex << std::setw(16) << std::setfill('0') << HashFNV1a(inputDirectory) << ".cache";
+
+  return (fs::path(directory) / fileName.str()).string();
+}
+
+void mitk::DICOMPersistentTagCache::Update(const StringList& inputFiles, const DICOMTagPathList& tagPaths)
+{
+  if (!m_CacheFile.empty() && m_CacheFile != m_LoadedCacheFile)
+  {
+    m_Entries.clear();
+    if (fs::exists(m_CacheFile) && !this->ReadCacheFile())
+    {
+      m_Entries.clear();
+    }
+    m_LoadedCacheFile = m_CacheFile;
+  }
+
+  const std::set<DICOMTagPath> requestedPaths(tagPaths.begin(), tagPaths.end());
+
+  StringList filesToScan;
+  for (const auto& fileName : inputFiles)
+  {
+    std::uint64_t size = 0;
+    std::int64_t modificationTime = 0;
+    const bool accessible = GetFileStamp(fileName, size, modificationTime);
+
+    auto finding = m_Entries.find(fileName);
+    bool valid = accessible && finding != m_Entries.end() && finding->second.size == size
+      && finding->second.modificationTime == modificationTime;
+
+    if (valid)
+    {
+      for (const auto& path : requestedPaths)
+      {
+        if (finding->second.scannedPaths.find(path) == finding->second.scannedPaths.end())
+        {
+          valid = false;
+          break;
+        }
+      }
+    }
+
+    if (!valid)
+    {
+      filesToScan.push_back(fileName);
+    }
+  }
+
+  m_NumberOfScannedFiles = filesToScan.size();
+
+  if (!filesToScan.empty())
+  {
+    // Rescanned files get the union of all paths known to the cache, so that
+    // readers with other tags of interest can reuse the entries as well.
+    std::set<DICOMTagPath> scanPaths = requestedPaths;
+    for (const auto& entry : m_Entries)
+    {
+      scanPaths.insert(entry.second.scannedPaths.begin(), entry.second.scannedPaths.end());
+    }
+
+    this->ScanFiles(filesToScan, scanPaths);
+
+    if (!m_CacheFile.empty())
+    {
+      this->PruneEntries();
+
+      if (!this->WriteCacheFile())
+      {
+        MITK_WARN << "Cannot write DICOM tag cache file: " << m_CacheFile;
+      }
+    }
+  }
+
+  this->Reset();
+  this->SetInputFiles(inputFiles);
+
+  for (const auto& fileName : inputFiles)
+  {
+    DICOMGenericImageFrameInfo::Pointer info = DICOMGenericImageFrameInfo::New(fileName);
+
+    auto finding = m_Entries.find(fileName);
+    if (finding != m_Entries.end())
+    {
+      for (const auto& value : finding->second.values)
+      {
+        info->SetTagValue(value.first, value.second);
+      }
+    }
+
+    this->AddFrameInfo(info);
+  }
+}
+
+void mitk::DICOMPersistentTagCache::ScanFiles(const StringList& files, const std::set<DICOMTagPath>& paths)
+{
+  // simple tags are scanned with GDCM (like DICOMITKSeriesGDCMReader does),
+  // nested or wildcarded paths need DCMTK.
+  DICOMTagPathList simplePaths;
+  DICOMTagPathList complexPaths;
+  for (const auto& path : paths)
+  {
+    if (path.Size() == 1 && path.IsExplicit())
+    {
+      simplePaths.push_back(path);
+    }
+    else
+    {
+      complexPaths.push_back(path);
+    }
+  }
+
+  using FrameMapType = std::map<std::string, DICOMDatasetAccessingImageFrameInfo::Pointer>;
+  auto scan = [&files](DICOMTagScanner* scanner, const DICOMTagPathList& scanPaths, FrameMapType& frames)
+  {
+    if (scanPaths.empty())
+      return;
+
+    scanner->SetInputFiles(files);
+    scanner->AddTagPaths(scanPaths);
+    scanner->Scan();
+
+    for (const auto& frame : scanner->GetFrameInfoList())
+    {
+      frames[frame->GetFilenameIfAvailable()] = frame;
+    }
+  };
+
+  FrameMapType simpleFrames;
+  FrameMapType complexFrames;
+  scan(DICOMGDCMTagScanner::New(), simplePaths, simpleFrames);
+  scan(DICOMDCMTKTagScanner::New(), complexPaths, complexFrames);
+
+  auto extractValues = [](const FrameMapType& frames, const std::string& fileName, const DICOMTagPathList& scanPaths, CacheEntry& entry)
+  {
+    auto frame = frames.find(fileName);
+    if (frame == frames.end())
+      return;
+
+    for (const auto& path : scanPaths)
+    {
+      for (const auto& finding : frame->second->GetTagValueAsString(path))
+      {
+        if (finding.isValid)
+        {
+          entry.values.emplace_back(finding.path.IsEmpty() ? path : finding.path, finding.value);
+        }
+      }
+    }
+  };
+
+  for (const auto& fileName : files)
+  {
+    CacheEntry entry;
+    if (!GetFileStamp(fileName, entry.size, entry.modificationTime))
+    {
+      // inaccessible files are not cached; they will be checked again next time.
+      m_Entries.erase(fileName);
+      continue;
+    }
+
+    entry.scannedPaths = paths;
+    extractValues(simpleFrames, fileName, simplePaths, entry);
+    extractValues(complexFrames, fileName, complexPaths, entry);
+
+    m_Entries[fileName] = entry;
+  }
+}
+
+void mitk::DICOMPersistentTagCache::PruneEntries()
+{
+  for (auto iter = m_Entries.begin(); iter != m_Entries.end();)
+  {
+    std::error_code error;
+    if (!fs::exists(iter->first, error) && !error)
+    {
+      iter = m_Entries.erase(iter);
+    }
+    else
+    {
+      ++iter;
+    }
+  }
+}
+
+std::size_t mitk::DICOMPersistentTagCache::GetNumberOfCachedFiles() const
+{
+  return m_Entries.size();
+}
+
+bool mitk::DICOMPersistentTagCache::ReadCacheFile()
+{
+  std::ifstream stream(m_CacheFile, std::ios::binary);
+  if (!stream)
+  {
+    MITK_WARN << "Cannot open DICOM tag cache file: " << m_CacheFile;
+    return false;
+  }
+
+  try
+  {
+    char magic[sizeof(CacheFileMagic)];
+    stream.read(magic, sizeof(magic));
+    if (!stream || !std::equal(magic, magic + sizeof(magic), CacheFileMagic)
+        || ReadValue<std::uint32_t>(stream) != CacheFileVersion)
+    {
+      MITK_WARN << "Ignoring DICOM tag cache file with unknown format: " << m_CacheFile;
+      return false;
+    }
+
+    // all tag paths are stored once in a table; entries refer to them by index.
+    std::vector<DICOMTagPath> pathTable(ReadValue<std::uint32_t>(stream));
+    for (auto& path : pathTable)
+    {
+      path = ReadPath(stream);
+    }
+
+    auto lookUpPath = [&pathTable](std::uint32_t index) -> const DICOMTagPath&
+    {
+      if (index >= pathTable.size())
+      {
+        mitkThrow() << "Invalid tag path index in DICOM tag cache file.";
+      }
+      return pathTable[index];
+    };
+
+    const auto numberOfEntries = ReadValue<std::uint32_t>(stream);
+    for (std::uint32_t i = 0; i < numberOfEntries; ++i)
+    {
+      const auto fileName = ReadString(stream);
+      CacheEntry entry;
+      entry.size = ReadValue<std::uint64_t>(stream);
+      entry.modificationTime = ReadValue<std::int64_t>(stream);
+
+      const auto numberOfScannedPaths = ReadValue<std::uint32_t>(stream);
+      for (std::uint32_t j = 0; j < numberOfScannedPaths; ++j)
+      {
+        entry.scannedPaths.insert(lookUpPath(ReadValue<std::uint32_t>(stream)));
+      }
+
+      const auto numberOfValues = ReadValue<std::uint32_t>(stream);
+      entry.values.reserve(numberOfValues);
+      for (std::uint32_t j = 0; j < numberOfValues; ++j)
+      {
+        const auto& path = lookUpPath(ReadValue<std::uint32_t>(stream));
+        entry.values.emplace_back(path, ReadString(stream));
+      }
+
+      m_Entries[fileName] = entry;
+    }
+  }
+  catch (const std::exception& e)
+  {
+    MITK_WARN << "Ignoring invalid DICOM tag cache file " << m_CacheFile << ". Reason: " << e.what();
+    return false;
+  }
+
+  return true;
+}
+
+bool mitk::DICOMPersistentTagCache::WriteCacheFile() const
+{
+  std::map<DICOMTagPath, std::uint32_t> pathIndices;
+  std::vector<const DICOMTagPath*> pathTable;
+
+  auto registerPath = [&pathIndices, &pathTable](const DICOMTagPath& path)
+  {
+    if (pathIndices.emplace(path, static_cast<std::uint32_t>(pathTable.size())).second)
+    {
+      pathTable.push_back(&path);
+    }
+  };
+
+  for (const auto& entry : m_Entries)
+  {
+    for (const auto& path : entry.second.scannedPaths)
+      registerPath(path);
+    for (const auto& value : entry.second.values)
+      registerPath(value.first);
+  }
+
+  std::error_code error;
+  const auto cacheDirectory = fs::path(m_CacheFile).parent_path();
+  if (!cacheDirectory.empty())
+  {
+    fs::create_directories(cacheDirectory, error);
+  }
+
+  // write to a temporary file first, so other processes never see a partially written cache.
+  const auto tempFile = GetUniqueTemporaryFileName(m_CacheFile);
+  {
+    std::ofstream stream(tempFile, std::ios::binary | std::ios::trunc);
+    if (!stream)
+      return false;
+
+    stream.write(CacheFileMagic, sizeof(CacheFileMagic));
+    WriteValue<std::uint32_t>(stream, CacheFileVersion);
+
+    WriteValue<std::uint32_t>(stream, static_cast<std::uint32_t>(pathTable.size()));
+    for (const auto path : pathTable)
+    {
+      WritePath(stream, *path);
+    }
+
+    WriteValue<std::uint32_t>(stream, static_cast<std::uint32_t>(m_Entries.size()));
+    for (const auto& entry : m_Entries)
+    {
+      WriteString(stream, entry.first);
+      WriteValue<std::uint64_t>(stream, entry.second.size);
+      WriteValue<std::int64_t>(stream, entry.second.modificationTime);
+
+      WriteValue<std::uint32_t>(stream, static_cast<std::uint32_t>(entry.second.scannedPaths.size()));
+      for (const auto& path : entry.second.scannedPaths)
+      {
+        WriteValue<std::uint32_t>(stream, pathIndices[path]);
+      }
+
+      WriteValue<std::uint32_t>(stream, static_cast<std::uint32_t>(entry.second.values.size()));
+      for (const auto& value : entry.second.values)
+      {
+        WriteValue<std::uint32_t>(stream, pathIndices[value.first]);
+        WriteString(stream, value.second);
+      }
+    }
+
+    stream.close();
+    if (!stream)
+    {
+      fs::remove(tempFile, error);
+      return false;
+    }
+  }
+
+  fs::rename(tempFile, m_CacheFile, error);
+  if (error)
+  {
+    fs::remove(tempFile, error);
+    return false;
+  }
+
+  return true;
+}
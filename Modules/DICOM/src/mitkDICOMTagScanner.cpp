@@ -12,9 +12,13 @@ found in the LICENSE file.
 
 #include "mitkDICOMTagScanner.h"
 
+#include <algorithm>
+#include <exception>
+#include <thread>
+
 std::mutex mitk::DICOMTagScanner::s_LocaleMutex;
 
-mitk::DICOMTagScanner::DICOMTagScanner()
+mitk::DICOMTagScanner::DICOMTagScanner() : m_NumberOfWorkers(1)
 {
 }
 
@@ -70,3 +74,65 @@ std::string mitk::DICOMTagScanner::GetActiveLocale()
 {
   return setlocale(LC_NUMERIC, nullptr);
 }
+
+unsigned int mitk::DICOMTagScanner::GetNumberOfShards(std::size_t numberOfFiles) const
+{
+  unsigned int workers = m_NumberOfWorkers;
+  if (workers == 0)
+  {
+    workers = std::max(1u, std::thread::hardware_concurrency());
+  }
+
+  return static_cast<unsigned int>(std::max<std::size_t>(1, std::min<std::size_t>(workers, numberOfFiles)));
+}
+
+void mitk::DICOMTagScanner::ProcessShards(std::size_t numberOfFiles, const ShardFunctionType& shardFunction) const
+{
+  const unsigned int numberOfShards = this->GetNumberOfShards(numberOfFiles);
+
+  if (numberOfShards == 1)
+  {
+    shardFunction(0, 0, numberOfFiles);
+    return;
+  }
+
+  std::vector<std::exception_ptr> exceptions(numberOfShards);
+  std::vector<std::thread> workers;
+  workers.reserve(numberOfShards);
+
+  const std::size_t shardSize = numberOfFiles / numberOfShards;
+  const std::size_t remainder = numberOfFiles % numberOfShards;
+  std::size_t begin = 0;
+
+  for (unsigned int shard = 0; shard < numberOfShards; ++shard)
+  {
+    const std::size_t end = begin + shardSize + (shard < remainder ? 1 : 0);
+
+    workers.emplace_back([&shardFunction, &exceptions, shard, begin, end]()
+    {
+      try
+      {
+        shardFunction(shard, begin, end);
+      }
+      catch (...)
+      {
+        exceptions[shard] = std::current_exception();
+      }
+    });
+
+    begin = end;
+  }
+
+  for (auto& worker : workers)
+  {
+    worker.join();
+  }
+
+  for (const auto& exception : exceptions)
+  {
+    if (exception)
+    {
+      std::rethrow_exception(exception);
+    }
+  }
+}
@@ -24,6 +24,7 @@ class mitkDICOMDCMTKTagScannerTestSuite : public mitk::TestFixture
 
   MITK_TEST(DeepScanning);
   MITK_TEST(MultiFileScanning);
+  MITK_TEST(ParallelMultiFileScanning);
 
   CPPUNIT_TEST_SUITE_END();
 
@@ -119,6 +120,32 @@ public:
     CPPUNIT_ASSERT_MESSAGE("Testing value of instance uid finding of frame 3", findings.front().value == "1.2.276.0.99.1.4.8323329.3795.1303917947.940055");
   }
 
+  void ParallelMultiFileScanning()
+  {
+    mitk::DICOMTagPath instanceUID(0x0008, 0x0018);
+
+    scanner->SetInputFiles(ctFiles);
+    scanner->AddTagPath(instanceUID);
+    scanner->SetNumberOfWorkers(3);
+
+    scanner->Scan();
+
+    mitk::DICOMDatasetAccessingImageFrameList frames = scanner->GetFrameInfoList();
+    CPPUNIT_ASSERT_MESSAGE("Testing DICOMDCMTKTagScanner::GetFrameInfoList() of parallel scan", frames.size() == 4);
+
+    const std::vector<std::string> expectedUIDs = { "1.2.276.0.99.1.4.8323329.3795.1303917947.940051",
+      "1.2.276.0.99.1.4.8323329.3795.1303917947.940052", "1.2.276.0.99.1.4.8323329.3795.1303917947.940053",
+      "1.2.276.0.99.1.4.8323329.3795.1303917947.940055" };
+
+    for (std::size_t i = 0; i < frames.size(); ++i)
+    {
+      CPPUNIT_ASSERT_MESSAGE("Testing file order of parallel scan", frames[i]->GetFilenameIfAvailable() == ctFiles[i]);
+      mitk::DICOMDatasetAccess::FindingsListType findings = frames[i]->GetTagValueAsString(instanceUID);
+      CPPUNIT_ASSERT_MESSAGE("Testing instance uid finding of parallel scan", findings.size() == 1);
+      CPPUNIT_ASSERT_MESSAGE("Testing value of instance uid finding of parallel scan", findings.front().value == expectedUIDs[i]);
+    }
+  }
+
 };
 
 MITK_TEST_SUITE_REGISTRATION(mitkDICOMDCMTKTagScanner)
@@ -0,0 +1,177 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include "mitkDICOMPersistentTagCache.h"
+
+#include "mitkTestFixture.h"
+#include "mitkTestingMacros.h"
+
+#include <mitkFileSystem.h>
+#include <mitkIOUtil.h>
+
+#include <chrono>
+
+class mitkDICOMPersistentTagCacheTestSuite : public mitk::TestFixture
+{
+  CPPUNIT_TEST_SUITE(mitkDICOMPersistentTagCacheTestSuite);
+
+  MITK_TEST(ReuseCachedValues);
+  MITK_TEST(RescanForNewTags);
+  MITK_TEST(RescanChangedFiles);
+  MITK_TEST(PruneDeletedFiles);
+
+  CPPUNIT_TEST_SUITE_END();
+
+private:
+
+  mitk::StringList ctFiles;
+  std::string cacheDirectory;
+  std::string cacheFile;
+
+  mitk::DICOMTagPath instanceUID = mitk::DICOMTagPath(0x0008, 0x0018);
+  mitk::DICOMTagPath imagePosition = mitk::DICOMTagPath(0x0020, 0x0032);
+
+  /** Copies a test file into the cache directory (overwriting the target) and returns the copy.*/
+  std::string CopyToCacheDirectory(const std::string& file, const std::string& name)
+  {
+    const auto copy = (fs::path(cacheDirectory) / name).string();
+    fs::copy_file(file, copy, fs::copy_options::overwrite_existing);
+    return copy;
+  }
+
+  std::string GetInstanceUID(const mitk::DICOMPersistentTagCache* cache, std::size_t frame)
+  {
+    return cache->GetFrameInfoList()[frame]->GetTagValueAsString(instanceUID.GetFirstNode().tag).value;
+  }
+
+public:
+
+  void setUp() override
+  {
+    ctFiles.clear();
+    ctFiles.push_back(GetTestDataFilePath("TinyCTAbdomen/100"));
+    ctFiles.push_back(GetTestDataFilePath("TinyCTAbdomen/101"));
+    ctFiles.push_back(GetTestDataFilePath("TinyCTAbdomen/102"));
+    ctFiles.push_back(GetTestDataFilePath("TinyCTAbdomen/104"));
+
+    cacheDirectory = mitk::IOUtil::CreateTemporaryDirectory("DICOMTagCache_XXXXXX");
+    cacheFile = (fs::path(cacheDirectory) / "test.cache").string();
+  }
+
+  void tearDown() override
+  {
+    std::error_code error;
+    fs::remove_all(cacheDirectory, error);
+  }
+
+  void ReuseCachedValues()
+  {
+    auto cache = mitk::DICOMPersistentTagCache::New();
+    cache->SetCacheFile(cacheFile);
+    cache->Update(ctFiles, { instanceUID });
+
+    CPPUNIT_ASSERT_MESSAGE("Testing that all files are scanned initially", cache->GetNumberOfScannedFiles() == ctFiles.size());
+    CPPUNIT_ASSERT_MESSAGE("Testing that the cache file is written", fs::exists(cacheFile));
+
+    auto reloadedCache = mitk::DICOMPersistentTagCache::New();
+    reloadedCache->SetCacheFile(cacheFile);
+    reloadedCache->Update(ctFiles, { instanceUID });
+
+    CPPUNIT_ASSERT_MESSAGE("Testing that no file is scanned again", reloadedCache->GetNumberOfScannedFiles() == 0);
+
+    auto frames = cache->GetFrameInfoList();
+    auto reloadedFrames = reloadedCache->GetFrameInfoList();
+    CPPUNIT_ASSERT_MESSAGE("Testing number of frames", frames.size() == ctFiles.size() && reloadedFrames.size() == ctFiles.size());
+
+    for (std::size_t i = 0; i < ctFiles.size(); ++i)
+    {
+      CPPUNIT_ASSERT_MESSAGE("Testing frame order", reloadedFrames[i]->GetFilenameIfAvailable() == ctFiles[i]);
+      auto value = frames[i]->GetTagValueAsString(instanceUID.GetFirstNode().tag);
+      auto reloadedValue = reloadedFrames[i]->GetTagValueAsString(instanceUID.GetFirstNode().tag);
+      CPPUNIT_ASSERT_MESSAGE("Testing validity of cached value", value.isValid && reloadedValue.isValid);
+      CPPUNIT_ASSERT_MESSAGE("Testing cached value", value.value == reloadedValue.value);
+    }
+
+    CPPUNIT_ASSERT_MESSAGE("Testing value of first frame", reloadedFrames[0]->GetTagValueAsString(instanceUID.GetFirstNode().tag).value == "1.2.276.0.99.1.4.8323329.3795.1303917947.940051");
+  }
+
+  void RescanForNewTags()
+  {
+    auto cache = mitk::DICOMPersistentTagCache::New();
+    cache->SetCacheFile(cacheFile);
+    cache->Update(ctFiles, { instanceUID });
+
+    auto reloadedCache = mitk::DICOMPersistentTagCache::New();
+    reloadedCache->SetCacheFile(cacheFile);
+    reloadedCache->Update(ctFiles, { instanceUID, imagePosition });
+
+    CPPUNIT_ASSERT_MESSAGE("Testing that files are scanned again for new tags", reloadedCache->GetNumberOfScannedFiles() == ctFiles.size());
+    CPPUNIT_ASSERT_MESSAGE("Testing that new tags are available", reloadedCache->GetFrameInfoList().front()->GetTagValueAsString(imagePosition.GetFirstNode().tag).isValid);
+
+    reloadedCache->Update(mitk::StringList({ ctFiles.front() }), { imagePosition });
+    CPPUNIT_ASSERT_MESSAGE("Testing that the update is restricted to the passed files", reloadedCache->GetFrameInfoList().size() == 1);
+    CPPUNIT_ASSERT_MESSAGE("Testing that the known tags are reused", reloadedCache->GetNumberOfScannedFiles() == 0);
+  }
+
+  void RescanChangedFiles()
+  {
+    mitk::StringList files = { CopyToCacheDirectory(ctFiles[0], "slice"), ctFiles[2], ctFiles[3] };
+
+    auto cache = mitk::DICOMPersistentTagCache::New();
+    cache->SetCacheFile(cacheFile);
+    cache->Update(files, { instanceUID });
+    const auto originalUID = GetInstanceUID(cache, 0);
+
+    // Files of a series usually have the same size, so the modification time has to be
+    // checked as well. It is moved explicitly, as the copy may be faster than its resolution.
+    CopyToCacheDirectory(ctFiles[1], "slice");
+    fs::last_write_time(files[0], fs::last_write_time(files[0]) + std::chrono::hours(1));
+
+    auto reloadedCache = mitk::DICOMPersistentTagCache::New();
+    reloadedCache->SetCacheFile(cacheFile);
+    reloadedCache->Update(files, { instanceUID });
+
+    CPPUNIT_ASSERT_MESSAGE("Testing that only the changed file is scanned again", reloadedCache->GetNumberOfScannedFiles() == 1);
+
+    auto referenceCache = mitk::DICOMPersistentTagCache::New();
+    referenceCache->Update(mitk::StringList({ ctFiles[1] }), { instanceUID });
+
+    CPPUNIT_ASSERT_MESSAGE("Testing that the value of the changed file is updated", GetInstanceUID(reloadedCache, 0) == GetInstanceUID(referenceCache, 0));
+    CPPUNIT_ASSERT_MESSAGE("Testing that the value has changed", GetInstanceUID(reloadedCache, 0) != originalUID);
+    CPPUNIT_ASSERT_MESSAGE("Testing that unchanged values are reused", GetInstanceUID(reloadedCache, 1) == GetInstanceUID(cache, 1));
+  }
+
+  void PruneDeletedFiles()
+  {
+    const auto deletedFile = CopyToCacheDirectory(ctFiles[0], "deleted");
+    const auto keptFile = CopyToCacheDirectory(ctFiles[1], "kept");
+
+    auto cache = mitk::DICOMPersistentTagCache::New();
+    cache->SetCacheFile(cacheFile);
+    cache->Update(mitk::StringList({ deletedFile, keptFile }), { instanceUID });
+    CPPUNIT_ASSERT_MESSAGE("Testing number of cached files", cache->GetNumberOfCachedFiles() == 2);
+
+    fs::remove(deletedFile);
+    const auto newFile = CopyToCacheDirectory(ctFiles[2], "new");
+    cache->Update(mitk::StringList({ keptFile, newFile }), { instanceUID });
+
+    auto reloadedCache = mitk::DICOMPersistentTagCache::New();
+    reloadedCache->SetCacheFile(cacheFile);
+    reloadedCache->Update(mitk::StringList({ keptFile }), { instanceUID });
+
+    CPPUNIT_ASSERT_MESSAGE("Testing that the kept file is not scanned again", reloadedCache->GetNumberOfScannedFiles() == 0);
+    CPPUNIT_ASSERT_MESSAGE("Testing that the deleted file was removed from the cache file", reloadedCache->GetNumberOfCachedFiles() == 2);
+  }
+
+};
+
+MITK_TEST_SUITE_REGISTRATION(mitkDICOMPersistentTagCache)
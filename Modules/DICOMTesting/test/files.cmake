@@ -3,4 +3,5 @@
 set(MODULE_CUSTOM_TESTS
   mitkDICOMTestingSanityTest.cpp
   mitkDICOMPreloadedVolumeTest.cpp
+  mitkDICOMTagScannerBenchmark.cpp
 )
@@ -0,0 +1,102 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include "mitkDICOMDCMTKTagScanner.h"
+#include "mitkDICOMGDCMTagScanner.h"
+
+#include "mitkTestingMacros.h"
+
+#include <chrono>
+
+namespace
+{
+  const mitk::DICOMTagList& BenchmarkTags()
+  {
+    static const mitk::DICOMTagList tags = {
+      mitk::DICOMTag(0x0008, 0x0018), // SOP instance uid
+      mitk::DICOMTag(0x0020, 0x000d), // study instance uid
+      mitk::DICOMTag(0x0020, 0x000e), // series instance uid
+      mitk::DICOMTag(0x0020, 0x0013), // instance number
+      mitk::DICOMTag(0x0020, 0x0032), // image position patient
+      mitk::DICOMTag(0x0020, 0x0037), // image orientation patient
+      mitk::DICOMTag(0x0028, 0x0010), // rows
+      mitk::DICOMTag(0x0028, 0x0011), // columns
+      mitk::DICOMTag(0x0028, 0x0030)  // pixel spacing
+    };
+    return tags;
+  }
+
+  /** Scans the files with the given scanner and returns the values of all benchmark tags
+   (in file order) as one list for comparison.*/
+  mitk::StringList ScanAndCollect(mitk::DICOMTagScanner* scanner, const mitk::StringList& files, unsigned int workers, unsigned int repetitions, double& filesPerSecond)
+  {
+    scanner->AddTags(BenchmarkTags());
+    scanner->SetInputFiles(files);
+    scanner->SetNumberOfWorkers(workers);
+
+    const auto start = std::chrono::steady_clock::now();
+    for (unsigned int i = 0; i < repetitions; ++i)
+    {
+      scanner->Scan();
+    }
+    const std::chrono::duration<double> duration = std::chrono::steady_clock::now() - start;
+
+    filesPerSecond = duration.count() > 0. ? (files.size() * repetitions) / duration.count() : 0.;
+
+    mitk::StringList values;
+    for (const auto& frame : scanner->GetFrameInfoList())
+    {
+      values.push_back(frame->GetFilenameIfAvailable());
+      for (const auto& tag : BenchmarkTags())
+      {
+        values.push_back(frame->GetTagValueAsString(tag).value);
+      }
+    }
+    return values;
+  }
+}
+
+/** Reports the scan throughput (files per second) of DICOMDCMTKTagScanner and
+ DICOMGDCMTagScanner for different numbers of workers. It also ensures that parallel
+ scans produce exactly the same results (in the same order) as sequential ones.
+
+ Usage: mitkDICOMTagScannerBenchmark <file1> [<file2> ...]*/
+int mitkDICOMTagScannerBenchmark(int argc, char** const argv)
+{
+  MITK_TEST_BEGIN("DICOMTagScannerBenchmark")
+
+  mitk::StringList files;
+  for (int arg = 1; arg < argc; ++arg) files.push_back(argv[arg]);
+
+  MITK_TEST_CONDITION_REQUIRED(!files.empty(), "Benchmark is called with DICOM files (see test invocation)")
+
+  const unsigned int repetitions = 5;
+  const std::vector<unsigned int> workerCounts = { 1, 2, 4, 0 };
+
+  double filesPerSecond = 0.;
+
+  auto dcmtkReference = ScanAndCollect(mitk::DICOMDCMTKTagScanner::New(), files, 1, 1, filesPerSecond);
+  auto gdcmReference = ScanAndCollect(mitk::DICOMGDCMTagScanner::New(), files, 1, 1, filesPerSecond);
+
+  for (const auto workers : workerCounts)
+  {
+    auto dcmtkValues = ScanAndCollect(mitk::DICOMDCMTKTagScanner::New(), files, workers, repetitions, filesPerSecond);
+    MITK_TEST_OUTPUT(<< "DICOMDCMTKTagScanner, workers: " << workers << ", files per second: " << filesPerSecond)
+    MITK_TEST_CONDITION(dcmtkValues == dcmtkReference, "DICOMDCMTKTagScanner with " << workers << " workers yields the sequential results")
+
+    auto gdcmValues = ScanAndCollect(mitk::DICOMGDCMTagScanner::New(), files, workers, repetitions, filesPerSecond);
+    MITK_TEST_OUTPUT(<< "DICOMGDCMTagScanner, workers: " << workers << ", files per second: " << filesPerSecond)
+    MITK_TEST_CONDITION(gdcmValues == gdcmReference, "DICOMGDCMTagScanner with " << workers << " workers yields the sequential results")
+  }
+
+  MITK_TEST_END()
+}
@@ -11,6 +11,7 @@ set(CPP_FILES
   mitkColorSequenceCycleH.cpp
   mitkColorSequenceRainbow.cpp
   mitkCompressedImageContainer.cpp
+  mitkCompressedImageDifference.cpp
   mitkCone.cpp
   mitkCuboid.cpp
   mitkCylinder.cpp
@@ -33,6 +33,9 @@ namespace mitk
     void CompressImage(const Image* image);
     Image::Pointer DecompressImage() const;
 
+    /** Number of bytes occupied by the compressed image.*/
+    std::size_t GetMemorySize() const;
+
   private:
     using CompressedSliceData = std::pair<int, char*>;
     using CompressedTimeStepData = std::vector<CompressedSliceData>;
@@ -0,0 +1,103 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#ifndef mitkCompressedImageDifference_h
+#define mitkCompressedImageDifference_h
+
+#include <MitkDataTypesExtExports.h>
+#include <mitkImage.h>
+
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace mitk
+{
+  /**
+   * \brief Stores the difference between two states of an image in compact form.
+   *
+   * The difference is determined slice by slice: the bytes of both states are XORed and every run of
+   * changed bytes is recorded together with its content before and after the change (LZ4 compressed).
+   * Unchanged slices do not consume any memory, so the difference of a small edit is tiny compared to
+   * a compressed copy of the whole image (see CompressedImageContainer). Slices are processed in parallel.
+   *
+   * ApplyBefore() and ApplyAfter() only write the bytes that differ between the two states into an image. All
+   * other bytes keep their current content, so changes made to other voxels in the meantime are preserved. This
+   * allows to implement undo and redo of an edit with one instance of this class.
+   */
+  class MITKDATATYPESEXT_EXPORT CompressedImageDifference
+  {
+  public:
+    CompressedImageDifference();
+    ~CompressedImageDifference();
+
+    CompressedImageDifference(const CompressedImageDifference&) = delete;
+    CompressedImageDifference& operator=(const CompressedImageDifference&) = delete;
+
+    /**
+     * \brief Determines the difference between the two states of an image.
+     * \param before State before the change. If it is nullptr, an image of the same type and size with all bytes
+     * zero is assumed (e.g. to store a sparse image compactly).
+     * \param after State after the change.
+     * \pre Both images must have the same pixel type and dimensions.
+     */
+    void ComputeDifference(const Image* before, const Image* after);
+
+    /** Writes the content of the changed runs before the change into the passed image.*/
+    void ApplyBefore(Image* image) const;
+
+    /** Writes the content of the changed runs after the change into the passed image.*/
+    void ApplyAfter(Image* image) const;
+
+    /** Creates an image with the geometry of the stored state that only contains the content of the changed runs
+     * after the change (all other bytes are zero). This restores images that were stored with before = nullptr.*/
+    Image::Pointer CreateAfterImage() const;
+
+    /** Indicates if both states are equal (or no difference was computed).*/
+    bool IsEmpty() const;
+
+    /** Number of bytes occupied by the stored difference.*/
+    std::size_t GetMemorySize() const;
+
+    /** Indicates if the difference between the two images can be computed (same pixel type and dimensions).*/
+    static bool HaveSameLayout(const Image* image1, const Image* image2);
+
+  private:
+    /** Runs of changed bytes in a slice (offset and length in bytes).*/
+    using RunVectorType = std::vector<std::pair<std::uint32_t, std::uint32_t>>;
+
+    struct SliceDifference
+    {
+      RunVectorType runs;
+      /** Number of bytes of all runs (uncompressed).*/
+      std::size_t contentSize = 0;
+      std::vector<char> before;
+      std::vector<char> after;
+    };
+
+    using TimeStepDifference = std::vector<SliceDifference>;
+
+    void Apply(Image* image, bool after) const;
+    void Clear();
+
+    std::vector<TimeStepDifference> m_Differences;
+
+    std::unique_ptr<PixelType> m_PixelType;
+    TimeGeometry::Pointer m_TimeGeometry;
+    std::array<unsigned int, 2> m_SliceDimensions;
+    unsigned int m_Dimension;
+  };
+}
+
+#endif
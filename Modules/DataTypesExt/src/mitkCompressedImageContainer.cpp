@@ -15,6 +15,8 @@ found in the LICENSE file.
 #include <mitkImageReadAccessor.h>
 #include <mitkImageWriteAccessor.h>
 
+#include <itkMultiThreaderBase.h>
+
 #include <lz4.h>
 
 #include <algorithm>
@@ -64,39 +66,53 @@ void mitk::CompressedImageContainer::CompressImage(const Image* image)
   const auto numSliceBytes = image->GetPixelType().GetSize() * image->GetDimension(0) * image->GetDimension(1);
 
   m_CompressedImageData.reserve(numTimeSteps);
+  auto threader = itk::MultiThreaderBase::New();
 
   for (std::remove_const_t<decltype(numTimeSteps)> t = 0; t < numTimeSteps; ++t)
   {
-    CompressedTimeStepData slices;
-    slices.reserve(numSlices);
+    CompressedTimeStepData slices(numSlices, CompressedSliceData(0, nullptr));
 
     ImageReadAccessor accessor(image, image->GetVolumeData(t));
 
-    for (std::remove_const_t<decltype(numSlices)> s = 0; s < numSlices; ++s)
+    // slices are compressed independently, so they can be compressed in parallel
+    threader->ParallelizeArray(0, numSlices, [&](itk::SizeValueType s)
     {
       const auto* src = reinterpret_cast<const char*>(accessor.GetData()) + numSliceBytes * s;
-      char* dest = new char[numSliceBytes];
-      const auto destSize = LZ4_compress_default(src, dest, static_cast<int>(numSliceBytes), static_cast<int>(numSliceBytes));
+      const auto destCapacity = LZ4_compressBound(static_cast<int>(numSliceBytes));
+      std::vector<char> dest(destCapacity);
+      const auto destSize = LZ4_compress_default(src, dest.data(), static_cast<int>(numSliceBytes), destCapacity);
 
       if (0 == destSize)
       {
         MITK_ERROR << "LZ4 compression failed!";
-        delete[] dest;
-        slices.emplace_back(0, nullptr);
       }
       else
       {
         char* shrinkedDest = new char[destSize];
-        std::copy(dest, dest + destSize, shrinkedDest);
-        delete[] dest;
-        slices.emplace_back(destSize, shrinkedDest);
+        std::copy(dest.data(), dest.data() + destSize, shrinkedDest);
+        slices[s] = CompressedSliceData(destSize, shrinkedDest);
       }
-    }
+    }, nullptr);
 
-    m_CompressedImageData.push_back(slices);
+    m_CompressedImageData.push_back(std::move(slices));
   }
 }
 
+std::size_t mitk::CompressedImageContainer::GetMemorySize() const
+{
+  std::size_t size = sizeof(*this);
+
+  for (const auto& slices : m_CompressedImageData)
+  {
+    size += slices.capacity() * sizeof(CompressedSliceData);
+
+    for (const auto& slice : slices)
+      size += slice.first;
+  }
+
+  return size;
+}
+
 mitk::Image::Pointer mitk::CompressedImageContainer::DecompressImage() const
 {
   if (m_CompressedImageData.empty())
@@ -0,0 +1,348 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include <mitkCompressedImageDifference.h>
+
+#include <mitkImageReadAccessor.h>
+#include <mitkImageWriteAccessor.h>
+
+#include <itkMultiThreaderBase.h>
+
+#include <lz4.h>
+
+#include <algorithm>
+#include <cstring>
+
+namespace
+{
+  /** Runs of changed bytes that are separated by fewer unchanged bytes are merged into one run. The unchanged
+   * bytes of a merged run are stored, but never written by Apply().*/
+  constexpr std::size_t MINIMUM_RUN_GAP = 16;
+
+  void Compress(const std::vector<char>& content, std::vector<char>& compressed)
+  {
+    compressed.resize(LZ4_compressBound(static_cast<int>(content.size())));
+    const auto size = LZ4_compress_default(content.data(), compressed.data(), static_cast<int>(content.size()), static_cast<int>(compressed.size()));
+
+    if (0 >= size)
+    {
+      MITK_ERROR << "LZ4 compression failed!";
+      compressed.clear();
+    }
+    else
+    {
+      compressed.resize(size);
+    }
+
+    compressed.shrink_to_fit();
+  }
+
+  bool Decompress(const std::vector<char>& compressed, std::vector<char>& content)
+  {
+    if (content.empty())
+      return true;
+
+    const auto size = LZ4_decompress_safe(compressed.data(), content.data(), static_cast<int>(compressed.size()), static_cast<int>(content.size()));
+    return static_cast<int>(content.size()) == size;
+  }
+
+  bool IsUnchanged(const char* before, const char* after, std::size_t numberOfBytes)
+  {
+    if (nullptr != before)
+      return 0 == std::memcmp(before, after, numberOfBytes);
+
+    return std::all_of(after, after + numberOfBytes, [](char value) { return 0 == value; });
+  }
+}
+
+mitk::CompressedImageDifference::CompressedImageDifference()
+  : m_SliceDimensions({ { 0, 0 } }), m_Dimension(0)
+{
+}
+
+mitk::CompressedImageDifference::~CompressedImageDifference()
+{
+}
+
+void mitk::CompressedImageDifference::Clear()
+{
+  m_Differences.clear();
+  m_PixelType = nullptr;
+  m_TimeGeometry = nullptr;
+  m_SliceDimensions[0] = 0;
+  m_SliceDimensions[1] = 0;
+  m_Dimension = 0;
+}
+
+void mitk::CompressedImageDifference::ComputeDifference(const Image* before, const Image* after)
+{
+  this->Clear();
+
+  if (nullptr == after)
+    mitkThrow() << "Cannot compute image difference. Image after the change is not set.";
+
+  if (nullptr != before && !HaveSameLayout(before, after))
+    mitkThrow() << "Cannot compute image difference. Pixel type or dimensions of the images differ.";
+
+  m_PixelType = std::make_unique<PixelType>(after->GetPixelType());
+  m_TimeGeometry = after->GetTimeGeometry()->Clone();
+  m_SliceDimensions[0] = after->GetDimension(0);
+  m_SliceDimensions[1] = after->GetDimension(1);
+  m_Dimension = after->GetDimension();
+
+  const auto numTimeSteps = m_TimeGeometry->CountTimeSteps();
+  const auto numSlices = after->GetDimension(2);
+  const std::size_t numSliceBytes = after->GetPixelType().GetSize() * after->GetDimension(0) * after->GetDimension(1);
+
+  m_Differences.assign(numTimeSteps, TimeStepDifference(numSlices));
+  auto threader = itk::MultiThreaderBase::New();
+
+  for (std::remove_const_t<decltype(numTimeSteps)> t = 0; t < numTimeSteps; ++t)
+  {
+    ImageReadAccessor afterAccessor(after, after->GetVolumeData(t));
+    const auto* afterData = static_cast<const char*>(afterAccessor.GetData());
+
+    std::unique_ptr<ImageReadAccessor> beforeAccessor;
+    const char* beforeData = nullptr;
+
+    if (nullptr != before)
+    {
+      beforeAccessor = std::make_unique<ImageReadAccessor>(before, before->GetVolumeData(t));
+      beforeData = static_cast<const char*>(beforeAccessor->GetData());
+    }
+
+    auto& slices = m_Differences[t];
+
+    threader->ParallelizeArray(0, numSlices, [&](itk::SizeValueType s)
+    {
+      const char* sliceBefore = nullptr == beforeData ? nullptr : beforeData + numSliceBytes * s;
+      const char* sliceAfter = afterData + numSliceBytes * s;
+
+      if (IsUnchanged(sliceBefore, sliceAfter, numSliceBytes))
+        return;
+
+      // a byte is changed if the XOR of both states is not zero
+      auto isChanged = [sliceBefore, sliceAfter](std::size_t i)
+      {
+        return 0 != ((nullptr == sliceBefore ? 0 : sliceBefore[i]) ^ sliceAfter[i]);
+      };
+
+      auto& difference = slices[s];
+      std::size_t i = 0;
+
+      while (i < numSliceBytes)
+      {
+        while (i < numSliceBytes && !isChanged(i))
+          ++i;
+
+        if (i == numSliceBytes)
+          break;
+
+        const auto runStart = i;
+        auto runEnd = i;
+
+        while (true)
+        {
+          while (runEnd < numSliceBytes && isChanged(runEnd))
+            ++runEnd;
+
+          auto next = runEnd;
+          while (next < numSliceBytes && next - runEnd < MINIMUM_RUN_GAP && !isChanged(next))
+            ++next;
+
+          if (next < numSliceBytes && next - runEnd < MINIMUM_RUN_GAP)
+          {
+            runEnd = next;
+          }
+          else
+          {
+            break;
+          }
+        }
+
+        difference.runs.emplace_back(static_cast<std::uint32_t>(runStart), static_cast<std::uint32_t>(runEnd - runStart));
+        difference.contentSize += runEnd - runStart;
+        i = runEnd;
+      }
+
+      std::vector<char> beforeContent;
+      std::vector<char> afterContent;
+      beforeContent.reserve(difference.contentSize);
+      afterContent.reserve(difference.contentSize);
+
+      for (const auto& [offset, length] : difference.runs)
+      {
+        if (nullptr == sliceBefore)
+        {
+          beforeContent.insert(beforeContent.end(), length, 0);
+        }
+        else
+        {
+          beforeContent.insert(beforeContent.end(), sliceBefore + offset, sliceBefore + offset + length);
+        }
+
+        afterContent.insert(afterContent.end(), sliceAfter + offset, sliceAfter + offset + length);
+      }
+
+      Compress(beforeContent, difference.before);
+      Compress(afterContent, difference.after);
+      difference.runs.shrink_to_fit();
+    }, nullptr);
+  }
+}
+
+void mitk::CompressedImageDifference::ApplyBefore(Image* image) const
+{
+  this->Apply(image, false);
+}
+
+void mitk::CompressedImageDifference::ApplyAfter(Image* image) const
+{
+  this->Apply(image, true);
+}
+
+void mitk::CompressedImageDifference::Apply(Image* image, bool after) const
+{
+  if (nullptr == image)
+    mitkThrow() << "Cannot apply image difference. Image is not set.";
+
+  if (m_Differences.empty())
+    return;
+
+  if (image->GetPixelType() != *m_PixelType || image->GetDimension(0) != m_SliceDimensions[0] ||
+      image->GetDimension(1) != m_SliceDimensions[1] || image->GetDimension(2) != m_Differences[0].size() ||
+      image->GetTimeSteps() != m_Differences.size())
+  {
+    mitkThrow() << "Cannot apply image difference. Image does not match the stored difference.";
+  }
+
+  const auto numTimeSteps = static_cast<unsigned int>(m_Differences.size());
+  const std::size_t numSliceBytes = m_PixelType->GetSize() * m_SliceDimensions[0] * m_SliceDimensions[1];
+  auto threader = itk::MultiThreaderBase::New();
+
+  for (std::remove_const_t<decltype(numTimeSteps)> t = 0; t < numTimeSteps; ++t)
+  {
+    const auto& slices = m_Differences[t];
+
+    if (std::all_of(slices.begin(), slices.end(), [](const SliceDifference& slice) { return slice.runs.empty(); }))
+      continue;
+
+    ImageWriteAccessor accessor(image, image->GetVolumeData(static_cast<int>(t)));
+    auto* data = static_cast<char*>(accessor.GetData());
+
+    threader->ParallelizeArray(0, slices.size(), [&](itk::SizeValueType s)
+    {
+      const auto& difference = slices[s];
+
+      if (difference.runs.empty())
+        return;
+
+      // Runs may contain unchanged bytes (see MINIMUM_RUN_GAP). Both states are needed to skip them, so that
+      // they keep their current content.
+      std::vector<char> beforeContent(difference.contentSize);
+      std::vector<char> afterContent(difference.contentSize);
+
+      if (!Decompress(difference.before, beforeContent) || !Decompress(difference.after, afterContent))
+      {
+        MITK_ERROR << "LZ4 decompression failed!";
+        return;
+      }
+
+      auto* slice = data + numSliceBytes * s;
+      const auto& content = after ? afterContent : beforeContent;
+      std::size_t source = 0;
+
+      for (const auto& [offset, length] : difference.runs)
+      {
+        for (std::size_t i = 0; i < length; ++i, ++source)
+        {
+          if (beforeContent[source] != afterContent[source])
+            slice[offset + i] = content[source];
+        }
+      }
+    }, nullptr);
+  }
+}
+
+mitk::Image::Pointer mitk::CompressedImageDifference::CreateAfterImage() const
+{
+  if (m_Differences.empty())
+    return nullptr;
+
+  std::array<unsigned int, 4> dimensions;
+  dimensions[0] = m_SliceDimensions[0];
+  dimensions[1] = m_SliceDimensions[1];
+  dimensions[2] = static_cast<unsigned int>(m_Differences[0].size());
+  dimensions[3] = static_cast<unsigned int>(m_Differences.size());
+
+  auto image = Image::New();
+  image->Initialize(*m_PixelType, m_Dimension, dimensions.data());
+
+  const std::size_t numTimeStepBytes = m_PixelType->GetSize() * dimensions[0] * dimensions[1] * dimensions[2];
+
+  for (unsigned int t = 0; t < dimensions[3]; ++t)
+  {
+    ImageWriteAccessor accessor(image, image->GetVolumeData(static_cast<int>(t)));
+    std::memset(accessor.GetData(), 0, numTimeStepBytes);
+  }
+
+  this->Apply(image, true);
+  image->SetTimeGeometry(m_TimeGeometry->Clone());
+
+  return image;
+}
+
+bool mitk::CompressedImageDifference::IsEmpty() const
+{
+  for (const auto& slices : m_Differences)
+  {
+    for (const auto& slice : slices)
+    {
+      if (!slice.runs.empty())
+        return false;
+    }
+  }
+
+  return true;
+}
+
+std::size_t mitk::CompressedImageDifference::GetMemorySize() const
+{
+  std::size_t size = sizeof(*this);
+
+  for (const auto& slices : m_Differences)
+  {
+    size += slices.capacity() * sizeof(SliceDifference);
+
+    for (const auto& slice : slices)
+      size += slice.runs.capacity() * sizeof(RunVectorType::value_type) + slice.before.capacity() + slice.after.capacity();
+  }
+
+  return size;
+}
+
+bool mitk::CompressedImageDifference::HaveSameLayout(const Image* image1, const Image* image2)
+{
+  if (nullptr == image1 || nullptr == image2)
+    return false;
+
+  if (image1->GetPixelType() != image2->GetPixelType() || image1->GetDimension() != image2->GetDimension())
+    return false;
+
+  for (unsigned int i = 0; i < image1->GetDimension(); ++i)
+  {
+    if (image1->GetDimension(i) != image2->GetDimension(i))
+      return false;
+  }
+
+  return true;
+}
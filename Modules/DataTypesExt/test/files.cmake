@@ -1,5 +1,6 @@
 set(MODULE_TESTS
   mitkColorSequenceRainbowTest.cpp
+  mitkCompressedImageDifferenceTest.cpp
   mitkMultiStepperTest.cpp
   mitkUnstructuredGridTest.cpp
 )
@@ -0,0 +1,167 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+// Testing
+#include "mitkTestFixture.h"
+#include "mitkTestingMacros.h"
+
+// MITK includes
+#include <mitkCompressedImageDifference.h>
+#include <mitkImagePixelReadAccessor.h>
+#include <mitkImagePixelWriteAccessor.h>
+
+class mitkCompressedImageDifferenceTestSuite : public mitk::TestFixture
+{
+  CPPUNIT_TEST_SUITE(mitkCompressedImageDifferenceTestSuite);
+  MITK_TEST(ComputeDifference_SmallEdit_UndoAndRedoRestoreStates);
+  MITK_TEST(ComputeDifference_EqualImages_IsEmpty);
+  MITK_TEST(ApplyBefore_ChangeBetweenMergedRuns_IsPreserved);
+  MITK_TEST(ComputeDifference_WithoutBefore_CreatesAfterImage);
+  MITK_TEST(ComputeDifference_DifferentLayout_Throws);
+  CPPUNIT_TEST_SUITE_END();
+
+  using PixelType = unsigned short;
+  using AccessorType = mitk::ImagePixelWriteAccessor<PixelType, 4>;
+
+private:
+  mitk::Image::Pointer m_Before;
+  mitk::Image::Pointer m_After;
+
+  static mitk::Image::Pointer CreateImage()
+  {
+    unsigned int dimensions[4] = { 32, 24, 10, 2 };
+
+    auto image = mitk::Image::New();
+    image->Initialize(mitk::MakeScalarPixelType<PixelType>(), 4, dimensions);
+
+    AccessorType accessor(image);
+    std::fill(accessor.GetData(), accessor.GetData() + 32 * 24 * 10 * 2, PixelType(0));
+
+    return image;
+  }
+
+  static void FillBlock(mitk::Image* image, itk::Index<4> from, itk::Index<4> to, PixelType value)
+  {
+    AccessorType accessor(image);
+    itk::Index<4> index;
+    for (index[3] = from[3]; index[3] <= to[3]; ++index[3])
+      for (index[2] = from[2]; index[2] <= to[2]; ++index[2])
+        for (index[1] = from[1]; index[1] <= to[1]; ++index[1])
+          for (index[0] = from[0]; index[0] <= to[0]; ++index[0])
+            accessor.SetPixelByIndex(index, value);
+  }
+
+  static bool AreEqual(mitk::Image* image1, mitk::Image* image2)
+  {
+    mitk::ImagePixelReadAccessor<PixelType, 4> accessor1(image1);
+    mitk::ImagePixelReadAccessor<PixelType, 4> accessor2(image2);
+    return std::equal(accessor1.GetData(), accessor1.GetData() + 32 * 24 * 10 * 2, accessor2.GetData());
+  }
+
+public:
+  void setUp() override
+  {
+    m_Before = CreateImage();
+    FillBlock(m_Before, {{ 2, 2, 0, 0 }}, {{ 20, 20, 9, 1 }}, 1);
+
+    m_After = m_Before->Clone();
+    FillBlock(m_After, {{ 5, 5, 3, 1 }}, {{ 8, 9, 4, 1 }}, 2);
+    FillBlock(m_After, {{ 25, 0, 7, 1 }}, {{ 25, 0, 7, 1 }}, 3);
+  }
+
+  void tearDown() override
+  {
+    m_Before = nullptr;
+    m_After = nullptr;
+  }
+
+  void ComputeDifference_SmallEdit_UndoAndRedoRestoreStates()
+  {
+    mitk::CompressedImageDifference difference;
+    difference.ComputeDifference(m_Before, m_After);
+
+    CPPUNIT_ASSERT(!difference.IsEmpty());
+    // only three slices are changed, so the difference is much smaller than the image
+    CPPUNIT_ASSERT(difference.GetMemorySize() < 32 * 24 * sizeof(PixelType));
+
+    auto image = m_After->Clone();
+    difference.ApplyBefore(image);
+    CPPUNIT_ASSERT(AreEqual(m_Before, image));
+
+    difference.ApplyAfter(image);
+    CPPUNIT_ASSERT(AreEqual(m_After, image));
+  }
+
+  void ApplyBefore_ChangeBetweenMergedRuns_IsPreserved()
+  {
+    // two edits in the same row that are close enough to be stored as one run
+    auto after = m_Before->Clone();
+    FillBlock(after, {{ 10, 12, 3, 0 }}, {{ 10, 12, 3, 0 }}, 4);
+    FillBlock(after, {{ 14, 12, 3, 0 }}, {{ 14, 12, 3, 0 }}, 5);
+
+    mitk::CompressedImageDifference difference;
+    difference.ComputeDifference(m_Before, after);
+
+    // another edit between them that is not part of the difference
+    auto image = after->Clone();
+    FillBlock(image, {{ 12, 12, 3, 0 }}, {{ 12, 12, 3, 0 }}, 7);
+
+    auto expected = m_Before->Clone();
+    FillBlock(expected, {{ 12, 12, 3, 0 }}, {{ 12, 12, 3, 0 }}, 7);
+
+    difference.ApplyBefore(image);
+    CPPUNIT_ASSERT(AreEqual(expected, image));
+
+    FillBlock(expected, {{ 10, 12, 3, 0 }}, {{ 10, 12, 3, 0 }}, 4);
+    FillBlock(expected, {{ 14, 12, 3, 0 }}, {{ 14, 12, 3, 0 }}, 5);
+
+    difference.ApplyAfter(image);
+    CPPUNIT_ASSERT(AreEqual(expected, image));
+  }
+
+  void ComputeDifference_EqualImages_IsEmpty()
+  {
+    mitk::CompressedImageDifference difference;
+    difference.ComputeDifference(m_Before, m_Before->Clone());
+
+    CPPUNIT_ASSERT(difference.IsEmpty());
+
+    auto image = m_Before->Clone();
+    difference.ApplyAfter(image);
+    CPPUNIT_ASSERT(AreEqual(m_Before, image));
+  }
+
+  void ComputeDifference_WithoutBefore_CreatesAfterImage()
+  {
+    mitk::CompressedImageDifference difference;
+    difference.ComputeDifference(nullptr, m_After);
+
+    auto image = difference.CreateAfterImage();
+    CPPUNIT_ASSERT(image.IsNotNull());
+    CPPUNIT_ASSERT(mitk::CompressedImageDifference::HaveSameLayout(m_After, image));
+    CPPUNIT_ASSERT(AreEqual(m_After, image));
+  }
+
+  void ComputeDifference_DifferentLayout_Throws()
+  {
+    unsigned int dimensions[3] = { 32, 24, 10 };
+    auto other = mitk::Image::New();
+    other->Initialize(mitk::MakeScalarPixelType<PixelType>(), 3, dimensions);
+
+    CPPUNIT_ASSERT(!mitk::CompressedImageDifference::HaveSameLayout(m_Before, other));
+
+    mitk::CompressedImageDifference difference;
+    CPPUNIT_ASSERT_THROW(difference.ComputeDifference(m_Before, other), mitk::Exception);
+  }
+};
+
+MITK_TEST_SUITE_REGISTRATION(mitkCompressedImageDifference)
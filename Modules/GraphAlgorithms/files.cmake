@@ -1,10 +1,14 @@
 set(CPP_FILES
+  itkLiveWireCostTerms.cpp
+  itkShortestPathIndexedHeap.cpp
   itkShortestPathNode.cpp
 )
 set(H_FILES
   itkShortestPathCostFunction.h
   itkShortestPathCostFunctionTbss.h
+  itkShortestPathIndexedHeap.h
   itkShortestPathNode.h
   itkShortestPathImageFilter.h
   itkShortestPathCostFunctionLiveWire.h
+  itkLiveWireCostTerms.h
 )
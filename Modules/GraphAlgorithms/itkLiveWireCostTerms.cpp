@@ -0,0 +1,107 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include "itkLiveWireCostTerms.h"
+
+#include <itkCannyEdgeDetectionImageFilter.h>
+#include <itkGradientImageFilter.h>
+#include <itkGradientMagnitudeImageFilter.h>
+#include <itkMultiThreaderBase.h>
+
+#include <algorithm>
+#include <cmath>
+
+namespace itk
+{
+  LiveWireCostTerms::LiveWireCostTerms() : m_GradientMax(0.0)
+  {
+  }
+
+  void LiveWireCostTerms::Compute(const FloatImageType *image)
+  {
+    m_Region = image->GetLargestPossibleRegion();
+
+    // The filters do not support empty images and the terms of empty rows would read the first pixel of a row
+    if (0 == m_Region.GetNumberOfPixels())
+    {
+      m_Terms.clear();
+      m_GradientMax = 0.0;
+      this->Modified();
+      return;
+    }
+
+    // gradient magnitude
+    typedef itk::GradientMagnitudeImageFilter<FloatImageType, FloatImageType> GradientMagnitudeFilterType;
+    auto gradientMagnitudeFilter = GradientMagnitudeFilterType::New();
+    gradientMagnitudeFilter->SetInput(image);
+    gradientMagnitudeFilter->Update();
+
+    // gradient
+    typedef itk::GradientImageFilter<FloatImageType> GradientFilterType;
+    auto gradientFilter = GradientFilterType::New();
+    gradientFilter->SetInput(image);
+    gradientFilter->Update();
+
+    // canny edge detection
+    typedef itk::CannyEdgeDetectionImageFilter<FloatImageType, FloatImageType> CannyEdgeDetectionImageFilterType;
+    auto cannyEdgeDetectionFilter = CannyEdgeDetectionImageFilterType::New();
+    cannyEdgeDetectionFilter->SetInput(image);
+    cannyEdgeDetectionFilter->SetUpperThreshold(30);
+    cannyEdgeDetectionFilter->SetLowerThreshold(15);
+    cannyEdgeDetectionFilter->SetVariance(4);
+    cannyEdgeDetectionFilter->SetMaximumError(.01f);
+    cannyEdgeDetectionFilter->Update();
+
+    const auto width = m_Region.GetSize(0);
+    const auto height = m_Region.GetSize(1);
+
+    const auto *gradientMagnitudes = gradientMagnitudeFilter->GetOutput()->GetBufferPointer();
+    const auto *gradients = gradientFilter->GetOutput()->GetBufferPointer();
+    const auto *edges = cannyEdgeDetectionFilter->GetOutput()->GetBufferPointer();
+
+    m_Terms.resize(width * height);
+    std::vector<float> rowMaxima(height, 0.0f);
+
+    itk::MultiThreaderBase::New()->ParallelizeArray(0, height, [&](SizeValueType y) {
+      float rowMaximum = gradientMagnitudes[y * width];
+
+      for (auto i = y * width; i < (y + 1) * width; ++i)
+      {
+        auto &terms = m_Terms[i];
+
+        const double gradientMagnitude = gradientMagnitudes[i];
+        terms.GradientMagnitude = gradientMagnitudes[i];
+        rowMaximum = std::max(rowMaximum, gradientMagnitudes[i]);
+
+        // The direction costs compare the normalized gradient of a pixel with itself. Due to rounding, the
+        // scalar product slightly differs from 1 or is undefined for a vanishing gradient.
+        const double normalizedGradient[2] = {gradients[i][0] / gradientMagnitude, gradients[i][1] / gradientMagnitude};
+        double scalarProduct = normalizedGradient[0] * normalizedGradient[0] + normalizedGradient[1] * normalizedGradient[1];
+
+        if (std::abs(scalarProduct) >= 1.0)
+        {
+          // make sure the input for acos is valid
+          scalarProduct = 0.999999999;
+        }
+
+        terms.GradientDirectionCost = static_cast<float>(std::acos(scalarProduct) / 3.14159265);
+        terms.IsEdge = (edges[i] < 0 || edges[i] > 0) ? 1 : 0;
+      }
+
+      rowMaxima[y] = rowMaximum;
+    }, nullptr);
+
+    m_GradientMax = *std::max_element(rowMaxima.begin(), rowMaxima.end());
+
+    this->Modified();
+  }
+}
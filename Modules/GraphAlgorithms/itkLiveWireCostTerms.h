@@ -0,0 +1,86 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#ifndef __itkLiveWireCostTerms_h
+#define __itkLiveWireCostTerms_h
+
+#include "MitkGraphAlgorithmsExports.h"
+
+#include <itkImage.h>
+#include <itkObject.h>
+#include <itkObjectFactory.h>
+
+#include <vector>
+
+namespace itk
+{
+  /** \brief Per-pixel cost terms of ShortestPathCostFunctionLiveWire.
+
+  The terms only depend on the image and not on the start and end point of a path. They are computed
+  once per image and kept in a compact structure instead of separate gradient, gradient magnitude and
+  edge images, so that they can be shared by all searches on the same slice.
+
+  - Gradient Magnitude
+  - Gradient Direction costs
+  - Canny edges as approximation of the Laplacian zero crossings
+  */
+  class MITKGRAPHALGORITHMS_EXPORT LiveWireCostTerms : public Object
+  {
+  public:
+    typedef LiveWireCostTerms Self;
+    typedef Object Superclass;
+    typedef SmartPointer<Self> Pointer;
+    typedef SmartPointer<const Self> ConstPointer;
+
+    itkFactorylessNewMacro(Self);
+    itkTypeMacro(LiveWireCostTerms, Object);
+
+    typedef itk::Image<float, 2> FloatImageType;
+    typedef FloatImageType::IndexType IndexType;
+    typedef FloatImageType::RegionType RegionType;
+
+    struct PixelTerms
+    {
+      float GradientMagnitude;
+      float GradientDirectionCost;
+      unsigned char IsEdge;
+    };
+
+    /** \brief Computes the terms of all pixels of the largest possible region. The filters and the
+    evaluation of the terms run multithreaded.*/
+    void Compute(const FloatImageType *image);
+
+    const PixelTerms &GetPixelTerms(const IndexType &index) const
+    {
+      const auto &regionIndex = m_Region.GetIndex();
+      return m_Terms[(index[0] - regionIndex[0]) + (index[1] - regionIndex[1]) * m_Region.GetSize(0)];
+    }
+
+    itkGetConstMacro(GradientMax, double);
+
+    const RegionType &GetRegion() const { return m_Region; }
+
+    /** \brief Memory size of the terms in bytes.*/
+    std::size_t GetMemorySize() const { return m_Terms.size() * sizeof(PixelTerms); }
+
+  protected:
+    LiveWireCostTerms();
+    ~LiveWireCostTerms() override {}
+
+  private:
+    std::vector<PixelTerms> m_Terms;
+    RegionType m_Region;
+    double m_GradientMax;
+  };
+}
+
+#endif
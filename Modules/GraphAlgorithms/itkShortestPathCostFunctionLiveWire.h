@@ -13,6 +13,7 @@ found in the LICENSE file.
 #ifndef __itkShortestPathCostFunctionLiveWire_h
 #define __itkShortestPathCostFunctionLiveWire_h
 
+#include "itkLiveWireCostTerms.h"
 #include "itkShortestPathCostFunction.h"
 
 #include "itkImageRegionConstIterator.h"
@@ -35,6 +36,9 @@ namespace itk
   To compute  the costs of the gradient magnitude dynamically
   an iverted map of the histogram of gradient magnitude image is used.
 
+  The features only depend on the image and are computed by Initialize(). Via SetCostTerms( LiveWireCostTerms* )
+  features computed before for the same image can be reused instead.
+
   */
   template <class TInputImageType>
   class ITK_EXPORT ShortestPathCostFunctionLiveWire : public ShortestPathCostFunction<TInputImageType>
@@ -101,6 +105,13 @@ namespace itk
      \brief Set the maximum of the dynamic cost map to save computation time.
     */
     void SetCostMapMaximum(double max) { this->m_MaxMapCosts = max; }
+
+    /**
+     \brief Set the cost terms of the image, e.g. from a cache, which are computed by Initialize() otherwise.
+     The terms must have been computed for the image of this cost function. SetImage() resets them.
+    */
+    itkSetObjectMacro(CostTerms, LiveWireCostTerms);
+    itkGetModifiableObjectMacro(CostTerms, LiveWireCostTerms);
     enum Constants
     {
       MAPSCALEFACTOR = 10
@@ -118,18 +129,13 @@ namespace itk
     static double Gaussian(double x, double xOfGaussian, double yOfGaussian);
 
     const UnsignedCharImageType *GetMaskImage() { return this->m_MaskImage.GetPointer(); };
-    const FloatImageType *GetGradientMagnitudeImage() { return this->m_GradientMagnitudeImage.GetPointer(); };
-    const FloatImageType *GetEdgeImage() { return this->m_EdgeImage.GetPointer(); };
-    const VectorOutputImageType *GetGradientImage() { return this->m_GradientImage.GetPointer(); };
   protected:
     ShortestPathCostFunctionLiveWire();
 
     ~ShortestPathCostFunctionLiveWire() override{};
 
-    FloatImageType::Pointer m_GradientMagnitudeImage;
-    FloatImageType::Pointer m_EdgeImage;
+    LiveWireCostTerms::Pointer m_CostTerms;
     UnsignedCharImageType::Pointer m_MaskImage;
-    VectorOutputImageType::Pointer m_GradientImage;
 
     double m_MinCosts;
 
@@ -140,12 +146,8 @@ namespace itk
     typename Superclass::PixelType startValue;
     typename Superclass::PixelType endValue;
 
-    double m_GradientMax;
-
     RegionType m_RequestedRegion;
 
-    bool m_Initialized;
-
     std::map<int, int> m_CostMap;
 
     bool m_UseCostMap;
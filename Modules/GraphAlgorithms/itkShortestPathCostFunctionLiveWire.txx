@@ -17,19 +17,13 @@ found in the LICENSE file.
 
 #include <cmath>
 
-#include <itkCannyEdgeDetectionImageFilter.h>
 #include <itkCastImageFilter.h>
-#include <itkGradientImageFilter.h>
-#include <itkGradientMagnitudeImageFilter.h>
-#include <itkLaplacianImageFilter.h>
-#include <itkStatisticsImageFilter.h>
-#include <itkZeroCrossingImageFilter.h>
 
 namespace itk
 {
   // Constructor
   template <class TInputImageType>
-  ShortestPathCostFunctionLiveWire<TInputImageType>::ShortestPathCostFunctionLiveWire(): m_MinCosts(0.0), m_UseRepulsivePoints(false), m_GradientMax(0.0), m_Initialized(false),  m_UseCostMap(false), m_MaxMapCosts(-1.0)
+  ShortestPathCostFunctionLiveWire<TInputImageType>::ShortestPathCostFunctionLiveWire(): m_MinCosts(0.0), m_UseRepulsivePoints(false), m_UseCostMap(false), m_MaxMapCosts(-1.0)
   {
   }
 
@@ -63,7 +57,7 @@ namespace itk
       this->m_MaskImage->FillBuffer(0);
 
       this->Modified();
-      this->m_Initialized = false;
+      this->m_CostTerms = nullptr;
     }
   }
 
@@ -91,17 +85,16 @@ namespace itk
         return 1000;
     }
 
-    double gradientX, gradientY;
-    gradientX = gradientY = 0.0;
+    // all terms of the features at p2 are precomputed
+    const auto &terms = this->m_CostTerms->GetPixelTerms(p2);
+    const double gradientMax = this->m_CostTerms->GetGradientMax();
 
     double gradientCost;
 
     double gradientMagnitude;
 
     // Gradient Magnitude costs
-    gradientMagnitude = this->m_GradientMagnitudeImage->GetPixel(p2);
-    gradientX = m_GradientImage->GetPixel(p2)[0];
-    gradientY = m_GradientImage->GetPixel(p2)[1];
+    gradientMagnitude = terms.GradientMagnitude;
 
     if (m_UseCostMap && !m_CostMap.empty())
     {
@@ -199,59 +192,21 @@ namespace itk
       }
       else
       { // use linear mapping
-        gradientCost = 1.0 - (gradientMagnitude / m_GradientMax);
+        gradientCost = 1.0 - (gradientMagnitude / gradientMax);
       }
     }
     else
     { // use linear mapping
       // value between 0 (good) and 1 (bad)
-      gradientCost = 1.0 - (gradientMagnitude / m_GradientMax);
+      gradientCost = 1.0 - (gradientMagnitude / gradientMax);
     }
 
     //  Laplacian zero crossing costs
     // f(p) =     0;   if I(p)=0
     //     or     1;   if I(p)!=0
-    double laplacianCost;
-    typename Superclass::PixelType laplaceImageValue;
+    double laplacianCost = terms.IsEdge ? 1.0 : 0.0;
 
-    laplaceImageValue = m_EdgeImage->GetPixel(p2);
-
-    if (laplaceImageValue < 0 || laplaceImageValue > 0)
-    {
-      laplacianCost = 1.0;
-    }
-    else
-    {
-      laplacianCost = 0.0;
-    }
-
-    // gradient vector at p1
-    double nGradientAtP1[2];
-    nGradientAtP1[0] = gradientX; // previously computed for gradient magnitude
-    nGradientAtP1[1] = gradientY;
-
-    // gradient direction unit vector of p1
-    nGradientAtP1[0] /= gradientMagnitude;
-    nGradientAtP1[1] /= gradientMagnitude;
-    //-------
-
-    // gradient vector at p1
-    double nGradientAtP2[2];
-
-    nGradientAtP2[0] = m_GradientImage->GetPixel(p2)[0];
-    nGradientAtP2[1] = m_GradientImage->GetPixel(p2)[1];
-
-    nGradientAtP2[0] /= m_GradientMagnitudeImage->GetPixel(p2);
-    nGradientAtP2[1] /= m_GradientMagnitudeImage->GetPixel(p2);
-
-    double scalarProduct = (nGradientAtP1[0] * nGradientAtP2[0]) + (nGradientAtP1[1] * nGradientAtP2[1]);
-    if (std::abs(scalarProduct) >= 1.0)
-    {
-      // this should probably not happen; make sure the input for acos is valid
-      scalarProduct = 0.999999999;
-    }
-
-    double gradientDirectionCost = acos(scalarProduct) / 3.14159265;
+    double gradientDirectionCost = terms.GradientDirectionCost;
 
     if (this->m_UseCostMap)
     {
@@ -294,83 +249,23 @@ namespace itk
   template <class TInputImageType>
   void ShortestPathCostFunctionLiveWire<TInputImageType>::Initialize()
   {
-    if (!m_Initialized)
+    if (this->m_CostTerms.IsNull())
     {
       typedef itk::CastImageFilter<TInputImageType, FloatImageType> CastFilterType;
       typename CastFilterType::Pointer castFilter = CastFilterType::New();
       castFilter->SetInput(this->m_Image);
+      castFilter->Update();
 
-      // init gradient magnitude image
-      typedef itk::GradientMagnitudeImageFilter<FloatImageType, FloatImageType> GradientMagnitudeFilterType;
-      typename GradientMagnitudeFilterType::Pointer gradientFilter = GradientMagnitudeFilterType::New();
-      gradientFilter->SetInput(castFilter->GetOutput());
-      // gradientFilter->SetNumberOfThreads(4);
-      // gradientFilter->GetOutput()->SetRequestedRegion(m_RequestedRegion);
-
-      gradientFilter->Update();
-      this->m_GradientMagnitudeImage = gradientFilter->GetOutput();
-
-      typedef itk::StatisticsImageFilter<FloatImageType> StatisticsImageFilterType;
-      typename StatisticsImageFilterType::Pointer statisticsImageFilter = StatisticsImageFilterType::New();
-      statisticsImageFilter->SetInput(this->m_GradientMagnitudeImage);
-      statisticsImageFilter->Update();
-
-      m_GradientMax = statisticsImageFilter->GetMaximum();
-
-      typedef itk::GradientImageFilter<FloatImageType> GradientFilterType;
-
-      typename GradientFilterType::Pointer filter = GradientFilterType::New();
-      // sigma is specified in millimeters
-      // filter->SetSigma( 1.5 );
-      filter->SetInput(castFilter->GetOutput());
-      filter->Update();
-
-      m_GradientImage = filter->GetOutput();
-
-      // init zero crossings
-      // typedef  itk::ZeroCrossingImageFilter< TInputImageType, UnsignedCharImageType  > ZeroCrossingImageFilterType;
-      // ZeroCrossingImageFilterType::Pointer zeroCrossingImageFilter = ZeroCrossingImageFilterType::New();
-      // zeroCrossingImageFilter->SetInput(this->m_Image);
-      // zeroCrossingImageFilter->SetBackgroundValue(1);
-      // zeroCrossingImageFilter->SetForegroundValue(0);
-      // zeroCrossingImageFilter->SetNumberOfThreads(4);
-      // zeroCrossingImageFilter->Update();
-
-      // m_EdgeImage = zeroCrossingImageFilter->GetOutput();
-
-      // cast image to float to apply canny edge detection filter
-      /*typedef itk::CastImageFilter< TInputImageType, FloatImageType > CastFilterType;
-      CastFilterType::Pointer castFilter = CastFilterType::New();
-      castFilter->SetInput(this->m_Image);*/
-
-      // typedef itk::LaplacianImageFilter<FloatImageType, FloatImageType >  filterType;
-      // filterType::Pointer laplacianFilter = filterType::New();
-      // laplacianFilter->SetInput( castFilter->GetOutput() ); // NOTE: input image type must be double or float
-      // laplacianFilter->Update();
-
-      // m_EdgeImage = laplacianFilter->GetOutput();
-
-      // init canny edge detection
-      typedef itk::CannyEdgeDetectionImageFilter<FloatImageType, FloatImageType> CannyEdgeDetectionImageFilterType;
-      typename CannyEdgeDetectionImageFilterType::Pointer cannyEdgeDetectionfilter =
-        CannyEdgeDetectionImageFilterType::New();
-      cannyEdgeDetectionfilter->SetInput(castFilter->GetOutput());
-      cannyEdgeDetectionfilter->SetUpperThreshold(30);
-      cannyEdgeDetectionfilter->SetLowerThreshold(15);
-      cannyEdgeDetectionfilter->SetVariance(4);
-      cannyEdgeDetectionfilter->SetMaximumError(.01f);
-
-      cannyEdgeDetectionfilter->Update();
-      m_EdgeImage = cannyEdgeDetectionfilter->GetOutput();
-
-      // set minCosts
-      m_MinCosts = 0.0; // The lower, the more thoroughly! 0 = dijkstra. If estimate costs are lower than actual costs
+      // gradient magnitude, gradient direction and canny edges
+      this->m_CostTerms = LiveWireCostTerms::New();
+      this->m_CostTerms->Compute(castFilter->GetOutput());
+    }
+
+    // set minCosts
+    m_MinCosts = 0.0; // The lower, the more thoroughly! 0 = dijkstra. If estimate costs are lower than actual costs
                       // everything is fine. If estimation is higher than actual costs, you might not get the shortest
                       // but a different path.
 
-      m_Initialized = true;
-    }
-
     // check start/end point value
     startValue = this->m_Image->GetPixel(this->m_StartIndex);
     endValue = this->m_Image->GetPixel(this->m_EndIndex);
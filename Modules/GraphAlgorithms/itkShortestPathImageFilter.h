@@ -14,6 +14,7 @@ found in the LICENSE file.
 
 #include "itkImageToImageFilter.h"
 #include "itkShortestPathCostFunction.h"
+#include "itkShortestPathIndexedHeap.h"
 #include "itkShortestPathNode.h"
 #include <itkImageRegionIteratorWithIndex.h>
 
@@ -33,6 +34,10 @@ found in the LICENSE file.
 // algorithm time extends a lot. Necessary for GetDistanceImage
 // void SetStoreVectorOrder(bool) // Optional (default=false), Stores in which order the pixels were checked. Necessary
 // for GetVectorOrderImage
+// void SetUseBidirectionalSearch(bool) // Optional (default=false), Bidirectional A* on lazily allocated nodes. Much
+// faster for single paths in large images
+// void SetSearchCorridorMargin(unsigned int) // Optional (default=0), Restrict the bidirectional search to the
+// bounding box of start and end point enlarged by this margin
 // void AddEndIndex(const IndexType & EndIndex) //Optional. By calling this function you can add several endpoints! The
 // algorithm will look for several shortest Paths. From Start to all Endpoints.
 //
@@ -130,6 +135,20 @@ namespace itk
     itkSetMacro(ActivateTimeOut, bool);
     itkGetMacro(ActivateTimeOut, bool);
 
+    // \brief (default=false), Search a single shortest path by bidirectional A* from start and end point at once.
+    // Nodes are allocated lazily from a pool that is reused by subsequent updates instead of allocating a node for
+    // every pixel, and the open nodes are kept in indexed heaps with decrease-key. Ignored for multiple end points,
+    // CalcAllDistances and StoreVectorOrder, which need the node of every pixel.
+    itkSetMacro(UseBidirectionalSearch, bool);
+    itkGetMacro(UseBidirectionalSearch, bool);
+    itkBooleanMacro(UseBidirectionalSearch);
+
+    // \brief (default=0), Restricts the bidirectional search to the bounding box of start and end point enlarged by
+    // this number of pixels in each direction. 0 searches the whole requested region. The bidirectional search treats
+    // edges with infinite costs as impassable. If they block the corridor, the whole region is searched.
+    itkSetMacro(SearchCorridorMargin, unsigned int);
+    itkGetMacro(SearchCorridorMargin, unsigned int);
+
     // \brief returns shortest Path as vector
     std::vector<IndexType> GetVectorPath();
 
@@ -194,6 +213,26 @@ namespace itk
 
     std::vector<NodeNumType> m_VectorOrder;
 
+    // Node of the bidirectional search, index 0 refers to the search from the start point and 1 to the search
+    // from the end point
+    struct SearchNode
+    {
+      IndexType coord;
+      DistanceType distance[2];    // minimal costs from the start point / to the end point, -1 if unknown
+      NodeNumType prevNode[2];     // pool index of the previous / next node on the path
+      bool closed[2];
+    };
+
+    bool m_UseBidirectionalSearch;
+    unsigned int m_SearchCorridorMargin;
+    std::vector<SearchNode> m_SearchNodePool; // reused by subsequent searches
+    // Flat table of the pool index of each pixel in the search corridor. Only the entries of the pool's nodes are
+    // reset before the next search, which keeps the table and does not touch every pixel.
+    std::vector<NodeNumType> m_SearchNodeIndices;
+    IndexType m_SearchCorridorBegin;
+    InputImageSizeType m_SearchCorridorSize;
+    ShortestPathIndexedHeap m_OpenSearchNodes[2];
+
     ShortestPathImageFilter();
 
     ~ShortestPathImageFilter() override;
@@ -226,6 +265,16 @@ namespace itk
 
     // \brief Start ShortestPathSearch
     void StartShortestPathSearch();
+
+    // \brief Search the shortest path from start to end point by bidirectional A* and fill m_VectorPath.
+    // Returns false if there is no path within the search corridor.
+    bool StartBidirectionalSearch();
+
+    // \brief Returns the pool index of the search node of a pixel in the search corridor, which is created if necessary
+    NodeNumType GetSearchNode(const IndexType &coord);
+
+    // \brief Returns the position of a pixel in the search corridor, i.e. in m_SearchNodeIndices
+    std::size_t GetSearchCorridorIndex(const IndexType &coord) const;
   };
 
 } // end of namespace itk
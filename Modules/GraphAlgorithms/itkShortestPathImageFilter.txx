@@ -17,6 +17,7 @@ found in the LICENSE file.
 #include "mitkMemoryUtilities.h"
 #include <ctime>
 #include <algorithm>
+#include <cmath>
 #include <iostream>
 #include <vector>
 
@@ -35,8 +36,12 @@ namespace itk
       m_CalcAllDistances(false),
       multipleEndPoints(false),
       m_ActivateTimeOut(false),
-      m_Initialized(false)
+      m_Initialized(false),
+      m_UseBidirectionalSearch(false),
+      m_SearchCorridorMargin(0)
   {
+    m_SearchCorridorBegin.Fill(0);
+    m_SearchCorridorSize.Fill(0);
     m_endPoints.clear();
     m_endPointsClosed.clear();
 
@@ -417,10 +422,9 @@ namespace itk
     const typename TInputImageType::IndexType &a)
   {
     // Returns the minimal possible costs for a path from "a" to targetnode.
-    itk::Vector<float, 3> v;
-    v[0] = m_EndIndex[0] - a[0];
-    v[1] = m_EndIndex[1] - a[1];
-    v[2] = m_EndIndex[2] - a[2];
+    itk::Vector<float, TInputImageType::ImageDimension> v;
+    for (unsigned int i = 0; i < TInputImageType::ImageDimension; ++i)
+      v[i] = m_EndIndex[i] - a[i];
 
     return m_CostFunction->GetMinCost() * v.GetNorm();
   }
@@ -430,18 +434,29 @@ namespace itk
   {
     if (!m_Initialized)
     {
-      // Clean up previous stuff
-      CleanUp();
-
       // Calc Number of nodes
       auto imageDimensions = TInputImageType::ImageDimension;
       const InputImageSizeType &size = this->GetInput()->GetRequestedRegion().GetSize();
-      m_Graph_NumberOfNodes = 1;
+      NodeNumType numberOfNodes = 1;
       for (NodeNumType i = 0; i < imageDimensions; ++i)
-        m_Graph_NumberOfNodes = m_Graph_NumberOfNodes * size[i];
+        numberOfNodes = numberOfNodes * size[i];
+
+      // Reuse the main node list of the previous search if the number of nodes did not change
+      if (nullptr == m_Nodes || numberOfNodes != m_Graph_NumberOfNodes)
+      {
+        // Clean up previous stuff
+        CleanUp();
 
-      // Initialize mainNodeList with that number
-      m_Nodes = new ShortestPathNode[m_Graph_NumberOfNodes];
+        m_Graph_NumberOfNodes = numberOfNodes;
+
+        // Initialize mainNodeList with that number
+        m_Nodes = new ShortestPathNode[m_Graph_NumberOfNodes];
+      }
+      else
+      {
+        m_VectorOrder.clear();
+        m_VectorPath.clear();
+      }
 
       // Initialize each node in nodelist
       for (NodeNumType i = 0; i < m_Graph_NumberOfNodes; i++)
@@ -697,6 +712,232 @@ namespace itk
     }
   }
 
+  template <class TInputImageType, class TOutputImageType>
+  inline std::size_t ShortestPathImageFilter<TInputImageType, TOutputImageType>::GetSearchCorridorIndex(
+    const IndexType &coord) const
+  {
+    std::size_t index = 0;
+    for (int i = InputImageType::ImageDimension - 1; i >= 0; --i)
+      index = index * m_SearchCorridorSize[i] + (coord[i] - m_SearchCorridorBegin[i]);
+
+    return index;
+  }
+
+  template <class TInputImageType, class TOutputImageType>
+  inline NodeNumType ShortestPathImageFilter<TInputImageType, TOutputImageType>::GetSearchNode(const IndexType &coord)
+  {
+    auto &poolIndex = m_SearchNodeIndices[GetSearchCorridorIndex(coord)];
+
+    if (NodeNumType(-1) == poolIndex)
+    {
+      poolIndex = static_cast<NodeNumType>(m_SearchNodePool.size());
+
+      SearchNode node;
+      node.coord = coord;
+
+      for (unsigned int direction = 0; direction < 2; ++direction)
+      {
+        node.distance[direction] = -1;
+        node.prevNode[direction] = -1;
+        node.closed[direction] = false;
+      }
+
+      m_SearchNodePool.push_back(node);
+    }
+
+    return poolIndex;
+  }
+
+  template <class TInputImageType, class TOutputImageType>
+  bool ShortestPathImageFilter<TInputImageType, TOutputImageType>::StartBidirectionalSearch()
+  {
+    const unsigned int dim = InputImageType::ImageDimension;
+    const InputImageSizeType &size = this->GetInput()->GetRequestedRegion().GetSize();
+
+    // Keep the memory of the previous search, only the entries of its nodes have to be reset
+    for (const auto &node : m_SearchNodePool)
+      m_SearchNodeIndices[GetSearchCorridorIndex(node.coord)] = -1;
+
+    m_SearchNodePool.clear();
+    m_OpenSearchNodes[0].Clear();
+    m_OpenSearchNodes[1].Clear();
+
+    // Search corridor
+    IndexType corridorBegin, corridorEnd;
+    for (unsigned int i = 0; i < dim; ++i)
+    {
+      corridorBegin[i] = 0;
+      corridorEnd[i] = static_cast<typename IndexType::IndexValueType>(size[i]) - 1;
+
+      if (m_SearchCorridorMargin > 0)
+      {
+        const auto margin = static_cast<typename IndexType::IndexValueType>(m_SearchCorridorMargin);
+        corridorBegin[i] = std::max(corridorBegin[i], std::min(m_StartIndex[i], m_EndIndex[i]) - margin);
+        corridorEnd[i] = std::min(corridorEnd[i], std::max(m_StartIndex[i], m_EndIndex[i]) + margin);
+      }
+    }
+
+    if (!CoordIsInBounds(m_StartIndex) || !CoordIsInBounds(m_EndIndex))
+      return false;
+
+    std::size_t corridorVolume = 1;
+    for (unsigned int i = 0; i < dim; ++i)
+    {
+      m_SearchCorridorBegin[i] = corridorBegin[i];
+      m_SearchCorridorSize[i] = corridorEnd[i] - corridorBegin[i] + 1;
+      corridorVolume *= m_SearchCorridorSize[i];
+    }
+
+    // All entries are -1 at this point, new ones as well
+    if (m_SearchNodeIndices.size() < corridorVolume)
+      m_SearchNodeIndices.resize(corridorVolume, -1);
+
+    // Offsets to the neighbors, N4/N6 or N8/N26 like GetNeighbors()
+    std::vector<IndexType> neighborOffsets;
+    IndexType offset;
+    offset.Fill(-1);
+
+    while (true)
+    {
+      unsigned int numberOfNonZeros = 0;
+      for (unsigned int i = 0; i < dim; ++i)
+        numberOfNonZeros += 0 != offset[i] ? 1 : 0;
+
+      if (1 == numberOfNonZeros || (m_Graph_fullNeighbors && numberOfNonZeros > 1))
+        neighborOffsets.push_back(offset);
+
+      unsigned int i = 0;
+      while (i < dim && 1 == offset[i])
+        offset[i++] = -1;
+
+      if (i == dim)
+        break;
+
+      ++offset[i];
+    }
+
+    // Admissible estimates of the costs to the target of each search
+    const IndexType targets[2] = {m_EndIndex, m_StartIndex};
+    const double minCost = m_CostFunction->GetMinCost();
+
+    auto estimateCosts = [&](const IndexType &a, unsigned int direction) {
+      double squaredNorm = 0.0;
+      for (unsigned int i = 0; i < dim; ++i)
+      {
+        const double difference = targets[direction][i] - a[i];
+        squaredNorm += difference * difference;
+      }
+      return minCost * std::sqrt(squaredNorm);
+    };
+
+    const NodeNumType sourceNodes[2] = {GetSearchNode(m_StartIndex), GetSearchNode(m_EndIndex)};
+
+    for (unsigned int direction = 0; direction < 2; ++direction)
+    {
+      m_SearchNodePool[sourceNodes[direction]].distance[direction] = 0;
+      m_OpenSearchNodes[direction].Push(sourceNodes[direction],
+                                        estimateCosts(direction == 0 ? m_StartIndex : m_EndIndex, direction));
+    }
+
+    // Costs of the best path found so far and the node where both searches met
+    DistanceType bestDistance = -1;
+    NodeNumType meetingNode = sourceNodes[0] == sourceNodes[1] ? sourceNodes[0] : -1;
+
+    if (sourceNodes[0] == sourceNodes[1])
+      bestDistance = 0;
+
+    while (!m_OpenSearchNodes[0].IsEmpty() && !m_OpenSearchNodes[1].IsEmpty())
+    {
+      // The keys are lower bounds of the costs of any path through an open node. No better path can be found,
+      // once one of the searches cannot improve the best path anymore.
+      if (bestDistance >= 0 && (m_OpenSearchNodes[0].GetTopKey() >= bestDistance ||
+                                m_OpenSearchNodes[1].GetTopKey() >= bestDistance))
+        break;
+
+      // Expand the smaller search front
+      const unsigned int direction = m_OpenSearchNodes[0].GetSize() <= m_OpenSearchNodes[1].GetSize() ? 0 : 1;
+      const unsigned int otherDirection = 1 - direction;
+
+      const auto current = m_OpenSearchNodes[direction].Pop();
+      m_SearchNodePool[current].closed[direction] = true;
+
+      const DistanceType currentDistance = m_SearchNodePool[current].distance[direction];
+      const IndexType currentCoord = m_SearchNodePool[current].coord;
+
+      for (const auto &neighborOffset : neighborOffsets)
+      {
+        IndexType neighborCoord;
+        bool isInCorridor = true;
+
+        for (unsigned int i = 0; i < dim; ++i)
+        {
+          neighborCoord[i] = currentCoord[i] + neighborOffset[i];
+          isInCorridor = isInCorridor && neighborCoord[i] >= corridorBegin[i] && neighborCoord[i] <= corridorEnd[i];
+        }
+
+        if (!isInCorridor)
+          continue;
+
+        // Note that the pool may grow and invalidate references to its nodes
+        const auto neighbor = GetSearchNode(neighborCoord);
+
+        if (m_SearchNodePool[neighbor].closed[direction])
+          continue;
+
+        // The search from the end point follows the edges backwards
+        const DistanceType cost = 0 == direction ? m_CostFunction->GetCost(currentCoord, neighborCoord)
+                                                 : m_CostFunction->GetCost(neighborCoord, currentCoord);
+
+        // Edges with infinite costs are impassable, so that a blocked corridor falls back to the whole region
+        if (!std::isfinite(cost))
+          continue;
+
+        const DistanceType newDistance = currentDistance + cost;
+
+        auto &neighborNode = m_SearchNodePool[neighbor];
+
+        if (neighborNode.distance[direction] >= 0 && newDistance >= neighborNode.distance[direction])
+          continue;
+
+        neighborNode.distance[direction] = newDistance;
+        neighborNode.prevNode[direction] = current;
+        m_OpenSearchNodes[direction].Push(neighbor, newDistance + estimateCosts(neighborCoord, direction));
+
+        // Both searches met at the neighbor
+        if (neighborNode.distance[otherDirection] >= 0)
+        {
+          const DistanceType distance = newDistance + neighborNode.distance[otherDirection];
+
+          if (bestDistance < 0 || distance < bestDistance)
+          {
+            bestDistance = distance;
+            meetingNode = neighbor;
+          }
+        }
+      }
+    }
+
+    if (bestDistance < 0)
+      return false;
+
+    // Go backwards from the meeting node to the start node and forwards to the end node
+    m_VectorPath.clear();
+
+    for (auto node = meetingNode; node != sourceNodes[0]; node = m_SearchNodePool[node].prevNode[0])
+      m_VectorPath.push_back(m_SearchNodePool[node].coord);
+
+    m_VectorPath.push_back(m_StartIndex);
+    std::reverse(m_VectorPath.begin(), m_VectorPath.end());
+
+    for (auto node = meetingNode; node != sourceNodes[1];)
+    {
+      node = m_SearchNodePool[node].prevNode[1];
+      m_VectorPath.push_back(m_SearchNodePool[node].coord);
+    }
+
+    return true;
+  }
+
   template <class TInputImageType, class TOutputImageType>
   void ShortestPathImageFilter<TInputImageType, TOutputImageType>::MakeOutputs()
   {
@@ -858,13 +1099,36 @@ namespace itk
     m_VectorPath.clear();
     // TODO: if multiple Path, clear all multiple Paths
 
-    if (m_Nodes)
-      delete[] m_Nodes;
+    delete[] m_Nodes;
+    m_Nodes = nullptr;
   }
 
   template <class TInputImageType, class TOutputImageType>
   void ShortestPathImageFilter<TInputImageType, TOutputImageType>::GenerateData()
   {
+    if (m_UseBidirectionalSearch && !multipleEndPoints && !m_CalcAllDistances && !m_StoreVectorOrder)
+    {
+      m_VectorPath.clear();
+
+      if (!m_useCostFunction)
+      {
+        m_VectorPath.push_back(m_StartIndex);
+        m_VectorPath.push_back(m_EndIndex);
+        MakeOutputs();
+        return;
+      }
+
+      m_CostFunction->Initialize();
+
+      if (StartBidirectionalSearch())
+      {
+        MakeOutputs();
+        return;
+      }
+
+      // No path within the search corridor, fall back to the search on the whole region
+    }
+
     // Build Graph
     InitGraph();
 
@@ -0,0 +1,120 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+#include "itkShortestPathIndexedHeap.h"
+
+#include <limits>
+
+namespace
+{
+  const itk::NodeNumType NotInHeap = std::numeric_limits<itk::NodeNumType>::max();
+}
+
+namespace itk
+{
+  bool ShortestPathIndexedHeap::Contains(NodeNumType node) const
+  {
+    return node < m_Positions.size() && m_Positions[node] != NotInHeap;
+  }
+
+  void ShortestPathIndexedHeap::Push(NodeNumType node, DistanceType key)
+  {
+    if (node >= m_Positions.size())
+      m_Positions.resize(node + 1, NotInHeap);
+
+    auto position = m_Positions[node];
+
+    if (position == NotInHeap)
+    {
+      position = static_cast<NodeNumType>(m_Heap.size());
+      m_Heap.emplace_back(key, node);
+      m_Positions[node] = position;
+      this->SiftUp(position);
+    }
+    else if (key < m_Heap[position].first)
+    {
+      m_Heap[position].first = key;
+      this->SiftUp(position);
+    }
+    else
+    {
+      m_Heap[position].first = key;
+      this->SiftDown(position);
+    }
+  }
+
+  NodeNumType ShortestPathIndexedHeap::Pop()
+  {
+    const auto top = m_Heap.front().second;
+
+    this->Swap(0, m_Heap.size() - 1);
+    m_Heap.pop_back();
+    m_Positions[top] = NotInHeap;
+
+    if (!m_Heap.empty())
+      this->SiftDown(0);
+
+    return top;
+  }
+
+  void ShortestPathIndexedHeap::Clear()
+  {
+    for (const auto &entry : m_Heap)
+      m_Positions[entry.second] = NotInHeap;
+
+    m_Heap.clear();
+  }
+
+  void ShortestPathIndexedHeap::Swap(std::size_t a, std::size_t b)
+  {
+    std::swap(m_Heap[a], m_Heap[b]);
+    m_Positions[m_Heap[a].second] = static_cast<NodeNumType>(a);
+    m_Positions[m_Heap[b].second] = static_cast<NodeNumType>(b);
+  }
+
+  void ShortestPathIndexedHeap::SiftUp(std::size_t position)
+  {
+    while (position > 0)
+    {
+      const auto parent = (position - 1) / 2;
+
+      if (!(m_Heap[position].first < m_Heap[parent].first))
+        break;
+
+      this->Swap(position, parent);
+      position = parent;
+    }
+  }
+
+  void ShortestPathIndexedHeap::SiftDown(std::size_t position)
+  {
+    const auto size = m_Heap.size();
+
+    while (true)
+    {
+      auto smallest = position;
+      const auto left = 2 * position + 1;
+      const auto right = left + 1;
+
+      if (left < size && m_Heap[left].first < m_Heap[smallest].first)
+        smallest = left;
+
+      if (right < size && m_Heap[right].first < m_Heap[smallest].first)
+        smallest = right;
+
+      if (smallest == position)
+        break;
+
+      this->Swap(position, smallest);
+      position = smallest;
+    }
+  }
+}
@@ -0,0 +1,57 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+#ifndef __itkShortestPathIndexedHeap_h_
+#define __itkShortestPathIndexedHeap_h_
+
+#include "MitkGraphAlgorithmsExports.h"
+#include "itkShortestPathNode.h"
+
+#include <utility>
+#include <vector>
+
+namespace itk
+{
+  /** \brief Binary min-heap of node numbers with decrease-key.
+
+  The heap knows the position of each of its nodes, so the key of a node can be updated in logarithmic time
+  instead of removing and reinserting it. Node numbers are expected to be dense (e.g. indices into a node pool),
+  as the positions are stored in a vector indexed by node number. Clear() keeps the allocated memory for reuse.
+  */
+  class MITKGRAPHALGORITHMS_EXPORT ShortestPathIndexedHeap
+  {
+  public:
+    bool IsEmpty() const { return m_Heap.empty(); }
+    std::size_t GetSize() const { return m_Heap.size(); }
+    bool Contains(NodeNumType node) const;
+
+    /** \brief Inserts the node or updates its key, if it is already in the heap.*/
+    void Push(NodeNumType node, DistanceType key);
+
+    NodeNumType GetTop() const { return m_Heap.front().second; }
+    DistanceType GetTopKey() const { return m_Heap.front().first; }
+
+    /** \brief Removes and returns the node with the lowest key.*/
+    NodeNumType Pop();
+
+    void Clear();
+
+  private:
+    void Swap(std::size_t a, std::size_t b);
+    void SiftUp(std::size_t position);
+    void SiftDown(std::size_t position);
+
+    std::vector<std::pair<DistanceType, NodeNumType>> m_Heap;
+    std::vector<NodeNumType> m_Positions;
+  };
+}
+
+#endif
@@ -0,0 +1,5 @@
+set(MODULE_TESTS
+  itkLiveWireCostTermsTest.cpp
+  itkShortestPathImageFilterTest.cpp
+  itkShortestPathIndexedHeapTest.cpp
+)
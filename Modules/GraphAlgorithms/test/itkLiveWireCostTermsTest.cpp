@@ -0,0 +1,217 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include <itkLiveWireCostTerms.h>
+#include <itkShortestPathCostFunctionLiveWire.h>
+
+#include <itkCannyEdgeDetectionImageFilter.h>
+#include <itkGradientImageFilter.h>
+#include <itkGradientMagnitudeImageFilter.h>
+#include <itkImageRegionIteratorWithIndex.h>
+
+#include <mitkTestFixture.h>
+#include <mitkTestingMacros.h>
+
+#include <algorithm>
+#include <cmath>
+
+class itkLiveWireCostTermsTestSuite : public mitk::TestFixture
+{
+  CPPUNIT_TEST_SUITE(itkLiveWireCostTermsTestSuite);
+  MITK_TEST(GetCost_PrecomputedTerms_EqualsOnTheFlyCosts);
+  MITK_TEST(GetCost_SharedTerms_EqualsOwnTerms);
+  MITK_TEST(Compute_EmptyImage_HasNoTerms);
+  CPPUNIT_TEST_SUITE_END();
+
+private:
+  typedef itk::LiveWireCostTerms::FloatImageType ImageType;
+  typedef itk::ShortestPathCostFunctionLiveWire<ImageType> CostFunctionType;
+
+  ImageType::Pointer m_Image;
+
+  /** Costs of ShortestPathCostFunctionLiveWire with linear mapping, computed from the filter outputs for
+   * every call like before the terms were precomputed.*/
+  class OnTheFlyCosts
+  {
+  public:
+    explicit OnTheFlyCosts(const ImageType *image)
+    {
+      auto gradientMagnitudeFilter = itk::GradientMagnitudeImageFilter<ImageType, ImageType>::New();
+      gradientMagnitudeFilter->SetInput(image);
+      gradientMagnitudeFilter->Update();
+      m_GradientMagnitudeImage = gradientMagnitudeFilter->GetOutput();
+
+      auto gradientFilter = itk::GradientImageFilter<ImageType>::New();
+      gradientFilter->SetInput(image);
+      gradientFilter->Update();
+      m_GradientImage = gradientFilter->GetOutput();
+
+      auto cannyEdgeDetectionFilter = itk::CannyEdgeDetectionImageFilter<ImageType, ImageType>::New();
+      cannyEdgeDetectionFilter->SetInput(image);
+      cannyEdgeDetectionFilter->SetUpperThreshold(30);
+      cannyEdgeDetectionFilter->SetLowerThreshold(15);
+      cannyEdgeDetectionFilter->SetVariance(4);
+      cannyEdgeDetectionFilter->SetMaximumError(.01f);
+      cannyEdgeDetectionFilter->Update();
+      m_EdgeImage = cannyEdgeDetectionFilter->GetOutput();
+
+      m_GradientMax = 0.0;
+      itk::ImageRegionIteratorWithIndex<ImageType> iter(m_GradientMagnitudeImage,
+                                                        m_GradientMagnitudeImage->GetLargestPossibleRegion());
+      for (; !iter.IsAtEnd(); ++iter)
+        m_GradientMax = std::max<double>(m_GradientMax, iter.Get());
+    }
+
+    double GetCost(const ImageType::IndexType &p1, const ImageType::IndexType &p2) const
+    {
+      const double gradientMagnitude = m_GradientMagnitudeImage->GetPixel(p2);
+      const double gradientCost = 1.0 - gradientMagnitude / m_GradientMax;
+
+      const auto gradient = m_GradientImage->GetPixel(p2);
+      const double normalizedGradient[2] = { gradient[0] / gradientMagnitude, gradient[1] / gradientMagnitude };
+      double scalarProduct =
+        normalizedGradient[0] * normalizedGradient[0] + normalizedGradient[1] * normalizedGradient[1];
+
+      if (std::abs(scalarProduct) >= 1.0)
+        scalarProduct = 0.999999999;
+
+      const double gradientDirectionCost = std::acos(scalarProduct) / 3.14159265;
+      const double laplacianCost = 0.0 != m_EdgeImage->GetPixel(p2) ? 1.0 : 0.0;
+
+      const double costs = 0.10 * laplacianCost + 0.85 * gradientCost + 0.05 * gradientDirectionCost;
+      return (p1[0] == p2[0] || p1[1] == p2[1]) ? costs : std::sqrt(2.0) * costs;
+    }
+
+    double GetGradientMax() const { return m_GradientMax; }
+
+    bool IsEdge(const ImageType::IndexType &index) const { return 0.0 != m_EdgeImage->GetPixel(index); }
+
+  private:
+    ImageType::Pointer m_GradientMagnitudeImage;
+    itk::GradientImageFilter<ImageType>::OutputImageType::Pointer m_GradientImage;
+    ImageType::Pointer m_EdgeImage;
+    double m_GradientMax;
+  };
+
+  /** Equal costs, where undefined gradient directions of flat pixels yield NaN on both sides.*/
+  static void AssertEqualCosts(double expected, double actual)
+  {
+    if (std::isnan(expected))
+    {
+      CPPUNIT_ASSERT(std::isnan(actual));
+      return;
+    }
+
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(expected, actual, 1e-5);
+  }
+
+  CostFunctionType::Pointer CreateCostFunction(itk::LiveWireCostTerms *costTerms = nullptr)
+  {
+    const ImageType::IndexType start = { { 2, 2 } };
+    const ImageType::IndexType end = { { 37, 27 } };
+
+    auto costFunction = CostFunctionType::New();
+    costFunction->SetImage(m_Image);
+    costFunction->SetCostTerms(costTerms);
+    costFunction->SetStartIndex(start);
+    costFunction->SetEndIndex(end);
+    costFunction->Initialize();
+    return costFunction;
+  }
+
+public:
+  /** 40x30 pixels with a bright rectangle on an intensity ramp.*/
+  void setUp() override
+  {
+    m_Image = ImageType::New();
+    ImageType::SizeType size = { { 40, 30 } };
+    m_Image->SetRegions(size);
+    m_Image->Allocate();
+
+    itk::ImageRegionIteratorWithIndex<ImageType> iter(m_Image, m_Image->GetLargestPossibleRegion());
+    for (; !iter.IsAtEnd(); ++iter)
+    {
+      const auto &index = iter.GetIndex();
+      const bool isInside = index[0] >= 10 && index[0] < 30 && index[1] >= 8 && index[1] < 22;
+      iter.Set((isInside ? 300.0f : 0.0f) + 0.5f * index[0]);
+    }
+  }
+
+  void tearDown() override { m_Image = nullptr; }
+
+  void GetCost_PrecomputedTerms_EqualsOnTheFlyCosts()
+  {
+    const OnTheFlyCosts expectedCosts(m_Image);
+    auto costFunction = this->CreateCostFunction();
+
+    auto costTerms = costFunction->GetCostTerms();
+    CPPUNIT_ASSERT(costTerms != nullptr);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(expectedCosts.GetGradientMax(), costTerms->GetGradientMax(), 1e-5);
+
+    const auto &region = m_Image->GetLargestPossibleRegion();
+    bool hasEdges = false;
+
+    itk::ImageRegionIteratorWithIndex<ImageType> iter(m_Image, region);
+    for (; !iter.IsAtEnd(); ++iter)
+    {
+      const auto &p1 = iter.GetIndex();
+      hasEdges = hasEdges || expectedCosts.IsEdge(p1);
+      CPPUNIT_ASSERT_EQUAL(expectedCosts.IsEdge(p1), 0 != costTerms->GetPixelTerms(p1).IsEdge);
+
+      for (int dy = -1; dy <= 1; ++dy)
+      {
+        for (int dx = -1; dx <= 1; ++dx)
+        {
+          ImageType::IndexType p2 = { { p1[0] + dx, p1[1] + dy } };
+
+          if ((0 == dx && 0 == dy) || !region.IsInside(p2))
+            continue;
+
+          AssertEqualCosts(expectedCosts.GetCost(p1, p2), costFunction->GetCost(p1, p2));
+        }
+      }
+    }
+
+    CPPUNIT_ASSERT_MESSAGE("Test image has no edges", hasEdges);
+  }
+
+  void GetCost_SharedTerms_EqualsOwnTerms()
+  {
+    auto costFunction = this->CreateCostFunction();
+
+    // Terms of another cost function, e.g. from the LiveWireCostTermsCache, are not computed again
+    auto sharedCostFunction = this->CreateCostFunction(costFunction->GetCostTerms());
+    CPPUNIT_ASSERT(costFunction->GetCostTerms() == sharedCostFunction->GetCostTerms());
+
+    const ImageType::IndexType p1 = { { 9, 7 } };
+    const ImageType::IndexType p2 = { { 10, 8 } };
+    const ImageType::IndexType p3 = { { 10, 9 } };
+
+    AssertEqualCosts(costFunction->GetCost(p1, p2), sharedCostFunction->GetCost(p1, p2));
+    AssertEqualCosts(costFunction->GetCost(p2, p3), sharedCostFunction->GetCost(p2, p3));
+  }
+
+  void Compute_EmptyImage_HasNoTerms()
+  {
+    auto emptyImage = ImageType::New();
+    ImageType::SizeType size = { { 0, 5 } };
+    emptyImage->SetRegions(size);
+
+    auto costTerms = itk::LiveWireCostTerms::New();
+    CPPUNIT_ASSERT_NO_THROW(costTerms->Compute(emptyImage));
+    CPPUNIT_ASSERT_EQUAL(std::size_t(0), costTerms->GetMemorySize());
+    CPPUNIT_ASSERT_EQUAL(0.0, costTerms->GetGradientMax());
+    CPPUNIT_ASSERT_EQUAL(itk::SizeValueType(0), costTerms->GetRegion().GetNumberOfPixels());
+  }
+};
+
+MITK_TEST_SUITE_REGISTRATION(itkLiveWireCostTerms)
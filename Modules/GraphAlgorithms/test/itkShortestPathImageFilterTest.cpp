@@ -0,0 +1,193 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include <itkShortestPathCostFunction.h>
+#include <itkShortestPathImageFilter.h>
+
+#include <mitkTestFixture.h>
+#include <mitkTestingMacros.h>
+
+#include <cmath>
+#include <limits>
+#include <vector>
+
+namespace
+{
+  typedef itk::Image<float, 2> ImageType;
+
+  /** Asymmetric costs without ties: the length of an edge times a pseudo-random factor in [1, 2) of its target
+   * pixel. Edges into the pixels of a wall are impassable.*/
+  class NoiseCostFunction : public itk::ShortestPathCostFunction<ImageType>
+  {
+  public:
+    typedef NoiseCostFunction Self;
+    typedef itk::ShortestPathCostFunction<ImageType> Superclass;
+    typedef itk::SmartPointer<Self> Pointer;
+    typedef itk::SmartPointer<const Self> ConstPointer;
+
+    itkNewMacro(Self);
+
+    // \brief Pixels at x == wallX with y < wallEnd are impassable. Default is no wall.
+    void SetWall(itk::IndexValueType wallX, itk::IndexValueType wallEnd)
+    {
+      m_WallX = wallX;
+      m_WallEnd = wallEnd;
+    }
+
+    double GetCost(IndexType p1, IndexType p2) override
+    {
+      if (p2[0] == m_WallX && p2[1] < m_WallEnd)
+        return std::numeric_limits<double>::infinity();
+
+      const double dx = p2[0] - p1[0];
+      const double dy = p2[1] - p1[1];
+      const double length = std::sqrt(dx * dx + dy * dy);
+      const double noise = std::abs(std::sin(p2[0] * 12.9898 + p2[1] * 78.233) * 43758.5453);
+
+      return length * (1.0 + noise - std::floor(noise));
+    }
+
+    double GetMinCost() override { return 1.0; }
+
+    void Initialize() override {}
+
+  protected:
+    NoiseCostFunction() : m_WallX(-1), m_WallEnd(0) {}
+
+  private:
+    itk::IndexValueType m_WallX;
+    itk::IndexValueType m_WallEnd;
+  };
+}
+
+class itkShortestPathImageFilterTestSuite : public mitk::TestFixture
+{
+  CPPUNIT_TEST_SUITE(itkShortestPathImageFilterTestSuite);
+  MITK_TEST(BidirectionalSearch_N4_EqualsDenseSearch);
+  MITK_TEST(BidirectionalSearch_N8_EqualsDenseSearch);
+  MITK_TEST(BidirectionalSearch_BlockedCorridor_FallsBackToWholeRegion);
+  CPPUNIT_TEST_SUITE_END();
+
+private:
+  typedef itk::ShortestPathImageFilter<ImageType, ImageType> FilterType;
+
+  ImageType::Pointer m_Image;
+  NoiseCostFunction::Pointer m_CostFunction;
+
+  FilterType::Pointer CreateFilter(bool useBidirectionalSearch, bool fullNeighbors, unsigned int corridorMargin = 0)
+  {
+    auto filter = FilterType::New();
+    filter->SetInput(m_Image);
+    filter->SetCostFunction(m_CostFunction);
+    filter->SetMakeOutputImage(false);
+    filter->SetGraph_fullNeighbors(fullNeighbors);
+    filter->SetUseBidirectionalSearch(useBidirectionalSearch);
+    filter->SetSearchCorridorMargin(corridorMargin);
+    return filter;
+  }
+
+  static std::vector<ImageType::IndexType> ComputePath(FilterType *filter,
+                                                       const ImageType::IndexType &start,
+                                                       const ImageType::IndexType &end)
+  {
+    filter->SetStartIndex(start);
+    filter->SetEndIndex(end);
+    filter->Modified();
+    filter->Update();
+    return filter->GetVectorPath();
+  }
+
+  double GetPathCost(const std::vector<ImageType::IndexType> &path) const
+  {
+    double cost = 0.0;
+
+    for (std::size_t i = 1; i < path.size(); ++i)
+      cost += m_CostFunction->GetCost(path[i - 1], path[i]);
+
+    return cost;
+  }
+
+  void AssertBidirectionalSearchEqualsDenseSearch(bool fullNeighbors)
+  {
+    // The bidirectional filter is reused, so that its node pool and lookup table are reset between searches
+    auto bidirectionalFilter = this->CreateFilter(true, fullNeighbors);
+
+    const std::vector<std::pair<ImageType::IndexType, ImageType::IndexType>> startAndEndPoints = {
+      { { { 3, 4 } }, { { 44, 40 } } },
+      { { { 40, 10 } }, { { 8, 30 } } },
+      { { { 20, 20 } }, { { 23, 21 } } },
+      { { { 0, 47 } }, { { 47, 0 } } },
+      { { { 12, 12 } }, { { 12, 12 } } }
+    };
+
+    for (const auto &points : startAndEndPoints)
+    {
+      auto densePath = ComputePath(this->CreateFilter(false, fullNeighbors), points.first, points.second);
+      auto bidirectionalPath = ComputePath(bidirectionalFilter, points.first, points.second);
+
+      CPPUNIT_ASSERT(!bidirectionalPath.empty());
+      CPPUNIT_ASSERT_EQUAL(points.first, bidirectionalPath.front());
+      CPPUNIT_ASSERT_EQUAL(points.second, bidirectionalPath.back());
+      CPPUNIT_ASSERT_DOUBLES_EQUAL(this->GetPathCost(densePath), this->GetPathCost(bidirectionalPath), 1e-9);
+      CPPUNIT_ASSERT(densePath == bidirectionalPath);
+    }
+  }
+
+public:
+  void setUp() override
+  {
+    m_Image = ImageType::New();
+    ImageType::SizeType size;
+    size.Fill(48);
+    m_Image->SetRegions(size);
+    m_Image->Allocate();
+    m_Image->FillBuffer(0.0f);
+
+    m_CostFunction = NoiseCostFunction::New();
+    m_CostFunction->SetImage(m_Image);
+  }
+
+  void tearDown() override
+  {
+    m_CostFunction = nullptr;
+    m_Image = nullptr;
+  }
+
+  void BidirectionalSearch_N4_EqualsDenseSearch() { this->AssertBidirectionalSearchEqualsDenseSearch(false); }
+
+  void BidirectionalSearch_N8_EqualsDenseSearch() { this->AssertBidirectionalSearchEqualsDenseSearch(true); }
+
+  void BidirectionalSearch_BlockedCorridor_FallsBackToWholeRegion()
+  {
+    // The wall blocks the corridor around start and end point, the only gap is far outside of it
+    m_CostFunction->SetWall(20, 40);
+
+    const ImageType::IndexType start = { { 5, 5 } };
+    const ImageType::IndexType end = { { 40, 5 } };
+
+    auto densePath = ComputePath(this->CreateFilter(false, false), start, end);
+    auto corridorPath = ComputePath(this->CreateFilter(true, false, 4), start, end);
+
+    const auto cost = this->GetPathCost(corridorPath);
+    CPPUNIT_ASSERT(std::isfinite(cost));
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(this->GetPathCost(densePath), cost, 1e-9);
+    CPPUNIT_ASSERT(densePath == corridorPath);
+
+    bool passesGap = false;
+    for (const auto &index : corridorPath)
+      passesGap = passesGap || (20 == index[0] && index[1] >= 40);
+
+    CPPUNIT_ASSERT_MESSAGE("Path does not pass the gap of the wall", passesGap);
+  }
+};
+
+MITK_TEST_SUITE_REGISTRATION(itkShortestPathImageFilter)
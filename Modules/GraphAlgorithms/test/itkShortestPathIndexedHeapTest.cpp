@@ -0,0 +1,118 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include <itkShortestPathIndexedHeap.h>
+
+#include <mitkTestFixture.h>
+#include <mitkTestingMacros.h>
+
+#include <vector>
+
+class itkShortestPathIndexedHeapTestSuite : public mitk::TestFixture
+{
+  CPPUNIT_TEST_SUITE(itkShortestPathIndexedHeapTestSuite);
+  MITK_TEST(Pop_PushedNodes_ReturnsNodesByAscendingKey);
+  MITK_TEST(Push_LowerKey_MovesNodeUp);
+  MITK_TEST(Push_HigherKey_MovesNodeDown);
+  MITK_TEST(Clear_FilledHeap_RemovesAllNodes);
+  CPPUNIT_TEST_SUITE_END();
+
+private:
+  itk::ShortestPathIndexedHeap m_Heap;
+
+  std::vector<itk::NodeNumType> PopAll()
+  {
+    std::vector<itk::NodeNumType> nodes;
+
+    while (!m_Heap.IsEmpty())
+      nodes.push_back(m_Heap.Pop());
+
+    return nodes;
+  }
+
+public:
+  void setUp() override
+  {
+    m_Heap.Clear();
+  }
+
+  void Pop_PushedNodes_ReturnsNodesByAscendingKey()
+  {
+    const double keys[] = { 5.0, 3.0, 8.0, 1.0, 9.0, 2.0, 7.0, 4.0, 6.0, 0.0 };
+
+    for (itk::NodeNumType node = 0; node < 10; ++node)
+      m_Heap.Push(node, keys[node]);
+
+    CPPUNIT_ASSERT_EQUAL(std::size_t(10), m_Heap.GetSize());
+    CPPUNIT_ASSERT_EQUAL(itk::NodeNumType(9), m_Heap.GetTop());
+    CPPUNIT_ASSERT_EQUAL(0.0, m_Heap.GetTopKey());
+
+    const std::vector<itk::NodeNumType> expectedOrder = { 9, 3, 5, 1, 7, 0, 8, 6, 2, 4 };
+    CPPUNIT_ASSERT(expectedOrder == this->PopAll());
+
+    for (itk::NodeNumType node = 0; node < 10; ++node)
+      CPPUNIT_ASSERT(!m_Heap.Contains(node));
+  }
+
+  void Push_LowerKey_MovesNodeUp()
+  {
+    for (itk::NodeNumType node = 0; node < 6; ++node)
+      m_Heap.Push(node, 10.0 + node);
+
+    // Decrease-key of a contained node does not insert it again
+    m_Heap.Push(4, 1.0);
+    CPPUNIT_ASSERT_EQUAL(std::size_t(6), m_Heap.GetSize());
+    CPPUNIT_ASSERT_EQUAL(itk::NodeNumType(4), m_Heap.GetTop());
+    CPPUNIT_ASSERT_EQUAL(1.0, m_Heap.GetTopKey());
+
+    m_Heap.Push(5, 10.5);
+
+    const std::vector<itk::NodeNumType> expectedOrder = { 4, 0, 5, 1, 2, 3 };
+    CPPUNIT_ASSERT(expectedOrder == this->PopAll());
+  }
+
+  void Push_HigherKey_MovesNodeDown()
+  {
+    for (itk::NodeNumType node = 0; node < 6; ++node)
+      m_Heap.Push(node, 10.0 + node);
+
+    m_Heap.Push(0, 12.5);
+    CPPUNIT_ASSERT_EQUAL(std::size_t(6), m_Heap.GetSize());
+    CPPUNIT_ASSERT_EQUAL(itk::NodeNumType(1), m_Heap.GetTop());
+
+    const std::vector<itk::NodeNumType> expectedOrder = { 1, 2, 0, 3, 4, 5 };
+    CPPUNIT_ASSERT(expectedOrder == this->PopAll());
+  }
+
+  void Clear_FilledHeap_RemovesAllNodes()
+  {
+    m_Heap.Push(3, 3.0);
+    m_Heap.Push(100, 1.0);
+    m_Heap.Push(7, 2.0);
+    CPPUNIT_ASSERT(m_Heap.Contains(100));
+    CPPUNIT_ASSERT(!m_Heap.Contains(50));
+
+    m_Heap.Clear();
+    CPPUNIT_ASSERT(m_Heap.IsEmpty());
+    CPPUNIT_ASSERT(!m_Heap.Contains(3));
+    CPPUNIT_ASSERT(!m_Heap.Contains(100));
+
+    // The heap is usable after clearing
+    m_Heap.Push(100, 5.0);
+    m_Heap.Push(3, 4.0);
+    CPPUNIT_ASSERT_EQUAL(itk::NodeNumType(3), m_Heap.Pop());
+    CPPUNIT_ASSERT_EQUAL(itk::NodeNumType(100), m_Heap.Pop());
+    CPPUNIT_ASSERT(m_Heap.IsEmpty());
+  }
+};
+
+MITK_TEST_SUITE_REGISTRATION(itkShortestPathIndexedHeap)
@@ -1,5 +1,7 @@
 set(MODULE_TESTS
   mitkImageStatisticsCalculatorTest.cpp
+  mitkAdaptiveHistogramTest.cpp
+  mitkIncrementalLabelStatisticsTest.cpp
   mitkPointSetStatisticsCalculatorTest.cpp
   mitkPointSetDifferenceStatisticsCalculatorTest.cpp
   mitkImageStatisticsTextureAnalysisTest.cpp
@@ -0,0 +1,221 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+// Testing
+#include "mitkTestingMacros.h"
+#include "mitkTestFixture.h"
+
+//MITK includes
+#include <mitkAdaptiveHistogram.h>
+#include <mitkNumericConstants.h>
+#include <mitkStatisticsImageFilter.h>
+
+#include <itkImage.h>
+#include <itkImageRegionIterator.h>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <random>
+
+class mitkAdaptiveHistogramTestSuite : public mitk::TestFixture
+{
+  CPPUNIT_TEST_SUITE(mitkAdaptiveHistogramTestSuite);
+  MITK_TEST(IntegerValuesAreRebinnedExactly);
+  MITK_TEST(MergedPartialsEqualSinglePass);
+  MITK_TEST(NonFiniteValuesAreIgnored);
+  MITK_TEST(StatisticsFilterWithAdaptiveHistogram);
+  CPPUNIT_TEST_SUITE_END();
+
+  using HistogramType = mitk::AdaptiveHistogram::HistogramType;
+
+private:
+  std::vector<double> m_IntegerValues;
+  std::vector<double> m_RealValues;
+
+  static HistogramType::Pointer CreateHistogram(unsigned int size, double lowerBound, double upperBound)
+  {
+    HistogramType::SizeType histogramSize(1);
+    histogramSize[0] = size;
+    HistogramType::MeasurementVectorType histogramLowerBound(1);
+    histogramLowerBound[0] = lowerBound;
+    HistogramType::MeasurementVectorType histogramUpperBound(1);
+    histogramUpperBound[0] = upperBound;
+
+    auto histogram = HistogramType::New();
+    histogram->SetMeasurementVectorSize(1);
+    histogram->Initialize(histogramSize, histogramLowerBound, histogramUpperBound);
+    return histogram;
+  }
+
+  static HistogramType::Pointer CreateReferenceHistogram(const std::vector<double>& values, unsigned int size)
+  {
+    const auto minmax = std::minmax_element(values.begin(), values.end());
+    auto histogram = CreateHistogram(size, *minmax.first, *minmax.second);
+
+    HistogramType::MeasurementVectorType measurement(1);
+    HistogramType::IndexType index(1);
+
+    for (auto value : values)
+    {
+      measurement[0] = value;
+      histogram->GetIndex(measurement, index);
+      histogram->IncreaseFrequencyOfIndex(index, 1);
+    }
+
+    return histogram;
+  }
+
+  static HistogramType::Pointer CreateAdaptiveHistogram(const mitk::AdaptiveHistogram& adaptiveHistogram, const std::vector<double>& values, unsigned int size)
+  {
+    const auto minmax = std::minmax_element(values.begin(), values.end());
+    auto histogram = CreateHistogram(size, *minmax.first, *minmax.second);
+    adaptiveHistogram.FillHistogram(histogram, *minmax.first, *minmax.second);
+    return histogram;
+  }
+
+  static void CheckEqualFrequencies(const HistogramType* reference, const HistogramType* histogram)
+  {
+    CPPUNIT_ASSERT_EQUAL(reference->GetSize(0), histogram->GetSize(0));
+
+    for (unsigned int bin = 0; bin < reference->GetSize(0); ++bin)
+      CPPUNIT_ASSERT_EQUAL(reference->GetFrequency(bin), histogram->GetFrequency(bin));
+  }
+
+public:
+  void setUp() override
+  {
+    std::mt19937 generator(42);
+    std::uniform_int_distribution<int> integerDistribution(-1024, 3071);
+    std::normal_distribution<double> realDistribution(100.0, 20.0);
+
+    m_IntegerValues.clear();
+    m_RealValues.clear();
+
+    for (int i = 0; i < 100000; ++i)
+    {
+      m_IntegerValues.push_back(integerDistribution(generator));
+      m_RealValues.push_back(realDistribution(generator));
+    }
+  }
+
+  void IntegerValuesAreRebinnedExactly()
+  {
+    mitk::AdaptiveHistogram adaptiveHistogram(true);
+
+    for (auto value : m_IntegerValues)
+      adaptiveHistogram.AddValue(value);
+
+    CPPUNIT_ASSERT_EQUAL(1.0, adaptiveHistogram.GetBinWidth());
+    CPPUNIT_ASSERT_EQUAL(static_cast<mitk::AdaptiveHistogram::FrequencyType>(m_IntegerValues.size()), adaptiveHistogram.GetTotalFrequency());
+
+    for (unsigned int size : { 10u, 100u, 333u })
+    {
+      auto reference = CreateReferenceHistogram(m_IntegerValues, size);
+      auto histogram = CreateAdaptiveHistogram(adaptiveHistogram, m_IntegerValues, size);
+      CheckEqualFrequencies(reference, histogram);
+    }
+  }
+
+  void MergedPartialsEqualSinglePass()
+  {
+    mitk::AdaptiveHistogram singlePass;
+    std::vector<mitk::AdaptiveHistogram> partials(3);
+
+    for (std::size_t i = 0; i < m_RealValues.size(); ++i)
+    {
+      singlePass.AddValue(m_RealValues[i]);
+      partials[i * partials.size() / m_RealValues.size()].AddValue(m_RealValues[i]);
+    }
+
+    mitk::AdaptiveHistogram merged;
+
+    for (const auto& partial : partials)
+      merged.Merge(partial);
+
+    CPPUNIT_ASSERT_EQUAL(singlePass.GetBinWidth(), merged.GetBinWidth());
+    CheckEqualFrequencies(CreateAdaptiveHistogram(singlePass, m_RealValues, 100), CreateAdaptiveHistogram(merged, m_RealValues, 100));
+
+    // only values closer than one fine bin to a bin border may end up in the neighbouring bin
+    auto reference = CreateReferenceHistogram(m_RealValues, 100);
+    auto histogram = CreateAdaptiveHistogram(merged, m_RealValues, 100);
+    double difference = 0;
+
+    for (unsigned int bin = 0; bin < reference->GetSize(0); ++bin)
+      difference += std::abs(static_cast<double>(reference->GetFrequency(bin)) - static_cast<double>(histogram->GetFrequency(bin)));
+
+    CPPUNIT_ASSERT(difference <= 0.005 * m_RealValues.size());
+  }
+
+  void NonFiniteValuesAreIgnored()
+  {
+    mitk::AdaptiveHistogram adaptiveHistogram;
+    CPPUNIT_ASSERT(adaptiveHistogram.IsEmpty());
+
+    adaptiveHistogram.AddValue(std::numeric_limits<double>::quiet_NaN());
+    adaptiveHistogram.AddValue(std::numeric_limits<double>::infinity());
+    CPPUNIT_ASSERT(adaptiveHistogram.IsEmpty());
+
+    adaptiveHistogram.AddValue(0);
+    adaptiveHistogram.AddValue(-1e300);
+    adaptiveHistogram.AddValue(1e300);
+    CPPUNIT_ASSERT_EQUAL(static_cast<mitk::AdaptiveHistogram::FrequencyType>(3), adaptiveHistogram.GetTotalFrequency());
+  }
+
+  void StatisticsFilterWithAdaptiveHistogram()
+  {
+    using ImageType = itk::Image<short, 3>;
+
+    ImageType::SizeType size;
+    size.Fill(40);
+
+    auto image = ImageType::New();
+    image->SetRegions(ImageType::RegionType(size));
+    image->Allocate();
+
+    std::size_t i = 0;
+    for (itk::ImageRegionIterator<ImageType> it(image, image->GetLargestPossibleRegion()); !it.IsAtEnd(); ++it, ++i)
+      it.Set(static_cast<short>(m_IntegerValues[i % m_IntegerValues.size()]));
+
+    // extrema that occur more than once are reported at their first position
+    ImageType::IndexType minIndex = {{ 3, 2, 1 }};
+    ImageType::IndexType maxIndex = {{ 5, 0, 30 }};
+    image->SetPixel(minIndex, -2000);
+    image->SetPixel(maxIndex, 4000);
+    image->SetPixel({{ 6, 0, 30 }}, 4000);
+    image->SetPixel({{ 3, 2, 39 }}, -2000);
+
+    auto fixedFilter = mitk::StatisticsImageFilter<ImageType>::New();
+    fixedFilter->SetInput(image);
+    fixedFilter->SetHistogramParameters(100, -2000, 4000);
+    fixedFilter->Update();
+
+    auto adaptiveFilter = mitk::StatisticsImageFilter<ImageType>::New();
+    adaptiveFilter->SetInput(image);
+    adaptiveFilter->SetAdaptiveHistogramParameters(100);
+    adaptiveFilter->Update();
+
+    CPPUNIT_ASSERT_EQUAL(static_cast<short>(-2000), adaptiveFilter->GetMinimum());
+    CPPUNIT_ASSERT_EQUAL(static_cast<short>(4000), adaptiveFilter->GetMaximum());
+    CPPUNIT_ASSERT_EQUAL(minIndex, adaptiveFilter->GetMinimumIndex());
+    CPPUNIT_ASSERT_EQUAL(maxIndex, adaptiveFilter->GetMaximumIndex());
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(fixedFilter->GetMean(), adaptiveFilter->GetMean(), mitk::eps);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(fixedFilter->GetVariance(), adaptiveFilter->GetVariance(), mitk::eps);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(fixedFilter->GetMedian(), adaptiveFilter->GetMedian(), mitk::eps);
+    CheckEqualFrequencies(fixedFilter->GetHistogram(), adaptiveFilter->GetHistogram());
+
+    adaptiveFilter->SetAdaptiveHistogramBinSize(50, 10);
+    adaptiveFilter->Update();
+    CPPUNIT_ASSERT_EQUAL(static_cast<HistogramType::SizeValueType>(120), adaptiveFilter->GetHistogram()->GetSize(0));
+  }
+};
+
+MITK_TEST_SUITE_REGISTRATION(mitkAdaptiveHistogram)
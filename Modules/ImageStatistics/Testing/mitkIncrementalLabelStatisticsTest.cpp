@@ -0,0 +1,346 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+// Testing
+#include "mitkTestingMacros.h"
+#include "mitkTestFixture.h"
+
+//MITK includes
+#include <mitkIncrementalLabelStatistics.h>
+#include <mitkImageCast.h>
+#include <mitkImageStatisticsCalculator.h>
+#include <mitkImageStatisticsConstants.h>
+#include <mitkImagePixelReadAccessor.h>
+#include <mitkImagePixelWriteAccessor.h>
+#include <mitkMultiLabelMaskGenerator.h>
+#include <mitkNumericConstants.h>
+
+#include <itkImage.h>
+#include <itkImageRegionIterator.h>
+
+#include <vtkImageData.h>
+
+class mitkIncrementalLabelStatisticsTestSuite : public mitk::TestFixture
+{
+  CPPUNIT_TEST_SUITE(mitkIncrementalLabelStatisticsTestSuite);
+  MITK_TEST(InitialStatistics);
+  MITK_TEST(SliceModificationsAreAppliedIncrementally);
+  MITK_TEST(LabelModificationTimes);
+  MITK_TEST(IncrementalStatisticsCalculation);
+  CPPUNIT_TEST_SUITE_END();
+
+  using LabelValueType = mitk::MultiLabelSegmentation::LabelValueType;
+  using VolumeAccessorType = mitk::ImagePixelWriteAccessor<LabelValueType, 3>;
+
+private:
+  mitk::Image::Pointer m_ReferenceImage;
+  mitk::MultiLabelSegmentation::Pointer m_Segmentation;
+  LabelValueType m_LabelA;
+  LabelValueType m_LabelB;
+
+  static void FillBlock(VolumeAccessorType& accessor, itk::Index<3> from, itk::Index<3> to, LabelValueType value)
+  {
+    itk::Index<3> index;
+    for (index[2] = from[2]; index[2] <= to[2]; ++index[2])
+      for (index[1] = from[1]; index[1] <= to[1]; ++index[1])
+        for (index[0] = from[0]; index[0] <= to[0]; ++index[0])
+          accessor.SetPixelByIndex(index, value);
+  }
+
+  /** Writes a block like the segmentation tools write slices: through the vtkImageData of the group image
+   * and not through an image accessor.*/
+  static void PaintBlock(mitk::Image* groupImage, itk::Index<3> from, itk::Index<3> to, LabelValueType value)
+  {
+    auto vtkImage = groupImage->GetVtkImageData(0);
+
+    for (auto z = from[2]; z <= to[2]; ++z)
+      for (auto y = from[1]; y <= to[1]; ++y)
+        for (auto x = from[0]; x <= to[0]; ++x)
+          *static_cast<LabelValueType*>(vtkImage->GetScalarPointer(x, y, z)) = value;
+  }
+
+  /** Paints the block into slice z of the group image and announces the modification like the segmentation tools do.*/
+  void PaintSlice(itk::Index<3> from, itk::Index<3> to, LabelValueType value)
+  {
+    auto groupImage = m_Segmentation->GetGroupImage(0);
+    auto originalSlice = CreateSlice(groupImage, from[2]);
+    auto originalMTime = groupImage->GetMTime();
+
+    PaintBlock(groupImage, from, to, value);
+    groupImage->Modified();
+    m_Segmentation->InvokeEvent(mitk::GroupSliceModifiedEvent(0, 0, nullptr, originalSlice, nullptr, originalMTime));
+  }
+
+  static itk::ModifiedTimeType NewTimeStamp()
+  {
+    itk::TimeStamp timeStamp;
+    timeStamp.Modified();
+    return timeStamp.GetMTime();
+  }
+
+  static mitk::ImageStatisticsContainer::Pointer ComputeStatistics(const mitk::Image* image, const mitk::MultiLabelSegmentation* segmentation,
+    const mitk::ImageStatisticsContainer* previousStatistics = nullptr, const mitk::ImageStatisticsCalculator::ModifiedLabelsType& modifiedLabels = {})
+  {
+    auto maskGenerator = mitk::MultiLabelMaskGenerator::New();
+    maskGenerator->SetMultiLabelSegmentation(segmentation);
+
+    auto calculator = mitk::ImageStatisticsCalculator::New();
+    calculator->SetInputImage(image);
+    calculator->SetMask(maskGenerator);
+    calculator->SetPreviousStatistics(previousStatistics, modifiedLabels);
+    return calculator->GetStatistics();
+  }
+
+  /** Compares all values and counts; extremum positions are ambiguous if the extremum is not unique.*/
+  static void CheckEqualStatisticsObjects(const mitk::ImageStatisticsContainer::ImageStatisticsObject& expected, const mitk::ImageStatisticsContainer::ImageStatisticsObject& actual)
+  {
+    for (const auto& name : expected.GetExistingStatisticNames())
+    {
+      const auto expectedValue = expected.GetValueNonConverted(name);
+      const auto actualValue = actual.GetValueNonConverted(name);
+
+      if (auto expectedReal = boost::get<mitk::ImageStatisticsContainer::RealType>(&expectedValue))
+      {
+        CPPUNIT_ASSERT_DOUBLES_EQUAL_MESSAGE(name, *expectedReal, boost::get<mitk::ImageStatisticsContainer::RealType>(actualValue), 1e-6);
+      }
+      else if (auto expectedCount = boost::get<mitk::ImageStatisticsContainer::VoxelCountType>(&expectedValue))
+      {
+        CPPUNIT_ASSERT_EQUAL_MESSAGE(name, *expectedCount, boost::get<mitk::ImageStatisticsContainer::VoxelCountType>(actualValue));
+      }
+    }
+  }
+
+  /** Creates a copy of an axial slice of the (axis aligned) group image, like the segmentation tools do before they write a slice.*/
+  static mitk::Image::Pointer CreateSlice(mitk::Image* groupImage, itk::IndexValueType z)
+  {
+    unsigned int dimensions[2] = { groupImage->GetDimension(0), groupImage->GetDimension(1) };
+
+    auto slice = mitk::Image::New();
+    slice->Initialize(mitk::MultiLabelSegmentation::GetPixelType(), 2, dimensions);
+
+    mitk::Point3D index;
+    index.Fill(0);
+    index[2] = z;
+    mitk::Point3D origin;
+    groupImage->GetGeometry()->IndexToWorld(index, origin);
+
+    slice->SetSpacing(groupImage->GetGeometry()->GetSpacing());
+    slice->SetOrigin(origin);
+
+    mitk::ImagePixelReadAccessor<LabelValueType, 3> volumeAccessor(groupImage);
+    mitk::ImagePixelWriteAccessor<LabelValueType, 2> sliceAccessor(slice);
+
+    for (itk::IndexValueType y = 0; y < static_cast<itk::IndexValueType>(dimensions[1]); ++y)
+      for (itk::IndexValueType x = 0; x < static_cast<itk::IndexValueType>(dimensions[0]); ++x)
+        sliceAccessor.SetPixelByIndex({{ x, y }}, volumeAccessor.GetPixelByIndex({{ x, y, z }}));
+
+    return slice;
+  }
+
+  static void CheckEqualStatistics(const mitk::IncrementalLabelStatistics* expected, const mitk::IncrementalLabelStatistics* actual, LabelValueType label)
+  {
+    CPPUNIT_ASSERT_EQUAL(expected->GetVoxelCount(label), actual->GetVoxelCount(label));
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(expected->GetVolume(label), actual->GetVolume(label), mitk::eps);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(expected->GetMean(label), actual->GetMean(label), 1e-8);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(expected->GetVariance(label), actual->GetVariance(label), 1e-8);
+    CPPUNIT_ASSERT_EQUAL(expected->GetBoundingBox(label), actual->GetBoundingBox(label));
+
+    auto expectedHistogram = expected->GetHistogram(label);
+    auto actualHistogram = actual->GetHistogram(label);
+    CPPUNIT_ASSERT_EQUAL(expectedHistogram->GetSize(0), actualHistogram->GetSize(0));
+
+    for (unsigned int bin = 0; bin < expectedHistogram->GetSize(0); ++bin)
+      CPPUNIT_ASSERT_EQUAL(expectedHistogram->GetFrequency(bin), actualHistogram->GetFrequency(bin));
+  }
+
+  mitk::IncrementalLabelStatistics::Pointer CreateStatistics() const
+  {
+    auto statistics = mitk::IncrementalLabelStatistics::New();
+    statistics->SetSegmentation(m_Segmentation);
+    statistics->SetReferenceImage(m_ReferenceImage);
+    statistics->SetNumberOfHistogramBins(16);
+    statistics->Update();
+    return statistics;
+  }
+
+public:
+  void setUp() override
+  {
+    using ImageType = itk::Image<short, 3>;
+
+    ImageType::SizeType size = {{ 12, 10, 8 }};
+    ImageType::SpacingType spacing;
+    spacing[0] = 1.0;
+    spacing[1] = 1.0;
+    spacing[2] = 2.0;
+
+    auto image = ImageType::New();
+    image->SetRegions(ImageType::RegionType(size));
+    image->SetSpacing(spacing);
+    image->Allocate();
+
+    for (itk::ImageRegionIterator<ImageType> it(image, image->GetLargestPossibleRegion()); !it.IsAtEnd(); ++it)
+    {
+      const auto index = it.GetIndex();
+      it.Set(static_cast<short>(index[0] * index[0] - 3 * index[1] + 7 * index[2]));
+    }
+
+    mitk::CastToMitkImage(image, m_ReferenceImage);
+
+    m_Segmentation = mitk::MultiLabelSegmentation::New();
+    m_Segmentation->Initialize(m_ReferenceImage);
+
+    mitk::Color color;
+    color.Set(1.0f, 0.0f, 0.0f);
+    m_LabelA = m_Segmentation->AddLabel("A", color, 0)->GetValue();
+    m_LabelB = m_Segmentation->AddLabel("B", color, 0)->GetValue();
+
+    auto groupImage = m_Segmentation->GetGroupImage(0);
+    {
+      VolumeAccessorType accessor(groupImage);
+      FillBlock(accessor, {{ 2, 2, 1 }}, {{ 5, 5, 6 }}, m_LabelA);
+      FillBlock(accessor, {{ 7, 1, 3 }}, {{ 9, 3, 4 }}, m_LabelB);
+    }
+    groupImage->Modified();
+  }
+
+  void tearDown() override
+  {
+    m_Segmentation = nullptr;
+    m_ReferenceImage = nullptr;
+  }
+
+  void InitialStatistics()
+  {
+    auto statistics = this->CreateStatistics();
+
+    CPPUNIT_ASSERT_EQUAL(std::size_t(96), statistics->GetVoxelCount(m_LabelA));
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(192.0, statistics->GetVolume(m_LabelA), mitk::eps);
+    CPPUNIT_ASSERT_EQUAL(std::size_t(18), statistics->GetVoxelCount(m_LabelB));
+
+    mitk::IncrementalLabelStatistics::RegionType expectedBoundingBox({{ 7, 1, 3 }}, {{ 3, 3, 2 }});
+    CPPUNIT_ASSERT_EQUAL(expectedBoundingBox, statistics->GetBoundingBox(m_LabelB));
+
+    // mean of x*x - 3*y + 7*z over x in [7,9], y in [1,3], z in [3,4]
+    const double expectedMean = (49.0 + 64.0 + 81.0) / 3.0 - 3.0 * 2.0 + 7.0 * 3.5;
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(expectedMean, statistics->GetMean(m_LabelB), 1e-8);
+    CPPUNIT_ASSERT_EQUAL(static_cast<mitk::IncrementalLabelStatistics::HistogramType::AbsoluteFrequencyType>(18),
+      statistics->GetHistogram(m_LabelB)->GetTotalFrequency());
+  }
+
+  void SliceModificationsAreAppliedIncrementally()
+  {
+    auto statistics = this->CreateStatistics();
+
+    // paint label B over parts of label A and the background in slice 3
+    this->PaintSlice({{ 0, 0, 3 }}, {{ 3, 3, 3 }}, m_LabelB);
+
+    // erase label A completely from slice 1, which shrinks its bounding box
+    this->PaintSlice({{ 0, 0, 1 }}, {{ 11, 9, 1 }}, mitk::MultiLabelSegmentation::UNLABELED_VALUE);
+
+    mitk::IncrementalLabelStatistics::RegionType expectedBoundingBox({{ 2, 2, 2 }}, {{ 4, 4, 5 }});
+    CPPUNIT_ASSERT_EQUAL(expectedBoundingBox, statistics->GetBoundingBox(m_LabelA));
+
+    // the announced modifications keep the statistics valid, so Update() does not recompute them
+    const auto modifiedTime = statistics->GetMTime();
+    statistics->Update();
+    CPPUNIT_ASSERT_EQUAL(modifiedTime, statistics->GetMTime());
+
+    auto recomputedStatistics = this->CreateStatistics();
+    CheckEqualStatistics(recomputedStatistics, statistics, m_LabelA);
+    CheckEqualStatistics(recomputedStatistics, statistics, m_LabelB);
+  }
+
+  void LabelModificationTimes()
+  {
+    auto statistics = this->CreateStatistics();
+    auto groupImage = m_Segmentation->GetGroupImage(0);
+
+    // paint label B over background only
+    auto timeStamp = NewTimeStamp();
+    this->PaintSlice({{ 0, 0, 3 }}, {{ 1, 1, 3 }}, m_LabelB);
+
+    CPPUNIT_ASSERT(statistics->GetLabelMTime(m_LabelA) < timeStamp);
+    CPPUNIT_ASSERT(statistics->GetLabelMTime(m_LabelB) > timeStamp);
+    CPPUNIT_ASSERT_EQUAL(mitk::IncrementalLabelStatistics::GroupIndexType(0), statistics->GetGroupIndex(m_LabelB));
+
+    // writes through an image accessor are not announced and do not call Modified(); Update() has to recompute the group
+    timeStamp = NewTimeStamp();
+    {
+      VolumeAccessorType accessor(groupImage);
+      FillBlock(accessor, {{ 7, 1, 3 }}, {{ 9, 3, 4 }}, mitk::MultiLabelSegmentation::UNLABELED_VALUE);
+    }
+    statistics->Update();
+
+    CPPUNIT_ASSERT(statistics->GetLabelMTime(m_LabelA) > timeStamp);
+    CPPUNIT_ASSERT_EQUAL(std::size_t(4), statistics->GetVoxelCount(m_LabelB));
+
+    // labels without statistics count as modified with the last recomputation
+    const LabelValueType unusedLabel = 100;
+    CPPUNIT_ASSERT(statistics->GetLabelMTime(unusedLabel) > timeStamp);
+    CPPUNIT_ASSERT(statistics->GetLabelValues().size() == 2);
+  }
+
+  void IncrementalStatisticsCalculation()
+  {
+    auto statistics = this->CreateStatistics();
+    auto previousStatistics = ComputeStatistics(m_ReferenceImage, m_Segmentation);
+    const auto previousTime = NewTimeStamp();
+
+    // label B is extended over the background, label A is not touched
+    this->PaintSlice({{ 0, 0, 3 }}, {{ 1, 1, 3 }}, m_LabelB);
+
+    // collect the modified labels like QmitkImageStatisticsDataGenerator does
+    mitk::ImageStatisticsCalculator::ModifiedLabelsType modifiedLabels;
+    for (auto label : statistics->GetLabelValues())
+    {
+      if (statistics->GetLabelMTime(label) > previousTime)
+      {
+        mitk::ImageStatisticsCalculator::ModifiedLabel modifiedLabel;
+        modifiedLabel.maskID = statistics->GetGroupIndex(label);
+        modifiedLabel.region = statistics->GetBoundingBox(label);
+        modifiedLabels[0][label] = modifiedLabel;
+      }
+    }
+
+    CPPUNIT_ASSERT_EQUAL(std::size_t(1), modifiedLabels[0].size());
+    CPPUNIT_ASSERT_EQUAL(std::size_t(1), modifiedLabels[0].count(m_LabelB));
+
+    auto incrementalStatistics = ComputeStatistics(m_ReferenceImage, m_Segmentation, previousStatistics, modifiedLabels);
+    auto recomputedStatistics = ComputeStatistics(m_ReferenceImage, m_Segmentation);
+
+    CPPUNIT_ASSERT(incrementalStatistics->StatisticsExist(m_LabelA, 0));
+    CPPUNIT_ASSERT(incrementalStatistics->StatisticsExist(m_LabelB, 0));
+    CPPUNIT_ASSERT_EQUAL(static_cast<mitk::ImageStatisticsContainer::VoxelCountType>(22),
+      incrementalStatistics->GetStatistics(m_LabelB, 0).GetValueConverted<mitk::ImageStatisticsContainer::VoxelCountType>(mitk::ImageStatisticsConstants::NUMBEROFVOXELS()));
+
+    CheckEqualStatisticsObjects(recomputedStatistics->GetStatistics(m_LabelA, 0), incrementalStatistics->GetStatistics(m_LabelA, 0));
+    CheckEqualStatisticsObjects(recomputedStatistics->GetStatistics(m_LabelB, 0), incrementalStatistics->GetStatistics(m_LabelB, 0));
+
+    // erasing label B completely removes its statistics
+    this->PaintSlice({{ 0, 0, 3 }}, {{ 11, 9, 3 }}, mitk::MultiLabelSegmentation::UNLABELED_VALUE);
+    this->PaintSlice({{ 0, 0, 4 }}, {{ 11, 9, 4 }}, m_LabelA);
+    this->PaintSlice({{ 0, 0, 4 }}, {{ 11, 9, 4 }}, mitk::MultiLabelSegmentation::UNLABELED_VALUE);
+
+    modifiedLabels.clear();
+    modifiedLabels[0][m_LabelA] = { 0, statistics->GetBoundingBox(m_LabelA) };
+    modifiedLabels[0][m_LabelB] = { 0, statistics->GetBoundingBox(m_LabelB) };
+    CPPUNIT_ASSERT_EQUAL(std::size_t(0), modifiedLabels[0][m_LabelB].region.GetNumberOfPixels());
+
+    incrementalStatistics = ComputeStatistics(m_ReferenceImage, m_Segmentation, incrementalStatistics, modifiedLabels);
+    recomputedStatistics = ComputeStatistics(m_ReferenceImage, m_Segmentation);
+
+    CPPUNIT_ASSERT(!incrementalStatistics->StatisticsExist(m_LabelB, 0));
+    CheckEqualStatisticsObjects(recomputedStatistics->GetStatistics(m_LabelA, 0), incrementalStatistics->GetStatistics(m_LabelA, 0));
+  }
+};
+
+MITK_TEST_SUITE_REGISTRATION(mitkIncrementalLabelStatistics)
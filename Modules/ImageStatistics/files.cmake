@@ -11,6 +11,8 @@ set(CPP_FILES
   mitkMultiLabelMaskGenerator.cpp
   mitkImageMaskGenerator.cpp
   mitkHistogramStatisticsCalculator.cpp
+  mitkIncrementalLabelStatistics.cpp
+  mitkAdaptiveHistogram.cpp
   mitkIgnorePixelMaskGenerator.cpp
   mitkImageStatisticsPredicateHelper.cpp
   mitkImageStatisticsContainerNodeHelper.cpp
@@ -33,6 +35,8 @@ set(H_FILES
   mitkMultiLabelMaskGenerator.h
   mitkImageMaskGenerator.h
   mitkHistogramStatisticsCalculator.h
+  mitkIncrementalLabelStatistics.h
+  mitkAdaptiveHistogram.h
   mitkMaskUtilities.h
   mitkitkMaskImageFilter.h
   mitkIgnorePixelMaskGenerator.h
@@ -0,0 +1,196 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include <mitkAdaptiveHistogram.h>
+
+#include <algorithm>
+#include <numeric>
+
+namespace
+{
+  // Keeps the scale factor 2^-exponent and all bin indices of finite values representable.
+  constexpr int MinimumExponent = -1000;
+
+  // Initial resolution relative to the magnitude of the first value.
+  constexpr int InitialRelativeExponent = -32;
+
+  // Initial size of the bin array. It grows with the occupied value range.
+  constexpr std::size_t MinimumArraySize = 64;
+}
+
+namespace mitk
+{
+  AdaptiveHistogram::AdaptiveHistogram(bool integerValues)
+    : m_IntegerValues(integerValues), m_Exponent(0), m_Scale(1), m_FirstBin(0), m_NumberOfBins(0)
+  {
+  }
+
+  bool AdaptiveHistogram::IsEmpty() const
+  {
+    return m_Frequencies.empty();
+  }
+
+  AdaptiveHistogram::FrequencyType AdaptiveHistogram::GetTotalFrequency() const
+  {
+    return std::accumulate(m_Frequencies.begin(), m_Frequencies.end(), FrequencyType(0));
+  }
+
+  AdaptiveHistogram::MeasurementType AdaptiveHistogram::GetBinWidth() const
+  {
+    return std::ldexp(1.0, m_Exponent);
+  }
+
+  void AdaptiveHistogram::AddValueOutsideOfBins(MeasurementType value)
+  {
+    if (!std::isfinite(value))
+      return;
+
+    if (m_Frequencies.empty())
+    {
+      int exponent = 0;
+
+      if (!m_IntegerValues)
+        exponent = 0 != value ? std::ilogb(value) + InitialRelativeExponent : MinimumExponent;
+
+      this->Rebin(std::max(exponent, MinimumExponent), value, value);
+      const auto bin = std::floor(value * m_Scale) - m_FirstBin;
+      ++m_Frequencies[static_cast<std::size_t>(bin)];
+      return;
+    }
+
+    MeasurementType low = value;
+    MeasurementType high = value;
+
+    if (this->GetOccupiedRange(low, high))
+    {
+      low = std::min(low, value);
+      high = std::max(high, value);
+    }
+
+    this->Rebin(GetRequiredExponent(m_Exponent, low, high), low, high);
+
+    const auto bin = std::floor(value * m_Scale) - m_FirstBin;
+    ++m_Frequencies[static_cast<std::size_t>(bin)];
+  }
+
+  void AdaptiveHistogram::Merge(const AdaptiveHistogram& other)
+  {
+    if (other.IsEmpty())
+      return;
+
+    if (this->IsEmpty())
+    {
+      *this = other;
+      return;
+    }
+
+    MeasurementType low, high, otherLow, otherHigh;
+
+    if (!other.GetOccupiedRange(otherLow, otherHigh))
+      return;
+
+    if (this->GetOccupiedRange(low, high))
+    {
+      low = std::min(low, otherLow);
+      high = std::max(high, otherHigh);
+    }
+    else
+    {
+      low = otherLow;
+      high = otherHigh;
+    }
+
+    this->Rebin(GetRequiredExponent(std::max(m_Exponent, other.m_Exponent), low, high), low, high);
+
+    for (std::size_t i = 0; i < other.m_Frequencies.size(); ++i)
+    {
+      if (0 == other.m_Frequencies[i])
+        continue;
+
+      const auto bin = std::floor(std::ldexp(other.m_FirstBin + i, other.m_Exponent - m_Exponent)) - m_FirstBin;
+      m_Frequencies[static_cast<std::size_t>(bin)] += other.m_Frequencies[i];
+    }
+  }
+
+  void AdaptiveHistogram::FillHistogram(HistogramType* histogram, MeasurementType minimum, MeasurementType maximum) const
+  {
+    HistogramType::MeasurementVectorType measurement(1);
+    HistogramType::IndexType index(1);
+
+    for (std::size_t i = 0; i < m_Frequencies.size(); ++i)
+    {
+      if (0 == m_Frequencies[i])
+        continue;
+
+      measurement[0] = std::min(std::max(std::ldexp(m_FirstBin + i, m_Exponent), minimum), maximum);
+      histogram->GetIndex(measurement, index);
+      histogram->IncreaseFrequencyOfIndex(index, m_Frequencies[i]);
+    }
+  }
+
+  bool AdaptiveHistogram::GetOccupiedRange(MeasurementType& low, MeasurementType& high) const
+  {
+    const auto isOccupied = [](FrequencyType frequency) { return 0 != frequency; };
+
+    const auto first = std::find_if(m_Frequencies.begin(), m_Frequencies.end(), isOccupied);
+
+    if (m_Frequencies.end() == first)
+      return false;
+
+    const auto last = std::find_if(m_Frequencies.rbegin(), m_Frequencies.rend(), isOccupied);
+
+    low = std::ldexp(m_FirstBin + std::distance(m_Frequencies.begin(), first), m_Exponent);
+    high = std::ldexp(m_FirstBin + std::distance(last, m_Frequencies.rend()) - 1, m_Exponent);
+
+    return true;
+  }
+
+  int AdaptiveHistogram::GetRequiredExponent(int exponent, MeasurementType low, MeasurementType high)
+  {
+    // Written as negation, so that overflowing bin indices (inf - inf) also require a larger exponent.
+    while (!(std::floor(std::ldexp(high, -exponent)) - std::floor(std::ldexp(low, -exponent)) < MaximumNumberOfBins))
+      ++exponent;
+
+    return exponent;
+  }
+
+  void AdaptiveHistogram::Rebin(int exponent, MeasurementType low, MeasurementType high)
+  {
+    const auto lowBin = std::floor(std::ldexp(low, -exponent));
+    const auto highBin = std::floor(std::ldexp(high, -exponent));
+
+    // The array covers twice the occupied range (rounded up to a power of two), so that it is
+    // only reallocated a logarithmic number of times while the value range grows.
+    std::size_t size = MinimumArraySize;
+    while (size < MaximumNumberOfBins && size < 2 * (highBin - lowBin + 1))
+      size *= 2;
+
+    const auto firstBin = lowBin - std::floor((size - 1 - (highBin - lowBin)) / 2);
+
+    std::vector<FrequencyType> frequencies(size, 0);
+
+    for (std::size_t i = 0; i < m_Frequencies.size(); ++i)
+    {
+      if (0 == m_Frequencies[i])
+        continue;
+
+      const auto bin = std::floor(std::ldexp(m_FirstBin + i, m_Exponent - exponent)) - firstBin;
+      frequencies[static_cast<std::size_t>(bin)] += m_Frequencies[i];
+    }
+
+    m_Frequencies.swap(frequencies);
+    m_Exponent = exponent;
+    m_Scale = std::ldexp(1.0, -exponent);
+    m_FirstBin = firstBin;
+    m_NumberOfBins = static_cast<MeasurementType>(size);
+  }
+}
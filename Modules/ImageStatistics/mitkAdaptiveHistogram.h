@@ -0,0 +1,110 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#ifndef mitkAdaptiveHistogram_h
+#define mitkAdaptiveHistogram_h
+
+#include <MitkImageStatisticsExports.h>
+#include <itkHistogram.h>
+
+#include <cmath>
+#include <vector>
+
+namespace mitk
+{
+  /**
+   * @brief Histogram accumulator that adapts its value range to the values added so far.
+   *
+   * Allows to accumulate a histogram in the same pass in which the minimum and maximum of the
+   * values are determined. Values are counted in fine bins of the width 2^e that are anchored at zero.
+   * Only the occupied value range is stored, so the memory of an accumulator grows with the range of
+   * its values (a few KB for an 8 bit image) instead of being allocated for the maximum up front.
+   * If a value does not fit into the stored bins, the bins are extended and, if the range exceeds
+   * MaximumNumberOfBins fine bins, neighbouring bins are merged (the width is doubled) until all values fit. Since every
+   * accumulator uses the same bin grid, partial accumulators (e.g. of different threads) can be merged
+   * without loss.
+   *
+   * Once the value range is known, FillHistogram() rebins the fine bins into an initialized
+   * itk::Statistics::Histogram. Integer values are rebinned exactly, as long as the value range does
+   * not exceed MaximumNumberOfBins values (e.g. all 8 and 16 bit images). Otherwise a value that lies
+   * closer than one fine bin width to a border of the target bins may be assigned to the neighbouring bin.
+   */
+  class MITKIMAGESTATISTICS_EXPORT AdaptiveHistogram
+  {
+  public:
+    typedef double MeasurementType;
+    typedef itk::Statistics::Histogram<MeasurementType> HistogramType;
+    typedef itk::SizeValueType FrequencyType;
+
+    static constexpr unsigned int MaximumNumberOfBins = 1 << 16;
+
+    /**
+     * @param integerValues If true, the added values are integers and the fine bins are never
+     * narrower than 1.
+     */
+    explicit AdaptiveHistogram(bool integerValues = false);
+
+    /** Adds a value. Non finite values are ignored. */
+    inline void AddValue(MeasurementType value)
+    {
+      const MeasurementType bin = std::floor(value * m_Scale) - m_FirstBin;
+
+      if (bin >= 0 && bin < m_NumberOfBins)
+      {
+        ++m_Frequencies[static_cast<std::size_t>(bin)];
+      }
+      else
+      {
+        this->AddValueOutsideOfBins(value);
+      }
+    }
+
+    /** Adds the values of another accumulator. */
+    void Merge(const AdaptiveHistogram& other);
+
+    bool IsEmpty() const;
+
+    /** Returns the sum of all frequencies. */
+    FrequencyType GetTotalFrequency() const;
+
+    /** Returns the current width of the fine bins. */
+    MeasurementType GetBinWidth() const;
+
+    /**
+     * @brief Adds all frequencies to the passed histogram.
+     * The histogram has to be initialized with bounds that enclose all added values. Each fine bin is
+     * represented by its lower edge, clamped to [minimum, maximum].
+     */
+    void FillHistogram(HistogramType* histogram, MeasurementType minimum, MeasurementType maximum) const;
+
+  private:
+    void AddValueOutsideOfBins(MeasurementType value);
+
+    /** Determines the lower edges of the first and the last occupied fine bin. */
+    bool GetOccupiedRange(MeasurementType& low, MeasurementType& high) const;
+
+    /** Returns the smallest exponent (not smaller than the passed one) whose bins can hold the value range [low, high]. */
+    static int GetRequiredExponent(int exponent, MeasurementType low, MeasurementType high);
+
+    /** Moves all frequencies onto the bins of the given exponent, centered around the value range [low, high]. */
+    void Rebin(int exponent, MeasurementType low, MeasurementType high);
+
+    bool m_IntegerValues;
+    int m_Exponent;
+    MeasurementType m_Scale;
+    MeasurementType m_FirstBin;
+    MeasurementType m_NumberOfBins;
+    std::vector<FrequencyType> m_Frequencies;
+  };
+}
+
+#endif
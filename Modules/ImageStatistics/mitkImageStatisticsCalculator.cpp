@@ -20,11 +20,26 @@ found in the LICENSE file.
 #include <mitkImageTimeSelector.h>
 #include <mitkImageToItk.h>
 #include <mitkMaskUtilities.h>
-#include <mitkMinMaxImageFilterWithIndex.h>
-#include <mitkMinMaxLabelmageFilterWithIndex.h>
-#include <mitkitkMaskImageFilter.h>
 #include <mitkNodePredicateGeometry.h>
 
+#include <itkExtractImageFilter.h>
+
+#include <algorithm>
+#include <set>
+
+namespace
+{
+  template <typename TImage>
+  typename TImage::ConstPointer ExtractRegion(const TImage* image, const typename TImage::RegionType& region)
+  {
+    auto extractFilter = itk::ExtractImageFilter<TImage, TImage>::New();
+    extractFilter->SetInput(image);
+    extractFilter->SetExtractionRegion(region);
+    extractFilter->Update();
+    return extractFilter->GetOutput();
+  }
+}
+
 namespace mitk
 {
   void ImageStatisticsCalculator::SetInputImage(const mitk::Image *image)
@@ -91,6 +106,25 @@ namespace mitk
 
   double ImageStatisticsCalculator::GetBinSizeForHistogramStatistics() const { return m_binSizeForHistogramStatistics; }
 
+  void ImageStatisticsCalculator::SetPreviousStatistics(const ImageStatisticsContainer* previousStatistics, const ModifiedLabelsType& modifiedLabels)
+  {
+    m_PreviousStatistics = previousStatistics;
+    m_ModifiedLabels = modifiedLabels;
+    this->Modified();
+  }
+
+  const ImageStatisticsCalculator::ModifiedLabelMapType* ImageStatisticsCalculator::GetModifiedLabels(TimeStepType timeStep) const
+  {
+    if (m_PreviousStatistics.IsNull() || m_MaskGenerator.IsNull() || m_SecondaryMaskGenerator.IsNotNull())
+      return nullptr;
+
+    if (!m_PreviousStatistics->GetTimeGeometry()->IsValidTimeStep(timeStep))
+      return nullptr;
+
+    auto finding = m_ModifiedLabels.find(timeStep);
+    return m_ModifiedLabels.end() == finding ? nullptr : &(finding->second);
+  }
+
   mitk::ImageStatisticsContainer* ImageStatisticsCalculator::GetStatistics()
   {
     if (m_Image.IsNull())
@@ -127,8 +161,23 @@ namespace mitk
           m_SecondaryMask = m_SecondaryMaskGenerator->GetMask(0);
         }
 
+        // incremental update: statistics of labels that were not modified are taken over,
+        // the masks only have to be processed for the modified labels
+        m_CurrentModifiedLabels = this->GetModifiedLabels(timeStep);
+
+        if (nullptr != m_CurrentModifiedLabels)
+        {
+          for (auto labelValue : m_PreviousStatistics->GetExistingLabelValues())
+          {
+            if (0 == m_CurrentModifiedLabels->count(labelValue) && m_PreviousStatistics->StatisticsExist(labelValue, timeStep))
+              m_StatisticContainer->SetStatistics(labelValue, timeStep, m_PreviousStatistics->GetStatistics(labelValue, timeStep));
+          }
+        }
+
         for (unsigned int maskID = 0; maskID < numbersOfMasks; ++maskID)
         {
+          m_CurrentMaskID = maskID;
+
           if (m_MaskGenerator.IsNotNull())
           {
             m_MaskGenerator->SetTimePoint(timePoint);
@@ -162,6 +211,8 @@ namespace mitk
           }
         }
       }
+
+      m_CurrentModifiedLabels = nullptr;
     }
 
     return m_StatisticContainer;
@@ -173,59 +224,25 @@ namespace mitk
   {
     typedef typename itk::Image<TPixel, VImageDimension> ImageType;
     typedef typename mitk::StatisticsImageFilter<ImageType> ImageStatisticsFilterType;
-    typedef typename itk::MinMaxImageFilterWithIndex<ImageType> MinMaxFilterType;
 
     auto statObj = ImageStatisticsContainer::ImageStatisticsObject();
 
+    // moments, extrema and histogram are computed in a single pass; the histogram bounds are
+    // determined by the filter from the extrema it finds
     typename ImageStatisticsFilterType::Pointer statisticsFilter = ImageStatisticsFilterType::New();
     statisticsFilter->SetInput(image);
     statisticsFilter->SetCoordinateTolerance(NODE_PREDICATE_GEOMETRY_DEFAULT_CHECK_COORDINATE_PRECISION);
     statisticsFilter->SetDirectionTolerance(NODE_PREDICATE_GEOMETRY_DEFAULT_CHECK_DIRECTION_PRECISION);
 
-    // TODO: this is single threaded. Implement our own image filter that does this multi threaded
-    //        typename itk::MinimumMaximumImageCalculator<ImageType>::Pointer imgMinMaxFilter =
-    //        itk::MinimumMaximumImageCalculator<ImageType>::New(); imgMinMaxFilter->SetImage(image);
-    //        imgMinMaxFilter->Compute();
-    vnl_vector<int> minIndex, maxIndex;
-
-    typename MinMaxFilterType::Pointer minMaxFilter = MinMaxFilterType::New();
-    minMaxFilter->SetInput(image);
-    minMaxFilter->UpdateLargestPossibleRegion();
-    typename ImageType::PixelType minval = minMaxFilter->GetMin();
-    typename ImageType::PixelType maxval = minMaxFilter->GetMax();
-
-    typename ImageType::IndexType tmpMinIndex = minMaxFilter->GetMinIndex();
-    typename ImageType::IndexType tmpMaxIndex = minMaxFilter->GetMaxIndex();
-
-    //        typename ImageType::IndexType tmpMinIndex = imgMinMaxFilter->GetIndexOfMinimum();
-    //        typename ImageType::IndexType tmpMaxIndex = imgMinMaxFilter->GetIndexOfMaximum();
-
-    minIndex.set_size(tmpMaxIndex.GetIndexDimension());
-    maxIndex.set_size(tmpMaxIndex.GetIndexDimension());
-
-    for (unsigned int i = 0; i < tmpMaxIndex.GetIndexDimension(); i++)
-    {
-      minIndex[i] = tmpMinIndex[i];
-      maxIndex[i] = tmpMaxIndex[i];
-    }
-
-    statObj.AddStatistic(mitk::ImageStatisticsConstants::MINIMUMPOSITION(), minIndex);
-    statObj.AddStatistic(mitk::ImageStatisticsConstants::MAXIMUMPOSITION(), maxIndex);
-
-    // convert m_binSize in m_nBins if necessary
-    unsigned int nBinsForHistogram;
     if (m_UseBinSizeOverNBins)
     {
-      nBinsForHistogram = std::max(static_cast<double>(std::ceil(maxval - minval)) / m_binSizeForHistogramStatistics,
-                                   10.); // do not allow less than 10 bins
+      statisticsFilter->SetAdaptiveHistogramBinSize(m_binSizeForHistogramStatistics, 10); // do not allow less than 10 bins
     }
     else
     {
-      nBinsForHistogram = m_nBinsForHistogramStatistics;
+      statisticsFilter->SetAdaptiveHistogramParameters(m_nBinsForHistogramStatistics);
     }
 
-    statisticsFilter->SetHistogramParameters(nBinsForHistogram, minval, maxval);
-
     try
     {
       statisticsFilter->Update();
@@ -235,6 +252,23 @@ namespace mitk
       mitkThrow() << "Image statistics calculation failed due to following ITK Exception: \n " << e.what();
     }
 
+    vnl_vector<int> minIndex, maxIndex;
+
+    typename ImageType::IndexType tmpMinIndex = statisticsFilter->GetMinimumIndex();
+    typename ImageType::IndexType tmpMaxIndex = statisticsFilter->GetMaximumIndex();
+
+    minIndex.set_size(tmpMaxIndex.GetIndexDimension());
+    maxIndex.set_size(tmpMaxIndex.GetIndexDimension());
+
+    for (unsigned int i = 0; i < tmpMaxIndex.GetIndexDimension(); i++)
+    {
+      minIndex[i] = tmpMinIndex[i];
+      maxIndex[i] = tmpMaxIndex[i];
+    }
+
+    statObj.AddStatistic(mitk::ImageStatisticsConstants::MINIMUMPOSITION(), minIndex);
+    statObj.AddStatistic(mitk::ImageStatisticsConstants::MAXIMUMPOSITION(), maxIndex);
+
     auto voxelVolume = GetVoxelVolume<TPixel, VImageDimension>(image);
 
     auto numberOfPixels = image->GetLargestPossibleRegion().GetNumberOfPixels();
@@ -284,10 +318,43 @@ namespace mitk
   {
     typedef itk::Image<TPixel, VImageDimension> ImageType;
     typedef itk::Image<MaskPixelType, VImageDimension> MaskType;
-    typedef typename MaskType::PixelType LabelPixelType;
     typedef LabelStatisticsImageFilter<ImageType> ImageStatisticsFilterType;
     typedef MaskUtilities<TPixel, VImageDimension> MaskUtilType;
-    typedef typename itk::MinMaxLabelImageFilterWithIndex<ImageType, MaskType> MinMaxLabelFilterType;
+
+    // incremental update: only the modified labels of the current mask are computed, within the union of their regions
+    std::set<LabelIndex> modifiedLabels;
+    itk::ImageRegion<3> modifiedRegion;
+
+    if (nullptr != m_CurrentModifiedLabels)
+    {
+      for (const auto& modifiedLabel : *m_CurrentModifiedLabels)
+      {
+        const auto& region = modifiedLabel.second.region;
+
+        if (modifiedLabel.second.maskID != m_CurrentMaskID || 0 == region.GetNumberOfPixels())
+          continue;
+
+        if (modifiedLabels.empty())
+        {
+          modifiedRegion = region;
+        }
+        else
+        {
+          for (unsigned int i = 0; i < 3; ++i)
+          {
+            const auto lower = std::min(modifiedRegion.GetIndex(i), region.GetIndex(i));
+            const auto upper = std::max(modifiedRegion.GetUpperIndex()[i], region.GetUpperIndex()[i]);
+            modifiedRegion.SetIndex(i, lower);
+            modifiedRegion.SetSize(i, upper - lower + 1);
+          }
+        }
+
+        modifiedLabels.insert(modifiedLabel.first);
+      }
+
+      if (modifiedLabels.empty())
+        return;
+    }
 
     // workaround: if m_SecondaryMaskGenerator is not null but m_MaskGenerator is! (this is the case if we request a
     // 'ignore zero valued pixels' mask in the gui but do not define a primary mask)
@@ -315,7 +382,10 @@ namespace mitk
       maskImage = noneConstMaskImage;
     }
 
-    // if we have a secondary mask (say a ignoreZeroPixelMask) we need to combine the masks (corresponds to AND)
+    // if we have a secondary mask (say a ignoreZeroPixelMask) it is combined with the mask (corresponds to AND)
+    // by the statistics filter while it computes the statistics
+    typename MaskType::ConstPointer adaptedSecondaryMaskImage;
+
     if (m_SecondaryMask.IsNotNull())
     {
       // dirty workaround for a bug when pf mask + any other mask is used in conjunction. We need a proper fix for this
@@ -337,16 +407,7 @@ namespace mitk
         MaskUtilities<MaskPixelType, VImageDimension>::New();
       secondaryMaskMaskUtil->SetImage(secondaryMaskImage.GetPointer());
       secondaryMaskMaskUtil->SetMask(maskImage.GetPointer());
-      typename MaskType::ConstPointer adaptedSecondaryMaskImage = secondaryMaskMaskUtil->ExtractMaskImageRegion();
-
-      typename itk::MaskImageFilter2<MaskType, MaskType, MaskType>::Pointer maskFilter =
-        itk::MaskImageFilter2<MaskType, MaskType, MaskType>::New();
-      maskFilter->SetInput1(maskImage);
-      maskFilter->SetInput2(adaptedSecondaryMaskImage);
-      maskFilter->SetMaskingValue(
-        1); // all pixels of maskImage where secondaryMaskImage==1 will be kept, all the others are set to 0
-      maskFilter->UpdateLargestPossibleRegion();
-      maskImage = maskFilter->GetOutput();
+      adaptedSecondaryMaskImage = secondaryMaskMaskUtil->ExtractMaskImageRegion();
     }
 
     typename MaskUtilType::Pointer maskUtil = MaskUtilType::New();
@@ -358,49 +419,47 @@ namespace mitk
 
     adaptedImage = maskUtil->ExtractMaskImageRegion(); // this also checks mask sanity
 
-    // find min, max, minindex and maxindex
-    typename MinMaxLabelFilterType::Pointer minMaxFilter = MinMaxLabelFilterType::New();
-    minMaxFilter->SetInput(adaptedImage);
-    minMaxFilter->SetLabelInput(maskImage);
-    minMaxFilter->SetCoordinateTolerance(NODE_PREDICATE_GEOMETRY_DEFAULT_CHECK_COORDINATE_PRECISION);
-    minMaxFilter->SetDirectionTolerance(NODE_PREDICATE_GEOMETRY_DEFAULT_CHECK_DIRECTION_PRECISION);
-    minMaxFilter->UpdateLargestPossibleRegion();
+    typename MaskType::ConstPointer labelImage = maskImage;
 
-    // set histogram parameters for each label individually (min/max may be different for each label)
-    typedef typename std::unordered_map<LabelPixelType, ScalarType> MapType;
-
-    std::vector<LabelPixelType> relevantLabels = minMaxFilter->GetRelevantLabels();
-    MapType minVals;
-    MapType maxVals;
-    std::unordered_map<LabelPixelType, unsigned int> nBins;
-
-    for (LabelPixelType label : relevantLabels)
+    if (!modifiedLabels.empty() && 3 == VImageDimension)
     {
-      minVals[label] = static_cast<ScalarType>(minMaxFilter->GetMin(label));
-      maxVals[label] = static_cast<ScalarType>(minMaxFilter->GetMax(label));
-
-      unsigned int nBinsForHistogram;
-      if (m_UseBinSizeOverNBins)
+      typename ImageType::RegionType region;
+      for (unsigned int i = 0; i < VImageDimension; ++i)
       {
-        nBinsForHistogram =
-          std::max(static_cast<double>(std::ceil(minMaxFilter->GetMax(label) - minMaxFilter->GetMin(label))) /
-                     m_binSizeForHistogramStatistics,
-                   10.); // do not allow less than 10 bins
+        region.SetIndex(i, modifiedRegion.GetIndex(i));
+        region.SetSize(i, modifiedRegion.GetSize(i));
       }
-      else
+
+      // otherwise the whole mask is processed, but still only the modified labels are stored
+      if (maskImage->GetBufferedRegion().IsInside(region) && adaptedImage->GetBufferedRegion().IsInside(region))
       {
-        nBinsForHistogram = m_nBinsForHistogramStatistics;
+        adaptedImage = ExtractRegion(adaptedImage.GetPointer(), region);
+        labelImage = ExtractRegion(maskImage.GetPointer(), region);
       }
-
-      nBins[label] = nBinsForHistogram;
     }
 
+    // moments, extrema (with their indices) and histograms of all labels are computed in a single pass;
+    // the histogram bounds of each label are determined by the filter from the extrema of the label
     typename ImageStatisticsFilterType::Pointer imageStatisticsFilter = ImageStatisticsFilterType::New();
     imageStatisticsFilter->SetCoordinateTolerance(NODE_PREDICATE_GEOMETRY_DEFAULT_CHECK_COORDINATE_PRECISION);
     imageStatisticsFilter->SetDirectionTolerance(NODE_PREDICATE_GEOMETRY_DEFAULT_CHECK_DIRECTION_PRECISION);
     imageStatisticsFilter->SetInput(adaptedImage);
-    imageStatisticsFilter->SetLabelInput(maskImage);
-    imageStatisticsFilter->SetHistogramParameters(nBins, minVals, maxVals);
+    imageStatisticsFilter->SetLabelInput(labelImage);
+
+    if (adaptedSecondaryMaskImage.IsNotNull())
+    {
+      imageStatisticsFilter->SetSecondaryMaskInput(adaptedSecondaryMaskImage);
+    }
+
+    if (m_UseBinSizeOverNBins)
+    {
+      imageStatisticsFilter->SetAdaptiveHistogramBinSize(m_binSizeForHistogramStatistics, 10); // do not allow less than 10 bins
+    }
+    else
+    {
+      imageStatisticsFilter->SetAdaptiveHistogramParameters(m_nBinsForHistogramStatistics);
+    }
+
     imageStatisticsFilter->Update();
 
     const auto labels = imageStatisticsFilter->GetValidLabelValues();
@@ -413,6 +472,12 @@ namespace mitk
         continue;
       }
 
+      if (!modifiedLabels.empty() && 0 == modifiedLabels.count(labelValue))
+      {
+        //statistics of labels that were not modified were taken over (and may not be complete in the processed region).
+        continue;
+      }
+
       ImageStatisticsContainer::ImageStatisticsObject statObj;
 
       // find min, max, minindex and maxindex
@@ -423,8 +488,8 @@ namespace mitk
       Point3D worldCoordinateMax;
       Point3D indexCoordinateMin;
       Point3D indexCoordinateMax;
-      m_InternalImageForStatistics->GetGeometry()->IndexToWorld(minMaxFilter->GetMinIndex(labelValue), worldCoordinateMin);
-      m_InternalImageForStatistics->GetGeometry()->IndexToWorld(minMaxFilter->GetMaxIndex(labelValue), worldCoordinateMax);
+      m_InternalImageForStatistics->GetGeometry()->IndexToWorld(imageStatisticsFilter->GetMinimumIndex(labelValue), worldCoordinateMin);
+      m_InternalImageForStatistics->GetGeometry()->IndexToWorld(imageStatisticsFilter->GetMaximumIndex(labelValue), worldCoordinateMax);
       m_Image->GetGeometry()->WorldToIndex(worldCoordinateMin, indexCoordinateMin);
       m_Image->GetGeometry()->WorldToIndex(worldCoordinateMax, indexCoordinateMax);
 
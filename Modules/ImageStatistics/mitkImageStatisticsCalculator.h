@@ -18,6 +18,10 @@ found in the LICENSE file.
 #include <mitkMaskGenerator.h>
 #include <mitkImageStatisticsContainer.h>
 
+#include <itkImageRegion.h>
+
+#include <map>
+
 namespace mitk
 {
     class MITKIMAGESTATISTICS_EXPORT ImageStatisticsCalculator: public itk::Object
@@ -39,6 +43,15 @@ namespace mitk
         typedef unsigned short MaskPixelType;
         using LabelIndex = ImageStatisticsContainer::LabelValueType;
 
+        /** Mask that contains a modified label and the index region (in the mask) that contains all voxels of the label.*/
+        struct ModifiedLabel
+        {
+          unsigned int maskID = 0;
+          itk::ImageRegion<3> region;
+        };
+        using ModifiedLabelMapType = std::map<LabelIndex, ModifiedLabel>;
+        using ModifiedLabelsType = std::map<TimeStepType, ModifiedLabelMapType>;
+
         /**Documentation
         @brief Set the image for which the statistics are to be computed.*/
         void SetInputImage(const mitk::Image* image);
@@ -70,6 +83,15 @@ namespace mitk
         That solely depends on which parameter has been set last.*/
         double GetBinSizeForHistogramStatistics() const;
 
+        /**Documentation
+        @brief Allows to update the statistics of a mask generator with several label masks (e.g. MultiLabelMaskGenerator) incrementally.
+        The statistics of all labels that are not listed in modifiedLabels for their time step are taken over from previousStatistics.
+        The listed labels are recomputed within their region only; listed labels with an empty region have no voxels anymore.
+        previousStatistics must have been computed for the same image, mask and histogram settings. The incremental update is not
+        used without mask generator, with a secondary mask or for time steps without entry in modifiedLabels.
+        Pass nullptr to compute all statistics from scratch.*/
+        void SetPreviousStatistics(const ImageStatisticsContainer* previousStatistics, const ModifiedLabelsType& modifiedLabels = ModifiedLabelsType());
+
         /**Documentation
         @brief Returns the statistics. If these requested statistics are not computed yet the computation is done as well.
          */
@@ -96,6 +118,9 @@ namespace mitk
 
         bool IsUpdateRequired() const;
 
+        /** Returns the modified labels of the time step if the statistics of the time step can be updated incrementally.*/
+        const ModifiedLabelMapType* GetModifiedLabels(TimeStepType timeStep) const;
+
         mitk::Image::ConstPointer m_Image;
         mitk::Image::ConstPointer m_ImageTimeSlice;
         mitk::Image::ConstPointer m_InternalImageForStatistics;
@@ -111,6 +136,11 @@ namespace mitk
         bool m_UseBinSizeOverNBins;
 
         ImageStatisticsContainer::Pointer m_StatisticContainer;
+
+        ImageStatisticsContainer::ConstPointer m_PreviousStatistics;
+        ModifiedLabelsType m_ModifiedLabels;
+        const ModifiedLabelMapType* m_CurrentModifiedLabels = nullptr;
+        unsigned int m_CurrentMaskID = 0;
     };
 
 }
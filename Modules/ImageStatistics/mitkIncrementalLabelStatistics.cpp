@@ -0,0 +1,488 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include <mitkIncrementalLabelStatistics.h>
+
+#include <mitkImageAccessByItk.h>
+#include <mitkImagePixelReadAccessor.h>
+#include <mitkImageTimeSelector.h>
+#include <mitkMultiLabelGroupIndex.h>
+
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+  template <typename TPixel, unsigned int VImageDimension>
+  void CreateReferenceAccessor(const itk::Image<TPixel, VImageDimension>* image,
+    std::function<double(std::size_t)>& accessor, double& minimum, double& maximum)
+  {
+    typename itk::Image<TPixel, VImageDimension>::ConstPointer keepAlive = image;
+    const TPixel* buffer = image->GetBufferPointer();
+    const auto numberOfPixels = image->GetBufferedRegion().GetNumberOfPixels();
+
+    minimum = 0.0;
+    maximum = 0.0;
+
+    if (numberOfPixels > 0)
+    {
+      const auto minmax = std::minmax_element(buffer, buffer + numberOfPixels);
+      minimum = static_cast<double>(*minmax.first);
+      maximum = static_cast<double>(*minmax.second);
+    }
+
+    accessor = [keepAlive, buffer](std::size_t offset) { return static_cast<double>(buffer[offset]); };
+  }
+
+  itk::ModifiedTimeType NewTimeStamp()
+  {
+    itk::TimeStamp timeStamp;
+    timeStamp.Modified();
+    return timeStamp.GetMTime();
+  }
+}
+
+mitk::IncrementalLabelStatistics::IncrementalLabelStatistics()
+  : m_NumberOfHistogramBins(100), m_Dimensions({ { 1, 1, 1 } }), m_ReferenceMTime(0), m_ComputeTime(0)
+{
+}
+
+mitk::IncrementalLabelStatistics::~IncrementalLabelStatistics()
+{
+}
+
+void mitk::IncrementalLabelStatistics::SetSegmentation(const MultiLabelSegmentation* segmentation)
+{
+  if (m_Segmentation == segmentation)
+    return;
+
+  m_SliceModifiedObserver.Reset();
+  m_GroupAddedObserver.Reset();
+  m_GroupRemovedObserver.Reset();
+
+  m_Segmentation = segmentation;
+  this->Invalidate();
+
+  if (nullptr != segmentation)
+  {
+    m_SliceModifiedObserver.Reset(segmentation, GroupSliceModifiedEvent(), [this](const itk::EventObject& event) { this->OnGroupSliceModified(event); });
+    m_GroupAddedObserver.Reset(segmentation, GroupAddedEvent(), [this](const itk::EventObject&) { this->Invalidate(); });
+    m_GroupRemovedObserver.Reset(segmentation, GroupRemovedEvent(), [this](const itk::EventObject&) { this->Invalidate(); });
+  }
+
+  this->Modified();
+}
+
+void mitk::IncrementalLabelStatistics::SetReferenceImage(const Image* referenceImage)
+{
+  if (m_ReferenceImage == referenceImage)
+    return;
+
+  m_ReferenceImage = referenceImage;
+  this->Invalidate();
+  this->Modified();
+}
+
+void mitk::IncrementalLabelStatistics::SetNumberOfHistogramBins(unsigned int numberOfBins)
+{
+  if (0 == numberOfBins)
+    mitkThrow() << "Cannot set number of histogram bins. At least one bin is needed.";
+
+  if (m_NumberOfHistogramBins == numberOfBins)
+    return;
+
+  m_NumberOfHistogramBins = numberOfBins;
+  this->Invalidate();
+  this->Modified();
+}
+
+void mitk::IncrementalLabelStatistics::Invalidate()
+{
+  m_Statistics.clear();
+  m_ReferenceTimeSteps.clear();
+  m_GroupMTimes.clear();
+  m_GroupWriteAccessTimes.clear();
+  m_ComputeTime = NewTimeStamp();
+}
+
+void mitk::IncrementalLabelStatistics::Update()
+{
+  if (m_Segmentation.IsNull())
+    mitkThrow() << "Cannot update incremental label statistics. Segmentation is not set.";
+
+  if (m_ReferenceImage.IsNotNull() && m_ReferenceImage->GetMTime() != m_ReferenceMTime)
+    this->Invalidate();
+
+  if (m_GroupMTimes.empty())
+    this->InitializeReference();
+
+  const auto numberOfGroups = m_Segmentation->GetNumberOfGroups();
+  m_GroupMTimes.resize(numberOfGroups, 0);
+  m_GroupWriteAccessTimes.resize(numberOfGroups, 0);
+
+  bool modified = false;
+
+  for (GroupIndexType groupID = 0; groupID < numberOfGroups; ++groupID)
+  {
+    auto groupImage = m_Segmentation->GetGroupImage(groupID);
+
+    if (m_GroupMTimes[groupID] != groupImage->GetMTime() || m_GroupWriteAccessTimes[groupID] != groupImage->GetLastWriteAccessTime())
+    {
+      this->ComputeGroup(groupID);
+      modified = true;
+    }
+  }
+
+  if (modified)
+    this->Modified();
+}
+
+void mitk::IncrementalLabelStatistics::InitializeReference()
+{
+  m_ReferenceTimeSteps.clear();
+
+  const auto& dimensions = m_Segmentation->GetDimensions();
+  for (std::size_t i = 0; i < 3; ++i)
+    m_Dimensions[i] = i < dimensions.size() ? dimensions[i] : 1;
+
+  if (m_ReferenceImage.IsNull())
+    return;
+
+  const auto segmentationTimeGeometry = m_Segmentation->GetTimeGeometry();
+  const auto referenceTimeGeometry = m_ReferenceImage->GetTimeGeometry();
+
+  for (TimeStepType timeStep = 0; timeStep < m_Segmentation->GetTimeSteps(); ++timeStep)
+  {
+    const auto timePoint = segmentationTimeGeometry->TimeStepToTimePoint(timeStep);
+
+    if (!referenceTimeGeometry->IsValidTimePoint(timePoint))
+      mitkThrow() << "Cannot update incremental label statistics. Reference image does not cover time step " << timeStep << " of the segmentation.";
+
+    ReferenceTimeStep reference;
+    reference.image = SelectImageByTimeStep(m_ReferenceImage, referenceTimeGeometry->TimePointToTimeStep(timePoint));
+
+    for (unsigned int i = 0; i < 3; ++i)
+    {
+      if (reference.image->GetDimension(i) != m_Dimensions[i])
+        mitkThrow() << "Cannot update incremental label statistics. Reference image and segmentation have different dimensions.";
+    }
+
+    double minimum = 0.0;
+    double maximum = 0.0;
+    AccessByItk_n(reference.image.GetPointer(), CreateReferenceAccessor, (reference.accessor, minimum, maximum));
+
+    reference.minimum = minimum;
+    reference.binWidth = (maximum - minimum) / m_NumberOfHistogramBins;
+
+    if (!(reference.binWidth > 0.0))
+      reference.binWidth = 1.0;
+
+    m_ReferenceTimeSteps.push_back(reference);
+  }
+
+  m_ReferenceMTime = m_ReferenceImage->GetMTime();
+}
+
+void mitk::IncrementalLabelStatistics::ComputeGroup(GroupIndexType groupID)
+{
+  for (auto iter = m_Statistics.begin(); iter != m_Statistics.end();)
+  {
+    if (iter->second.group == groupID)
+    {
+      iter = m_Statistics.erase(iter);
+    }
+    else
+    {
+      ++iter;
+    }
+  }
+
+  auto groupImage = m_Segmentation->GetGroupImage(groupID);
+  const auto computeTime = NewTimeStamp();
+
+  for (TimeStepType timeStep = 0; timeStep < groupImage->GetTimeSteps(); ++timeStep)
+  {
+    auto volume = SelectImageByTimeStep(groupImage, timeStep);
+    ImagePixelReadAccessor<LabelValueType, 3> accessor(volume);
+    const auto* labels = accessor.GetData();
+
+    auto lastLabel = MultiLabelSegmentation::UNLABELED_VALUE;
+    LabelStatistics* statistics = nullptr;
+
+    itk::Index<3> index;
+    std::size_t offset = 0;
+
+    for (index[2] = 0; index[2] < static_cast<itk::IndexValueType>(m_Dimensions[2]); ++index[2])
+    {
+      for (index[1] = 0; index[1] < static_cast<itk::IndexValueType>(m_Dimensions[1]); ++index[1])
+      {
+        for (index[0] = 0; index[0] < static_cast<itk::IndexValueType>(m_Dimensions[0]); ++index[0], ++offset)
+        {
+          const auto label = labels[offset];
+
+          if (MultiLabelSegmentation::UNLABELED_VALUE == label)
+            continue;
+
+          if (label != lastLabel || nullptr == statistics)
+          {
+            statistics = &(this->GetOrCreateStatistics(label, timeStep));
+            statistics->group = groupID;
+            statistics->mtime = computeTime;
+            lastLabel = label;
+          }
+
+          this->ChangeVoxel(*statistics, timeStep, index, offset, 1);
+        }
+      }
+    }
+  }
+
+  m_GroupMTimes[groupID] = groupImage->GetMTime();
+  m_GroupWriteAccessTimes[groupID] = groupImage->GetLastWriteAccessTime();
+  m_ComputeTime = computeTime;
+}
+
+void mitk::IncrementalLabelStatistics::UpdateSlice(GroupIndexType groupID, TimeStepType timeStep, const Image* originalSlice, itk::ModifiedTimeType originalMTime)
+{
+  if (m_Segmentation.IsNull() || nullptr == originalSlice)
+    mitkThrow() << "Cannot update incremental label statistics. Segmentation or original slice is not set.";
+
+  // statistics of the group were not computed or already outdated before the slice was written; Update() will recompute them.
+  if (groupID >= m_GroupMTimes.size() || 0 == m_GroupMTimes[groupID] || m_GroupMTimes[groupID] != originalMTime)
+    return;
+
+  auto groupImage = m_Segmentation->GetGroupImage(groupID);
+
+  // group image was written through an image accessor without announcement since the last synchronization
+  if (m_GroupWriteAccessTimes[groupID] != groupImage->GetLastWriteAccessTime())
+    return;
+
+  if (originalSlice->GetPixelType() != MultiLabelSegmentation::GetPixelType())
+  {
+    MITK_WARN << "Original slice has an unexpected pixel type. Statistics of group " << groupID << " will be recomputed.";
+    m_GroupMTimes[groupID] = 0;
+    return;
+  }
+
+  bool modified = false;
+  const auto modificationTime = NewTimeStamp();
+
+  MultiLabelGroupIndex::VisitModifiedVoxels(groupImage, timeStep, originalSlice,
+    [this, groupID, timeStep, modificationTime, &modified](std::size_t offset, const itk::Index<3>& index, LabelValueType originalLabel, LabelValueType currentLabel)
+  {
+    if (MultiLabelSegmentation::UNLABELED_VALUE != originalLabel)
+    {
+      auto& statistics = this->GetOrCreateStatistics(originalLabel, timeStep);
+      statistics.mtime = modificationTime;
+      this->ChangeVoxel(statistics, timeStep, index, offset, -1);
+    }
+
+    if (MultiLabelSegmentation::UNLABELED_VALUE != currentLabel)
+    {
+      auto& statistics = this->GetOrCreateStatistics(currentLabel, timeStep);
+      statistics.group = groupID;
+      statistics.mtime = modificationTime;
+      this->ChangeVoxel(statistics, timeStep, index, offset, 1);
+    }
+
+    modified = true;
+  });
+
+  m_GroupMTimes[groupID] = groupImage->GetMTime();
+
+  if (modified)
+    this->Modified();
+}
+
+void mitk::IncrementalLabelStatistics::OnGroupSliceModified(const itk::EventObject& event)
+{
+  auto sliceEvent = dynamic_cast<const GroupSliceModifiedEvent*>(&event);
+
+  if (nullptr == sliceEvent)
+    return;
+
+  if (nullptr == sliceEvent->GetOriginalSlice())
+  {
+    if (sliceEvent->GetGroupID() < m_GroupMTimes.size())
+      m_GroupMTimes[sliceEvent->GetGroupID()] = 0;
+
+    return;
+  }
+
+  this->UpdateSlice(sliceEvent->GetGroupID(), sliceEvent->GetTimeStep(), sliceEvent->GetOriginalSlice(), sliceEvent->GetOriginalMTime());
+}
+
+mitk::IncrementalLabelStatistics::LabelStatistics& mitk::IncrementalLabelStatistics::GetOrCreateStatistics(LabelValueType label, TimeStepType timeStep)
+{
+  auto result = m_Statistics.emplace(StatisticsKeyType(label, timeStep), LabelStatistics());
+  auto& statistics = result.first->second;
+
+  if (result.second)
+  {
+    for (std::size_t i = 0; i < 3; ++i)
+      statistics.axisCounts[i].assign(m_Dimensions[i], 0);
+
+    if (!m_ReferenceTimeSteps.empty())
+      statistics.histogram.assign(m_NumberOfHistogramBins, 0);
+  }
+
+  return statistics;
+}
+
+const mitk::IncrementalLabelStatistics::LabelStatistics* mitk::IncrementalLabelStatistics::FindStatistics(LabelValueType label, TimeStepType timeStep) const
+{
+  auto finding = m_Statistics.find(StatisticsKeyType(label, timeStep));
+  return m_Statistics.end() == finding ? nullptr : &(finding->second);
+}
+
+void mitk::IncrementalLabelStatistics::ChangeVoxel(LabelStatistics& statistics, TimeStepType timeStep, const itk::Index<3>& index, std::size_t offset, int weight) const
+{
+  const auto change = [weight](std::size_t& count) { weight > 0 ? ++count : --count; };
+
+  change(statistics.count);
+
+  for (std::size_t i = 0; i < 3; ++i)
+    change(statistics.axisCounts[i][index[i]]);
+
+  if (timeStep < m_ReferenceTimeSteps.size())
+  {
+    const auto& reference = m_ReferenceTimeSteps[timeStep];
+    const auto value = reference.accessor(offset);
+
+    statistics.sum += weight * value;
+    statistics.sumOfSquares += weight * value * value;
+
+    const auto bin = std::min(std::max(std::floor((value - reference.minimum) / reference.binWidth), 0.0), m_NumberOfHistogramBins - 1.0);
+    change(statistics.histogram[static_cast<std::size_t>(bin)]);
+  }
+}
+
+std::vector<mitk::IncrementalLabelStatistics::LabelValueType> mitk::IncrementalLabelStatistics::GetLabelValues(TimeStepType timeStep) const
+{
+  std::vector<LabelValueType> result;
+
+  for (const auto& statistics : m_Statistics)
+  {
+    if (statistics.first.second == timeStep)
+      result.push_back(statistics.first.first);
+  }
+
+  return result;
+}
+
+mitk::IncrementalLabelStatistics::GroupIndexType mitk::IncrementalLabelStatistics::GetGroupIndex(LabelValueType label, TimeStepType timeStep) const
+{
+  auto statistics = this->FindStatistics(label, timeStep);
+  return nullptr == statistics ? 0 : statistics->group;
+}
+
+itk::ModifiedTimeType mitk::IncrementalLabelStatistics::GetLabelMTime(LabelValueType label, TimeStepType timeStep) const
+{
+  auto statistics = this->FindStatistics(label, timeStep);
+  return nullptr == statistics ? m_ComputeTime : statistics->mtime;
+}
+
+std::size_t mitk::IncrementalLabelStatistics::GetVoxelCount(LabelValueType label, TimeStepType timeStep) const
+{
+  auto statistics = this->FindStatistics(label, timeStep);
+  return nullptr == statistics ? 0 : statistics->count;
+}
+
+double mitk::IncrementalLabelStatistics::GetVolume(LabelValueType label, TimeStepType timeStep) const
+{
+  if (m_Segmentation.IsNull())
+    return 0.0;
+
+  const auto spacing = m_Segmentation->GetGeometry(timeStep)->GetSpacing();
+  return this->GetVoxelCount(label, timeStep) * spacing[0] * spacing[1] * spacing[2];
+}
+
+double mitk::IncrementalLabelStatistics::GetMean(LabelValueType label, TimeStepType timeStep) const
+{
+  auto statistics = this->FindStatistics(label, timeStep);
+
+  if (nullptr == statistics || 0 == statistics->count)
+    return 0.0;
+
+  return statistics->sum / statistics->count;
+}
+
+double mitk::IncrementalLabelStatistics::GetVariance(LabelValueType label, TimeStepType timeStep) const
+{
+  auto statistics = this->FindStatistics(label, timeStep);
+
+  if (nullptr == statistics || statistics->count < 2)
+    return 0.0;
+
+  const double count = static_cast<double>(statistics->count);
+  const double variance = (statistics->sumOfSquares - statistics->sum * statistics->sum / count) / (count - 1.0);
+
+  // removing voxels may leave a tiny negative rounding error
+  return std::max(variance, 0.0);
+}
+
+double mitk::IncrementalLabelStatistics::GetStandardDeviation(LabelValueType label, TimeStepType timeStep) const
+{
+  return std::sqrt(this->GetVariance(label, timeStep));
+}
+
+mitk::IncrementalLabelStatistics::RegionType mitk::IncrementalLabelStatistics::GetBoundingBox(LabelValueType label, TimeStepType timeStep) const
+{
+  RegionType region;
+  auto statistics = this->FindStatistics(label, timeStep);
+
+  if (nullptr == statistics || 0 == statistics->count)
+    return region;
+
+  for (std::size_t i = 0; i < 3; ++i)
+  {
+    const auto& counts = statistics->axisCounts[i];
+    const auto isOccupied = [](std::size_t count) { return 0 != count; };
+
+    const auto first = std::distance(counts.begin(), std::find_if(counts.begin(), counts.end(), isOccupied));
+    const auto last = std::distance(std::find_if(counts.rbegin(), counts.rend(), isOccupied), counts.rend()) - 1;
+
+    region.SetIndex(i, first);
+    region.SetSize(i, last - first + 1);
+  }
+
+  return region;
+}
+
+mitk::IncrementalLabelStatistics::HistogramType::Pointer mitk::IncrementalLabelStatistics::GetHistogram(LabelValueType label, TimeStepType timeStep) const
+{
+  if (timeStep >= m_ReferenceTimeSteps.size())
+    return nullptr;
+
+  const auto& reference = m_ReferenceTimeSteps[timeStep];
+
+  HistogramType::SizeType size(1);
+  size[0] = m_NumberOfHistogramBins;
+  HistogramType::MeasurementVectorType lowerBound(1);
+  lowerBound[0] = reference.minimum;
+  HistogramType::MeasurementVectorType upperBound(1);
+  upperBound[0] = reference.minimum + reference.binWidth * m_NumberOfHistogramBins;
+
+  auto histogram = HistogramType::New();
+  histogram->SetMeasurementVectorSize(1);
+  histogram->Initialize(size, lowerBound, upperBound);
+
+  auto statistics = this->FindStatistics(label, timeStep);
+
+  if (nullptr != statistics)
+  {
+    for (unsigned int bin = 0; bin < m_NumberOfHistogramBins; ++bin)
+      histogram->SetFrequency(bin, statistics->histogram[bin]);
+  }
+
+  return histogram;
+}
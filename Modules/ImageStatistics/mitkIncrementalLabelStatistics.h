@@ -0,0 +1,183 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#ifndef mitkIncrementalLabelStatistics_h
+#define mitkIncrementalLabelStatistics_h
+
+#include <MitkImageStatisticsExports.h>
+#include <mitkLabelSetImage.h>
+#include <mitkITKEventObserverGuard.h>
+
+#include <itkHistogram.h>
+#include <itkImageRegion.h>
+
+#include <array>
+#include <functional>
+#include <map>
+
+namespace mitk
+{
+  /**
+   * @brief Keeps per label statistics of a multi label segmentation up to date while it is edited.
+   *
+   * For every label value and time step the class keeps the number of voxels, the bounding box and,
+   * if a reference image is set, the sum and the sum of squares of the reference intensities as well
+   * as a histogram of them. Instead of reprocessing the segmentation after each modification, the
+   * statistics are updated from the slice modifications announced by GroupSliceModifiedEvent
+   * (sent by the slice based segmentation tools and by undo/redo of slice operations). Only the
+   * voxels of the modified slice are visited, so volume, mean, standard deviation and bounding
+   * box stay available during editing without a pass over the whole image.
+   *
+   * The statistics of a group are computed from scratch by Update() if they were never computed
+   * or if the group image was modified by other means than announced slice changes (detected by
+   * the modification time of the group image and the time of its last released write accessor).
+   * Adding or removing groups and changing the reference image invalidate all statistics. The
+   * unlabeled value is not tracked.
+   *
+   * GetLabelMTime() tells when the voxels of a label changed last. Consumers that keep results
+   * per label (e.g. QmitkImageStatisticsDataGenerator) use it to recompute only the labels that
+   * changed since their last result, restricted to the bounding boxes of these labels.
+   *
+   * The histogram of each time step uses the given number of bins evenly spread over the intensity
+   * range of the reference image at that time step.
+   */
+  class MITKIMAGESTATISTICS_EXPORT IncrementalLabelStatistics : public itk::Object
+  {
+  public:
+    mitkClassMacroItkParent(IncrementalLabelStatistics, itk::Object);
+    itkFactorylessNewMacro(Self);
+
+    using LabelValueType = MultiLabelSegmentation::LabelValueType;
+    using GroupIndexType = MultiLabelSegmentation::GroupIndexType;
+    using RegionType = itk::ImageRegion<3>;
+    using HistogramType = itk::Statistics::Histogram<double>;
+
+    /** Sets the segmentation whose labels are tracked. The class observes the segmentation
+     * for slice modifications as long as it is set.*/
+    void SetSegmentation(const MultiLabelSegmentation* segmentation);
+    itkGetConstObjectMacro(Segmentation, MultiLabelSegmentation);
+
+    /** Sets the optional image whose intensities are summarized per label. It must have the
+     * same spatial dimensions as the segmentation.*/
+    void SetReferenceImage(const Image* referenceImage);
+    itkGetConstObjectMacro(ReferenceImage, Image);
+
+    /** Number of histogram bins (default 100). Changing it invalidates all statistics.*/
+    void SetNumberOfHistogramBins(unsigned int numberOfBins);
+    itkGetConstMacro(NumberOfHistogramBins, unsigned int);
+
+    /** Computes the statistics of all groups that are not valid anymore.*/
+    void Update();
+
+    /** Applies a slice modification of a group image. The modified slice must already be written into
+     * the group image; the changed voxels are determined by comparing the passed original slice with
+     * the group image. The modification is only applied if the statistics of the group were up to date
+     * with the passed original modification time of the group image; otherwise the group is recomputed by
+     * the next Update(). Is called automatically for every GroupSliceModifiedEvent of the segmentation.*/
+    void UpdateSlice(GroupIndexType groupID, TimeStepType timeStep, const Image* originalSlice, itk::ModifiedTimeType originalMTime);
+
+    /** Returns the labels that have statistics at the time step. This includes labels whose voxels were
+     * all removed by slice modifications since the statistics of their group were computed.*/
+    std::vector<LabelValueType> GetLabelValues(TimeStepType timeStep = 0) const;
+
+    /** Returns the index of the group containing the label (0 for labels not returned by GetLabelValues()).*/
+    GroupIndexType GetGroupIndex(LabelValueType label, TimeStepType timeStep = 0) const;
+
+    /** Returns the time stamp (comparable with itk::Object::GetMTime()) of the last change of the voxels of the
+     * label at the time step. Labels without statistics return the time of the last (re)computation or
+     * invalidation, so labels that vanished with a recomputation are reported as changed as well.*/
+    itk::ModifiedTimeType GetLabelMTime(LabelValueType label, TimeStepType timeStep = 0) const;
+
+    /** Returns the number of voxels of the label at the time step.*/
+    std::size_t GetVoxelCount(LabelValueType label, TimeStepType timeStep = 0) const;
+
+    /** Returns the volume of the label at the time step in mm^3.*/
+    double GetVolume(LabelValueType label, TimeStepType timeStep = 0) const;
+
+    /** Returns the mean reference intensity of the label at the time step (0 if there is no reference image or voxel).*/
+    double GetMean(LabelValueType label, TimeStepType timeStep = 0) const;
+
+    /** Returns the (unbiased) variance of the reference intensities of the label at the time step.*/
+    double GetVariance(LabelValueType label, TimeStepType timeStep = 0) const;
+    double GetStandardDeviation(LabelValueType label, TimeStepType timeStep = 0) const;
+
+    /** Returns the index bounding box of the label at the time step. The region is empty if the label has no voxel.*/
+    RegionType GetBoundingBox(LabelValueType label, TimeStepType timeStep = 0) const;
+
+    /** Returns the histogram of the reference intensities of the label at the time step or nullptr if no
+     * reference image is set.*/
+    HistogramType::Pointer GetHistogram(LabelValueType label, TimeStepType timeStep = 0) const;
+
+  protected:
+    IncrementalLabelStatistics();
+    ~IncrementalLabelStatistics() override;
+
+    using ReferenceAccessorType = std::function<double(std::size_t)>;
+
+    struct LabelStatistics
+    {
+      /** Group whose image contains the label.*/
+      GroupIndexType group = 0;
+      /** Time stamp of the last change of the voxels of the label.*/
+      itk::ModifiedTimeType mtime = 0;
+      std::size_t count = 0;
+      double sum = 0.0;
+      double sumOfSquares = 0.0;
+      /** Number of voxels per index coordinate of each axis. Allows to shrink the bounding box exactly.*/
+      std::array<std::vector<std::size_t>, 3> axisCounts;
+      std::vector<std::size_t> histogram;
+    };
+
+    struct ReferenceTimeStep
+    {
+      Image::ConstPointer image;
+      ReferenceAccessorType accessor;
+      double minimum = 0.0;
+      double binWidth = 1.0;
+    };
+
+    using StatisticsKeyType = std::pair<LabelValueType, TimeStepType>;
+    using StatisticsMapType = std::map<StatisticsKeyType, LabelStatistics>;
+
+    void OnGroupSliceModified(const itk::EventObject& event);
+    void Invalidate();
+
+    void InitializeReference();
+    void ComputeGroup(GroupIndexType groupID);
+    LabelStatistics& GetOrCreateStatistics(LabelValueType label, TimeStepType timeStep);
+    const LabelStatistics* FindStatistics(LabelValueType label, TimeStepType timeStep) const;
+
+    /** Adds (weight 1) or removes (weight -1) the voxel with the given index and buffer offset.*/
+    void ChangeVoxel(LabelStatistics& statistics, TimeStepType timeStep, const itk::Index<3>& index, std::size_t offset, int weight) const;
+
+    MultiLabelSegmentation::ConstPointer m_Segmentation;
+    Image::ConstPointer m_ReferenceImage;
+    unsigned int m_NumberOfHistogramBins;
+
+    std::array<std::size_t, 3> m_Dimensions;
+    StatisticsMapType m_Statistics;
+    std::vector<ReferenceTimeStep> m_ReferenceTimeSteps;
+    /** Modification time of each group image when its statistics were last synchronized (0 = invalid).*/
+    std::vector<itk::ModifiedTimeType> m_GroupMTimes;
+    /** Last write access time (see Image::GetLastWriteAccessTime()) of each group image when its statistics were last synchronized.*/
+    std::vector<itk::ModifiedTimeType> m_GroupWriteAccessTimes;
+    /** Time stamp of the last computation of a group or invalidation of all statistics.*/
+    itk::ModifiedTimeType m_ComputeTime;
+    itk::ModifiedTimeType m_ReferenceMTime;
+
+    ITKEventObserverGuard m_SliceModifiedObserver;
+    ITKEventObserverGuard m_GroupAddedObserver;
+    ITKEventObserverGuard m_GroupRemovedObserver;
+  };
+}
+
+#endif
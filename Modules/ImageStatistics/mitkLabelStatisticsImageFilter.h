@@ -25,10 +25,22 @@ found in the LICENSE file.
 #include <unordered_map>
 #include <vector>
 
+#include <mitkAdaptiveHistogram.h>
 #include <mitkLabel.h>
 
 namespace mitk
 {
+  /**
+   * @brief Computes the statistics of an image for every label of a label image in a single, multithreaded pass.
+   *
+   * Besides the moments, the extrema (including their indices) and the bounding box of every label, a
+   * histogram per label can be computed in the same pass. Either the histogram bounds of every label are
+   * passed via SetHistogramParameters(), or they are derived from the minimum and maximum of the label
+   * (SetAdaptiveHistogramParameters() and SetAdaptiveHistogramBinSize()).
+   *
+   * If a secondary mask is set, all pixels where the secondary mask is not 1 are treated as label 0.
+   * This combines both masks on the fly, so no combined mask image has to be generated beforehand.
+   */
   template <typename TInputImage>
   class LabelStatisticsImageFilter : public itk::ImageSink<TInputImage>
   {
@@ -72,6 +84,8 @@ namespace mitk
       itk::SizeValueType m_CountOfPositivePixels;
       RealType m_Min;
       RealType m_Max;
+      IndexType m_MinIndex;
+      IndexType m_MaxIndex;
       RealType m_Mean;
       itk::CompensatedSummation<RealType> m_Sum;
       itk::CompensatedSummation<RealType> m_SumOfPositivePixels;
@@ -89,6 +103,7 @@ namespace mitk
       RealType m_Kurtosis;
       BoundingBoxType m_BoundingBox;
       HistogramPointer m_Histogram;
+      AdaptiveHistogram m_AdaptiveHistogram;
     };
 
     using MapType = std::unordered_map<LabelPixelType, LabelStatistics>;
@@ -103,18 +118,31 @@ namespace mitk
       const std::unordered_map<LabelPixelType, RealType>& lowerBounds,
       const std::unordered_map<LabelPixelType, RealType>& upperBounds);
 
+    /** Computes histograms with the passed number of bins between the minimum and the maximum of every label. */
+    void SetAdaptiveHistogramParameters(unsigned int size);
+
+    /** Computes histograms between the minimum and the maximum of every label. The number of bins is
+     * (maximum - minimum) / binSize, but at least minimumSize.*/
+    void SetAdaptiveHistogramBinSize(RealType binSize, unsigned int minimumSize = 1);
+
     using LabelImageType = itk::Image<LabelPixelType, ImageDimension>;
     using ProcessObject = itk::ProcessObject;
 
     itkSetInputMacro(LabelInput, LabelImageType);
     itkGetInputMacro(LabelInput, LabelImageType);
 
+    /** Optional mask that is combined (AND) with the label input. */
+    itkSetInputMacro(SecondaryMaskInput, LabelImageType);
+    itkGetInputMacro(SecondaryMaskInput, LabelImageType);
+
     bool HasLabel(LabelPixelType label) const;
     unsigned int GetNumberOfObjects() const;
     unsigned int GetNumberOfLabels() const;
 
     PixelType GetMinimum(LabelPixelType label) const;
     PixelType GetMaximum(LabelPixelType label) const;
+    IndexType GetMinimumIndex(LabelPixelType label) const;
+    IndexType GetMaximumIndex(LabelPixelType label) const;
     RealType GetMean(LabelPixelType label) const;
     RealType GetSigma(LabelPixelType label) const;
     RealType GetVariance(LabelPixelType label) const;
@@ -150,10 +178,21 @@ namespace mitk
 
     void MergeMap(MapType& map1, MapType& map2) const;
 
+    LabelStatistics CreateLabelStatistics(LabelPixelType label);
+
+    /** Determines the histogram size of an adaptive histogram for the passed value range. */
+    unsigned int GetAdaptiveHistogramSize(RealType minimum, RealType maximum) const;
+
+    static HistogramPointer CreateInitializedHistogram(unsigned int size, RealType lowerBound, RealType upperBound);
+
     MapType m_LabelStatistics;
     ValidLabelValuesContainerType m_ValidLabelValues;
 
     bool m_ComputeHistograms;
+    bool m_AdaptiveHistograms;
+    unsigned int m_AdaptiveHistogramSize;
+    RealType m_AdaptiveHistogramBinSize;
+    unsigned int m_MinimumAdaptiveHistogramSize;
     std::unordered_map<LabelPixelType, unsigned int> m_HistogramSizes;
     std::unordered_map<LabelPixelType, RealType> m_HistogramLowerBounds;
     std::unordered_map<LabelPixelType, RealType> m_HistogramUpperBounds;
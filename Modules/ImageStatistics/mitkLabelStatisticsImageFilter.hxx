@@ -42,6 +42,8 @@ mitk::LabelStatisticsImageFilter<TInputImage>::LabelStatistics::LabelStatistics(
     m_Skewness(0),
     m_Kurtosis(0)
 {
+  m_MinIndex.Fill(0);
+  m_MaxIndex.Fill(0);
   m_BoundingBox.resize(ImageDimension * 2);
 
   for (std::remove_const_t<decltype(ImageDimension)> i = 0; i < ImageDimension * 2; i += 2)
@@ -55,21 +57,7 @@ template <typename TInputImage>
 mitk::LabelStatisticsImageFilter<TInputImage>::LabelStatistics::LabelStatistics(unsigned int size, RealType lowerBound, RealType upperBound)
   : LabelStatistics()
 {
-  typename HistogramType::SizeType histogramSize;
-  histogramSize.SetSize(1);
-  histogramSize[0] = size;
-
-  typename HistogramType::MeasurementVectorType histogramLowerBound;
-  histogramLowerBound.SetSize(1);
-  histogramLowerBound[0] = lowerBound;
-
-  typename HistogramType::MeasurementVectorType histogramUpperBound;
-  histogramUpperBound.SetSize(1);
-  histogramUpperBound[0] = upperBound;
-
-  m_Histogram = HistogramType::New();
-  m_Histogram->SetMeasurementVectorSize(1);
-  m_Histogram->Initialize(histogramSize, histogramLowerBound, histogramUpperBound);
+  m_Histogram = LabelStatisticsImageFilter::CreateInitializedHistogram(size, lowerBound, upperBound);
 }
 
 template <typename TInputImage>
@@ -79,9 +67,14 @@ mitk::LabelStatisticsImageFilter<TInputImage>::LabelStatistics::~LabelStatistics
 
 template <typename TInputImage>
 mitk::LabelStatisticsImageFilter<TInputImage>::LabelStatisticsImageFilter()
-  : m_ComputeHistograms(false)
+  : m_ComputeHistograms(false),
+    m_AdaptiveHistograms(false),
+    m_AdaptiveHistogramSize(0),
+    m_AdaptiveHistogramBinSize(0),
+    m_MinimumAdaptiveHistogramSize(1)
 {
   this->AddRequiredInputName("LabelInput");
+  this->AddOptionalInputName("SecondaryMaskInput");
 }
 
 template <typename TInputImage>
@@ -109,8 +102,13 @@ auto mitk::LabelStatisticsImageFilter<TInputImage>::ThreadedStreamedGenerateData
 
   using TLabelImage = itk::Image<LabelPixelType, ImageDimension>;
 
+  const auto* secondaryMask = this->GetSecondaryMaskInput();
+  const bool hasSecondaryMask = nullptr != secondaryMask;
+
   itk::ImageLinearConstIteratorWithIndex<TInputImage> it(this->GetInput(), region);
   itk::ImageScanlineConstIterator<TLabelImage> labelIt(this->GetLabelInput(), region);
+  // Without secondary mask the iterator is never dereferenced
+  itk::ImageScanlineConstIterator<TLabelImage> secondaryMaskIt(hasSecondaryMask ? secondaryMask : this->GetLabelInput(), region);
 
   auto mapIt = localStats.end();
 
@@ -120,21 +118,34 @@ auto mitk::LabelStatisticsImageFilter<TInputImage>::ThreadedStreamedGenerateData
     {
       const auto& value = static_cast<RealType>(it.Get());
       const auto& index = it.GetIndex();
-      const auto& label = labelIt.Get();
+      auto label = labelIt.Get();
 
-      mapIt = localStats.find(label);
+      if (hasSecondaryMask && 1 != secondaryMaskIt.Get())
+        label = 0;
 
-      if (mapIt == localStats.end())
+      // Neighbouring pixels mostly share their label, so the map is only searched if the label changes
+      if (mapIt == localStats.end() || mapIt->first != label)
       {
-        mapIt = m_ComputeHistograms
-          ? localStats.emplace(label, LabelStatistics(m_HistogramSizes[label], m_HistogramLowerBounds[label], m_HistogramUpperBounds[label])).first
-          : localStats.emplace(label, LabelStatistics()).first;
+        mapIt = localStats.find(label);
+
+        if (mapIt == localStats.end())
+          mapIt = localStats.emplace(label, this->CreateLabelStatistics(label)).first;
       }
 
       auto& labelStats = mapIt->second;
 
-      labelStats.m_Min = std::min(labelStats.m_Min, value);
-      labelStats.m_Max = std::max(labelStats.m_Max, value);
+      if (0 == labelStats.m_Count || value < labelStats.m_Min)
+      {
+        labelStats.m_Min = value;
+        labelStats.m_MinIndex = index;
+      }
+
+      if (0 == labelStats.m_Count || labelStats.m_Max < value)
+      {
+        labelStats.m_Max = value;
+        labelStats.m_MaxIndex = index;
+      }
+
       labelStats.m_Sum += value;
       auto squareValue = value * value;
       labelStats.m_SumOfSquares += squareValue;
@@ -154,17 +165,27 @@ auto mitk::LabelStatisticsImageFilter<TInputImage>::ThreadedStreamedGenerateData
         labelStats.m_BoundingBox[i + 1] = std::max(labelStats.m_BoundingBox[i + 1], index[i / 2]);
       }
 
-      if (m_ComputeHistograms)
+      if (m_ComputeHistograms && m_AdaptiveHistograms)
+      {
+        labelStats.m_AdaptiveHistogram.AddValue(value);
+      }
+      else if (m_ComputeHistograms)
       {
         histogramMeasurement[0] = value;
         labelStats.m_Histogram->GetIndex(histogramMeasurement, histogramIndex);
         labelStats.m_Histogram->IncreaseFrequencyOfIndex(histogramIndex, 1);
       }
 
+      if (hasSecondaryMask)
+        ++secondaryMaskIt;
+
       ++labelIt;
       ++it;
     }
 
+    if (hasSecondaryMask)
+      secondaryMaskIt.NextLine();
+
     labelIt.NextLine();
     it.NextLine();
   }
@@ -237,6 +258,13 @@ auto mitk::LabelStatisticsImageFilter<TInputImage>::AfterStreamedGenerateData()
 
     if (m_ComputeHistograms)
     {
+      if (m_AdaptiveHistograms)
+      {
+        stats.m_Histogram = CreateInitializedHistogram(this->GetAdaptiveHistogramSize(stats.m_Min, stats.m_Max), stats.m_Min, stats.m_Max);
+        stats.m_AdaptiveHistogram.FillHistogram(stats.m_Histogram, stats.m_Min, stats.m_Max);
+        stats.m_AdaptiveHistogram = AdaptiveHistogram();
+      }
+
       mitk::HistogramStatisticsCalculator histogramStatisticsCalculator;
       histogramStatisticsCalculator.SetHistogram(stats.m_Histogram);
       histogramStatisticsCalculator.CalculateStatistics();
@@ -275,12 +303,90 @@ auto mitk::LabelStatisticsImageFilter<TInputImage>::SetHistogramParameters(
     modified = true;
   }
 
-  m_ComputeHistograms = true;
+  if (!m_ComputeHistograms || m_AdaptiveHistograms)
+  {
+    m_ComputeHistograms = true;
+    m_AdaptiveHistograms = false;
+    modified = true;
+  }
 
   if (modified)
     this->Modified();
 }
 
+template <typename TInputImage>
+auto mitk::LabelStatisticsImageFilter<TInputImage>::SetAdaptiveHistogramParameters(unsigned int size) -> void
+{
+  if (m_ComputeHistograms && m_AdaptiveHistograms && m_AdaptiveHistogramSize == size && m_AdaptiveHistogramBinSize == 0)
+    return;
+
+  m_ComputeHistograms = true;
+  m_AdaptiveHistograms = true;
+  m_AdaptiveHistogramSize = size;
+  m_AdaptiveHistogramBinSize = 0;
+
+  this->Modified();
+}
+
+template <typename TInputImage>
+auto mitk::LabelStatisticsImageFilter<TInputImage>::SetAdaptiveHistogramBinSize(RealType binSize, unsigned int minimumSize) -> void
+{
+  if (m_ComputeHistograms && m_AdaptiveHistograms && m_AdaptiveHistogramBinSize == binSize && m_MinimumAdaptiveHistogramSize == minimumSize)
+    return;
+
+  m_ComputeHistograms = true;
+  m_AdaptiveHistograms = true;
+  m_AdaptiveHistogramBinSize = binSize;
+  m_MinimumAdaptiveHistogramSize = minimumSize;
+
+  this->Modified();
+}
+
+template <typename TInputImage>
+auto mitk::LabelStatisticsImageFilter<TInputImage>::GetAdaptiveHistogramSize(RealType minimum, RealType maximum) const -> unsigned int
+{
+  if (m_AdaptiveHistogramBinSize > 0)
+    return static_cast<unsigned int>(std::max(std::ceil(maximum - minimum) / m_AdaptiveHistogramBinSize, static_cast<RealType>(m_MinimumAdaptiveHistogramSize)));
+
+  return m_AdaptiveHistogramSize;
+}
+
+template <typename TInputImage>
+auto mitk::LabelStatisticsImageFilter<TInputImage>::CreateInitializedHistogram(unsigned int size, RealType lowerBound, RealType upperBound) -> HistogramPointer
+{
+  typename HistogramType::SizeType histogramSize;
+  histogramSize.SetSize(1);
+  histogramSize[0] = size;
+
+  typename HistogramType::MeasurementVectorType histogramLowerBound;
+  histogramLowerBound.SetSize(1);
+  histogramLowerBound[0] = lowerBound;
+
+  typename HistogramType::MeasurementVectorType histogramUpperBound;
+  histogramUpperBound.SetSize(1);
+  histogramUpperBound[0] = upperBound;
+
+  auto histogram = HistogramType::New();
+  histogram->SetMeasurementVectorSize(1);
+  histogram->Initialize(histogramSize, histogramLowerBound, histogramUpperBound);
+
+  return histogram;
+}
+
+template <typename TInputImage>
+auto mitk::LabelStatisticsImageFilter<TInputImage>::CreateLabelStatistics(LabelPixelType label) -> LabelStatistics
+{
+  if (!m_ComputeHistograms)
+    return LabelStatistics();
+
+  if (!m_AdaptiveHistograms)
+    return LabelStatistics(m_HistogramSizes[label], m_HistogramLowerBounds[label], m_HistogramUpperBounds[label]);
+
+  LabelStatistics statistics;
+  statistics.m_AdaptiveHistogram = AdaptiveHistogram(itk::NumericTraits<PixelType>::is_integer);
+  return statistics;
+}
+
 template <typename TInputImage>
 auto mitk::LabelStatisticsImageFilter<TInputImage>::MergeMap(MapType& map1, MapType& map2) const -> void
 {
@@ -298,8 +404,20 @@ auto mitk::LabelStatisticsImageFilter<TInputImage>::MergeMap(MapType& map1, MapT
       auto& stats1 = iter1->second;
       auto& stats2 = elem2.second;
 
-      stats1.m_Min = std::min(stats1.m_Min, stats2.m_Min);
-      stats1.m_Max = std::max(stats1.m_Max, stats2.m_Max);
+      // Ties are resolved in favor of the lower offset, so the indices do not depend on the order of the work units
+      const auto* input = this->GetInput();
+
+      if (stats2.m_Min < stats1.m_Min || (!(stats1.m_Min < stats2.m_Min) && input->ComputeOffset(stats2.m_MinIndex) < input->ComputeOffset(stats1.m_MinIndex)))
+      {
+        stats1.m_Min = stats2.m_Min;
+        stats1.m_MinIndex = stats2.m_MinIndex;
+      }
+
+      if (stats1.m_Max < stats2.m_Max || (!(stats2.m_Max < stats1.m_Max) && input->ComputeOffset(stats2.m_MaxIndex) < input->ComputeOffset(stats1.m_MaxIndex)))
+      {
+        stats1.m_Max = stats2.m_Max;
+        stats1.m_MaxIndex = stats2.m_MaxIndex;
+      }
 
       stats1.m_Sum += stats2.m_Sum;
       stats1.m_SumOfSquares += stats2.m_SumOfSquares;
@@ -315,7 +433,11 @@ auto mitk::LabelStatisticsImageFilter<TInputImage>::MergeMap(MapType& map1, MapT
         stats1.m_BoundingBox[i + 1] = std::max(stats1.m_BoundingBox[i + 1], stats2.m_BoundingBox[i + 1]);
       }
 
-      if (m_ComputeHistograms)
+      if (m_ComputeHistograms && m_AdaptiveHistograms)
+      {
+        stats1.m_AdaptiveHistogram.Merge(stats2.m_AdaptiveHistogram);
+      }
+      else if (m_ComputeHistograms)
       {
         typename HistogramType::IndexType index;
         index.SetSize(1);
@@ -392,6 +514,20 @@ auto mitk::LabelStatisticsImageFilter<TInputImage>::GetMaximum(LabelPixelType la
   return labelStatistics.m_Max;
 }
 
+template <typename TInputImage>
+auto mitk::LabelStatisticsImageFilter<TInputImage>::GetMinimumIndex(LabelPixelType label) const -> IndexType
+{
+  const auto& labelStatistics = this->GetLabelStatistics(label);
+  return labelStatistics.m_MinIndex;
+}
+
+template <typename TInputImage>
+auto mitk::LabelStatisticsImageFilter<TInputImage>::GetMaximumIndex(LabelPixelType label) const -> IndexType
+{
+  const auto& labelStatistics = this->GetLabelStatistics(label);
+  return labelStatistics.m_MaxIndex;
+}
+
 template <typename TInputImage>
 auto mitk::LabelStatisticsImageFilter<TInputImage>::GetMean(LabelPixelType label) const -> RealType
 {
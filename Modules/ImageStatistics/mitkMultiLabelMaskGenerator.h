@@ -22,6 +22,8 @@ namespace mitk
 {
 /**
  * @brief Class that allows to generate masks (for statistic computation) out of multi label segmentations
+ *
+ * There is one mask per group; the mask ID is the group index and the mask contains the label values of the group.
  */
 class MITKIMAGESTATISTICS_EXPORT MultiLabelMaskGenerator: public MaskGenerator
 {
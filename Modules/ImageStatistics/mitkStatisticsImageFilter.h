@@ -15,6 +15,7 @@ found in the LICENSE file.
 
 // This file is based on ITK's itkStatisticsImageFilter.h
 
+#include <mitkAdaptiveHistogram.h>
 #include <mitkCommon.h>
 
 #include <itkArray.h>
@@ -28,6 +29,18 @@ found in the LICENSE file.
 
 namespace mitk
 {
+  /**
+   * @brief Computes the statistics of an image in a single, multithreaded pass.
+   *
+   * Besides the moments and the extrema (including their indices) a histogram can be computed in the
+   * same pass. Either the histogram bounds are passed via SetHistogramParameters(), or they are derived
+   * from the minimum and maximum found by the filter itself (SetAdaptiveHistogramParameters() and
+   * SetAdaptiveHistogramBinSize()). In the latter case the values are accumulated in an
+   * mitk::AdaptiveHistogram and rebinned after the pass.
+   *
+   * Every work unit accumulates its region line by line into local partials that are merged
+   * at the end of the work unit.
+   */
   template <typename TInputImage>
   class StatisticsImageFilter : public itk::ImageSink<TInputImage>
   {
@@ -42,6 +55,7 @@ namespace mitk
     itkTypeMacro(StatisticsImageFilter, itk::ImageSink);
 
     using RegionType = typename TInputImage::RegionType;
+    using IndexType = typename TInputImage::IndexType;
     using PixelType = typename TInputImage::PixelType;
 
     using RealType = typename itk::NumericTraits<PixelType>::RealType;
@@ -56,10 +70,13 @@ namespace mitk
 
     using RealObjectType = SimpleDataObjectDecorator<RealType>;
     using PixelObjectType = SimpleDataObjectDecorator<PixelType>;
+    using IndexObjectType = SimpleDataObjectDecorator<IndexType>;
     using ProcessObject = itk::ProcessObject;
 
     itkGetDecoratedOutputMacro(Minimum, PixelType);
     itkGetDecoratedOutputMacro(Maximum, PixelType);
+    itkGetDecoratedOutputMacro(MinimumIndex, IndexType);
+    itkGetDecoratedOutputMacro(MaximumIndex, IndexType);
     itkGetDecoratedOutputMacro(Mean, RealType);
     itkGetDecoratedOutputMacro(Sigma, RealType);
     itkGetDecoratedOutputMacro(Variance, RealType);
@@ -76,8 +93,16 @@ namespace mitk
     itkGetDecoratedOutputMacro(UPP, RealType);
     itkGetDecoratedOutputMacro(Median, RealType);
 
+    /** Computes a histogram with the passed number of bins and bounds. */
     void SetHistogramParameters(unsigned int size, RealType lowerBound, RealType upperBound);
 
+    /** Computes a histogram with the passed number of bins between the minimum and the maximum of the input. */
+    void SetAdaptiveHistogramParameters(unsigned int size);
+
+    /** Computes a histogram between the minimum and the maximum of the input. The number of bins is
+     * (maximum - minimum) / binSize, but at least minimumSize.*/
+    void SetAdaptiveHistogramBinSize(RealType binSize, unsigned int minimumSize = 1);
+
     using DataObjectIdentifierType = itk::ProcessObject::DataObjectIdentifierType;
     using Superclass::MakeOutput;
     
@@ -90,6 +115,8 @@ namespace mitk
 
     itkSetDecoratedOutputMacro(Minimum, PixelType);
     itkSetDecoratedOutputMacro(Maximum, PixelType);
+    itkSetDecoratedOutputMacro(MinimumIndex, IndexType);
+    itkSetDecoratedOutputMacro(MaximumIndex, IndexType);
     itkSetDecoratedOutputMacro(Mean, RealType);
     itkSetDecoratedOutputMacro(Sigma, RealType);
     itkSetDecoratedOutputMacro(Variance, RealType);
@@ -113,13 +140,20 @@ namespace mitk
     void PrintSelf(std::ostream& os, itk::Indent indent) const override;
 
   private:
-    HistogramPointer CreateInitializedHistogram() const;
+    HistogramPointer CreateInitializedHistogram(unsigned int size, RealType lowerBound, RealType upperBound) const;
+
+    /** Determines the histogram size of the adaptive histogram for the passed value range. */
+    unsigned int GetAdaptiveHistogramSize(RealType minimum, RealType maximum) const;
 
     bool m_ComputeHistogram;
+    bool m_AdaptiveHistogram;
+    RealType m_HistogramBinSize;
+    unsigned int m_MinimumHistogramSize;
     unsigned int m_HistogramSize;
     RealType m_HistogramLowerBound;
     RealType m_HistogramUpperBound;
     HistogramPointer m_Histogram;
+    AdaptiveHistogram m_AdaptiveHistogramAccumulator;
 
     itk::CompensatedSummation<RealType> m_Sum;
     itk::CompensatedSummation<RealType> m_SumOfPositivePixels;
@@ -131,6 +165,8 @@ namespace mitk
     itk::SizeValueType m_CountOfPositivePixels;
     PixelType m_Min;
     PixelType m_Max;
+    itk::OffsetValueType m_MinOffset;
+    itk::OffsetValueType m_MaxOffset;
 
     std::mutex m_Mutex;
   };
@@ -20,6 +20,9 @@ found in the LICENSE file.
 template <typename TInputImage>
 mitk::StatisticsImageFilter<TInputImage>::StatisticsImageFilter()
   : m_ComputeHistogram(false),
+    m_AdaptiveHistogram(false),
+    m_HistogramBinSize(0),
+    m_MinimumHistogramSize(1),
     m_HistogramSize(0),
     m_HistogramLowerBound(itk::NumericTraits<RealType>::NonpositiveMin()),
     m_HistogramUpperBound(itk::NumericTraits<RealType>::max()),
@@ -31,12 +34,19 @@ mitk::StatisticsImageFilter<TInputImage>::StatisticsImageFilter()
     m_Count(1),
     m_CountOfPositivePixels(1),
     m_Min(1),
-    m_Max(1)
+    m_Max(1),
+    m_MinOffset(0),
+    m_MaxOffset(0)
 {
   this->SetNumberOfRequiredInputs(1);
 
+  IndexType index;
+  index.Fill(0);
+
   this->SetMinimum(itk::NumericTraits<PixelType>::max());
   this->SetMaximum(itk::NumericTraits<PixelType>::NonpositiveMin());
+  this->SetMinimumIndex(index);
+  this->SetMaximumIndex(index);
   this->SetMean(itk::NumericTraits<RealType>::max());
   this->SetSigma(itk::NumericTraits<RealType>::max());
   this->SetVariance(itk::NumericTraits<RealType>::max());
@@ -67,6 +77,12 @@ typename mitk::StatisticsImageFilter<TInputImage>::DataObjectPointer mitk::Stati
     return PixelObjectType::New();
   }
 
+  if (name == "MinimumIndex" ||
+      name == "MaximumIndex")
+  {
+    return IndexObjectType::New();
+  }
+
   if (name == "Mean" ||
       name == "Sigma" ||
       name == "Variance" ||
@@ -116,26 +132,68 @@ void mitk::StatisticsImageFilter<TInputImage>::SetHistogramParameters(unsigned i
     modified = true;
   }
 
-  m_ComputeHistogram = true;
+  if (!m_ComputeHistogram || m_AdaptiveHistogram)
+  {
+    m_ComputeHistogram = true;
+    m_AdaptiveHistogram = false;
+    modified = true;
+  }
 
   if (modified)
     this->Modified();
 }
 
 template <typename TInputImage>
-auto mitk::StatisticsImageFilter<TInputImage>::CreateInitializedHistogram() const -> HistogramPointer
+void mitk::StatisticsImageFilter<TInputImage>::SetAdaptiveHistogramParameters(unsigned int size)
+{
+  if (m_ComputeHistogram && m_AdaptiveHistogram && m_HistogramSize == size && m_HistogramBinSize == 0)
+    return;
+
+  m_ComputeHistogram = true;
+  m_AdaptiveHistogram = true;
+  m_HistogramSize = size;
+  m_HistogramBinSize = 0;
+
+  this->Modified();
+}
+
+template <typename TInputImage>
+void mitk::StatisticsImageFilter<TInputImage>::SetAdaptiveHistogramBinSize(RealType binSize, unsigned int minimumSize)
+{
+  if (m_ComputeHistogram && m_AdaptiveHistogram && m_HistogramBinSize == binSize && m_MinimumHistogramSize == minimumSize)
+    return;
+
+  m_ComputeHistogram = true;
+  m_AdaptiveHistogram = true;
+  m_HistogramBinSize = binSize;
+  m_MinimumHistogramSize = minimumSize;
+
+  this->Modified();
+}
+
+template <typename TInputImage>
+unsigned int mitk::StatisticsImageFilter<TInputImage>::GetAdaptiveHistogramSize(RealType minimum, RealType maximum) const
+{
+  if (m_HistogramBinSize > 0)
+    return static_cast<unsigned int>(std::max(std::ceil(maximum - minimum) / m_HistogramBinSize, static_cast<RealType>(m_MinimumHistogramSize)));
+
+  return m_HistogramSize;
+}
+
+template <typename TInputImage>
+auto mitk::StatisticsImageFilter<TInputImage>::CreateInitializedHistogram(unsigned int histogramSize, RealType histogramLowerBound, RealType histogramUpperBound) const -> HistogramPointer
 {
   typename HistogramType::SizeType size;
   size.SetSize(1);
-  size.Fill(m_HistogramSize);
+  size.Fill(histogramSize);
 
   typename HistogramType::MeasurementVectorType lowerBound;
   lowerBound.SetSize(1);
-  lowerBound.Fill(m_HistogramLowerBound);
+  lowerBound.Fill(histogramLowerBound);
 
   typename HistogramType::MeasurementVectorType upperBound;
   upperBound.SetSize(1);
-  upperBound.Fill(m_HistogramUpperBound);
+  upperBound.Fill(histogramUpperBound);
 
   auto histogram = HistogramType::New();
   histogram->SetMeasurementVectorSize(1);
@@ -158,14 +216,27 @@ void mitk::StatisticsImageFilter<TInputImage>::BeforeStreamedGenerateData()
   m_CountOfPositivePixels = 0;
   m_Min = itk::NumericTraits<PixelType>::max();
   m_Max = itk::NumericTraits<PixelType>::NonpositiveMin();
+  m_MinOffset = 0;
+  m_MaxOffset = 0;
+  m_Histogram = nullptr;
+  m_AdaptiveHistogramAccumulator = AdaptiveHistogram(itk::NumericTraits<PixelType>::is_integer);
 
-  if (m_ComputeHistogram)
-    m_Histogram = this->CreateInitializedHistogram();
+  if (m_ComputeHistogram && !m_AdaptiveHistogram)
+    m_Histogram = this->CreateInitializedHistogram(m_HistogramSize, m_HistogramLowerBound, m_HistogramUpperBound);
 }
 
 template <typename TInputImage>
 void mitk::StatisticsImageFilter<TInputImage>::ThreadedStreamedGenerateData(const RegionType& regionForThread)
 {
+  const auto lineLength = regionForThread.GetSize(0);
+
+  if (0 == lineLength)
+    return;
+
+  // Number of independent accumulators per line. Splitting the sums into lanes
+  // breaks their dependency chains, so the compiler can vectorize the loop.
+  constexpr itk::SizeValueType NumberOfLanes = 4;
+
   itk::CompensatedSummation<RealType> sum = 0;
   itk::CompensatedSummation<RealType> sumOfPositivePixels = 0;
   itk::CompensatedSummation<RealType> sumOfSquares = 0;
@@ -173,56 +244,110 @@ void mitk::StatisticsImageFilter<TInputImage>::ThreadedStreamedGenerateData(cons
   itk::CompensatedSummation<RealType> sumOfQuadruples = 0;
   itk::SizeValueType count = 0;
   itk::SizeValueType countOfPositivePixels = 0;
-  auto min = itk::NumericTraits<PixelType>::max();
-  auto max = itk::NumericTraits<PixelType>::NonpositiveMin();
-  RealType realValue = 0;
-  RealType squareValue = 0;
+
+  const auto* input = this->GetInput();
+  const PixelType* buffer = input->GetBufferPointer();
+
+  itk::OffsetValueType minOffset = input->ComputeOffset(regionForThread.GetIndex());
+  itk::OffsetValueType maxOffset = minOffset;
+  auto min = buffer[minOffset];
+  auto max = min;
 
   HistogramPointer histogram;
   typename HistogramType::MeasurementVectorType histogramMeasurement;
   typename HistogramType::IndexType histogramIndex;
+  AdaptiveHistogram adaptiveHistogram(itk::NumericTraits<PixelType>::is_integer);
 
-  if (m_ComputeHistogram) // Initialize histogram
+  if (m_ComputeHistogram && !m_AdaptiveHistogram) // Initialize histogram
   {
-    histogram = this->CreateInitializedHistogram();
+    histogram = this->CreateInitializedHistogram(m_HistogramSize, m_HistogramLowerBound, m_HistogramUpperBound);
     histogramMeasurement.SetSize(1);
   }
 
-  itk::ImageScanlineConstIterator<TInputImage> it(this->GetInput(), regionForThread);
+  itk::ImageScanlineConstIterator<TInputImage> it(input, regionForThread);
 
   while (!it.IsAtEnd())
   {
-    while (!it.IsAtEndOfLine())
+    // Lines are contiguous in the buffer, so they are read directly
+    const auto lineOffset = input->ComputeOffset(it.GetIndex());
+    const PixelType* line = buffer + lineOffset;
+
+    RealType lineSum[NumberOfLanes] = {};
+    RealType lineSumOfPositivePixels[NumberOfLanes] = {};
+    RealType lineSumOfSquares[NumberOfLanes] = {};
+    RealType lineSumOfCubes[NumberOfLanes] = {};
+    RealType lineSumOfQuadruples[NumberOfLanes] = {};
+    itk::SizeValueType lineCountOfPositivePixels[NumberOfLanes] = {};
+
+    auto accumulate = [&](const PixelType& value, itk::SizeValueType lane)
     {
-      const auto& value = it.Get();
-      realValue = static_cast<RealType>(value);
+      const auto realValue = static_cast<RealType>(value);
+      const auto squareValue = realValue * realValue;
+      const bool isPositive = 0 < realValue;
 
-      if (m_ComputeHistogram) // Compute histogram
+      lineSum[lane] += realValue;
+      lineSumOfSquares[lane] += squareValue;
+      lineSumOfCubes[lane] += squareValue * realValue;
+      lineSumOfQuadruples[lane] += squareValue * squareValue;
+      lineSumOfPositivePixels[lane] += isPositive ? realValue : 0;
+      lineCountOfPositivePixels[lane] += isPositive;
+    };
+
+    itk::SizeValueType i = 0;
+
+    for (; i + NumberOfLanes <= lineLength; i += NumberOfLanes)
+    {
+      for (itk::SizeValueType lane = 0; lane < NumberOfLanes; ++lane)
+        accumulate(line[i + lane], lane);
+    }
+
+    for (; i < lineLength; ++i)
+      accumulate(line[i], 0);
+
+    for (i = 0; i < lineLength; ++i)
+    {
+      if (line[i] < min)
       {
-        histogramMeasurement[0] = realValue;
-        histogram->GetIndex(histogramMeasurement, histogramIndex);
-        histogram->IncreaseFrequencyOfIndex(histogramIndex, 1);
+        min = line[i];
+        minOffset = lineOffset + i;
       }
 
-      min = std::min(min, value);
-      max = std::max(max, value);
-      squareValue = realValue * realValue;
-
-      sum += realValue;
-      sumOfSquares += squareValue;
-      sumOfCubes += squareValue * realValue;
-      sumOfQuadruples += squareValue * squareValue;
-      ++count;
+      if (max < line[i])
+      {
+        max = line[i];
+        maxOffset = lineOffset + i;
+      }
+    }
 
-      if (0 < realValue)
+    if (m_ComputeHistogram) // Compute histogram while the line is still cached
+    {
+      if (m_AdaptiveHistogram)
+      {
+        for (i = 0; i < lineLength; ++i)
+          adaptiveHistogram.AddValue(static_cast<RealType>(line[i]));
+      }
+      else
       {
-        sumOfPositivePixels += realValue;
-        ++countOfPositivePixels;
+        for (i = 0; i < lineLength; ++i)
+        {
+          histogramMeasurement[0] = static_cast<RealType>(line[i]);
+          histogram->GetIndex(histogramMeasurement, histogramIndex);
+          histogram->IncreaseFrequencyOfIndex(histogramIndex, 1);
+        }
       }
+    }
 
-      ++it;
+    for (itk::SizeValueType lane = 0; lane < NumberOfLanes; ++lane)
+    {
+      sum += lineSum[lane];
+      sumOfPositivePixels += lineSumOfPositivePixels[lane];
+      sumOfSquares += lineSumOfSquares[lane];
+      sumOfCubes += lineSumOfCubes[lane];
+      sumOfQuadruples += lineSumOfQuadruples[lane];
+      countOfPositivePixels += lineCountOfPositivePixels[lane];
     }
 
+    count += lineLength;
     it.NextLine();
   }
 
@@ -230,15 +355,37 @@ void mitk::StatisticsImageFilter<TInputImage>::ThreadedStreamedGenerateData(cons
 
   if (m_ComputeHistogram) // Merge histograms
   {
-    typename HistogramType::ConstIterator histogramIt = histogram->Begin();
-    typename HistogramType::ConstIterator histogramEnd = histogram->End();
-
-    while (histogramIt != histogramEnd)
+    if (m_AdaptiveHistogram)
     {
-      m_Histogram->GetIndex(histogramIt.GetMeasurementVector(), histogramIndex);
-      m_Histogram->IncreaseFrequencyOfIndex(histogramIndex, histogramIt.GetFrequency());
-      ++histogramIt;
+      m_AdaptiveHistogramAccumulator.Merge(adaptiveHistogram);
     }
+    else
+    {
+      typename HistogramType::ConstIterator histogramIt = histogram->Begin();
+      typename HistogramType::ConstIterator histogramEnd = histogram->End();
+
+      while (histogramIt != histogramEnd)
+      {
+        m_Histogram->GetIndex(histogramIt.GetMeasurementVector(), histogramIndex);
+        m_Histogram->IncreaseFrequencyOfIndex(histogramIndex, histogramIt.GetFrequency());
+        ++histogramIt;
+      }
+    }
+  }
+
+  // Ties are resolved in favor of the lower offset, so the indices do not depend on the order of the work units
+  const bool isFirstRegion = 0 == m_Count;
+
+  if (isFirstRegion || min < m_Min || (!(m_Min < min) && minOffset < m_MinOffset))
+  {
+    m_Min = min;
+    m_MinOffset = minOffset;
+  }
+
+  if (isFirstRegion || m_Max < max || (!(max < m_Max) && maxOffset < m_MaxOffset))
+  {
+    m_Max = max;
+    m_MaxOffset = maxOffset;
   }
 
   m_Sum += sum;
@@ -248,8 +395,6 @@ void mitk::StatisticsImageFilter<TInputImage>::ThreadedStreamedGenerateData(cons
   m_SumOfQuadruples += sumOfQuadruples;
   m_Count += count;
   m_CountOfPositivePixels += countOfPositivePixels;
-  m_Min = std::min(min, m_Min);
-  m_Max = std::max(max, m_Max);
 }
 
 template <typename TInputImage>
@@ -266,6 +411,7 @@ void mitk::StatisticsImageFilter<TInputImage>::AfterStreamedGenerateData()
   const itk::SizeValueType countOfPositivePixels = m_CountOfPositivePixels;
   const PixelType minimum = m_Min;
   const PixelType maximum = m_Max;
+  const auto* input = this->GetInput();
 
   const RealType mean = sum / static_cast<RealType>(count);
   const RealType variance = (sumOfSquares - (sum * sum / static_cast<RealType>(count))) / (static_cast<RealType>(count) - 1);
@@ -280,6 +426,8 @@ void mitk::StatisticsImageFilter<TInputImage>::AfterStreamedGenerateData()
 
   this->SetMinimum(minimum);
   this->SetMaximum(maximum);
+  this->SetMinimumIndex(input->ComputeIndex(m_MinOffset));
+  this->SetMaximumIndex(input->ComputeIndex(m_MaxOffset));
   this->SetMean(mean);
   this->SetSigma(sigma);
   this->SetVariance(variance);
@@ -293,6 +441,15 @@ void mitk::StatisticsImageFilter<TInputImage>::AfterStreamedGenerateData()
 
   if (m_ComputeHistogram)
   {
+    if (m_AdaptiveHistogram)
+    {
+      const auto lowerBound = static_cast<RealType>(minimum);
+      const auto upperBound = static_cast<RealType>(maximum);
+
+      m_Histogram = this->CreateInitializedHistogram(this->GetAdaptiveHistogramSize(lowerBound, upperBound), lowerBound, upperBound);
+      m_AdaptiveHistogramAccumulator.FillHistogram(m_Histogram, lowerBound, upperBound);
+    }
+
     this->SetHistogram(m_Histogram);
 
     mitk::HistogramStatisticsCalculator histogramStatisticsCalculator;
@@ -311,6 +468,8 @@ void mitk::StatisticsImageFilter<TInputImage>::PrintSelf(std::ostream& os, itk::
 {
   Superclass::PrintSelf(os, indent);
 
+  os << indent << "MinimumIndex: " << this->GetMinimumIndex() << std::endl;
+  os << indent << "MaximumIndex: " << this->GetMaximumIndex() << std::endl;
   os << indent << "SumOfCubes: " << this->GetSumOfCubes() << std::endl;
   os << indent << "SumOfQuadruples: " << this->GetSumOfQuadruples() << std::endl;
   os << indent << "Skewness: " << this->GetSkewness() << std::endl;
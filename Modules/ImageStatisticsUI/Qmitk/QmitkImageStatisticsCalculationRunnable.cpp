@@ -12,7 +12,6 @@ found in the LICENSE file.
 
 #include "QmitkImageStatisticsCalculationRunnable.h"
 
-#include "mitkImageStatisticsCalculator.h"
 #include <mitkPlanarFigure.h>
 #include <mitkImage.h>
 #include <mitkLabelSetImage.h>
@@ -31,6 +30,7 @@ QmitkImageStatisticsCalculationRunnable::QmitkImageStatisticsCalculationRunnable
   , m_MaskData(nullptr)
   , m_IgnoreZeros(false)
   , m_HistogramNBins(100)
+  , m_LabelStatisticsTime(0)
 {
 }
 
@@ -84,6 +84,22 @@ unsigned int QmitkImageStatisticsCalculationRunnable::GetHistogramNBins() const
   return this->m_HistogramNBins;
 }
 
+void QmitkImageStatisticsCalculationRunnable::SetPreviousStatistics(const mitk::ImageStatisticsContainer* previousStatistics, const mitk::ImageStatisticsCalculator::ModifiedLabelsType& modifiedLabels)
+{
+  this->m_PreviousStatistics = previousStatistics;
+  this->m_ModifiedLabels = modifiedLabels;
+}
+
+void QmitkImageStatisticsCalculationRunnable::SetLabelStatisticsTime(itk::ModifiedTimeType time)
+{
+  this->m_LabelStatisticsTime = time;
+}
+
+itk::ModifiedTimeType QmitkImageStatisticsCalculationRunnable::GetLabelStatisticsTime() const
+{
+  return this->m_LabelStatisticsTime;
+}
+
 QmitkDataGenerationJobBase::ResultMapType QmitkImageStatisticsCalculationRunnable::GetResults() const
 {
   ResultMapType result;
@@ -119,6 +135,7 @@ bool QmitkImageStatisticsCalculationRunnable::RunComputation()
       mitk::MultiLabelMaskGenerator::Pointer imgMask = mitk::MultiLabelMaskGenerator::New();
       imgMask->SetMultiLabelSegmentation(multiLabelMask);
       calculator->SetMask(imgMask.GetPointer());
+      calculator->SetPreviousStatistics(m_PreviousStatistics, m_ModifiedLabels);
     }
     else if (nullptr != binLabelMask)
     {
@@ -13,6 +13,7 @@ found in the LICENSE file.
 #define QmitkImageStatisticsCalculationRunnable_h
 
 //mitk headers
+#include <mitkImageStatisticsCalculator.h>
 #include <mitkImageStatisticsContainer.h>
 
 #include "QmitkDataGenerationJobBase.h"
@@ -67,6 +68,16 @@ public:
   /brief Get bin size for histogram resolution.*/
   unsigned int GetHistogramNBins() const;
 
+  /*!
+  /brief Sets the statistics of a previous run and the labels modified since then. Only used for multi label
+  segmentation masks; see mitk::ImageStatisticsCalculator::SetPreviousStatistics().*/
+  void SetPreviousStatistics(const mitk::ImageStatisticsContainer* previousStatistics, const mitk::ImageStatisticsCalculator::ModifiedLabelsType& modifiedLabels);
+  /*!
+  /brief Set/Get the time stamp of the incremental label statistics the job was set up with.
+  Labels modified later have to be recomputed by the next job.*/
+  void SetLabelStatisticsTime(itk::ModifiedTimeType time);
+  itk::ModifiedTimeType GetLabelStatisticsTime() const;
+
   ResultMapType GetResults() const override;
 
 protected:
@@ -78,5 +89,8 @@ private:
   mitk::ImageStatisticsContainer::Pointer m_StatisticsContainer;
   bool m_IgnoreZeros;                                             ///< member variable holds flag to indicate if zero valued voxel should be suppressed
   unsigned int m_HistogramNBins;                                      ///< member variable holds the bin size for histogram resolution.
+  mitk::ImageStatisticsContainer::ConstPointer m_PreviousStatistics;
+  mitk::ImageStatisticsCalculator::ModifiedLabelsType m_ModifiedLabels;
+  itk::ModifiedTimeType m_LabelStatisticsTime;
 };
 #endif
@@ -24,6 +24,8 @@ found in the LICENSE file.
 
 #include "QmitkImageStatisticsCalculationRunnable.h"
 
+#include <algorithm>
+
 void QmitkImageStatisticsDataGenerator::SetIgnoreZeroValueVoxel(bool _arg)
 {
   if (m_IgnoreZeroValueVoxel != _arg)
@@ -179,6 +181,11 @@ std::pair<QmitkDataGenerationJobBase*, mitk::DataNode::Pointer> QmitkImageStatis
     newJob->SetIgnoreZeroValueVoxel(m_IgnoreZeroValueVoxel);
     newJob->SetHistogramNBins(m_HistogramNBins);
 
+    if (nullptr != dynamic_cast<const mitk::MultiLabelSegmentation*>(mask))
+    {
+      this->InitializeIncrementalUpdate(newJob, imageNode, roiNode);
+    }
+
     return std::pair<QmitkDataGenerationJobBase*, mitk::DataNode::Pointer>(newJob, resultDataNode.GetPointer());
   }
   else if (resultDataNode->GetStringProperty(mitk::STATS_GENERATION_STATUS_PROPERTY_NAME.c_str(), status) && status == mitk::STATS_GENERATION_STATUS_VALUE_WORK_IN_PROGRESS)
@@ -218,10 +225,110 @@ void QmitkImageStatisticsDataGenerator::RemoveObsoleteDataNodes(const mitk::Data
     std::lock_guard<std::mutex> mutexguard(m_DataMutex);
 
     auto oldStatisticContainerNodes = storage->GetSubset(predicate);
+
+    for (const auto& node : *oldStatisticContainerNodes)
+    {
+      if (nullptr != node->GetData())
+        m_LabelStatisticsTimes.erase(node->GetData()->GetUID());
+    }
+
     storage->Remove(oldStatisticContainerNodes);
   }
 }
 
+void QmitkImageStatisticsDataGenerator::InitializeIncrementalUpdate(QmitkImageStatisticsCalculationRunnable* job, const mitk::DataNode* imageNode, const mitk::DataNode* roiNode) const
+{
+  auto image = dynamic_cast<const mitk::Image*>(imageNode->GetData());
+  auto segmentation = dynamic_cast<const mitk::MultiLabelSegmentation*>(roiNode->GetData());
+
+  this->RemoveObsoleteLabelStatistics();
+
+  auto& labelStatistics = m_LabelStatistics[segmentation];
+
+  if (labelStatistics.IsNull())
+  {
+    labelStatistics = mitk::IncrementalLabelStatistics::New();
+    labelStatistics->SetSegmentation(segmentation);
+  }
+
+  // only a pass over the groups modified without slice modification events
+  try
+  {
+    labelStatistics->Update();
+  }
+  catch (const std::exception& e)
+  {
+    MITK_WARN << "Cannot update label statistics incrementally. All labels will be recomputed. Reason: " << e.what();
+    m_LabelStatistics.erase(segmentation);
+    return;
+  }
+
+  itk::TimeStamp labelStatisticsTime;
+  labelStatisticsTime.Modified();
+  job->SetLabelStatisticsTime(labelStatisticsTime.GetMTime());
+
+  if (m_IgnoreZeroValueVoxel || image->GetTimeSteps() != segmentation->GetTimeSteps())
+    return;
+
+  auto previousNode = this->GetLatestResult(imageNode, roiNode, false, true);
+  auto previousStatistics = previousNode.IsNotNull() ? dynamic_cast<const mitk::ImageStatisticsContainer*>(previousNode->GetData()) : nullptr;
+
+  if (nullptr == previousStatistics)
+    return;
+
+  auto finding = m_LabelStatisticsTimes.find(previousStatistics->GetUID());
+
+  // statistics of unmodified labels can only be taken over if the image is unchanged as well
+  if (m_LabelStatisticsTimes.end() == finding || image->GetMTime() > finding->second)
+    return;
+
+  const auto previousTime = finding->second;
+  mitk::ImageStatisticsCalculator::ModifiedLabelsType modifiedLabels;
+
+  for (mitk::TimeStepType timeStep = 0; timeStep < segmentation->GetTimeSteps(); ++timeStep)
+  {
+    auto& modifiedLabelsOfTimeStep = modifiedLabels[timeStep];
+
+    auto addIfModified = [&](mitk::Label::PixelType labelValue)
+    {
+      if (labelStatistics->GetLabelMTime(labelValue, timeStep) > previousTime)
+      {
+        mitk::ImageStatisticsCalculator::ModifiedLabel modifiedLabel;
+        modifiedLabel.maskID = labelStatistics->GetGroupIndex(labelValue, timeStep);
+        modifiedLabel.region = labelStatistics->GetBoundingBox(labelValue, timeStep);
+        modifiedLabelsOfTimeStep[labelValue] = modifiedLabel;
+      }
+    };
+
+    for (auto labelValue : previousStatistics->GetExistingLabelValues())
+      addIfModified(labelValue);
+
+    for (auto labelValue : labelStatistics->GetLabelValues(timeStep))
+      addIfModified(labelValue);
+  }
+
+  job->SetPreviousStatistics(previousStatistics, modifiedLabels);
+}
+
+void QmitkImageStatisticsDataGenerator::RemoveObsoleteLabelStatistics() const
+{
+  const auto roiNodes = this->GetROINodes();
+
+  for (auto iter = m_LabelStatistics.begin(); iter != m_LabelStatistics.end();)
+  {
+    const auto isROI = std::any_of(roiNodes.begin(), roiNodes.end(), [iter](const mitk::DataNode::ConstPointer& node) { return node->GetData() == iter->first; });
+
+    if (isROI)
+    {
+      ++iter;
+    }
+    else
+    {
+      iter = m_LabelStatistics.erase(iter);
+    }
+  }
+}
+
 mitk::DataNode::Pointer QmitkImageStatisticsDataGenerator::PrepareResultForStorage(const std::string& /*label*/, mitk::BaseData* result, const QmitkDataGenerationJobBase* job) const
 {
   auto statsJob = dynamic_cast<const QmitkImageStatisticsCalculationRunnable*>(job);
@@ -235,6 +342,9 @@ mitk::DataNode::Pointer QmitkImageStatisticsDataGenerator::PrepareResultForStora
 
     resultNode->SetName(this->GenerateStatisticsNodeName(statsJob->GetStatisticsImage(), statsJob->GetMaskData()));
 
+    if (0 != statsJob->GetLabelStatisticsTime())
+      m_LabelStatisticsTimes[result->GetUID()] = statsJob->GetLabelStatisticsTime();
+
     return resultNode;
   }
 
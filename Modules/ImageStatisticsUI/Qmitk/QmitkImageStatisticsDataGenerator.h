@@ -17,12 +17,19 @@ found in the LICENSE file.
 
 #include <MitkImageStatisticsUIExports.h>
 
+#include <mitkIncrementalLabelStatistics.h>
+
+class QmitkImageStatisticsCalculationRunnable;
+
 /**
 Generates ImageStatisticContainers by using QmitkImageStatisticsCalculationRunnables for each pair if image and ROIs and ensures their
 validity.
 It also encodes the HistogramNBins and IgnoreZeroValueVoxel as properties to the results as these settings are important criteria for
 discriminating statistics results.
 For more details of how the generation is done see QmitkDataGenerationBase.
+For multi label segmentations the generator keeps mitk::IncrementalLabelStatistics up to date while the segmentation is
+edited, so that a new job only recomputes the labels that were modified since the previous result (within their bounding
+boxes) and takes over the statistics of all other labels.
 */
 class MITKIMAGESTATISTICSUI_EXPORT QmitkImageStatisticsDataGenerator : public QmitkImageAndRoiDataGeneratorBase
 {
@@ -59,11 +66,20 @@ protected:
   void RemoveObsoleteDataNodes(const mitk::DataNode* imageNode, const mitk::DataNode* roiNode) const;
   mitk::DataNode::Pointer PrepareResultForStorage(const std::string& label, mitk::BaseData* result, const QmitkDataGenerationJobBase* job) const;
 
+  /** Sets the previous result and the labels modified since then for a job of a multi label segmentation.*/
+  void InitializeIncrementalUpdate(QmitkImageStatisticsCalculationRunnable* job, const mitk::DataNode* imageNode, const mitk::DataNode* roiNode) const;
+  /** Removes the label statistics of segmentations that are no ROI anymore.*/
+  void RemoveObsoleteLabelStatistics() const;
+
   QmitkImageStatisticsDataGenerator(const QmitkImageStatisticsDataGenerator&) = delete;
   QmitkImageStatisticsDataGenerator& operator = (const QmitkImageStatisticsDataGenerator&) = delete;
 
   bool m_IgnoreZeroValueVoxel = false;
   unsigned int m_HistogramNBins = 100;
+
+  mutable std::map<const mitk::MultiLabelSegmentation*, mitk::IncrementalLabelStatistics::Pointer> m_LabelStatistics;
+  /** Time stamp of the label statistics each result (identified by its UID) was computed from.*/
+  mutable std::map<std::string, itk::ModifiedTimeType> m_LabelStatisticsTimes;
 };
 
 #endif
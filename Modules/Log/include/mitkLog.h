@@ -14,7 +14,9 @@ found in the LICENSE file.
 #define mitkLog_h
 
 #include <mitkLogBackendBase.h>
+#include <mitkLogConfig.h>
 
+#include <cstddef>
 #include <sstream>
 
 #include <MitkLogExports.h>
@@ -60,6 +62,39 @@ namespace mitk
    */
   bool MITKLOG_EXPORT IsBackendEnabled(LogBackendBase::OutputType type);
 
+  /** \brief Behavior of the asynchronous log mechanism if its message queue is full.
+   */
+  enum class LogOverflowPolicy
+  {
+    Block, ///< The emitting thread waits until the background thread made room in the queue.
+    Drop   ///< The message is discarded and counted (see GetNumberOfDroppedLogMessages()).
+  };
+
+  /** \brief Process log messages in a background thread instead of the emitting thread.
+   *
+   * Messages are put into a bounded lock-free queue, which is drained into the registered backends by a
+   * single background thread. Fatal messages, as well as messages emitted by backends themselves, are
+   * still processed synchronously. Calling this method again replaces the queue after flushing it.
+   */
+  void MITKLOG_EXPORT EnableAsynchronousLogging(std::size_t queueCapacity = 8192,
+    LogOverflowPolicy policy = LogOverflowPolicy::Block);
+
+  /** \brief Process all pending log messages and return to synchronous logging.
+   */
+  void MITKLOG_EXPORT DisableAsynchronousLogging();
+
+  /** \brief Check whether log messages are processed in a background thread.
+   */
+  bool MITKLOG_EXPORT IsAsynchronousLoggingEnabled();
+
+  /** \brief Block until all log messages emitted so far have been processed by the backends.
+   */
+  void MITKLOG_EXPORT FlushLog();
+
+  /** \brief Number of log messages discarded due to LogOverflowPolicy::Drop.
+   */
+  std::size_t MITKLOG_EXPORT GetNumberOfDroppedLogMessages();
+
   /** \brief Simulates a std::cout stream.
    *
    * Should only be used by the macros defined in the file mitkLog.h.
@@ -199,6 +234,11 @@ namespace mitk
       return *this;
     }
 
+    NullLogStream& operator()(const std::string&)
+    {
+      return *this;
+    }
+
     NullLogStream& operator()(bool)
     {
       return *this;
@@ -206,15 +246,35 @@ namespace mitk
   };
 }
 
-#define MITK_INFO mitk::PseudoLogStream(mitk::LogLevel::Info, __FILE__, __LINE__, __FUNCTION__)
-#define MITK_WARN mitk::PseudoLogStream(mitk::LogLevel::Warn, __FILE__, __LINE__, __FUNCTION__)
-#define MITK_ERROR mitk::PseudoLogStream(mitk::LogLevel::Error, __FILE__, __LINE__, __FUNCTION__)
-#define MITK_FATAL mitk::PseudoLogStream(mitk::LogLevel::Fatal, __FILE__, __LINE__, __FUNCTION__)
+#define MITK_LOG_STREAM_(level) mitk::PseudoLogStream(mitk::LogLevel::level, __FILE__, __LINE__, __FUNCTION__)
+#define MITK_NULL_LOG_STREAM_ true ? mitk::NullLogStream() : mitk::NullLogStream()
+
+// Log statements below MITK_LOG_MINIMUM_LEVEL (see mitkLogConfig.h) are compiled out entirely.
+
+#if MITK_LOG_MINIMUM_LEVEL <= MITK_LOG_LEVEL_INFO
+#define MITK_INFO MITK_LOG_STREAM_(Info)
+#else
+#define MITK_INFO MITK_NULL_LOG_STREAM_
+#endif
+
+#if MITK_LOG_MINIMUM_LEVEL <= MITK_LOG_LEVEL_WARN
+#define MITK_WARN MITK_LOG_STREAM_(Warn)
+#else
+#define MITK_WARN MITK_NULL_LOG_STREAM_
+#endif
+
+#if MITK_LOG_MINIMUM_LEVEL <= MITK_LOG_LEVEL_ERROR
+#define MITK_ERROR MITK_LOG_STREAM_(Error)
+#else
+#define MITK_ERROR MITK_NULL_LOG_STREAM_
+#endif
+
+#define MITK_FATAL MITK_LOG_STREAM_(Fatal)
 
-#ifdef MITK_ENABLE_DEBUG_MESSAGES
-#define MITK_DEBUG mitk::PseudoLogStream(mitk::LogLevel::Debug, __FILE__, __LINE__, __FUNCTION__)
+#if MITK_LOG_MINIMUM_LEVEL <= MITK_LOG_LEVEL_DEBUG
+#define MITK_DEBUG MITK_LOG_STREAM_(Debug)
 #else
-#define MITK_DEBUG true ? mitk::NullLogStream() : mitk::NullLogStream()
+#define MITK_DEBUG MITK_NULL_LOG_STREAM_
 #endif
 
 #endif
@@ -13,19 +13,359 @@ found in the LICENSE file.
 #include <mitkLog.h>
 #include <mitkLogBackendCout.h>
 
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
 #include <list>
+#include <memory>
+#include <mutex>
+#include <optional>
 #include <set>
+#include <thread>
 
-static std::list<mitk::LogBackendBase*> backends;
-static std::set<mitk::LogBackendBase::OutputType> disabledBackendTypes;
+namespace
+{
+  /** \brief Bounded lock-free multi-producer single-consumer queue of log messages.
+   *
+   * Each cell carries a sequence number that tells producers and the consumer whether the
+   * cell is free for writing or ready for reading (D. Vyukov's bounded MPMC queue layout).
+   * The capacity is rounded up to the next power of two.
+   */
+  class LogMessageQueue
+  {
+  public:
+    explicit LogMessageQueue(std::size_t capacity)
+      : m_Mask(0),
+        m_EnqueuePosition(0),
+        m_DequeuePosition(0)
+    {
+      std::size_t size = 2;
+      while (size < capacity)
+        size <<= 1;
+
+      m_Mask = size - 1;
+      m_Cells.reset(new Cell[size]);
+
+      for (std::size_t i = 0; i < size; ++i)
+        m_Cells[i].Sequence.store(i, std::memory_order_relaxed);
+    }
+
+    bool TryPush(mitk::LogMessage& message)
+    {
+      Cell* cell = nullptr;
+      auto position = m_EnqueuePosition.load(std::memory_order_relaxed);
+
+      for (;;)
+      {
+        cell = &m_Cells[position & m_Mask];
+        auto sequence = cell->Sequence.load(std::memory_order_acquire);
+        auto difference = static_cast<std::intptr_t>(sequence) - static_cast<std::intptr_t>(position);
+
+        if (difference == 0)
+        {
+          if (m_EnqueuePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+            break;
+        }
+        else if (difference < 0)
+        {
+          return false; // Queue is full
+        }
+        else
+        {
+          position = m_EnqueuePosition.load(std::memory_order_relaxed);
+        }
+      }
+
+      cell->Message.emplace(std::move(message));
+      cell->Sequence.store(position + 1, std::memory_order_release);
+
+      return true;
+    }
+
+    /** \brief Must only be called by the single consumer thread.
+     */
+    bool TryPop(std::optional<mitk::LogMessage>& message)
+    {
+      auto position = m_DequeuePosition.load(std::memory_order_relaxed);
+      Cell* cell = &m_Cells[position & m_Mask];
+      auto sequence = cell->Sequence.load(std::memory_order_acquire);
+
+      if (static_cast<std::intptr_t>(sequence) - static_cast<std::intptr_t>(position + 1) < 0)
+        return false; // Queue is empty
+
+      m_DequeuePosition.store(position + 1, std::memory_order_relaxed);
+
+      message.emplace(std::move(*cell->Message));
+      cell->Message.reset();
+      cell->Sequence.store(position + m_Mask + 1, std::memory_order_release);
+
+      return true;
+    }
+
+  private:
+    struct Cell
+    {
+      std::atomic<std::size_t> Sequence;
+      std::optional<mitk::LogMessage> Message;
+    };
+
+    std::unique_ptr<Cell[]> m_Cells;
+    std::size_t m_Mask;
+    alignas(64) std::atomic<std::size_t> m_EnqueuePosition;
+    alignas(64) std::atomic<std::size_t> m_DequeuePosition;
+  };
+
+  std::list<mitk::LogBackendBase*> backends;
+  std::set<mitk::LogBackendBase::OutputType> disabledBackendTypes;
+
+  // Recursive, since backends may log themselves while processing a message.
+  std::recursive_mutex backendsMutex;
+
+  void ProcessMessageInBackends(const mitk::LogMessage& message)
+  {
+    std::lock_guard<std::recursive_mutex> lock(backendsMutex);
+
+    // create dummy backend if there is no backend registered (so we have an output anyway)
+    static mitk::LogBackendCout* dummyBackend = nullptr;
+
+    if (backends.empty() && dummyBackend == nullptr)
+    {
+      dummyBackend = new mitk::LogBackendCout;
+      backends.push_back(dummyBackend);
+    }
+    else if (backends.size() > 1 && dummyBackend != nullptr)
+    {
+      // if there was added another backend remove the dummy backend and delete it
+      backends.remove(dummyBackend);
+      delete dummyBackend;
+      dummyBackend = nullptr;
+    }
+
+    // iterate through all registered images and call the ProcessMessage() methods of the backends
+    for (auto i = backends.begin(); i != backends.end(); ++i)
+    {
+      if (disabledBackendTypes.find((*i)->GetOutputType()) == disabledBackendTypes.end())
+        (*i)->ProcessMessage(message);
+    }
+  }
+
+  /** \brief State of the asynchronous log mechanism.
+   *
+   * Producers only touch the queue while they are registered in m_ActiveProducers, which
+   * allows Disable() to wait for them before the worker thread and the queue are released.
+   */
+  class AsynchronousLogging
+  {
+  public:
+    AsynchronousLogging()
+      : m_Enabled(false),
+        m_ActiveProducers(0),
+        m_Policy(mitk::LogOverflowPolicy::Block),
+        m_Stop(false),
+        m_Waiting(false),
+        m_NumberOfPushedMessages(0),
+        m_NumberOfProcessedMessages(0),
+        m_NumberOfDroppedMessages(0)
+    {
+    }
+
+    ~AsynchronousLogging()
+    {
+      this->Disable();
+    }
+
+    void Enable(std::size_t capacity, mitk::LogOverflowPolicy policy)
+    {
+      std::lock_guard<std::mutex> lock(m_ControlMutex);
+
+      this->DisableUnlocked();
+
+      m_Queue = std::make_unique<LogMessageQueue>(capacity);
+      m_Policy = policy;
+      m_Stop = false;
+      m_Thread = std::thread(&AsynchronousLogging::Run, this);
+
+      m_Enabled.store(true);
+    }
+
+    void Disable()
+    {
+      std::lock_guard<std::mutex> lock(m_ControlMutex);
+      this->DisableUnlocked();
+    }
+
+    bool IsEnabled() const
+    {
+      return m_Enabled.load();
+    }
+
+    /** \brief Returns false if the message must be processed synchronously by the caller.
+     */
+    bool Push(mitk::LogMessage& message)
+    {
+      if (!m_Enabled.load())
+        return false;
+
+      // Messages emitted by backends while being called from the worker thread are processed
+      // right away, since waiting for the worker thread would dead-lock.
+      if (std::this_thread::get_id() == m_ThreadId.load())
+        return false;
+
+      m_ActiveProducers.fetch_add(1);
+
+      if (!m_Enabled.load())
+      {
+        m_ActiveProducers.fetch_sub(1);
+        return false;
+      }
+
+      if (m_Queue->TryPush(message))
+      {
+        m_NumberOfPushedMessages.fetch_add(1);
+      }
+      else if (m_Policy == mitk::LogOverflowPolicy::Drop)
+      {
+        m_NumberOfDroppedMessages.fetch_add(1, std::memory_order_relaxed);
+      }
+      else
+      {
+        do
+        {
+          this->WakeUp();
+          std::this_thread::yield();
+        } while (!m_Queue->TryPush(message));
+
+        m_NumberOfPushedMessages.fetch_add(1);
+      }
+
+      this->WakeUp();
+      m_ActiveProducers.fetch_sub(1);
+
+      return true;
+    }
+
+    void Flush()
+    {
+      if (!m_Enabled.load() || std::this_thread::get_id() == m_ThreadId.load())
+        return;
+
+      const auto numberOfPushedMessages = m_NumberOfPushedMessages.load();
+
+      while (m_NumberOfProcessedMessages.load() < numberOfPushedMessages)
+      {
+        this->WakeUp();
+        std::this_thread::yield();
+      }
+    }
+
+    std::size_t GetNumberOfDroppedMessages() const
+    {
+      return m_NumberOfDroppedMessages.load(std::memory_order_relaxed);
+    }
+
+  private:
+    void DisableUnlocked()
+    {
+      if (!m_Thread.joinable())
+        return;
+
+      m_Enabled.store(false);
+
+      while (m_ActiveProducers.load() != 0)
+        std::this_thread::yield();
+
+      {
+        std::lock_guard<std::mutex> lock(m_WaitMutex);
+        m_Stop = true;
+      }
+
+      m_Condition.notify_one();
+      m_Thread.join();
+      m_Queue.reset();
+    }
+
+    void WakeUp()
+    {
+      if (m_Waiting.load())
+        m_Condition.notify_one();
+    }
+
+    void Run()
+    {
+      m_ThreadId.store(std::this_thread::get_id());
+
+      std::optional<mitk::LogMessage> message;
+
+      for (;;)
+      {
+        while (m_Queue->TryPop(message))
+        {
+          ProcessMessageInBackends(*message);
+          message.reset();
+          m_NumberOfProcessedMessages.fetch_add(1);
+        }
+
+        std::unique_lock<std::mutex> lock(m_WaitMutex);
+
+        if (m_Stop)
+        {
+          // Producers are gone at this point, so one last pass drains the queue for good.
+          lock.unlock();
+
+          while (m_Queue->TryPop(message))
+          {
+            ProcessMessageInBackends(*message);
+            message.reset();
+            m_NumberOfProcessedMessages.fetch_add(1);
+          }
+
+          break;
+        }
+
+        // Producers notify without locking, hence the timeout as a safety net for missed wake-ups.
+        m_Waiting.store(true);
+        m_Condition.wait_for(lock, std::chrono::milliseconds(10));
+        m_Waiting.store(false);
+      }
+
+      m_ThreadId.store(std::thread::id());
+    }
+
+    std::atomic<bool> m_Enabled;
+    std::atomic<std::size_t> m_ActiveProducers;
+    std::unique_ptr<LogMessageQueue> m_Queue;
+    mitk::LogOverflowPolicy m_Policy;
+
+    std::mutex m_ControlMutex;
+    std::thread m_Thread;
+    std::atomic<std::thread::id> m_ThreadId;
+
+    std::mutex m_WaitMutex;
+    std::condition_variable m_Condition;
+    bool m_Stop;
+    std::atomic<bool> m_Waiting;
+
+    std::atomic<std::size_t> m_NumberOfPushedMessages;
+    std::atomic<std::size_t> m_NumberOfProcessedMessages;
+    std::atomic<std::size_t> m_NumberOfDroppedMessages;
+  };
+
+  AsynchronousLogging asynchronousLogging;
+}
 
 void mitk::RegisterBackend(LogBackendBase* backend)
 {
+  std::lock_guard<std::recursive_mutex> lock(backendsMutex);
   backends.push_back(backend);
 }
 
 void mitk::UnregisterBackend(LogBackendBase* backend)
 {
+  // Messages that are still queued might be addressed to this backend.
+  asynchronousLogging.Flush();
+
+  std::lock_guard<std::recursive_mutex> lock(backendsMutex);
   backends.remove(backend);
 }
 
@@ -40,41 +380,58 @@ void mitk::DistributeToBackends(LogMessage& message)
       : "";
   }
 
-  // create dummy backend if there is no backend registered (so we have an output anyway)
-  static LogBackendCout* dummyBackend = nullptr;
-
-  if (backends.empty() && dummyBackend == nullptr)
+  if (message.Level == LogLevel::Fatal)
   {
-    dummyBackend = new LogBackendCout;
-    RegisterBackend(dummyBackend);
+    // Fatal messages are usually followed by a crash, so make sure everything is written out
+    asynchronousLogging.Flush();
   }
-  else if (backends.size() > 1 && dummyBackend != nullptr)
+  else if (asynchronousLogging.Push(message))
   {
-    // if there was added another backend remove the dummy backend and delete it
-    UnregisterBackend(dummyBackend);
-    delete dummyBackend;
-    dummyBackend = nullptr;
+    return;
   }
 
-  // iterate through all registered images and call the ProcessMessage() methods of the backends
-  for (auto i = backends.begin(); i != backends.end(); ++i)
-  {
-    if (IsBackendEnabled((*i)->GetOutputType()))
-      (*i)->ProcessMessage(message);
-  }
+  ProcessMessageInBackends(message);
 }
 
 void mitk::EnableBackends(LogBackendBase::OutputType type)
 {
+  std::lock_guard<std::recursive_mutex> lock(backendsMutex);
   disabledBackendTypes.erase(type);
 }
 
 void mitk::DisableBackends(LogBackendBase::OutputType type)
 {
+  std::lock_guard<std::recursive_mutex> lock(backendsMutex);
   disabledBackendTypes.insert(type);
 }
 
 bool mitk::IsBackendEnabled(LogBackendBase::OutputType type)
 {
+  std::lock_guard<std::recursive_mutex> lock(backendsMutex);
   return disabledBackendTypes.find(type) == disabledBackendTypes.end();
 }
+
+void mitk::EnableAsynchronousLogging(std::size_t queueCapacity, LogOverflowPolicy policy)
+{
+  asynchronousLogging.Enable(queueCapacity, policy);
+}
+
+void mitk::DisableAsynchronousLogging()
+{
+  asynchronousLogging.Disable();
+}
+
+bool mitk::IsAsynchronousLoggingEnabled()
+{
+  return asynchronousLogging.IsEnabled();
+}
+
+void mitk::FlushLog()
+{
+  asynchronousLogging.Flush();
+}
+
+std::size_t mitk::GetNumberOfDroppedLogMessages()
+{
+  return asynchronousLogging.GetNumberOfDroppedMessages();
+}
@@ -15,6 +15,7 @@ found in the LICENSE file.
 
 #include <string>
 #include <map>
+#include <vector>
 
 #include "mitkExceptionMacro.h"
 
@@ -102,6 +103,105 @@ namespace mitk
     /*! @brief Map that holds the values that will replace the variables during evaluation. */
     const VariableMapType* m_Variables;
   };
+
+  /*!
+   *	@brief		Pre-compiled representation of a formula string that can be understood by
+   *				the FormulaParser.
+   *	@details	The formula is parsed only once (on construction) with the same grammar
+   *				as the FormulaParser and translated into a compact stack program. Variables
+   *				are resolved to slots (their index in the list of variable names passed to
+   *				the constructor), so evaluating the formula requires neither string
+   *				operations nor look-ups in a map. Constant sub-expressions are folded during
+   *				compilation.
+   *
+   *				Use this class instead of FormulaParser::parse whenever the same formula has
+   *				to be evaluated many times with changing variable values (e.g. for every
+   *				time point of a model function). With @ref CompiledFormula::evaluateSeries
+   *				the formula is evaluated for a whole series of values of one variable in
+   *				one call.
+   *
+   *				Instances are immutable after construction; evaluating them concurrently
+   *				from several threads is therefore safe.
+   */
+  class MITKMODELFIT_EXPORT CompiledFormula
+  {
+  public:
+    using ValueType = FormulaParser::ValueType;
+    using VariableNamesType = std::vector<std::string>;
+    using VariableValuesType = std::vector<ValueType>;
+    using UnaryFunctionType = ValueType(*)(ValueType);
+
+    /*!
+     *	@brief					Compiles the @b input string.
+     *	@param[in] input		The formula string to be compiled.
+     *	@param[in] variableNames	Names of all variables that may be used in the formula.
+     *							The position of a name in the vector defines its slot,
+     *							i.e. the index of its value when the formula is evaluated.
+     *	@throw FormulaParserException	In the same cases as FormulaParser::parse.
+     */
+    CompiledFormula(const std::string& input, const VariableNamesType& variableNames);
+
+    /*!
+     *	@brief				Evaluates the formula with the given variable values.
+     *	@param[in] values	The values of the variables ordered by their slots. Must contain
+     *						at least @ref getNumberOfVariables elements.
+     */
+    ValueType evaluate(const VariableValuesType& values) const;
+
+    /*!
+     *	@brief				Evaluates the formula for every element of @b series.
+     *	@details			The variable of slot @b seriesSlot is set to the respective element
+     *						of @b series, all other variables are taken from @b values. The
+     *						program is executed instruction by instruction over the whole
+     *						series, which keeps the inner loops tight and vectorizable.
+     *	@param[in] values	The values of the variables ordered by their slots. The value of
+     *						@b seriesSlot is ignored.
+     *	@param[in] seriesSlot	Slot of the variable that is taken from @b series.
+     *	@param[in] series	Pointer to @b count values of the series variable.
+     *	@param[in] count	Number of elements of @b series and @b result.
+     *	@param[out] result	Pointer to the memory (@b count values) the results are written to.
+     */
+    void evaluateSeries(const VariableValuesType& values, std::size_t seriesSlot,
+      const ValueType* series, std::size_t count, ValueType* result) const;
+
+    /*! @brief Returns the formula string the instance was compiled from. */
+    const std::string& getFormula() const;
+
+    /*! @brief Returns the number of variable slots that are expected by the evaluate methods. */
+    std::size_t getNumberOfVariables() const;
+
+    /*! @brief Operation codes of the compiled stack program. */
+    enum class OpCode
+    {
+      Constant,
+      Variable,
+      Add,
+      Subtract,
+      Multiply,
+      Divide,
+      Power,
+      Negate,
+      Function
+    };
+
+    /*! @brief One instruction of the compiled stack program. */
+    struct Instruction
+    {
+      OpCode op;
+      ValueType constant;
+      std::size_t slot;
+      UnaryFunctionType function;
+    };
+
+    using ProgramType = std::vector<Instruction>;
+
+  private:
+    std::string m_Formula;
+    std::size_t m_NumberOfVariables;
+    ProgramType m_Program;
+    /*! @brief Maximum depth of the evaluation stack the program needs. */
+    std::size_t m_StackDepth;
+  };
 }
 
 #endif
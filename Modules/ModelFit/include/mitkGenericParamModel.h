@@ -14,6 +14,10 @@ found in the LICENSE file.
 #define mitkGenericParamModel_h
 
 #include "mitkModelBase.h"
+#include "mitkFormulaParser.h"
+
+#include <memory>
+#include <mutex>
 
 #include "MitkModelFitExports.h"
 
@@ -33,7 +37,11 @@ namespace mitk
 
   Remark: The variable "x" is reserved. It is the signal position / timepoint.
   Remark: The current version supports up to 10 model parameter.
-  Don't use it for a model parameter that should be deduced by fitting (these are a..j).*/
+  Don't use it for a model parameter that should be deduced by fitting (these are a..j).
+  Remark: The function string is only parsed once. The model keeps a compiled version of it
+  (see CompiledFormula) that is evaluated for the whole time grid in one call. The compiled
+  formula can also be passed in (e.g. by the GenericParamModelParameterizer) so that it is shared
+  by all model instances of a fit.*/
   class MITKMODELFIT_EXPORT GenericParamModel : public mitk::ModelBase
   {
 
@@ -60,7 +68,25 @@ namespace mitk
     std::string GetModelType() const override;
 
     FunctionStringType GetFunctionString() const override;
-    itkSetStringMacro(FunctionString);
+    void SetFunctionString(const FunctionStringType& functionString);
+    void SetFunctionString(const char* functionString);
+
+    using CompiledFormulaConstPointer = std::shared_ptr<const CompiledFormula>;
+
+    /** Sets a precompiled version of the function string. It is only used if it was compiled
+     from the current function string with the variables x and the current parameter names
+     (in this order), otherwise the model compiles the function string itself.*/
+    void SetCompiledFormula(CompiledFormulaConstPointer formula);
+
+    /** Returns the compiled version of the current function string (variables: x followed by
+     the parameter names). It is compiled on demand. This method is thread-safe.
+     @throw FormulaParserException If the function string is invalid.*/
+    CompiledFormulaConstPointer GetCompiledFormula() const;
+
+    /** Helper that compiles the passed function string for a generic param model with the
+     passed number of parameters.
+     @throw FormulaParserException If the function string is invalid.*/
+    static CompiledFormulaConstPointer CompileFunctionString(const FunctionStringType& functionString, ParametersSizeType numberOfParameters);
 
     /**@pre The Number of parameters must be between 1 and 10.*/
     itkSetClampMacro(NumberOfParameters, ParametersSizeType, 1, 10);
@@ -100,6 +126,11 @@ namespace mitk
     /**Number of parameters the model should offer / the function string contains.*/
     ParametersSizeType m_NumberOfParameters;
 
+    /**Cached compiled version of m_FunctionString.*/
+    mutable CompiledFormulaConstPointer m_CompiledFormula;
+    /**Guards m_CompiledFormula, which is filled lazily by the const GetCompiledFormula().*/
+    mutable std::mutex m_CompiledFormulaMutex;
+
     //No copy constructor allowed
     GenericParamModel(const Self& source);
     void operator=(const Self&);  //purposely not implemented
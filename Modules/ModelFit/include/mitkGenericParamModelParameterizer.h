@@ -15,9 +15,14 @@ found in the LICENSE file.
 #include "mitkConcreteModelParameterizerBase.h"
 #include "mitkGenericParamModel.h"
 
+#include <mutex>
+
 namespace mitk
 {
   /** Parameterizer for the GenricParamModel.
+  The function string is compiled only once per parameterizer (see CompiledFormula). All models
+  generated by the parameterizer share this compiled formula, so fitting a whole image does not
+  parse the function string again for every voxel.
   */
   class MITKMODELFIT_EXPORT GenericParamModelParameterizer : public ConcreteModelParameterizerBase
     <GenericParamModel>
@@ -58,6 +63,12 @@ namespace mitk
 
     ParametersType GetDefaultInitialParameterization() const override;
 
+    /** Returns the compiled version of the current function string that is shared by all
+     generated models. It is compiled on demand and recompiled if the function string or the
+     number of parameters changed. This method is thread-safe.
+     @throw FormulaParserException If the function string is invalid.*/
+    GenericParamModel::CompiledFormulaConstPointer GetCompiledFormula() const;
+
   protected:
 
     GenericParamModelParameterizer();
@@ -69,6 +80,10 @@ namespace mitk
     ParametersSizeType m_NumberOfParameters;
 
   private:
+    /**Compiled version of m_FunctionString shared by all generated models.*/
+    mutable GenericParamModel::CompiledFormulaConstPointer m_CompiledFormula;
+    /**Guards m_CompiledFormula, models may be generated concurrently by the fitting threads.*/
+    mutable std::mutex m_CompiledFormulaMutex;
 
     //No copy constructor allowed
     GenericParamModelParameterizer(const Self& source);
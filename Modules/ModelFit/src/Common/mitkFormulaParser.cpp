@@ -15,6 +15,9 @@ found in the LICENSE file.
 #include <boost/spirit/include/phoenix.hpp>
 #include <boost/version.hpp>
 
+#include <algorithm>
+#include <cmath>
+
 #include "mitkFormulaParser.h"
 #include "mitkFresnel.h"
 
@@ -107,6 +110,34 @@ namespace mitk
     return static_cast<T>(fresnel_c(x) / boost::math::constants::root_two_div_pi<T>());
   }
 
+  /*!
+   *	@brief	Helper structure that maps strings to function calls so that parsing e.g.
+   *			@c "cos(0)" actually calls the @c std::cos function with parameter @c 1 so it
+   *			returns @c 0.
+   */
+  class unaryFunction_ :
+    public qi::symbols<typename std::iterator_traits<Iter>::value_type, FormulaParser::ValueType(*)(FormulaParser::ValueType)>
+  {
+  public:
+    /*!
+     *	@brief Constructs the structure, this is where the mapping takes place.
+     */
+    unaryFunction_()
+    {
+      this->add
+      ("abs", static_cast<FormulaParser::ValueType(*)(FormulaParser::ValueType)>(&std::abs))
+        ("exp", static_cast<FormulaParser::ValueType(*)(FormulaParser::ValueType)>(&std::exp)) // @TODO: exp ignores division by zero
+        ("sin", static_cast<FormulaParser::ValueType(*)(FormulaParser::ValueType)>(&std::sin))
+        ("cos", static_cast<FormulaParser::ValueType(*)(FormulaParser::ValueType)>(&std::cos))
+        ("tan", static_cast<FormulaParser::ValueType(*)(FormulaParser::ValueType)>(&std::tan))
+        ("sind", &sind)
+        ("cosd", &cosd)
+        ("tand", &tand)
+        ("fresnelS", &fresnelS)
+        ("fresnelC", &fresnelC);
+    }
+  };
+
   /*!
    *	@brief		The grammar that defines the language (i.e. what is allowed) for the parser.
    */
@@ -154,33 +185,8 @@ namespace mitk
       }
     };
 
-    /*!
-     *	@brief	Helper structure that maps strings to function calls so that parsing e.g.
-     *			@c "cos(0)" actually calls the @c std::cos function with parameter @c 1 so it
-     *			returns @c 0.
-     */
-    class unaryFunction_ :
-      public qi::symbols<typename std::iterator_traits<Iter>::value_type, FormulaParser::ValueType(*)(FormulaParser::ValueType)>
-    {
-    public:
-      /*!
-       *	@brief Constructs the structure, this is where the mapping takes place.
-       */
-      unaryFunction_()
-      {
-        this->add
-        ("abs", static_cast<FormulaParser::ValueType(*)(FormulaParser::ValueType)>(&std::abs))
-          ("exp", static_cast<FormulaParser::ValueType(*)(FormulaParser::ValueType)>(&std::exp)) // @TODO: exp ignores division by zero
-          ("sin", static_cast<FormulaParser::ValueType(*)(FormulaParser::ValueType)>(&std::sin))
-          ("cos", static_cast<FormulaParser::ValueType(*)(FormulaParser::ValueType)>(&std::cos))
-          ("tan", static_cast<FormulaParser::ValueType(*)(FormulaParser::ValueType)>(&std::tan))
-          ("sind", &sind)
-          ("cosd", &cosd)
-          ("tand", &tand)
-          ("fresnelS", &fresnelS)
-          ("fresnelC", &fresnelC);
-      }
-    } unaryFunction;
+    /*! @brief Maps the names of the supported functions to their implementations. */
+    unaryFunction_ unaryFunction;
 
   public:
     /*!
@@ -235,6 +241,157 @@ namespace mitk
   };
 
 
+  /*!
+   *	@brief	Collects the instructions of a CompiledFormula while the CompilerGrammar
+   *			walks over the input. Variables are resolved to their slots and constant
+   *			sub-expressions are folded on the fly.
+   */
+  class FormulaProgramBuilder
+  {
+  public:
+    using OpCode = CompiledFormula::OpCode;
+    using Instruction = CompiledFormula::Instruction;
+
+    FormulaProgramBuilder(const CompiledFormula::VariableNamesType& variableNames)
+      : m_VariableNames(variableNames)
+    {}
+
+    void pushConstant(FormulaParser::ValueType value)
+    {
+      m_Program.push_back({ OpCode::Constant, value, 0, nullptr });
+    }
+
+    void pushVariable(const std::string& name)
+    {
+      auto finding = std::find(m_VariableNames.begin(), m_VariableNames.end(), name);
+      if (finding == m_VariableNames.end())
+      {
+        mitkThrowException(FormulaParserException) << "No variable '" << name << "' defined in lookup";
+      }
+
+      const std::size_t slot = static_cast<std::size_t>(std::distance(m_VariableNames.begin(), finding));
+      m_Program.push_back({ OpCode::Variable, 0., slot, nullptr });
+    }
+
+    void pushUnary(OpCode op, CompiledFormula::UnaryFunctionType function)
+    {
+      if (!m_Program.empty() && m_Program.back().op == OpCode::Constant)
+      {
+        auto& operand = m_Program.back().constant;
+        operand = (op == OpCode::Negate) ? -operand : function(operand);
+      }
+      else
+      {
+        m_Program.push_back({ op, 0., 0, function });
+      }
+    }
+
+    void pushNegate()
+    {
+      this->pushUnary(OpCode::Negate, nullptr);
+    }
+
+    void pushFunction(CompiledFormula::UnaryFunctionType function)
+    {
+      this->pushUnary(OpCode::Function, function);
+    }
+
+    void pushBinary(OpCode op)
+    {
+      const auto size = m_Program.size();
+      if (size >= 2 && m_Program[size - 1].op == OpCode::Constant && m_Program[size - 2].op == OpCode::Constant)
+      {
+        m_Program[size - 2].constant = applyBinary(op, m_Program[size - 2].constant, m_Program[size - 1].constant);
+        m_Program.pop_back();
+      }
+      else
+      {
+        m_Program.push_back({ op, 0., 0, nullptr });
+      }
+    }
+
+    static FormulaParser::ValueType applyBinary(OpCode op, FormulaParser::ValueType lhs, FormulaParser::ValueType rhs)
+    {
+      switch (op)
+      {
+        case OpCode::Add: return lhs + rhs;
+        case OpCode::Subtract: return lhs - rhs;
+        case OpCode::Multiply: return lhs * rhs;
+        case OpCode::Divide: return lhs / rhs;
+        case OpCode::Power: return std::pow(lhs, rhs);
+        default: mitkThrowException(FormulaParserException) << "Invalid binary operation in compiled formula.";
+      }
+    }
+
+    const CompiledFormula::ProgramType& getProgram() const
+    {
+      return m_Program;
+    }
+
+  private:
+    const CompiledFormula::VariableNamesType& m_VariableNames;
+    CompiledFormula::ProgramType m_Program;
+  };
+
+  /*!
+   *	@brief		Grammar of the CompiledFormula. It accepts exactly the same language as
+   *				Grammar, but instead of computing the value it emits instructions into a
+   *				FormulaProgramBuilder.
+   */
+  class CompilerGrammar : public qi::grammar<Iter, Skipper>
+  {
+    /*! @brief Maps the names of the supported functions to their implementations. */
+    unaryFunction_ unaryFunction;
+
+  public:
+    /*!
+     *	@brief						Constructs the grammar with the given program builder.
+     *	@param[in, out] builder		The builder the instructions are emitted to.
+     */
+    CompilerGrammar(FormulaProgramBuilder& builder) : CompilerGrammar::base_type(start)
+    {
+      using qi::_1;
+      using qi::char_;
+      using qi::alpha;
+      using qi::alnum;
+      using qi::double_;
+      using qi::as_string;
+      using OpCode = CompiledFormula::OpCode;
+
+      start = expression > qi::eoi;
+
+      expression = term
+        >> *(('+' >> term)[phx::bind(&FormulaProgramBuilder::pushBinary, &builder, OpCode::Add)]
+          | ('-' >> term)[phx::bind(&FormulaProgramBuilder::pushBinary, &builder, OpCode::Subtract)]);
+
+      term = factor
+        >> *(('*' >> factor)[phx::bind(&FormulaProgramBuilder::pushBinary, &builder, OpCode::Multiply)]
+          | ('/' >> factor)[phx::bind(&FormulaProgramBuilder::pushBinary, &builder, OpCode::Divide)]);
+
+      factor = primary
+        >> *(('^' >> primary)[phx::bind(&FormulaProgramBuilder::pushBinary, &builder, OpCode::Power)]);
+
+      variable = as_string[alpha >> *(alnum | char_('_'))]
+        [phx::bind(&FormulaProgramBuilder::pushVariable, &builder, _1)];
+
+      primary = double_[phx::bind(&FormulaProgramBuilder::pushConstant, &builder, _1)]
+        | '(' >> expression >> ')'
+        | ('-' >> primary)[phx::bind(&FormulaProgramBuilder::pushNegate, &builder)]
+        | ('+' >> primary)
+        | (unaryFunction >> '(' >> expression >> ')')[phx::bind(&FormulaProgramBuilder::pushFunction, &builder, _1)]
+        | variable;
+    }
+
+    /*! the rules of the grammar. */
+    qi::rule<Iter, Skipper> start;
+    qi::rule<Iter, Skipper> expression;
+    qi::rule<Iter, Skipper> term;
+    qi::rule<Iter, Skipper> factor;
+    qi::rule<Iter, Skipper> variable;
+    qi::rule<Iter, Skipper> primary;
+  };
+
+
   FormulaParser::FormulaParser(const VariableMapType* variables) : m_Variables(variables)
   {}
 
@@ -284,4 +441,194 @@ namespace mitk
     }
   };
 
+  CompiledFormula::CompiledFormula(const std::string& input, const VariableNamesType& variableNames)
+    : m_Formula(input), m_NumberOfVariables(variableNames.size()), m_StackDepth(0)
+  {
+    std::string::const_iterator iter = input.begin();
+    std::string::const_iterator end = input.end();
+    FormulaProgramBuilder builder(variableNames);
+
+    try
+    {
+      if (!qi::phrase_parse(iter, end, CompilerGrammar(builder), ascii::space))
+      {
+        mitkThrowException(FormulaParserException) << "Could not parse '" << input <<
+          "': Grammar could not be applied to the input " << "at all.";
+      }
+    }
+    catch (qi::expectation_failure<Iter>& e)
+    {
+      std::string parsed = "";
+
+      for (Iter i = input.begin(); i != e.first; i++)
+      {
+        parsed += *i;
+      }
+      mitkThrowException(FormulaParserException) << "Error while parsing '" << input <<
+        "': Unexpected character '" << *e.first << "' after '" << parsed << "'";
+    }
+
+    m_Program = builder.getProgram();
+
+    // Validate the program and determine the stack depth that is needed to evaluate it.
+    std::size_t depth = 0;
+    for (const auto& instruction : m_Program)
+    {
+      switch (instruction.op)
+      {
+        case OpCode::Constant:
+        case OpCode::Variable:
+          ++depth;
+          m_StackDepth = std::max(m_StackDepth, depth);
+          break;
+        case OpCode::Negate:
+        case OpCode::Function:
+          if (depth < 1)
+          {
+            mitkThrowException(FormulaParserException) << "Invalid program generated for '" << input << "'";
+          }
+          break;
+        default:
+          if (depth < 2)
+          {
+            mitkThrowException(FormulaParserException) << "Invalid program generated for '" << input << "'";
+          }
+          --depth;
+      }
+    }
+
+    if (depth != 1)
+    {
+      mitkThrowException(FormulaParserException) << "Invalid program generated for '" << input << "'";
+    }
+  }
+
+  CompiledFormula::ValueType CompiledFormula::evaluate(const VariableValuesType& values) const
+  {
+    if (values.size() < m_NumberOfVariables)
+    {
+      mitkThrowException(FormulaParserException) << "Not enough variable values passed to evaluate '" << m_Formula << "'";
+    }
+
+    std::vector<ValueType> stack(m_StackDepth);
+    std::size_t top = 0;
+
+    for (const auto& instruction : m_Program)
+    {
+      switch (instruction.op)
+      {
+        case OpCode::Constant:
+          stack[top++] = instruction.constant;
+          break;
+        case OpCode::Variable:
+          stack[top++] = values[instruction.slot];
+          break;
+        case OpCode::Negate:
+          stack[top - 1] = -stack[top - 1];
+          break;
+        case OpCode::Function:
+          stack[top - 1] = instruction.function(stack[top - 1]);
+          break;
+        default:
+          --top;
+          stack[top - 1] = FormulaProgramBuilder::applyBinary(instruction.op, stack[top - 1], stack[top]);
+      }
+    }
+
+    return stack[0];
+  }
+
+  void CompiledFormula::evaluateSeries(const VariableValuesType& values, std::size_t seriesSlot,
+    const ValueType* series, std::size_t count, ValueType* result) const
+  {
+    if (values.size() < m_NumberOfVariables)
+    {
+      mitkThrowException(FormulaParserException) << "Not enough variable values passed to evaluate '" << m_Formula << "'";
+    }
+
+    if (count == 0)
+    {
+      return;
+    }
+
+    // Every stack entry is a whole row of count values; each instruction is applied
+    // to the complete row before the next instruction is processed.
+    std::vector<ValueType> stack(m_StackDepth * count);
+    std::size_t top = 0;
+
+    for (const auto& instruction : m_Program)
+    {
+      switch (instruction.op)
+      {
+        case OpCode::Constant:
+          std::fill_n(stack.data() + top * count, count, instruction.constant);
+          ++top;
+          break;
+        case OpCode::Variable:
+          if (instruction.slot == seriesSlot)
+          {
+            std::copy(series, series + count, stack.data() + top * count);
+          }
+          else
+          {
+            std::fill_n(stack.data() + top * count, count, values[instruction.slot]);
+          }
+          ++top;
+          break;
+        case OpCode::Negate:
+        {
+          ValueType* operand = stack.data() + (top - 1) * count;
+          for (std::size_t i = 0; i < count; ++i)
+          {
+            operand[i] = -operand[i];
+          }
+          break;
+        }
+        case OpCode::Function:
+        {
+          ValueType* operand = stack.data() + (top - 1) * count;
+          for (std::size_t i = 0; i < count; ++i)
+          {
+            operand[i] = instruction.function(operand[i]);
+          }
+          break;
+        }
+        default:
+        {
+          --top;
+          ValueType* lhs = stack.data() + (top - 1) * count;
+          const ValueType* rhs = stack.data() + top * count;
+          switch (instruction.op)
+          {
+            case OpCode::Add:
+              for (std::size_t i = 0; i < count; ++i) lhs[i] += rhs[i];
+              break;
+            case OpCode::Subtract:
+              for (std::size_t i = 0; i < count; ++i) lhs[i] -= rhs[i];
+              break;
+            case OpCode::Multiply:
+              for (std::size_t i = 0; i < count; ++i) lhs[i] *= rhs[i];
+              break;
+            case OpCode::Divide:
+              for (std::size_t i = 0; i < count; ++i) lhs[i] /= rhs[i];
+              break;
+            default:
+              for (std::size_t i = 0; i < count; ++i) lhs[i] = std::pow(lhs[i], rhs[i]);
+          }
+        }
+      }
+    }
+
+    std::copy(stack.begin(), stack.begin() + count, result);
+  }
+
+  const std::string& CompiledFormula::getFormula() const
+  {
+    return m_Formula;
+  }
+
+  std::size_t CompiledFormula::getNumberOfVariables() const
+  {
+    return m_NumberOfVariables;
+  }
 }
@@ -11,7 +11,6 @@ found in the LICENSE file.
 ============================================================================*/
 
 #include "mitkGenericParamModel.h"
-#include "mitkFormulaParser.h"
 
 const std::string mitk::GenericParamModel::NAME_STATIC_PARAMETER_number = "number_of_parameters";
 
@@ -30,6 +29,57 @@ mitk::GenericParamModel::FunctionStringType mitk::GenericParamModel::GetFunction
   return m_FunctionString;
 };
 
+void mitk::GenericParamModel::SetFunctionString(const FunctionStringType& functionString)
+{
+  if (m_FunctionString != functionString)
+  {
+    m_FunctionString = functionString;
+    {
+      std::lock_guard<std::mutex> lock(m_CompiledFormulaMutex);
+      m_CompiledFormula.reset();
+    }
+    this->Modified();
+  }
+};
+
+void mitk::GenericParamModel::SetFunctionString(const char* functionString)
+{
+  this->SetFunctionString(FunctionStringType(functionString ? functionString : ""));
+};
+
+void mitk::GenericParamModel::SetCompiledFormula(CompiledFormulaConstPointer formula)
+{
+  std::lock_guard<std::mutex> lock(m_CompiledFormulaMutex);
+  m_CompiledFormula = formula;
+};
+
+mitk::GenericParamModel::CompiledFormulaConstPointer
+mitk::GenericParamModel::GetCompiledFormula() const
+{
+  std::lock_guard<std::mutex> lock(m_CompiledFormulaMutex);
+
+  if (!m_CompiledFormula || m_CompiledFormula->getFormula() != m_FunctionString
+      || m_CompiledFormula->getNumberOfVariables() != m_NumberOfParameters + 1)
+  {
+    m_CompiledFormula = CompileFunctionString(m_FunctionString, m_NumberOfParameters);
+  }
+
+  return m_CompiledFormula;
+};
+
+mitk::GenericParamModel::CompiledFormulaConstPointer
+mitk::GenericParamModel::CompileFunctionString(const FunctionStringType& functionString, ParametersSizeType numberOfParameters)
+{
+  auto model = GenericParamModel::New();
+  model->SetNumberOfParameters(numberOfParameters);
+
+  CompiledFormula::VariableNamesType variableNames = { model->GetXName() };
+  auto paramNames = model->GetParameterNames();
+  variableNames.insert(variableNames.end(), paramNames.begin(), paramNames.end());
+
+  return std::make_shared<const CompiledFormula>(functionString, variableNames);
+};
+
 std::string mitk::GenericParamModel::GetXName() const
 {
   return "x";
@@ -71,26 +121,16 @@ mitk::GenericParamModel::ComputeModelfunction(const ParametersType& parameters)
   unsigned int timeSteps = m_TimeGrid.GetSize();
   ModelResultType signal(timeSteps);
 
-  std::map<std::string, double> parameterMap;
-  parameterMap.insert(std::make_pair(GetXName(), 0.0));
+  auto formula = this->GetCompiledFormula();
 
-  auto paramNames = this->GetParameterNames();
-  for (ParametersType::size_type i = 0; i < parameters.size(); ++i)
+  //slot 0 is x, the parameters follow in the order of GetParameterNames()
+  CompiledFormula::VariableValuesType values(formula->getNumberOfVariables(), 0.0);
+  for (ParametersType::size_type i = 0; i < parameters.size() && i + 1 < values.size(); ++i)
   {
-    parameterMap.insert(std::make_pair(paramNames[i], parameters[i]));
+    values[i + 1] = parameters[i];
   }
 
-  FormulaParser formulaParser(&parameterMap);
-
-  TimeGridType::const_iterator timeGridEnd = m_TimeGrid.end();
-  ModelResultType::iterator signalPos = signal.begin();
-
-  for (TimeGridType::const_iterator gridPos = m_TimeGrid.begin(); gridPos != timeGridEnd;
-       ++gridPos, ++signalPos)
-  {
-    parameterMap[GetXName()] = *gridPos;
-    *signalPos = formulaParser.parse(m_FunctionString);
-  }
+  formula->evaluateSeries(values, 0, m_TimeGrid.data_block(), timeSteps, signal.data_block());
 
   return signal;
 };
@@ -138,6 +178,11 @@ itk::LightObject::Pointer mitk::GenericParamModel::InternalClone() const
 
   newClone->SetTimeGrid(this->m_TimeGrid);
   newClone->SetNumberOfParameters(this->m_NumberOfParameters);
+  newClone->SetFunctionString(this->m_FunctionString);
+  {
+    std::lock_guard<std::mutex> lock(m_CompiledFormulaMutex);
+    newClone->SetCompiledFormula(this->m_CompiledFormula);
+  }
 
   return newClone.GetPointer();
 };
@@ -23,9 +23,32 @@ mitk::GenericParamModelParameterizer::ModelBasePointer
   ModelPointer newModel = dynamic_cast<ModelType*>(Superclass::GenerateParameterizedModel(
                             currentPosition).GetPointer());
   newModel->SetFunctionString(m_FunctionString);
+  try
+  {
+    newModel->SetCompiledFormula(this->GetCompiledFormula());
+  }
+  catch (const FormulaParserException&)
+  {
+    //Invalid function strings are reported when the model function is computed, like it is
+    //done by the model itself. Generating models (e.g. to query parameter names) must still work.
+  }
   return newModel.GetPointer();
 };
 
+mitk::GenericParamModel::CompiledFormulaConstPointer
+  mitk::GenericParamModelParameterizer::GetCompiledFormula() const
+{
+  std::lock_guard<std::mutex> lock(m_CompiledFormulaMutex);
+
+  if (!m_CompiledFormula || m_CompiledFormula->getFormula() != m_FunctionString
+      || m_CompiledFormula->getNumberOfVariables() != m_NumberOfParameters + 1)
+  {
+    m_CompiledFormula = ModelType::CompileFunctionString(m_FunctionString, m_NumberOfParameters);
+  }
+
+  return m_CompiledFormula;
+};
+
 mitk::GenericParamModelParameterizer::StaticParameterMapType
   mitk::GenericParamModelParameterizer::GetGlobalStaticParameters() const
 {
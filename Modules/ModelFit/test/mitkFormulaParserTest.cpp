@@ -210,6 +210,49 @@ public:
 
     delete parser;
   }
+
+  static void TestCompiledFormula()
+  {
+    const CompiledFormula::VariableNamesType names = { "x", "test" };
+
+    // invalid input is rejected on compilation
+    MITK_TEST_FOR_EXCEPTION(FormulaParserException, CompiledFormula("", names));
+    MITK_TEST_FOR_EXCEPTION(FormulaParserException, CompiledFormula("_", names));
+    MITK_TEST_FOR_EXCEPTION(FormulaParserException, CompiledFormula("5=", names));
+    MITK_TEST_FOR_EXCEPTION(FormulaParserException, CompiledFormula("a", names));
+
+    std::map<std::string, double> varMap;
+    varMap["test"] = 17;
+    FormulaParser parser(&varMap);
+
+    const std::vector<std::string> formulas = { "-7 + +1 - -1", "(1+2)*(4-2)", "2*test-test",
+      "test*x^2 - exp(-x/test) + sin(x)", "2^x^2", "abs(test - 3*x) / (1 + x)", "fresnelS(x) + cosd(x)" };
+    const std::vector<double> grid = { 0., 0.5, 1., 2.5, 7. };
+    const double eps = 1e-10;
+
+    for (const auto& formula : formulas)
+    {
+      CompiledFormula* compiled = nullptr;
+      TEST_NOTHROW(compiled = new CompiledFormula(formula, names),
+        "Testing if compiling '" << formula << "' throws an unwanted exception");
+
+      std::vector<double> series(grid.size());
+      compiled->evaluateSeries({ 0., 17. }, 0, grid.data(), grid.size(), series.data());
+
+      bool equal = true;
+      for (std::size_t i = 0; i < grid.size(); ++i)
+      {
+        varMap["x"] = grid[i];
+        const double expected = parser.parse(formula);
+        equal = equal && std::abs(compiled->evaluate({ grid[i], 17. }) - expected) < eps
+          && std::abs(series[i] - expected) < eps;
+      }
+      MITK_TEST_CONDITION_REQUIRED(equal,
+        "Testing if compiled formula '" << formula << "' produces the same results as the parser");
+
+      delete compiled;
+    }
+  }
 };
 
 int mitkFormulaParserTest(int, char *[])
@@ -219,6 +262,7 @@ int mitkFormulaParserTest(int, char *[])
   FormulaParserTests::TestConstructor();
   FormulaParserTests::TestLookupVariable();
   FormulaParserTests::TestParse();
+  FormulaParserTests::TestCompiledFormula();
 
   MITK_TEST_END();
 }
@@ -2,6 +2,7 @@ set(MODULE_TESTS
     mitkLabelTest.cpp
     mitkLabelSetImageTest.cpp
     mitkLegacyLabelSetImageIOTest.cpp
+    mitkMultiLabelSegmentationCompressionTest.cpp
     mitkMultiLabelSegmentationIOTest.cpp
     mitkMultiLabelSegmentationStackReaderTest.cpp
     mitkMultiLabelSegmentationStackWriterTest.cpp
@@ -11,6 +11,7 @@ found in the LICENSE file.
 ============================================================================*/
 
 #include <mitkIOUtil.h>
+#include <mitkImagePixelWriteAccessor.h>
 #include <mitkImageStatisticsHolder.h>
 #include <mitkLabelSetImage.h>
 #include <mitkLabelSetImageConverter.h>
@@ -74,6 +75,7 @@ class mitkLabelSetImageTestSuite : public mitk::TestFixture
   MITK_TEST(TestRemoveLayer);
   MITK_TEST(TestRemoveLabels);
   MITK_TEST(TestEraseLabels);
+  MITK_TEST(TestIsEmptyAndCenterOfMass);
   MITK_TEST(TestMergeLabels);
   MITK_TEST(TestCreateLabelMask);
   CPPUNIT_TEST_SUITE_END();
@@ -558,6 +560,71 @@ public:
       m_LabelSetImage->GetGroupImage(0)->GetStatistics()->GetScalarValueMax() == 6);
   }
 
+  void TestIsEmptyAndCenterOfMass()
+  {
+    mitk::Color color;
+    color.Set(1.0f, 0.0f, 0.0f);
+    auto labelValue = m_LabelSetImage->AddLabel("Block", color, 0)->GetValue();
+
+    CPPUNIT_ASSERT_MESSAGE("New label is not empty", m_LabelSetImage->IsEmpty(labelValue));
+
+    auto groupImage = m_LabelSetImage->GetGroupImage(0);
+    {
+      mitk::ImagePixelWriteAccessor<mitk::Label::PixelType, 3> accessor(groupImage);
+      itk::Index<3> index;
+      for (index[2] = 10; index[2] <= 13; ++index[2])
+        for (index[1] = 20; index[1] <= 25; ++index[1])
+          for (index[0] = 30; index[0] <= 31; ++index[0])
+            accessor.SetPixelByIndex(index, labelValue);
+    }
+    groupImage->Modified();
+
+    CPPUNIT_ASSERT_MESSAGE("Label with pixels is empty", !m_LabelSetImage->IsEmpty(labelValue));
+
+    m_LabelSetImage->UpdateCenterOfMass(labelValue);
+    auto centerOfMass = m_LabelSetImage->GetLabel(labelValue)->GetCenterOfMassIndex();
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(30.5, centerOfMass[0], mitk::eps);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(22.5, centerOfMass[1], mitk::eps);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(11.5, centerOfMass[2], mitk::eps);
+
+    m_LabelSetImage->EraseLabel(labelValue);
+    CPPUNIT_ASSERT_MESSAGE("Erased label is not empty", m_LabelSetImage->IsEmpty(labelValue));
+
+    // The index must not hide modifications done after the erasure.
+    {
+      mitk::ImagePixelWriteAccessor<mitk::Label::PixelType, 3> accessor(groupImage);
+      accessor.SetPixelByIndex({{ 1, 2, 3 }}, labelValue);
+    }
+    groupImage->Modified();
+    CPPUNIT_ASSERT_MESSAGE("Label with pixels is empty after erasure", !m_LabelSetImage->IsEmpty(labelValue));
+
+    // Writers that do not call Modified() must not get stale answers either.
+    {
+      mitk::ImagePixelWriteAccessor<mitk::Label::PixelType, 3> accessor(groupImage);
+      accessor.SetPixelByIndex({{ 1, 2, 3 }}, mitk::MultiLabelSegmentation::UNLABELED_VALUE);
+    }
+    CPPUNIT_ASSERT_MESSAGE("Label is not empty after an unannounced write", m_LabelSetImage->IsEmpty(labelValue));
+
+    {
+      mitk::ImagePixelWriteAccessor<mitk::Label::PixelType, 3> accessor(groupImage);
+      accessor.SetPixelByIndex({{ 4, 6, 8 }}, labelValue);
+      accessor.SetPixelByIndex({{ 6, 6, 8 }}, labelValue);
+    }
+    CPPUNIT_ASSERT_MESSAGE("Label is empty after an unannounced write", !m_LabelSetImage->IsEmpty(labelValue));
+
+    m_LabelSetImage->UpdateCenterOfMass(labelValue);
+    centerOfMass = m_LabelSetImage->GetLabel(labelValue)->GetCenterOfMassIndex();
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(5.0, centerOfMass[0], mitk::eps);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(6.0, centerOfMass[1], mitk::eps);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(8.0, centerOfMass[2], mitk::eps);
+
+    // Re-initializing without resetting the labels replaces the group images; the index must follow them.
+    mitk::Image::Pointer previousGroupImage = groupImage;
+    m_LabelSetImage->Initialize(previousGroupImage, false);
+    CPPUNIT_ASSERT_MESSAGE("Group image was not replaced", previousGroupImage.GetPointer() != m_LabelSetImage->GetGroupImage(0));
+    CPPUNIT_ASSERT_MESSAGE("Label is not empty after re-initialization", m_LabelSetImage->IsEmpty(labelValue));
+  }
+
   void TestMergeLabels()
   {
     mitk::Image::Pointer image =
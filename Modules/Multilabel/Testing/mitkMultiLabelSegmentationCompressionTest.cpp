@@ -0,0 +1,212 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include <mitkIOUtil.h>
+#include <mitkImageReadAccessor.h>
+#include <mitkImageWriteAccessor.h>
+#include <mitkLabelSetImage.h>
+#include <mitkNrrdCompression.h>
+
+#include <mitkTestFixture.h>
+#include <mitkTestingMacros.h>
+
+#include <itkImageFileReader.h>
+#include <itkNrrdImageIO.h>
+#include <itksys/SystemTools.hxx>
+
+#include <chrono>
+#include <cstring>
+
+class mitkMultiLabelSegmentationCompressionTestSuite : public mitk::TestFixture
+{
+  CPPUNIT_TEST_SUITE(mitkMultiLabelSegmentationCompressionTestSuite);
+  MITK_TEST(AllCodecsRoundTrip);
+  MITK_TEST(ParallelCodecsWriteStandardNrrd);
+  MITK_TEST(CorruptedBlockTableFallsBack);
+  MITK_TEST(BenchmarkCodecs);
+  CPPUNIT_TEST_SUITE_END();
+
+private:
+  using Codec = mitk::NrrdCompression::Codec;
+  using Level = mitk::NrrdCompression::Level;
+
+  std::string m_TempPath;
+  mitk::MultiLabelSegmentation::Pointer m_Segmentation;
+
+  std::string GetTempFilePath(const std::string& fileName)
+  {
+    return m_TempPath + mitk::IOUtil::GetDirectorySeparator() + fileName;
+  }
+
+  /** Two spherical labels in a 256x256x160 volume, i.e. mostly background like typical segmentations.*/
+  static mitk::MultiLabelSegmentation::Pointer CreateSegmentation()
+  {
+    const unsigned int dimensions[] = { 256, 256, 160 };
+
+    auto referenceImage = mitk::Image::New();
+    referenceImage->Initialize(mitk::MakeScalarPixelType<unsigned char>(), 3, dimensions);
+
+    auto segmentation = mitk::MultiLabelSegmentation::New();
+    segmentation->Initialize(referenceImage);
+    segmentation->AddLabel(mitk::Label::New(1, "Label 1"), 0);
+    segmentation->AddLabel(mitk::Label::New(2, "Label 2"), 0);
+
+    mitk::ImageWriteAccessor accessor(segmentation->GetGroupImage(0));
+    auto data = static_cast<mitk::Label::PixelType*>(accessor.GetData());
+
+    for (unsigned int z = 0; z < dimensions[2]; ++z)
+    {
+      for (unsigned int y = 0; y < dimensions[1]; ++y)
+      {
+        for (unsigned int x = 0; x < dimensions[0]; ++x)
+        {
+          const int dx1 = x - 80, dy1 = y - 100, dz1 = z - 60;
+          const int dx2 = x - 170, dy2 = y - 150, dz2 = z - 100;
+
+          mitk::Label::PixelType value = 0;
+
+          if (dx1 * dx1 + dy1 * dy1 + dz1 * dz1 < 50 * 50)
+            value = 1;
+          else if (dx2 * dx2 + dy2 * dy2 + dz2 * dz2 < 40 * 40)
+            value = 2;
+
+          *data++ = value;
+        }
+      }
+    }
+
+    return segmentation;
+  }
+
+  std::string Save(Codec codec, Level level, const std::string& fileName)
+  {
+    const auto path = GetTempFilePath(fileName);
+
+    mitk::IFileWriter::Options options = {
+      { mitk::NrrdCompression::OPTION_CODEC(), us::Any(mitk::NrrdCompression::GetCodecName(codec)) },
+      { mitk::NrrdCompression::OPTION_LEVEL(), us::Any(mitk::NrrdCompression::GetLevelName(level)) } };
+
+    mitk::IOUtil::Save(m_Segmentation, path, options);
+    return path;
+  }
+
+  bool HasSamePixels(const mitk::MultiLabelSegmentation* segmentation)
+  {
+    mitk::ImageReadAccessor expected(m_Segmentation->GetGroupImage(0));
+    mitk::ImageReadAccessor actual(segmentation->GetGroupImage(0));
+
+    const auto size = m_Segmentation->GetGroupImage(0)->GetPixelType().GetSize() * 256 * 256 * 160;
+    return 0 == std::memcmp(expected.GetData(), actual.GetData(), size);
+  }
+
+public:
+  void setUp() override
+  {
+    m_TempPath = mitk::IOUtil::CreateTemporaryDirectory("mitk-MultiLabelSegmentationCompressionTest-XXXXXX");
+    m_Segmentation = CreateSegmentation();
+  }
+
+  void tearDown() override
+  {
+    m_Segmentation = nullptr;
+    itksys::SystemTools::RemoveADirectory(m_TempPath);
+  }
+
+  void AllCodecsRoundTrip()
+  {
+    for (auto codec : { Codec::Default, Codec::None, Codec::Parallel, Codec::ParallelRunLength })
+    {
+      for (auto level : { Level::Fast, Level::Small })
+      {
+        const auto path = Save(codec, level, "roundtrip.nrrd");
+        auto loaded = mitk::IOUtil::Load<mitk::MultiLabelSegmentation>(path);
+
+        const auto message = mitk::NrrdCompression::GetCodecName(codec) + ", " + mitk::NrrdCompression::GetLevelName(level);
+        CPPUNIT_ASSERT_MESSAGE(message, mitk::Equal(*m_Segmentation, *loaded, mitk::eps, true));
+        CPPUNIT_ASSERT_MESSAGE(message, HasSamePixels(loaded));
+      }
+    }
+  }
+
+  void ParallelCodecsWriteStandardNrrd()
+  {
+    for (auto codec : { Codec::Parallel, Codec::ParallelRunLength })
+    {
+      const auto path = Save(codec, Level::Balanced, "standard.nrrd");
+
+      // Read with ITK only, i.e. without the parallel decompression of MITK
+      using ImageType = itk::Image<mitk::Label::PixelType, 3>;
+      auto reader = itk::ImageFileReader<ImageType>::New();
+      reader->SetImageIO(itk::NrrdImageIO::New());
+      reader->SetFileName(path);
+      reader->Update();
+
+      mitk::ImageReadAccessor expected(m_Segmentation->GetGroupImage(0));
+      const auto numberOfPixels = reader->GetOutput()->GetLargestPossibleRegion().GetNumberOfPixels();
+
+      CPPUNIT_ASSERT_EQUAL(itk::SizeValueType(256 * 256 * 160), numberOfPixels);
+      CPPUNIT_ASSERT(0 == std::memcmp(expected.GetData(), reader->GetOutput()->GetBufferPointer(), numberOfPixels * sizeof(mitk::Label::PixelType)));
+    }
+  }
+
+  void CorruptedBlockTableFallsBack()
+  {
+    std::vector<unsigned char> data(3 * 1024 * 1024 + 5);
+
+    for (std::size_t i = 0; i < data.size(); ++i)
+      data[i] = static_cast<unsigned char>((i / 1000) % 3);
+
+    auto member = mitk::NrrdCompression::Compress(data.data(), data.size(), 6, true);
+    std::vector<unsigned char> result(data.size());
+
+    CPPUNIT_ASSERT(mitk::NrrdCompression::Decompress(member.data(), member.size(), result.data(), result.size()));
+    CPPUNIT_ASSERT(data == result);
+
+    // wrong size
+    CPPUNIT_ASSERT(!mitk::NrrdCompression::Decompress(member.data(), member.size(), result.data(), result.size() - 1));
+
+    // corrupted compressed data is detected by the checksum at the latest
+    member[member.size() / 2] ^= 0x55;
+    CPPUNIT_ASSERT(!mitk::NrrdCompression::Decompress(member.data(), member.size(), result.data(), result.size()));
+  }
+
+  void BenchmarkCodecs()
+  {
+    const double megabytes = 256.0 * 256 * 160 * sizeof(mitk::Label::PixelType) / (1024 * 1024);
+
+    for (auto codec : { Codec::Default, Codec::None, Codec::Parallel, Codec::ParallelRunLength })
+    {
+      for (auto level : { Level::Fast, Level::Balanced, Level::Small })
+      {
+        const auto start = std::chrono::steady_clock::now();
+        const auto path = Save(codec, level, "benchmark.nrrd");
+        const auto saved = std::chrono::steady_clock::now();
+        auto loaded = mitk::IOUtil::Load<mitk::MultiLabelSegmentation>(path);
+        const auto end = std::chrono::steady_clock::now();
+
+        CPPUNIT_ASSERT(HasSamePixels(loaded));
+
+        const auto writeSeconds = std::chrono::duration<double>(saved - start).count();
+        const auto readSeconds = std::chrono::duration<double>(end - saved).count();
+
+        MITK_INFO << mitk::NrrdCompression::GetCodecName(codec) << " (" << mitk::NrrdCompression::GetLevelName(level) << "): "
+                  << itksys::SystemTools::FileLength(path) / 1024 << " KiB, write " << megabytes / writeSeconds
+                  << " MiB/s, read " << megabytes / readSeconds << " MiB/s";
+
+        if (Codec::None == codec)
+          break; // the level is irrelevant
+      }
+    }
+  }
+};
+
+MITK_TEST_SUITE_REGISTRATION(mitkMultiLabelSegmentationCompression)
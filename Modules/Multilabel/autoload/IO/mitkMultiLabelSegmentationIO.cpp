@@ -21,6 +21,7 @@ found in the LICENSE file.
 #include <mitkIPropertyPersistence.h>
 #include <mitkCoreServices.h>
 #include <mitkItkImageIO.h>
+#include <mitkNrrdCompression.h>
 #include <mitkUIDManipulator.h>
 
 // itk
@@ -46,6 +47,7 @@ namespace mitk
     : AbstractFileIO(MultiLabelSegmentation::GetStaticNameOfClass(), MitkMultilabelIOMimeTypes::MULTILABEL_SEGMENTATION_MIMETYPE(), "MITK Multilabel Segmentation")
   {
     this->InitializeDefaultMetaDataKeys();
+    this->SetDefaultWriterOptions(NrrdCompression::CreateWriterOptions(NrrdCompression::Codec::ParallelRunLength));
     AbstractFileWriter::SetRanking(10);
     AbstractFileReader::SetRanking(10);
     this->RegisterService();
@@ -111,12 +113,14 @@ namespace mitk
       // Handle UID
       itk::EncapsulateMetaData<std::string>(nrrdImageIo->GetMetaDataDictionary(), PROPERTY_KEY_UID, input->GetUID());
 
-      // use compression if available
-      nrrdImageIo->UseCompressionOn();
+      auto codec = NrrdCompression::Codec::ParallelRunLength;
+      auto level = NrrdCompression::Level::Balanced;
+      NrrdCompression::GetWriterOptions(this->GetWriterOptions(), codec, level);
+
       nrrdImageIo->SetFileName(path);
 
       ImageReadAccessor imageAccess(inputVector);
-      nrrdImageIo->Write(imageAccess.GetData());
+      NrrdCompression::Write(nrrdImageIo, imageAccess.GetData(), codec, level);
     }
     catch (const std::exception &e)
     {
@@ -10,6 +10,7 @@ set(CPP_FILES
   mitkLabelSetImageToSurfaceThreadedFilter.cpp
   mitkLabelSetImageVtkMapper2D.cpp
   mitkMultiLabelEvents.cpp
+  mitkMultiLabelGroupIndex.cpp
   mitkMultiLabelIOHelper.cpp
   mitkMultilabelObjectFactory.cpp
   mitkMultiLabelPredicateHelper.cpp
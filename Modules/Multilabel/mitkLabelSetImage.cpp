@@ -22,7 +22,6 @@ found in the LICENSE file.
 #include <mitkNodePredicateGeometry.h>
 #include <mitkLabelSetImageHelper.h>
 #include <mitkImageTimeSelector.h>
-#include <itkLabelGeometryImageFilter.h>
 #include <itkCommand.h>
 #include <itkBinaryFunctorImageFilter.h>
 
@@ -172,10 +171,12 @@ void mitk::MultiLabelSegmentation::Initialize(const mitk::Image * templateImage,
   }
   else
   {
-    for (auto& imagePtr : m_GroupContainer)
+    std::lock_guard<std::mutex> indexGuard(m_GroupIndicesMutex);
+    for (std::size_t groupID = 0; groupID < m_GroupContainer.size(); ++groupID)
     {
-      imagePtr = this->GenerateNewGroupImage();
-      ClearImageBuffer(imagePtr);
+      m_GroupContainer[groupID] = this->GenerateNewGroupImage();
+      ClearImageBuffer(m_GroupContainer[groupID]);
+      m_GroupIndices[groupID] = MultiLabelGroupIndex(m_GroupContainer[groupID]);
     }
   }
 
@@ -220,10 +221,12 @@ void mitk::MultiLabelSegmentation::Initialize(const mitk::TimeGeometry* geometry
   }
   else
   {
-    for (auto& imagePtr : m_GroupContainer)
+    std::lock_guard<std::mutex> indexGuard(m_GroupIndicesMutex);
+    for (std::size_t groupID = 0; groupID < m_GroupContainer.size(); ++groupID)
     {
-      imagePtr = this->GenerateNewGroupImage();
-      ClearImageBuffer(imagePtr);
+      m_GroupContainer[groupID] = this->GenerateNewGroupImage();
+      ClearImageBuffer(m_GroupContainer[groupID]);
+      m_GroupIndices[groupID] = MultiLabelGroupIndex(m_GroupContainer[groupID]);
     }
   }
 
@@ -280,6 +283,10 @@ void mitk::MultiLabelSegmentation::RemoveGroup(GroupIndexType indexToDelete)
     m_Groups.erase(m_Groups.begin() + indexToDelete);
     m_GroupToLabelMap.erase(m_GroupToLabelMap.begin() + indexToDelete);
     m_GroupContainer.erase(m_GroupContainer.begin() + indexToDelete);
+    {
+      std::lock_guard<std::mutex> indexGuard(m_GroupIndicesMutex);
+      m_GroupIndices.erase(m_GroupIndices.begin() + indexToDelete);
+    }
 
     //update old indexes in m_LabelToGroupMap to new group indexes
     for (auto& element : m_LabelToGroupMap)
@@ -408,6 +415,10 @@ void mitk::MultiLabelSegmentation::InsertGroup(GroupIndexType groupID, mitk::Ima
 
     // push a new working image for the new group
     m_GroupContainer.insert(m_GroupContainer.begin()+groupID, groupImage);
+    {
+      std::lock_guard<std::mutex> indexGuard(m_GroupIndicesMutex);
+      m_GroupIndices.insert(m_GroupIndices.begin() + groupID, MultiLabelGroupIndex(groupImage));
+    }
 
     m_Groups.insert(m_Groups.begin() + groupID, name);
     m_GroupToLabelMap.insert(m_GroupToLabelMap.begin() + groupID, LabelValueVectorType());
@@ -846,16 +857,47 @@ void mitk::MultiLabelSegmentation::EraseLabel(LabelValueType pixelValue)
     auto groupID = this->GetGroupIndexOfLabel(pixelValue);
 
     mitk::Image* groupImage = this->GetGroupImage(groupID);
+    const auto timeSteps = groupImage->GetTimeSteps();
 
-    if (4 == this->GetDimension())
-    {
-      AccessFixedDimensionByItk_1(groupImage, EraseLabelProcessing, 4, pixelValue);
-    }
-    else
+    std::unique_lock<std::mutex> indexGuard(m_GroupIndicesMutex);
+    auto& groupIndex = m_GroupIndices[groupID];
+
+    // only the bounding boxes of the label have to be visited.
+    for (TimeStepType t = 0; t < timeSteps; ++t)
     {
-      AccessByItk_1(groupImage, EraseLabelProcessing, pixelValue);
+      groupIndex.Update(t);
+      auto entry = groupIndex.GetEntry(pixelValue, t);
+
+      if (nullptr == entry)
+        continue;
+
+      auto region = entry->GetBoundingRegion();
+      auto volume = SelectImageByTimeStep(groupImage, t);
+      ImagePixelWriteAccessor<LabelValueType, 3> accessor(volume);
+      auto pixels = accessor.GetData();
+
+      const std::size_t width = volume->GetDimension(0);
+      const std::size_t height = volume->GetDimension(1);
+      const auto first = region.GetIndex();
+      const auto last = region.GetUpperIndex();
+
+      for (auto z = first[2]; z <= last[2]; ++z)
+      {
+        for (auto y = first[1]; y <= last[1]; ++y)
+        {
+          auto row = pixels + (static_cast<std::size_t>(z) * height + static_cast<std::size_t>(y)) * width;
+          std::replace(row + first[0], row + last[0] + 1, pixelValue, UNLABELED_VALUE);
+        }
+      }
     }
+
+    // Modified() may trigger observers that use the label index, so the lock is released meanwhile.
+    indexGuard.unlock();
     groupImage->Modified();
+    indexGuard.lock();
+
+    for (TimeStepType t = 0; t < timeSteps; ++t)
+      m_GroupIndices[groupID].RemoveLabel(pixelValue, t);
   }
   catch (const itk::ExceptionObject& e)
   {
@@ -987,35 +1029,41 @@ const mitk::Label* mitk::MultiLabelSegmentation::GetActiveLabel() const
 void mitk::MultiLabelSegmentation::UpdateCenterOfMass(LabelValueType pixelValue)
 {
   if (4 == this->GetDimension())
+    return;
+
+  auto groupID = this->GetGroupIndexOfLabel(pixelValue);
+
+  mitk::Point3D pos;
   {
-    AccessFixedDimensionByItk_1(this->GetGroupImage(this->GetGroupIndexOfLabel(pixelValue)), CalculateCenterOfMassProcessing, 4, pixelValue);
+    std::lock_guard<std::mutex> indexGuard(m_GroupIndicesMutex);
+    auto& groupIndex = m_GroupIndices[groupID];
+    groupIndex.Update(0);
+    auto entry = groupIndex.GetEntry(pixelValue, 0);
+
+    if (nullptr == entry)
+      return;
+
+    pos = entry->GetCenterOfMassIndex();
   }
-  else
+
+  auto label = this->GetLabel(pixelValue);
+  if (label.IsNotNull())
   {
-    AccessByItk_1(this->GetGroupImage(this->GetGroupIndexOfLabel(pixelValue)), CalculateCenterOfMassProcessing, pixelValue);
+    label->SetCenterOfMassIndex(pos);
+    this->GetSlicedGeometry()->IndexToWorld(pos, pos);
+    label->SetCenterOfMassCoordinates(pos);
   }
 }
 
 bool mitk::MultiLabelSegmentation::IsEmpty(LabelValueType pixelValue, TimeStepType t) const
 {
-  Image::ConstPointer image = this->GetGroupImage(this->GetGroupIndexOfLabel(pixelValue));
-  image = SelectImageByTimeStep(image, t);
-
-  size_t numPixels = 1;
-
-  for (int i = 0; i < 3; ++i)
-    numPixels *= static_cast<size_t>(image->GetDimension(i));
+  auto groupID = this->GetGroupIndexOfLabel(pixelValue);
 
-  ImagePixelReadAccessor<LabelValueType, 3> accessor(image);
-  auto pixels = accessor.GetData();
+  std::lock_guard<std::mutex> indexGuard(m_GroupIndicesMutex);
+  auto& groupIndex = m_GroupIndices[groupID];
+  groupIndex.Update(t);
 
-  for (size_t i = 0; i < numPixels; ++i)
-  {
-    if (pixels[i] == pixelValue)
-      return false;
-  }
-
-  return true;
+  return nullptr == groupIndex.GetEntry(pixelValue, t);
 }
 
 bool mitk::MultiLabelSegmentation::IsEmpty(const Label* label, TimeStepType t) const
@@ -1170,53 +1218,6 @@ itk::ModifiedTimeType mitk::MultiLabelSegmentation::GetMTime() const
   return result;
 }
 
-template <typename ImageType>
-void mitk::MultiLabelSegmentation::CalculateCenterOfMassProcessing(ImageType *itkImage, LabelValueType pixelValue)
-{
-  if (ImageType::GetImageDimension() != 3)
-  {
-    return;
-  }
-
-  auto labelGeometryFilter = itk::LabelGeometryImageFilter<ImageType>::New();
-  labelGeometryFilter->SetInput(itkImage);
-  labelGeometryFilter->Update();
-  auto centroid = labelGeometryFilter->GetCentroid(pixelValue);
-
-  mitk::Point3D pos;
-  pos[0] = centroid[0];
-  pos[1] = centroid[1];
-  pos[2] = centroid[2];
-
-  auto label = this->GetLabel(pixelValue);
-  if (label.IsNotNull())
-  {
-    label->SetCenterOfMassIndex(pos);
-    this->GetSlicedGeometry()->IndexToWorld(pos, pos);
-    label->SetCenterOfMassCoordinates(pos);
-  }
-}
-
-template <typename ImageType>
-void mitk::MultiLabelSegmentation::EraseLabelProcessing(ImageType *itkImage, LabelValueType pixelValue)
-{
-  typedef itk::ImageRegionIterator<ImageType> IteratorType;
-
-  IteratorType iter(itkImage, itkImage->GetLargestPossibleRegion());
-  iter.GoToBegin();
-
-  while (!iter.IsAtEnd())
-  {
-    LabelValueType value = iter.Get();
-
-    if (value == pixelValue)
-    {
-      iter.Set(0);
-    }
-    ++iter;
-  }
-}
-
 void mitk::MultiLabelSegmentation::AddLabelToMap(LabelValueType labelValue, mitk::Label* label, GroupIndexType groupID)
 {
   if (m_LabelMap.find(labelValue)!=m_LabelMap.end())
@@ -1276,6 +1277,17 @@ void mitk::MultiLabelSegmentation::OnLabelModified(const Object* sender, const i
   this->InvokeEvent(LabelModifiedEvent(label->GetValue()));
 }
 
+void mitk::MultiLabelSegmentation::GroupSliceModified(const GroupSliceModifiedEvent& event)
+{
+  if (nullptr != event.GetOriginalSlice() && this->ExistGroup(event.GetGroupID()))
+  {
+    std::lock_guard<std::mutex> indexGuard(m_GroupIndicesMutex);
+    m_GroupIndices[event.GetGroupID()].ApplySliceModification(event.GetTimeStep(), event.GetOriginalSlice(), event.GetOriginalMTime());
+  }
+
+  this->InvokeEvent(event);
+}
+
 bool mitk::MultiLabelSegmentation::ExistLabel(LabelValueType value) const
 {
   auto finding = m_LabelMap.find(value);
@@ -13,11 +13,13 @@ found in the LICENSE file.
 #ifndef mitkMultiLabelSegmentation_h
 #define mitkMultiLabelSegmentation_h
 
+#include <mutex>
 #include <shared_mutex>
 #include <mitkImage.h>
 #include <mitkLabel.h>
 #include <mitkLookupTable.h>
 #include <mitkMultiLabelEvents.h>
+#include <mitkMultiLabelGroupIndex.h>
 #include <mitkMessage.h>
 #include <mitkITKEventObserverGuard.h>
 
@@ -563,16 +565,29 @@ namespace mitk
     itk::ModifiedTimeType GetMTime() const override;
 
     /**
-      * \brief  */
+      * \brief Updates the center of mass (index and world coordinates) of the label.
+      * The center of mass is taken from the label index of the group (see MultiLabelGroupIndex), which is only
+      * rebuilt if the group image was modified in an unknown way. For 4D segmentations the center of mass is
+      * not updated.*/
     void UpdateCenterOfMass(LabelValueType pixelValue);
 
     using BaseData::IsEmpty;
 
     /** \brief Checks if a label is empty at a given time step (does not contain any pixels).
+      * The check is answered by the label index of the group (see MultiLabelGroupIndex) and therefore
+      * does not need to visit the group image, as long as the index is up to date.
       */
     bool IsEmpty(const Label* label, TimeStepType t = 0) const;
     bool IsEmpty(LabelValueType pixelValue, TimeStepType t = 0) const;
 
+    /** \brief Announces a slice that was written into a group image.
+      * Updates the label index of the group from the original slice of the event (if it has one) and
+      * invokes the event for the observers of the segmentation. Writers should only extract the original
+      * slice if they need it anyway (e.g. for undo) or HasObserver(GroupSliceModifiedEvent()) is true.
+      * If no original slice is passed, the label index of the group is rebuilt on its next use.
+      */
+    void GroupSliceModified(const GroupSliceModifiedEvent& event);
+
     /**
      * @brief Gets the ID of the currently active group
      * @return the ID of the active group
@@ -626,12 +641,6 @@ namespace mitk
 
     LabelValueType m_ActiveLabelValue;
 
-    template <typename ImageType>
-    void CalculateCenterOfMassProcessing(ImageType* input, LabelValueType index);
-
-    template <typename ImageType>
-    void EraseLabelProcessing(ImageType* input, LabelValueType index);
-
     template <typename MultiLabelSegmentationType, typename ImageType>
     void InitializeByLabeledImageProcessing(MultiLabelSegmentationType* input, const ImageType* other);
 
@@ -646,6 +655,12 @@ namespace mitk
 
     std::vector<Image::Pointer> m_GroupContainer;
 
+    /** Label indices of the group images (same order as m_GroupContainer). They are updated lazily
+      (also by const methods like IsEmpty()) and therefore mutable.*/
+    mutable std::vector<MultiLabelGroupIndex> m_GroupIndices;
+    /** Mutex used to secure the access to the label indices.*/
+    mutable std::mutex m_GroupIndicesMutex;
+
     using LabelMapType = std::map<LabelValueType, Label::Pointer>;
     /** Dictionary that holds all known labels (label value is the key).*/
     LabelMapType m_LabelMap;
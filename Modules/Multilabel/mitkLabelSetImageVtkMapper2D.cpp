@@ -369,6 +369,10 @@ void mitk::LabelSetImageVtkMapper2D::GenerateImageSlice(mitk::BaseRenderer* rend
     localStorage->m_ReslicerVector[groupID]->SetInterpolationMode(ExtractSliceFilter::RESLICE_NEAREST);
     localStorage->m_ReslicerVector[groupID]->SetVtkOutputRequest(true);
 
+    bool multithreadedReslicing = true;
+    node->GetBoolProperty("multithreaded reslicing", multithreadedReslicing, renderer);
+    localStorage->m_ReslicerVector[groupID]->SetUseExtractSliceFilter2(multithreadedReslicing);
+
     // this is needed when thick mode was enabled before. These variables have to be reset to default values
     localStorage->m_ReslicerVector[groupID]->SetOutputDimensionality(2);
     localStorage->m_ReslicerVector[groupID]->SetOutputSpacingZDirection(1.0);
@@ -102,4 +102,53 @@ namespace mitk
   mitkMultiLabelEventMacroDefinition(GroupAddedEvent, AnyGroupEvent, AnyGroupEvent::GroupIndexType);
   mitkMultiLabelEventMacroDefinition(GroupModifiedEvent, AnyGroupEvent, AnyGroupEvent::GroupIndexType);
   mitkMultiLabelEventMacroDefinition(GroupRemovedEvent, AnyGroupEvent, AnyGroupEvent::GroupIndexType);
+
+  GroupSliceModifiedEvent::GroupSliceModifiedEvent(GroupIndexType groupID) : AnyGroupEvent(groupID) {}
+
+  GroupSliceModifiedEvent::GroupSliceModifiedEvent(GroupIndexType groupID, TimeStepType timeStep, const PlaneGeometry* planeGeometry, const Image* originalSlice, const Image* modifiedSlice, itk::ModifiedTimeType originalMTime)
+    : AnyGroupEvent(groupID), m_TimeStep(timeStep), m_PlaneGeometry(planeGeometry), m_OriginalSlice(originalSlice), m_ModifiedSlice(modifiedSlice), m_OriginalMTime(originalMTime)
+  {
+  }
+
+  GroupSliceModifiedEvent::GroupSliceModifiedEvent(const GroupSliceModifiedEvent& s)
+    : AnyGroupEvent(s), m_TimeStep(s.m_TimeStep), m_PlaneGeometry(s.m_PlaneGeometry), m_OriginalSlice(s.m_OriginalSlice), m_ModifiedSlice(s.m_ModifiedSlice), m_OriginalMTime(s.m_OriginalMTime)
+  {
+  }
+
+  GroupSliceModifiedEvent::~GroupSliceModifiedEvent() {}
+
+  const char* GroupSliceModifiedEvent::GetEventName() const { return "GroupSliceModifiedEvent"; }
+
+  bool GroupSliceModifiedEvent::CheckEvent(const itk::EventObject* e) const
+  {
+    if (!Superclass::CheckEvent(e)) return false;
+    return (dynamic_cast<const GroupSliceModifiedEvent*>(e) != nullptr);
+  }
+
+  itk::EventObject* GroupSliceModifiedEvent::MakeObject() const { return new GroupSliceModifiedEvent(); }
+
+  TimeStepType GroupSliceModifiedEvent::GetTimeStep() const
+  {
+    return m_TimeStep;
+  }
+
+  const PlaneGeometry* GroupSliceModifiedEvent::GetPlaneGeometry() const
+  {
+    return m_PlaneGeometry;
+  }
+
+  const Image* GroupSliceModifiedEvent::GetOriginalSlice() const
+  {
+    return m_OriginalSlice;
+  }
+
+  const Image* GroupSliceModifiedEvent::GetModifiedSlice() const
+  {
+    return m_ModifiedSlice;
+  }
+
+  itk::ModifiedTimeType GroupSliceModifiedEvent::GetOriginalMTime() const
+  {
+    return m_OriginalMTime;
+  }
 }
\ No newline at end of file
@@ -15,6 +15,7 @@ found in the LICENSE file.
 
 #include <itkEventObject.h>
 #include <mitkLabel.h>
+#include <mitkTimeGeometry.h>
 
 #include <MitkMultilabelExports.h>
 
@@ -191,6 +192,52 @@ namespace mitk
   */
   mitkMultiLabelEventMacroDeclaration(GroupRemovedEvent, AnyGroupEvent, AnyGroupEvent::GroupIndexType);
 
+  class Image;
+  class PlaneGeometry;
+
+  /** Event class that is used to indicate that a slice of a group image has been overwritten.
+  *
+  * The event is sent by the slice based segmentation tools and by undo/redo after a slice was
+  * written into a group image. Besides the group id it references the time step, the plane geometry
+  * and the content of the slice before and after the write operation. Observers can use the two
+  * slices to update derived information incrementally instead of reprocessing the whole group image.
+  * The modification time the group image had before the write allows observers to check that their
+  * derived information was up to date before the slice was written.
+  * The referenced objects are only guaranteed to be valid while the event is processed.
+  * Senders should only create the original slice if HasObserver() indicates that anybody listens.
+  */
+  class MITKMULTILABEL_EXPORT GroupSliceModifiedEvent : public AnyGroupEvent
+  {
+  public:
+    using Self = GroupSliceModifiedEvent;
+    using Superclass = AnyGroupEvent;
+
+    GroupSliceModifiedEvent() = default;
+    GroupSliceModifiedEvent(GroupIndexType groupID);
+    GroupSliceModifiedEvent(GroupIndexType groupID, TimeStepType timeStep, const PlaneGeometry* planeGeometry, const Image* originalSlice, const Image* modifiedSlice, itk::ModifiedTimeType originalMTime);
+    GroupSliceModifiedEvent(const Self& s);
+    ~GroupSliceModifiedEvent() override;
+    const char* GetEventName() const override;
+    bool CheckEvent(const itk::EventObject* e) const override;
+    itk::EventObject* MakeObject() const override;
+
+    TimeStepType GetTimeStep() const;
+    const PlaneGeometry* GetPlaneGeometry() const;
+    /** Slice as it was before the write operation.*/
+    const Image* GetOriginalSlice() const;
+    /** Slice that was written into the group image.*/
+    const Image* GetModifiedSlice() const;
+    /** Modification time of the group image before the slice was written.*/
+    itk::ModifiedTimeType GetOriginalMTime() const;
+  private:
+    void operator=(const Self&);
+    TimeStepType m_TimeStep = 0;
+    const PlaneGeometry* m_PlaneGeometry = nullptr;
+    const Image* m_OriginalSlice = nullptr;
+    const Image* m_ModifiedSlice = nullptr;
+    itk::ModifiedTimeType m_OriginalMTime = 0;
+  };
+
 }
 
 #endif
@@ -0,0 +1,355 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include <mitkMultiLabelGroupIndex.h>
+
+#include <mitkImagePixelReadAccessor.h>
+#include <mitkImageTimeSelector.h>
+
+#include <itkMath.h>
+#include <itkMultiThreaderBase.h>
+
+#include <algorithm>
+
+mitk::MultiLabelGroupIndex::RegionType mitk::MultiLabelGroupIndex::LabelEntry::GetBoundingRegion() const
+{
+  RegionType region;
+
+  if (0 == count)
+    return region;
+
+  for (unsigned int i = 0; i < 3; ++i)
+  {
+    region.SetIndex(i, minIndex[i]);
+    region.SetSize(i, maxIndex[i] - minIndex[i] + 1);
+  }
+
+  return region;
+}
+
+mitk::Point3D mitk::MultiLabelGroupIndex::LabelEntry::GetCenterOfMassIndex() const
+{
+  Point3D center;
+  center.Fill(0.0);
+
+  if (0 != count)
+  {
+    for (unsigned int i = 0; i < 3; ++i)
+      center[i] = indexSum[i] / count;
+  }
+
+  return center;
+}
+
+void mitk::MultiLabelGroupIndex::LabelEntry::AddVoxel(const IndexType& index)
+{
+  this->AddRun(index, 1);
+}
+
+void mitk::MultiLabelGroupIndex::LabelEntry::RemoveVoxel(const IndexType& index)
+{
+  --count;
+
+  for (unsigned int i = 0; i < 3; ++i)
+    indexSum[i] -= index[i];
+}
+
+void mitk::MultiLabelGroupIndex::LabelEntry::AddRun(const IndexType& index, std::size_t length)
+{
+  IndexType last = index;
+  last[0] += length - 1;
+
+  if (0 == count)
+  {
+    minIndex = index;
+    maxIndex = last;
+  }
+  else
+  {
+    for (unsigned int i = 0; i < 3; ++i)
+    {
+      minIndex[i] = std::min(minIndex[i], index[i]);
+      maxIndex[i] = std::max(maxIndex[i], last[i]);
+    }
+  }
+
+  count += length;
+  // sum of the first coordinates of the run: length * (first + last) / 2
+  indexSum[0] += 0.5 * length * (index[0] + last[0]);
+  indexSum[1] += static_cast<double>(length) * index[1];
+  indexSum[2] += static_cast<double>(length) * index[2];
+}
+
+void mitk::MultiLabelGroupIndex::LabelEntry::Merge(const LabelEntry& other)
+{
+  if (0 == other.count)
+    return;
+
+  if (0 == count)
+  {
+    *this = other;
+    return;
+  }
+
+  count += other.count;
+
+  for (unsigned int i = 0; i < 3; ++i)
+  {
+    minIndex[i] = std::min(minIndex[i], other.minIndex[i]);
+    maxIndex[i] = std::max(maxIndex[i], other.maxIndex[i]);
+    indexSum[i] += other.indexSum[i];
+  }
+}
+
+mitk::MultiLabelGroupIndex::MultiLabelGroupIndex(const Image* groupImage)
+  : m_GroupImage(groupImage)
+{
+}
+
+bool mitk::MultiLabelGroupIndex::IsUpToDate(TimeStepType timeStep) const
+{
+  return m_GroupImage.IsNotNull() && timeStep < m_TimeSteps.size() && m_TimeSteps[timeStep].mtime == m_GroupImage->GetMTime()
+    && m_TimeSteps[timeStep].writeAccessTime == m_GroupImage->GetLastWriteAccessTime();
+}
+
+void mitk::MultiLabelGroupIndex::Update(TimeStepType timeStep)
+{
+  if (m_GroupImage.IsNull())
+    mitkThrow() << "Cannot update multi label group index. Group image is not set.";
+
+  if (timeStep >= m_GroupImage->GetTimeSteps())
+    mitkThrow() << "Cannot update multi label group index. Invalid time step: " << timeStep;
+
+  if (!this->IsUpToDate(timeStep))
+    this->Rebuild(timeStep);
+}
+
+const mitk::MultiLabelGroupIndex::LabelEntry* mitk::MultiLabelGroupIndex::GetEntry(LabelValueType label, TimeStepType timeStep) const
+{
+  if (timeStep >= m_TimeSteps.size())
+    return nullptr;
+
+  const auto& entries = m_TimeSteps[timeStep].entries;
+  auto finding = entries.find(label);
+
+  return entries.end() == finding || 0 == finding->second.count ? nullptr : &(finding->second);
+}
+
+void mitk::MultiLabelGroupIndex::Rebuild(TimeStepType timeStep)
+{
+  if (m_TimeSteps.size() < m_GroupImage->GetTimeSteps())
+    m_TimeSteps.resize(m_GroupImage->GetTimeSteps());
+
+  const auto mtime = m_GroupImage->GetMTime();
+  const auto writeAccessTime = m_GroupImage->GetLastWriteAccessTime();
+
+  auto volume = SelectImageByTimeStep(m_GroupImage.GetPointer(), timeStep);
+  ImagePixelReadAccessor<LabelValueType, 3> accessor(volume);
+  const auto* labels = accessor.GetData();
+
+  const std::size_t width = volume->GetDimension(0);
+  const std::size_t height = volume->GetDimension(1);
+  const std::size_t numberOfLines = height * volume->GetDimension(2);
+
+  // Each chunk of lines is indexed into its own map; the maps are merged afterwards.
+  auto threader = itk::MultiThreaderBase::New();
+  const std::size_t numberOfChunks = std::max<std::size_t>(1, std::min<std::size_t>(numberOfLines, 4 * threader->GetMaximumNumberOfThreads()));
+  std::vector<LabelEntryMapType> partialEntries(numberOfChunks);
+
+  threader->ParallelizeArray(0, numberOfChunks, [&](itk::SizeValueType chunk)
+  {
+    auto& entries = partialEntries[chunk];
+    const auto firstLine = chunk * numberOfLines / numberOfChunks;
+    const auto endLine = (chunk + 1) * numberOfLines / numberOfChunks;
+
+    auto lastLabel = Label::UNLABELED_VALUE;
+    LabelEntry* entry = nullptr;
+    IndexType index;
+
+    for (auto line = firstLine; line < endLine; ++line)
+    {
+      const auto* row = labels + line * width;
+      index[1] = line % height;
+      index[2] = line / height;
+
+      std::size_t x = 0;
+      while (x < width)
+      {
+        // skip unlabeled runs without touching the maps
+        x = std::find_if(row + x, row + width, [](LabelValueType value) { return Label::UNLABELED_VALUE != value; }) - row;
+
+        if (x >= width)
+          break;
+
+        const auto label = row[x];
+        const auto runEnd = std::find_if(row + x, row + width, [label](LabelValueType value) { return label != value; }) - row;
+
+        if (label != lastLabel || nullptr == entry)
+        {
+          entry = &entries[label];
+          lastLabel = label;
+        }
+
+        index[0] = x;
+        entry->AddRun(index, runEnd - x);
+        x = runEnd;
+      }
+    }
+  }, nullptr);
+
+  auto& timeStepIndex = m_TimeSteps[timeStep];
+  timeStepIndex.entries.clear();
+
+  for (const auto& entries : partialEntries)
+  {
+    for (const auto& [label, entry] : entries)
+      timeStepIndex.entries[label].Merge(entry);
+  }
+
+  timeStepIndex.mtime = mtime;
+  timeStepIndex.writeAccessTime = writeAccessTime;
+}
+
+void mitk::MultiLabelGroupIndex::ApplySliceModification(TimeStepType timeStep, const Image* originalSlice, itk::ModifiedTimeType originalMTime)
+{
+  // An index that was already stale before the write is rebuilt completely anyway. The slices are written
+  // through the vtkImageData of the group image, so a released write accessor is an unannounced write.
+  const auto writeAccessTime = m_GroupImage->GetLastWriteAccessTime();
+
+  if (timeStep >= m_TimeSteps.size() || 0 == m_TimeSteps[timeStep].mtime || m_TimeSteps[timeStep].mtime != originalMTime
+    || m_TimeSteps[timeStep].writeAccessTime != writeAccessTime)
+    return;
+
+  auto& entries = m_TimeSteps[timeStep].entries;
+
+  VisitModifiedVoxels(m_GroupImage.GetPointer(), timeStep, originalSlice, [&entries](std::size_t, const IndexType& index, LabelValueType originalLabel, LabelValueType currentLabel)
+  {
+    if (Label::UNLABELED_VALUE != originalLabel)
+    {
+      auto finding = entries.find(originalLabel);
+
+      if (entries.end() != finding && 0 != finding->second.count)
+        finding->second.RemoveVoxel(index);
+    }
+
+    if (Label::UNLABELED_VALUE != currentLabel)
+      entries[currentLabel].AddVoxel(index);
+  });
+
+  // the write only touched this time step, so all time steps that were up to date before still are.
+  for (TimeStepType t = 0; t < m_TimeSteps.size(); ++t)
+  {
+    if (m_TimeSteps[t].mtime == originalMTime && m_TimeSteps[t].writeAccessTime == writeAccessTime)
+      this->Stamp(t);
+  }
+}
+
+void mitk::MultiLabelGroupIndex::RemoveLabel(LabelValueType label, TimeStepType timeStep)
+{
+  if (timeStep < m_TimeSteps.size())
+  {
+    m_TimeSteps[timeStep].entries.erase(label);
+    this->Stamp(timeStep);
+  }
+}
+
+void mitk::MultiLabelGroupIndex::Stamp(TimeStepType timeStep)
+{
+  if (m_GroupImage.IsNotNull() && timeStep < m_TimeSteps.size())
+  {
+    m_TimeSteps[timeStep].mtime = m_GroupImage->GetMTime();
+    m_TimeSteps[timeStep].writeAccessTime = m_GroupImage->GetLastWriteAccessTime();
+  }
+}
+
+void mitk::MultiLabelGroupIndex::VisitModifiedVoxels(const Image* groupImage, TimeStepType timeStep, const Image* originalSlice, const ModifiedVoxelVisitorType& visitor)
+{
+  if (nullptr == groupImage || nullptr == originalSlice)
+    mitkThrow() << "Cannot determine modified voxels. Group image or original slice is not set.";
+
+  auto volume = SelectImageByTimeStep(groupImage, timeStep);
+  ImagePixelReadAccessor<LabelValueType, 3> volumeAccessor(volume);
+  const auto* currentLabels = volumeAccessor.GetData();
+
+  ImagePixelReadAccessor<LabelValueType, 2> sliceAccessor(originalSlice);
+  const auto* originalLabels = sliceAccessor.GetData();
+
+  const std::array<std::size_t, 3> dimensions = { { volume->GetDimension(0), volume->GetDimension(1), volume->GetDimension(2) } };
+
+  // The slice index grid is mapped affinely onto the continuous index grid of the volume. Each slice
+  // pixel was extracted from (and written back to) the nearest voxel.
+  const auto sliceGeometry = originalSlice->GetGeometry();
+  const auto volumeGeometry = groupImage->GetGeometry(timeStep);
+
+  Point3D sliceIndex;
+  sliceIndex.Fill(0);
+  Point3D worldPoint;
+  Point3D volumeOrigin, volumeStepX, volumeStepY;
+
+  sliceGeometry->IndexToWorld(sliceIndex, worldPoint);
+  volumeGeometry->WorldToIndex(worldPoint, volumeOrigin);
+  sliceIndex[0] = 1;
+  sliceGeometry->IndexToWorld(sliceIndex, worldPoint);
+  volumeGeometry->WorldToIndex(worldPoint, volumeStepX);
+  sliceIndex[0] = 0;
+  sliceIndex[1] = 1;
+  sliceGeometry->IndexToWorld(sliceIndex, worldPoint);
+  volumeGeometry->WorldToIndex(worldPoint, volumeStepY);
+
+  const Vector3D stepX = volumeStepX - volumeOrigin;
+  const Vector3D stepY = volumeStepY - volumeOrigin;
+
+  struct ModifiedVoxel
+  {
+    std::size_t offset;
+    IndexType index;
+    LabelValueType originalLabel;
+  };
+
+  std::vector<ModifiedVoxel> modifiedVoxels;
+
+  const auto width = originalSlice->GetDimension(0);
+  const auto height = originalSlice->GetDimension(1);
+
+  for (unsigned int y = 0; y < height; ++y)
+  {
+    for (unsigned int x = 0; x < width; ++x)
+    {
+      const auto originalLabel = originalLabels[y * width + x];
+      const auto continuousIndex = volumeOrigin + stepX * static_cast<double>(x) + stepY * static_cast<double>(y);
+
+      ModifiedVoxel voxel;
+      bool isInside = true;
+      voxel.offset = 0;
+
+      for (int i = 2; i >= 0; --i)
+      {
+        voxel.index[i] = itk::Math::RoundHalfIntegerUp<itk::IndexValueType>(continuousIndex[i]);
+        isInside = isInside && voxel.index[i] >= 0 && voxel.index[i] < static_cast<itk::IndexValueType>(dimensions[i]);
+        voxel.offset = voxel.offset * dimensions[i] + static_cast<std::size_t>(voxel.index[i]);
+      }
+
+      if (isInside && currentLabels[voxel.offset] != originalLabel)
+      {
+        voxel.originalLabel = originalLabel;
+        modifiedVoxels.push_back(voxel);
+      }
+    }
+  }
+
+  // oblique slices may map several pixels onto the same voxel
+  std::sort(modifiedVoxels.begin(), modifiedVoxels.end(), [](const ModifiedVoxel& a, const ModifiedVoxel& b) { return a.offset < b.offset; });
+  modifiedVoxels.erase(std::unique(modifiedVoxels.begin(), modifiedVoxels.end(), [](const ModifiedVoxel& a, const ModifiedVoxel& b) { return a.offset == b.offset; }), modifiedVoxels.end());
+
+  for (const auto& voxel : modifiedVoxels)
+    visitor(voxel.offset, voxel.index, voxel.originalLabel, currentLabels[voxel.offset]);
+}
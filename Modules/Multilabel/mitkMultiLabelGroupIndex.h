@@ -0,0 +1,126 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#ifndef mitkMultiLabelGroupIndex_h
+#define mitkMultiLabelGroupIndex_h
+
+#include <MitkMultilabelExports.h>
+
+#include <mitkImage.h>
+#include <mitkLabel.h>
+
+#include <itkImageRegion.h>
+
+#include <array>
+#include <functional>
+#include <map>
+
+namespace mitk
+{
+  /**
+   * @brief Index of the labels contained in a group image of a multi label segmentation.
+   *
+   * For every time step the index knows which label values occur in the group image, how many voxels
+   * they have, a bounding box of their voxels and the sum of their voxel indices (for the center of mass).
+   * This allows to answer IsEmpty() and center of mass requests without visiting the image and to
+   * restrict operations like erasing a label to the bounding box of the label.
+   *
+   * The index of a time step is valid as long as the modification time of the group image equals the
+   * time stamp of the index and no write accessor of the group image was released since (writes through
+   * ImageWriteAccessor do not necessarily call Modified()). If it is stale, Update() rebuilds it with one multi threaded pass over the
+   * time step that indexes all labels at once. Modifications whose effect on the index is known (e.g.
+   * slices written by the segmentation tools, see ApplySliceModification()) keep the index up to date
+   * without a rebuild.
+   *
+   * Removing voxels of a label does not shrink its bounding box. The bounding box is therefore only
+   * guaranteed to contain all voxels of the label; the voxel count and the index sum are always exact.
+   */
+  class MITKMULTILABEL_EXPORT MultiLabelGroupIndex
+  {
+  public:
+    using LabelValueType = Label::PixelType;
+    using IndexType = itk::Index<3>;
+    using RegionType = itk::ImageRegion<3>;
+
+    struct MITKMULTILABEL_EXPORT LabelEntry
+    {
+      std::size_t count = 0;
+      IndexType minIndex = {{ 0, 0, 0 }};
+      IndexType maxIndex = {{ 0, 0, 0 }};
+      std::array<double, 3> indexSum = {{ 0.0, 0.0, 0.0 }};
+
+      /** Region that contains all voxels of the label (empty if the label has no voxel).*/
+      RegionType GetBoundingRegion() const;
+      /** Center of mass in index coordinates of the group image.*/
+      Point3D GetCenterOfMassIndex() const;
+
+      void AddVoxel(const IndexType& index);
+      void RemoveVoxel(const IndexType& index);
+      /** Adds a run of voxels along the first axis, starting at the passed index.*/
+      void AddRun(const IndexType& index, std::size_t length);
+      void Merge(const LabelEntry& other);
+    };
+
+    using LabelEntryMapType = std::map<LabelValueType, LabelEntry>;
+    using ModifiedVoxelVisitorType = std::function<void(std::size_t offset, const IndexType& index, LabelValueType originalLabel, LabelValueType currentLabel)>;
+
+    explicit MultiLabelGroupIndex(const Image* groupImage = nullptr);
+
+    /** Indicates if the index of the time step matches the current content of the group image.*/
+    bool IsUpToDate(TimeStepType timeStep) const;
+
+    /** Rebuilds the index of the time step if it is not up to date.*/
+    void Update(TimeStepType timeStep);
+
+    /** Returns the entry of the label at the time step or nullptr if the label has no voxel.
+     * @pre The index of the time step must be up to date.*/
+    const LabelEntry* GetEntry(LabelValueType label, TimeStepType timeStep) const;
+
+    /** Updates the index for a slice that was written into the group image (see GroupSliceModifiedEvent).
+     * The update is only applied if the index was up to date with the original modification time of the group
+     * image and no write accessor was released since. Otherwise the index stays outdated and is rebuilt on the
+     * next Update().*/
+    void ApplySliceModification(TimeStepType timeStep, const Image* originalSlice, itk::ModifiedTimeType originalMTime);
+
+    /** Removes the label from the index of the time step and marks the index as up to date.
+     * Use it after all voxels of the label were erased from the group image.*/
+    void RemoveLabel(LabelValueType label, TimeStepType timeStep);
+
+    /** Marks the index of the time step as up to date with the current group image (e.g. after a modification
+     * that did not change the index).*/
+    void Stamp(TimeStepType timeStep);
+
+    /**
+     * @brief Determines the voxels of a group image that were changed by writing a slice.
+     * The written slice must already be in the group image. The passed original slice (the content before the
+     * write) is mapped onto the voxels of the group image and every voxel whose current label differs from the
+     * original one is passed (once) to the visitor in ascending offset order.
+     */
+    static void VisitModifiedVoxels(const Image* groupImage, TimeStepType timeStep, const Image* originalSlice, const ModifiedVoxelVisitorType& visitor);
+
+  private:
+    struct TimeStepIndex
+    {
+      itk::ModifiedTimeType mtime = 0;
+      itk::ModifiedTimeType writeAccessTime = 0;
+      LabelEntryMapType entries;
+    };
+
+    void Rebuild(TimeStepType timeStep);
+
+    /** Group image the index belongs to.*/
+    Image::ConstPointer m_GroupImage;
+    std::vector<TimeStepIndex> m_TimeSteps;
+  };
+}
+
+#endif
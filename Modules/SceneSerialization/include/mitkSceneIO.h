@@ -18,7 +18,13 @@ found in the LICENSE file.
 #include "mitkDataStorage.h"
 #include "mitkNodePredicateBase.h"
 
-#include <Poco/Zip/ZipLocalFileHeader.h>
+namespace Poco
+{
+  namespace Zip
+  {
+    class Compress;
+  }
+}
 
 namespace tinyxml2
 {
@@ -30,6 +36,7 @@ namespace mitk
 {
   class BaseData;
   class PropertyList;
+  class SceneArchive;
 
   class MITKSCENESERIALIZATION_EXPORT SceneIO : public itk::Object
   {
@@ -48,6 +55,9 @@ namespace mitk
      * Attempts to read the provided file and create objects with
      * parent/child relations into a DataStorage.
      *
+     * The members of the archive are read directly from the file, the archive is not
+     * extracted to a temporary directory. The data of different nodes is read concurrently.
+     *
      * \param filename full filename of the scene file
      * \param storage If given, this DataStorage is used instead of a newly created one
      * \param clearStorageFirst If set, the provided DataStorage will be cleared before populating it with the loaded
@@ -86,6 +96,11 @@ namespace mitk
      * Attempts to write a scene file, which contains the nodes of the
      * provided DataStorage, their parent/child relations, and properties.
      *
+     * Every file is added to the archive right after it was serialized, so the scene
+     * is not assembled in a temporary directory. Data files of formats that are compressed
+     * already (like NRRD images) are stored without further compression, other data files
+     * are compressed with the fastest compression level.
+     *
      * \param sceneNodes
      * \param storage a DataStorage containing all nodes that should be saved
      * \param filename
@@ -121,17 +136,16 @@ namespace mitk
 
     std::string CreateEmptyTempDirectory();
 
-    tinyxml2::XMLElement *SaveBaseData(tinyxml2::XMLDocument &doc, BaseData *data, const std::string &filenamehint, bool &error);
-    tinyxml2::XMLElement *SavePropertyList(tinyxml2::XMLDocument &doc, PropertyList *propertyList, const std::string &filenamehint);
+    DataStorage::Pointer LoadSceneFromArchive(const SceneArchive &archive, DataStorage *storage, bool clearStorageFirst);
 
-    void OnUnzipError(const void *pSender, std::pair<const Poco::Zip::ZipLocalFileHeader, const std::string> &info);
-    void OnUnzipOk(const void *pSender, std::pair<const Poco::Zip::ZipLocalFileHeader, const Poco::Path> &info);
+    tinyxml2::XMLElement *SaveBaseData(tinyxml2::XMLDocument &doc, Poco::Zip::Compress &archive, BaseData *data, const std::string &filenamehint, bool &error);
+    tinyxml2::XMLElement *SavePropertyList(tinyxml2::XMLDocument &doc, Poco::Zip::Compress &archive, PropertyList *propertyList, const std::string &filenamehint);
 
     FailedBaseDataListType::Pointer m_FailedNodes;
     PropertyList::Pointer m_FailedProperties;
 
+    /** \brief Directory in which BaseDataSerializers write their files before these are added to the archive. */
     std::string m_WorkingDirectory;
-    unsigned int m_UnzipErrors;
   };
 }
 
@@ -26,6 +26,8 @@ namespace tinyxml2
 
 namespace mitk
 {
+  class SceneArchive;
+
   class MITKSCENESERIALIZATION_EXPORT SceneReader : public itk::Object
   {
   public:
@@ -34,6 +36,13 @@ namespace mitk
     itkCloneMacro(Self);
 
     virtual bool LoadScene(tinyxml2::XMLDocument &document, const std::string &workingDirectory, DataStorage *storage);
+
+    /**
+      \brief Loads the scene described by the index document, reading all further files from the given archive.
+
+      The archive is either a .mitk file, whose members are read without extracting it, or an unzipped scene directory.
+    */
+    virtual bool LoadScene(tinyxml2::XMLDocument &document, const SceneArchive &archive, DataStorage *storage);
   };
 }
 
@@ -22,12 +22,25 @@ mitk::PropertyListDeserializer::~PropertyListDeserializer()
 {
 }
 
+void mitk::PropertyListDeserializer::SetContent(const std::string &content)
+{
+  m_Content = content;
+}
+
+bool mitk::PropertyListDeserializer::LoadDocument(tinyxml2::XMLDocument &document) const
+{
+  if (!m_Content.empty())
+    return tinyxml2::XML_SUCCESS == document.Parse(m_Content.data(), m_Content.size());
+
+  return tinyxml2::XML_SUCCESS == document.LoadFile(m_Filename.c_str());
+}
+
 bool mitk::PropertyListDeserializer::Deserialize()
 {
   bool error(false);
 
   tinyxml2::XMLDocument document;
-  if (tinyxml2::XML_SUCCESS != document.LoadFile(m_Filename.c_str()))
+  if (!this->LoadDocument(document))
   {
     MITK_ERROR << "Could not open/read/parse " << m_Filename << "\nTinyXML reports: " << document.ErrorStr()
                << std::endl;
@@ -66,6 +79,7 @@ bool mitk::PropertyListDeserializer::Deserialize()
     if (auto *reader = dynamic_cast<PropertyListDeserializer *>(iter->GetPointer()))
     {
       reader->SetFilename(m_Filename);
+      reader->SetContent(m_Content);
       bool success = reader->Deserialize();
       error |= !success;
       m_PropertyList = reader->GetOutput();
@@ -15,6 +15,11 @@ found in the LICENSE file.
 
 #include "mitkPropertyList.h"
 
+namespace tinyxml2
+{
+  class XMLDocument;
+}
+
 namespace mitk
 {
   /**
@@ -29,6 +34,13 @@ namespace mitk
       itkSetStringMacro(Filename);
     itkGetStringMacro(Filename);
 
+    /**
+      \brief Sets the XML content of the property list file, e.g. as read from a scene archive.
+
+      If set, the file is not read and Filename is only used in messages.
+      */
+    void SetContent(const std::string &content);
+
     /**
       \brief Reads a propertylist from file
       \return success of deserialization
@@ -41,7 +53,13 @@ namespace mitk
     PropertyListDeserializer();
     ~PropertyListDeserializer() override;
 
+    /**
+      \brief Parses the content if set, reads and parses the file otherwise.
+      */
+    bool LoadDocument(tinyxml2::XMLDocument &document) const;
+
     std::string m_Filename;
+    std::string m_Content;
     PropertyList::Pointer m_PropertyList;
   };
 
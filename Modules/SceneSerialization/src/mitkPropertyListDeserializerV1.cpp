@@ -32,7 +32,7 @@ bool mitk::PropertyListDeserializerV1::Deserialize()
   m_PropertyList = PropertyList::New();
 
   tinyxml2::XMLDocument document;
-  if (tinyxml2::XML_SUCCESS != document.LoadFile(m_Filename.c_str()))
+  if (!this->LoadDocument(document))
   {
     MITK_ERROR << "Could not open/read/parse " << m_Filename << "\nTinyXML reports: " << document.ErrorStr()
                << std::endl;
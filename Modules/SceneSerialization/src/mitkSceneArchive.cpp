@@ -0,0 +1,174 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include "mitkSceneArchive.h"
+
+#include <mitkExceptionMacro.h>
+#include <mitkFileReaderSelector.h>
+#include <mitkFileSystem.h>
+#include <mitkIOUtil.h>
+
+#include <Poco/Zip/ZipArchive.h>
+#include <Poco/Zip/ZipStream.h>
+
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+
+mitk::SceneArchive::SceneArchive(const std::string &path)
+  : m_Location(path)
+{
+  if (fs::is_directory(path))
+    return;
+
+  std::ifstream file(path, std::ios::binary);
+
+  if (!file.good())
+    mitkThrow() << "Cannot open '" << path << "' for reading.";
+
+  try
+  {
+    m_Archive = std::make_unique<Poco::Zip::ZipArchive>(file);
+  }
+  catch (const std::exception &e)
+  {
+    mitkThrow() << "Cannot read the directory of archive '" << path << "': " << e.what();
+  }
+}
+
+mitk::SceneArchive::~SceneArchive()
+{
+}
+
+std::string mitk::SceneArchive::GetLocation() const
+{
+  return m_Location;
+}
+
+bool mitk::SceneArchive::HasMember(const std::string &name) const
+{
+  if (!m_Archive)
+    return fs::is_regular_file(fs::path(m_Location) / name);
+
+  return m_Archive->findHeader(name) != m_Archive->headerEnd();
+}
+
+bool mitk::SceneArchive::ReadMember(const std::string &name, std::string &content) const
+{
+  std::ostringstream stream;
+
+  try
+  {
+    if (!m_Archive)
+    {
+      std::ifstream file((fs::path(m_Location) / name).string(), std::ios::binary);
+
+      if (!file.good())
+        return false;
+
+      stream << file.rdbuf();
+    }
+    else
+    {
+      auto header = m_Archive->findHeader(name);
+
+      if (header == m_Archive->headerEnd())
+        return false;
+
+      // Each call uses a stream of its own, so members can be read concurrently
+      std::ifstream file(m_Location, std::ios::binary);
+      Poco::Zip::ZipInputStream member(file, header->second);
+
+      stream << member.rdbuf();
+    }
+  }
+  catch (const std::exception &e)
+  {
+    MITK_ERROR << "Cannot read '" << name << "' from '" << m_Location << "': " << e.what();
+    return false;
+  }
+
+  content = stream.str();
+  return true;
+}
+
+std::vector<mitk::BaseData::Pointer> mitk::SceneArchive::LoadData(const std::string &name,
+                                                                  const PropertyList *properties) const
+{
+  if (!m_Archive)
+    return this->LoadDataFromFile((fs::path(m_Location) / name).string(), properties);
+
+  auto header = m_Archive->findHeader(name);
+
+  if (header == m_Archive->headerEnd())
+    mitkThrow() << "Archive '" << m_Location << "' does not contain '" << name << "'.";
+
+  // Keep the member name as suffix, readers are selected by extension and content
+  std::ofstream tmpStream;
+  const auto tmpPath = IOUtil::CreateTemporaryFile(tmpStream, std::ios_base::binary, "XXXXXX_" + name);
+
+  std::vector<BaseData::Pointer> result;
+
+  try
+  {
+    {
+      std::ifstream file(m_Location, std::ios::binary);
+      Poco::Zip::ZipInputStream member(file, header->second);
+
+      tmpStream << member.rdbuf();
+      tmpStream.close();
+    }
+
+    if (tmpStream.fail())
+      mitkThrow() << "Cannot copy '" << name << "' from '" << m_Location << "' to '" << tmpPath << "'.";
+
+    result = this->LoadDataFromFile(tmpPath, properties);
+  }
+  catch (const Exception &)
+  {
+    std::remove(tmpPath.c_str());
+    throw;
+  }
+  catch (const std::exception &e)
+  {
+    std::remove(tmpPath.c_str());
+    mitkThrow() << "Cannot read '" << name << "' from '" << m_Location << "': " << e.what();
+  }
+
+  std::remove(tmpPath.c_str());
+  return result;
+}
+
+std::vector<mitk::BaseData::Pointer> mitk::SceneArchive::LoadDataFromFile(const std::string &path,
+                                                                          const PropertyList *properties) const
+{
+  // Unlike IOUtil::Load(), the selector neither reports progress nor asks for reader options,
+  // so this is safe to be called from worker threads
+  FileReaderSelector readerSelector(path);
+
+  if (readerSelector.IsEmpty())
+    mitkThrow() << "No reader available for '" << path << "'.";
+
+  auto *reader = readerSelector.GetSelected().GetReader();
+
+  if (nullptr == reader)
+    mitkThrow() << "Unexpected nullptr reader for '" << path << "'.";
+
+  reader->SetProperties(properties);
+
+  auto result = reader->Read();
+
+  if (result.empty())
+    mitkThrow() << "Unknown read error occurred reading '" << path << "'.";
+
+  return result;
+}
@@ -0,0 +1,82 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#ifndef mitkSceneArchive_h
+#define mitkSceneArchive_h
+
+#include <mitkBaseData.h>
+#include <mitkPropertyList.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace Poco
+{
+  namespace Zip
+  {
+    class ZipArchive;
+  }
+}
+
+namespace mitk
+{
+  /**
+    \brief Read access to the members of a scene, i.e. index.xml, property list files, and data files.
+
+    The scene is either a .mitk archive or the directory of an unzipped scene. Members of an archive
+    are read directly from the archive file, the archive is never extracted as a whole. As the readers
+    of base data need files, a data member is copied to a temporary file of its own while it is read.
+    For members that are stored uncompressed this is a plain copy.
+
+    All const methods can be called concurrently.
+  */
+  class SceneArchive
+  {
+  public:
+    /**
+      \brief Opens a .mitk archive or, if path is a directory, an unzipped scene.
+      \throw mitk::Exception if the archive cannot be read.
+    */
+    explicit SceneArchive(const std::string &path);
+    ~SceneArchive();
+
+    SceneArchive(const SceneArchive &) = delete;
+    SceneArchive &operator=(const SceneArchive &) = delete;
+
+    /** \brief Path of the archive or of the scene directory, e.g. for messages. */
+    std::string GetLocation() const;
+
+    bool HasMember(const std::string &name) const;
+
+    /**
+      \brief Reads the complete content of a member into memory.
+      \return false if there is no such member or it cannot be read.
+    */
+    bool ReadMember(const std::string &name, std::string &content) const;
+
+    /**
+      \brief Reads the base data of a data member with the best matching file reader.
+      \param properties read-only meta data that is provided to the reader (may be nullptr)
+      \throw mitk::Exception if the member does not exist or cannot be read.
+    */
+    std::vector<BaseData::Pointer> LoadData(const std::string &name, const PropertyList *properties) const;
+
+  private:
+    std::vector<BaseData::Pointer> LoadDataFromFile(const std::string &path, const PropertyList *properties) const;
+
+    std::string m_Location;
+    std::unique_ptr<Poco::Zip::ZipArchive> m_Archive;
+  };
+}
+
+#endif
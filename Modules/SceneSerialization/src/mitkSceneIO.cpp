@@ -10,14 +10,14 @@ found in the LICENSE file.
 
 ============================================================================*/
 
-#include <Poco/Delegate.h>
+#include <Poco/DateTime.h>
+#include <Poco/File.h>
 #include <Poco/Path.h>
-#include <Poco/TemporaryFile.h>
 #include <Poco/Zip/Compress.h>
-#include <Poco/Zip/Decompress.h>
 
 #include "mitkBaseDataSerializer.h"
 #include "mitkPropertyListSerializer.h"
+#include "mitkSceneArchive.h"
 #include "mitkSceneIO.h"
 #include "mitkSceneReader.h"
 
@@ -25,21 +25,79 @@ found in the LICENSE file.
 #include "mitkProgressBar.h"
 #include "mitkRenderingManager.h"
 #include "mitkStandaloneDataStorage.h"
+#include <mitkExceptionMacro.h>
 #include <mitkLocaleSwitch.h>
 #include <mitkStandardFileLocations.h>
 #include <mitkUIDGenerator.h>
 
 #include <itkObjectFactoryBase.h>
 
+#include <algorithm>
+#include <cctype>
 #include <fstream>
+#include <mitkFileSystem.h>
 #include <mitkIOUtil.h>
+#include <set>
 #include <sstream>
 
 #include "itksys/SystemTools.hxx"
 
 #include <tinyxml2.h>
 
-mitk::SceneIO::SceneIO() : m_WorkingDirectory(""), m_UnzipErrors(0)
+namespace
+{
+  /**
+    Data files of formats that are compressed already (NRRD images are written with gzip encoding) are
+    stored as they are, as deflating them a second time costs a lot of time for next to no gain. All
+    other data files are deflated with the fastest level. Only the small XML files are compressed
+    with the maximum level.
+  */
+  void AddFileToArchive(Poco::Zip::Compress &archive, const fs::path &file)
+  {
+    static const std::set<std::string> storedExtensions = { ".nrrd", ".gz", ".png", ".jpg", ".zip" };
+
+    auto extension = file.extension().string();
+    std::transform(extension.begin(), extension.end(), extension.begin(), ::tolower);
+
+    std::ifstream stream(file.string(), std::ios::binary);
+
+    if (!stream.good())
+      mitkThrow() << "Cannot open " << file.string() << " for reading";
+
+    if (storedExtensions.count(extension) != 0)
+    {
+      archive.addFile(stream, Poco::DateTime(), Poco::Path(file.filename().string()),
+        Poco::Zip::ZipCommon::CM_STORE, Poco::Zip::ZipCommon::CL_NORMAL);
+    }
+    else
+    {
+      archive.addFile(stream, Poco::DateTime(), Poco::Path(file.filename().string()),
+        Poco::Zip::ZipCommon::CM_DEFLATE, Poco::Zip::ZipCommon::CL_SUPERFAST);
+    }
+  }
+
+  void AddXMLToArchive(Poco::Zip::Compress &archive, const std::string &xml, const std::string &name)
+  {
+    std::istringstream stream(xml);
+    archive.addFile(stream, Poco::DateTime(), Poco::Path(name),
+      Poco::Zip::ZipCommon::CM_DEFLATE, Poco::Zip::ZipCommon::CL_MAXIMUM);
+  }
+
+  void RemoveTempDirectory(const std::string &directory)
+  {
+    try
+    {
+      Poco::File deleteDir(directory);
+      deleteDir.remove(true); // recursive
+    }
+    catch (...)
+    {
+      MITK_ERROR << "Could not delete temporary directory " << directory;
+    }
+  }
+}
+
+mitk::SceneIO::SceneIO() : m_WorkingDirectory("")
 {
 }
 
@@ -110,48 +168,17 @@ mitk::DataStorage::Pointer mitk::SceneIO::LoadScene(const std::string &filename,
     return storage;
   }
 
-  // get new temporary directory
-  m_WorkingDirectory = CreateEmptyTempDirectory();
-  if (m_WorkingDirectory.empty())
-  {
-    MITK_ERROR << "Could not create temporary directory. Cannot open scene files.";
-    return storage;
-  }
-
-  // unzip all filenames contents to temp dir
-  m_UnzipErrors = 0;
-  Poco::Zip::Decompress unzipper(file, Poco::Path(m_WorkingDirectory));
-  unzipper.EError += Poco::Delegate<SceneIO, std::pair<const Poco::Zip::ZipLocalFileHeader, const std::string>>(
-    this, &SceneIO::OnUnzipError);
-  unzipper.EOk += Poco::Delegate<SceneIO, std::pair<const Poco::Zip::ZipLocalFileHeader, const Poco::Path>>(
-    this, &SceneIO::OnUnzipOk);
-  unzipper.decompressAllFiles();
-  unzipper.EError -= Poco::Delegate<SceneIO, std::pair<const Poco::Zip::ZipLocalFileHeader, const std::string>>(
-    this, &SceneIO::OnUnzipError);
-  unzipper.EOk -= Poco::Delegate<SceneIO, std::pair<const Poco::Zip::ZipLocalFileHeader, const Poco::Path>>(
-    this, &SceneIO::OnUnzipOk);
-
-  if (m_UnzipErrors)
-  {
-    MITK_ERROR << "There were " << m_UnzipErrors << " errors unzipping '" << filename
-               << "'. Will attempt to read whatever could be unzipped.";
-  }
-
-  // transcode locale-dependent string
-  m_WorkingDirectory = Poco::Path::transcode (m_WorkingDirectory);
+  file.close();
 
-  auto indexFile = m_WorkingDirectory + mitk::IOUtil::GetDirectorySeparator() + "index.xml";
-  storage = LoadSceneUnzipped(indexFile, storage, clearStorageFirst);
-
-  // delete temp directory
   try
   {
-    Poco::File deleteDir(m_WorkingDirectory);
-    deleteDir.remove(true); // recursive
+    // members are read directly from the archive, it is not extracted
+    SceneArchive archive(filename);
+    storage = this->LoadSceneFromArchive(archive, storage, clearStorageFirst);
   }
-  catch (...)
+  catch (const std::exception &e)
   {
-    MITK_ERROR << "Could not delete temporary directory " << m_WorkingDirectory;
+    MITK_ERROR << "Could not open scene file '" << filename << "': " << e.what();
   }
 
   // return new data storage, even if empty or incomplete (return as much as possible but notify calling method)
@@ -195,23 +222,65 @@ mitk::DataStorage::Pointer mitk::SceneIO::LoadSceneUnzipped(const std::string &i
   std::string workingDir;
   itksys::SystemTools::SplitProgramPath(indexfilename, workingDir, tempfilename);
 
-  // test if index.xml exists
+  try
+  {
+    SceneArchive archive(workingDir);
+    storage = this->LoadSceneFromArchive(archive, storage, false);
+  }
+  catch (const std::exception &e)
+  {
+    MITK_ERROR << "Could not open scene directory " << workingDir << ": " << e.what();
+  }
+
+  // return new data storage, even if empty or incomplete (return as much as possible but notify calling method)
+  return storage;
+}
+
+mitk::DataStorage::Pointer mitk::SceneIO::LoadSceneFromArchive(const SceneArchive &archive,
+                                                               DataStorage *pStorage,
+                                                               bool clearStorageFirst)
+{
+  // prepare data storage
+  DataStorage::Pointer storage = pStorage;
+  if (storage.IsNull())
+  {
+    storage = StandaloneDataStorage::New().GetPointer();
+  }
+
+  if (clearStorageFirst)
+  {
+    try
+    {
+      storage->Remove(storage->GetAll());
+    }
+    catch (...)
+    {
+      MITK_ERROR << "DataStorage cannot be cleared properly.";
+    }
+  }
+
   // parse index.xml with TinyXML
+  std::string index;
+  if (!archive.ReadMember("index.xml", index))
+  {
+    MITK_ERROR << "Could not open/read " << archive.GetLocation() << mitk::IOUtil::GetDirectorySeparator() << "index.xml";
+    return storage;
+  }
+
   tinyxml2::XMLDocument document;
-  if (tinyxml2::XML_SUCCESS != document.LoadFile(indexfilename.c_str()))
+  if (tinyxml2::XML_SUCCESS != document.Parse(index.data(), index.size()))
   {
-    MITK_ERROR << "Could not open/read/parse " << workingDir << mitk::IOUtil::GetDirectorySeparator()
+    MITK_ERROR << "Could not parse " << archive.GetLocation() << mitk::IOUtil::GetDirectorySeparator()
       << "index.xml\nTinyXML reports: " << document.ErrorStr() << std::endl;
     return storage;
   }
 
   SceneReader::Pointer reader = SceneReader::New();
-  if (!reader->LoadScene(document, workingDir, storage))
+  if (!reader->LoadScene(document, archive, storage))
   {
-    MITK_ERROR << "There were errors while loading scene file " << indexfilename << ". Your data may be corrupted";
+    MITK_ERROR << "There were errors while loading scene file " << archive.GetLocation() << ". Your data may be corrupted";
   }
 
-  // return new data storage, even if empty or incomplete (return as much as possible but notify calling method)
   return storage;
 }
 
@@ -239,11 +308,54 @@ bool mitk::SceneIO::SaveScene(DataStorage::SetOfObjects::ConstPointer sceneNodes
 
   mitk::LocaleSwitch localeSwitch("C");
 
+  // The zip is created next to filename and replaces it only when it is complete, so that a failure
+  // neither leaves a partial scene file nor destroys an existing one.
+  std::ofstream file;
+  std::string temporaryFilename;
+
+  try
+  {
+    const fs::path targetPath(filename);
+    const auto directory = targetPath.has_parent_path() ? targetPath.parent_path().string() + '/' : std::string("./");
+    temporaryFilename = IOUtil::CreateTemporaryFile(file, std::ios::binary | std::ios::out, targetPath.filename().string() + ".XXXXXX", directory);
+  }
+  catch (std::exception &e)
+  {
+    MITK_ERROR << "Could not open a zip file for writing: '" << filename << "'\nReason: " << e.what();
+    return false;
+  }
+
+  auto removeTemporaryFile = [&file, &temporaryFilename]() {
+    if (file.is_open())
+      file.close();
+
+    std::error_code error;
+    fs::remove(temporaryFilename, error);
+  };
+
+  if (!file.good())
+  {
+    MITK_ERROR << "Could not open a zip file for writing: '" << filename << "'";
+    removeTemporaryFile();
+    return false;
+  }
+
+  // serializers of base data write files, which are moved to the archive one by one
+  m_WorkingDirectory = CreateEmptyTempDirectory();
+  if (m_WorkingDirectory.empty())
+  {
+    MITK_ERROR << "Could not create temporary directory. Cannot create scene files.";
+    removeTemporaryFile();
+    return false;
+  }
+
   try
   {
     m_FailedNodes = DataStorage::SetOfObjects::New();
     m_FailedProperties = PropertyList::New();
 
+    Poco::Zip::Compress archive(file, true);
+
     // start XML DOM
     tinyxml2::XMLDocument document;
     document.InsertEndChild(document.NewDeclaration());
@@ -269,13 +381,6 @@ bool mitk::SceneIO::SaveScene(DataStorage::SetOfObjects::ConstPointer sceneNodes
 
       MITK_INFO << "Storing scene with " << sceneNodes->size() << " objects to " << filename;
 
-      m_WorkingDirectory = CreateEmptyTempDirectory();
-      if (m_WorkingDirectory.empty())
-      {
-        MITK_ERROR << "Could not create temporary directory. Cannot create scene files.";
-        return false;
-      }
-
       ProgressBar::GetInstance()->AddStepsToDo(sceneNodes->size());
 
       // find out about dependencies
@@ -357,7 +462,7 @@ bool mitk::SceneIO::SaveScene(DataStorage::SetOfObjects::ConstPointer sceneNodes
           {
             // std::string filenameHint( node->GetName() );
             bool error(false);
-            auto *dataElement = SaveBaseData(document, data, filenameHint, error); // returns a reference to a file
+            auto *dataElement = SaveBaseData(document, archive, data, filenameHint, error); // returns a reference to a file
             if (error)
             {
               m_FailedNodes->push_back(node);
@@ -368,7 +473,7 @@ bool mitk::SceneIO::SaveScene(DataStorage::SetOfObjects::ConstPointer sceneNodes
             if (propertyList && !propertyList->IsEmpty())
             {
               auto *baseDataPropertiesElement =
-                SavePropertyList(document, propertyList, filenameHint + "-data"); // returns a reference to a file
+                SavePropertyList(document, archive, propertyList, filenameHint + "-data"); // returns a reference to a file
               dataElement->InsertEndChild(baseDataPropertiesElement);
             }
 
@@ -383,7 +488,7 @@ bool mitk::SceneIO::SaveScene(DataStorage::SetOfObjects::ConstPointer sceneNodes
             if (propertyList && !propertyList->IsEmpty())
             {
               auto *renderWindowPropertiesElement =
-                SavePropertyList(document, propertyList, filenameHint + "-" + renderWindowName); // returns a reference to a file
+                SavePropertyList(document, archive, propertyList, filenameHint + "-" + renderWindowName); // returns a reference to a file
               renderWindowPropertiesElement->SetAttribute("renderwindow", renderWindowName.c_str());
               nodeElement->InsertEndChild(renderWindowPropertiesElement);
             }
@@ -394,7 +499,7 @@ bool mitk::SceneIO::SaveScene(DataStorage::SetOfObjects::ConstPointer sceneNodes
           if (propertyList && !propertyList->IsEmpty())
           {
             auto *propertiesElement =
-              SavePropertyList(document, propertyList, filenameHint + "-node"); // returns a reference to a file
+              SavePropertyList(document, archive, propertyList, filenameHint + "-node"); // returns a reference to a file
             nodeElement->InsertEndChild(propertiesElement);
           }
           document.InsertEndChild(nodeElement);
@@ -408,66 +513,45 @@ bool mitk::SceneIO::SaveScene(DataStorage::SetOfObjects::ConstPointer sceneNodes
       } // end for all nodes
     }   // end if sceneNodes
 
-    std::string defaultLocale_WorkingDirectory = Poco::Path::transcode( m_WorkingDirectory );
+    tinyxml2::XMLPrinter printer;
+    document.Print(&printer);
 
-    auto xmlFilename = defaultLocale_WorkingDirectory + Poco::Path::separator() + "index.xml";
-    if (tinyxml2::XML_SUCCESS != document.SaveFile(xmlFilename.c_str()))
-    {
-      MITK_ERROR << "Could not write scene to " << defaultLocale_WorkingDirectory << Poco::Path::separator() << "index.xml"
-                 << "\nTinyXML reports '" << document.ErrorStr() << "'";
-      return false;
-    }
-    else
-    {
-      try
-      {
-        Poco::File deleteFile(filename.c_str());
-        if (deleteFile.exists())
-        {
-          deleteFile.remove();
-        }
+    AddXMLToArchive(archive, std::string(printer.CStr(), printer.CStrSize() - 1), "index.xml");
+    archive.close();
+  }
+  catch (std::exception &e)
+  {
+    MITK_ERROR << "Could not write scene to '" << filename << "'\nReason: " << e.what();
+    RemoveTempDirectory(m_WorkingDirectory);
+    removeTemporaryFile();
+    return false;
+  }
 
-        // create zip at filename
-        std::ofstream file(filename.c_str(), std::ios::binary | std::ios::out);
-        if (!file.good())
-        {
-          MITK_ERROR << "Could not open a zip file for writing: '" << filename << "'";
-          return false;
-        }
-        else
-        {
-          Poco::Zip::Compress zipper(file, true);
-          Poco::Path tmpdir(m_WorkingDirectory);
-          zipper.addRecursive(tmpdir);
-          zipper.close();
-        }
-        try
-        {
-          Poco::File deleteDir(m_WorkingDirectory);
-          deleteDir.remove(true); // recursive
-        }
-        catch (...)
-        {
-          MITK_ERROR << "Could not delete temporary directory " << m_WorkingDirectory;
-          return false; // ok?
-        }
-      }
-      catch (std::exception &e)
-      {
-        MITK_ERROR << "Could not create ZIP file from " << m_WorkingDirectory << "\nReason: " << e.what();
-        return false;
-      }
-      return true;
-    }
+  RemoveTempDirectory(m_WorkingDirectory);
+
+  file.close();
+  if (file.fail())
+  {
+    MITK_ERROR << "Could not write scene to '" << filename << "'";
+    removeTemporaryFile();
+    return false;
+  }
+
+  try
+  {
+    Poco::File(temporaryFilename).renameTo(filename);
   }
   catch (std::exception &e)
   {
-    MITK_ERROR << "Caught exception during saving temporary files to disk. Error description: '" << e.what() << "'";
+    MITK_ERROR << "Could not replace '" << filename << "'\nReason: " << e.what();
+    removeTemporaryFile();
     return false;
   }
+
+  return true;
 }
 
-tinyxml2::XMLElement *mitk::SceneIO::SaveBaseData(tinyxml2::XMLDocument &doc, BaseData *data, const std::string &filenamehint, bool &error)
+tinyxml2::XMLElement *mitk::SceneIO::SaveBaseData(tinyxml2::XMLDocument &doc, Poco::Zip::Compress &archive, BaseData *data, const std::string &filenamehint, bool &error)
 {
   assert(data);
   error = true;
@@ -513,6 +597,15 @@ tinyxml2::XMLElement *mitk::SceneIO::SaveBaseData(tinyxml2::XMLDocument &doc, Ba
       {
         MITK_ERROR << "Serializer " << serializer->GetNameOfClass() << " failed: " << e.what();
       }
+
+      // move everything the serializer wrote (usually one file) to the archive
+      for (const auto &entry : fs::directory_iterator(defaultLocale_WorkingDirectory))
+      {
+        if (!error && fs::is_regular_file(entry.path()))
+          AddFileToArchive(archive, entry.path());
+
+        fs::remove_all(entry.path());
+      }
       break;
     }
   }
@@ -521,7 +614,7 @@ tinyxml2::XMLElement *mitk::SceneIO::SaveBaseData(tinyxml2::XMLDocument &doc, Ba
   return element;
 }
 
-tinyxml2::XMLElement *mitk::SceneIO::SavePropertyList(tinyxml2::XMLDocument &doc, PropertyList *propertyList, const std::string &filenamehint)
+tinyxml2::XMLElement *mitk::SceneIO::SavePropertyList(tinyxml2::XMLDocument &doc, Poco::Zip::Compress &archive, PropertyList *propertyList, const std::string &filenamehint)
 {
   assert(propertyList);
 
@@ -533,12 +626,15 @@ tinyxml2::XMLElement *mitk::SceneIO::SavePropertyList(tinyxml2::XMLDocument &doc
 
   serializer->SetPropertyList(propertyList);
   serializer->SetFilenameHint(filenamehint);
-  std::string defaultLocale_WorkingDirectory = Poco::Path::transcode( m_WorkingDirectory );
-  serializer->SetWorkingDirectory(defaultLocale_WorkingDirectory);
   try
   {
-    std::string writtenfilename = serializer->Serialize();
+    std::ostringstream stream;
+    std::string writtenfilename = serializer->Serialize(stream);
     element->SetAttribute("file", writtenfilename.c_str());
+
+    if (!writtenfilename.empty())
+      AddXMLToArchive(archive, stream.str(), writtenfilename);
+
     PropertyList::Pointer failedProperties = serializer->GetFailedProperties();
     if (failedProperties.IsNotNull())
     {
@@ -563,16 +659,3 @@ const mitk::PropertyList *mitk::SceneIO::GetFailedProperties()
 {
   return m_FailedProperties;
 }
-
-void mitk::SceneIO::OnUnzipError(const void * /*pSender*/,
-                                 std::pair<const Poco::Zip::ZipLocalFileHeader, const std::string> &info)
-{
-  ++m_UnzipErrors;
-  MITK_ERROR << "Error while unzipping: " << info.second;
-}
-
-void mitk::SceneIO::OnUnzipOk(const void * /*pSender*/,
-                              std::pair<const Poco::Zip::ZipLocalFileHeader, const Poco::Path> & /*info*/)
-{
-  // MITK_INFO << "Unzipped ok: " << info.second.toString();
-}
@@ -11,9 +11,24 @@ found in the LICENSE file.
 ============================================================================*/
 
 #include "mitkSceneReader.h"
+#include "mitkSceneArchive.h"
 #include <tinyxml2.h>
 
 bool mitk::SceneReader::LoadScene(tinyxml2::XMLDocument &document, const std::string &workingDirectory, DataStorage *storage)
+{
+  try
+  {
+    SceneArchive archive(workingDirectory);
+    return this->LoadScene(document, archive, storage);
+  }
+  catch (const std::exception &e)
+  {
+    MITK_ERROR << "Cannot open scene directory " << workingDirectory << ": " << e.what();
+    return false;
+  }
+}
+
+bool mitk::SceneReader::LoadScene(tinyxml2::XMLDocument &document, const SceneArchive &archive, DataStorage *storage)
 {
   // find version node --> note version in some variable
   int fileVersion = 1;
@@ -22,7 +37,7 @@ bool mitk::SceneReader::LoadScene(tinyxml2::XMLDocument &document, const std::st
   {
     if (versionObject->QueryIntAttribute("FileVersion", &fileVersion) != tinyxml2::XML_SUCCESS)
     {
-      MITK_ERROR << "Scene file " << workingDirectory + "/index.xml"
+      MITK_ERROR << "Scene file " << archive.GetLocation() + "/index.xml"
                  << " does not contain version information! Trying version 1 format." << std::endl;
     }
   }
@@ -46,10 +61,10 @@ bool mitk::SceneReader::LoadScene(tinyxml2::XMLDocument &document, const std::st
   {
     if (auto *reader = dynamic_cast<SceneReader *>(iter->GetPointer()))
     {
-      if (!reader->LoadScene(document, workingDirectory, storage))
+      if (!reader->LoadScene(document, archive, storage))
       {
         MITK_ERROR << "There were errors while loading scene file "
-                   << workingDirectory + "/index.xml. Your data may be corrupted";
+                   << archive.GetLocation() + "/index.xml. Your data may be corrupted";
         return false;
       }
       else
@@ -11,18 +11,21 @@ found in the LICENSE file.
 ============================================================================*/
 
 #include "mitkSceneReaderV1.h"
-#include "Poco/Path.h"
 #include "mitkBaseRenderer.h"
-#include "mitkIOUtil.h"
 #include "mitkProgressBar.h"
 #include "mitkPropertyListDeserializer.h"
+#include "mitkSceneArchive.h"
 #include "mitkSerializerMacros.h"
 #include <mitkUIDManipulator.h>
 #include <mitkRenderingModeProperty.h>
 #include <tinyxml2.h>
 
 #include <mitkFileSystem.h>
+
+#include <algorithm>
+#include <atomic>
 #include <map>
+#include <thread>
 
 MITK_REGISTER_SERIALIZER(SceneReaderV1)
 
@@ -77,28 +80,40 @@ namespace
       geometry->SetStepDuration(value);
   }
 
-  mitk::PropertyList::Pointer DeserializeProperties(const tinyxml2::XMLElement *propertiesElement, const fs::path& basePath)
+  mitk::PropertyListDeserializer::Pointer CreatePropertyListDeserializer(const std::string &filename,
+                                                                         const mitk::SceneArchive &archive)
+  {
+    auto deserializer = mitk::PropertyListDeserializer::New();
+    deserializer->SetFilename((fs::path(archive.GetLocation()) / filename).string());
+
+    // Parse the property list from memory instead of extracting it
+    std::string content;
+
+    if (archive.ReadMember(filename, content))
+      deserializer->SetContent(content);
+
+    return deserializer;
+  }
+
+  mitk::PropertyList::Pointer DeserializeProperties(const tinyxml2::XMLElement *propertiesElement,
+                                                    const mitk::SceneArchive &archive)
   {
     if (propertiesElement == nullptr)
       return nullptr;
 
-    fs::path path(propertiesElement->Attribute("file"));
+    const char *filename = propertiesElement->Attribute("file");
 
-    if (path.empty())
+    if (filename == nullptr || strlen(filename) == 0)
       return nullptr;
 
-    if (!basePath.empty())
-      path = basePath / path;
-
-    auto deserializer = mitk::PropertyListDeserializer::New();
-    deserializer->SetFilename(path.string());
+    auto deserializer = CreatePropertyListDeserializer(filename, archive);
     deserializer->Deserialize();
 
     return deserializer->GetOutput();
   }
 }
 
-bool mitk::SceneReaderV1::LoadScene(tinyxml2::XMLDocument &document, const std::string &workingDirectory, DataStorage *storage)
+bool mitk::SceneReaderV1::LoadScene(tinyxml2::XMLDocument &document, const SceneArchive &archive, DataStorage *storage)
 {
   assert(storage);
   bool error(false);
@@ -140,13 +155,16 @@ bool mitk::SceneReaderV1::LoadScene(tinyxml2::XMLDocument &document, const std::
 
     if (dataElement != nullptr)
     {
-      auto properties = DeserializeProperties(dataElement->FirstChildElement("properties"), workingDirectory);
+      auto properties = DeserializeProperties(dataElement->FirstChildElement("properties"), archive);
 
       if (properties.IsNotNull())
         baseDataPropertyLists[uid] = properties;
     }
   }
 
+  std::vector<const tinyxml2::XMLElement *> dataElements;
+  std::vector<PropertyList *> dataProperties;
+
   for (auto *element = document.FirstChildElement("node"); element != nullptr;
        element = element->NextSiblingElement("node"))
   {
@@ -161,8 +179,43 @@ bool mitk::SceneReaderV1::LoadScene(tinyxml2::XMLDocument &document, const std::
         properties = iter->second;
     }
 
-    const auto *dataElement = element->FirstChildElement("data");
-    auto dataNode = this->LoadBaseDataFromDataTag(dataElement, properties, workingDirectory, error);
+    dataElements.push_back(element->FirstChildElement("data"));
+    dataProperties.push_back(properties);
+  }
+
+  // The base data of the nodes is independent from each other, so it is read concurrently.
+  // Nodes are created in document order afterwards.
+  const auto numberOfNodes = dataElements.size();
+  const auto numberOfDataElements = static_cast<std::size_t>(
+    std::count_if(dataElements.begin(), dataElements.end(), [](const tinyxml2::XMLElement *e) { return e != nullptr; }));
+
+  std::vector<BaseData::Pointer> baseDataOfNodes(numberOfNodes);
+  std::vector<std::string> errorMessages(numberOfNodes);
+  std::atomic<std::size_t> nextNode(0);
+
+  auto loadBaseData = [&]() {
+    for (auto i = nextNode++; i < numberOfNodes; i = nextNode++)
+    {
+      if (dataElements[i] != nullptr)
+        baseDataOfNodes[i] = this->LoadBaseData(dataElements[i], dataProperties[i], archive, errorMessages[i]);
+    }
+  };
+
+  const auto numberOfThreads = std::min<std::size_t>(numberOfDataElements, std::max(1u, std::thread::hardware_concurrency()));
+  std::vector<std::thread> threads;
+
+  for (std::size_t i = 1; i < numberOfThreads; ++i)
+    threads.emplace_back(loadBaseData);
+
+  loadBaseData();
+
+  for (auto &thread : threads)
+    thread.join();
+
+  for (std::size_t i = 0; i < numberOfNodes; ++i)
+  {
+    auto *properties = dataProperties[i];
+    auto dataNode = this->CreateNodeFromData(dataElements[i], baseDataOfNodes[i], errorMessages[i], error);
 
     if (dataNode.IsNull())
       continue;
@@ -208,7 +261,7 @@ bool mitk::SceneReaderV1::LoadScene(tinyxml2::XMLDocument &document, const std::
     //        - instantiate the appropriate PropertyListDeSerializer
     //        - use them to construct PropertyList objects
     //        - add these properties to the node (if necessary, use renderwindow name)
-    bool success = DecorateNodeWithProperties(node, element, workingDirectory);
+    bool success = DecorateNodeWithProperties(node, element, archive);
     if (!success)
     {
       MITK_ERROR << "Could not load properties for node.";
@@ -322,43 +375,69 @@ bool mitk::SceneReaderV1::LoadScene(tinyxml2::XMLDocument &document, const std::
 
 mitk::DataNode::Pointer mitk::SceneReaderV1::LoadBaseDataFromDataTag(const tinyxml2::XMLElement *dataElement,
                                                                      const PropertyList *properties,
-                                                                     const std::string &workingDirectory,
+                                                                     const SceneArchive &archive,
                                                                      bool &error)
 {
-  DataNode::Pointer node;
+  BaseData::Pointer baseData;
+  std::string errorMessage;
 
   if (dataElement)
+    baseData = this->LoadBaseData(dataElement, properties, archive, errorMessage);
+
+  return this->CreateNodeFromData(dataElement, baseData, errorMessage, error);
+}
+
+mitk::BaseData::Pointer mitk::SceneReaderV1::LoadBaseData(const tinyxml2::XMLElement *dataElement,
+                                                          const PropertyList *properties,
+                                                          const SceneArchive &archive,
+                                                          std::string &errorMessage) const
+{
+  const char *filename = dataElement->Attribute("file");
+
+  if (filename == nullptr || strlen(filename) == 0)
   {
-    const char *filename = dataElement->Attribute("file");
-    if (filename && strlen(filename) != 0)
-    {
-      try
-      {
-        auto baseData = IOUtil::Load(workingDirectory + Poco::Path::separator() + filename, properties);
+    errorMessage = "File attribute of data tag is empty!";
+    return nullptr;
+  }
 
-        node = DataNode::New();
-        node->SetData(baseData);
-      }
-      catch (std::exception &e)
-      {
-        MITK_ERROR << "Error during attempt to read '" << filename << "'. Exception says: " << e.what();
-        error = true;
-      }
+  try
+  {
+    return archive.LoadData(filename, properties).front();
+  }
+  catch (std::exception &e)
+  {
+    errorMessage = std::string("Error during attempt to read '") + filename + "'. Exception says: " + e.what();
+  }
+  catch (...)
+  {
+    errorMessage = std::string("Error during attempt to read '") + filename + "'. Unknown exception.";
+  }
 
-      if (node.IsNull())
-      {
-        MITK_ERROR << "Error during attempt to read '" << filename << "'. Factory returned nullptr object.";
-        error = true;
-      }
+  return nullptr;
+}
+
+mitk::DataNode::Pointer mitk::SceneReaderV1::CreateNodeFromData(const tinyxml2::XMLElement *dataElement,
+                                                                BaseData *baseData,
+                                                                const std::string &errorMessage,
+                                                                bool &error)
+{
+  DataNode::Pointer node;
+
+  if (dataElement)
+  {
+    if (baseData != nullptr)
+    {
+      node = DataNode::New();
+      node->SetData(baseData);
     }
     else
     {
-      MITK_ERROR << "File attribute of data tag is empty!";
+      MITK_ERROR << errorMessage;
       error = true;
     }
 
     const char* dataUID = dataElement->Attribute("UID");
-    if (!error && dataUID != nullptr)
+    if (node.IsNotNull() && dataUID != nullptr)
     {
       UIDManipulator manip(node->GetData());
       manip.SetUID(dataUID);
@@ -425,7 +504,7 @@ void mitk::SceneReaderV1::ClearNodePropertyListWithExceptions(DataNode &node, Pr
 
 bool mitk::SceneReaderV1::DecorateNodeWithProperties(DataNode *node,
                                                      const tinyxml2::XMLElement *nodeElement,
-                                                     const std::string &workingDirectory)
+                                                     const SceneArchive &archive)
 {
   assert(node);
   assert(nodeElement);
@@ -445,9 +524,7 @@ bool mitk::SceneReaderV1::DecorateNodeWithProperties(DataNode *node,
     ClearNodePropertyListWithExceptions(*node, *propertyList);
 
     // use deserializer to construct new properties
-    PropertyListDeserializer::Pointer deserializer = PropertyListDeserializer::New();
-
-    deserializer->SetFilename(workingDirectory + Poco::Path::separator() + propertiesfile);
+    PropertyListDeserializer::Pointer deserializer = CreatePropertyListDeserializer(propertiesfile, archive);
     bool success = deserializer->Deserialize();
     error |= !success;
     PropertyList::Pointer readProperties = deserializer->GetOutput();
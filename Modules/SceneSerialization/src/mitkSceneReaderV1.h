@@ -30,9 +30,9 @@ namespace mitk
     itkFactorylessNewMacro(Self);
     itkCloneMacro(Self);
 
-    bool LoadScene(tinyxml2::XMLDocument &document,
-                             const std::string &workingDirectory,
-                             DataStorage *storage) override;
+    using SceneReader::LoadScene;
+
+    bool LoadScene(tinyxml2::XMLDocument &document, const SceneArchive &archive, DataStorage *storage) override;
 
   protected:
     /**
@@ -40,13 +40,31 @@ namespace mitk
     */
     DataNode::Pointer LoadBaseDataFromDataTag(const tinyxml2::XMLElement *dataElement,
                                               const PropertyList *properties,
-                                              const std::string &workingDirectory,
+                                              const SceneArchive &archive,
                                               bool &error);
 
+    /**
+      \brief reads the BaseData of a given XML \<data\> element
+
+      Does not log errors but returns a message via errorMessage, so it can be called concurrently for several elements.
+    */
+    BaseData::Pointer LoadBaseData(const tinyxml2::XMLElement *dataElement,
+                                   const PropertyList *properties,
+                                   const SceneArchive &archive,
+                                   std::string &errorMessage) const;
+
+    /**
+      \brief creates one DataNode for the BaseData read by LoadBaseData() (logs errorMessage if baseData is nullptr)
+    */
+    DataNode::Pointer CreateNodeFromData(const tinyxml2::XMLElement *dataElement,
+                                         BaseData *baseData,
+                                         const std::string &errorMessage,
+                                         bool &error);
+
     /**
       \brief reads all the properties from the XML document and recreates them in node
     */
-    bool DecorateNodeWithProperties(DataNode *node, const tinyxml2::XMLElement *nodeElement, const std::string &workingDirectory);
+    bool DecorateNodeWithProperties(DataNode *node, const tinyxml2::XMLElement *nodeElement, const SceneArchive &archive);
 
     /**
       \brief Clear a default property list and handle some exceptions.
@@ -16,8 +16,19 @@ found in the LICENSE file.
 
 #include "mitkDataStorageCompare.h"
 #include "mitkIOUtil.h"
+#include "mitkImageGenerator.h"
+#include "mitkPointSet.h"
 #include "mitkSceneIO.h"
 #include "mitkSceneIOTestScenarioProvider.h"
+#include "mitkStandaloneDataStorage.h"
+
+#include <Poco/File.h>
+#include <Poco/Path.h>
+#include <Poco/Zip/Decompress.h>
+#include <Poco/Zip/ZipArchive.h>
+
+#include <fstream>
+#include <vector>
 
 /**
   \brief Test cases for SceneIO.
@@ -78,10 +89,48 @@ class mitkSceneIOTest2Suite : public mitk::TestFixture
   CPPUNIT_TEST_SUITE(mitkSceneIOTest2Suite);
   MITK_TEST(Test_SceneIOInterfaces);
   MITK_TEST(Test_ReconstructionOfScenes);
+  MITK_TEST(Test_ImageMembersAreStored);
+  MITK_TEST(Test_LoadSceneUnzipped);
+  MITK_TEST(Test_SaveSceneOverExistingFile);
   CPPUNIT_TEST_SUITE_END();
 
   mitk::SceneIOTestScenarioProvider m_TestCaseProvider;
 
+  /// Several images and point sets, so that their data is read concurrently.
+  static mitk::DataStorage::Pointer CreateStorageWithData()
+  {
+    mitk::DataStorage::Pointer storage = mitk::StandaloneDataStorage::New().GetPointer();
+
+    for (int i = 0; i < 4; ++i)
+    {
+      auto imageNode = mitk::DataNode::New();
+      imageNode->SetName("Image-" + std::to_string(i));
+      imageNode->SetData(mitk::ImageGenerator::GenerateRandomImage<short>(40, 30, 20, 1, 0.5, 0.5, 1, 3000, -1000));
+      storage->Add(imageNode);
+
+      auto pointSet = mitk::PointSet::New();
+      mitk::PointSet::PointType p;
+      mitk::FillVector3D(p, 1.0 * i, -2.0, 33.0);
+      pointSet->SetPoint(0, p);
+
+      auto pointSetNode = mitk::DataNode::New();
+      pointSetNode->SetName("PointSet-" + std::to_string(i));
+      pointSetNode->SetData(pointSet);
+      storage->Add(pointSetNode, imageNode);
+    }
+
+    return storage;
+  }
+
+  static bool CompareStorages(const mitk::DataStorage *original, const mitk::DataStorage *restored)
+  {
+    return mitk::DataStorageCompare(original,
+                                    restored,
+                                    mitk::DataStorageCompare::CMP_Hierarchy | mitk::DataStorageCompare::CMP_Data |
+                                      mitk::DataStorageCompare::CMP_Properties)
+      .CompareVerbose();
+  }
+
 public:
   void Test_SceneIOInterfaces() { CPPUNIT_ASSERT_MESSAGE("Not urgent", true); }
   void Test_ReconstructionOfScenes()
@@ -125,6 +174,86 @@ public:
     }
   }
 
+  void Test_ImageMembersAreStored()
+  {
+    std::string tempDir = mitk::IOUtil::CreateTemporaryDirectory("SceneIOTest_XXXXXX");
+    std::string archiveFilename = mitk::IOUtil::CreateTemporaryFile("scene_XXXXXX.mitk", tempDir);
+
+    mitk::DataStorage::Pointer originalStorage = CreateStorageWithData();
+    CPPUNIT_ASSERT(mitk::SceneIO::New()->SaveScene(originalStorage->GetAll(), originalStorage, archiveFilename));
+
+    {
+      std::ifstream file(archiveFilename, std::ios::binary);
+      Poco::Zip::ZipArchive archive(file);
+
+      CPPUNIT_ASSERT(archive.findHeader("index.xml") != archive.headerEnd());
+
+      int numberOfImages = 0;
+      for (auto iter = archive.headerBegin(); iter != archive.headerEnd(); ++iter)
+      {
+        if (Poco::Path(iter->first).getExtension() == "nrrd")
+        {
+          // NRRD images are compressed already and must not be deflated once more
+          CPPUNIT_ASSERT_EQUAL(Poco::Zip::ZipCommon::CM_STORE, iter->second.getCompressionMethod());
+          ++numberOfImages;
+        }
+      }
+      CPPUNIT_ASSERT_EQUAL(4, numberOfImages);
+    }
+
+    mitk::DataStorage::Pointer restoredStorage;
+    CPPUNIT_ASSERT_NO_THROW(restoredStorage = mitk::SceneIO::New()->LoadScene(archiveFilename));
+    CPPUNIT_ASSERT(CompareStorages(originalStorage, restoredStorage));
+
+    Poco::File(tempDir).remove(true);
+  }
+
+  void Test_LoadSceneUnzipped()
+  {
+    std::string tempDir = mitk::IOUtil::CreateTemporaryDirectory("SceneIOTest_XXXXXX");
+    std::string archiveFilename = mitk::IOUtil::CreateTemporaryFile("scene_XXXXXX.mitk", tempDir);
+    std::string sceneDir = mitk::IOUtil::CreateTemporaryDirectory("scene_XXXXXX", tempDir);
+
+    mitk::DataStorage::Pointer originalStorage = CreateStorageWithData();
+    CPPUNIT_ASSERT(mitk::SceneIO::New()->SaveScene(originalStorage->GetAll(), originalStorage, archiveFilename));
+
+    {
+      std::ifstream file(archiveFilename, std::ios::binary);
+      Poco::Zip::Decompress unzipper(file, Poco::Path(sceneDir));
+      unzipper.decompressAllFiles();
+    }
+
+    mitk::DataStorage::Pointer restoredStorage;
+    CPPUNIT_ASSERT_NO_THROW(restoredStorage = mitk::SceneIO::New()->LoadSceneUnzipped(sceneDir + "/index.xml"));
+    CPPUNIT_ASSERT(CompareStorages(originalStorage, restoredStorage));
+
+    Poco::File(tempDir).remove(true);
+  }
+
+  void Test_SaveSceneOverExistingFile()
+  {
+    std::string tempDir = mitk::IOUtil::CreateTemporaryDirectory("SceneIOTest_XXXXXX");
+    std::string archiveFilename = mitk::IOUtil::CreateTemporaryFile("scene_XXXXXX.mitk", tempDir);
+
+    mitk::DataStorage::Pointer firstStorage = CreateStorageWithData();
+    CPPUNIT_ASSERT(mitk::SceneIO::New()->SaveScene(firstStorage->GetAll(), firstStorage, archiveFilename));
+
+    // The scene is written to a temporary file that replaces the existing one
+    mitk::DataStorage::Pointer secondStorage = CreateStorageWithData();
+    CPPUNIT_ASSERT(mitk::SceneIO::New()->SaveScene(secondStorage->GetAll(), secondStorage, archiveFilename));
+
+    std::vector<std::string> files;
+    Poco::File(tempDir).list(files);
+    CPPUNIT_ASSERT_EQUAL(std::size_t(1), files.size());
+    CPPUNIT_ASSERT_EQUAL(Poco::Path(archiveFilename).getFileName(), files.front());
+
+    mitk::DataStorage::Pointer restoredStorage;
+    CPPUNIT_ASSERT_NO_THROW(restoredStorage = mitk::SceneIO::New()->LoadScene(archiveFilename));
+    CPPUNIT_ASSERT(CompareStorages(secondStorage, restoredStorage));
+
+    Poco::File(tempDir).remove(true);
+  }
+
 }; // class
 
 int mitkSceneIOTest2(int /*argc*/, char * /*argv*/ [])
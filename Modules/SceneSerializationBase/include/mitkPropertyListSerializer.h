@@ -19,6 +19,8 @@ found in the LICENSE file.
 
 #include <itkObjectFactoryBase.h>
 
+#include <iosfwd>
+
 namespace tinyxml2
 {
   class XMLDocument;
@@ -50,6 +52,12 @@ namespace mitk
       */
     virtual std::string Serialize();
 
+    /**
+      \brief Serializes given PropertyList object into a stream instead of a file in the working directory.
+      \return the filename under which the stream contents are expected, e.g. as member of a scene archive.
+      */
+    std::string Serialize(std::ostream &stream);
+
     PropertyList *GetFailedProperties();
 
   protected:
@@ -58,6 +66,14 @@ namespace mitk
 
     tinyxml2::XMLElement *SerializeOneProperty(tinyxml2::XMLDocument &doc, const std::string &key, const BaseProperty *property);
 
+    /**
+      \brief Creates the XML document of the property list.
+      \return false if there is no property list to serialize.
+      */
+    bool CreateDocument(tinyxml2::XMLDocument &document);
+
+    static std::string CreateUniqueFilename();
+
     std::string m_FilenameHint;
     std::string m_WorkingDirectory;
     PropertyList::Pointer m_PropertyList;
@@ -16,6 +16,8 @@ found in the LICENSE file.
 #include <itksys/SystemTools.hxx>
 #include <tinyxml2.h>
 
+#include <atomic>
+
 mitk::PropertyListSerializer::PropertyListSerializer() : m_FilenameHint("unnamed"), m_WorkingDirectory("")
 {
 }
@@ -26,25 +28,12 @@ mitk::PropertyListSerializer::~PropertyListSerializer()
 
 std::string mitk::PropertyListSerializer::Serialize()
 {
-  m_FailedProperties = PropertyList::New();
+  tinyxml2::XMLDocument document;
 
-  if (m_PropertyList.IsNull() || m_PropertyList->IsEmpty())
-  {
-    MITK_ERROR << "Not serializing nullptr or empty PropertyList";
+  if (!this->CreateDocument(document))
     return "";
-  }
 
-  // tmpname
-  static unsigned long count = 1;
-  unsigned long n = count++;
-  std::ostringstream name;
-  for (int i = 0; i < 6; ++i)
-  {
-    name << char('a' + (n % 26));
-    n /= 26;
-  }
-  std::string filename;
-  filename.append(name.str());
+  std::string filename = CreateUniqueFilename();
 
   std::string fullname(m_WorkingDirectory);
   fullname += "/";
@@ -57,7 +46,62 @@ std::string mitk::PropertyListSerializer::Serialize()
   if (length >= 2 && fullname[0] == '"' && fullname[length - 1] == '"')
     fullname = fullname.substr(1, length - 2);
 
+  // save XML file
+  if (tinyxml2::XML_SUCCESS != document.SaveFile(fullname.c_str()))
+  {
+    MITK_ERROR << "Could not write PropertyList to " << fullname << "\nTinyXML reports '" << document.ErrorStr()
+               << "'";
+    return "";
+  }
+
+  return filename;
+}
+
+std::string mitk::PropertyListSerializer::Serialize(std::ostream &stream)
+{
   tinyxml2::XMLDocument document;
+
+  if (!this->CreateDocument(document))
+    return "";
+
+  tinyxml2::XMLPrinter printer;
+  document.Print(&printer);
+
+  stream.write(printer.CStr(), printer.CStrSize() - 1);
+
+  if (!stream)
+  {
+    MITK_ERROR << "Could not write PropertyList to stream";
+    return "";
+  }
+
+  return CreateUniqueFilename();
+}
+
+std::string mitk::PropertyListSerializer::CreateUniqueFilename()
+{
+  // tmpname
+  static std::atomic<unsigned long> count(1);
+  unsigned long n = count++;
+  std::ostringstream name;
+  for (int i = 0; i < 6; ++i)
+  {
+    name << char('a' + (n % 26));
+    n /= 26;
+  }
+  return name.str();
+}
+
+bool mitk::PropertyListSerializer::CreateDocument(tinyxml2::XMLDocument &document)
+{
+  m_FailedProperties = PropertyList::New();
+
+  if (m_PropertyList.IsNull() || m_PropertyList->IsEmpty())
+  {
+    MITK_ERROR << "Not serializing nullptr or empty PropertyList";
+    return false;
+  }
+
   document.InsertEndChild(document.NewDeclaration());
 
   auto *version = document.NewElement("Version");
@@ -84,15 +128,7 @@ std::string mitk::PropertyListSerializer::Serialize()
     }
   }
 
-  // save XML file
-  if (tinyxml2::XML_SUCCESS != document.SaveFile(fullname.c_str()))
-  {
-    MITK_ERROR << "Could not write PropertyList to " << fullname << "\nTinyXML reports '" << document.ErrorStr()
-               << "'";
-    return "";
-  }
-
-  return filename;
+  return true;
 }
 
 tinyxml2::XMLElement *mitk::PropertyListSerializer::SerializeOneProperty(tinyxml2::XMLDocument &doc, const std::string &key, const BaseProperty *property)
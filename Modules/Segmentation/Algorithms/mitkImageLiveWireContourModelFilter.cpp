@@ -17,6 +17,9 @@ found in the LICENSE file.
 #include <itkImageRegionIterator.h>
 
 #include "mitkIOUtil.h"
+#include "mitkLiveWireCostTermsCache.h"
+
+#include <algorithm>
 
 mitk::ImageLiveWireContourModelFilter::ImageLiveWireContourModelFilter()
 {
@@ -27,8 +30,10 @@ mitk::ImageLiveWireContourModelFilter::ImageLiveWireContourModelFilter()
   m_CostFunction = CostFunctionType::New();
   m_ShortestPathFilter = ShortestPathImageFilterType::New();
   m_ShortestPathFilter->SetCostFunction(m_CostFunction);
+  m_ShortestPathFilter->UseBidirectionalSearchOn();
   m_UseDynamicCostMap = false;
   m_TimeStep = 0;
+  m_CostTermsTimeStep = 0;
 }
 
 mitk::ImageLiveWireContourModelFilter::~ImageLiveWireContourModelFilter()
@@ -40,6 +45,12 @@ mitk::ImageLiveWireContourModelFilter::OutputType *mitk::ImageLiveWireContourMod
   return Superclass::GetOutput();
 }
 
+void mitk::ImageLiveWireContourModelFilter::SetCostTermsCacheKey(const Image *referenceImage, TimeStepType timeStep)
+{
+  m_CostTermsReferenceImage = referenceImage;
+  m_CostTermsTimeStep = timeStep;
+}
+
 void mitk::ImageLiveWireContourModelFilter::SetInput(const mitk::ImageLiveWireContourModelFilter::InputType *input)
 {
   this->SetInput(0, input);
@@ -134,6 +145,25 @@ void mitk::ImageLiveWireContourModelFilter::ItkPreProcessImage(const itk::Image<
   m_InternalImage = castFilter->GetOutput();
   m_CostFunction->SetImage(m_InternalImage);
   m_ShortestPathFilter->SetInput(m_InternalImage);
+
+  // share the cost terms with all filters on the same slice
+  auto referenceImage = m_CostTermsReferenceImage.Lock();
+
+  if (referenceImage.IsNotNull())
+  {
+    auto cache = LiveWireCostTermsCache::GetInstance();
+    auto sliceGeometry = this->GetInput()->GetGeometry();
+    auto costTerms = cache->Get(referenceImage, m_CostTermsTimeStep, sliceGeometry);
+
+    if (costTerms.IsNull())
+    {
+      costTerms = itk::LiveWireCostTerms::New();
+      costTerms->Compute(m_InternalImage);
+      cache->Insert(referenceImage, m_CostTermsTimeStep, sliceGeometry, costTerms);
+    }
+
+    m_CostFunction->SetCostTerms(costTerms);
+  }
 }
 
 void mitk::ImageLiveWireContourModelFilter::ClearRepulsivePoints()
@@ -209,6 +239,10 @@ void mitk::ImageLiveWireContourModelFilter::UpdateLiveWire()
   // m_ShortestPathFilter->SetInput( m_CostFunction->SetImage(m_InternalImage) );
   m_ShortestPathFilter->SetMakeOutputImage(false);
 
+  // Only search in a corridor around start and end point, which is generous enough for paths that follow edges
+  // around the direct line. The search falls back to the whole image if there is no path within the corridor.
+  m_ShortestPathFilter->SetSearchCorridorMargin(std::max(32u, static_cast<unsigned int>(std::max(size[0], size[1]))));
+
   // m_ShortestPathFilter->SetCalcAllDistances(true);
   m_ShortestPathFilter->SetStartIndex(startPoint);
   m_ShortestPathFilter->SetEndIndex(endPoint);
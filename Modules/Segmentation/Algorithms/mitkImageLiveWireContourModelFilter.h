@@ -21,6 +21,7 @@ found in the LICENSE file.
 #include <mitkImage.h>
 #include <mitkImageAccessByItk.h>
 #include <mitkImageCast.h>
+#include <mitkWeakPointer.h>
 
 #include <itkShortestPathCostFunctionLiveWire.h>
 #include <itkShortestPathImageFilter.h>
@@ -39,6 +40,10 @@ namespace mitk
    \note On the fly training will only be used for next update.
    The computation uses the last calculated segment to map cost according to features in the area of the segment.
 
+   The cost terms of a slice are shared with other filters on the same slice via the LiveWireCostTermsCache,
+   if the reference image the slice was extracted from is set by SetCostTermsCacheKey().
+   \sa LiveWireCostTermsCache
+
    Caution: time support currently not available. Filter will always work on the first
    timestep in its current implementation.
 
@@ -92,6 +97,12 @@ namespace mitk
     */
     void RemoveRepulsivePoint(const itk::Index<2> &idx);
 
+    /** \brief Identifies the input slice by the image and time step it was extracted from.
+    If set, the cost terms of the slice are taken from or stored in the LiveWireCostTermsCache.
+    \note Has to be called before the slice is set as input.
+    */
+    void SetCostTermsCacheKey(const Image *referenceImage, TimeStepType timeStep);
+
     virtual void SetInput(const InputType *input);
 
     using Superclass::SetInput;
@@ -144,6 +155,10 @@ namespace mitk
 
     unsigned int m_TimeStep;
 
+    /** \brief Reference image and time step of the input slice for the LiveWireCostTermsCache*/
+    WeakPointer<const Image> m_CostTermsReferenceImage;
+    TimeStepType m_CostTermsTimeStep;
+
     template <typename TPixel, unsigned int VImageDimension>
     void ItkPreProcessImage(const itk::Image<TPixel, VImageDimension> *inputImage);
 
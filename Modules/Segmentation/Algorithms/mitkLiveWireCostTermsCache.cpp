@@ -0,0 +1,126 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include "mitkLiveWireCostTermsCache.h"
+
+#include <algorithm>
+
+namespace
+{
+  bool IsMatching(const mitk::Image *referenceImage,
+                  mitk::TimeStepType timeStep,
+                  const mitk::BaseGeometry *sliceGeometry,
+                  const mitk::Image *entryImage,
+                  itk::ModifiedTimeType entryMTime,
+                  mitk::TimeStepType entryTimeStep,
+                  const mitk::BaseGeometry *entryGeometry)
+  {
+    return entryImage == referenceImage && entryMTime == referenceImage->GetMTime() && entryTimeStep == timeStep &&
+           mitk::Equal(*entryGeometry, *sliceGeometry, mitk::eps);
+  }
+}
+
+mitk::LiveWireCostTermsCache::LiveWireCostTermsCache()
+  : m_MaximumNumberOfEntries(4)
+{
+}
+
+mitk::LiveWireCostTermsCache *mitk::LiveWireCostTermsCache::GetInstance()
+{
+  static LiveWireCostTermsCache s_Instance;
+  return &s_Instance;
+}
+
+itk::LiveWireCostTerms::Pointer mitk::LiveWireCostTermsCache::Get(const Image *referenceImage,
+                                                                   TimeStepType timeStep,
+                                                                   const BaseGeometry *sliceGeometry)
+{
+  if (nullptr == referenceImage || nullptr == sliceGeometry)
+    return nullptr;
+
+  std::lock_guard<std::mutex> lock(m_Mutex);
+
+  this->RemoveExpiredEntries();
+
+  for (auto iter = m_Entries.begin(); iter != m_Entries.end(); ++iter)
+  {
+    if (IsMatching(referenceImage, timeStep, sliceGeometry, iter->ReferenceImage.Lock(), iter->ReferenceImageMTime,
+                   iter->TimeStep, iter->SliceGeometry))
+    {
+      // mark as most recently used
+      m_Entries.splice(m_Entries.begin(), m_Entries, iter);
+      return m_Entries.front().CostTerms;
+    }
+  }
+
+  return nullptr;
+}
+
+void mitk::LiveWireCostTermsCache::Insert(const Image *referenceImage,
+                                          TimeStepType timeStep,
+                                          const BaseGeometry *sliceGeometry,
+                                          itk::LiveWireCostTerms *costTerms)
+{
+  if (nullptr == referenceImage || nullptr == sliceGeometry || nullptr == costTerms)
+    return;
+
+  Entry entry;
+  entry.ReferenceImage = referenceImage;
+  entry.ReferenceImageMTime = referenceImage->GetMTime();
+  entry.TimeStep = timeStep;
+  entry.SliceGeometry = sliceGeometry->Clone().GetPointer();
+  entry.CostTerms = costTerms;
+
+  std::lock_guard<std::mutex> lock(m_Mutex);
+
+  this->RemoveExpiredEntries();
+
+  m_Entries.remove_if([&](const Entry &other) {
+    return IsMatching(referenceImage, timeStep, sliceGeometry, other.ReferenceImage.Lock(), other.ReferenceImageMTime,
+                      other.TimeStep, other.SliceGeometry);
+  });
+
+  m_Entries.push_front(std::move(entry));
+
+  while (m_Entries.size() > m_MaximumNumberOfEntries)
+    m_Entries.pop_back();
+}
+
+void mitk::LiveWireCostTermsCache::Clear()
+{
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  m_Entries.clear();
+}
+
+void mitk::LiveWireCostTermsCache::SetMaximumNumberOfEntries(std::size_t numberOfEntries)
+{
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  m_MaximumNumberOfEntries = std::max<std::size_t>(1, numberOfEntries);
+
+  while (m_Entries.size() > m_MaximumNumberOfEntries)
+    m_Entries.pop_back();
+}
+
+std::size_t mitk::LiveWireCostTermsCache::GetMaximumNumberOfEntries() const
+{
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  return m_MaximumNumberOfEntries;
+}
+
+void mitk::LiveWireCostTermsCache::RemoveExpiredEntries()
+{
+  // entries of deleted or modified reference images are never hit again
+  m_Entries.remove_if([](const Entry &entry) {
+    auto referenceImage = entry.ReferenceImage.Lock();
+    return referenceImage.IsNull() || referenceImage->GetMTime() != entry.ReferenceImageMTime;
+  });
+}
@@ -0,0 +1,79 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#ifndef mitkLiveWireCostTermsCache_h
+#define mitkLiveWireCostTermsCache_h
+
+#include <mitkImage.h>
+#include <mitkWeakPointer.h>
+#include <MitkSegmentationExports.h>
+
+#include <itkLiveWireCostTerms.h>
+
+#include <list>
+#include <mutex>
+
+namespace mitk
+{
+  /**
+   \brief Keeps the LiveWire cost terms of the most recently used slices.
+
+   Computing the cost terms is the expensive part of a LiveWire update. The terms only depend on the
+   slice of the reference image, so they are shared by all ImageLiveWireContourModelFilter instances
+   that work on the same slice. An entry is identified by the reference image, its modification time,
+   the time step and the geometry of the slice. The least recently used entries are discarded.
+
+   \sa ImageLiveWireContourModelFilter
+  */
+  class MITKSEGMENTATION_EXPORT LiveWireCostTermsCache
+  {
+  public:
+    /** \brief Returns an instance of the class */
+    static LiveWireCostTermsCache *GetInstance();
+
+    /** \brief Returns the cost terms of the slice or nullptr if they are not cached. */
+    itk::LiveWireCostTerms::Pointer Get(const Image *referenceImage,
+                                        TimeStepType timeStep,
+                                        const BaseGeometry *sliceGeometry);
+
+    void Insert(const Image *referenceImage,
+                TimeStepType timeStep,
+                const BaseGeometry *sliceGeometry,
+                itk::LiveWireCostTerms *costTerms);
+
+    void Clear();
+
+    /** \brief Default is 4, i.e. the current slice and its neighbors. */
+    void SetMaximumNumberOfEntries(std::size_t numberOfEntries);
+    std::size_t GetMaximumNumberOfEntries() const;
+
+  private:
+    struct Entry
+    {
+      WeakPointer<const Image> ReferenceImage;
+      itk::ModifiedTimeType ReferenceImageMTime;
+      TimeStepType TimeStep;
+      BaseGeometry::ConstPointer SliceGeometry;
+      itk::LiveWireCostTerms::Pointer CostTerms;
+    };
+
+    LiveWireCostTermsCache();
+
+    void RemoveExpiredEntries();
+
+    mutable std::mutex m_Mutex;
+    std::list<Entry> m_Entries;
+    std::size_t m_MaximumNumberOfEntries;
+  };
+}
+
+#endif
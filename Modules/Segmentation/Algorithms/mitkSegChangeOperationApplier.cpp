@@ -20,12 +20,15 @@ found in the LICENSE file.
 
 #include <mitkSegTool2D.h>
 #include <mitkRenderingManager.h>
+#include <mitkImageTimeSelector.h>
 
 #include <mitkUndoController.h>
 
 // VTK
 #include <vtkSmartPointer.h>
 
+#include <numeric>
+
 
 namespace
 {
@@ -84,7 +87,40 @@ namespace
   void ApplySliceOperation(mitk::SegSliceOperation* sliceOperation, mitk::MultiLabelSegmentation* segmentation)
   {
     auto relevantGroupImage = segmentation->GetGroupImage(sliceOperation->GetGroupID());
-    mitk::SegTool2D::WriteSliceToVolume(relevantGroupImage, sliceOperation->GetSlicePlaneGeometry(), sliceOperation->GetSlice(), sliceOperation->GetTimeStep());
+    const mitk::GroupSliceModifiedEvent sliceEvent(sliceOperation->GetGroupID());
+    const bool notifySliceChanges = segmentation->HasObserver(sliceEvent);
+    mitk::Image::Pointer originalSlice;
+    mitk::Image::Pointer slice;
+
+    if (sliceOperation->IsDifference())
+    {
+      // only the changed runs are stored, so they are applied to the current content of the slice
+      slice = mitk::SegTool2D::GetAffectedImageSliceAs2DImage(sliceOperation->GetSlicePlaneGeometry(), relevantGroupImage, sliceOperation->GetTimeStep());
+
+      if (notifySliceChanges)
+      {
+        originalSlice = slice->Clone();
+      }
+
+      sliceOperation->ApplyDifference(slice);
+    }
+    else
+    {
+      if (notifySliceChanges)
+      {
+        originalSlice = mitk::SegTool2D::GetAffectedImageSliceAs2DImage(sliceOperation->GetSlicePlaneGeometry(), relevantGroupImage, sliceOperation->GetTimeStep());
+      }
+
+      slice = sliceOperation->GetSlice();
+    }
+
+    const auto originalMTime = relevantGroupImage->GetMTime();
+    mitk::SegTool2D::WriteSliceToVolume(relevantGroupImage, sliceOperation->GetSlicePlaneGeometry(), slice, sliceOperation->GetTimeStep());
+
+    if (originalSlice.IsNotNull())
+    {
+      segmentation->GroupSliceModified(mitk::GroupSliceModifiedEvent(sliceOperation->GetGroupID(), sliceOperation->GetTimeStep(), sliceOperation->GetSlicePlaneGeometry(), originalSlice, slice, originalMTime));
+    }
     mitk::SegTool2D::UpdateAllSurfaceInterpolations(segmentation, sliceOperation->GetTimeStep(), sliceOperation->GetSlicePlaneGeometry(), true);
   }
 
@@ -92,6 +128,16 @@ namespace
   {
     segmentation->ReplaceLabels(labelPropModOperation->GetModifiedLabels());
   }
+
+  /** Creates a group modify operation that only stores labels and names. Group images are added as differences.*/
+  mitk::SegGroupModifyOperation* CreateGroupModifyOperationWithoutImages(mitk::MultiLabelSegmentation* segmentation,
+    const std::set<mitk::MultiLabelSegmentation::GroupIndexType>& relevantGroupIDs, bool noLabels, bool noNames)
+  {
+    if (noLabels && noNames)
+      return new mitk::SegGroupModifyOperation(segmentation, {}, {}, {});
+
+    return mitk::SegGroupModifyOperation::CreatFromSegmentation(segmentation, relevantGroupIDs, false, 0, noLabels, true, noNames);
+  }
 }
 
 
@@ -148,7 +194,33 @@ mitk::SegGroupModifyUndoRedoHelper::SegGroupModifyUndoRedoHelper(MultiLabelSegme
   m_CoverAllTimeSteps(coverAllTimeSteps), m_TimeStep(timeStep), m_NoLabels(noLabels), m_NoGroupImages(noGroupImages),
   m_NoNames(noNames), m_UndoOperation(nullptr)
 {
-  m_UndoOperation = SegGroupModifyOperation::CreatFromSegmentation(m_Segmentation, m_RelevantGroupIDs, m_CoverAllTimeSteps, m_TimeStep, m_NoLabels, m_NoGroupImages, m_NoNames);
+  if (nullptr == m_Segmentation)
+    mitkThrow() << "Invalid usage of SegGroupModifyUndoRedoHelper. Segmentation is not valid (nullptr).";
+
+  if (m_NoLabels && m_NoGroupImages && m_NoNames)
+    mitkThrow() << "Invalid usage of SegGroupModifyUndoRedoHelper. Arguments noLabels, noGroupImages and noNames must not be both true at the same time.";
+
+  if (!m_NoGroupImages)
+  {
+    std::vector<TimeStepType> relevantTSs({ m_TimeStep });
+    if (m_CoverAllTimeSteps)
+    {
+      relevantTSs.resize(m_Segmentation->GetTimeSteps());
+      std::iota(relevantTSs.begin(), relevantTSs.end(), 0);
+    }
+
+    for (auto groupID : m_RelevantGroupIDs)
+    {
+      for (auto aTimeStep : relevantTSs)
+      {
+        auto compressor = std::make_unique<CompressedImageContainer>();
+        compressor->CompressImage(SelectImageByTimeStep(m_Segmentation->GetGroupImage(groupID), aTimeStep));
+        m_OriginalGroupImages[groupID].emplace(aTimeStep, std::move(compressor));
+      }
+    }
+  }
+
+  m_UndoOperation = CreateGroupModifyOperationWithoutImages(m_Segmentation, m_RelevantGroupIDs, m_NoLabels, m_NoNames);
 }
 
 mitk::SegGroupModifyUndoRedoHelper::~SegGroupModifyUndoRedoHelper()
@@ -164,9 +236,22 @@ void mitk::SegGroupModifyUndoRedoHelper::RegisterUndoRedoOperationEvent(const st
   UndoStackItem::IncCurrGroupEventId();
   UndoStackItem::IncCurrObjectEventId();
 
-  auto redoOperation =
-    SegGroupModifyOperation::CreatFromSegmentation(m_Segmentation, m_RelevantGroupIDs, m_CoverAllTimeSteps, m_TimeStep,
-      m_NoLabels, m_NoGroupImages, m_NoNames);
+  auto undoOperation = static_cast<SegGroupModifyOperation*>(m_UndoOperation);
+  auto redoOperation = CreateGroupModifyOperationWithoutImages(m_Segmentation, m_RelevantGroupIDs, m_NoLabels, m_NoNames);
+
+  // undo and redo operation share the runs that were changed by the modification
+  // (the original images are decompressed one at a time)
+  for (const auto& [groupID, tsImageMap] : m_OriginalGroupImages)
+  {
+    for (const auto& [aTimeStep, compressedImage] : tsImageMap)
+    {
+      auto difference = std::make_shared<CompressedImageDifference>();
+      difference->ComputeDifference(compressedImage->DecompressImage(), SelectImageByTimeStep(m_Segmentation->GetGroupImage(groupID), aTimeStep));
+      undoOperation->SetGroupImageDifference(groupID, aTimeStep, difference, true);
+      redoOperation->SetGroupImageDifference(groupID, aTimeStep, difference, false);
+    }
+  }
+  m_OriginalGroupImages.clear();
 
   OperationEvent* undoStackItem =
     new OperationEvent(SegChangeOperationApplier::GetInstance(), redoOperation, m_UndoOperation, description);
@@ -14,6 +14,8 @@ found in the LICENSE file.
 #define mitkSegChangeOperationApplier_h
 
 #include "mitkCommon.h"
+#include <mitkCompressedImageContainer.h>
+#include <mitkLabelSetImage.h>
 #include <mitkOperationActor.h>
 #include <MitkSegmentationExports.h>
 
@@ -70,6 +72,10 @@ namespace mitk
     bool m_NoGroupImages;
     bool m_NoNames;
 
+    /** Compressed content of the relevant group images before the modification. When the operation event is
+     registered, only the difference to the modified group images is stored in the undo and redo operation.*/
+    std::map<MultiLabelSegmentation::GroupIndexType, std::map<TimeStepType, std::unique_ptr<CompressedImageContainer>>> m_OriginalGroupImages;
+
     SegChangeOperationBase* m_UndoOperation;
   };
 
@@ -22,8 +22,8 @@ mitk::SegGroupInsertOperation::SegGroupInsertOperation(MultiLabelSegmentation* s
 {
   for (auto& [groupID, image] : groupImages)
   {
-    auto compressor = std::make_unique<CompressedImageContainer>();
-    compressor->CompressImage(image);
+    auto compressor = std::make_unique<CompressedImageDifference>();
+    compressor->ComputeDifference(nullptr, image);
     m_Images.emplace(groupID, std::move(compressor));
   }
   for (auto& groupID : groupIDs)
@@ -61,7 +61,7 @@ mitk::Image::Pointer mitk::SegGroupInsertOperation::GetGroupImage(MultiLabelSegm
 {
   if (m_Images.cend() != m_Images.find(groupID))
   {
-    auto image = m_Images.at(groupID)->DecompressImage();
+    auto image = m_Images.at(groupID)->CreateAfterImage();
     return image;
   }
   
@@ -88,6 +88,16 @@ std::string mitk::SegGroupInsertOperation::GetGroupName(MultiLabelSegmentation::
   return "";
 }
 
+std::size_t mitk::SegGroupInsertOperation::GetMemorySize() const
+{
+  std::size_t size = 0;
+
+  for (const auto& [groupID, compressor] : m_Images)
+    size += compressor->GetMemorySize();
+
+  return size;
+}
+
 mitk::SegGroupInsertOperation* mitk::SegGroupInsertOperation::CreateFromSegmentation(
   MultiLabelSegmentation* segmentation,
   const GroupIndexSetType& relevantGroupIDs,
@@ -13,7 +13,7 @@ found in the LICENSE file.
 #ifndef mitkSegGroupInsertOperation_h
 #define mitkSegGroupInsertOperation_h
 
-#include "mitkCompressedImageContainer.h"
+#include "mitkCompressedImageDifference.h"
 #include <MitkSegmentationExports.h>
 #include <mitkSegChangeOperationBase.h>
 
@@ -53,6 +53,9 @@ namespace mitk
     MultiLabelSegmentation::ConstLabelVectorType GetGroupLabels(MultiLabelSegmentation::GroupIndexType groupID) const;
     std::string GetGroupName(MultiLabelSegmentation::GroupIndexType groupID) const;
 
+    /** \brief Returns the memory of the stored group images.*/
+    std::size_t GetMemorySize() const override;
+
     // Explicitly delete copy operations because internally std::unique_ptr are used.
     SegGroupInsertOperation(const SegGroupInsertOperation&) = delete;
     SegGroupInsertOperation& operator=(const SegGroupInsertOperation&) = delete;
@@ -62,7 +65,8 @@ namespace mitk
       bool noLabels = false, bool noGroupImages = false);
 
   protected:
-    using ModifyCompressedImageMapType = std::map<MultiLabelSegmentation::GroupIndexType, std::unique_ptr<CompressedImageContainer>>;
+    /** Group images are stored as difference to an empty image, so only their labeled runs occupy memory.*/
+    using ModifyCompressedImageMapType = std::map<MultiLabelSegmentation::GroupIndexType, std::unique_ptr<CompressedImageDifference>>;
     GroupIndexSetType m_GroupIDs;
     ModifyCompressedImageMapType m_Images;
     ModifyLabelsMapType m_Labels;
@@ -33,23 +33,37 @@ mitk::SegGroupModifyOperation::SegGroupModifyOperation(MultiLabelSegmentation* s
 
 mitk::SegGroupModifyOperation::GroupIndexVectorType mitk::SegGroupModifyOperation::GetImageGroupIDs() const
 {
-  GroupIndexVectorType result;
+  std::set<MultiLabelSegmentation::GroupIndexType> groupIDs;
   for (auto& pair : m_ModifiedImages)
   {
-    result.push_back(pair.first);
+    groupIDs.insert(pair.first);
   }
-  return result;
+  for (auto& pair : m_ImageDifferences)
+  {
+    groupIDs.insert(pair.first);
+  }
+  return GroupIndexVectorType(groupIDs.begin(), groupIDs.end());
 }
 
 
 mitk::SegGroupModifyOperation::TimeStepVectorType mitk::SegGroupModifyOperation::GetImageTimeSteps(MultiLabelSegmentation::GroupIndexType groupID) const
 {
-  TimeStepVectorType result;
-  for (auto& pair : m_ModifiedImages.at(groupID))
+  std::set<TimeStepType> timeSteps;
+  if (auto finding = m_ModifiedImages.find(groupID); m_ModifiedImages.end() != finding)
   {
-    result.push_back(pair.first);
+    for (auto& pair : finding->second)
+    {
+      timeSteps.insert(pair.first);
+    }
   }
-  return result;
+  if (auto finding = m_ImageDifferences.find(groupID); m_ImageDifferences.end() != finding)
+  {
+    for (auto& pair : finding->second)
+    {
+      timeSteps.insert(pair.first);
+    }
+  }
+  return TimeStepVectorType(timeSteps.begin(), timeSteps.end());
 }
 
 mitk::SegGroupModifyOperation::GroupIndexVectorType mitk::SegGroupModifyOperation::GetLabelGroupIDs() const
@@ -74,10 +88,73 @@ mitk::SegGroupModifyOperation::GroupIndexVectorType mitk::SegGroupModifyOperatio
 
 mitk::Image::Pointer mitk::SegGroupModifyOperation::GetModifiedGroupImage(MultiLabelSegmentation::GroupIndexType groupID, TimeStepType timeStep) const
 {
+  if (auto groupFinding = m_ImageDifferences.find(groupID); m_ImageDifferences.end() != groupFinding)
+  {
+    if (auto finding = groupFinding->second.find(timeStep); groupFinding->second.end() != finding)
+    {
+      auto segmentation = this->GetSegmentation();
+      if (nullptr == segmentation)
+        mitkThrow() << "Cannot get modified group image. Segmentation of the operation is not valid anymore.";
+
+      // apply the changed runs to a copy of the current content of the group image
+      auto image = SelectImageByTimeStep(segmentation->GetGroupImage(groupID), timeStep)->Clone();
+      const auto& [difference, restoreBefore] = finding->second;
+
+      if (restoreBefore)
+      {
+        difference->ApplyBefore(image);
+      }
+      else
+      {
+        difference->ApplyAfter(image);
+      }
+
+      return image;
+    }
+  }
+
   auto image = m_ModifiedImages.at(groupID).at(timeStep)->DecompressImage();
   return image;
 }
 
+void mitk::SegGroupModifyOperation::SetGroupImageDifference(MultiLabelSegmentation::GroupIndexType groupID,
+  TimeStepType timeStep, std::shared_ptr<const CompressedImageDifference> difference, bool restoreBefore)
+{
+  if (nullptr == difference)
+    mitkThrow() << "Invalid call of SetGroupImageDifference. Difference is not set.";
+
+  if (auto finding = m_ModifiedImages.find(groupID); m_ModifiedImages.end() != finding)
+  {
+    finding->second.erase(timeStep);
+    if (finding->second.empty())
+      m_ModifiedImages.erase(finding);
+  }
+
+  m_ImageDifferences[groupID][timeStep] = std::make_pair(difference, restoreBefore);
+}
+
+std::size_t mitk::SegGroupModifyOperation::GetMemorySize() const
+{
+  std::size_t size = 0;
+
+  for (const auto& [groupID, tsImageMap] : m_ModifiedImages)
+  {
+    for (const auto& [timeStep, compressor] : tsImageMap)
+      size += compressor->GetMemorySize();
+  }
+
+  for (const auto& [groupID, tsDifferenceMap] : m_ImageDifferences)
+  {
+    for (const auto& [timeStep, difference] : tsDifferenceMap)
+    {
+      if (difference.second)
+        size += difference.first->GetMemorySize();
+    }
+  }
+
+  return size;
+}
+
 mitk::MultiLabelSegmentation::ConstLabelVectorType mitk::SegGroupModifyOperation::GetModifiedLabels(MultiLabelSegmentation::GroupIndexType groupID) const
 {
   return m_ModifiedLabels.at(groupID);
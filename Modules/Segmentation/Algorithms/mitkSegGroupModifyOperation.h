@@ -14,6 +14,7 @@ found in the LICENSE file.
 #define mitkSegGroupModifyOperation_h
 
 #include "mitkCompressedImageContainer.h"
+#include "mitkCompressedImageDifference.h"
 #include <MitkSegmentationExports.h>
 #include <mitkSegChangeOperationBase.h>
 
@@ -51,12 +52,24 @@ namespace mitk
     GroupIndexVectorType GetLabelGroupIDs() const;
     GroupIndexVectorType GetNameGroupIDs() const;
 
-    /** \brief Get the modified group image for a certain group and time step that is applied in the operation.*/
+    /** \brief Get the modified group image for a certain group and time step that is applied in the operation.
+      If only a difference is stored for the group and time step (see SetGroupImageDifference()), the image is
+      created from the current group image of the segmentation.*/
     Image::Pointer GetModifiedGroupImage(MultiLabelSegmentation::GroupIndexType groupID, TimeStepType timeStep) const;
     /** \brief Get the modified group image for a certain group and time step that is applied in the operation.*/
     MultiLabelSegmentation::ConstLabelVectorType GetModifiedLabels(MultiLabelSegmentation::GroupIndexType groupID) const;
     std::string GetModifiedName(MultiLabelSegmentation::GroupIndexType groupID) const;
 
+    /** \brief Stores only the difference of an edit for a group image and time step instead of the whole image.
+      The same difference can be shared by the undo and the redo operation of the edit.
+      \param restoreBefore Indicates if the operation restores the state before (undo) or after (redo) the edit.*/
+    void SetGroupImageDifference(MultiLabelSegmentation::GroupIndexType groupID, TimeStepType timeStep,
+      std::shared_ptr<const CompressedImageDifference> difference, bool restoreBefore);
+
+    /** \brief Returns the memory of the stored group images. Differences shared with the redo operation
+      are only accounted by the undo operation (restoreBefore).*/
+    std::size_t GetMemorySize() const override;
+
     // Explicitly delete copy operations because internally std::unique_ptr are used.
     SegGroupModifyOperation(const SegGroupModifyOperation&) = delete;
     SegGroupModifyOperation& operator=(const SegGroupModifyOperation&) = delete;
@@ -68,6 +81,8 @@ namespace mitk
   protected:
     using ModifyCompressedImageMapType = std::map<MultiLabelSegmentation::GroupIndexType, std::map<TimeStepType, std::unique_ptr<CompressedImageContainer>>>;
     ModifyCompressedImageMapType m_ModifiedImages;
+    using ModifyImageDifferenceMapType = std::map<MultiLabelSegmentation::GroupIndexType, std::map<TimeStepType, std::pair<std::shared_ptr<const CompressedImageDifference>, bool>>>;
+    ModifyImageDifferenceMapType m_ImageDifferences;
     ModifyLabelsMapType m_ModifiedLabels;
     ModifyGroupNameMapType m_ModifiedNames;
   };
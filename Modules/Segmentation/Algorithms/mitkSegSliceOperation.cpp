@@ -19,7 +19,7 @@ mitk::SegSliceOperation::SegSliceOperation(MultiLabelSegmentation* segmentation,
   const Image* slice,
   const TimeStepType timestep,
   const PlaneGeometry* planeGeometry)
-  : SegChangeOperationBase(segmentation, 1), m_GroupID(groupID), m_TimeStep(timestep)
+  : SegChangeOperationBase(segmentation, 1), m_GroupID(groupID), m_TimeStep(timestep), m_RestoreBefore(false)
 
 {
   m_PlaneGeometry = planeGeometry->Clone();
@@ -32,11 +32,59 @@ mitk::SegSliceOperation::SegSliceOperation(MultiLabelSegmentation* segmentation,
   m_CompressedImageContainer.CompressImage(slice);
 }
 
+mitk::SegSliceOperation::SegSliceOperation(MultiLabelSegmentation* segmentation,
+  MultiLabelSegmentation::GroupIndexType groupID,
+  std::shared_ptr<const CompressedImageDifference> sliceDifference,
+  bool restoreBefore,
+  const TimeStepType timestep,
+  const PlaneGeometry* planeGeometry)
+  : SegChangeOperationBase(segmentation, 1), m_GroupID(groupID), m_TimeStep(timestep),
+    m_SliceDifference(sliceDifference), m_RestoreBefore(restoreBefore)
+{
+  if (nullptr == m_SliceDifference)
+    mitkThrow() << "Cannot create SegSliceOperation. Slice difference is not set.";
+
+  m_PlaneGeometry = planeGeometry->Clone();
+  // see comment in the other constructor (bug 12338)
+  m_GuardReferenceGeometry = dynamic_cast<const PlaneGeometry *>(m_PlaneGeometry.GetPointer())->GetReferenceGeometry();
+}
+
 mitk::Image::Pointer mitk::SegSliceOperation::GetSlice() const
 {
+  if (this->IsDifference())
+    return nullptr;
+
   return m_CompressedImageContainer.DecompressImage();
 }
 
+bool mitk::SegSliceOperation::IsDifference() const
+{
+  return nullptr != m_SliceDifference;
+}
+
+void mitk::SegSliceOperation::ApplyDifference(Image* slice) const
+{
+  if (!this->IsDifference())
+    mitkThrow() << "Invalid call of SegSliceOperation::ApplyDifference. Operation does not store a difference.";
+
+  if (m_RestoreBefore)
+  {
+    m_SliceDifference->ApplyBefore(slice);
+  }
+  else
+  {
+    m_SliceDifference->ApplyAfter(slice);
+  }
+}
+
+std::size_t mitk::SegSliceOperation::GetMemorySize() const
+{
+  if (this->IsDifference())
+    return m_RestoreBefore ? m_SliceDifference->GetMemorySize() : 0;
+
+  return m_CompressedImageContainer.GetMemorySize();
+}
+
 bool mitk::SegSliceOperation::IsValid() const
 {
   return SegChangeOperationBase::IsValid() && m_PlaneGeometry.IsNotNull();
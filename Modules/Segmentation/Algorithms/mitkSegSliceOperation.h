@@ -14,6 +14,7 @@ found in the LICENSE file.
 #define mitkSegSliceOperation_h
 
 #include "mitkCompressedImageContainer.h"
+#include "mitkCompressedImageDifference.h"
 #include <MitkSegmentationExports.h>
 #include <mitkSegChangeOperationBase.h>
 
@@ -36,13 +37,31 @@ namespace mitk
                        const Image *slice,
                        const TimeStepType timestep,
                        const PlaneGeometry * planeGeometry);
+
+    /** \brief Constructs an operation that only stores the difference of an edit of the slice.
+      The same difference can be shared by the undo and the redo operation of the edit.
+      \param sliceDifference Difference between the slice before and after the edit.
+      \param restoreBefore Indicates if the operation restores the state before (undo) or after (redo) the edit.*/
+    SegSliceOperation(MultiLabelSegmentation* segmentation,
+                       MultiLabelSegmentation::GroupIndexType groupID,
+                       std::shared_ptr<const CompressedImageDifference> sliceDifference,
+                       bool restoreBefore,
+                       const TimeStepType timestep,
+                       const PlaneGeometry * planeGeometry);
     ~SegSliceOperation() override = default;
 
     /** \brief Check if it is a valid operation.*/
     bool IsValid() const override;
 
-    /** \brief Get the slice that is applied in the operation.*/
+    /** \brief Get the slice that is applied in the operation.
+      Returns nullptr if the operation only stores a difference (see IsDifference()).*/
     Image::Pointer GetSlice() const;
+    /** \brief Indicates if the operation only stores the difference of an edit.
+      In this case the slice to apply is created by ApplyDifference().*/
+    bool IsDifference() const;
+    /** \brief Writes the changed runs of the stored difference into the passed slice, which
+      should contain the current content of the slice plane.*/
+    void ApplyDifference(Image* slice) const;
     /** \brief Get the time step the operation should be applied on.*/
     TimeStepType GetTimeStep() const;
     /** \brief Get the plane where the slice has to be applied in the volume.*/
@@ -50,10 +69,16 @@ namespace mitk
     /** \brief Get the group index of the group image that should be modified.*/
     MultiLabelSegmentation::GroupIndexType GetGroupID() const;
 
+    /** \brief Returns the memory of the stored slice or difference. A difference shared with
+      the redo operation is only accounted by the undo operation (restoreBefore).*/
+    std::size_t GetMemorySize() const override;
+
   protected:
     MultiLabelSegmentation::GroupIndexType m_GroupID;
     TimeStepType m_TimeStep;
     CompressedImageContainer m_CompressedImageContainer;
+    std::shared_ptr<const CompressedImageDifference> m_SliceDifference;
+    bool m_RestoreBefore;
     PlaneGeometry::ConstPointer m_PlaneGeometry;
     /** Ensures that the reference geometry of the plane geometry is not deleted to soon
      see bug T12338.*/
@@ -12,15 +12,100 @@ found in the LICENSE file.
 
 #include "mitkShapeBasedInterpolationAlgorithm.h"
 #include "mitkImageAccessByItk.h"
-#include "mitkImageCast.h"
-#include <mitkITKImageImport.h>
+#include "mitkSegTool2D.h"
 
-#include <itkFastChamferDistanceImageFilter.h>
-#include <itkInvertIntensityImageFilter.h>
-#include <itkIsoContourDistanceImageFilter.h>
-#include <itkSubtractImageFilter.h>
+#include <algorithm>
+#include <cmath>
+#include <tuple>
+#include <vector>
 
-#include <thread>
+namespace
+{
+  /** Squared distance assigned to pixels without a feature pixel. Finite to keep the parabola intersections defined.*/
+  constexpr double FAR_AWAY = 1e20;
+
+  /**
+   * Exact one dimensional squared euclidean distance transform of a sampled function (lower envelope of parabolas,
+   * see P.F. Felzenszwalb, D.P. Huttenlocher: "Distance Transforms of Sampled Functions", Theory of Computing 8, 2012).
+   * f and d are accessed with the passed stride; v and z are work buffers of size n and n + 1.
+   */
+  void DistanceTransform1D(const double* f, double* d, std::size_t n, std::size_t stride, std::vector<std::size_t>& v, std::vector<double>& z)
+  {
+    std::size_t k = 0;
+    v[0] = 0;
+    z[0] = -FAR_AWAY;
+    z[1] = FAR_AWAY;
+
+    const auto intersection = [f, stride](std::size_t q, std::size_t p)
+    {
+      return ((f[q * stride] + static_cast<double>(q * q)) - (f[p * stride] + static_cast<double>(p * p))) / (2.0 * q - 2.0 * p);
+    };
+
+    for (std::size_t q = 1; q < n; ++q)
+    {
+      auto s = intersection(q, v[k]);
+
+      while (s <= z[k])
+      {
+        --k;
+        s = intersection(q, v[k]);
+      }
+
+      ++k;
+      v[k] = q;
+      z[k] = s;
+      z[k + 1] = FAR_AWAY;
+    }
+
+    k = 0;
+    for (std::size_t q = 0; q < n; ++q)
+    {
+      while (z[k + 1] < q)
+        ++k;
+
+      const auto delta = static_cast<double>(q) - static_cast<double>(v[k]);
+      d[q * stride] = delta * delta + f[v[k] * stride];
+    }
+  }
+
+  /** Squared euclidean distance of every pixel to the nearest feature pixel (columns first, then rows).*/
+  void DistanceTransform2D(std::vector<double>& image, std::size_t width, std::size_t height)
+  {
+    const auto length = std::max(width, height);
+    std::vector<std::size_t> v(length);
+    std::vector<double> z(length + 1);
+    std::vector<double> line(length);
+
+    for (std::size_t x = 0; x < width; ++x)
+    {
+      for (std::size_t y = 0; y < height; ++y)
+        line[y] = image[y * width + x];
+
+      DistanceTransform1D(line.data(), image.data() + x, height, width, v, z);
+    }
+
+    for (std::size_t y = 0; y < height; ++y)
+    {
+      std::copy(image.begin() + y * width, image.begin() + (y + 1) * width, line.begin());
+      DistanceTransform1D(line.data(), image.data() + y * width, width, 1, v, z);
+    }
+  }
+}
+
+bool mitk::ShapeBasedInterpolationAlgorithm::DistanceMapKey::operator<(const DistanceMapKey& other) const
+{
+  return std::tie(group, label, sliceDimension, sliceIndex, timeStep) <
+         std::tie(other.group, other.label, other.sliceDimension, other.sliceIndex, other.timeStep);
+}
+
+mitk::ShapeBasedInterpolationAlgorithm::ShapeBasedInterpolationAlgorithm()
+  : m_DistanceMapCacheSize(64), m_CacheGroup(0), m_CacheLabel(0)
+{
+}
+
+mitk::ShapeBasedInterpolationAlgorithm::~ShapeBasedInterpolationAlgorithm()
+{
+}
 
 mitk::Image::Pointer mitk::ShapeBasedInterpolationAlgorithm::Interpolate(
   Image::ConstPointer lowerSlice,
@@ -28,128 +113,261 @@ mitk::Image::Pointer mitk::ShapeBasedInterpolationAlgorithm::Interpolate(
   Image::ConstPointer upperSlice,
   unsigned int upperSliceIndex,
   unsigned int requestedIndex,
-  unsigned int /*sliceDimension*/, // commented variables are not used
+  unsigned int sliceDimension,
   Image::Pointer resultImage,
-  unsigned int /*timeStep*/,
+  unsigned int timeStep,
   Image::ConstPointer /*referenceImage*/)
 {
-  auto lowerDistanceImage = this->ComputeDistanceMap(lowerSliceIndex, lowerSlice);
-  auto upperDistanceImage = this->ComputeDistanceMap(upperSliceIndex, upperSlice);
+  auto lowerDistanceImage = this->ComputeDistanceMap(sliceDimension, lowerSliceIndex, timeStep, lowerSlice);
+  auto upperDistanceImage = this->ComputeDistanceMap(sliceDimension, upperSliceIndex, timeStep, upperSlice);
 
   // calculate where the current slice is in comparison to the lower and upper neighboring slices
   float ratio = (float)(requestedIndex - lowerSliceIndex) / (float)(upperSliceIndex - lowerSliceIndex);
-  AccessFixedDimensionByItk_3(resultImage, InterpolateIntermediateSlice, 2, upperDistanceImage, lowerDistanceImage, ratio);
+  AccessFixedDimensionByItk_3(resultImage, InterpolateIntermediateSlice, 2, lowerDistanceImage.GetPointer(), upperDistanceImage.GetPointer(), ratio);
 
   return resultImage;
 }
 
-mitk::Image::Pointer mitk::ShapeBasedInterpolationAlgorithm::ComputeDistanceMap(unsigned int sliceIndex, Image::ConstPointer slice)
+mitk::ShapeBasedInterpolationAlgorithm::DistanceImageType::ConstPointer mitk::ShapeBasedInterpolationAlgorithm::ComputeDistanceMap(
+  unsigned int sliceDimension, unsigned int sliceIndex, unsigned int timeStep, const Image* slice)
 {
-  static const auto MAX_CACHE_SIZE = 2 * std::thread::hardware_concurrency();
+  if (nullptr == slice)
+    mitkThrow() << "Cannot compute distance map. Slice is not set.";
+
+  DistanceMapKey key;
+  itk::ModifiedTimeType mtime = 0;
 
   {
     std::lock_guard<std::mutex> lock(m_DistanceImageCacheMutex);
+    key = { m_CacheGroup, m_CacheLabel, sliceDimension, sliceIndex, timeStep };
+    mtime = this->GetGroupImageMTime(key.group);
+
+    auto finding = m_DistanceMapLookup.find(key);
 
-    if (0 != m_DistanceImageCache.count(sliceIndex))
-      return m_DistanceImageCache[sliceIndex];
+    if (m_DistanceMapLookup.end() != finding)
+    {
+      if (finding->second->mtime == mtime)
+      {
+        m_DistanceMaps.splice(m_DistanceMaps.begin(), m_DistanceMaps, finding->second);
+        return finding->second->distanceMap;
+      }
 
-    if (MAX_CACHE_SIZE < m_DistanceImageCache.size())
-      m_DistanceImageCache.clear();
+      this->EraseEntry(finding->second);
+    }
   }
 
-  mitk::Image::Pointer distanceImage;
-  AccessFixedDimensionByItk_1(slice, ComputeDistanceMap, 2, distanceImage);
+  DistanceImageType::Pointer distanceImage;
+  AccessFixedDimensionByItk_1(slice, ComputeSignedDistance, 2, distanceImage);
 
   std::lock_guard<std::mutex> lock(m_DistanceImageCacheMutex);
 
-  m_DistanceImageCache[sliceIndex] = distanceImage;
+  // another thread may have computed the same distance map in the meantime
+  auto finding = m_DistanceMapLookup.find(key);
+  if (m_DistanceMapLookup.end() != finding)
+    this->EraseEntry(finding->second);
+
+  m_DistanceMaps.push_front({ key, distanceImage.GetPointer(), mtime });
+  m_DistanceMapLookup[key] = m_DistanceMaps.begin();
 
-  return distanceImage;
+  while (m_DistanceMaps.size() > m_DistanceMapCacheSize)
+    this->EraseEntry(std::prev(m_DistanceMaps.end()));
+
+  return distanceImage.GetPointer();
 }
 
-template <typename TPixel, unsigned int VImageDimension>
-void mitk::ShapeBasedInterpolationAlgorithm::ComputeDistanceMap(const itk::Image<TPixel, VImageDimension> *binaryImage,
-                                                                mitk::Image::Pointer &result)
+void mitk::ShapeBasedInterpolationAlgorithm::SetCacheLabel(GroupIndexType group, LabelValueType label)
 {
-  typedef itk::Image<TPixel, VImageDimension> DistanceFilterInputImageType;
+  std::lock_guard<std::mutex> lock(m_DistanceImageCacheMutex);
+  m_CacheGroup = group;
+  m_CacheLabel = label;
+}
 
-  typedef itk::FastChamferDistanceImageFilter<DistanceFilterImageType, DistanceFilterImageType> DistanceFilterType;
-  typedef itk::IsoContourDistanceImageFilter<DistanceFilterInputImageType, DistanceFilterImageType> IsoContourType;
-  typedef itk::InvertIntensityImageFilter<DistanceFilterInputImageType> InvertIntensityImageFilterType;
-  typedef itk::SubtractImageFilter<DistanceFilterImageType, DistanceFilterImageType> SubtractImageFilterType;
+void mitk::ShapeBasedInterpolationAlgorithm::SetDistanceMapCacheSize(std::size_t size)
+{
+  std::lock_guard<std::mutex> lock(m_DistanceImageCacheMutex);
+  m_DistanceMapCacheSize = size;
 
-  typename DistanceFilterType::Pointer distanceFilter = DistanceFilterType::New();
-  typename DistanceFilterType::Pointer distanceFilterInverted = DistanceFilterType::New();
-  typename IsoContourType::Pointer isoContourFilter = IsoContourType::New();
-  typename IsoContourType::Pointer isoContourFilterInverted = IsoContourType::New();
-  typename InvertIntensityImageFilterType::Pointer invertFilter = InvertIntensityImageFilterType::New();
-  typename SubtractImageFilterType::Pointer subtractImageFilter = SubtractImageFilterType::New();
+  while (m_DistanceMaps.size() > m_DistanceMapCacheSize)
+    this->EraseEntry(std::prev(m_DistanceMaps.end()));
+}
 
-  // arbitrary maximum distance
-  int maximumDistance = 100;
+std::size_t mitk::ShapeBasedInterpolationAlgorithm::GetDistanceMapCacheSize() const
+{
+  std::lock_guard<std::mutex> lock(m_DistanceImageCacheMutex);
+  return m_DistanceMapCacheSize;
+}
 
-  // this assumes the image contains only 1 and 0
-  invertFilter->SetInput(binaryImage);
-  invertFilter->SetMaximum(1);
+void mitk::ShapeBasedInterpolationAlgorithm::InvalidateDistanceMaps()
+{
+  std::lock_guard<std::mutex> lock(m_DistanceImageCacheMutex);
+  m_DistanceMaps.clear();
+  m_DistanceMapLookup.clear();
+}
 
-  // do the processing on the image and the inverted image to get inside and outside distance
-  isoContourFilter->SetInput(binaryImage);
-  isoContourFilter->SetFarValue(maximumDistance + 1);
-  isoContourFilter->SetLevelSetValue(0);
+void mitk::ShapeBasedInterpolationAlgorithm::InvalidateDistanceMaps(GroupIndexType group, unsigned int sliceDimension, unsigned int sliceIndex, unsigned int timeStep)
+{
+  std::lock_guard<std::mutex> lock(m_DistanceImageCacheMutex);
 
-  isoContourFilterInverted->SetInput(invertFilter->GetOutput());
-  isoContourFilterInverted->SetFarValue(maximumDistance + 1);
-  isoContourFilterInverted->SetLevelSetValue(0);
+  for (auto iter = m_DistanceMaps.begin(); iter != m_DistanceMaps.end();)
+  {
+    const auto& key = iter->key;
+    const bool isAffected = key.group == group && key.timeStep == timeStep &&
+                            (key.sliceDimension != sliceDimension || key.sliceIndex == sliceIndex);
+
+    if (isAffected)
+    {
+      m_DistanceMapLookup.erase(key);
+      iter = m_DistanceMaps.erase(iter);
+    }
+    else
+    {
+      ++iter;
+    }
+  }
+}
 
-  distanceFilter->SetInput(isoContourFilter->GetOutput());
-  distanceFilter->SetMaximumDistance(maximumDistance);
+void mitk::ShapeBasedInterpolationAlgorithm::SetSegmentation(MultiLabelSegmentation* segmentation)
+{
+  if (m_Segmentation == segmentation)
+    return;
 
-  distanceFilterInverted->SetInput(isoContourFilterInverted->GetOutput());
-  distanceFilterInverted->SetMaximumDistance(maximumDistance);
+  m_SliceModifiedObserver.Reset();
+  m_GroupModifiedObserver.Reset();
+  m_GroupRemovedObserver.Reset();
 
-  // inside distance should be negative, outside distance positive
-  subtractImageFilter->SetInput2(distanceFilter->GetOutput());
-  subtractImageFilter->SetInput1(distanceFilterInverted->GetOutput());
-  subtractImageFilter->Update();
+  this->InvalidateDistanceMaps();
+  m_Segmentation = segmentation;
 
-  result = mitk::GrabItkImageMemory(subtractImageFilter->GetOutput());
+  if (nullptr != segmentation)
+  {
+    m_SliceModifiedObserver.Reset(segmentation, GroupSliceModifiedEvent(), [this](const itk::EventObject& event) { this->OnGroupSliceModified(event); });
+    m_GroupModifiedObserver.Reset(segmentation, GroupModifiedEvent(), [this](const itk::EventObject&) { this->InvalidateDistanceMaps(); });
+    m_GroupRemovedObserver.Reset(segmentation, GroupRemovedEvent(), [this](const itk::EventObject&) { this->InvalidateDistanceMaps(); });
+  }
 }
 
-template <typename TPixel, unsigned int VImageDimension>
-void mitk::ShapeBasedInterpolationAlgorithm::InterpolateIntermediateSlice(itk::Image<TPixel, VImageDimension> *result,
-                                                                          const mitk::Image::Pointer &lower,
-                                                                          const mitk::Image::Pointer &upper,
-                                                                          float ratio)
+itk::ModifiedTimeType mitk::ShapeBasedInterpolationAlgorithm::GetGroupImageMTime(GroupIndexType group) const
 {
-  typename DistanceFilterImageType::Pointer lowerITK = DistanceFilterImageType::New();
-  typename DistanceFilterImageType::Pointer upperITK = DistanceFilterImageType::New();
+  if (m_Segmentation.IsNull() || !m_Segmentation->ExistGroup(group))
+    return 0;
 
-  CastToItkImage(lower, lowerITK);
-  CastToItkImage(upper, upperITK);
+  return m_Segmentation->GetGroupImage(group)->GetMTime();
+}
 
-  itk::ImageRegionConstIteratorWithIndex<DistanceFilterImageType> lowerIter(lowerITK,
-                                                                            lowerITK->GetLargestPossibleRegion());
+void mitk::ShapeBasedInterpolationAlgorithm::EraseEntry(DistanceMapListType::iterator entry)
+{
+  m_DistanceMapLookup.erase(entry->key);
+  m_DistanceMaps.erase(entry);
+}
 
-  lowerIter.GoToBegin();
+void mitk::ShapeBasedInterpolationAlgorithm::OnGroupSliceModified(const itk::EventObject& event)
+{
+  auto sliceEvent = dynamic_cast<const GroupSliceModifiedEvent*>(&event);
 
-  if (!lowerITK->GetLargestPossibleRegion().IsInside(upperITK->GetLargestPossibleRegion()) ||
-      !lowerITK->GetLargestPossibleRegion().IsInside(result->GetLargestPossibleRegion()))
-  {
-    // TODO Exception etc.
-    MITK_ERROR << "The regions of the slices for the 2D interpolation are not equally sized!";
+  if (nullptr == sliceEvent || m_Segmentation.IsNull())
     return;
+
+  const auto group = sliceEvent->GetGroupID();
+  const auto timeStep = sliceEvent->GetTimeStep();
+
+  int sliceDimension = -1;
+  int sliceIndex = -1;
+
+  if (nullptr != sliceEvent->GetPlaneGeometry() &&
+      SegTool2D::DetermineAffectedImageSlice(m_Segmentation->GetGroupImage(group), sliceEvent->GetPlaneGeometry(), sliceDimension, sliceIndex))
+  {
+    this->InvalidateDistanceMaps(group, sliceDimension, sliceIndex, timeStep);
+  }
+  else
+  {
+    // oblique slices may touch every slice of the time step
+    std::lock_guard<std::mutex> lock(m_DistanceImageCacheMutex);
+
+    for (auto iter = m_DistanceMaps.begin(); iter != m_DistanceMaps.end();)
+    {
+      if (iter->key.group == group && iter->key.timeStep == timeStep)
+      {
+        m_DistanceMapLookup.erase(iter->key);
+        iter = m_DistanceMaps.erase(iter);
+      }
+      else
+      {
+        ++iter;
+      }
+    }
+  }
+
+  // the remaining entries of the group were not affected by the write
+  std::lock_guard<std::mutex> lock(m_DistanceImageCacheMutex);
+  const auto mtime = this->GetGroupImageMTime(group);
+
+  for (auto& entry : m_DistanceMaps)
+  {
+    if (entry.key.group == group && entry.mtime == sliceEvent->GetOriginalMTime())
+      entry.mtime = mtime;
   }
+}
+
+template <typename TPixel, unsigned int VImageDimension>
+void mitk::ShapeBasedInterpolationAlgorithm::ComputeSignedDistance(const itk::Image<TPixel, VImageDimension>* binaryImage,
+                                                                   DistanceImageType::Pointer& result) const
+{
+  const auto region = binaryImage->GetLargestPossibleRegion();
+  const std::size_t width = region.GetSize(0);
+  const std::size_t height = region.GetSize(1);
+  const std::size_t numberOfPixels = width * height;
+  const TPixel* pixels = binaryImage->GetBufferPointer();
 
-  float weight[2] = {1.0f - ratio, ratio};
-  while (!lowerIter.IsAtEnd())
+  // squared distances to the nearest inside (for outside pixels) and to the nearest outside pixel (for inside pixels)
+  std::vector<double> distanceToInside(numberOfPixels);
+  std::vector<double> distanceToOutside(numberOfPixels);
+
+  for (std::size_t i = 0; i < numberOfPixels; ++i)
   {
-    typename DistanceFilterImageType::PixelType lowerPixelVal = lowerIter.Get();
-    typename DistanceFilterImageType::PixelType upperPixelVal = upperITK->GetPixel(lowerIter.GetIndex());
-    typename DistanceFilterImageType::PixelType intermediatePixelVal =
-      (weight[0] * upperPixelVal + weight[1] * lowerPixelVal > 0 ? 0 : 1);
+    const bool isInside = 0 != pixels[i];
+    distanceToInside[i] = isInside ? 0.0 : FAR_AWAY;
+    distanceToOutside[i] = isInside ? FAR_AWAY : 0.0;
+  }
+
+  DistanceTransform2D(distanceToInside, width, height);
+  DistanceTransform2D(distanceToOutside, width, height);
+
+  result = DistanceImageType::New();
+  result->SetRegions(region);
+  result->SetOrigin(binaryImage->GetOrigin());
+  result->SetSpacing(binaryImage->GetSpacing());
+  result->SetDirection(binaryImage->GetDirection());
+  result->Allocate();
+
+  auto distances = result->GetBufferPointer();
 
-    result->SetPixel(lowerIter.GetIndex(), static_cast<TPixel>(intermediatePixelVal));
+  // the contour lies between inside and outside pixels: inside distance should be negative, outside distance positive
+  for (std::size_t i = 0; i < numberOfPixels; ++i)
+  {
+    distances[i] = 0 != pixels[i]
+      ? static_cast<mitk::ScalarType>(0.5 - std::sqrt(distanceToOutside[i]))
+      : static_cast<mitk::ScalarType>(std::sqrt(distanceToInside[i]) - 0.5);
+  }
+}
 
-    ++lowerIter;
+template <typename TPixel, unsigned int VImageDimension>
+void mitk::ShapeBasedInterpolationAlgorithm::InterpolateIntermediateSlice(itk::Image<TPixel, VImageDimension> *result,
+                                                                          const DistanceImageType* lower,
+                                                                          const DistanceImageType* upper,
+                                                                          float ratio)
+{
+  if (lower->GetLargestPossibleRegion().GetSize() != upper->GetLargestPossibleRegion().GetSize() ||
+      lower->GetLargestPossibleRegion().GetSize() != result->GetLargestPossibleRegion().GetSize())
+  {
+    mitkThrow() << "The regions of the slices for the 2D interpolation are not equally sized!";
   }
+
+  const float weight[2] = {1.0f - ratio, ratio};
+  const auto numberOfPixels = result->GetLargestPossibleRegion().GetNumberOfPixels();
+  const auto lowerPixels = lower->GetBufferPointer();
+  const auto upperPixels = upper->GetBufferPointer();
+  auto resultPixels = result->GetBufferPointer();
+
+  for (std::size_t i = 0; i < numberOfPixels; ++i)
+    resultPixels[i] = static_cast<TPixel>(weight[0] * lowerPixels[i] + weight[1] * upperPixels[i] > 0 ? 0 : 1);
 }
@@ -16,6 +16,10 @@ found in the LICENSE file.
 #include "mitkSegmentationInterpolationAlgorithm.h"
 #include <MitkSegmentationExports.h>
 
+#include <mitkITKEventObserverGuard.h>
+#include <mitkLabelSetImage.h>
+
+#include <list>
 #include <map>
 #include <mutex>
 
@@ -24,14 +28,24 @@ namespace mitk
   /**
    * \brief Shape-based binary image interpolation.
    *
-   * This class uses legacy code from ipSegmentation to implement
-   * the shape-based interpolation algorithm described in
+   * This class implements the shape-based interpolation algorithm described in
    *
    * G.T. Herman, J. Zheng, C.A. Bucholtz: "Shape-based interpolation"
    * IEEE Computer Graphics & Applications, pp. 69-79,May 1992
    *
-   *  Last contributor:
-   *  $Author:$
+   * The signed distance maps of the neighboring slices are computed with an exact euclidean distance
+   * transform (in index coordinates of the slice; negative inside, positive outside) and kept in a
+   * least recently used cache. Entries are identified by group, label, slice dimension, slice index and
+   * time step (see SetCacheLabel()). Reusing one instance therefore avoids recomputing the distance maps
+   * of the bounding slices when several slices between them are interpolated (e.g. while scrolling or
+   * when interpolating a whole volume).
+   *
+   * Cached distance maps become invalid if the content of their slice changes. Callers that modify slices
+   * can invalidate the affected entries with InvalidateDistanceMaps(). Alternatively SetSegmentation() lets
+   * the algorithm observe the slice writes (GroupSliceModifiedEvent) and group modifications of a
+   * multi label segmentation and validate entries by the modification time of the group image.
+   *
+   * Interpolate() and ComputeDistanceMap() may be called concurrently.
    */
   class MITKSEGMENTATION_EXPORT ShapeBasedInterpolationAlgorithm : public SegmentationInterpolationAlgorithm
   {
@@ -40,32 +54,95 @@ namespace mitk
     itkFactorylessNewMacro(Self);
     itkCloneMacro(Self);
 
-      Image::Pointer Interpolate(Image::ConstPointer lowerSlice,
-                                 unsigned int lowerSliceIndex,
-                                 Image::ConstPointer upperSlice,
-                                 unsigned int upperSliceIndex,
-                                 unsigned int requestedIndex,
-                                 unsigned int sliceDimension,
-                                 Image::Pointer resultImage,
-                                 unsigned int timeStep,
-                                 Image::ConstPointer referenceImage) override;
+    using DistanceImageType = itk::Image<mitk::ScalarType, 2>;
+    using GroupIndexType = MultiLabelSegmentation::GroupIndexType;
+    using LabelValueType = MultiLabelSegmentation::LabelValueType;
+
+    Image::Pointer Interpolate(Image::ConstPointer lowerSlice,
+                               unsigned int lowerSliceIndex,
+                               Image::ConstPointer upperSlice,
+                               unsigned int upperSliceIndex,
+                               unsigned int requestedIndex,
+                               unsigned int sliceDimension,
+                               Image::Pointer resultImage,
+                               unsigned int timeStep,
+                               Image::ConstPointer referenceImage) override;
+
+    /** Returns the signed distance map of a binary slice (pixels other than 0 are inside).
+     * The map is taken from the cache if available, otherwise it is computed and added to the cache.*/
+    DistanceImageType::ConstPointer ComputeDistanceMap(unsigned int sliceDimension, unsigned int sliceIndex, unsigned int timeStep, const Image* slice);
+
+    /** Sets the group and label the passed slices belong to. It is part of the cache key of all distance maps
+     * computed afterwards. Default is group 0 and label 0 (e.g. for plain binary segmentations).*/
+    void SetCacheLabel(GroupIndexType group, LabelValueType label);
+
+    /** Sets the maximum number of cached distance maps. Default is 64.*/
+    void SetDistanceMapCacheSize(std::size_t size);
+    std::size_t GetDistanceMapCacheSize() const;
+
+    /** Removes all cached distance maps.*/
+    void InvalidateDistanceMaps();
+
+    /** Removes all cached distance maps that are affected by a modification of the passed slice (in any label of
+     * the group). Slices of the other slice dimensions intersect the modified slice and are removed too.*/
+    void InvalidateDistanceMaps(GroupIndexType group, unsigned int sliceDimension, unsigned int sliceIndex, unsigned int timeStep);
+
+    /** Observes the slice writes and group modifications of the segmentation to invalidate the cache.
+     * If a segmentation is set, cached distance maps are only used while the modification time of their group
+     * image is unchanged or all changes were announced by a GroupSliceModifiedEvent.*/
+    void SetSegmentation(MultiLabelSegmentation* segmentation);
+
+  protected:
+    ShapeBasedInterpolationAlgorithm();
+    ~ShapeBasedInterpolationAlgorithm() override;
 
   private:
-    typedef itk::Image<mitk::ScalarType, 2> DistanceFilterImageType;
+    struct DistanceMapKey
+    {
+      GroupIndexType group;
+      LabelValueType label;
+      unsigned int sliceDimension;
+      unsigned int sliceIndex;
+      unsigned int timeStep;
+
+      bool operator<(const DistanceMapKey& other) const;
+    };
+
+    struct DistanceMapCacheEntry
+    {
+      DistanceMapKey key;
+      DistanceImageType::ConstPointer distanceMap;
+      /** Modification time of the group image the distance map belongs to (0 if no segmentation is set).*/
+      itk::ModifiedTimeType mtime;
+    };
+
+    using DistanceMapListType = std::list<DistanceMapCacheEntry>;
 
     template <typename TPixel, unsigned int VImageDimension>
-    void ComputeDistanceMap(const itk::Image<TPixel, VImageDimension> *, mitk::Image::Pointer &result);
-
-    Image::Pointer ComputeDistanceMap(unsigned int sliceIndex, Image::ConstPointer slice);
+    void ComputeSignedDistance(const itk::Image<TPixel, VImageDimension>* binaryImage, DistanceImageType::Pointer& result) const;
 
     template <typename TPixel, unsigned int VImageDimension>
-    void InterpolateIntermediateSlice(itk::Image<TPixel, VImageDimension> *result,
-                                      const mitk::Image::Pointer &lowerDistanceImage,
-                                      const mitk::Image::Pointer &upperDistanceImage,
+    void InterpolateIntermediateSlice(itk::Image<TPixel, VImageDimension>* result,
+                                      const DistanceImageType* lowerDistanceImage,
+                                      const DistanceImageType* upperDistanceImage,
                                       float ratio);
 
-    std::map<unsigned int, Image::Pointer> m_DistanceImageCache;
-    std::mutex m_DistanceImageCacheMutex;
+    itk::ModifiedTimeType GetGroupImageMTime(GroupIndexType group) const;
+    void EraseEntry(DistanceMapListType::iterator entry);
+    void OnGroupSliceModified(const itk::EventObject& event);
+
+    /** Cache entries in the order of their last use (most recently used first).*/
+    DistanceMapListType m_DistanceMaps;
+    std::map<DistanceMapKey, DistanceMapListType::iterator> m_DistanceMapLookup;
+    std::size_t m_DistanceMapCacheSize;
+    GroupIndexType m_CacheGroup;
+    LabelValueType m_CacheLabel;
+    mutable std::mutex m_DistanceImageCacheMutex;
+
+    MultiLabelSegmentation::ConstPointer m_Segmentation;
+    ITKEventObserverGuard m_SliceModifiedObserver;
+    ITKEventObserverGuard m_GroupModifiedObserver;
+    ITKEventObserverGuard m_GroupRemovedObserver;
   };
 
 } // namespace
@@ -22,7 +22,9 @@ found in the LICENSE file.
 #include <itkCommand.h>
 #include <itkImage.h>
 #include <itkImageSliceConstIteratorWithIndex.h>
+#include <itkMultiThreaderBase.h>
 
+#include <array>
 #include <thread>
 
 namespace
@@ -60,6 +62,9 @@ mitk::SegmentationInterpolationController::SegmentationInterpolationController()
   : m_SegmentationModifiedObserverTag(std::make_pair(0UL, false)),
     m_BlockModified(false),
     m_2DInterpolationActivated(false),
+    m_Algorithm(ShapeBasedInterpolationAlgorithm::New()),
+    m_LabelSourceGroup(0),
+    m_HasLabelSource(false),
     m_EnableSliceImageCache(false)
 {
 }
@@ -111,6 +116,10 @@ void mitk::SegmentationInterpolationController::SetSegmentationVolume(const Imag
   // clear old information (remove all time steps
   m_SegmentationCountInSlice.clear();
 
+  // distance maps of a label source are validated by the modification time of its group image
+  if (!m_HasLabelSource)
+    m_Algorithm->InvalidateDistanceMaps();
+
   // delete this from the list of interpolators
   auto iter = s_InterpolatorForImage.find(segmentation);
   if (iter != s_InterpolatorForImage.end())
@@ -172,6 +181,16 @@ void mitk::SegmentationInterpolationController::SetSegmentationVolume(const Imag
   Modified();
 }
 
+void mitk::SegmentationInterpolationController::SetLabelSource(MultiLabelSegmentation *segmentation,
+                                                               MultiLabelSegmentation::LabelValueType label)
+{
+  m_HasLabelSource = nullptr != segmentation && segmentation->ExistLabel(label);
+  m_LabelSourceGroup = m_HasLabelSource ? segmentation->GetGroupIndexOfLabel(label) : 0;
+
+  m_Algorithm->SetSegmentation(m_HasLabelSource ? segmentation : nullptr);
+  m_Algorithm->SetCacheLabel(m_LabelSourceGroup, m_HasLabelSource ? label : 0);
+}
+
 void mitk::SegmentationInterpolationController::SetChangedVolume(const Image *sliceDiff, unsigned int timeStep)
 {
   if (!sliceDiff)
@@ -180,6 +199,7 @@ void mitk::SegmentationInterpolationController::SetChangedVolume(const Image *sl
     return;
 
   AccessFixedDimensionByItk_1(sliceDiff, ScanChangedVolume, 3, timeStep);
+  m_Algorithm->InvalidateDistanceMaps();
 
   // PrintStatus();
   Modified();
@@ -227,6 +247,7 @@ void mitk::SegmentationInterpolationController::SetChangedSlice(const Image *sli
 
   AccessFixedDimensionByItk_1(
     sliceDiff, ScanChangedSlice, 2, SetChangedSliceOptions(sliceDimension, sliceIndex, dim0, dim1, timeStep, rawSlice));
+  m_Algorithm->InvalidateDistanceMaps(m_LabelSourceGroup, sliceDimension, sliceIndex, timeStep);
 
   Modified();
 }
@@ -534,18 +555,124 @@ mitk::Image::Pointer mitk::SegmentationInterpolationController::Interpolate(unsi
   // inspect the reference image at appropriate positions.
 
   if (algorithm.IsNull())
-    algorithm = mitk::ShapeBasedInterpolationAlgorithm::New();
-
-  return algorithm->Interpolate(
-    lowerSlice.GetPointer(),
-    lowerBound,
-    upperSlice.GetPointer(),
-    upperBound,
-    sliceIndex,
-    sliceDimension,
-    resultImage,
-    timeStep,
-    nullptr);
+    algorithm = m_Algorithm;
+
+  try
+  {
+    return algorithm->Interpolate(
+      lowerSlice.GetPointer(),
+      lowerBound,
+      upperSlice.GetPointer(),
+      upperBound,
+      sliceIndex,
+      sliceDimension,
+      resultImage,
+      timeStep,
+      nullptr);
+  }
+  catch (const std::exception &e)
+  {
+    MITK_ERROR << "Error in 2D interpolation: " << e.what();
+    return nullptr;
+  }
+}
+
+unsigned int mitk::SegmentationInterpolationController::InterpolateAll(unsigned int sliceDimension,
+                                                                       const mitk::PlaneGeometry *currentPlane,
+                                                                       unsigned int timeStep,
+                                                                       const InterpolationCallbackType &callback,
+                                                                       ShapeBasedInterpolationAlgorithm::Pointer algorithm)
+{
+  if (m_Segmentation.IsNull() || nullptr == currentPlane)
+    return 0;
+
+  if (timeStep >= m_SegmentationCountInSlice.size())
+    return 0;
+
+  if (sliceDimension > 2)
+    return 0;
+
+  if (algorithm.IsNull())
+    algorithm = m_Algorithm;
+
+  const auto& segmentationCountInSlice = m_SegmentationCountInSlice[timeStep][sliceDimension];
+  const auto slicedGeometry = m_Segmentation->GetSlicedGeometry(timeStep);
+
+  // Transforming the current origin so that it matches the passed slice
+  auto createSlicePlane = [currentPlane, slicedGeometry, sliceDimension](unsigned int sliceIndex)
+  {
+    auto slicePlane = currentPlane->Clone();
+    auto origin = currentPlane->GetOrigin();
+    slicedGeometry->WorldToIndex(origin, origin);
+    origin[sliceDimension] = sliceIndex;
+    slicedGeometry->IndexToWorld(origin, origin);
+    slicePlane->SetOrigin(origin);
+    return slicePlane;
+  };
+
+  auto threader = itk::MultiThreaderBase::New();
+  unsigned int numberOfInterpolatedSlices = 0;
+  unsigned int lowerBound = 0;
+  bool hasLowerBound = false;
+
+  for (unsigned int upperBound = 0; upperBound < segmentationCountInSlice.size(); ++upperBound)
+  {
+    if (0 == segmentationCountInSlice[upperBound])
+      continue;
+
+    if (hasLowerBound && upperBound - lowerBound > 1)
+    {
+      mitk::Image::Pointer lowerSlice;
+      mitk::Image::Pointer upperSlice;
+      std::vector<mitk::PlaneGeometry::Pointer> slicePlanes;
+      std::vector<mitk::Image::Pointer> resultImages;
+
+      // The slice extraction is done sequentially, only the interpolation itself is parallelized.
+      try
+      {
+        lowerSlice = this->ExtractSlice(createSlicePlane(lowerBound), lowerBound, timeStep, true);
+        upperSlice = this->ExtractSlice(createSlicePlane(upperBound), upperBound, timeStep, true);
+
+        for (auto sliceIndex = lowerBound + 1; sliceIndex < upperBound; ++sliceIndex)
+        {
+          slicePlanes.push_back(createSlicePlane(sliceIndex));
+          resultImages.push_back(this->ExtractSlice(slicePlanes.back(), sliceIndex, timeStep));
+        }
+      }
+      catch (const std::exception &e)
+      {
+        MITK_ERROR << "Error in 2D interpolation: " << e.what();
+        return numberOfInterpolatedSlices;
+      }
+
+      if (lowerSlice.IsNotNull() && upperSlice.IsNotNull())
+      {
+        const std::array<const Image*, 2> boundingSlices = { { lowerSlice, upperSlice } };
+        const std::array<unsigned int, 2> boundingSliceIndices = { { lowerBound, upperBound } };
+
+        threader->ParallelizeArray(0, boundingSlices.size(), [&](itk::SizeValueType i)
+        {
+          algorithm->ComputeDistanceMap(sliceDimension, boundingSliceIndices[i], timeStep, boundingSlices[i]);
+        }, nullptr);
+
+        threader->ParallelizeArray(0, resultImages.size(), [&](itk::SizeValueType i)
+        {
+          algorithm->Interpolate(lowerSlice.GetPointer(), lowerBound, upperSlice.GetPointer(), upperBound,
+            lowerBound + 1 + i, sliceDimension, resultImages[i], timeStep, nullptr);
+        }, nullptr);
+
+        for (std::size_t i = 0; i < resultImages.size(); ++i)
+          callback(lowerBound + 1 + i, slicePlanes[i], resultImages[i]);
+
+        numberOfInterpolatedSlices += resultImages.size();
+      }
+    }
+
+    lowerBound = upperBound;
+    hasLowerBound = true;
+  }
+
+  return numberOfInterpolatedSlices;
 }
 
 mitk::Image::Pointer mitk::SegmentationInterpolationController::ExtractSlice(const PlaneGeometry* planeGeometry, unsigned int sliceIndex, unsigned int timeStep, bool cache)
@@ -21,6 +21,7 @@ found in the LICENSE file.
 #include <itkImage.h>
 #include <itkObjectFactory.h>
 
+#include <functional>
 #include <map>
 #include <mutex>
 #include <utility>
@@ -99,6 +100,17 @@ namespace mitk
     */
     void SetSegmentationVolume(const Image *segmentation);
 
+    /**
+      \brief Sets the multi label segmentation and the label the segmentation volume was created from (e.g. with
+      CreateLabelMask()).
+
+      The distance maps cached by the algorithm of the controller are then keyed by the group and label and are
+      invalidated by the slice writes of the segmentation (see ShapeBasedInterpolationAlgorithm::SetSegmentation()).
+      They therefore survive switching between labels and re-setting the segmentation volume.
+      Call it before SetSegmentationVolume(). Pass nullptr if the segmentation volume has no such source.
+    */
+    void SetLabelSource(MultiLabelSegmentation *segmentation, MultiLabelSegmentation::LabelValueType label);
+
     /**
       \brief Update after changing a single slice.
 
@@ -128,7 +140,8 @@ namespace mitk
 
       \param timeStep Which time step to use
 
-      \param algorithm Optional algorithm instance to potentially benefit from caching for repeated interpolation
+      \param algorithm Optional algorithm instance. If not set, an algorithm instance owned by the controller is used,
+             which caches the distance maps of the bounding slices until the segmentation changes.
     */
     Image::Pointer Interpolate(unsigned int sliceDimension,
                                unsigned int sliceIndex,
@@ -136,6 +149,33 @@ namespace mitk
                                unsigned int timeStep,
                                mitk::ShapeBasedInterpolationAlgorithm::Pointer algorithm = nullptr);
 
+    using InterpolationCallbackType = std::function<void(unsigned int sliceIndex, const PlaneGeometry* slicePlane, Image* interpolation)>;
+
+    /**
+      \brief Generates interpolated images for all slices of a slice dimension that lie between two segmented slices.
+
+      The gaps are processed one after another. The distance maps of the two slices bounding a gap and the
+      interpolations of all slices of the gap are computed in parallel. The callback is called in the calling thread
+      for every interpolated slice (in ascending slice order); only the slices of one gap are kept in memory at once.
+
+      \param sliceDimension Number of the dimension which is constant for all pixels of the meant slices.
+
+      \param currentPlane Plane of any slice of the slice dimension. It is moved to the interpolated slices.
+
+      \param timeStep Which time step to use
+
+      \param callback Receives the slice index, the plane geometry and the image of every interpolated slice.
+
+      \param algorithm Optional algorithm instance (see Interpolate()).
+
+      \return Number of interpolated slices
+    */
+    unsigned int InterpolateAll(unsigned int sliceDimension,
+                                const mitk::PlaneGeometry *currentPlane,
+                                unsigned int timeStep,
+                                const InterpolationCallbackType &callback,
+                                mitk::ShapeBasedInterpolationAlgorithm::Pointer algorithm = nullptr);
+
     void OnImageModified(const itk::EventObject &);
 
     /**
@@ -223,6 +263,13 @@ namespace mitk
     bool m_BlockModified;
     bool m_2DInterpolationActivated;
 
+    /** Algorithm used if no algorithm is passed to Interpolate(). Its distance map cache is invalidated by slice
+      changes (SetChangedSlice()) and reset if the whole segmentation volume changes (unless a label source is set).*/
+    ShapeBasedInterpolationAlgorithm::Pointer m_Algorithm;
+    /** Group of the label source (see SetLabelSource()) or 0.*/
+    MultiLabelSegmentation::GroupIndexType m_LabelSourceGroup;
+    bool m_HasLabelSource;
+
     bool m_EnableSliceImageCache;
     std::map<std::pair<unsigned int, unsigned int>, Image::Pointer> m_SliceImageCache;
     std::mutex m_SliceImageCacheMutex;
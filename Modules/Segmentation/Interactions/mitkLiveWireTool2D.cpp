@@ -89,6 +89,7 @@ void mitk::LiveWireTool2D::OnTimePointChanged()
   auto timeStep = reference->GetTimeGeometry()->TimePointToTimeStep(this->GetLastTimePointTriggered());
 
   m_ReferenceDataSlice = GetAffectedImageSliceAs2DImageByTimePoint(m_PlaneGeometry, reference, timeStep);
+  m_LiveWireFilter->SetCostTermsCacheKey(reference, timeStep);
   m_LiveWireFilter->SetInput(m_ReferenceDataSlice);
 
   m_LiveWireFilter->Update();
@@ -104,6 +105,15 @@ mitk::Point3D mitk::LiveWireTool2D::PrepareInitContour(const mitk::Point3D& clic
   // Set current slice as input for ImageToLiveWireContourModelFilter
   m_LiveWireFilter = ImageLiveWireContourModelFilter::New();
   m_LiveWireFilter->SetUseCostFunction(true);
+
+  // reuse the cost terms of the slice, if it was already live wired
+  auto reference = this->GetReferenceData();
+  if (nullptr != reference)
+  {
+    auto timeStep = reference->GetTimeGeometry()->TimePointToTimeStep(this->GetLastTimePointTriggered());
+    m_LiveWireFilter->SetCostTermsCacheKey(reference, timeStep);
+  }
+
   m_LiveWireFilter->SetInput(m_ReferenceDataSlice);
 
   itk::Index<3> idx;
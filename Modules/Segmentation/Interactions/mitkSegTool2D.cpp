@@ -625,30 +625,59 @@ void mitk::SegTool2D::WriteBackSegmentationResults(const DataNode* workingNode,
       UndoStackItem::IncCurrGroupEventId();
     }
 
+    // the original slices are also needed if somebody tracks the slice changes (e.g. incremental statistics)
+    const bool notifySliceChanges = segmentation->HasObserver(GroupSliceModifiedEvent(groupIndex));
+
     for (const auto& sliceInfo : sliceList)
     {
       if (nullptr != sliceInfo.plane && sliceInfo.slice.IsNotNull())
       {
         SegSliceOperation* undoOperation = nullptr;
+        mitk::Image::Pointer originalSlice;
+
+        if (allowUndo || notifySliceChanges)
+        {
+          originalSlice = GetAffectedImageSliceAs2DImage(sliceInfo.plane, groupImage, sliceInfo.timestep);
+        }
+
+        std::shared_ptr<CompressedImageDifference> sliceDifference;
 
         if (allowUndo)
         {
           /*============= BEGIN undo/redo feature block ========================*/
-          // Create undo operation by caching the not yet modified slices
-          mitk::Image::Pointer originalSlice = GetAffectedImageSliceAs2DImage(sliceInfo.plane, groupImage, sliceInfo.timestep);
-          undoOperation =
-            new SegSliceOperation(segmentation, groupIndex, originalSlice, sliceInfo.timestep, sliceInfo.plane);
+          if (CompressedImageDifference::HaveSameLayout(originalSlice, sliceInfo.slice))
+          {
+            // Only store the runs changed by the edit; undo and redo operation share them
+            sliceDifference = std::make_shared<CompressedImageDifference>();
+            sliceDifference->ComputeDifference(originalSlice, sliceInfo.slice);
+            undoOperation =
+              new SegSliceOperation(segmentation, groupIndex, sliceDifference, true, sliceInfo.timestep, sliceInfo.plane);
+          }
+          else
+          {
+            // Create undo operation by caching the not yet modified slices
+            undoOperation =
+              new SegSliceOperation(segmentation, groupIndex, originalSlice, sliceInfo.timestep, sliceInfo.plane);
+          }
           /*============= END undo/redo feature block ========================*/
         }
 
+        const auto originalMTime = groupImage->GetMTime();
         SegTool2D::WriteSliceToVolume(groupImage, sliceInfo);
 
+        if (originalSlice.IsNotNull())
+        {
+          // keeps the label index of the group up to date and notifies the observers
+          segmentation->GroupSliceModified(GroupSliceModifiedEvent(groupIndex, sliceInfo.timestep, sliceInfo.plane, originalSlice, sliceInfo.slice, originalMTime));
+        }
+
         if (allowUndo)
         {
           /*============= BEGIN undo/redo feature block ========================*/
           // specify the redo operation with the edited slice
-          auto* doOperation =
-            new SegSliceOperation(segmentation, groupIndex, sliceInfo.slice, sliceInfo.timestep, sliceInfo.plane);
+          auto* doOperation = nullptr != sliceDifference
+            ? new SegSliceOperation(segmentation, groupIndex, sliceDifference, false, sliceInfo.timestep, sliceInfo.plane)
+            : new SegSliceOperation(segmentation, groupIndex, sliceInfo.slice, sliceInfo.timestep, sliceInfo.plane);
 
           // create an operation event for the undo stack
           UndoStackItem::IncCurrObjectEventId();
@@ -4,7 +4,9 @@ set(MODULE_TESTS
   mitkContourModelSetToImageFilterTest.cpp
   mitkDataNodeSegmentationTest.cpp
   mitkImageToContourFilterTest.cpp
+  mitkLiveWireCostTermsCacheTest.cpp
   mitkSegmentationInterpolationTest.cpp
+  mitkShapeBasedInterpolationAlgorithmTest.cpp
   mitkOverwriteSliceFilterTest.cpp
   mitkOverwriteSliceFilterObliquePlaneTest.cpp
 #  mitkToolManagerTest.cpp
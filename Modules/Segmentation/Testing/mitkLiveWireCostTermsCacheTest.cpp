@@ -0,0 +1,151 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+// Testing
+#include <mitkTestFixture.h>
+#include <mitkTestingMacros.h>
+
+// other
+#include <mitkGeometry3D.h>
+#include <mitkLiveWireCostTermsCache.h>
+
+#include <vector>
+
+class mitkLiveWireCostTermsCacheTestSuite : public mitk::TestFixture
+{
+  CPPUNIT_TEST_SUITE(mitkLiveWireCostTermsCacheTestSuite);
+  MITK_TEST(Get_InsertedSlice_ReturnsCostTerms);
+  MITK_TEST(Get_ModifiedReferenceImage_ReturnsNullptr);
+  MITK_TEST(Get_OtherGeometry_ReturnsNullptr);
+  MITK_TEST(Get_OtherTimeStep_ReturnsNullptr);
+  MITK_TEST(Insert_CacheFull_EvictsLeastRecentlyUsed);
+  CPPUNIT_TEST_SUITE_END();
+
+private:
+  mitk::LiveWireCostTermsCache *m_Cache;
+  std::size_t m_MaximumNumberOfEntries;
+  mitk::Image::Pointer m_ReferenceImage;
+
+  /** Geometry of the axial slice at z.*/
+  static mitk::BaseGeometry::Pointer CreateSliceGeometry(double z)
+  {
+    auto geometry = mitk::Geometry3D::New();
+    mitk::Point3D origin;
+    mitk::FillVector3D(origin, 0.0, 0.0, z);
+    geometry->SetOrigin(origin);
+    return geometry.GetPointer();
+  }
+
+public:
+  void setUp() override
+  {
+    m_Cache = mitk::LiveWireCostTermsCache::GetInstance();
+    m_MaximumNumberOfEntries = m_Cache->GetMaximumNumberOfEntries();
+    m_Cache->Clear();
+
+    m_ReferenceImage = mitk::Image::New();
+    unsigned int dimensions[4] = { 8, 8, 8, 2 };
+    m_ReferenceImage->Initialize(mitk::MakeScalarPixelType<short>(), 4, dimensions);
+  }
+
+  void tearDown() override
+  {
+    m_Cache->Clear();
+    m_Cache->SetMaximumNumberOfEntries(m_MaximumNumberOfEntries);
+    m_ReferenceImage = nullptr;
+  }
+
+  void Get_InsertedSlice_ReturnsCostTerms()
+  {
+    auto costTerms = itk::LiveWireCostTerms::New();
+    m_Cache->Insert(m_ReferenceImage, 0, CreateSliceGeometry(3.0), costTerms);
+
+    // An equal geometry of another instance, e.g. of another renderer, hits the entry
+    CPPUNIT_ASSERT(costTerms == m_Cache->Get(m_ReferenceImage, 0, CreateSliceGeometry(3.0)));
+    CPPUNIT_ASSERT(costTerms == m_Cache->Get(m_ReferenceImage, 0, CreateSliceGeometry(3.0)));
+
+    CPPUNIT_ASSERT(m_Cache->Get(mitk::Image::New(), 0, CreateSliceGeometry(3.0)).IsNull());
+    CPPUNIT_ASSERT(m_Cache->Get(nullptr, 0, CreateSliceGeometry(3.0)).IsNull());
+  }
+
+  void Get_ModifiedReferenceImage_ReturnsNullptr()
+  {
+    m_Cache->Insert(m_ReferenceImage, 0, CreateSliceGeometry(3.0), itk::LiveWireCostTerms::New());
+
+    m_ReferenceImage->Modified();
+    CPPUNIT_ASSERT(m_Cache->Get(m_ReferenceImage, 0, CreateSliceGeometry(3.0)).IsNull());
+
+    // The terms of the modified image are cached anew
+    auto costTerms = itk::LiveWireCostTerms::New();
+    m_Cache->Insert(m_ReferenceImage, 0, CreateSliceGeometry(3.0), costTerms);
+    CPPUNIT_ASSERT(costTerms == m_Cache->Get(m_ReferenceImage, 0, CreateSliceGeometry(3.0)));
+  }
+
+  void Get_OtherGeometry_ReturnsNullptr()
+  {
+    auto costTerms = itk::LiveWireCostTerms::New();
+    m_Cache->Insert(m_ReferenceImage, 0, CreateSliceGeometry(3.0), costTerms);
+
+    CPPUNIT_ASSERT(m_Cache->Get(m_ReferenceImage, 0, CreateSliceGeometry(4.0)).IsNull());
+
+    auto spacedGeometry = CreateSliceGeometry(3.0);
+    mitk::Vector3D spacing;
+    mitk::FillVector3D(spacing, 0.5, 0.5, 1.0);
+    spacedGeometry->SetSpacing(spacing);
+    CPPUNIT_ASSERT(m_Cache->Get(m_ReferenceImage, 0, spacedGeometry).IsNull());
+
+    CPPUNIT_ASSERT(costTerms == m_Cache->Get(m_ReferenceImage, 0, CreateSliceGeometry(3.0)));
+  }
+
+  void Get_OtherTimeStep_ReturnsNullptr()
+  {
+    auto costTerms = itk::LiveWireCostTerms::New();
+    m_Cache->Insert(m_ReferenceImage, 0, CreateSliceGeometry(3.0), costTerms);
+
+    CPPUNIT_ASSERT(m_Cache->Get(m_ReferenceImage, 1, CreateSliceGeometry(3.0)).IsNull());
+    CPPUNIT_ASSERT(costTerms == m_Cache->Get(m_ReferenceImage, 0, CreateSliceGeometry(3.0)));
+  }
+
+  void Insert_CacheFull_EvictsLeastRecentlyUsed()
+  {
+    CPPUNIT_ASSERT_EQUAL(std::size_t(4), m_Cache->GetMaximumNumberOfEntries());
+
+    std::vector<itk::LiveWireCostTerms::Pointer> costTerms;
+
+    for (int slice = 0; slice < 4; ++slice)
+    {
+      costTerms.push_back(itk::LiveWireCostTerms::New());
+      m_Cache->Insert(m_ReferenceImage, 0, CreateSliceGeometry(slice), costTerms.back());
+    }
+
+    // slice 1 is the least recently used entry after using slice 0
+    CPPUNIT_ASSERT(costTerms[0] == m_Cache->Get(m_ReferenceImage, 0, CreateSliceGeometry(0)));
+
+    costTerms.push_back(itk::LiveWireCostTerms::New());
+    m_Cache->Insert(m_ReferenceImage, 0, CreateSliceGeometry(4), costTerms.back());
+
+    CPPUNIT_ASSERT_MESSAGE("Least recently used entry was not evicted",
+                           m_Cache->Get(m_ReferenceImage, 0, CreateSliceGeometry(1)).IsNull());
+
+    for (int slice : { 0, 2, 3, 4 })
+      CPPUNIT_ASSERT_MESSAGE("Recently used entry was evicted",
+                             costTerms[slice] == m_Cache->Get(m_ReferenceImage, 0, CreateSliceGeometry(slice)));
+
+    // Shrinking the cache keeps the most recently used entries (slices 3 and 4)
+    m_Cache->SetMaximumNumberOfEntries(2);
+    CPPUNIT_ASSERT(m_Cache->Get(m_ReferenceImage, 0, CreateSliceGeometry(2)).IsNull());
+    CPPUNIT_ASSERT(costTerms[3] == m_Cache->Get(m_ReferenceImage, 0, CreateSliceGeometry(3)));
+    CPPUNIT_ASSERT(costTerms[4] == m_Cache->Get(m_ReferenceImage, 0, CreateSliceGeometry(4)));
+  }
+};
+
+MITK_TEST_SUITE_REGISTRATION(mitkLiveWireCostTermsCache)
@@ -25,12 +25,18 @@ found in the LICENSE file.
 #include <mitkTool.h>
 #include <mitkVtkImageOverwrite.h>
 
+#include <algorithm>
+#include <cstdlib>
+#include <string>
+
 class mitkSegmentationInterpolationTestSuite : public mitk::TestFixture
 {
   CPPUNIT_TEST_SUITE(mitkSegmentationInterpolationTestSuite);
   MITK_TEST(Equal_Axial_TestInterpolationAndReferenceInterpolation_ReturnsTrue);
   MITK_TEST(Equal_Coronal_TestInterpolationAndReferenceInterpolation_ReturnsTrue);
   MITK_TEST(Equal_Sagittal_TestInterpolationAndReferenceInterpolation_ReturnsTrue);
+  MITK_TEST(InterpolateAll_Axial_ReturnsSameInterpolationAsInterpolate);
+  MITK_TEST(InterpolateAll_Axial_ReturnsExpectedInterpolation);
   CPPUNIT_TEST_SUITE_END();
 
 private:
@@ -148,6 +154,85 @@ private:
   itk::Index<3> m_CenterPoint;
   mitk::SegmentationInterpolationController::Pointer m_InterpolationController;
 
+  void FillBoundingSlices(int dim)
+  {
+    mitk::ImagePixelWriteAccessor<mitk::Tool::DefaultSegmentationDataType, 3> writeAccessor(m_SegmentationImage);
+    itk::Index<3> currentPoint = m_CenterPoint;
+
+    // 3x3 square three slices below and a single pixel three slices above the center
+    currentPoint[dim] = m_CenterPoint[dim] - 3;
+    for (int i = -1; i <= 1; ++i)
+    {
+      for (int j = -1; j <= 1; ++j)
+      {
+        currentPoint[(dim + 1) % 3] = m_CenterPoint[(dim + 1) % 3] + i;
+        currentPoint[(dim + 2) % 3] = m_CenterPoint[(dim + 2) % 3] + j;
+        writeAccessor.SetPixelByIndexSafe(currentPoint, 1);
+      }
+    }
+
+    currentPoint[dim] = m_CenterPoint[dim] + 3;
+    writeAccessor.SetPixelByIndexSafe(currentPoint, 1);
+  }
+
+  /** Sets a square of pixels (edge length 2 * halfSize + 1) around the center point in a slice of the segmentation.*/
+  void FillSquare(int dim, itk::IndexValueType sliceIndex, int halfSize)
+  {
+    mitk::ImagePixelWriteAccessor<mitk::Tool::DefaultSegmentationDataType, 3> writeAccessor(m_SegmentationImage);
+    itk::Index<3> currentPoint = m_CenterPoint;
+    currentPoint[dim] = sliceIndex;
+
+    for (int i = -halfSize; i <= halfSize; ++i)
+    {
+      for (int j = -halfSize; j <= halfSize; ++j)
+      {
+        currentPoint[(dim + 1) % 3] = m_CenterPoint[(dim + 1) % 3] + i;
+        currentPoint[(dim + 2) % 3] = m_CenterPoint[(dim + 2) % 3] + j;
+        writeAccessor.SetPixelByIndexSafe(currentPoint, 1);
+      }
+    }
+  }
+
+  /** Writes an interpolated slice back into the segmentation.*/
+  void WriteInterpolation(mitk::Image* interpolation, const mitk::PlaneGeometry* plane)
+  {
+    vtkSmartPointer<mitkVtkImageOverwrite> reslicer = vtkSmartPointer<mitkVtkImageOverwrite>::New();
+    reslicer->SetInputSlice(interpolation->GetSliceData()->GetVtkImageAccessor(interpolation)->GetVtkImageData());
+    reslicer->SetOverwriteMode(true);
+    reslicer->Modified();
+    mitk::ExtractSliceFilter::Pointer extractor = mitk::ExtractSliceFilter::New(reslicer);
+    extractor->SetInput(m_SegmentationImage);
+    extractor->SetTimeStep(0);
+    extractor->SetWorldGeometry(plane);
+    extractor->SetVtkOutputRequest(true);
+    extractor->SetResliceTransformByGeometry(m_SegmentationImage->GetTimeGeometry()->GetGeometryForTimeStep(0));
+    extractor->Modified();
+    extractor->Update();
+  }
+
+  /** Checks that a slice of the segmentation contains exactly the square of the passed size around the center point
+    (within a neighborhood of the center point).*/
+  void CheckSquare(int dim, itk::IndexValueType sliceIndex, int halfSize)
+  {
+    mitk::ImagePixelReadAccessor<mitk::Tool::DefaultSegmentationDataType, 3> readAccess(m_SegmentationImage);
+    itk::Index<3> currentPoint = m_CenterPoint;
+    currentPoint[dim] = sliceIndex;
+
+    for (int i = -halfSize - 3; i <= halfSize + 3; ++i)
+    {
+      for (int j = -halfSize - 3; j <= halfSize + 3; ++j)
+      {
+        currentPoint[(dim + 1) % 3] = m_CenterPoint[(dim + 1) % 3] + i;
+        currentPoint[(dim + 2) % 3] = m_CenterPoint[(dim + 2) % 3] + j;
+
+        const bool isInside = std::abs(i) <= halfSize && std::abs(j) <= halfSize;
+        CPPUNIT_ASSERT_EQUAL_MESSAGE("Unexpected interpolation in slice " + std::to_string(sliceIndex),
+                                     isInside ? 1 : 0,
+                                     static_cast<int>(readAccess.GetPixelByIndexSafe(currentPoint)));
+      }
+    }
+  }
+
 public:
   void setUp() override
   {
@@ -179,6 +264,7 @@ public:
     m_ReferenceImage = nullptr;
     m_SegmentationImage = nullptr;
     m_CenterPoint = {{0, 0, 0}};
+    m_InterpolationController->SetLabelSource(nullptr, 0);
   }
 
   void Equal_Axial_TestInterpolationAndReferenceInterpolation_ReturnsTrue()
@@ -198,6 +284,97 @@ public:
     mitk::AnatomicalPlane viewDirection = mitk::AnatomicalPlane::Sagittal;
     testRoutine(viewDirection);
   }
+
+  void InterpolateAll_Axial_ReturnsSameInterpolationAsInterpolate()
+  {
+    const int dim = 2;
+    this->FillBoundingSlices(dim);
+    m_InterpolationController->SetSegmentationVolume(m_SegmentationImage);
+
+    mitk::SliceNavigationController::Pointer navigationController = mitk::SliceNavigationController::New();
+    navigationController->SetInputWorldTimeGeometry(m_SegmentationImage->GetTimeGeometry());
+    navigationController->Update(mitk::AnatomicalPlane::Axial);
+    mitk::Point3D pointMM;
+    m_SegmentationImage->GetTimeGeometry()->GetGeometryForTimeStep(0)->IndexToWorld(m_CenterPoint, pointMM);
+    navigationController->SelectSliceByPoint(pointMM);
+    auto plane = navigationController->GetCurrentPlaneGeometry();
+
+    std::vector<unsigned int> interpolatedSlices;
+    std::vector<mitk::Image::Pointer> interpolations;
+
+    auto numberOfInterpolatedSlices = m_InterpolationController->InterpolateAll(dim, plane, 0,
+      [&](unsigned int sliceIndex, const mitk::PlaneGeometry*, mitk::Image* interpolation)
+      {
+        interpolatedSlices.push_back(sliceIndex);
+        interpolations.push_back(interpolation);
+      });
+
+    CPPUNIT_ASSERT_EQUAL(5u, numberOfInterpolatedSlices);
+    CPPUNIT_ASSERT_EQUAL(std::size_t(5), interpolatedSlices.size());
+
+    auto expectedInterpolation = m_InterpolationController->Interpolate(dim, m_CenterPoint[dim], plane, 0);
+    CPPUNIT_ASSERT(expectedInterpolation.IsNotNull());
+    CPPUNIT_ASSERT_EQUAL(static_cast<unsigned int>(m_CenterPoint[dim]), interpolatedSlices[2]);
+
+    mitk::ImagePixelReadAccessor<mitk::Tool::DefaultSegmentationDataType, 2> expectedAccess(expectedInterpolation);
+    mitk::ImagePixelReadAccessor<mitk::Tool::DefaultSegmentationDataType, 2> actualAccess(interpolations[2]);
+    const auto numberOfPixels = expectedInterpolation->GetDimension(0) * expectedInterpolation->GetDimension(1);
+
+    CPPUNIT_ASSERT(std::equal(expectedAccess.GetData(), expectedAccess.GetData() + numberOfPixels, actualAccess.GetData()));
+  }
+
+  void InterpolateAll_Axial_ReturnsExpectedInterpolation()
+  {
+    /* Fill segmentation
+     *
+     * center - 2: 5x5 square
+     * center + 2: single pixel
+     * center + 6: single pixel
+     * -> the center slice should become a 3x3 square and the slices between the
+     *    two single pixels should contain the same single pixel
+     */
+    const int dim = 2;
+    const auto center = m_CenterPoint[dim];
+    this->FillSquare(dim, center - 2, 2);
+    this->FillSquare(dim, center + 2, 0);
+    this->FillSquare(dim, center + 6, 0);
+    m_InterpolationController->SetSegmentationVolume(m_SegmentationImage);
+
+    mitk::SliceNavigationController::Pointer navigationController = mitk::SliceNavigationController::New();
+    navigationController->SetInputWorldTimeGeometry(m_SegmentationImage->GetTimeGeometry());
+    navigationController->Update(mitk::AnatomicalPlane::Axial);
+    mitk::Point3D pointMM;
+    m_SegmentationImage->GetTimeGeometry()->GetGeometryForTimeStep(0)->IndexToWorld(m_CenterPoint, pointMM);
+    navigationController->SelectSliceByPoint(pointMM);
+    auto plane = navigationController->GetCurrentPlaneGeometry();
+
+    std::vector<unsigned int> interpolatedSlices;
+    std::vector<mitk::PlaneGeometry::Pointer> slicePlanes;
+    std::vector<mitk::Image::Pointer> interpolations;
+
+    auto numberOfInterpolatedSlices = m_InterpolationController->InterpolateAll(dim, plane, 0,
+      [&](unsigned int sliceIndex, const mitk::PlaneGeometry* slicePlane, mitk::Image* interpolation)
+      {
+        interpolatedSlices.push_back(sliceIndex);
+        slicePlanes.push_back(slicePlane->Clone());
+        interpolations.push_back(interpolation);
+      });
+
+    const std::vector<unsigned int> expectedSlices = { static_cast<unsigned int>(center - 1), static_cast<unsigned int>(center),
+      static_cast<unsigned int>(center + 1), static_cast<unsigned int>(center + 3), static_cast<unsigned int>(center + 4),
+      static_cast<unsigned int>(center + 5) };
+
+    CPPUNIT_ASSERT_EQUAL(6u, numberOfInterpolatedSlices);
+    CPPUNIT_ASSERT(expectedSlices == interpolatedSlices);
+
+    for (std::size_t i = 0; i < interpolations.size(); ++i)
+      this->WriteInterpolation(interpolations[i], slicePlanes[i]);
+
+    this->CheckSquare(dim, center, 1);
+    this->CheckSquare(dim, center + 3, 0);
+    this->CheckSquare(dim, center + 4, 0);
+    this->CheckSquare(dim, center + 5, 0);
+  }
 };
 
 MITK_TEST_SUITE_REGISTRATION(mitkSegmentationInterpolation)
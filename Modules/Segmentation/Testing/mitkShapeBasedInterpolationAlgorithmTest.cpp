@@ -0,0 +1,210 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+// Testing
+#include <mitkTestFixture.h>
+#include <mitkTestingMacros.h>
+
+// other
+#include <mitkImagePixelWriteAccessor.h>
+#include <mitkLabelSetImage.h>
+#include <mitkShapeBasedInterpolationAlgorithm.h>
+#include <mitkSliceNavigationController.h>
+
+#include <cmath>
+
+class mitkShapeBasedInterpolationAlgorithmTestSuite : public mitk::TestFixture
+{
+  CPPUNIT_TEST_SUITE(mitkShapeBasedInterpolationAlgorithmTestSuite);
+  MITK_TEST(ComputeDistanceMap_SquareSlice_ReturnsSignedDistances);
+  MITK_TEST(ComputeDistanceMap_CacheFull_EvictsLeastRecentlyUsed);
+  MITK_TEST(InvalidateDistanceMaps_Slice_RemovesIntersectingSlices);
+  MITK_TEST(SetCacheLabel_DifferentLabels_AreCachedSeparately);
+  MITK_TEST(SetSegmentation_SliceWrite_InvalidatesWrittenSlice);
+  MITK_TEST(SetSegmentation_UnannouncedModification_InvalidatesGroup);
+  CPPUNIT_TEST_SUITE_END();
+
+private:
+  using DistanceMapPointer = mitk::ShapeBasedInterpolationAlgorithm::DistanceImageType::ConstPointer;
+
+  mitk::ShapeBasedInterpolationAlgorithm::Pointer m_Algorithm;
+  mitk::Image::Pointer m_Slice;
+
+  /** 7x7 slice with a 3x3 square in its center.*/
+  static mitk::Image::Pointer CreateSquareSlice()
+  {
+    auto slice = mitk::Image::New();
+    unsigned int dimensions[2] = { 7, 7 };
+    slice->Initialize(mitk::MakeScalarPixelType<unsigned char>(), 2, dimensions);
+
+    mitk::ImagePixelWriteAccessor<unsigned char, 2> accessor(slice);
+    itk::Index<2> index;
+    for (index[1] = 0; index[1] < 7; ++index[1])
+      for (index[0] = 0; index[0] < 7; ++index[0])
+        accessor.SetPixelByIndex(index, (index[0] >= 2 && index[0] <= 4 && index[1] >= 2 && index[1] <= 4) ? 1 : 0);
+
+    return slice;
+  }
+
+  /** Plane of an axial slice of the passed image.*/
+  static mitk::PlaneGeometry::ConstPointer GetAxialPlane(const mitk::Image* image, itk::IndexValueType sliceIndex)
+  {
+    auto navigationController = mitk::SliceNavigationController::New();
+    navigationController->SetInputWorldTimeGeometry(image->GetTimeGeometry());
+    navigationController->Update(mitk::AnatomicalPlane::Axial);
+
+    itk::Index<3> index = { { 0, 0, sliceIndex } };
+    mitk::Point3D point;
+    image->GetGeometry()->IndexToWorld(index, point);
+    navigationController->SelectSliceByPoint(point);
+
+    return navigationController->GetCurrentPlaneGeometry();
+  }
+
+public:
+  void setUp() override
+  {
+    m_Algorithm = mitk::ShapeBasedInterpolationAlgorithm::New();
+    m_Slice = CreateSquareSlice();
+  }
+
+  void tearDown() override
+  {
+    m_Algorithm = nullptr;
+    m_Slice = nullptr;
+  }
+
+  void ComputeDistanceMap_SquareSlice_ReturnsSignedDistances()
+  {
+    auto distanceMap = m_Algorithm->ComputeDistanceMap(2, 0, 0, m_Slice);
+
+    // inside negative, outside positive, the contour lies half a pixel from the border pixels
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(-1.5, distanceMap->GetPixel({ { 3, 3 } }), mitk::eps);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(-0.5, distanceMap->GetPixel({ { 2, 3 } }), mitk::eps);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(0.5, distanceMap->GetPixel({ { 1, 3 } }), mitk::eps);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(1.5, distanceMap->GetPixel({ { 0, 3 } }), mitk::eps);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(std::sqrt(2.0) - 0.5, distanceMap->GetPixel({ { 1, 1 } }), mitk::eps);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(std::sqrt(8.0) - 0.5, distanceMap->GetPixel({ { 0, 0 } }), mitk::eps);
+  }
+
+  void ComputeDistanceMap_CacheFull_EvictsLeastRecentlyUsed()
+  {
+    m_Algorithm->SetDistanceMapCacheSize(2);
+    CPPUNIT_ASSERT_EQUAL(std::size_t(2), m_Algorithm->GetDistanceMapCacheSize());
+
+    DistanceMapPointer map0 = m_Algorithm->ComputeDistanceMap(2, 0, 0, m_Slice);
+    DistanceMapPointer map1 = m_Algorithm->ComputeDistanceMap(2, 1, 0, m_Slice);
+
+    CPPUNIT_ASSERT_MESSAGE("Cached distance map was recomputed", map0 == m_Algorithm->ComputeDistanceMap(2, 0, 0, m_Slice));
+
+    // slice 1 is the least recently used entry now
+    DistanceMapPointer map2 = m_Algorithm->ComputeDistanceMap(2, 2, 0, m_Slice);
+
+    CPPUNIT_ASSERT_MESSAGE("Recently used distance map was evicted", map0 == m_Algorithm->ComputeDistanceMap(2, 0, 0, m_Slice));
+    CPPUNIT_ASSERT_MESSAGE("New distance map was evicted", map2 == m_Algorithm->ComputeDistanceMap(2, 2, 0, m_Slice));
+    CPPUNIT_ASSERT_MESSAGE("Least recently used distance map was not evicted", map1 != m_Algorithm->ComputeDistanceMap(2, 1, 0, m_Slice));
+
+    // shrinking the cache keeps the most recently used entry (slice 1)
+    m_Algorithm->SetDistanceMapCacheSize(1);
+    DistanceMapPointer newMap1 = m_Algorithm->ComputeDistanceMap(2, 1, 0, m_Slice);
+    CPPUNIT_ASSERT_MESSAGE("Most recently used distance map was evicted", newMap1 == m_Algorithm->ComputeDistanceMap(2, 1, 0, m_Slice));
+    CPPUNIT_ASSERT_MESSAGE("Distance map was not evicted by shrinking the cache", map2 != m_Algorithm->ComputeDistanceMap(2, 2, 0, m_Slice));
+  }
+
+  void InvalidateDistanceMaps_Slice_RemovesIntersectingSlices()
+  {
+    DistanceMapPointer axial5 = m_Algorithm->ComputeDistanceMap(2, 5, 0, m_Slice);
+    DistanceMapPointer axial6 = m_Algorithm->ComputeDistanceMap(2, 6, 0, m_Slice);
+    DistanceMapPointer coronal3 = m_Algorithm->ComputeDistanceMap(1, 3, 0, m_Slice);
+    DistanceMapPointer axial5Time1 = m_Algorithm->ComputeDistanceMap(2, 5, 1, m_Slice);
+
+    m_Algorithm->InvalidateDistanceMaps(0, 2, 5, 0);
+
+    CPPUNIT_ASSERT_MESSAGE("Modified slice was not invalidated", axial5 != m_Algorithm->ComputeDistanceMap(2, 5, 0, m_Slice));
+    CPPUNIT_ASSERT_MESSAGE("Intersecting slice was not invalidated", coronal3 != m_Algorithm->ComputeDistanceMap(1, 3, 0, m_Slice));
+    CPPUNIT_ASSERT_MESSAGE("Parallel slice was invalidated", axial6 == m_Algorithm->ComputeDistanceMap(2, 6, 0, m_Slice));
+    CPPUNIT_ASSERT_MESSAGE("Other time step was invalidated", axial5Time1 == m_Algorithm->ComputeDistanceMap(2, 5, 1, m_Slice));
+
+    m_Algorithm->InvalidateDistanceMaps();
+    CPPUNIT_ASSERT_MESSAGE("Cache was not cleared", axial6 != m_Algorithm->ComputeDistanceMap(2, 6, 0, m_Slice));
+  }
+
+  void SetCacheLabel_DifferentLabels_AreCachedSeparately()
+  {
+    m_Algorithm->SetCacheLabel(0, 1);
+    DistanceMapPointer label1 = m_Algorithm->ComputeDistanceMap(2, 5, 0, m_Slice);
+
+    m_Algorithm->SetCacheLabel(0, 2);
+    DistanceMapPointer label2 = m_Algorithm->ComputeDistanceMap(2, 5, 0, m_Slice);
+    CPPUNIT_ASSERT_MESSAGE("Distance map of another label was used", label1 != label2);
+
+    m_Algorithm->SetCacheLabel(0, 1);
+    CPPUNIT_ASSERT_MESSAGE("Distance map was not kept while another label was used", label1 == m_Algorithm->ComputeDistanceMap(2, 5, 0, m_Slice));
+  }
+
+  void SetSegmentation_SliceWrite_InvalidatesWrittenSlice()
+  {
+    auto referenceImage = mitk::Image::New();
+    unsigned int dimensions[3] = { 7, 7, 10 };
+    referenceImage->Initialize(mitk::MakeScalarPixelType<unsigned char>(), 3, dimensions);
+
+    auto segmentation = mitk::MultiLabelSegmentation::New();
+    segmentation->Initialize(referenceImage);
+    mitk::Color color;
+    color.Set(1.0f, 0.0f, 0.0f);
+    auto label = segmentation->AddLabel("Square", color, 0)->GetValue();
+
+    m_Algorithm->SetSegmentation(segmentation);
+    m_Algorithm->SetCacheLabel(0, label);
+
+    DistanceMapPointer slice3 = m_Algorithm->ComputeDistanceMap(2, 3, 0, m_Slice);
+    DistanceMapPointer slice6 = m_Algorithm->ComputeDistanceMap(2, 6, 0, m_Slice);
+
+    // emulates SegTool2D writing slice 3
+    auto groupImage = segmentation->GetGroupImage(0);
+    const auto originalMTime = groupImage->GetMTime();
+    groupImage->Modified();
+    auto plane = GetAxialPlane(groupImage, 3);
+    segmentation->GroupSliceModified(mitk::GroupSliceModifiedEvent(0, 0, plane, nullptr, nullptr, originalMTime));
+
+    CPPUNIT_ASSERT_MESSAGE("Unaffected slice was invalidated", slice6 == m_Algorithm->ComputeDistanceMap(2, 6, 0, m_Slice));
+    CPPUNIT_ASSERT_MESSAGE("Written slice was not invalidated", slice3 != m_Algorithm->ComputeDistanceMap(2, 3, 0, m_Slice));
+
+    m_Algorithm->SetSegmentation(nullptr);
+  }
+
+  void SetSegmentation_UnannouncedModification_InvalidatesGroup()
+  {
+    auto referenceImage = mitk::Image::New();
+    unsigned int dimensions[3] = { 7, 7, 10 };
+    referenceImage->Initialize(mitk::MakeScalarPixelType<unsigned char>(), 3, dimensions);
+
+    auto segmentation = mitk::MultiLabelSegmentation::New();
+    segmentation->Initialize(referenceImage);
+    mitk::Color color;
+    color.Set(1.0f, 0.0f, 0.0f);
+    auto label = segmentation->AddLabel("Square", color, 0)->GetValue();
+
+    m_Algorithm->SetSegmentation(segmentation);
+    m_Algorithm->SetCacheLabel(0, label);
+
+    DistanceMapPointer slice6 = m_Algorithm->ComputeDistanceMap(2, 6, 0, m_Slice);
+    CPPUNIT_ASSERT_MESSAGE("Cached distance map was recomputed", slice6 == m_Algorithm->ComputeDistanceMap(2, 6, 0, m_Slice));
+
+    segmentation->GetGroupImage(0)->Modified();
+    CPPUNIT_ASSERT_MESSAGE("Distance map of a modified group was used", slice6 != m_Algorithm->ComputeDistanceMap(2, 6, 0, m_Slice));
+
+    m_Algorithm->SetSegmentation(nullptr);
+  }
+};
+
+MITK_TEST_SUITE_REGISTRATION(mitkShapeBasedInterpolationAlgorithm)
@@ -40,7 +40,6 @@ found in the LICENSE file.
 #include <mitkPlaneProposer.h>
 #include <mitkUnstructuredGridClusteringFilter.h>
 #include <mitkVtkImageOverwrite.h>
-#include <mitkShapeBasedInterpolationAlgorithm.h>
 #include <itkCommand.h>
 
 #include <mitkImageToContourFilter.h>
@@ -68,8 +67,6 @@ found in the LICENSE file.
 #include <vtkPolyData.h>
 
 #include <array>
-#include <atomic>
-#include <thread>
 #include <vector>
 
 namespace
@@ -848,6 +845,7 @@ void QmitkSlicesInterpolator::AcceptAllInterpolations(mitk::SliceNavigationContr
     {
       MITK_ERROR << e.what() << " | NO LABELSETIMAGE IN WORKING NODE\n";
     }
+    m_Interpolator->SetLabelSource(m_Segmentation, m_CurrentActiveLabelValue);
     m_Interpolator->SetSegmentationVolume(activeLabelImage);
 
     const auto relevantGroupImage = m_Segmentation->GetGroupImage(m_Segmentation->GetGroupIndexOfLabel(m_CurrentActiveLabelValue));
@@ -868,7 +866,6 @@ void QmitkSlicesInterpolator::AcceptAllInterpolations(mitk::SliceNavigationContr
     }
 
     // Since we need to shift the plane it must be clone so that the original plane isn't altered
-    auto slicedGeometry = m_Segmentation->GetSlicedGeometry();
     auto planeGeometry = slicer->GetCurrentPlaneGeometry()->Clone();
     int sliceDimension = -1;
     int sliceIndex = -1;
@@ -884,75 +881,40 @@ void QmitkSlicesInterpolator::AcceptAllInterpolations(mitk::SliceNavigationContr
     const auto numSlices = m_Segmentation->GetDimensions()[sliceDimension];
     mitk::ProgressBar::GetInstance()->AddStepsToDo(numSlices);
 
-    std::atomic_uint totalChangedSlices;
-
-    // Reuse interpolation algorithm instance for each slice to cache boundary calculations
-    auto algorithm = mitk::ShapeBasedInterpolationAlgorithm::New();
-
-    // Distribute slice interpolations to multiple threads
-    const auto numThreads = std::min(std::thread::hardware_concurrency(), numSlices);
-    std::vector<std::vector<unsigned int>> sliceIndices(numThreads);
-
-    for (std::remove_const_t<decltype(numSlices)> sliceIndex = 0; sliceIndex < numSlices; ++sliceIndex)
-      sliceIndices[sliceIndex % numThreads].push_back(sliceIndex);
-
-    std::vector<std::thread> threads;
-    threads.reserve(numThreads);
-
     auto timeStep = m_Segmentation->GetTimeGeometry()->TimePointToTimeStep(m_TimePoint);
 
-    // This lambda will be executed by the threads
-    auto interpolate = [=, &interpolator = m_Interpolator, &totalChangedSlices](unsigned int threadIndex)
+    // Writes the interpolation results back into the diff image
+    auto writeInterpolation = [&diffImage](unsigned int, const mitk::PlaneGeometry* slicePlane, mitk::Image* interpolation)
     {
-      auto clonedPlaneGeometry = planeGeometry->Clone();
-      auto origin = clonedPlaneGeometry->GetOrigin();
-
-      //  Go through the sliced indices
-      for (auto sliceIndex : sliceIndices[threadIndex])
-      {
-        slicedGeometry->WorldToIndex(origin, origin);
-        origin[sliceDimension] = sliceIndex;
-        slicedGeometry->IndexToWorld(origin, origin);
-        clonedPlaneGeometry->SetOrigin(origin);
-
-        auto interpolation = interpolator->Interpolate(sliceDimension, sliceIndex, clonedPlaneGeometry, timeStep, algorithm);
-
-        if (interpolation.IsNotNull())
-        {
-          // Setting up the reslicing pipeline which allows us to write the interpolation results back into the image volume
-          auto reslicer = vtkSmartPointer<mitkVtkImageOverwrite>::New();
-
-          // Set overwrite mode to true to write back to the image volume
-          reslicer->SetInputSlice(interpolation->GetSliceData()->GetVtkImageAccessor(interpolation)->GetVtkImageData());
-          reslicer->SetOverwriteMode(true);
-          reslicer->Modified();
+      // Setting up the reslicing pipeline which allows us to write the interpolation results back into the image volume
+      auto reslicer = vtkSmartPointer<mitkVtkImageOverwrite>::New();
 
-          auto diffSliceWriter = mitk::ExtractSliceFilter::New(reslicer);
+      // Set overwrite mode to true to write back to the image volume
+      reslicer->SetInputSlice(interpolation->GetSliceData()->GetVtkImageAccessor(interpolation)->GetVtkImageData());
+      reslicer->SetOverwriteMode(true);
+      reslicer->Modified();
 
-          diffSliceWriter->SetInput(diffImage);
-          diffSliceWriter->SetTimeStep(0);
-          diffSliceWriter->SetWorldGeometry(clonedPlaneGeometry);
-          diffSliceWriter->SetVtkOutputRequest(true);
-          diffSliceWriter->SetResliceTransformByGeometry(diffImage->GetTimeGeometry()->GetGeometryForTimeStep(0));
-          diffSliceWriter->Modified();
-          diffSliceWriter->Update();
+      auto diffSliceWriter = mitk::ExtractSliceFilter::New(reslicer);
 
-          ++totalChangedSlices;
-        }
+      diffSliceWriter->SetInput(diffImage);
+      diffSliceWriter->SetTimeStep(0);
+      diffSliceWriter->SetWorldGeometry(slicePlane);
+      diffSliceWriter->SetVtkOutputRequest(true);
+      diffSliceWriter->SetResliceTransformByGeometry(diffImage->GetTimeGeometry()->GetGeometryForTimeStep(0));
+      diffSliceWriter->Modified();
+      diffSliceWriter->Update();
 
-        mitk::ProgressBar::GetInstance()->Progress();
-      }
+      mitk::ProgressBar::GetInstance()->Progress();
     };
-    m_Interpolator->EnableSliceImageCache();
-
-    //  Do the interpolation here.
-    for (size_t threadIndex = 0; threadIndex < numThreads; ++threadIndex)
-    {
-      interpolate(threadIndex);
-    }
 
+    // All gaps of the label are interpolated in parallel, the results are written back sequentially.
+    m_Interpolator->EnableSliceImageCache();
+    // The algorithm of the controller is used, so distance maps computed for the suggestions are reused.
+    const auto totalChangedSlices = m_Interpolator->InterpolateAll(sliceDimension, planeGeometry, timeStep, writeInterpolation);
     m_Interpolator->DisableSliceImageCache();
 
+    mitk::ProgressBar::GetInstance()->Progress(numSlices - totalChangedSlices);
+
     if (totalChangedSlices > 0)
     {
       const auto activeLabel = m_Segmentation->GetActiveLabel();
@@ -1238,6 +1200,7 @@ void QmitkSlicesInterpolator::OnInterpolationActivated(bool on)
       if (nullptr != activeLabel)
       {
         auto activeLabelImage = mitk::CreateLabelMask(labelSetImage, activeLabel->GetValue());
+        m_Interpolator->SetLabelSource(labelSetImage, activeLabel->GetValue());
         m_Interpolator->SetSegmentationVolume(activeLabelImage);
       }
     }
@@ -1496,4 +1459,10 @@ void QmitkSlicesInterpolator::NodeRemoved(const mitk::DataNode* node)
   {
     WaitForFutures();
   }
+
+  if (m_ToolManager && m_ToolManager->GetWorkingData(0) == node)
+  {
+    // the cached distance maps must not keep the removed segmentation alive
+    m_Interpolator->SetLabelSource(nullptr, 0);
+  }
 }
@@ -2,6 +2,7 @@ set(MODULE_TESTS
   mitkComputeContourSetNormalsFilterTest.cpp
   mitkCreateDistanceImageFromSurfaceFilterTest.cpp
   mitkImageToPointCloudFilterTest.cpp
+  mitkPartitionOfUnityRBFInterpolantTest.cpp
   mitkReduceContourSetFilterTest.cpp
   mitkSurfaceInterpolationControllerTest.cpp
 )
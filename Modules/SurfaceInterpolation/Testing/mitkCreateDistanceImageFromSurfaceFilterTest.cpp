@@ -14,10 +14,16 @@ found in the LICENSE file.
 #include <mitkCreateDistanceImageFromSurfaceFilter.h>
 #include <mitkIOUtil.h>
 #include <mitkImageAccessByItk.h>
+#include <mitkImageReadAccessor.h>
 #include <mitkTestFixture.h>
 #include <mitkTestingMacros.h>
 
+#include <vtkCellArray.h>
+#include <vtkCellData.h>
 #include <vtkDebugLeaks.h>
+#include <vtkDoubleArray.h>
+#include <vtkPoints.h>
+#include <vtkPolyData.h>
 
 class mitkCreateDistanceImageFromSurfaceFilterTestSuite : public mitk::TestFixture
 {
@@ -26,6 +32,9 @@ class mitkCreateDistanceImageFromSurfaceFilterTestSuite : public mitk::TestFixtu
   // Basically tests the same as the other test below
   // MITK_TEST(TestCreateDistanceImageForLiver);
   MITK_TEST(TestCreateDistanceImageForTube);
+  MITK_TEST(TestParallelFillingEqualsSerialFilling);
+  MITK_TEST(TestParallelFillingReachesDisconnectedContours);
+  MITK_TEST(TestAutomaticSolverSwitchesAtThreshold);
   CPPUNIT_TEST_SUITE_END();
 
 private:
@@ -33,6 +42,83 @@ private:
 
 public:
   void setUp() override {}
+
+  /** Circular contour with normals per point, like the output of the ComputeContourSetNormalsFilter. */
+  static mitk::Surface::Pointer CreateCircularContour(double centerX, double z, double radius)
+  {
+    const int numberOfPoints = static_cast<int>(2 * itk::Math::pi * radius);
+
+    auto points = vtkSmartPointer<vtkPoints>::New();
+    auto polygon = vtkSmartPointer<vtkCellArray>::New();
+    auto normals = vtkSmartPointer<vtkDoubleArray>::New();
+    normals->SetNumberOfComponents(3);
+
+    polygon->InsertNextCell(numberOfPoints);
+
+    for (int i = 0; i < numberOfPoints; ++i)
+    {
+      const double angle = 2 * itk::Math::pi * i / numberOfPoints;
+      const double normal[] = {std::cos(angle), std::sin(angle), 0.0};
+
+      polygon->InsertCellPoint(points->InsertNextPoint(centerX + radius * normal[0], radius * normal[1], z));
+      normals->InsertNextTuple(normal);
+    }
+
+    auto polyData = vtkSmartPointer<vtkPolyData>::New();
+    polyData->SetPoints(points);
+    polyData->SetPolys(polygon);
+    polyData->GetCellData()->SetNormals(normals);
+
+    auto contour = mitk::Surface::New();
+    contour->SetVtkPolyData(polyData);
+    return contour;
+  }
+
+  /** Contours of spheres with radius 10 on seven slices each. */
+  static mitk::Image::Pointer CreateDistanceImageOfSpheres(
+    const std::vector<double> &centersX,
+    bool useParallelFilling,
+    mitk::CreateDistanceImageFromSurfaceFilter::RBFSolver solver = mitk::CreateDistanceImageFromSurfaceFilter::RBFSolver::Automatic,
+    unsigned int partitionOfUnityThreshold = 3000)
+  {
+    auto referenceImage = itk::Image<unsigned char, 3>::New();
+    itk::Image<unsigned char, 3>::SizeType size;
+    size.Fill(100);
+    referenceImage->SetRegions(size);
+    referenceImage->SetOrigin(itk::Point<double, 3>(-50.0));
+
+    auto filter = mitk::CreateDistanceImageFromSurfaceFilter::New();
+    filter->SetReferenceImage(referenceImage.GetPointer());
+    filter->SetUseParallelFilling(useParallelFilling);
+    filter->SetRBFSolver(solver);
+    filter->SetPartitionOfUnityThreshold(partitionOfUnityThreshold);
+
+    unsigned int input = 0;
+
+    for (auto centerX : centersX)
+    {
+      for (int slice = -3; slice <= 3; ++slice)
+      {
+        const double z = 3.0 * slice;
+        filter->SetInput(input++, CreateCircularContour(centerX, z, std::sqrt(100.0 - z * z)));
+      }
+    }
+
+    filter->Update();
+    return filter->GetOutput();
+  }
+
+  static double GetPixelAtPoint(mitk::Image *image, const mitk::Point3D &point)
+  {
+    itk::Index<3> index;
+    image->GetGeometry()->WorldToIndex(point, index);
+
+    mitk::ImageReadAccessor accessor(image);
+    const auto *dimensions = image->GetDimensions();
+    const auto *data = static_cast<const double *>(accessor.GetData());
+
+    return data[index[0] + dimensions[0] * (index[1] + dimensions[1] * index[2])];
+  }
   template <typename TPixel, unsigned int VImageDimension>
   void GetImageBase(itk::Image<TPixel, VImageDimension> *input, itk::ImageBase<3>::Pointer &result)
   {
@@ -128,6 +214,56 @@ public:
     CPPUNIT_ASSERT_MESSAGE("HolesDistanceImages are not equal!",
                            mitk::Equal(*(holesDistanceImageReference), *(holeDistanceImage), 0.0001, true));
   }
+
+  void TestParallelFillingEqualsSerialFilling()
+  {
+    auto serialDistanceImage = CreateDistanceImageOfSpheres({0.0}, false);
+    auto parallelDistanceImage = CreateDistanceImageOfSpheres({0.0}, true);
+
+    CPPUNIT_ASSERT_MESSAGE("Serially and parallelly filled distance images are not equal!",
+                           mitk::Equal(*serialDistanceImage, *parallelDistanceImage, 0.0001, true));
+  }
+
+  void TestParallelFillingReachesDisconnectedContours()
+  {
+    // The narrow bands of both spheres are not connected
+    auto distanceImage = CreateDistanceImageOfSpheres({-15.0, 15.0}, true);
+
+    mitk::Point3D center;
+    center.Fill(0.0);
+
+    for (auto centerX : {-15.0, 15.0})
+    {
+      center[0] = centerX;
+      CPPUNIT_ASSERT_MESSAGE("Center of sphere is not inside", GetPixelAtPoint(distanceImage, center) < 0.0);
+    }
+
+    center[0] = 0.0;
+    CPPUNIT_ASSERT_MESSAGE("Point between spheres is not outside", GetPixelAtPoint(distanceImage, center) > 0.0);
+  }
+
+  void TestAutomaticSolverSwitchesAtThreshold()
+  {
+    using RBFSolver = mitk::CreateDistanceImageFromSurfaceFilter::RBFSolver;
+
+    // The contours of one sphere yield about 1200 centers
+    auto denseDistanceImage = CreateDistanceImageOfSpheres({0.0}, false, RBFSolver::Dense);
+    auto partitionOfUnityDistanceImage = CreateDistanceImageOfSpheres({0.0}, false, RBFSolver::PartitionOfUnity);
+
+    auto belowThresholdDistanceImage = CreateDistanceImageOfSpheres({0.0}, false, RBFSolver::Automatic, 3000);
+    CPPUNIT_ASSERT_MESSAGE("Automatic solver did not use the dense solver below the threshold",
+                           mitk::Equal(*denseDistanceImage, *belowThresholdDistanceImage, mitk::eps, true));
+
+    auto aboveThresholdDistanceImage = CreateDistanceImageOfSpheres({0.0}, false, RBFSolver::Automatic, 100);
+    CPPUNIT_ASSERT_MESSAGE("Automatic solver did not use the partition of unity above the threshold",
+                           mitk::Equal(*partitionOfUnityDistanceImage, *aboveThresholdDistanceImage, mitk::eps, true));
+
+    // Both solvers interpolate the same contours
+    mitk::Point3D center;
+    center.Fill(0.0);
+    CPPUNIT_ASSERT(GetPixelAtPoint(partitionOfUnityDistanceImage, center) < 0.0);
+    CPPUNIT_ASSERT(GetPixelAtPoint(denseDistanceImage, center) < 0.0);
+  }
 };
 
 MITK_TEST_SUITE_REGISTRATION(mitkCreateDistanceImageFromSurfaceFilter)
@@ -0,0 +1,170 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include <mitkException.h>
+#include <mitkPartitionOfUnityRBFInterpolant.h>
+#include <mitkTestFixture.h>
+#include <mitkTestingMacros.h>
+
+#include <itkMath.h>
+
+#include <cmath>
+
+class mitkPartitionOfUnityRBFInterpolantTestSuite : public mitk::TestFixture
+{
+  CPPUNIT_TEST_SUITE(mitkPartitionOfUnityRBFInterpolantTestSuite);
+  MITK_TEST(TestCenterValuesAreInterpolated);
+  MITK_TEST(TestSignOfSphereDistance);
+  MITK_TEST(TestPointsBeyondDomainAreNotCovered);
+  MITK_TEST(TestSmallPatchesInterpolateCenterValues);
+  MITK_TEST(TestInvalidInputThrows);
+  CPPUNIT_TEST_SUITE_END();
+
+private:
+  typedef mitk::PartitionOfUnityRBFInterpolant::PointType PointType;
+
+  static constexpr double Radius = 20.0;
+  static constexpr double Spacing = 1.0;
+
+  std::vector<PointType> m_Centers;
+  Eigen::VectorXd m_Values;
+  mitk::PartitionOfUnityRBFInterpolant m_Interpolant;
+
+  static PointType CreatePoint(double x, double y, double z)
+  {
+    PointType point;
+    point[0] = x;
+    point[1] = y;
+    point[2] = z;
+    return point;
+  }
+
+public:
+  /**
+   * Circular contours of a sphere on nine slices, about one point per millimeter, and the inner and outer
+   * centers along the normals, like they are created by the CreateDistanceImageFromSurfaceFilter.
+   */
+  void setUp() override
+  {
+    std::vector<PointType> points;
+    std::vector<PointType> normals;
+
+    for (int slice = -4; slice <= 4; ++slice)
+    {
+      const double z = 4.0 * slice;
+      const double radius = std::sqrt(Radius * Radius - z * z);
+      const int numberOfPoints = static_cast<int>(2 * itk::Math::pi * radius);
+
+      for (int i = 0; i < numberOfPoints; ++i)
+      {
+        const double angle = 2 * itk::Math::pi * i / numberOfPoints;
+        points.push_back(CreatePoint(radius * std::cos(angle), radius * std::sin(angle), z));
+        normals.push_back(points.back() / Radius);
+      }
+    }
+
+    const auto numberOfPoints = points.size();
+
+    m_Centers = points;
+    m_Values.setZero(3 * numberOfPoints);
+
+    for (std::size_t i = 0; i < numberOfPoints; ++i)
+    {
+      m_Centers.push_back(points[i] - normals[i] * Spacing);
+      m_Values[numberOfPoints + i] = -Spacing;
+    }
+
+    for (std::size_t i = 0; i < numberOfPoints; ++i)
+    {
+      m_Centers.push_back(points[i] + normals[i] * Spacing);
+      m_Values[2 * numberOfPoints + i] = Spacing;
+    }
+
+    m_Interpolant.Build(m_Centers, m_Values, 2 * Spacing);
+  }
+
+  void tearDown() override
+  {
+    m_Interpolant.Clear();
+    m_Centers.clear();
+  }
+
+  void TestCenterValuesAreInterpolated()
+  {
+    CPPUNIT_ASSERT(m_Interpolant.GetNumberOfPatches() > 1);
+
+    for (std::size_t i = 0; i < m_Centers.size(); ++i)
+    {
+      double value = 0.0;
+      CPPUNIT_ASSERT(m_Interpolant.Evaluate(m_Centers[i], value));
+      CPPUNIT_ASSERT_DOUBLES_EQUAL(m_Values[i], value, 0.01);
+    }
+  }
+
+  void TestSignOfSphereDistance()
+  {
+    // Sample points in between the contours and on other angles than the contour points
+    for (int z = -16; z <= 16; ++z)
+    {
+      for (double radius : { 17.0, 19.5, 20.5, 21.0 })
+      {
+        const double radiusInSlice = std::sqrt(radius * radius - z * z);
+
+        for (int i = 0; i < 36; ++i)
+        {
+          const double angle = 2 * itk::Math::pi * i / 36 + 0.1;
+          const auto point = CreatePoint(radiusInSlice * std::cos(angle), radiusInSlice * std::sin(angle), z);
+
+          double value = 0.0;
+          CPPUNIT_ASSERT(m_Interpolant.Evaluate(point, value));
+          CPPUNIT_ASSERT_EQUAL(radius < Radius, value < 0.0);
+        }
+      }
+    }
+  }
+
+  void TestPointsBeyondDomainAreNotCovered()
+  {
+    double value = 0.0;
+    CPPUNIT_ASSERT(!m_Interpolant.Evaluate(CreatePoint(5 * Radius, 0.0, 0.0), value));
+    CPPUNIT_ASSERT(!m_Interpolant.Evaluate(CreatePoint(0.0, 0.0, -5 * Radius), value));
+  }
+
+  void TestSmallPatchesInterpolateCenterValues()
+  {
+    // Spheres that would contain more centers than a patch may hold are subdivided or shrunk
+    mitk::PartitionOfUnityRBFInterpolant interpolant;
+    interpolant.SetMaximumNumberOfCentersPerCell(8);
+    interpolant.SetNumberOfCentersPerPatch(8, 16);
+    interpolant.Build(m_Centers, m_Values, 2 * Spacing);
+
+    CPPUNIT_ASSERT(interpolant.GetNumberOfPatches() > m_Interpolant.GetNumberOfPatches());
+
+    for (std::size_t i = 0; i < m_Centers.size(); ++i)
+    {
+      double value = 0.0;
+      CPPUNIT_ASSERT(interpolant.Evaluate(m_Centers[i], value));
+      CPPUNIT_ASSERT_DOUBLES_EQUAL(m_Values[i], value, 0.01);
+    }
+  }
+
+  void TestInvalidInputThrows()
+  {
+    mitk::PartitionOfUnityRBFInterpolant interpolant;
+    Eigen::VectorXd values(2);
+
+    CPPUNIT_ASSERT_THROW(interpolant.Build(m_Centers, values, 0.0), mitk::Exception);
+    CPPUNIT_ASSERT_THROW(interpolant.Build(std::vector<PointType>(), Eigen::VectorXd(), 0.0), mitk::Exception);
+  }
+};
+
+MITK_TEST_SUITE_REGISTRATION(mitkPartitionOfUnityRBFInterpolant)
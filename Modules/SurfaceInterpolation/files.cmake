@@ -2,6 +2,7 @@ set(CPP_FILES
   mitkComputeContourSetNormalsFilter.cpp
   mitkCreateDistanceImageFromSurfaceFilter.cpp
   mitkImageToPointCloudFilter.cpp
+  mitkPartitionOfUnityRBFInterpolant.cpp
   mitkPlaneProposer.cpp
   mitkReduceContourSetFilter.cpp
   mitkSurfaceInterpolationController.cpp
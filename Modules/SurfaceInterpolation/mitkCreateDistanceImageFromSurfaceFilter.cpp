@@ -20,9 +20,15 @@ found in the LICENSE file.
 #include "vtkSmartPointer.h"
 
 #include "itkImageRegionIteratorWithIndex.h"
+#include "itkMultiThreaderBase.h"
 #include "itkNeighborhoodIterator.h"
 
+#include <algorithm>
+#include <atomic>
+#include <memory>
 #include <queue>
+#include <set>
+#include <tuple>
 
 void mitk::CreateDistanceImageFromSurfaceFilter::CreateEmptyDistanceImage()
 {
@@ -104,7 +110,12 @@ void mitk::CreateDistanceImageFromSurfaceFilter::CreateEmptyDistanceImage()
 }
 
 mitk::CreateDistanceImageFromSurfaceFilter::CreateDistanceImageFromSurfaceFilter()
-  : m_DistanceImageSpacing(0.0), m_DistanceImageDefaultBufferValue(0.0)
+  : m_RBFSolver(RBFSolver::Automatic),
+    m_PartitionOfUnityThreshold(3000),
+    m_UsePartitionOfUnity(false),
+    m_UseParallelFilling(false),
+    m_DistanceImageSpacing(0.0),
+    m_DistanceImageDefaultBufferValue(0.0)
 {
   m_DistanceImageVolume = 50000;
   this->m_UseProgressBar = false;
@@ -129,19 +140,31 @@ void mitk::CreateDistanceImageFromSurfaceFilter::GenerateData()
   if (this->m_UseProgressBar)
     mitk::ProgressBar::GetInstance()->Progress(1);
 
-  m_Weights = m_SolutionMatrix.partialPivLu().solve(m_FunctionValues);
+  if (m_UsePartitionOfUnity)
+  {
+    // The narrow band reaches up to two times the spacing beyond the outer centers
+    m_PartitionOfUnityInterpolant.Build(m_Centers, m_FunctionValues, 2 * m_DistanceImageSpacing);
+  }
+  else
+  {
+    m_Weights = m_SolutionMatrix.partialPivLu().solve(m_FunctionValues);
+  }
 
   if (this->m_UseProgressBar)
     mitk::ProgressBar::GetInstance()->Progress(2);
 
   // The last step is to create the distance map with the interpolated distance function
-  this->FillDistanceImage();
+  if (m_UseParallelFilling)
+    this->FillDistanceImageParallel();
+  else
+    this->FillDistanceImage();
 
   if (this->m_UseProgressBar)
     mitk::ProgressBar::GetInstance()->Progress(2);
 
   m_Centers.clear();
   m_Normals.clear();
+  m_PartitionOfUnityInterpolant.Clear();
 }
 
 void mitk::CreateDistanceImageFromSurfaceFilter::PreprocessContourPoints()
@@ -167,6 +190,9 @@ void mitk::CreateDistanceImageFromSurfaceFilter::PreprocessContourPoints()
   PointType currentPoint;
   PointType normal;
 
+  // Duplicates are looked up in a set instead of the list of centers, which would be quadratic in the number of points
+  std::set<std::tuple<double, double, double>> existingCenters;
+
   for (unsigned int i = 0; i < numberOfInputs; i++)
   {
     auto currentSurface = this->GetInput(i);
@@ -198,9 +224,7 @@ void mitk::CreateDistanceImageFromSurfaceFilter::PreprocessContourPoints()
 
         currentPoint.copy_in(p);
 
-        int count = std::count(m_Centers.begin(), m_Centers.end(), currentPoint);
-
-        if (count == 0)
+        if (existingCenters.emplace(p[0], p[1], p[2]).second)
         {
           double currentNormal[3];
           currentCellNormals->GetTuple(cell[j], currentNormal);
@@ -263,6 +287,16 @@ void mitk::CreateDistanceImageFromSurfaceFilter::CreateSolutionMatrixAndFunction
   // Now we have created all centers and all function values. Next step is to create the solution matrix
   numberOfCenters = m_Centers.size();
 
+  m_UsePartitionOfUnity = RBFSolver::PartitionOfUnity == m_RBFSolver ||
+                          (RBFSolver::Automatic == m_RBFSolver && numberOfCenters > m_PartitionOfUnityThreshold);
+
+  if (m_UsePartitionOfUnity)
+  {
+    // The local equation systems are created by the interpolant
+    m_SolutionMatrix.resize(0, 0);
+    return;
+  }
+
   m_SolutionMatrix.resize(numberOfCenters, numberOfCenters);
 
   m_Weights.resize(numberOfCenters);
@@ -417,9 +451,270 @@ void mitk::CreateDistanceImageFromSurfaceFilter::FillDistanceImage()
   CastToMitkImage(m_DistanceImageITK, resultImage);
 }
 
+void mitk::CreateDistanceImageFromSurfaceFilter::FillDistanceImageParallel()
+{
+  /*
+  * Parallel variant of FillDistanceImage():
+  *
+  * 1. All contour points are the seeds, i.e. the first wavefront of the narrow band
+  * 2. Each wavefront is split into chunks that are processed in parallel. A chunk claims the unvisited
+  *    6-neighbors of its voxels and evaluates the distance function for them in batches. The neighbors
+  *    whose distance is below a certain threshold form the next wavefront.
+  * 3. This is repeated until the wavefront is empty.
+  *
+  * Every voxel is claimed exactly once, so the result does not depend on the number of threads.
+  * Afterwards the interior is filled row by row in parallel, the rows are independent of each other.
+  */
+
+  constexpr std::size_t ChunkSize = 256;
+  constexpr Eigen::Index BatchSize = 64;
+
+  const auto size = m_DistanceImageITK->GetLargestPossibleRegion().GetSize();
+  const std::size_t sizeX = size[0], sizeY = size[1], sizeZ = size[2];
+  const auto numberOfPixels = sizeX * sizeY * sizeZ;
+
+  const auto &origin = m_DistanceImageITK->GetOrigin();
+  const auto &indexToPhysicalPoint = m_DistanceImageITK->GetIndexToPhysicalPoint();
+  auto *buffer = m_DistanceImageITK->GetBufferPointer();
+  const auto threshold = m_DistanceImageSpacing * 2;
+
+  // Same arithmetic as itk::ImageBase::TransformIndexToPhysicalPoint() for the region starting at index 0
+  auto toPhysicalPoint = [&](std::size_t offset, Eigen::ArrayX3d &points, Eigen::Index row) {
+    const double index[3] = {static_cast<double>(offset % sizeX),
+                             static_cast<double>((offset / sizeX) % sizeY),
+                             static_cast<double>(offset / (sizeX * sizeY))};
+
+    for (unsigned int i = 0; i < 3; ++i)
+    {
+      points(row, i) = origin[i];
+
+      for (unsigned int j = 0; j < 3; ++j)
+        points(row, i) += indexToPhysicalPoint[i][j] * index[j];
+    }
+  };
+
+  std::unique_ptr<std::atomic<bool>[]> visited(new std::atomic<bool>[numberOfPixels]);
+
+  for (std::size_t i = 0; i < numberOfPixels; ++i)
+    visited[i].store(false, std::memory_order_relaxed);
+
+  // The first third of the centers are the contour points, see CreateSolutionMatrixAndFunctionValues()
+  const auto numberOfContourPoints = m_Centers.size() / 3;
+  std::vector<std::size_t> seeds;
+  seeds.reserve(numberOfContourPoints);
+
+  for (std::size_t i = 0; i < numberOfContourPoints; ++i)
+  {
+    DistanceImageType::PointType point;
+    point[0] = m_Centers[i][0];
+    point[1] = m_Centers[i][1];
+    point[2] = m_Centers[i][2];
+
+    const auto index = m_DistanceImageITK->TransformPhysicalPointToIndex(point);
+
+    if (!m_DistanceImageITK->GetLargestPossibleRegion().IsInside(index))
+      continue;
+
+    const auto offset = static_cast<std::size_t>(index[0]) + sizeX * (index[1] + sizeY * index[2]);
+
+    if (!visited[offset].exchange(true))
+      seeds.push_back(offset);
+  }
+
+  auto multiThreader = itk::MultiThreaderBase::New();
+
+  // Evaluate the distance function for voxels in batches. Seeds are always set, all other voxels only
+  // within the narrow band.
+  auto evaluate = [&](const std::vector<std::size_t> &offsets, bool isSeed, std::vector<std::size_t> &narrowBand) {
+    Eigen::ArrayX3d points(BatchSize, 3);
+    Eigen::ArrayXd distances;
+
+    for (std::size_t first = 0; first < offsets.size(); first += BatchSize)
+    {
+      const auto count = std::min<Eigen::Index>(BatchSize, offsets.size() - first);
+
+      if (count < BatchSize)
+        points.conservativeResize(count, 3);
+
+      for (Eigen::Index i = 0; i < count; ++i)
+        toPhysicalPoint(offsets[first + i], points, i);
+
+      this->CalculateDistanceValues(points, distances);
+
+      for (Eigen::Index i = 0; i < count; ++i)
+      {
+        if (isSeed || std::fabs(distances[i]) <= threshold)
+        {
+          buffer[offsets[first + i]] = distances[i];
+          narrowBand.push_back(offsets[first + i]);
+        }
+      }
+    }
+  };
+
+  std::vector<std::size_t> wavefront;
+
+  {
+    const auto numberOfChunks = (seeds.size() + ChunkSize - 1) / ChunkSize;
+    std::vector<std::vector<std::size_t>> chunkSeeds(numberOfChunks), chunkWavefronts(numberOfChunks);
+
+    multiThreader->ParallelizeArray(0, numberOfChunks, [&](itk::SizeValueType chunk) {
+      const auto first = seeds.begin() + chunk * ChunkSize;
+      chunkSeeds[chunk].assign(first, first + std::min(ChunkSize, seeds.size() - chunk * ChunkSize));
+      evaluate(chunkSeeds[chunk], true, chunkWavefronts[chunk]);
+    }, nullptr);
+
+    for (const auto &chunkWavefront : chunkWavefronts)
+      wavefront.insert(wavefront.end(), chunkWavefront.begin(), chunkWavefront.end());
+  }
+
+  while (!wavefront.empty())
+  {
+    const auto numberOfChunks = (wavefront.size() + ChunkSize - 1) / ChunkSize;
+    std::vector<std::vector<std::size_t>> nextWavefronts(numberOfChunks);
+
+    multiThreader->ParallelizeArray(0, numberOfChunks, [&](itk::SizeValueType chunk) {
+      const std::size_t first = chunk * ChunkSize;
+      const auto last = std::min(first + ChunkSize, wavefront.size());
+
+      std::vector<std::size_t> candidates;
+      candidates.reserve(6 * (last - first));
+
+      auto claim = [&](std::size_t offset) {
+        if (!visited[offset].load(std::memory_order_relaxed) && !visited[offset].exchange(true))
+          candidates.push_back(offset);
+      };
+
+      for (auto i = first; i < last; ++i)
+      {
+        const auto offset = wavefront[i];
+        const auto x = offset % sizeX;
+        const auto y = (offset / sizeX) % sizeY;
+        const auto z = offset / (sizeX * sizeY);
+
+        if (x > 0) claim(offset - 1);
+        if (x + 1 < sizeX) claim(offset + 1);
+        if (y > 0) claim(offset - sizeX);
+        if (y + 1 < sizeY) claim(offset + sizeX);
+        if (z > 0) claim(offset - sizeX * sizeY);
+        if (z + 1 < sizeZ) claim(offset + sizeX * sizeY);
+      }
+
+      evaluate(candidates, false, nextWavefronts[chunk]);
+    }, nullptr);
+
+    wavefront.clear();
+
+    for (const auto &nextWavefront : nextWavefronts)
+      wavefront.insert(wavefront.end(), nextWavefront.begin(), nextWavefront.end());
+  }
+
+  visited.reset();
+
+  // Set every pixel inside the surface to -m_DistanceImageDefaultBufferValue except the edge points, like in
+  // FillDistanceImage(). Each row starts and ends at the image border, so all rows can be processed independently.
+  const auto defaultValue = m_DistanceImageDefaultBufferValue;
+
+  multiThreader->ParallelizeArray(0, sizeY * sizeZ, [&](itk::SizeValueType rowIndex) {
+    const auto y = rowIndex % sizeY;
+    const auto z = rowIndex / sizeY;
+    auto *row = buffer + rowIndex * sizeX;
+
+    if (0 == y || 0 == z || sizeY - 1 == y || sizeZ - 1 == z)
+    {
+      std::fill(row, row + sizeX, defaultValue);
+      return;
+    }
+
+    double prevPixelVal = defaultValue;
+    std::size_t x = 0;
+
+    while (x < sizeX)
+    {
+      if (row[x] == defaultValue && prevPixelVal < 0)
+      {
+        while (x < sizeX && row[x] == defaultValue)
+        {
+          if (0 == x || sizeX - 1 == x)
+          {
+            prevPixelVal = defaultValue;
+            ++x;
+            break;
+          }
+
+          row[x] = -defaultValue;
+          prevPixelVal = -defaultValue;
+          ++x;
+        }
+      }
+      else if (0 == x || sizeX - 1 == x)
+      {
+        row[x] = defaultValue;
+        prevPixelVal = defaultValue;
+        ++x;
+      }
+      else
+      {
+        prevPixelVal = row[x];
+        ++x;
+      }
+    }
+  }, nullptr);
+
+  Image::Pointer resultImage = this->GetOutput();
+
+  // Cast the created distance-Image from itk::Image to the mitk::Image
+  // that is our output.
+  CastToMitkImage(m_DistanceImageITK, resultImage);
+}
+
+void mitk::CreateDistanceImageFromSurfaceFilter::CalculateDistanceValues(const Eigen::ArrayX3d &points,
+                                                                         Eigen::ArrayXd &distances) const
+{
+  const auto numberOfPoints = points.rows();
+  distances.setZero(numberOfPoints);
+
+  if (m_UsePartitionOfUnity)
+  {
+    PointType p;
+
+    for (Eigen::Index i = 0; i < numberOfPoints; ++i)
+    {
+      p[0] = points(i, 0);
+      p[1] = points(i, 1);
+      p[2] = points(i, 2);
+
+      // Points beyond the interpolated domain are treated as far outside, which stops the narrow band
+      if (!m_PartitionOfUnityInterpolant.Evaluate(p, distances[i]))
+        distances[i] = m_DistanceImageDefaultBufferValue;
+    }
+
+    return;
+  }
+
+  // The centers are the outer loop, so that the inner loop over the points is vectorized by Eigen. The sum for
+  // each point is accumulated in the same order as in CalculateDistanceValue().
+  const auto numberOfCenters = m_Centers.size();
+
+  for (std::size_t i = 0; i < numberOfCenters; ++i)
+  {
+    const auto &center = m_Centers[i];
+
+    distances += m_Weights[i] * ((points.col(0) - center[0]).square() + (points.col(1) - center[1]).square() +
+                                 (points.col(2) - center[2]).square()).sqrt();
+  }
+}
+
 double mitk::CreateDistanceImageFromSurfaceFilter::CalculateDistanceValue(PointType p)
 {
   double distanceValue(0);
+
+  if (m_UsePartitionOfUnity)
+  {
+    // Points beyond the interpolated domain are treated as far outside, which stops the narrow band
+    return m_PartitionOfUnityInterpolant.Evaluate(p, distanceValue) ? distanceValue : m_DistanceImageDefaultBufferValue;
+  }
+
   PointType p1;
   PointType p2;
   double norm;
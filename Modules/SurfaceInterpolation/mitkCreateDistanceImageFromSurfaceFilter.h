@@ -16,6 +16,7 @@ found in the LICENSE file.
 #include <MitkSurfaceInterpolationExports.h>
 
 #include "mitkImageSource.h"
+#include "mitkPartitionOfUnityRBFInterpolant.h"
 #include "mitkProgressBar.h"
 #include "mitkSurface.h"
 
@@ -74,6 +75,18 @@ namespace mitk
 
     typedef std::vector<Surface::Pointer> SurfaceList;
 
+    /** \brief Methods to solve the RBF interpolation. */
+    enum class RBFSolver
+    {
+      /** One dense equation system of all centers. Its cost grows cubically with the number of centers. */
+      Dense,
+      /** Local equation systems blended by a partition of unity, see PartitionOfUnityRBFInterpolant.
+          Its cost grows about linearly with the number of centers. */
+      PartitionOfUnity,
+      /** Dense up to PartitionOfUnityThreshold centers, partition of unity beyond. */
+      Automatic
+    };
+
     mitkClassMacro(CreateDistanceImageFromSurfaceFilter, ImageSource);
     itkFactorylessNewMacro(Self);
     itkCloneMacro(Self);
@@ -99,6 +112,31 @@ namespace mitk
     */
     itkSetMacro(DistanceImageVolume, unsigned int);
 
+    /**
+    \brief Set the method to solve the RBF interpolation. Default is RBFSolver::Automatic.
+    */
+    itkSetEnumMacro(RBFSolver, RBFSolver);
+    itkGetEnumMacro(RBFSolver, RBFSolver);
+
+    /**
+    \brief Set the number of centers (i.e. three times the number of contour points) beyond which
+           RBFSolver::Automatic uses the partition of unity. Default is 3000.
+    */
+    itkSetMacro(PartitionOfUnityThreshold, unsigned int);
+    itkGetConstMacro(PartitionOfUnityThreshold, unsigned int);
+
+    /**
+    \brief Set whether the distance image is filled in parallel. Default is false.
+
+    The narrow band is then grown from all contour points at once in parallel wavefronts, the distance
+    function is evaluated for batches of voxels and the interior is filled in parallel rows. Other than the
+    serial filling, which grows the narrow band from the first contour point only, this also reaches
+    contours that are not connected to the first contour point by the narrow band, e.g. holes.
+    */
+    itkSetMacro(UseParallelFilling, bool);
+    itkGetConstMacro(UseParallelFilling, bool);
+    itkBooleanMacro(UseParallelFilling);
+
     void PrintEquationSystem();
 
     // Resets the filter, i.e. removes all inputs and outputs
@@ -131,6 +169,10 @@ namespace mitk
     double CalculateDistanceValue(PointType p);
 
     void FillDistanceImage();
+    void FillDistanceImageParallel();
+
+    /** Evaluates the distance function for a batch of points, one point per row. */
+    void CalculateDistanceValues(const Eigen::ArrayX3d &points, Eigen::ArrayXd &distances) const;
 
     /**
     * \brief This method fills the given variables with the minimum and
@@ -162,6 +204,12 @@ namespace mitk
     Eigen::VectorXd m_FunctionValues;
     Eigen::VectorXd m_Weights;
 
+    PartitionOfUnityRBFInterpolant m_PartitionOfUnityInterpolant;
+    RBFSolver m_RBFSolver;
+    unsigned int m_PartitionOfUnityThreshold;
+    bool m_UsePartitionOfUnity;
+    bool m_UseParallelFilling;
+
     DistanceImageType::Pointer m_DistanceImageITK;
     itk::ImageBase<3>::Pointer m_ReferenceImage;
 
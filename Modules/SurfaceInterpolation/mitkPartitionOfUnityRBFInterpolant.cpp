@@ -0,0 +1,351 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include "mitkPartitionOfUnityRBFInterpolant.h"
+
+#include <mitkExceptionMacro.h>
+
+#include <itkMultiThreaderBase.h>
+
+#include <vtkIdList.h>
+#include <vtkKdTreePointLocator.h>
+#include <vtkNew.h>
+#include <vtkPoints.h>
+#include <vtkPolyData.h>
+
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+  constexpr unsigned int MaximumOctreeDepth = 12;
+  constexpr int MaximumGridSize = 64;
+
+  // The sphere of a patch encloses its octree cell with some overlap to its neighbors
+  const double PatchRadiusPerCellSize = 0.75 * std::sqrt(3.0);
+
+  /** Wendland's C2 function, i.e. (1-t)^4 * (4t+1) for t in [0, 1].*/
+  double Wendland(double t)
+  {
+    const auto s = 1.0 - t;
+    return s * s * s * s * (4.0 * t + 1.0);
+  }
+}
+
+mitk::PartitionOfUnityRBFInterpolant::PartitionOfUnityRBFInterpolant()
+  : m_MaximumNumberOfCentersPerCell(32),
+    m_MinimumNumberOfCentersPerPatch(64),
+    m_MaximumNumberOfCentersPerPatch(256),
+    m_GridCellSize(1.0),
+    m_GridSize{0, 0, 0}
+{
+}
+
+void mitk::PartitionOfUnityRBFInterpolant::SetMaximumNumberOfCentersPerCell(unsigned int number)
+{
+  m_MaximumNumberOfCentersPerCell = std::max(1u, number);
+}
+
+void mitk::PartitionOfUnityRBFInterpolant::SetNumberOfCentersPerPatch(unsigned int minimum, unsigned int maximum)
+{
+  m_MinimumNumberOfCentersPerPatch = std::max(1u, minimum);
+  m_MaximumNumberOfCentersPerPatch = std::max(m_MinimumNumberOfCentersPerPatch, maximum);
+}
+
+void mitk::PartitionOfUnityRBFInterpolant::Build(const std::vector<PointType> &centers,
+                                                 const Eigen::VectorXd &values,
+                                                 double padding)
+{
+  this->Clear();
+
+  if (centers.empty() || static_cast<std::size_t>(values.size()) != centers.size())
+    mitkThrow() << "Cannot interpolate " << values.size() << " values at " << centers.size() << " centers.";
+
+  m_Centers = centers;
+
+  PointType minimum = centers.front();
+  PointType maximum = centers.front();
+
+  for (const auto &center : centers)
+  {
+    for (unsigned int dim = 0; dim < 3; ++dim)
+    {
+      minimum[dim] = std::min(minimum[dim], center[dim]);
+      maximum[dim] = std::max(maximum[dim], center[dim]);
+    }
+  }
+
+  // The octree is built on the cube that encloses the padded bounding box
+  padding = std::max(padding, 0.0);
+  double size = 0.0;
+
+  for (unsigned int dim = 0; dim < 3; ++dim)
+  {
+    minimum[dim] -= padding;
+    size = std::max(size, maximum[dim] + padding - minimum[dim]);
+  }
+
+  size = std::max(size, 1e-6);
+
+  this->CreatePatches(minimum, size);
+
+  // The local equation systems are independent of each other
+  auto solvePatch = [this, &values](itk::SizeValueType i) {
+    auto &patch = m_Patches[i];
+    const auto numberOfCenters = patch.CenterIds.size();
+
+    Eigen::MatrixXd matrix(numberOfCenters, numberOfCenters);
+    Eigen::VectorXd patchValues(numberOfCenters);
+
+    for (std::size_t row = 0; row < numberOfCenters; ++row)
+    {
+      const auto &center = m_Centers[patch.CenterIds[row]];
+
+      for (std::size_t column = 0; column < numberOfCenters; ++column)
+        matrix(row, column) = (center - m_Centers[patch.CenterIds[column]]).two_norm();
+
+      patchValues[row] = values[patch.CenterIds[row]];
+    }
+
+    patch.Weights = matrix.partialPivLu().solve(patchValues);
+  };
+
+  itk::MultiThreaderBase::New()->ParallelizeArray(0, m_Patches.size(), solvePatch, nullptr);
+
+  this->CreateLookupGrid(minimum, size);
+}
+
+void mitk::PartitionOfUnityRBFInterpolant::Clear()
+{
+  m_Centers.clear();
+  m_Patches.clear();
+  m_Grid.clear();
+  std::fill(m_GridSize, m_GridSize + 3, 0);
+}
+
+void mitk::PartitionOfUnityRBFInterpolant::CreatePatches(const PointType &origin, double size)
+{
+  const auto numberOfCenters = static_cast<vtkIdType>(m_Centers.size());
+
+  vtkNew<vtkPoints> points;
+  points->SetNumberOfPoints(numberOfCenters);
+
+  for (vtkIdType i = 0; i < numberOfCenters; ++i)
+    points->SetPoint(i, m_Centers[i].data_block());
+
+  vtkNew<vtkPolyData> polyData;
+  polyData->SetPoints(points);
+
+  vtkNew<vtkKdTreePointLocator> locator;
+  locator->SetDataSet(polyData);
+  locator->BuildLocator();
+
+  struct Cell
+  {
+    PointType Origin;
+    double Size;
+    unsigned int Depth;
+    std::vector<unsigned int> CenterIds;
+  };
+
+  std::vector<Cell> cells(1);
+  cells[0].Origin = origin;
+  cells[0].Size = size;
+  cells[0].Depth = 0;
+  cells[0].CenterIds.resize(m_Centers.size());
+
+  for (unsigned int i = 0; i < m_Centers.size(); ++i)
+    cells[0].CenterIds[i] = i;
+
+  vtkNew<vtkIdList> ids;
+
+  while (!cells.empty())
+  {
+    auto cell = std::move(cells.back());
+    cells.pop_back();
+
+    const auto halfSize = 0.5 * cell.Size;
+
+    // Every cell gets a patch, also empty ones, so that the whole octree is covered
+    Patch patch;
+
+    for (unsigned int dim = 0; dim < 3; ++dim)
+      patch.Center[dim] = cell.Origin[dim] + halfSize;
+
+    patch.Radius = PatchRadiusPerCellSize * cell.Size;
+
+    bool subdivide = cell.CenterIds.size() > m_MaximumNumberOfCentersPerCell;
+
+    if (!subdivide)
+    {
+      locator->FindPointsWithinRadius(patch.Radius, patch.Center.data_block(), ids);
+
+      // The sphere reaches into denser neighbors. Smaller cells get smaller spheres, so that all centers
+      // within a sphere remain part of its local interpolant.
+      subdivide = static_cast<unsigned int>(ids->GetNumberOfIds()) > m_MaximumNumberOfCentersPerPatch;
+    }
+
+    if (subdivide && cell.Depth < MaximumOctreeDepth)
+    {
+      std::vector<Cell> children(8);
+
+      for (unsigned int child = 0; child < 8; ++child)
+      {
+        children[child].Size = halfSize;
+        children[child].Depth = cell.Depth + 1;
+
+        for (unsigned int dim = 0; dim < 3; ++dim)
+          children[child].Origin[dim] = cell.Origin[dim] + ((child >> dim) & 1) * halfSize;
+      }
+
+      for (auto id : cell.CenterIds)
+      {
+        unsigned int child = 0;
+
+        for (unsigned int dim = 0; dim < 3; ++dim)
+        {
+          if (m_Centers[id][dim] >= cell.Origin[dim] + halfSize)
+            child |= 1 << dim;
+        }
+
+        children[child].CenterIds.push_back(id);
+      }
+
+      for (auto &child : children)
+        cells.push_back(std::move(child));
+
+      continue;
+    }
+
+    if (cell.CenterIds.size() > m_MaximumNumberOfCentersPerCell)
+      locator->FindPointsWithinRadius(patch.Radius, patch.Center.data_block(), ids);
+
+    if (static_cast<unsigned int>(ids->GetNumberOfIds()) < m_MinimumNumberOfCentersPerPatch)
+    {
+      // Enlarge the sphere, so that it encloses the nearest centers
+      locator->FindClosestNPoints(std::min<int>(m_MinimumNumberOfCentersPerPatch, numberOfCenters), patch.Center.data_block(), ids);
+
+      double farthest = 0.0;
+
+      for (vtkIdType i = 0; i < ids->GetNumberOfIds(); ++i)
+        farthest = std::max(farthest, (m_Centers[ids->GetId(i)] - patch.Center).two_norm());
+
+      patch.Radius = std::max(patch.Radius, 1.05 * farthest);
+      locator->FindPointsWithinRadius(patch.Radius, patch.Center.data_block(), ids);
+    }
+
+    if (static_cast<unsigned int>(ids->GetNumberOfIds()) > m_MaximumNumberOfCentersPerPatch)
+    {
+      // The cell cannot be subdivided any further. Shrink the sphere to the nearest centers, since centers
+      // within the sphere that are not interpolated locally would be blended with a wrong value.
+      locator->FindClosestNPoints(m_MaximumNumberOfCentersPerPatch, patch.Center.data_block(), ids);
+
+      double farthest = 0.0;
+
+      for (vtkIdType i = 0; i < ids->GetNumberOfIds(); ++i)
+        farthest = std::max(farthest, (m_Centers[ids->GetId(i)] - patch.Center).two_norm());
+
+      patch.Radius = farthest;
+    }
+
+    patch.CenterIds.resize(ids->GetNumberOfIds());
+
+    for (vtkIdType i = 0; i < ids->GetNumberOfIds(); ++i)
+      patch.CenterIds[i] = static_cast<unsigned int>(ids->GetId(i));
+
+    m_Patches.push_back(std::move(patch));
+  }
+}
+
+void mitk::PartitionOfUnityRBFInterpolant::CreateLookupGrid(const PointType &origin, double size)
+{
+  double minimumRadius = size;
+
+  for (const auto &patch : m_Patches)
+    minimumRadius = std::min(minimumRadius, patch.Radius);
+
+  m_GridOrigin = origin;
+  m_GridCellSize = std::max(minimumRadius, size / MaximumGridSize);
+
+  for (unsigned int dim = 0; dim < 3; ++dim)
+    m_GridSize[dim] = std::max(1, static_cast<int>(std::ceil(size / m_GridCellSize)));
+
+  m_Grid.assign(static_cast<std::size_t>(m_GridSize[0]) * m_GridSize[1] * m_GridSize[2], std::vector<unsigned int>());
+
+  for (unsigned int patchId = 0; patchId < m_Patches.size(); ++patchId)
+  {
+    const auto &patch = m_Patches[patchId];
+    int first[3], last[3];
+
+    for (unsigned int dim = 0; dim < 3; ++dim)
+    {
+      first[dim] = std::max(0, static_cast<int>(std::floor((patch.Center[dim] - patch.Radius - origin[dim]) / m_GridCellSize)));
+      last[dim] = std::min(m_GridSize[dim] - 1, static_cast<int>(std::floor((patch.Center[dim] + patch.Radius - origin[dim]) / m_GridCellSize)));
+    }
+
+    for (int z = first[2]; z <= last[2]; ++z)
+    {
+      for (int y = first[1]; y <= last[1]; ++y)
+      {
+        for (int x = first[0]; x <= last[0]; ++x)
+          m_Grid[(static_cast<std::size_t>(z) * m_GridSize[1] + y) * m_GridSize[0] + x].push_back(patchId);
+      }
+    }
+  }
+}
+
+bool mitk::PartitionOfUnityRBFInterpolant::Evaluate(const PointType &p, double &value) const
+{
+  int index[3];
+
+  for (unsigned int dim = 0; dim < 3; ++dim)
+  {
+    const auto position = (p[dim] - m_GridOrigin[dim]) / m_GridCellSize;
+
+    if (position < 0.0 || position >= m_GridSize[dim])
+      return false;
+
+    index[dim] = static_cast<int>(position);
+  }
+
+  double weightSum = 0.0;
+  double valueSum = 0.0;
+
+  for (auto patchId : m_Grid[(static_cast<std::size_t>(index[2]) * m_GridSize[1] + index[1]) * m_GridSize[0] + index[0]])
+  {
+    const auto &patch = m_Patches[patchId];
+    const auto distance = (p - patch.Center).two_norm();
+
+    if (distance >= patch.Radius)
+      continue;
+
+    double localValue = 0.0;
+
+    for (std::size_t i = 0; i < patch.CenterIds.size(); ++i)
+      localValue += patch.Weights[i] * (p - m_Centers[patch.CenterIds[i]]).two_norm();
+
+    const auto weight = Wendland(distance / patch.Radius);
+    weightSum += weight;
+    valueSum += weight * localValue;
+  }
+
+  if (weightSum <= 0.0)
+    return false;
+
+  value = valueSum / weightSum;
+  return true;
+}
+
+std::size_t mitk::PartitionOfUnityRBFInterpolant::GetNumberOfPatches() const
+{
+  return m_Patches.size();
+}
@@ -0,0 +1,101 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#ifndef mitkPartitionOfUnityRBFInterpolant_h
+#define mitkPartitionOfUnityRBFInterpolant_h
+
+#include <MitkSurfaceInterpolationExports.h>
+
+#include "vnl/vnl_vector_fixed.h"
+
+#include <itkeigen/Eigen/Dense>
+
+#include <vector>
+
+namespace mitk
+{
+  /**
+  \brief Radial basis function interpolation that scales to large numbers of centers.
+
+  The bounding box of the centers is subdivided by an octree until every cell holds only a few centers.
+  Each cell gets a local interpolant with the same basis function as the CreateDistanceImageFromSurfaceFilter
+  (Phi(r) = r), which interpolates the centers within a sphere around the cell. The sphere is enlarged until
+  it contains a minimum number of centers, so that local interpolants bridge the gaps between contours.
+  Cells whose spheres contain too many centers are subdivided further, so that every center within a sphere
+  is interpolated by its local interpolant.
+  The local interpolants are blended by a partition of unity of compactly supported Wendland functions,
+  one per sphere.
+
+  As the local equation systems have a bounded size and every point is covered by a bounded number of
+  spheres, building and evaluating the interpolant scales about linearly with the number of centers,
+  instead of cubically for a single dense equation system.
+
+  \sa CreateDistanceImageFromSurfaceFilter
+  */
+  class MITKSURFACEINTERPOLATION_EXPORT PartitionOfUnityRBFInterpolant
+  {
+  public:
+    typedef vnl_vector_fixed<double, 3> PointType;
+
+    PartitionOfUnityRBFInterpolant();
+
+    /** Octree cells with more centers are subdivided. Default is 32.*/
+    void SetMaximumNumberOfCentersPerCell(unsigned int number);
+
+    /** Range of the number of centers of a local interpolant. Defaults are 64 and 256.*/
+    void SetNumberOfCentersPerPatch(unsigned int minimum, unsigned int maximum);
+
+    /**
+    \brief Fits the local interpolants to the values at the centers, the equation systems are solved in parallel.
+    \param padding Distance by which the interpolated domain exceeds the bounding box of the centers.
+    */
+    void Build(const std::vector<PointType> &centers, const Eigen::VectorXd &values, double padding);
+
+    /** Releases all centers and local interpolants.*/
+    void Clear();
+
+    /**
+    \brief Evaluates the interpolant, can be called concurrently.
+    \return false if p lies outside of the interpolated domain.
+    */
+    bool Evaluate(const PointType &p, double &value) const;
+
+    std::size_t GetNumberOfPatches() const;
+
+  private:
+    struct Patch
+    {
+      PointType Center;
+      double Radius;
+      std::vector<unsigned int> CenterIds;
+      Eigen::VectorXd Weights;
+    };
+
+    void CreatePatches(const PointType &origin, double size);
+    void CreateLookupGrid(const PointType &origin, double size);
+
+    unsigned int m_MaximumNumberOfCentersPerCell;
+    unsigned int m_MinimumNumberOfCentersPerPatch;
+    unsigned int m_MaximumNumberOfCentersPerPatch;
+
+    std::vector<PointType> m_Centers;
+    std::vector<Patch> m_Patches;
+
+    // Uniform grid that lists the patches whose spheres intersect a grid cell
+    PointType m_GridOrigin;
+    double m_GridCellSize;
+    int m_GridSize[3];
+    std::vector<std::vector<unsigned int>> m_Grid;
+  };
+}
+
+#endif
@@ -46,6 +46,7 @@ std::map<mitk::MultiLabelSegmentation*, unsigned long> labelRemovedObserverTags;
 
 mitk::SurfaceInterpolationController::SurfaceInterpolationController()
   : m_DistanceImageVolume(50000),
+    m_UseParallelDistanceImageFilling(true),
     m_SelectedSegmentation(nullptr)
 {
 }
@@ -498,6 +499,7 @@ void mitk::SurfaceInterpolationController::Interpolate(const MultiLabelSegmentat
   reduceFilter->SetMaxSpacing(maxSpacing);
   normalsFilter->SetMaxSpacing(maxSpacing);
   interpolateSurfaceFilter->SetDistanceImageVolume(m_DistanceImageVolume);
+  interpolateSurfaceFilter->SetUseParallelFilling(m_UseParallelDistanceImageFilling);
 
   reduceFilter->SetUseProgressBar(false);
   normalsFilter->SetUseProgressBar(true);
@@ -627,6 +629,16 @@ void mitk::SurfaceInterpolationController::SetDistanceImageVolume(unsigned int d
   m_DistanceImageVolume = distImgVolume;
 }
 
+void mitk::SurfaceInterpolationController::SetUseParallelDistanceImageFilling(bool useParallelFilling)
+{
+  m_UseParallelDistanceImageFilling = useParallelFilling;
+}
+
+bool mitk::SurfaceInterpolationController::GetUseParallelDistanceImageFilling() const
+{
+  return m_UseParallelDistanceImageFilling;
+}
+
 mitk::MultiLabelSegmentation* mitk::SurfaceInterpolationController::GetCurrentSegmentation()
 {
   return m_SelectedSegmentation.Lock();
@@ -120,6 +120,14 @@ namespace mitk
      */
     void SetDistanceImageVolume(unsigned int distImageVolume);
 
+    /**
+     * Sets whether the distance image of the interpolation is filled in parallel, which also interpolates
+     * contours with holes correctly. Default is true.
+     * \sa CreateDistanceImageFromSurfaceFilter::SetUseParallelFilling()
+     */
+    void SetUseParallelDistanceImageFilling(bool useParallelFilling);
+    bool GetUseParallelDistanceImageFilling() const;
+
     /**
      * @brief Get the current selected segmentation for which the interpolation is performed
      * @return the current segmentation image
@@ -252,6 +260,7 @@ namespace mitk
     void AddToCPIMap(ContourPositionInformation& contourInfo, bool reinitializationAction = false);
 
     unsigned int m_DistanceImageVolume;
+    bool m_UseParallelDistanceImageFilling;
     mitk::DataStorage::Pointer m_DataStorage;
 
     WeakPointer<MultiLabelSegmentation> m_SelectedSegmentation;
@@ -15,11 +15,15 @@ found in the LICENSE file.
 #include "QmitkDataNodeGlobalReinitAction.h"
 
 #include <QCheckBox>
+#include <QComboBox>
 #include <QFormLayout>
 
 #include <mitkCoreServices.h>
 #include <mitkIPreferencesService.h>
 #include <mitkIPreferences.h>
+#include <mitkItkImageIO.h>
+
+#include <vector>
 
 namespace
 {
@@ -28,6 +32,27 @@ namespace
     auto* preferencesService = mitk::CoreServices::GetPreferencesService();
     return preferencesService->GetSystemPreferences()->Node(QmitkDataNodeGlobalReinitAction::ACTION_ID.toStdString());
   }
+
+  mitk::IPreferences* GetIOPreferences()
+  {
+    auto* preferencesService = mitk::CoreServices::GetPreferencesService();
+    return preferencesService->GetSystemPreferences()->Node("org.mitk.gui.qt.application");
+  }
+
+  // Indices of the combo box, see mitk::ItkImageIO::LoadMode
+  const std::vector<mitk::ItkImageIO::LoadMode> ImageLoadModes = {
+    mitk::ItkImageIO::LoadMode::Complete,
+    mitk::ItkImageIO::LoadMode::Streamed,
+    mitk::ItkImageIO::LoadMode::MemoryMapped,
+    mitk::ItkImageIO::LoadMode::Paged
+  };
+
+  mitk::ItkImageIO::LoadMode GetImageLoadMode(int index)
+  {
+    return index >= 0 && index < static_cast<int>(ImageLoadModes.size())
+      ? ImageLoadModes[index]
+      : mitk::ItkImageIO::LoadMode::Complete;
+  }
 }
 
 QmitkGeneralPreferencePage::QmitkGeneralPreferencePage()
@@ -48,9 +73,15 @@ void QmitkGeneralPreferencePage::CreateQtControl(QWidget* parent)
   m_GlobalReinitOnNodeDelete = new QCheckBox;
   m_GlobalReinitOnNodeVisibilityChanged = new QCheckBox;
 
+  m_ImageLoadMode = new QComboBox;
+  m_ImageLoadMode->addItems({ "Complete", "Streamed", "Memory mapped", "Paged" });
+  m_ImageLoadMode->setToolTip("Memory mapped and paged images are read from their files on demand.\n"
+                              "These files must not be modified by other applications while the images are loaded.");
+
   auto formLayout = new QFormLayout;
   formLayout->addRow("&Call global reinit if node is deleted", m_GlobalReinitOnNodeDelete);
   formLayout->addRow("&Call global reinit if node visibility is changed", m_GlobalReinitOnNodeVisibilityChanged);
+  formLayout->addRow("&Image load mode", m_ImageLoadMode);
 
   m_MainControl->setLayout(formLayout);
   Update();
@@ -68,6 +99,9 @@ bool QmitkGeneralPreferencePage::PerformOk()
   prefs->PutBool("Call global reinit if node is deleted", m_GlobalReinitOnNodeDelete->isChecked());
   prefs->PutBool("Call global reinit if node visibility is changed", m_GlobalReinitOnNodeVisibilityChanged->isChecked());
 
+  GetIOPreferences()->PutInt("image load mode", m_ImageLoadMode->currentIndex());
+  ApplyImageLoadMode();
+
   return true;
 }
 
@@ -82,4 +116,11 @@ void QmitkGeneralPreferencePage::Update()
 
   m_GlobalReinitOnNodeDelete->setChecked(prefs->GetBool("Call global reinit if node is deleted", true));
   m_GlobalReinitOnNodeVisibilityChanged->setChecked(prefs->GetBool("Call global reinit if node visibility is changed", false));
+
+  m_ImageLoadMode->setCurrentIndex(GetIOPreferences()->GetInt("image load mode", 0));
+}
+
+void QmitkGeneralPreferencePage::ApplyImageLoadMode()
+{
+  mitk::ItkImageIO::SetDefaultLoadMode(GetImageLoadMode(GetIOPreferences()->GetInt("image load mode", 0)));
 }
@@ -17,6 +17,7 @@ found in the LICENSE file.
 
 class QWidget;
 class QCheckBox;
+class QComboBox;
 
 class QmitkGeneralPreferencePage : public QObject, public berry::IQtPreferencePage
 {
@@ -57,12 +58,18 @@ public:
   */
   void Update() override;
 
+  /**
+  * @brief Passes the image load mode of the preferences to mitk::ItkImageIO.
+  */
+  static void ApplyImageLoadMode();
+
 protected:
 
     QWidget* m_MainControl;
 
     QCheckBox* m_GlobalReinitOnNodeDelete;
     QCheckBox* m_GlobalReinitOnNodeVisibilityChanged;
+    QComboBox* m_ImageLoadMode;
 };
 
 #endif
@@ -38,6 +38,8 @@ namespace mitk
     BERRY_REGISTER_EXTENSION_CLASS(QmitkShowPreferencePageHandler, context)
 
     QmitkRegisterClasses();
+
+    QmitkGeneralPreferencePage::ApplyImageLoadMode();
   }
 
   void org_mitk_gui_qt_application_Activator::stop(ctkPluginContext* context)
@@ -60,6 +60,8 @@ void QmitkUndoRedoView::CreateQtPartControl(QWidget* parent)
   connect(m_Controls->redoButton, SIGNAL(clicked()), this, SLOT(OnRedoButtonClicked()));
   connect(m_Controls->btnLimit, SIGNAL(clicked()), this, SLOT(OnChangeLimitClicked()));
   connect(m_Controls->checkLimit, &QAbstractButton::toggled, this, &QmitkUndoRedoView::OnCheckLimitChanged);
+  connect(m_Controls->btnMemoryLimit, SIGNAL(clicked()), this, SLOT(OnChangeMemoryLimitClicked()));
+  connect(m_Controls->checkMemoryLimit, &QAbstractButton::toggled, this, &QmitkUndoRedoView::OnCheckMemoryLimitChanged);
 
   // Use ITKEventObserver to listen for undo stack changes
   m_UndoStackObserverGuard = mitk::ITKEventObserverGuard(undoModel, mitk::UndoStackEvent(), [this](const itk::EventObject&) {this->OnUndoStackChanged(); });
@@ -141,6 +143,40 @@ void QmitkUndoRedoView::OnCheckLimitChanged(bool)
   this->UpdateButtonStatus();
 }
 
+void QmitkUndoRedoView::OnChangeMemoryLimitClicked()
+{
+  auto undoModel = this->GetUndoModel();
+  if (nullptr != undoModel)
+  {
+    bool ok = false;
+    auto newLimit = QInputDialog::getInt(m_Controls->undoRedoListView->parentWidget(), "Select the undo memory limit", "New max undo memory (MB):", static_cast<int>(undoModel->GetMemoryLimit()), 1, 1048576, 64, &ok);
+    if (ok)
+    {
+      undoModel->SetMemoryLimit(newLimit);
+      this->UpdateUndoRedoList();
+      this->UpdateButtonStatus();
+    }
+  }
+}
+
+void QmitkUndoRedoView::OnCheckMemoryLimitChanged(bool)
+{
+  auto undoModel = this->GetUndoModel();
+  if (nullptr != undoModel)
+  {
+    if (m_Controls->checkMemoryLimit->isChecked() && undoModel->GetMemoryLimit() == 0)
+    {
+      undoModel->SetMemoryLimit(1024);
+    }
+    else if (!m_Controls->checkMemoryLimit->isChecked())
+    {
+      undoModel->SetMemoryLimit(0);
+    }
+  }
+  this->UpdateUndoRedoList();
+  this->UpdateButtonStatus();
+}
+
 void QmitkUndoRedoView::OnUndoStackChanged()
 {
   // The undo stack has changed, update our view
@@ -223,4 +259,23 @@ void QmitkUndoRedoView::UpdateButtonStatus()
     }
   }
   m_Controls->labelLimit->setText(limitText);
+
+  m_Controls->checkMemoryLimit->setEnabled(nullptr != undoModel);
+  m_Controls->checkMemoryLimit->setChecked(nullptr != undoModel && undoModel->GetMemoryLimit() > 0);
+  m_Controls->labelMemoryLimit->setVisible(nullptr != undoModel && m_Controls->checkMemoryLimit->isChecked());
+  m_Controls->btnMemoryLimit->setVisible(nullptr != undoModel && m_Controls->checkMemoryLimit->isChecked());
+  QString memoryLimitText = "unknown";
+  if (nullptr != undoModel)
+  {
+    const auto usedMegaBytes = static_cast<double>(undoModel->GetMemorySize()) / (1024.0 * 1024.0);
+    if (undoModel->GetMemoryLimit() > 0)
+    {
+      memoryLimitText = QString("%1 of %2 MB used").arg(usedMegaBytes, 0, 'f', 1).arg(undoModel->GetMemoryLimit());
+    }
+    else
+    {
+      memoryLimitText = QString("%1 MB used").arg(usedMegaBytes, 0, 'f', 1);
+    }
+  }
+  m_Controls->labelMemoryLimit->setText(memoryLimitText);
 }
@@ -47,6 +47,8 @@ private slots:
   void OnRedoButtonClicked();
   void OnChangeLimitClicked();
   void OnCheckLimitChanged(bool);
+  void OnChangeMemoryLimitClicked();
+  void OnCheckMemoryLimitChanged(bool);
 
 private:
   mitk::VerboseLimitedLinearUndo* GetUndoModel() const;